@@ -35,7 +35,18 @@ AudioBuffer::AudioBuffer( int aAmountOfChannels, int aBufferSize )
 
     // create silent buffers for each channel
 
-    _buffers = BufferUtility::createSampleBuffers( aAmountOfChannels, aBufferSize );
+    _buffers     = BufferUtility::createSampleBuffers( aAmountOfChannels, aBufferSize );
+    _ownsBuffers = true;
+}
+
+AudioBuffer::AudioBuffer( int aAmountOfChannels, int aBufferSize, SAMPLE_TYPE* const* aChannelBuffers )
+{
+    loopeable        = false;
+    amountOfChannels = aAmountOfChannels;
+    bufferSize       = aBufferSize;
+
+    _buffers     = new std::vector<SAMPLE_TYPE*>( aChannelBuffers, aChannelBuffers + aAmountOfChannels );
+    _ownsBuffers = false;
 }
 
 AudioBuffer::~AudioBuffer()
@@ -168,12 +179,14 @@ AudioBuffer* AudioBuffer::clone()
 void AudioBuffer::clearVectors()
 {
     if ( _buffers != nullptr ) {
-        while ( !_buffers->empty()) {
+        while ( _ownsBuffers && !_buffers->empty()) {
             delete[] _buffers->back(), _buffers->pop_back();
         }
         delete _buffers;
         _buffers = nullptr;
     }
+    // vectors created after clearing (see ResizableAudioBuffer) are owned by this AudioBuffer
+    _ownsBuffers = true;
 }
 
 } // E.O namespace MWEngine
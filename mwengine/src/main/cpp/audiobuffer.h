@@ -31,6 +31,11 @@ class AudioBuffer
 {
     public:
         AudioBuffer( int aAmountOfChannels, int aBufferSize );
+#ifndef SWIG
+        // wraps existing sample memory (one pointer per channel) without copying it, the
+        // memory is not released by the AudioBuffer and must outlive it (see SampleBank)
+        AudioBuffer( int aAmountOfChannels, int aBufferSize, SAMPLE_TYPE* const* aChannelBuffers );
+#endif
         ~AudioBuffer();
 
         int amountOfChannels;
@@ -47,6 +52,7 @@ class AudioBuffer
 
     protected:
         std::vector<SAMPLE_TYPE*>* _buffers;
+        bool _ownsBuffers;
         void clearVectors();
 };
 } // E.O namespace MWEngine
@@ -74,13 +74,19 @@ void AudioChannel::setVolume( float value )
 
 void AudioChannel::addEvent( BaseAudioEvent* aEvent )
 {
-    audioEvents.push_back( aEvent );
+    // the event lists can only grow when the engine isn't rendering
+
+    if ( audioEvents.size() < audioEvents.capacity() || !AudioEngineProps::isRendering.load() ) {
+        audioEvents.push_back( aEvent );
+    }
 }
 
 void AudioChannel::addLiveEvent( BaseAudioEvent* aLiveEvent )
 {
-    hasLiveEvents = true;
-    liveEvents.push_back( aLiveEvent );
+    if ( liveEvents.size() < liveEvents.capacity() || !AudioEngineProps::isRendering.load() ) {
+        hasLiveEvents = true;
+        liveEvents.push_back( aLiveEvent );
+    }
 }
 
 void AudioChannel::readCachedBuffer( AudioBuffer* aOutputBuffer, int aReadOffset )
@@ -222,7 +228,8 @@ void AudioChannel::reset()
 {
     audioEvents.clear();
     liveEvents.clear();
-    hasLiveEvents = false;
+    hasLiveEvents  = false;
+    schedule.valid = false;
 }
 
 float AudioChannel::getPan()
@@ -272,6 +279,12 @@ void AudioChannel::init()
     _volume            = VolumeUtil::toLog( 1.0 );
     maxBufferPosition  = 0;
     processingChain    = new ProcessingChain();
+    schedule           = { false, 0, 0, 0, 0 };
+    instrument         = nullptr;
+    isGathered         = false;
+
+    audioEvents.reserve( EVENT_CAPACITY );
+    liveEvents.reserve( EVENT_CAPACITY );
 
     setPan( 0 );
     createOutputBuffer();
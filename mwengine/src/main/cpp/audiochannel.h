@@ -40,11 +40,39 @@ class AudioChannel
 
         // queried and modified by Sequencer (these are temporary
         // vectors used during rendering, the actual events belong
-        // to the events BaseInstrument)
+        // to the events BaseInstrument). Room for EVENT_CAPACITY events (matching the
+        // capacity of BaseInstrument) is preallocated so collecting events doesn't allocate
+        // during rendering. Events exceeding the capacity are not rendered
+
+        static const int EVENT_CAPACITY = 256;
 
         std::vector<BaseAudioEvent*> audioEvents;
         std::vector<BaseAudioEvent*> liveEvents;
 
+#ifndef SWIG
+        /**
+         * describes the range the Sequencer collected the sequenced audioEvents for. As long as
+         * playback continues within the same schedule (e.g. no event starts or ends and no events
+         * were added/removed), the collected events remain valid and needn't be collected again
+         */
+        struct EventSchedule {
+            bool valid;
+            int rangeEnd;           // the end of the range the events were collected for
+            int nextEventStart;     // the start offset of the first event following the collected range
+            int firstEventEnd;      // the lowest end offset of the collected events
+            unsigned int revision;  // the revision of the instruments EventIndex at the moment of collection
+        };
+        EventSchedule schedule;
+
+        // the instrument whose events are collected into this channel (assigned by the Sequencer)
+
+        BaseInstrument* instrument;
+
+        // whether the Sequencer gathered this channel for rendering in the current render cycle
+
+        bool isGathered;
+#endif
+
         ProcessingChain *processingChain;
 
         /**
@@ -30,8 +30,12 @@
 #include <definitions/notifications.h>
 #include <messaging/notifier.h>
 #include <events/baseaudioevent.h>
+#include <instruments/baseinstrument.h>
+#include <messaging/commandqueue.h>
 #include <utilities/bufferutility.h>
 #include <utilities/perfutility.h>
+#include <utilities/renderprofiler.h>
+#include <utilities/rtsafetychecker.h>
 #include <utilities/debug.h>
 #include <utilities/channelutility.h>
 #include <utilities/utils.h>
@@ -97,6 +101,8 @@ namespace MWEngine {
 
     int    AudioEngine::outputChannels                = AudioEngineProps::OUTPUT_CHANNELS;
     bool   AudioEngine::isMono                        = ( outputChannels == 1 );
+    int64_t AudioEngine::renderedFrames               = 0;
+    int64_t AudioEngine::bufferFrame                  = 0;
     float* AudioEngine::outBuffer                     = nullptr;
     ResizableAudioBuffer* AudioEngine::inBuffer       = nullptr;
     std::vector<AudioChannel*>* AudioEngine::channels = nullptr;
@@ -104,6 +110,11 @@ namespace MWEngine {
     std::thread* AudioEngine::thread  = nullptr;
     bool AudioEngine::threadOptimized = false;
 
+    int         AudioEngine::renderWorkers = 0;
+    WorkerPool* AudioEngine::workerPool    = nullptr;
+
+    StemCapture* AudioEngine::stemCapture = nullptr;
+
 #ifdef PREVENT_CPU_FREQUENCY_SCALING
     double  AudioEngine::_noopsPerTick;
     int64_t AudioEngine::_renderedSamples;
@@ -166,33 +177,11 @@ namespace MWEngine {
 
         // audio hardware available, prepare environment
 
-        channels       = new std::vector<AudioChannel*>();
-        outputChannels = AudioEngineProps::OUTPUT_CHANNELS;
-        isMono         = ( outputChannels == 1 );
+        allocateRenderBuffers();
 
-        createOutputBuffer();
+        // notifications broadcast during rendering are dispatched outside of the render thread
 
-#ifdef RECORD_DEVICE_INPUT
-
-        // generate the input buffer used for recording from the device's input
-        // as well as the temporary buffer used to merge the input into
-
-        recbufferIn  = new float[ AudioEngineProps::BUFFER_SIZE * AudioEngineProps::INPUT_CHANNELS ]();
-        inputChannel->createOutputBuffer();
-
-#endif
-        // accumulates all channels ("master strip")
-
-        inBuffer = new ResizableAudioBuffer( outputChannels, AudioEngineProps::BUFFER_SIZE );
-
-        // ensure all AudioChannel buffers have the correct properties (in case engine is
-        // restarting after changing buffer size, for instance)
-
-        std::vector<BaseInstrument*> instruments = Sequencer::instruments;
-
-        for ( auto & instrument : instruments ) {
-            instrument->audioChannel->createOutputBuffer();
-        }
+        Notifier::startDispatcher();
 
         // all ready. start render cycle
 
@@ -212,6 +201,11 @@ namespace MWEngine {
         }
         thread = nullptr;
 
+        // apply the mutations the render thread did not get to and dispatch its remaining notifications
+
+        CommandQueue::synchronize();
+        Notifier::stopDispatcher();
+
         Debug::log( "AudioEngine::STOPPED engine" );
 
         DriverAdapter::destroy();
@@ -219,18 +213,7 @@ namespace MWEngine {
         Debug::log( "AudioEngine::Destroyed audio driver" );
 
         // clear heap memory allocated before thread loop
-        delete channels;
-        delete outBuffer;
-        delete inBuffer;
-
-        channels  = nullptr;
-        outBuffer = nullptr;
-        inBuffer  = nullptr;
-
-#ifdef RECORD_DEVICE_INPUT
-        delete recbufferIn;
-        recbufferIn = nullptr;
-#endif
+        releaseRenderBuffers();
     }
 
     void AudioEngine::reset()
@@ -258,6 +241,16 @@ namespace MWEngine {
         recordingState.bouncing       = false;
     }
 
+    void AudioEngine::setRenderWorkers( int amountOfWorkers )
+    {
+        renderWorkers = std::max( 0, amountOfWorkers );
+    }
+
+    int AudioEngine::getRenderWorkers()
+    {
+        return renderWorkers;
+    }
+
     void AudioEngine::addChannelGroup( ChannelGroup* group )
     {
         auto it = std::find( groups.begin(), groups.end(), group );
@@ -327,8 +320,8 @@ namespace MWEngine {
 
         if ( wasRecording )
         {
-            // recording halted, write currently recording snippet into file
-            // and concatenate all recorded snippets into the requested output file name
+            // recording halted, the samples were streamed into the output file while recording
+            // so we only write the remaining queued samples and finalize the file's header
             // we can do this synchronously as this method is called from outside the
             // rendering thread and thus won't lead to buffer under runs
 
@@ -359,8 +352,8 @@ namespace MWEngine {
         recordingState.inputToFile = false;
         if ( wasRecording )
         {
-            // recording halted, write currently recording snippet into file
-            // and concatenate all recorded snippets into the requested output file name
+            // recording halted, the samples were streamed into the output file while recording
+            // so we only write the remaining queued samples and finalize the file's header
             // we can do this synchronously as this method is called from outside the
             // rendering thread and thus won't lead to buffer under runs
 
@@ -392,20 +385,18 @@ namespace MWEngine {
 
     void AudioEngine::saveRecordedSnippet( int snippetBufferIndex )
     {
-        DiskWriter::writeBufferToFile( snippetBufferIndex, true );
+        // recordings are written onto storage by the DiskWriter while recording
     }
 
     bool AudioEngine::render( int amountOfSamples )
     {
-        size_t i, j, k, c, ci;
-        float sample;
-
         if ( !threadOptimized ) {
             if ( !DriverAdapter::isMocked() ) {
                 PerfUtility::optimizeThreadPerformance( AudioEngineProps::CPU_CORES );
             }
             threadOptimized = true;
         }
+        RT_SAFETY_SCOPE(); // the remainder of the render cycle must not allocate nor lock
 
 #ifdef PREVENT_CPU_FREQUENCY_SCALING
 
@@ -427,10 +418,138 @@ namespace MWEngine {
         int64_t expectedRenderDuration = static_cast<int64_t>(( amountOfSamplesTime * MAX_CPU_PER_RENDER_TIME ) - totalExpectedDelta );
 
 #endif
+        renderOutput( amountOfSamples, true );
+
+        // thread has been stopped during operations above ? exit as writing the
+        // output into the audio hardware will lock execution until the next buffer
+        // is enqueued (additionally, we prevent writing to device storage when recording/bouncing)
+
+        if ( !AudioEngineProps::isRendering.load() ) {
+            return false;
+        }
+
+        // write the synthesized output into the audio driver (unless we are bouncing as writing the
+        // output to the hardware makes it both unnecessarily audible and stalls execution)
+
+        if ( !recordingState.bouncing ) {
+            RT_SAFETY_SUSPEND(); // the driver can block until the hardware is ready
+            DriverAdapter::writeOutput( outBuffer, amountOfSamples * outputChannels );
+        }
+
+#ifdef RECORD_TO_DISK
+        // write the output to disk if a recording state is active
+        if (( Sequencer::playing && recordingState.outputToFile ) || recordingState.inputToFile )
+        {
+#ifdef RECORD_DEVICE_INPUT
+
+            // recording from device input ?
+            if ( recordingState.inputToFile ) {
+                // if we are recording WITH the processing chain, write to disk (otherwise pre-mix
+                // buffer was already written to disk prior to applying the processing chain)
+                if ( recordingState.recordInputWithChain ) {
+                    DiskWriter::appendBuffer( inputChannel->getOutputBuffer() );
+                }
+            } else {
+#endif
+
+                    // recording global output ? > write the combined output buffer
+
+                    bool isFullDuplexRecording = recordingState.correctLatency;
+
+                    if ( recordingState.recordDeviceInput && inputChannel->muted ) {
+                        if ( isFullDuplexRecording ) {
+                            // use alternative DiskWriter method to append and instantly mix the input when correcting latency
+                            DiskWriter::appendDuplexBuffers( outBuffer,
+                                                             inputChannel->getOutputBuffer(),
+                                                             amountOfSamples, outputChannels );
+                        } else {
+                            // if no latency correction is applied, mix the input with the output
+                            // since we were also recording device input with a muted input channel, we first
+                            // mix the input (not audible in the written driver output) into the output buffer
+                            inputChannel->mixBuffer( inBuffer, inputChannel->getVolume() );
+                            BufferUtility::mixBufferInterleaved( inBuffer, outBuffer, amountOfSamples, outputChannels );
+                        }
+                    }
+
+                    if ( !isFullDuplexRecording ) {
+                        // actual writing of audio into the DiskWriter buffer
+                        DiskWriter::appendBuffer( outBuffer, amountOfSamples, outputChannels );
+                    }
+
+#ifdef RECORD_DEVICE_INPUT
+            }
+#endif
+            // are we bouncing the current sequencer range and have we played through the full range?
+
+            if ( recordingState.bouncing && ( loopStarted || bufferPosition == recordingState.bounceRangeStart || bufferPosition >= recordingState.bounceRangeEnd ))
+            {
+                // write current snippet onto disk and finish recording
+                // (this can be done synchronously as rendering will now halt)
+
+                DiskWriter::finish();
+
+                // broadcast update via JNI
+
+                Notifier::broadcast( Notifications::BOUNCE_COMPLETE );
+
+                // stops thread, halts rendering
+
+                stop();
+                Sequencer::playing = false;
+
+                recordingState.bouncing = false;
+                recordingState.outputToFile = false;
+
+                return false;
+            }
+        }
+#endif
+        // tempo update queued ?
+        if ( queuedTempo != tempo ) {
+            handleTempoUpdate( queuedTempo, true );
+        }
+
+#ifdef PREVENT_CPU_FREQUENCY_SCALING
+
+        int64_t renderEnd      = PerfUtility::now();
+        int64_t renderDuration = renderEnd - renderStart;
+        int64_t loadDuration   = expectedRenderDuration - renderDuration; // total time to apply stabilizing load
+
+        _noopsPerTick     = PerfUtility::applyCPUStabilizingLoad( renderEnd + loadDuration, _noopsPerTick );
+        _renderedSamples += amountOfSamples;
+
+#endif
+
+        // bit fugly, during bounce on AAudio driver, keep render loop going until bounce completes
+        if ( recordingState.bouncing && AudioEngineProps::isRendering.load() && DriverAdapter::isAAudio() ) {
+            render( amountOfSamples );
+        }
+        return AudioEngineProps::isRendering.load();
+    }
+
+    float* AudioEngine::renderOutput( int amountOfSamples, bool mixDeviceInput )
+    {
+        size_t j, k;
+
+        RT_SAFETY_SCOPE();
+        PROFILE_START( cycleStart );
+
+        // apply the mutations posted by the control thread since the previous render cycle
+
+        CommandQueue::flush();
+
+        bufferFrame     = renderedFrames;
+        renderedFrames += amountOfSamples;
+
         inBuffer->resize( amountOfSamples ); // keep output buffer size in sync with driver requested sample size
         inBuffer->silenceBuffers();          // erase previous buffer contents for the current render range
 
+        if ( stemCapture != nullptr ) {
+            stemCapture->prepare( amountOfSamples );
+        }
+
         // gather the audio events by the sequencer range currently being processed
+        PROFILE_START( sequencerStart );
         loopStarted = Sequencer::getAudioEvents( channels, bufferPosition, amountOfSamples, true, true );
 
         // read pointer exceeds maximum allowed offset (max_buffer_position) ? => sequencer has started its loop
@@ -442,10 +561,11 @@ namespace MWEngine {
         if ( loopAmount > 0 ) {
             Sequencer::getAudioEvents( channels, min_buffer_position, loopAmount, false, false );
         }
+        PROFILE_STOP( sequencerStart, SEQUENCER );
 
 #ifdef RECORD_DEVICE_INPUT
         // record audio from Android device ?
-        if (( recordingState.recordDeviceInput || recordingState.inputToFile ))
+        if ( mixDeviceInput && ( recordingState.recordDeviceInput || recordingState.inputToFile ))
         {
             int recordedSamples = DriverAdapter::getInput( recbufferIn, amountOfSamples );
             inputChannel->getOutputBuffer()->resize( recordedSamples );
@@ -467,7 +587,7 @@ namespace MWEngine {
 
             // apply processing chain onto the input
 
-            std::vector<BaseProcessor*> processors = inputChannel->processingChain->getActiveProcessors();
+            auto& processors = inputChannel->processingChain->getActiveProcessors();
             for ( k = 0; k < processors.size(); ++k ) {
                 processors[ k ]->process( inputChannel->getOutputBuffer(), AudioEngineProps::INPUT_CHANNELS == 1 );
             }
@@ -479,105 +599,30 @@ namespace MWEngine {
             }
         }
 #endif
-        // channel loop
+        // channel loop (render the events and processing chain of each channel into its output buffer)
         size_t channelAmount = channels->size();
         size_t groupAmount   = groups.size();
 
-        for ( j = 0; j < channelAmount; ++j )
-        {
-            AudioChannel* channel = channels->at( j );
-            bool isCached         = channel->hasCache;                // whether this channel has a fully cached buffer
-            bool mustCache        = AudioEngineProps::CHANNEL_CACHING && channel->canCache() && !isCached; // whether to cache this channels output
-            int cacheReadPos      = 0;  // the offset we start ready from the channel buffer (when writing to cache)
-
-            std::vector<BaseAudioEvent*> audioEvents = channel->audioEvents;
-            unsigned long amount = audioEvents.size();
-
-            // divide the channels volume by the amount of channels to provide extra headroom
-            SAMPLE_TYPE channelVolume = ( SAMPLE_TYPE ) channel->getVolumeLogarithmic() / ( SAMPLE_TYPE ) channelAmount;
-
-            // get channel output buffer and clear previous contents
-            ResizableAudioBuffer* channelBuffer = channel->getOutputBuffer();
-            if ( channelBuffer == nullptr ) continue;
-
-            channelBuffer->resize( amountOfSamples ); // keep output buffer size in sync with driver requested sample size
-            channelBuffer->silenceBuffers();
-
-            bool useChannelRange  = channel->maxBufferPosition != 0; // channel has its own buffer range (i.e. drummachine)
-            int maxBufferPosition = useChannelRange ? channel->maxBufferPosition : max_buffer_position;
-
-            // we make a copy of the current buffer position indicator
-            int bufferPos = bufferPosition;
-
-            // ...in case the AudioChannels maxBufferPosition differs from the sequencer loop range
-            // note that these buffer positions are always a full measure in length (as we loop by measures)
-            while ( bufferPos > maxBufferPosition ) {
-                bufferPos -= samples_per_bar;
-            }
-
-            // only render sequenced events when the sequencer isn't in the paused state
-            // and the channel volume is actually at an audible level! ( > 0 )
-
-            if ( Sequencer::playing && amount > 0 && channelVolume > SILENCE )
-            {
-                if ( !isCached )
-                {
-                    // write the audioEvent buffers into the main output buffer
-                    for ( k = 0; k < amount; ++k )
-                    {
-                        BaseAudioEvent* audioEvent = audioEvents[ k ];
-
-                        if ( audioEvent != nullptr && !audioEvent->isLocked()) // make sure we're allowed to query the contents
-                        {
-                            audioEvent->mixBuffer( channelBuffer, bufferPos, min_buffer_position,
-                                                   maxBufferPosition, loopStarted, loopOffset, useChannelRange );
-                        }
-                    }
-                }
-                else {
-                    channel->readCachedBuffer( channelBuffer, bufferPos );
-                }
-            }
-
-            // perform live rendering for this channels instrument
-            if ( channel->hasLiveEvents )
-            {
-                size_t lAmount = channel->liveEvents.size();
-
-                for ( k = 0; k < lAmount; ++k )
-                {
-                    BaseAudioEvent* liveEvent = channel->liveEvents[ k ];
-                    liveEvent->mixBuffer( channelBuffer );
-                }
+        if ( workerPool != nullptr && channelAmount > 1 ) {
+            workerPool->run( renderChannelTask, &amountOfSamples, channelAmount );
+        } else {
+            for ( j = 0; j < channelAmount; ++j ) {
+                renderChannel( channels->at( j ), amountOfSamples, Sequencer::audibleChannels );
             }
+        }
 
-            // apply the processing chains processors / modulators
-            ProcessingChain* chain = channel->processingChain;
-            std::vector<BaseProcessor*> processors = chain->getActiveProcessors();
-
-            for ( k = 0; k < processors.size(); ++k )
-            {
-                BaseProcessor* processor = processors[ k ];
-                bool canCacheProcessor   = processor->isCacheable();
-
-                // only apply processor when we're not caching or cannot cache its output
-                if ( !isCached || !canCacheProcessor )
-                {
-                    // cannot cache this processor and we're caching ? write all contents
-                    // of the channelBuffer into the channels cache
-                    if ( mustCache && !canCacheProcessor )
-                        mustCache = !writeChannelCache( channel, channelBuffer, cacheReadPos );
+        // write the channel buffers into the combined output buffer, apply channel volume
+        // note this happens in order so the output is equal regardless of parallel channel rendering
 
-                    processor->process( channelBuffer, channel->isMono );
-                }
-            }
+        for ( j = 0; j < channelAmount; ++j )
+        {
+            AudioChannel* channel = channels->at( j );
 
-            // write cache if it didn't happen yet ;) (bus processors are (currently) non-cacheable)
-            if ( mustCache ) {
-                mustCache = !writeChannelCache( channel, channelBuffer, cacheReadPos );
+            if ( channel->getOutputBuffer() == nullptr ) {
+                continue;
             }
+            SAMPLE_TYPE channelVolume = getChannelMixVolume( channel, Sequencer::audibleChannels );
 
-            // write the channel buffer into the combined output buffer, apply channel volume
             // (note live events are always audible as their volume is relative to the instrument)
             if ( channel->hasLiveEvents && channelVolume == SILENCE ) {
                 channelVolume = MAX_VOLUME;
@@ -587,169 +632,119 @@ namespace MWEngine {
             if ( groupAmount == 0 || !ChannelUtility::channelBelongsToGroup( channel, groups )) {
                 channel->mixBuffer( inBuffer, channelVolume );
             }
+
+            if ( stemCapture != nullptr ) {
+                stemCapture->captureChannel( channel, channelVolume );
+            }
         }
 
         // apply group effects onto the mix buffer
 
+        PROFILE_START( groupsStart );
         for ( j = 0; j < groupAmount; ++j ) {
-            groups[ j ]->applyEffectsToChannels( inBuffer );
+            if ( groups[ j ]->applyEffectsToChannels( inBuffer ) && stemCapture != nullptr ) {
+                stemCapture->captureGroup( groups[ j ] );
+            }
         }
+        PROFILE_STOP( groupsStart, GROUPS );
 
         // apply master bus processors (e.g. high/low pass filters, limiter, etc.) onto the mix buffer
 
-        std::vector<BaseProcessor*> processors = masterBus->getActiveProcessors();
+        PROFILE_START( masterBusStart );
+        auto& processors = masterBus->getActiveProcessors();
 
         for ( j = 0; j < processors.size(); ++j ) {
             processors[ j ]->process( inBuffer, isMono );
         }
+        PROFILE_STOP( masterBusStart, MASTER_BUS );
 
         // write the accumulated buffers into the output buffer
 
-        for ( i = 0, c = 0; i < amountOfSamples; i++, c += outputChannels )
-        {
-            for ( ci = 0; ci < outputChannels; ci++ )
-            {
-                // apply the master volume onto the output
-                sample = ( float ) inBuffer->getBufferForChannel(( int ) ci )[ i ] * volume;
+        PROFILE_START( outputStart );
 
-                // write output interleaved (e.g. a sample per output channel
-                // before continuing writing the next sample for the next channel range)
-                outBuffer[ c + ci ] = ( float ) capSampleSafe( sample );
-            }
+        // apply the master volume and write the output interleaved (e.g. a sample per output
+        // channel before continuing writing the next sample for the next channel range)
 
-            // update the buffer pointers and sequencer position
-            if ( Sequencer::playing )
-            {
-                if ( bufferPosition % samples_per_step == 0 )
-                {
-                    // for higher accuracy we must calculate using floating point precision, it
-                    // is a more expensive calculation than using integer modulo though, so we check
-                    // only when the integer modulo operation check has passed
-                    // TODO : this attempted fmod calculation is inaccurate.
-                    //if ( std::fmod(( float ) bufferPosition, samples_per_step ) == 0 )
-                        handleSequencerPositionUpdate(( int ) i );
-                }
-                if ( marked_buffer_position > 0 && bufferPosition == marked_buffer_position ) {
-                     Notifier::broadcast( Notifications::MARKER_POSITION_REACHED );
-                }
-                bufferPosition++;
+        BufferUtility::writeBufferInterleaved( inBuffer, outBuffer, amountOfSamples, outputChannels, volume );
 
-                if ( bufferPosition > max_buffer_position ) {
-                    bufferPosition = min_buffer_position;
-                }
-            }
-        }
+        // update the buffer pointers and sequencer position
 
-        // thread has been stopped during operations above ? exit as writing the
-        // output into the audio hardware will lock execution until the next buffer
-        // is enqueued (additionally, we prevent writing to device storage when recording/bouncing)
-
-        if ( !AudioEngineProps::isRendering.load() ) {
-            return false;
+        if ( Sequencer::playing ) {
+            advanceSequencerPosition( amountOfSamples );
         }
+        PROFILE_STOP( outputStart, OUTPUT );
+        PROFILE_STOP_CYCLE( cycleStart, amountOfSamples );
 
-        // write the synthesized output into the audio driver (unless we are bouncing as writing the
-        // output to the hardware makes it both unnecessarily audible and stalls execution)
+        return outBuffer;
+    }
 
-        if ( !recordingState.bouncing ) {
-            DriverAdapter::writeOutput( outBuffer, amountOfSamples * outputChannels );
-        }
+    /* internal methods */
 
-#ifdef RECORD_TO_DISK
-        // write the output to disk if a recording state is active
-        if (( Sequencer::playing && recordingState.outputToFile ) || recordingState.inputToFile )
-        {
-#ifdef RECORD_DEVICE_INPUT
+    void AudioEngine::allocateRenderBuffers()
+    {
+        renderedFrames = 0;
+        bufferFrame    = 0;
 
-            // recording from device input ?
-            if ( recordingState.inputToFile ) {
-                // if we are recording WITH the processing chain, write to disk (otherwise pre-mix
-                // buffer was already written to disk prior to applying the processing chain)
-                if ( recordingState.recordInputWithChain ) {
-                    DiskWriter::appendBuffer( inputChannel->getOutputBuffer() );
-                }
-            } else {
-#endif
+        channels       = new std::vector<AudioChannel*>();
+        outputChannels = AudioEngineProps::OUTPUT_CHANNELS;
+        isMono         = ( outputChannels == 1 );
 
-                    // recording global output ? > write the combined output buffer
+        // preallocate the channel list (the Sequencer collects a channel per instrument on each render cycle)
+        // leaving room for instruments created during playback
 
-                    bool isFullDuplexRecording = recordingState.correctLatency;
+        channels->reserve( std::max(( size_t ) 64, Sequencer::instruments.size() * 2 ));
+        Sequencer::instruments.reserve( std::max(( size_t ) 64, Sequencer::instruments.size() * 2 ));
 
-                    if ( recordingState.recordDeviceInput && inputChannel->muted ) {
-                        if ( isFullDuplexRecording ) {
-                            // use alternative DiskWriter method to append and instantly mix the input when correcting latency
-                            DiskWriter::appendDuplexBuffers( outBuffer,
-                                                             inputChannel->getOutputBuffer(),
-                                                             amountOfSamples, outputChannels,
-                                                             recordingState.latency );
-                        } else {
-                            // if no latency correction is applied, mix the input with the output
-                            // since we were also recording device input with a muted input channel, we first
-                            // mix the input (not audible in the written driver output) into the output buffer
-                            inputChannel->mixBuffer( inBuffer, inputChannel->getVolume() );
-                            BufferUtility::mixBufferInterleaved( inBuffer, outBuffer, amountOfSamples, outputChannels );
-                        }
-                    }
-
-                    if ( !isFullDuplexRecording ) {
-                        // actual writing of audio into the DiskWriter buffer
-                        DiskWriter::appendBuffer( outBuffer, amountOfSamples, outputChannels );
-                    }
+        delete[] outBuffer;
+        outBuffer = new float[ AudioEngineProps::BUFFER_SIZE * outputChannels ]();
 
 #ifdef RECORD_DEVICE_INPUT
-            }
-#endif
-            // are we bouncing the current sequencer range and have we played through the full range?
 
-            if ( recordingState.bouncing && ( loopStarted || bufferPosition == recordingState.bounceRangeStart || bufferPosition >= recordingState.bounceRangeEnd ))
-            {
-                // write current snippet onto disk and finish recording
-                // (this can be done synchronously as rendering will now halt)
+        // generate the input buffer used for recording from the device's input
+        // as well as the temporary buffer used to merge the input into
 
-                DiskWriter::finish();
+        recbufferIn  = new float[ AudioEngineProps::BUFFER_SIZE * AudioEngineProps::INPUT_CHANNELS ]();
+        inputChannel->createOutputBuffer();
 
-                // broadcast update via JNI
+#endif
+        // accumulates all channels ("master strip")
 
-                Notifier::broadcast( Notifications::BOUNCE_COMPLETE );
+        inBuffer = new ResizableAudioBuffer( outputChannels, AudioEngineProps::BUFFER_SIZE );
 
-                // stops thread, halts rendering
+        // spawn the worker threads for parallel channel rendering (when requested)
 
-                stop();
-                Sequencer::playing = false;
+        if ( renderWorkers > 0 ) {
+            workerPool = new WorkerPool( renderWorkers, AudioEngineProps::CPU_CORES );
+        }
 
-                recordingState.bouncing = false;
-                recordingState.outputToFile = false;
+        // ensure all AudioChannel buffers have the correct properties (in case engine is
+        // restarting after changing buffer size, for instance)
 
-                return false;
-            }
-            DiskWriter::updateSnippetProgress( false, true );
-        }
-#endif
-        // tempo update queued ?
-        if ( queuedTempo != tempo ) {
-            handleTempoUpdate( queuedTempo, true );
-        }
+        std::vector<BaseInstrument*> instruments = Sequencer::instruments;
 
-#ifdef PREVENT_CPU_FREQUENCY_SCALING
+        for ( auto & instrument : instruments ) {
+            instrument->audioChannel->createOutputBuffer();
+        }
+    }
 
-        int64_t renderEnd      = PerfUtility::now();
-        int64_t renderDuration = renderEnd - renderStart;
-        int64_t loadDuration   = expectedRenderDuration - renderDuration; // total time to apply stabilizing load
+    void AudioEngine::releaseRenderBuffers()
+    {
+        delete channels;
+        delete[] outBuffer;
+        delete inBuffer;
+        delete workerPool;
 
-        _noopsPerTick     = PerfUtility::applyCPUStabilizingLoad( renderEnd + loadDuration, _noopsPerTick );
-        _renderedSamples += amountOfSamples;
+        channels   = nullptr;
+        outBuffer  = nullptr;
+        inBuffer   = nullptr;
+        workerPool = nullptr;
 
+#ifdef RECORD_DEVICE_INPUT
+        delete[] recbufferIn;
+        recbufferIn = nullptr;
 #endif
-
-        // bit fugly, during bounce on AAudio driver, keep render loop going until bounce completes
-        if ( recordingState.bouncing && AudioEngineProps::isRendering.load() && DriverAdapter::isAAudio() ) {
-            render( amountOfSamples );
-        }
-        return AudioEngineProps::isRendering.load();
     }
 
-    /* internal methods */
-
     void AudioEngine::createOutputBuffer()
     {
 #ifndef MOCK_ENGINE
@@ -820,6 +815,58 @@ namespace MWEngine {
         }
     }
 
+    void AudioEngine::advanceSequencerPosition( int amountOfSamples )
+    {
+        // rather than inspecting each sample, we calculate which step boundaries and marker
+        // position fall within the current buffer, broadcasting their notifications in
+        // order of occurrence. The buffer is divided into segments at the loop boundary
+
+        int i = 0;
+
+        while ( i < amountOfSamples )
+        {
+            // the amount of samples to advance until the loop end is reached (when the position
+            // exceeds the loop range, it will be reset to the loop start after a single sample)
+
+            int segmentLength = std::max( 1, std::min( amountOfSamples - i, ( max_buffer_position - bufferPosition ) + 1 ));
+            int segmentStart  = bufferPosition;
+            int segmentEnd    = segmentStart + segmentLength;
+
+            // the first step boundary within the segment
+
+            int step = segmentStart + ( samples_per_step - segmentStart % samples_per_step ) % samples_per_step;
+
+            bool reachesMarker = marked_buffer_position > 0 &&
+                                 marked_buffer_position >= segmentStart && marked_buffer_position < segmentEnd;
+
+            for ( ; step < segmentEnd; step += samples_per_step )
+            {
+                if ( reachesMarker && marked_buffer_position < step ) {
+                    broadcastMarkerPosition( i + ( marked_buffer_position - segmentStart ));
+                    reachesMarker = false;
+                }
+                bufferPosition = step;
+                handleSequencerPositionUpdate( i + ( step - segmentStart ));
+            }
+
+            if ( reachesMarker ) {
+                broadcastMarkerPosition( i + ( marked_buffer_position - segmentStart ));
+            }
+            i += segmentLength;
+            bufferPosition = segmentEnd;
+
+            if ( bufferPosition > max_buffer_position ) {
+                bufferPosition = min_buffer_position;
+            }
+        }
+    }
+
+    void AudioEngine::broadcastMarkerPosition( int bufferOffset )
+    {
+        bufferPosition = marked_buffer_position;
+        Notifier::broadcastAtFrame( bufferFrame + bufferOffset, Notifications::MARKER_POSITION_REACHED );
+    }
+
     void AudioEngine::handleSequencerPositionUpdate( int bufferOffset )
     {
         stepPosition = ( int ) floor( bufferPosition / samples_per_step );
@@ -827,7 +874,128 @@ namespace MWEngine {
         if ( stepPosition > max_step_position )
             stepPosition = min_step_position;
 
-        Notifier::broadcast( Notifications::SEQUENCER_POSITION_UPDATED, bufferOffset );
+        Notifier::broadcastAtFrame( bufferFrame + bufferOffset, Notifications::SEQUENCER_POSITION_UPDATED, bufferOffset );
+    }
+
+    void AudioEngine::renderChannel( AudioChannel* channel, int amountOfSamples, size_t channelAmount )
+    {
+        size_t k;
+
+        bool isCached    = channel->hasCache;                // whether this channel has a fully cached buffer
+        bool mustCache   = AudioEngineProps::CHANNEL_CACHING && channel->canCache() && !isCached; // whether to cache this channels output
+        int cacheReadPos = 0;  // the offset we start ready from the channel buffer (when writing to cache)
+
+        auto& audioEvents = channel->audioEvents; // note: populated by the Sequencer within this render cycle
+        unsigned long amount = audioEvents.size();
+
+        SAMPLE_TYPE channelVolume = getChannelMixVolume( channel, channelAmount );
+
+        // get channel output buffer and clear previous contents
+        ResizableAudioBuffer* channelBuffer = channel->getOutputBuffer();
+        if ( channelBuffer == nullptr ) return;
+
+        channelBuffer->resize( amountOfSamples ); // keep output buffer size in sync with driver requested sample size
+        channelBuffer->silenceBuffers();
+
+        bool useChannelRange  = channel->maxBufferPosition != 0; // channel has its own buffer range (i.e. drummachine)
+        int maxBufferPosition = useChannelRange ? channel->maxBufferPosition : max_buffer_position;
+
+        // we make a copy of the current buffer position indicator
+        int bufferPos = bufferPosition;
+
+        // ...in case the AudioChannels maxBufferPosition differs from the sequencer loop range
+        // note that these buffer positions are always a full measure in length (as we loop by measures)
+        while ( bufferPos > maxBufferPosition ) {
+            bufferPos -= samples_per_bar;
+        }
+
+        // only render sequenced events when the sequencer isn't in the paused state
+        // and the channel volume is actually at an audible level! ( > 0 )
+
+        PROFILE_START( eventsStart );
+
+        BaseInstrument* instrument = channel->instrument;
+
+        if ( instrument != nullptr )
+            instrument->beginEventMix( channelBuffer );
+
+        if ( Sequencer::playing && amount > 0 && channelVolume > SILENCE )
+        {
+            if ( !isCached )
+            {
+                // write the audioEvent buffers into the main output buffer
+                for ( k = 0; k < amount; ++k )
+                {
+                    BaseAudioEvent* audioEvent = audioEvents[ k ];
+
+                    if ( audioEvent != nullptr )
+                    {
+                        audioEvent->mixBuffer( channelBuffer, bufferPos, min_buffer_position,
+                                               maxBufferPosition, loopStarted, loopOffset, useChannelRange );
+                    }
+                }
+            }
+            else {
+                channel->readCachedBuffer( channelBuffer, bufferPos );
+            }
+        }
+
+        // perform live rendering for this channels instrument
+        if ( channel->hasLiveEvents )
+        {
+            size_t lAmount = channel->liveEvents.size();
+
+            for ( k = 0; k < lAmount; ++k )
+            {
+                BaseAudioEvent* liveEvent = channel->liveEvents[ k ];
+                liveEvent->mixBuffer( channelBuffer );
+            }
+        }
+
+        if ( instrument != nullptr )
+            instrument->endEventMix();
+
+        PROFILE_STOP_CHANNEL( eventsStart, CHANNEL_EVENTS, channel );
+
+        // apply the processing chains processors / modulators
+        ProcessingChain* chain = channel->processingChain;
+        auto& processors = chain->getActiveProcessors();
+
+        for ( k = 0; k < processors.size(); ++k )
+        {
+            BaseProcessor* processor = processors[ k ];
+            bool canCacheProcessor   = processor->isCacheable();
+
+            // only apply processor when we're not caching or cannot cache its output
+            if ( !isCached || !canCacheProcessor )
+            {
+                // cannot cache this processor and we're caching ? write all contents
+                // of the channelBuffer into the channels cache
+                if ( mustCache && !canCacheProcessor )
+                    mustCache = !writeChannelCache( channel, channelBuffer, cacheReadPos );
+
+                PROFILE_START( processorStart );
+                processor->process( channelBuffer, channel->isMono );
+                PROFILE_STOP_PROCESSOR( processorStart, channel, processor );
+            }
+        }
+
+        // write cache if it didn't happen yet ;) (bus processors are (currently) non-cacheable)
+        if ( mustCache ) {
+            writeChannelCache( channel, channelBuffer, cacheReadPos );
+        }
+    }
+
+    void AudioEngine::renderChannelTask( size_t channelIndex, void* amountOfSamples )
+    {
+        RT_SAFETY_SCOPE(); // invoked by the WorkerPool threads
+        renderChannel( channels->at( channelIndex ), *static_cast<int*>( amountOfSamples ), Sequencer::audibleChannels );
+    }
+
+    SAMPLE_TYPE AudioEngine::getChannelMixVolume( AudioChannel* channel, size_t channelAmount )
+    {
+        // divide the channels volume by the amount of channels to provide extra headroom
+        return ( SAMPLE_TYPE ) channel->getVolumeLogarithmic() / ( SAMPLE_TYPE ) channelAmount;
     }
 
     bool AudioEngine::writeChannelCache( AudioChannel* channel, AudioBuffer* channelBuffer, int cacheReadPos )
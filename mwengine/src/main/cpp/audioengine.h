@@ -29,6 +29,8 @@
 #include "global.h"
 #include "processingchain.h"
 #include "resizable_audiobuffer.h"
+#include "utilities/stemcapture.h"
+#include "workerpool.h"
 #include <definitions/drivers.h>
 #include <thread>
 
@@ -52,6 +54,16 @@ class AudioEngine
 
         static AudioChannel* getInputChannel();
 
+        /**
+         * Renders the AudioChannels in parallel using given amount of worker threads
+         * (in addition to the render thread, which sums the rendered channels into the
+         * output in order, keeping the output identical to the serial render). The workers
+         * are spawned (and pinned to the CPU cores, see AudioEngineProps::CPU_CORES) when the
+         * engine starts. Pass 0 to disable parallel rendering (default).
+         */
+        static void setRenderWorkers( int amountOfWorkers );
+        static int getRenderWorkers();
+
         /**
          * Records the signal coming from the device input into MWEngine
          * The signal can be mixed into the output or monitored silently
@@ -69,11 +81,10 @@ class AudioEngine
         /**
          * Record the output of the sequencer onto storage
          *
-         * maxBuffers {int} the total recorded buffer size to store in memory
-         *                  before writing the recorded snippet as .WAV file into
-         *                  the given output file's directory.
-         * outputFile {char*} name of the output WAV file to generate when recording completes
-         *                    (when recording state is disabled), this will concatenate all snippets.
+         * maxBuffers {int} the amount of samples that can be buffered in memory before
+         *                  they must have been written onto storage (see DiskWriter)
+         * outputFile {char*} name of the output WAV file to write the recording into, the
+         *                    file is complete once the recording state is disabled
          */
         static void setRecordOutputToFileState( int maxBuffers, char* outputFile );
         static void unsetRecordOutputToFileState();
@@ -82,10 +93,9 @@ class AudioEngine
          * record audio from the Androids input channel, this stores only the incoming audio
          * not the remaining audio processed / generated by the engine
          *
-         * maxBuffers {int} the total recorded buffer size to store in memory
-         *            before writing the recorded contents as .WAV file into
-         *            the given output directory.
-         * outputFile {char*} name of the folder to write each snippet into
+         * maxBuffers {int} the amount of samples that can be buffered in memory before
+         *            they must have been written onto storage (see DiskWriter)
+         * outputFile {char*} name of the output WAV file to write the recording into
          * skipProcessing {bool} when true, the device input is recorded onto disk dry, when
          *                false, the ProcessingChain of the input channel is applied prior to writing
          */
@@ -100,10 +110,9 @@ class AudioEngine
         static void unsetRecordFullDuplexState();
 
         /**
-         * Save the contents of the snippet at given buffer index
-         * onto storage. This should be invoked from a thread separate to the
-         * audio rendering thread to prevent buffer under runs from happening
-         * while writing the buffer during the rendering of audio output
+         * @deprecated recordings are no longer written in snippets but written onto storage
+         * while recording (by a thread separate to the audio rendering thread), this method
+         * is kept for backwards compatibility and does nothing
          */
         static void saveRecordedSnippet( int snippetBufferIndex );
 
@@ -137,6 +146,22 @@ class AudioEngine
         static bool render( int amountOfSamples );
         static void createOutputBuffer();
 
+        /**
+         * Renders given amount of samples (up to the buffer size) at the current sequencer position into
+         * the interleaved output buffer, advancing the sequencer position when playing. This does not write
+         * into the audio driver nor record the output, it is invoked by render() and the OfflineRenderer.
+         * The render buffers must have been allocated (see allocateRenderBuffers())
+         */
+        static float* renderOutput( int amountOfSamples, bool mixDeviceInput );
+
+        // (de)allocates the buffers used during rendering, invoked when starting/stopping the engine
+
+        static void allocateRenderBuffers();
+        static void releaseRenderBuffers();
+
+        // when set, the channels and groups registered in the StemCapture are recorded during rendering
+        static StemCapture* stemCapture;
+
         static int min_buffer_position;    // the lowest sample offset in the current loop range
         static int max_buffer_position;    // the maximum sample offset in the current loop range
         static int marked_buffer_position; // the buffer position that should launch a notification when playback exceeds this position
@@ -148,6 +173,8 @@ class AudioEngine
         static int bufferPosition; // the current sequence position in samples ("playback head" offset)
         static int stepPosition;   // the current sequence bar subdivided position (e.g. 16th note of a bar)
 
+        static int64_t bufferFrame; // the sample frame (counted since the engine started) the current render cycle starts at
+
         /* tempo related */
 
         static float tempo;                     // the tempo of the sequencer
@@ -180,6 +207,7 @@ class AudioEngine
         static int  loopAmount;   // amount of samples we must read from the current loop ranges start offset (== min_buffer_position)
         static int  outputChannels;
         static bool isMono;
+        static int64_t renderedFrames; // the amount of sample frames rendered since the engine started
         static std::vector<AudioChannel*>* channels;
         static ResizableAudioBuffer* inBuffer;
         static float*  outBuffer;
@@ -187,6 +215,9 @@ class AudioEngine
         static std::thread* thread;
         static bool threadOptimized;
 
+        static int renderWorkers;
+        static WorkerPool* workerPool;
+
 #ifdef PREVENT_CPU_FREQUENCY_SCALING
 
         /* CPU stabilization related */
@@ -207,7 +238,12 @@ class AudioEngine
         /* internal render methods */
 
         static void initRenderTask( Drivers::types audioDriver );
+        static void advanceSequencerPosition     ( int amountOfSamples );
         static void handleSequencerPositionUpdate( int bufferOffset );
+        static void broadcastMarkerPosition      ( int bufferOffset );
+        static void renderChannel                ( AudioChannel* channel, int amountOfSamples, size_t channelAmount );
+        static void renderChannelTask            ( size_t channelIndex, void* amountOfSamples );
+        static SAMPLE_TYPE getChannelMixVolume   ( AudioChannel* channel, size_t channelAmount );
         static bool writeChannelCache            ( AudioChannel* channel, AudioBuffer* channelBuffer, int cacheReadPos );
 };
 } // E.O namespace MWEngine
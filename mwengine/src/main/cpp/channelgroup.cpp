@@ -23,6 +23,7 @@
 #include <channelgroup.h>
 #include <audioengine.h>
 #include <utilities/volumeutil.h>
+#include <algorithm>
 
 namespace MWEngine {
 
@@ -69,6 +70,11 @@ ProcessingChain* ChannelGroup::getProcessingChain()
     return _processingChain;
 }
 
+AudioBuffer* ChannelGroup::getMixBuffer()
+{
+    return _mixBuffer;
+}
+
 bool ChannelGroup::addAudioChannel( AudioChannel* audioChannel )
 {
     if ( !containsAudioChannel( audioChannel )) {
@@ -120,7 +126,7 @@ bool ChannelGroup::applyEffectsToChannels( AudioBuffer* bufferToMixInto )
 
     // apply the processing chain onto the mix buffer
 
-    auto processors = _processingChain->getActiveProcessors();
+    auto& processors = _processingChain->getActiveProcessors();
     total = processors.size();
 
     for ( i = 0; i < total; ++i ) {
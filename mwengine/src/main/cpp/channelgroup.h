@@ -46,6 +46,10 @@ class ChannelGroup
 
         ProcessingChain* getProcessingChain();
 
+        // the processed mix of the groups channels (prior to applying the group volume)
+        // of the last render cycle
+        AudioBuffer* getMixBuffer();
+
         bool addAudioChannel( AudioChannel* audioChannel );
         bool removeAudioChannel( AudioChannel* audioChannel );
         bool containsAudioChannel( AudioChannel* audioChannel );
@@ -44,9 +44,9 @@ class Notifications
 
             /* recording actions */
 
-            RECORDED_SNIPPET_READY,     // single snippet is ready for writing to storage
-            RECORDED_SNIPPET_SAVED,     // single snippet has been written to storage and flushed from memory
-            RECORDING_COMPLETED,        // recording has completed in full all snippets have been saved into requested output file, memory and temp files flushed
+            RECORDED_SNIPPET_READY,     // deprecated : no longer broadcast as recordings are written while recording (see DiskWriter)
+            RECORDED_SNIPPET_SAVED,     // deprecated : no longer broadcast as recordings are written while recording (see DiskWriter)
+            RECORDING_COMPLETED,        // recording has completed in full and has been written into the requested output file
             BOUNCE_COMPLETE,            // bouncing has completed, see RECORDING_COMPLETED
 
             /* system messages */
@@ -29,8 +29,10 @@ namespace DriverAdapter {
 
     Drivers::types _driver       = Drivers::types::OPENSL;
 
+#ifdef __ANDROID__
     AAudio_IO* driver_aAudio     = nullptr;
     OPENSL_STREAM* driver_openSL = nullptr;
+#endif
 #ifdef MOCK_ENGINE
     Mock_IO*       driver_mocked = nullptr;
 #endif
@@ -39,9 +41,11 @@ namespace DriverAdapter {
 
         destroy(); // destroy existing drivers
 
+#ifdef __ANDROID__
         if ( driver == Drivers::AAUDIO && !AAudio_IO::isSupported() ) {
             driver = Drivers::OPENSL; // fall back to OpenSL when AAudio isn't supported
         }
+#endif
 
         _driver = driver;
         int bursts;
@@ -51,6 +55,7 @@ namespace DriverAdapter {
             default:
                 return false;
 
+#ifdef __ANDROID__
             case Drivers::OPENSL:
 
                 Debug::log( "DriverAdapter::initializing OpenSL driver" );
@@ -88,6 +93,7 @@ namespace DriverAdapter {
                 driver_aAudio->setBufferSizeInBursts( bursts );
 
                 return true;
+#endif
 
 #ifdef MOCK_ENGINE
 
@@ -103,6 +109,7 @@ namespace DriverAdapter {
 
     void destroy() {
 
+#ifdef __ANDROID__
         if ( driver_openSL != nullptr ) {
             android_CloseAudioDevice( driver_openSL );
         }
@@ -110,6 +117,7 @@ namespace DriverAdapter {
 
         delete driver_aAudio;
         driver_aAudio = nullptr;
+#endif
 
 #ifdef MOCK_ENGINE
         delete driver_mocked;
@@ -159,12 +167,14 @@ namespace DriverAdapter {
                 driver_mocked->writeOutput( outputBuffer, amountOfSamples );
                 break;
 #endif
+#ifdef __ANDROID__
             case Drivers::OPENSL:
                 android_AudioOut( driver_openSL, outputBuffer, amountOfSamples );
                 break;
             case Drivers::AAUDIO:
                 driver_aAudio->enqueueOutputBuffer( outputBuffer, amountOfSamples );
                 break;
+#endif
         }
     }
 
@@ -176,10 +186,12 @@ namespace DriverAdapter {
             case Drivers::MOCKED:
 #endif
                 return 0;
+#ifdef __ANDROID__
             case Drivers::OPENSL:
                 return android_AudioIn( driver_openSL, recordBuffer, amountOfSamples );
             case Drivers::AAUDIO:
                 return driver_aAudio->getEnqueuedInputBuffer( recordBuffer );
+#endif
         }
     }
 
@@ -191,10 +203,12 @@ namespace DriverAdapter {
             case Drivers::MOCKED:
 #endif
                 return 0;
+#ifdef __ANDROID__
             case Drivers::OPENSL:
                 return 0; // TODO (if we care...) how to calculate latency using OpenSL driver
             case Drivers::AAUDIO:
                 return driver_aAudio->getOutputLatency();
+#endif
         }
     }
 }
@@ -25,8 +25,10 @@
 
 #include "../global.h"
 #include <definitions/drivers.h>
+#ifdef __ANDROID__
 #include "aaudio_io.h"
 #include "opensl_io.h"
+#endif
 
 #ifdef MOCK_ENGINE
 #include "mock_io.h"
@@ -72,8 +74,10 @@ namespace DriverAdapter {
     /* internal variables */
 
     extern Drivers::types _driver;
+#ifdef __ANDROID__
     extern OPENSL_STREAM* driver_openSL;
     extern AAudio_IO*     driver_aAudio;
+#endif
 
 #ifdef MOCK_ENGINE
     extern Mock_IO*       driver_mocked;
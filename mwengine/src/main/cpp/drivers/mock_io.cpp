@@ -44,7 +44,11 @@ int Mock_IO::writeOutput( float *buffer, int size )
     int outputChannels   = AudioEngineProps::OUTPUT_CHANNELS;
     int singleBufferSize = size / outputChannels;
 
-    Debug::log( "Audio Engine test %d running", MockData::test_program );
+    // the benchmark is not logged as it would affect the measured render performance
+
+    if ( MockData::test_program != 5 ) {
+        Debug::log( "Audio Engine test %d running", MockData::test_program );
+    }
 
     switch ( MockData::test_program )
     {
@@ -198,11 +202,46 @@ int Mock_IO::writeOutput( float *buffer, int size )
             }
 
             break;
+
+        case 4: // parallel rendering test
+
+            if ( Sequencer::playing )
+            {
+                // record the output, the contents are compared across render modes in audioengine_test.cpp
+
+                MockData::recorded_output.insert( MockData::recorded_output.end(), buffer, buffer + size );
+
+                if ( ++MockData::render_iterations == MockData::max_render_iterations )
+                {
+                    Debug::log( "Audio Engine test %d done", MockData::test_program );
+                    AudioEngine::stop();
+                }
+            }
+            break;
+
+        case 5: // benchmark (renders for the requested amount of iterations without evaluating the output)
+
+            if ( ++MockData::render_iterations == MockData::max_render_iterations ) {
+                AudioEngine::stop();
+            }
+            break;
+
+        case 6: // real-time safety test (alternates the tempo, applied by the render thread in the next iteration)
+
+            if ( ++MockData::render_iterations == MockData::max_render_iterations ) {
+                AudioEngine::stop();
+            }
+            else if ( MockData::render_iterations % 4 == 0 ) {
+                AudioEngine::queuedTempo = AudioEngine::tempo == 120.f ? 90.f : 120.f;
+            }
+            break;
     }
     return size;
 }
 
-bool  MockData::engine_started    = false;
-int   MockData::test_program      = 0;
-bool  MockData::test_successful   = false;
-int   MockData::render_iterations = 0;
+bool  MockData::engine_started        = false;
+int   MockData::test_program          = 0;
+bool  MockData::test_successful       = false;
+int   MockData::render_iterations     = 0;
+int   MockData::max_render_iterations = 0;
+std::vector<float> MockData::recorded_output;
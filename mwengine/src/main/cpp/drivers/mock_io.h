@@ -24,6 +24,7 @@
 #define __MWENGINE__MOCK_ENGINE_INCLUDED__
 
 #include <global.h>
+#include <vector>
 
 /**
  * The mock engine is used during unit testing
@@ -65,6 +66,8 @@ class MockData {
         static int test_program;
         static bool test_successful;
         static int render_iterations;
+        static int max_render_iterations;
+        static std::vector<float> recorded_output;
 };
 }
 #endif
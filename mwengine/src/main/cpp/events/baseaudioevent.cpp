@@ -24,8 +24,8 @@
 #include <global.h>
 #include <audioengine.h>
 #include <instruments/baseinstrument.h>
+#include <messaging/commandqueue.h>
 #include <utilities/bufferutility.h>
-#include <utilities/eventutility.h>
 #include <utilities/volumeutil.h>
 #include <algorithm>
 #include <sequencer.h>
@@ -47,14 +47,24 @@ BaseAudioEvent::BaseAudioEvent( BaseInstrument* instrument )
 
 BaseAudioEvent::~BaseAudioEvent()
 {
-    dispose();
+    removeFromInstrument();
+
+    // when the engine is rendering, the removal is applied by the render thread
+    // wait for it to complete before this events buffer and memory are freed
+    // (returns immediately when the event was detached and the removal applied beforehand)
+
+    CommandQueue::synchronize();
+    destroyBuffer();
 }
 
 /* public methods */
 
 void BaseAudioEvent::dispose()
 {
-    removeFromSequencer();
+    // the buffer can only be freed once the render thread has applied the removal
+
+    removeFromInstrument();
+    CommandQueue::synchronize();
     destroyBuffer();
 }
 
@@ -65,6 +75,15 @@ BaseInstrument* BaseAudioEvent::getInstrument()
 
 void BaseAudioEvent::setInstrument( BaseInstrument* aInstrument )
 {
+    // passing a nullptr detaches this event from its current instrument
+    // (e.g. when the instrument is destroyed while the event lives on)
+
+    if ( aInstrument == nullptr )
+    {
+        removeFromInstrument();
+        return;
+    }
+
     // swap instrument if new one is different to existing reference
     // additionally, if event was added to the sequencer, add it to the new
     // instruments sequenced events list
@@ -126,6 +145,9 @@ void BaseAudioEvent::addToSequencer()
 
     // adds the event to the sequencer so it can be heard
 
+    if ( _instrument == nullptr ) {
+        return;
+    }
     if ( isSequenced ) {
         _instrument->addEvent( this, false );
     }
@@ -484,10 +506,29 @@ void BaseAudioEvent::init()
     _endPosition       = 0.F;
     _instrument        = nullptr;
     _removalEnqueued   = false;
+    _addedToSequencer  = false;
     _livePlayback      = false;
     isSequenced        = true;
 }
 
+void BaseAudioEvent::removeFromInstrument()
+{
+    if ( _instrument == nullptr ) {
+        return;
+    }
+
+    // only post the removals for the lists this event can be part of, as such destroying
+    // events that were detached beforehand doesn't need to await the render thread
+
+    if ( isAddedToSequencer() ) {
+        _instrument->removeEvent( this, false );
+    }
+    if ( _livePlayback ) {
+        _instrument->removeEvent( this, true );
+    }
+    _instrument = nullptr;
+}
+
 void BaseAudioEvent::destroyBuffer()
 {
     if ( _destroyableBuffer && _buffer != nullptr )
@@ -499,11 +540,24 @@ void BaseAudioEvent::destroyBuffer()
 
 bool BaseAudioEvent::isAddedToSequencer()
 {
-    if ( _instrument != nullptr )
-    {
-        return EventUtility::vectorContainsEvent( _instrument->getEvents(), this );
+    if ( _instrument == nullptr ) {
+        return false;
     }
-    return false;
+
+    // the state is maintained by the instrument upon each addition and removal (rather than searching
+    // its event list, which the render thread mutates while the engine is rendering, see CommandQueue)
+
+    return _addedToSequencer.load();
+}
+
+void BaseAudioEvent::setAddedToSequencer( bool value )
+{
+    _addedToSequencer.store( value );
+}
+
+void BaseAudioEvent::applyUpdate()
+{
+    // override in derived class
 }
 
 /* TO BE DEPRECATED */
@@ -24,6 +24,7 @@
 #define __MWENGINE__BASEAUDIOEVENT_H_INCLUDED__
 
 #include "../audiobuffer.h"
+#include <atomic>
 
 namespace MWEngine {
 
@@ -86,6 +87,14 @@ class BaseAudioEvent
         virtual void setBuffer( AudioBuffer* buffer, bool destroyable );
         virtual bool hasBuffer();
 
+        // whether this event is added to the instruments sequenced events list
+        // (maintained by the instrument, see BaseInstrument::addEvent())
+
+        void setAddedToSequencer( bool value );
+
+        // applies the state changes of the event that were prepared by a control thread (see CommandQueue::UPDATE_EVENT)
+        virtual void applyUpdate();
+
 #endif
 
         virtual BaseInstrument* getInstrument(); // retrieve reference to the instrument this event belongs to
@@ -188,6 +197,7 @@ class BaseAudioEvent
     protected:
 
         virtual void init(); // basic initialization which can be shared across derived classes
+        void removeFromInstrument(); // removes event from its instruments event lists and detaches it (doesn't await the removal)
 
         float _volume;
         int _eventStart;
@@ -201,9 +211,10 @@ class BaseAudioEvent
 
         // properties
         bool _enabled;
-        bool _livePlayback;
+        std::atomic<bool> _livePlayback; // reset by the render thread when removed from the live events list
 
         bool isAddedToSequencer();   // whether this event exists in the instruments event list (and is eligible for playback)
+        std::atomic<bool> _addedToSequencer;
         BaseInstrument* _instrument; // the BaseInstrument this event belongs to
 
         // cached buffer
@@ -24,7 +24,10 @@
 #include "../audioengine.h"
 #include "../sequencer.h"
 #include "../global.h"
+#include <definitions/waveforms.h>
 #include <instruments/synthinstrument.h>
+#include <messaging/commandqueue.h>
+#include <utilities/bufferpool.h>
 #include <cmath>
 
 namespace MWEngine {
@@ -36,6 +39,10 @@ unsigned int BaseSynthEvent::INSTANCE_COUNT = 0;
 BaseSynthEvent::BaseSynthEvent()
 {
     // uses BaseAudioEvent constructor
+
+    for ( int i = 0; i < MAX_OSCILLATOR_AMOUNT; ++i ) {
+        ringBuffers[ i ] = nullptr;
+    }
 }
 
 /**
@@ -65,7 +72,12 @@ BaseSynthEvent::BaseSynthEvent( float aFrequency, SynthInstrument* aInstrument )
 
 BaseSynthEvent::~BaseSynthEvent()
 {
+    // ensure the event is no longer rendered before releasing its ring buffers
+
+    removeFromInstrument();
+    CommandQueue::synchronize();
 
+    BufferPool::destroyRingBuffersForEvent( this );
 }
 
 /* public methods */
@@ -124,6 +136,36 @@ void BaseSynthEvent::stop()
     }
 }
 
+void BaseSynthEvent::addToSequencer()
+{
+    // acquire the ring buffers for the Karplus-Strong oscillators on the control
+    // thread (as reserving these allocates) before the event becomes eligible for playback
+
+    SynthInstrument* instrument = getSynthInstrument();
+
+    if ( isSequenced && instrument != nullptr && !isAddedToSequencer() )
+    {
+        bool assigned = false;
+
+        for ( int i = 0, l = instrument->getOscillatorAmount(); i < l; ++i )
+        {
+            if ( instrument->getOscillatorProperties( i )->getWaveform() != WaveForms::KARPLUS_STRONG ||
+                 ringBuffers[ i ].load() != nullptr ) {
+                continue;
+            }
+            BufferPool::reserveRingBuffers( 1 );
+            assigned = BufferPool::assignRingBuffer( this, i ) != nullptr || assigned;
+        }
+
+        // fill the newly assigned ring buffers with noise
+
+        if ( assigned ) {
+            instrument->synthesizer->initializeEventProperties( this, true );
+        }
+    }
+    BaseAudioEvent::addToSequencer();
+}
+
 int BaseSynthEvent::getEventEnd()
 {
     // SynthEvents might have a longer duration if they have a positive release envelope
@@ -164,12 +206,12 @@ void BaseSynthEvent::setFrequency( float aFrequency, bool storeAsBaseFrequency )
 
 SAMPLE_TYPE BaseSynthEvent::getPhaseForOscillator( int aOscillatorNum )
 {
-    return cachedProps.oscillatorPhases.at( aOscillatorNum );
+    return cachedProps.oscillatorPhases[ aOscillatorNum ];
 }
 
 void BaseSynthEvent::setPhaseForOscillator( int aOscillatorNum, SAMPLE_TYPE aPhase )
 {
-    cachedProps.oscillatorPhases.at( aOscillatorNum ) = aPhase;
+    cachedProps.oscillatorPhases[ aOscillatorNum ] = aPhase;
 }
 
 void BaseSynthEvent::unlock()
@@ -239,7 +281,7 @@ void BaseSynthEvent::mixBuffer( AudioBuffer* outputBuffer, int bufferPos,
     // extended by a positive release time on the instruments ADSR envelope
     int eventEnd = getEventEnd();
 
-    ResizableAudioBuffer* tempBuffer = getEmptyTempBuffer( outputBuffer->bufferSize );
+    ResizableAudioBuffer* tempBuffer = nullptr;
 
     if (( bufferPos >= _eventStart || bufferEndPos > _eventStart ) &&
           bufferPos < eventEnd )
@@ -257,12 +299,22 @@ void BaseSynthEvent::mixBuffer( AudioBuffer* outputBuffer, int bufferPos,
             released = false;
         }
 
-        // render the snippet into the temp buffer
-        getSynthInstrument()->synthesizer->render( tempBuffer, this );
+        // events playing for the full buffer are preferably rendered in a batch
+        // alongside the other events of the instrument (see VoiceRenderer)
+
+        bool batched = !loopStarted && writeOffset == 0 &&
+                       getSynthInstrument()->getVoiceRenderer()->enqueue( this, outputBuffer );
 
-        // merge temp buffer into the output buffer
-        // note we merge using 1.0 as mix volume as the events volume was applied during synthesis
-        outputBuffer->mergeBuffers( tempBuffer, 0, writeOffset, 1.0 );
+        if ( !batched )
+        {
+            // render the snippet into the temp buffer
+            tempBuffer = getEmptyTempBuffer( outputBuffer->bufferSize );
+            getSynthInstrument()->synthesizer->render( tempBuffer, this );
+
+            // merge temp buffer into the output buffer
+            // note we merge using 1.0 as mix volume as the events volume was applied during synthesis
+            outputBuffer->mergeBuffers( tempBuffer, 0, writeOffset, 1.0 );
+        }
 
         // reset of event properties at end of write
         if ( lastWriteIndex >= _eventLength ) {
@@ -284,6 +336,9 @@ void BaseSynthEvent::mixBuffer( AudioBuffer* outputBuffer, int bufferPos,
             invalidateProperties();
             lastWriteIndex = 0;
 
+            if ( tempBuffer == nullptr )
+                tempBuffer = getEmptyTempBuffer( outputBuffer->bufferSize );
+
             // TODO: specify total render range in ::render method ? this would avoid unnecessary buffer merging ;)
             // also synthesizer now renders a full output buffer size (wasteful)
 
@@ -309,9 +364,43 @@ void BaseSynthEvent::mixBuffer( AudioBuffer* outputBuffer )
     lock();
 
     int bufferSize = outputBuffer->bufferSize;
+
+    VoicePool* voicePool = getSynthInstrument()->getVoicePool();
+    SynthVoice* voice    = voicePool->getVoice( this );
+
+    bool isFading = voice != nullptr && voice->fadeRemaining > 0;
+    bool isEnding = _shouldEnqueueRemoval && ( _minLength - bufferSize ) <= 0;
+
+    // events that are not fading out are preferably rendered in a batch
+    // alongside the other events of the instrument (see VoiceRenderer)
+
+    if ( !isFading && !isEnding && getSynthInstrument()->getVoiceRenderer()->enqueue( this, outputBuffer ))
+    {
+        if ( _shouldEnqueueRemoval )
+            _minLength -= bufferSize;
+
+        unlock();
+        return;
+    }
+
     ResizableAudioBuffer* tempBuffer = getEmptyTempBuffer( bufferSize );
     getSynthInstrument()->synthesizer->render( tempBuffer, this );
 
+    // the voice of this event has been stolen by another live event ? fade out prior to removal
+
+    if ( isFading )
+    {
+        if ( voicePool->applyFade( voice, tempBuffer ))
+        {
+            _hasMinLength = true;
+            enqueueRemoval( true );
+            BaseAudioEvent::stop();
+        }
+        outputBuffer->mergeBuffers( tempBuffer, 0, 0, 1.0 );
+        unlock();
+        return;
+    }
+
     // keep track of the rendered samples, in case of a key up event
     // we still want to have the sound ring for the minimum period
     // defined in the constructor instead of cut off immediately
@@ -419,11 +508,9 @@ void BaseSynthEvent::init( SynthInstrument* aInstrument, float aFrequency,
     cachedProps.arpeggioPosition = 0;
     cachedProps.arpeggioStep     = 0;
 
-    int maxOscillatorAmount = 8; // let's assume a max amount of oscillators of 8 here
-    cachedProps.oscillatorPhases.reserve( maxOscillatorAmount );
-
-    for ( int i = 0; i < maxOscillatorAmount; ++i ) {
-        cachedProps.oscillatorPhases.push_back( 0.0 );
+    for ( int i = 0; i < MAX_OSCILLATOR_AMOUNT; ++i ) {
+        cachedProps.oscillatorPhases[ i ] = 0.0;
+        ringBuffers[ i ] = nullptr;
     }
 
     this->isSequenced     = isSequenced;
@@ -25,11 +25,17 @@
 
 #include <global.h>
 #include <resizable_audiobuffer.h>
+#include <atomic>
 #include "baseaudioevent.h"
 
 namespace MWEngine {
 
 class SynthInstrument;  // forward declaration, see <instruments/synthinstrument.h>
+class RingBuffer;       // forward declaration, see <ringbuffer.h>
+
+// the maximum amount of oscillators an event can be synthesized with (see SynthInstrument::setOscillatorAmount())
+
+const int MAX_OSCILLATOR_AMOUNT = 8;
 
 // will hold references to last known values (see <generators/synthesizer.cpp>)
 
@@ -43,7 +49,7 @@ typedef struct
     int arpeggioPosition;
     int arpeggioStep;
 
-    std::vector<SAMPLE_TYPE> oscillatorPhases;
+    SAMPLE_TYPE oscillatorPhases[ MAX_OSCILLATOR_AMOUNT ];
 
 } CachedProperties;
 
@@ -72,9 +78,14 @@ class BaseSynthEvent : public BaseAudioEvent
 #ifndef SWIG
         // internal to the engine
         bool released;
+
+        // the Karplus-Strong ring buffer for each oscillator when sequenced (taken from the BufferPool, these
+        // are acquired by the control thread upon addToSequencer() or by the render thread when missing)
+        std::atomic<RingBuffer*> ringBuffers[ MAX_OSCILLATOR_AMOUNT ];
 #endif
         void play();
         void stop();
+        void addToSequencer();
 
         int getEventEnd();
         // events with a positive release phase should not directly be removed upon stop() / sequencer removal
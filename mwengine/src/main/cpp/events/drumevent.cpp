@@ -139,7 +139,12 @@ void DrumEvent::updateSample()
                 smp = "hh";
             break;
     }
-    setSample( SampleManager::getSample( smp ));
+    CompactBuffer* compactBuffer = SampleManager::getCompactSample( smp );
+
+    if ( compactBuffer != nullptr )
+        setCompactSample( compactBuffer, AudioEngineProps::SAMPLE_RATE );
+    else
+        setSample( SampleManager::getSample( smp ));
 }
 
 } // E.O namespace MWEngine
@@ -25,9 +25,45 @@
 #include "../audioengine.h"
 #include "../global.h"
 #include "../sequencer.h"
+#include "../utilities/samplemanager.h"
+#include "../messaging/commandqueue.h"
 
 namespace MWEngine {
 
+/* internal methods */
+
+namespace {
+
+    // amount of samples for which the read positions are collected prior to
+    // being interpolated by the resampling kernel (when playing at a custom playback rate)
+
+    const int RESAMPLE_BLOCK_SIZE = 64;
+
+    // sources provide per channel accessors to the sample data for use within the
+    // mixing loops (compact samples decode the stored sample type upon access)
+
+    struct BufferSource
+    {
+        AudioBuffer* buffer;
+
+        inline SAMPLE_TYPE* getChannel( int channel )
+        {
+            return buffer->getBufferForChannel( channel );
+        }
+    };
+
+    template <typename T>
+    struct CompactSource
+    {
+        CompactBuffer* buffer;
+
+        inline CompactBuffer::Channel<T> getChannel( int channel )
+        {
+            return buffer->getChannel<T>( channel );
+        }
+    };
+}
+
 /* constructor / destructor */
 
 SampleEvent::SampleEvent()
@@ -42,7 +78,15 @@ SampleEvent::SampleEvent( BaseInstrument* aInstrument )
 
 SampleEvent::~SampleEvent()
 {
-    // nowt...
+    // the sample can only be released once the render thread no longer reads from it
+
+    removeFromInstrument();
+    CommandQueue::synchronize();
+
+    releaseRetiredSamples( true );
+
+    if ( _retainedBuffer != nullptr )
+        SampleManager::releaseBuffer( _retainedBuffer );
 }
 
 /* public methods */
@@ -53,7 +97,7 @@ void SampleEvent::play()
     // are back at the start (when looping, at the beginning of
     // the entire sample, when playing from a range, at the beginning of the range)
     _readPointer          = std::max( 0, _bufferRangeStart );
-    _readPointerF         = ( float ) _readPointer;
+    _readPhase            = Resampler::fromIndex( _readPointer );
     _lastPlaybackPosition = _bufferRangeStart;
 
     BaseAudioEvent::play();
@@ -63,6 +107,11 @@ void SampleEvent::setEventLength( int value )
 {
     if ( _loopeable ) {
 
+        // keep the instruments event index in sync with the events playback range
+
+        bool mustSyncWithInstrument = isAddedToSequencer();
+        if ( mustSyncWithInstrument ) _instrument->removeEvent( this, false );
+
         _eventLength = value;
 
         // loopeable-events differ from non-loopable events in that
@@ -78,6 +127,8 @@ void SampleEvent::setEventLength( int value )
 
         // update end position in seconds
         _endPosition = BufferUtility::bufferToSeconds( _eventEnd, AudioEngineProps::SAMPLE_RATE );
+
+        if ( mustSyncWithInstrument ) _instrument->addEvent( this, false );
     }
     else {
         BaseAudioEvent::setEventLength( value );
@@ -91,10 +142,15 @@ void SampleEvent::setEventEnd( int value )
         return;
     }
 
+    bool mustSyncWithInstrument = isAddedToSequencer();
+    if ( mustSyncWithInstrument ) _instrument->removeEvent( this, false );
+
     _eventEnd = value;
 
     // update end position in seconds
     _endPosition = BufferUtility::bufferToSeconds( _eventEnd, AudioEngineProps::SAMPLE_RATE );
+
+    if ( mustSyncWithInstrument ) _instrument->addEvent( this, false );
 }
 
 int SampleEvent::getBufferRangeStart()
@@ -111,18 +167,18 @@ void SampleEvent::setBufferRangeStart( int value )
     if ( _rangePointer < _bufferRangeStart )
         _rangePointer = _bufferRangeStart;
 
-    // floating point used for alternate playback rates
+    // fixed point used for alternate playback rates
 
-    if ( _rangePointerF < _bufferRangeStart )
-        _rangePointerF = ( float ) _bufferRangeStart;
+    if ( _rangePhase < Resampler::fromIndex( _bufferRangeStart ))
+        _rangePhase = Resampler::fromIndex( _bufferRangeStart );
 
     if ( _bufferRangeEnd <= _bufferRangeStart )
         _bufferRangeEnd = std::max( _bufferRangeStart + ( _bufferRangeLength - 1 ), _bufferRangeStart );
 
     // buffer range may never exceed the length of the source buffer (which can be unequal to the sample length)
 
-    if ( _buffer != nullptr && _bufferRangeEnd >= _buffer->bufferSize )
-        setBufferRangeEnd( _buffer->bufferSize - 1 );
+    if ( hasBuffer() && _bufferRangeEnd >= getSourceLength() )
+        setBufferRangeEnd( getSourceLength() - 1 );
 
     _bufferRangeLength = ( _bufferRangeEnd - _bufferRangeStart ) + 1;
     setRangeBasedPlayback( _bufferRangeLength != _eventLength );
@@ -136,13 +192,13 @@ int SampleEvent::getBufferRangeEnd()
 void SampleEvent::setBufferRangeEnd( int value )
 {
     // buffer range may never exceed the length of the source buffer (which can be unequal to the sample length)
-    _bufferRangeEnd = ( _buffer != nullptr ) ? std::min( value, _buffer->bufferSize - 1 ): value;
+    _bufferRangeEnd = hasBuffer() ? std::min( value, getSourceLength() - 1 ): value;
 
     if ( _rangePointer > _bufferRangeEnd )
         _rangePointer = _bufferRangeEnd;
 
-    if ( _rangePointerF > getBufferRangeEnd() )
-        _rangePointerF = ( float ) getBufferRangeEnd();
+    if ( _rangePhase > Resampler::fromIndex( getBufferRangeEnd() ))
+        _rangePhase = Resampler::fromIndex( getBufferRangeEnd() );
 
     if ( _bufferRangeStart >= _bufferRangeEnd )
         _bufferRangeStart = std::max( _bufferRangeEnd - 1, 0 );
@@ -180,37 +236,55 @@ bool SampleEvent::setSample( AudioBuffer* sampleBuffer, unsigned int sampleRate
     if ( sampleBuffer == nullptr )
         return false;
 
-    // make sure we lock read/write operations as setting a sample
-    // while the engine is running (thus reading from the current one) is a tad dangerous ;)
+    // is this events buffer destroyable ? then clone
+    // the input buffer, if not, merely point to it to
+    // minimize memory consumption when re-using existing samples
 
-    bool wasLocked = _locked;
-    _locked        = true;
+    AudioBuffer* buffer = _destroyableBuffer ? sampleBuffer->clone() : sampleBuffer;
+    buffer->loopeable   = _loopeable;
 
-    int sampleLength = sampleBuffer->bufferSize;
+    swapSample( buffer, nullptr, _destroyableBuffer ? nullptr : sampleBuffer, sampleBuffer->bufferSize, sampleRate );
 
-    // delete previous contents
-    if ( _eventLength != sampleLength )
-        destroyBuffer();
+    return true;
+}
 
-    // is this events buffer destroyable ? then clone
-    // the input buffer, if not, merely point to it to
-    // minimize memory consumption when re-using existing samples
+bool SampleEvent::setCompactSample( CompactBuffer* sampleBuffer, unsigned int sampleRate )
+{
+    if ( sampleBuffer == nullptr )
+        return false;
 
-    if ( _destroyableBuffer )
-        _buffer = sampleBuffer->clone();
-    else
-        _buffer = sampleBuffer;
+    // CompactBuffers are never cloned, as these are always shared by the SampleManager
+
+    swapSample( nullptr, sampleBuffer, sampleBuffer, sampleBuffer->bufferSize, sampleRate );
+
+    return true;
+}
 
-    _buffer->loopeable = _loopeable;
+CompactBuffer* SampleEvent::getCompactBuffer()
+{
+    return _compactBuffer;
+}
+
+bool SampleEvent::hasBuffer()
+{
+    return _buffer != nullptr || _compactBuffer != nullptr;
+}
+
+void SampleEvent::initSample( int sampleLength, unsigned int sampleRate )
+{
     setEventLength( sampleLength );
     setEventEnd   ( _eventStart + ( _eventLength - 1 ));
 
     // in case the given event has a sample rate that differs from the engine
-    // adjust the playback rate of the sample accordingly
+    // adjust the playback rate of the sample accordingly (replacing the adjustment made for
+    // the previous sample, e.g. when replacing a sample with one converted to the engine's sample rate)
 
     _sampleRate = sampleRate;
-    if ( _sampleRate != AudioEngineProps::SAMPLE_RATE ) {
-        setPlaybackRate( _playbackRate / ( float ) AudioEngineProps::SAMPLE_RATE * ( float ) _sampleRate );
+    float sampleRateRatio = ( float ) _sampleRate / ( float ) AudioEngineProps::SAMPLE_RATE;
+
+    if ( sampleRateRatio != _sampleRateRatio ) {
+        setPlaybackRate( _playbackRate / _sampleRateRatio * sampleRateRatio );
+        _sampleRateRatio = sampleRateRatio;
     }
 
     // when switching samples, existing buffer ranges are reset
@@ -226,11 +300,6 @@ bool SampleEvent::setSample( AudioBuffer* sampleBuffer, unsigned int sampleRate
     cacheFades();
 
     _updateAfterUnlock = false; // unnecessary
-
-    if ( !wasLocked )
-        _locked = false;
-
-    return true;
 }
 
 float SampleEvent::getPlaybackRate()
@@ -244,6 +313,16 @@ void SampleEvent::setPlaybackRate( float value )
     _playbackRate = std::max( 0.01f, std::min( 100.f, value ));
 }
 
+int SampleEvent::getResamplingQuality()
+{
+    return _resamplingQuality;
+}
+
+void SampleEvent::setResamplingQuality( int value )
+{
+    _resamplingQuality = std::max(( int ) Resampler::LINEAR, std::min(( int ) Resampler::SINC, value ));
+}
+
 bool SampleEvent::isLoopeable()
 {
     return _loopeable;
@@ -272,7 +351,7 @@ int SampleEvent::getLoopStartOffset()
 
 void SampleEvent::setLoopStartOffset( int value )
 {
-    int max = _buffer != nullptr ? _buffer->bufferSize : _eventLength;
+    int max = hasBuffer() ? getSourceLength() : _eventLength;
     _loopStartOffset = std::min( value, std::max( 0, max - 1 ));
     cacheFades();
 }
@@ -284,7 +363,7 @@ int SampleEvent::getLoopEndOffset()
 
 void SampleEvent::setLoopEndOffset( int value )
 {
-    int max = _buffer != nullptr ? _buffer->bufferSize : _eventLength;
+    int max = hasBuffer() ? getSourceLength() : _eventLength;
     _loopEndOffset = std::min( value, std::max( 0, max - 1 ));
     cacheFades();
 }
@@ -319,6 +398,39 @@ void SampleEvent::mixBuffer( AudioBuffer* outputBuffer, int bufferPosition,
         return;
     }
 
+    // compact samples are decoded while reading, using the accessor for their storage type
+
+    if ( _compactBuffer == nullptr ) {
+        BufferSource source = { _buffer };
+        mixSource( source, outputBuffer, bufferPosition, minBufferPosition, maxBufferPosition, loopStarted, loopOffset, useChannelRange );
+        return;
+    }
+
+    switch ( _compactBuffer->getStorageType() )
+    {
+        case CompactBuffer::PCM16: {
+            CompactSource<int16_t> source = { _compactBuffer };
+            mixSource( source, outputBuffer, bufferPosition, minBufferPosition, maxBufferPosition, loopStarted, loopOffset, useChannelRange );
+            break;
+        }
+        case CompactBuffer::HALF_FLOAT: {
+            CompactSource<uint16_t> source = { _compactBuffer };
+            mixSource( source, outputBuffer, bufferPosition, minBufferPosition, maxBufferPosition, loopStarted, loopOffset, useChannelRange );
+            break;
+        }
+        default: {
+            CompactSource<float> source = { _compactBuffer };
+            mixSource( source, outputBuffer, bufferPosition, minBufferPosition, maxBufferPosition, loopStarted, loopOffset, useChannelRange );
+            break;
+        }
+    }
+}
+
+template <typename Source>
+void SampleEvent::mixSource( Source& source, AudioBuffer* outputBuffer, int bufferPosition,
+                             int minBufferPosition, int maxBufferPosition,
+                             bool loopStarted, int loopOffset, bool useChannelRange )
+{
     int bufferSize = outputBuffer->bufferSize;
     int maxReadPos = _loopEndOffset;
     bool crossfade = _crossfadeStart != _loopEndOffset || _crossfadeEnd != 0;
@@ -330,22 +442,27 @@ void SampleEvent::mixBuffer( AudioBuffer* outputBuffer, int bufferPosition,
     int outputChannels = outputBuffer->amountOfChannels;
 
     // but mixing mono events into multichannel output is OK
-    bool mixMono = _buffer->amountOfChannels < outputChannels;
+    bool mixMono = source.buffer->amountOfChannels < outputChannels;
 
     if ( _playbackRate == 1.f )
     {
         // use BaseAudioEvent behaviour if no custom playback rate nor looping is set
 
         if ( !_loopeable ) {
-            BaseAudioEvent::mixBuffer( outputBuffer, bufferPosition, minBufferPosition,
-                                       maxBufferPosition, loopStarted, loopOffset, useChannelRange );
+            if ( _compactBuffer != nullptr ) {
+                mixCompactBuffer( outputBuffer, bufferPosition, minBufferPosition,
+                                  maxBufferPosition, loopStarted, loopOffset, useChannelRange );
+            }
+            else {
+                BaseAudioEvent::mixBuffer( outputBuffer, bufferPosition, minBufferPosition,
+                                           maxBufferPosition, loopStarted, loopOffset, useChannelRange );
+            }
         }
         else
         {
             // loopeable events mix their buffer contents using an internal read pointer
 
             int bufferPointer, i, c, ca;
-            SAMPLE_TYPE* srcBuffer;
             SAMPLE_TYPE* tgtBuffer;
 
             bool sampleLoopStarted = false;
@@ -382,7 +499,7 @@ void SampleEvent::mixBuffer( AudioBuffer* outputBuffer, int bufferPosition,
                     // use range pointers to read within the specific buffer ranges
                     for ( c = 0, ca = outputChannels; c < ca; ++c )
                     {
-                        srcBuffer = _buffer->getBufferForChannel( mixMono ? 0 : c );
+                        auto srcBuffer = source.getChannel( mixMono ? 0 : c );
 
                         tgtBuffer       = outputBuffer->getBufferForChannel( c );
                         tgtBuffer[ i ] += ( srcBuffer[ _readPointer ] * volume );
@@ -402,137 +519,156 @@ void SampleEvent::mixBuffer( AudioBuffer* outputBuffer, int bufferPosition,
     }
 
     // custom playback rate
+    // read positions are calculated as 32.32 fixed point phases (see Resampler) which are collected
+    // for blocks of samples, to then be interpolated by the resampling kernel for each channel.
+    // note that we still rely on maxReadPos for determining the maximum allowed source buffer read
+    // offset, to ensure we remain in range to prevent overflowing of allocated memory ranges
 
-    int i, t, t2, c, ca;
-    float frac;
-    SAMPLE_TYPE* srcBuffer;
-    SAMPLE_TYPE* tgtBuffer;
-    SAMPLE_TYPE s1, s2;
+    int64_t phases[ RESAMPLE_BLOCK_SIZE ];
+    SAMPLE_TYPE gains[ RESAMPLE_BLOCK_SIZE ];
 
-    // at custom playback rate we require floating point precision for these properties
-    // also we translate the values relative to the playback speed
-    // note that we still rely on maxReadPos for determining the maximum allowed source buffer read
-    // offset as due to rounding of floating point increments, we rely on integer comparison
-    // to ensure we remain in range to prevent overflowing of allocated memory ranges
+    int i, j, c, t, amount;
+    int lastIndex = source.buffer->bufferSize - 1;
 
-    float fEventStart        = ( float ) _eventStart;
-    float fEventEnd          = ( float ) getEventEnd();
-    float fMinBufferPosition = ( float ) minBufferPosition;
-    float fMaxBufferPosition = _playbackRate < 1.F ? maxBufferPosition / _playbackRate : maxBufferPosition * _playbackRate;
-    float fLoopOffset        = _playbackRate < 1.F ? loopOffset / _playbackRate        : loopOffset * _playbackRate;
+    // we translate the values relative to the playback speed
+
+    int64_t increment         = Resampler::toPhase( _playbackRate );
+    int64_t eventStart        = Resampler::fromIndex( _eventStart );
+    int64_t eventEnd          = Resampler::fromIndex( getEventEnd() );
+    int64_t maxReadPhase      = Resampler::fromIndex( maxReadPos );
+    int64_t minBufferPhase    = Resampler::fromIndex( minBufferPosition );
+    int64_t maxBufferPhase    = Resampler::toPhase( _playbackRate < 1.F ? maxBufferPosition / _playbackRate : maxBufferPosition * _playbackRate );
+    int64_t loopOffsetPhase   = Resampler::toPhase( _playbackRate < 1.F ? loopOffset / _playbackRate        : loopOffset * _playbackRate );
 
     // iterator that increments by the playback rate
-    float fi = 0.f;
+    int64_t fi = 0;
 
     // take sequencer playhead position and determine what the position
     // should be relative to this events playback rate
-    float fBufferPosition = fEventStart + ((( float ) bufferPosition - fEventStart ) * _playbackRate );
-    float fBufferPointer, fReadPointer;
+    int64_t bufferPhase = eventStart + ( int64_t ) ( bufferPosition - _eventStart ) * increment;
+    int64_t bufferPointer, readPhase;
+
+    auto mixBlock = [ & ]( int offset, int amountOfSamples )
+    {
+        for ( c = 0; c < outputChannels; ++c ) {
+            auto srcBuffer = source.getChannel( mixMono ? 0 : c );
+            Resampler::mix( srcBuffer, phases, gains, outputBuffer->getBufferForChannel( c ) + offset,
+                            amountOfSamples, lastIndex, _resamplingQuality );
+        }
+    };
 
     // non-loopeable event whose playback is tied to the Sequencer
 
     if ( !_loopeable )
     {
-        fEventEnd = _eventEnd; // use unstretched end (see below fBufferPointer calculation)
-
-        for ( i = 0; i < bufferSize; ++i, fi += _playbackRate )
-        {
-            // NOTE buffer pointer progresses by the playback rate
+        eventEnd = Resampler::fromIndex( _eventEnd ); // use unstretched end (see below bufferPointer calculation)
 
-            fBufferPointer = ( loopStarted && fi >= fLoopOffset ) ? fMinBufferPosition + ( fi - fLoopOffset ) : fBufferPosition + fi;
+        bool ended = false;
 
-            // over the max position ? read from the start ( implies that sequence has started loop )
-            if ( fBufferPointer > fMaxBufferPosition )
-            {
-                if ( useChannelRange )
-                    fBufferPointer -= fMaxBufferPosition;
-                else
-                    break;
-            }
+        for ( i = 0; i < bufferSize && !ended; i += RESAMPLE_BLOCK_SIZE )
+        {
+            amount = std::min( RESAMPLE_BLOCK_SIZE, bufferSize - i );
 
-            if ( fBufferPointer >= fEventStart && fBufferPointer <= fEventEnd )
+            for ( j = 0; j < amount; ++j, fi += increment )
             {
-                // mind the offset ! ( source buffer starts at 0 while
-                // the eventStart defines where the event is positioned )
-                // subtract it from current sequencer position to get the
-                // offset relative to the source buffer
+                // NOTE buffer pointer progresses by the playback rate
 
-                fReadPointer = fBufferPointer - fEventStart;
+                bufferPointer = ( loopStarted && fi >= loopOffsetPhase ) ? minBufferPhase + ( fi - loopOffsetPhase ) : bufferPhase + fi;
 
-                t    = ( int ) fReadPointer;
-                frac = fReadPointer - t; // between 0 - 1 range
-
-                for ( c = 0; c < outputChannels; ++c )
+                // over the max position ? read from the start ( implies that sequence has started loop )
+                if ( bufferPointer > maxBufferPhase )
                 {
-                    srcBuffer = _buffer->getBufferForChannel( mixMono ? 0 : c );
-                    tgtBuffer = outputBuffer->getBufferForChannel( c );
-
-                    t2 = t + 1;
-
-                    if ( t2 > maxReadPos )
+                    if ( useChannelRange ) {
+                        bufferPointer -= maxBufferPhase;
+                    }
+                    else {
+                        amount = j;
+                        ended  = true;
                         break;
+                    }
+                }
 
-                    s1 = srcBuffer[ t ];
-                    s2 = srcBuffer[ t2 ];
+                // mind the offset ! ( source buffer starts at 0 while
+                // the eventStart defines where the event is positioned )
+                // subtract it from current sequencer position to get the
+                // offset relative to the source buffer. The interpolated
+                // sample following the read position must be within range
 
-                    tgtBuffer[ i ] += (( s1 + ( s2 - s1 ) * frac ) * _volume );
+                readPhase = bufferPointer - eventStart;
+
+                if ( bufferPointer >= eventStart && bufferPointer <= eventEnd && readPhase < maxReadPhase ) {
+                    phases[ j ] = readPhase;
+                    gains [ j ] = _volume;
+                }
+                else {
+                    phases[ j ] = 0;
+                    gains [ j ] = 0.0;
                 }
             }
+            mixBlock( i, amount );
         }
     }
     else
     {
         // loopeable events mix their buffer contents using an internal read pointer
 
-        float fMaxReadPos = ( float ) maxReadPos;
+        float fMaxReadPos      = ( float ) maxReadPos;
+        int64_t loopStartPhase = Resampler::fromIndex( _loopStartOffset );
+        int64_t loopLength     = maxReadPhase - loopStartPhase;
 
         if ( _livePlayback )
-            fBufferPosition = _readPointerF; // use internal read pointer when reading loopeable content
+            bufferPhase = _readPhase; // use internal read pointer when reading loopeable content
 
         bool sampleLoopStarted = false;
         float crossfadeLength  = fMaxReadPos - ( float ) _crossfadeStart;
         float volume           = _volume;
 
-        for ( i = 0; i < bufferSize; ++i, fi += _playbackRate )
+        for ( i = 0; i < bufferSize; i += RESAMPLE_BLOCK_SIZE )
         {
-            // when playing event from the beginning (e.g. "(re)trigger"), ensure that its looped
-            // sample is playing from the beginning too. We use the non-rate adjusted iterators
-            // to determine this, as they are locked to the Sequencer which is responsible
-            // for these (re)triggers
+            amount = std::min( RESAMPLE_BLOCK_SIZE, bufferSize - i );
 
-            if ( !_livePlayback )
+            for ( j = 0; j < amount; ++j, fi += increment )
             {
-                if (( loopStarted && i == loopOffset )) {
-                    _readPointerF   = 0.0f;
-                    fBufferPosition = 0.0f;
-                    fi              = 0.0f;
-                }
-                else if (( bufferPosition + i ) == _eventStart ) {
-                    _readPointerF = 0.0f;
-                    fi            = 0.0f;
+                phases[ j ] = 0;
+                gains [ j ] = 0.0;
+
+                // when playing event from the beginning (e.g. "(re)trigger"), ensure that its looped
+                // sample is playing from the beginning too. We use the non-rate adjusted iterators
+                // to determine this, as they are locked to the Sequencer which is responsible
+                // for these (re)triggers
+
+                if ( !_livePlayback )
+                {
+                    if (( loopStarted && ( i + j ) == loopOffset )) {
+                        _readPhase  = 0;
+                        bufferPhase = 0;
+                        fi          = 0;
+                    }
+                    else if (( bufferPosition + i + j ) == _eventStart ) {
+                        _readPhase = 0;
+                        fi         = 0;
+                    }
                 }
-            }
 
-            // NOTE buffer pointer progresses by the playback rate
+                // NOTE buffer pointer progresses by the playback rate
 
-            fBufferPointer = fBufferPosition + fi;
+                bufferPointer = bufferPhase + fi;
 
-            // read sample when the read pointer is within event start and end points
-            // or always when playing a live event
+                // read sample when the read pointer is within event start and end points
+                // or always when playing a live event
 
-            if ( _livePlayback || ( fBufferPointer >= fEventStart && fBufferPointer <= fEventEnd ))
-            {
-                fReadPointer = fBufferPointer - fEventStart;
+                if ( !_livePlayback && ( bufferPointer < eventStart || bufferPointer > eventEnd ))
+                    continue;
+
+                readPhase = bufferPointer - eventStart;
 
                 // max pos describes the max position within the source buffer
                 // when looping, we start reading from the loop start offset again
 
-                if ( fReadPointer > fMaxReadPos ) {
-                    fReadPointer = ( float ) _loopStartOffset + fmod( fReadPointer, fMaxReadPos - ( float ) _loopStartOffset );
-                }
+                if ( readPhase > maxReadPhase )
+                    readPhase = loopStartPhase + (( loopLength > 0 ) ? readPhase % loopLength : 0 );
 
-                t    = ( int ) fReadPointer;
-                frac = fReadPointer - t; // between 0 - 1 range
+                t = Resampler::getIndex( readPhase );
 
                 if ( crossfade )
                 {
@@ -547,36 +683,27 @@ void SampleEvent::mixBuffer( AudioBuffer* outputBuffer, int bufferPosition,
                     }
                 }
 
-                // use range pointers to read within the specific buffer ranges
-                for ( c = 0, ca = outputChannels; c < ca; ++c )
-                {
-                    srcBuffer = _buffer->getBufferForChannel( mixMono ? 0 : c );
-                    tgtBuffer = outputBuffer->getBufferForChannel( c );
-
-                    t2 = t + 1;
-
-                    if ( t2 > maxReadPos )
-                        break;
-
-                    s1 = srcBuffer[ t ];
-                    s2 = srcBuffer[ t2 ];
+                // the interpolated sample following the read position must be within range
 
-                    tgtBuffer[ i ] += (( s1 + ( s2 - s1 ) * frac ) * volume );
+                if ( t < maxReadPos ) {
+                    phases[ j ] = readPhase;
+                    gains [ j ] = volume;
                 }
 
                 // this is a loopeable event (thus using internal read pointer)
                 // set the internal read pointer to the loop start so it keeps playing indefinitely
 
-                if ( round( _readPointerF += _playbackRate ) >= fMaxReadPos ) {
-                    _readPointerF     = ( float ) _loopStartOffset;
+                if ( Resampler::roundIndex( _readPhase += increment ) >= maxReadPos ) {
+                    _readPhase        = loopStartPhase;
                     sampleLoopStarted = true;
 
                     if ( _livePlayback ) {
-                        fBufferPosition = _readPointerF;
-                        fi              = 0.f;
+                        bufferPhase = _readPhase;
+                        fi          = 0;
                     }
                 }
             }
+            mixBlock( i, amount );
         }
     }
 }
@@ -614,11 +741,36 @@ void SampleEvent::setRangeBasedPlayback( bool value )
 }
 
 bool SampleEvent::getBufferForRange( AudioBuffer* buffer, int readPos )
+{
+    if ( _compactBuffer == nullptr ) {
+        BufferSource source = { _buffer };
+        return getSourceForRange( source, buffer, readPos );
+    }
+
+    switch ( _compactBuffer->getStorageType() )
+    {
+        case CompactBuffer::PCM16: {
+            CompactSource<int16_t> source = { _compactBuffer };
+            return getSourceForRange( source, buffer, readPos );
+        }
+        case CompactBuffer::HALF_FLOAT: {
+            CompactSource<uint16_t> source = { _compactBuffer };
+            return getSourceForRange( source, buffer, readPos );
+        }
+        default: {
+            CompactSource<float> source = { _compactBuffer };
+            return getSourceForRange( source, buffer, readPos );
+        }
+    }
+}
+
+template <typename Source>
+bool SampleEvent::getSourceForRange( Source& source, AudioBuffer* buffer, int readPos )
 {
     int bufferSize          = buffer->bufferSize;
     int amountOfChannels    = buffer->amountOfChannels;
     bool gotBuffer          = false;
-    bool monoCopy           = _buffer->amountOfChannels < amountOfChannels;
+    bool monoCopy           = source.buffer->amountOfChannels < amountOfChannels;
 
     bool useInternalPointer = _loopeable;
 
@@ -628,8 +780,6 @@ bool SampleEvent::getBufferForRange( AudioBuffer* buffer, int readPos )
     int eventStart = _eventStart;
     int eventEnd   = getEventEnd();
 
-    SAMPLE_TYPE* srcBuffer;
-
     if ( _playbackRate == 1.f )
     {
         for ( int i = 0; i < bufferSize; ++i )
@@ -641,10 +791,7 @@ bool SampleEvent::getBufferForRange( AudioBuffer* buffer, int readPos )
                 for ( int c = 0; c < amountOfChannels; ++c )
                 {
                     // this sample might have less channels than the output buffer
-                    if ( !monoCopy )
-                        srcBuffer = _buffer->getBufferForChannel( c );
-                    else
-                        srcBuffer = _buffer->getBufferForChannel( 0 );
+                    auto srcBuffer = source.getChannel( monoCopy ? 0 : c );
 
                     SAMPLE_TYPE* targetBuffer = buffer->getBufferForChannel( c );
                     targetBuffer[ i ]        += ( srcBuffer[ _rangePointer ] * _volume );
@@ -665,48 +812,55 @@ bool SampleEvent::getBufferForRange( AudioBuffer* buffer, int readPos )
     }
     else {
 
-        // custom playback speed
+        // custom playback speed, read positions are collected for blocks of samples
+        // to then be interpolated by the resampling kernel for each channel (see Resampler)
 
-        int t;
-        SAMPLE_TYPE s1, s2;
-        float bufferRangeEnd = ( float ) getBufferRangeEnd();
-        float frac;
+        int64_t phases[ RESAMPLE_BLOCK_SIZE ];
+        SAMPLE_TYPE gains[ RESAMPLE_BLOCK_SIZE ];
 
-        for ( int i = 0; i < bufferSize; ++i )
+        int64_t increment       = Resampler::toPhase( _playbackRate );
+        int64_t rangeStartPhase = Resampler::fromIndex( _bufferRangeStart );
+        int64_t rangeEndPhase   = Resampler::fromIndex( getBufferRangeEnd() );
+        int lastIndex           = source.buffer->bufferSize - 1;
+
+        for ( int i = 0; i < bufferSize; i += RESAMPLE_BLOCK_SIZE )
         {
-            // read sample when the read pointer is within sample start and end points
-            if ( readPos >= eventStart && readPos <= eventEnd )
-            {
-                t    = ( int ) _rangePointerF;
-                frac = _rangePointerF - t; // between 0 - 1 range
+            int amount = std::min( RESAMPLE_BLOCK_SIZE, bufferSize - i );
 
-                // use range pointers to read within the specific sample ranges
-                for ( int c = 0; c < amountOfChannels; ++c )
+            for ( int j = 0; j < amount; ++j )
+            {
+                // read sample when the read pointer is within sample start and end points
+                if ( readPos >= eventStart && readPos <= eventEnd )
                 {
-                    // this sample might have less channels than the output buffer
-                    if ( !monoCopy )
-                        srcBuffer = _buffer->getBufferForChannel( c );
-                    else
-                        srcBuffer = _buffer->getBufferForChannel( 0 );
+                    phases[ j ] = _rangePhase;
+                    gains [ j ] = _volume;
 
-                    s1 = srcBuffer[ t ];
-                    s2 = srcBuffer[ t + 1 ];
+                    if (( _rangePhase += increment ) > rangeEndPhase )
+                        _rangePhase = rangeStartPhase;
 
-                    SAMPLE_TYPE* targetBuffer = buffer->getBufferForChannel( c );
-                    targetBuffer[ i ]        += (( s1 + ( s2 - s1 ) * frac ) * _volume );
+                    gotBuffer = true;
+                }
+                else {
+                    phases[ j ] = 0;
+                    gains [ j ] = 0.0;
                 }
 
-                if (( _rangePointerF += _playbackRate ) > bufferRangeEnd )
-                    _rangePointerF = ( float ) _bufferRangeStart;
+                // if this is a loopeable sample (thus using internal read pointer)
+                // set the read pointer to the sample start so it keeps playing indefinitely
 
-                gotBuffer = true;
+                if ( ++readPos > eventEnd && _loopeable )
+                    readPos = eventStart;
             }
 
-            // if this is a loopeable sample (thus using internal read pointer)
-            // set the read pointer to the sample start so it keeps playing indefinitely
+            // use range pointers to read within the specific sample ranges
+            for ( int c = 0; c < amountOfChannels; ++c )
+            {
+                // this sample might have less channels than the output buffer
+                auto srcBuffer = source.getChannel( monoCopy ? 0 : c );
 
-            if ( ++readPos > eventEnd && _loopeable )
-                readPos = eventStart;
+                Resampler::mix( srcBuffer, phases, gains, buffer->getBufferForChannel( c ) + i,
+                                amount, lastIndex, _resamplingQuality );
+            }
         }
     }
 
@@ -718,6 +872,163 @@ bool SampleEvent::getBufferForRange( AudioBuffer* buffer, int readPos )
 
 /* protected methods */
 
+/**
+ * variant of BaseAudioEvent::mixBuffer() for compact samples, which mixes
+ * consecutive reads from the source using the vectorized CompactBuffer::mix()
+ */
+void SampleEvent::mixCompactBuffer( AudioBuffer* outputBuffer, int bufferPosition,
+                                    int minBufferPosition, int maxBufferPosition,
+                                    bool loopStarted, int loopOffset, bool useChannelRange )
+{
+    lock(); // prevents buffer mutations (from outside threads) during this read cycle
+
+    int bufferSize     = outputBuffer->bufferSize;
+    int outputChannels = outputBuffer->amountOfChannels;
+    bool mixMono       = _compactBuffer->amountOfChannels < outputChannels;
+    int maxReadPos     = _compactBuffer->bufferSize;
+
+    // resolves the source buffer read offset for given output buffer index
+    // -1 when nothing is to be read, -2 when nothing is to be read for the remainder of the buffer
+
+    auto getReadPointer = [&]( int i ) -> int
+    {
+        int bufferPointer = i + bufferPosition;
+
+        if ( bufferPointer > maxBufferPosition )
+        {
+            if ( useChannelRange )
+                bufferPointer -= maxBufferPosition;
+
+            else if ( !loopStarted )
+                return -2;
+        }
+
+        if ( bufferPointer < _eventStart || bufferPointer > _eventEnd )
+        {
+            if ( !loopStarted || i < loopOffset )
+                return -1;
+
+            bufferPointer = minBufferPosition + ( i - loopOffset );
+
+            if ( bufferPointer < _eventStart || bufferPointer > _eventEnd )
+                return -1;
+        }
+        int readPointer = bufferPointer - _eventStart;
+
+        return ( readPointer < maxReadPos ) ? readPointer : -1;
+    };
+
+    for ( int i = 0; i < bufferSize; )
+    {
+        int readPointer = getReadPointer( i );
+
+        if ( readPointer == -2 )
+            break;
+
+        if ( readPointer == -1 ) {
+            ++i;
+            continue;
+        }
+
+        // determine the amount of consecutively read samples and mix these at once
+
+        int length = 1;
+        while ( i + length < bufferSize && getReadPointer( i + length ) == readPointer + length )
+            ++length;
+
+        for ( int c = 0; c < outputChannels; ++c ) {
+            _compactBuffer->mix( mixMono ? 0 : c, readPointer, outputBuffer->getBufferForChannel( c ) + i, length, _volume );
+        }
+        i += length;
+    }
+    unlock();   // release lock
+}
+
+/**
+ * swaps the sample this event plays back. While the engine is rendering, the render thread applies the swap
+ * (see applyUpdate()) at the start of its next render cycle (e.g. sequenced and live playback continue
+ * uninterrupted). The previous sample (the cloned buffer owned by this event and/or the reference held on the
+ * SampleManager buffer, which prevents its eviction while in use) is released once the swap has been applied
+ */
+void SampleEvent::swapSample( AudioBuffer* buffer, CompactBuffer* compactBuffer, const void* retainedBuffer,
+                              int sampleLength, unsigned int sampleRate )
+{
+    releaseRetiredSamples( false );
+
+    // a swap the render thread has yet to apply must complete before its prepared sample can be replaced
+
+    if ( !_retiredSamples.empty() ) {
+        CommandQueue::synchronize();
+        releaseRetiredSamples( false );
+    }
+
+    if ( retainedBuffer != nullptr )
+        SampleManager::retainBuffer( retainedBuffer );
+
+    _retiredSamples.push_back({ _destroyableBuffer ? _buffer : nullptr, _retainedBuffer, 0 });
+
+    _retainedBuffer = retainedBuffer;
+    _pendingSample  = { buffer, compactBuffer, sampleLength, sampleRate };
+
+    if ( !CommandQueue::isDeferred() ) {
+        applyUpdate();
+        releaseRetiredSamples( true );
+        return;
+    }
+    CommandQueue::post({ .type = CommandQueue::UPDATE_EVENT, .audioEvent = this });
+
+    // the render thread applies the commands in order of posting, once the amount of applied
+    // commands reaches the amount of posted commands, the swap has been applied
+
+    _retiredSamples.back().command = CommandQueue::getPostedCommands();
+}
+
+void SampleEvent::releaseRetiredSamples( bool all )
+{
+    uint64_t appliedCommands = CommandQueue::getAppliedCommands();
+    size_t released = 0;
+
+    for ( auto& retired : _retiredSamples )
+    {
+        if ( !all && retired.command > appliedCommands )
+            break;
+
+        delete retired.buffer;
+
+        if ( retired.retainedBuffer != nullptr )
+            SampleManager::releaseBuffer( retired.retainedBuffer );
+
+        ++released;
+    }
+    _retiredSamples.erase( _retiredSamples.begin(), _retiredSamples.begin() + released );
+}
+
+void SampleEvent::applyUpdate()
+{
+    bool wasLocked = _locked;
+    _locked        = true;
+
+    _buffer        = _pendingSample.buffer;
+    _compactBuffer = _pendingSample.compactBuffer;
+
+    // note this updates the instruments event index when the events range changes (without allocating)
+
+    initSample( _pendingSample.sampleLength, _pendingSample.sampleRate );
+
+    // live playback continues at its current position, unless this exceeds the new sample
+
+    _readPointer = std::min( _readPointer, _bufferRangeEnd );
+    _readPhase   = std::min( _readPhase, Resampler::fromIndex( _bufferRangeEnd ));
+
+    if ( !wasLocked )
+        _locked = false;
+}
+
+int SampleEvent::getSourceLength()
+{
+    return ( _compactBuffer != nullptr ) ? _compactBuffer->bufferSize : _buffer->bufferSize;
+}
+
 void SampleEvent::init( BaseInstrument* instrument )
 {
     BaseAudioEvent::init();
@@ -733,14 +1044,18 @@ void SampleEvent::init( BaseInstrument* instrument )
     _loopStartOffset      = 0;
     _loopEndOffset        = 0;
     _rangePointer         = 0;     // integer for non altered playback rates
-    _rangePointerF        = 0.f;   // floating point for alternate playback rates
+    _rangePhase           = 0;     // fixed point for alternate playback rates
     _lastPlaybackPosition = 0;
     _playbackRate         = 1.f;
-    _readPointerF         = 0.f;
+    _readPhase            = 0;
+    _resamplingQuality    = Resampler::LINEAR;
     _destroyableBuffer    = false; // is referenced via SampleManager !
     _useBufferRange       = false;
     _instrument           = instrument;
     _sampleRate           = ( unsigned int ) AudioEngineProps::SAMPLE_RATE;
+    _sampleRateRatio      = 1.f;
+    _compactBuffer        = nullptr;
+    _retainedBuffer       = nullptr;
 }
 
 void SampleEvent::cacheFades()
@@ -24,6 +24,8 @@
 #define __MWENGINE__SAMPLEEVENT_H_INCLUDED__
 
 #include "baseaudioevent.h"
+#include <utilities/compactbuffer.h>
+#include <utilities/resampler.h>
 #include <instruments/baseinstrument.h>
 
 namespace MWEngine {
@@ -55,9 +57,23 @@ class SampleEvent : public BaseAudioEvent
 
         bool setSample( AudioBuffer* sampleBuffer, unsigned int sampleRate );
 
+        // set a sample held in compact storage (see SampleManager::compactSample()), which is decoded
+        // during playback. Note that CompactBuffers are always referenced (never cloned)
+
+        bool setCompactSample( CompactBuffer* sampleBuffer, unsigned int sampleRate );
+        CompactBuffer* getCompactBuffer();
+
+        bool hasBuffer();
+
         float getPlaybackRate();
         void setPlaybackRate( float value );
 
+        // the interpolation used when playing back at a custom playback rate (or when the
+        // sample rate differs from the engine's), see Resampler::qualities. Defaults to LINEAR
+
+        int getResamplingQuality();
+        void setResamplingQuality( int value );
+
         // use these to repeat this SampleEvents buffer for the total
         // event duration. Optionally specify the point at which the loop will start
         // for samples where the end and start offsets are not at a zero crossing
@@ -86,6 +102,9 @@ class SampleEvent : public BaseAudioEvent
                         bool loopStarted, int loopOffset, bool useChannelRange );
 
         void mixBuffer( AudioBuffer* outputBuffer );
+
+        // swaps in the sample prepared by setSample() / setCompactSample()
+        void applyUpdate();
 #endif
 
         // whether to mix sample data from a specific range instead of the full sampleLength range
@@ -106,7 +125,7 @@ class SampleEvent : public BaseAudioEvent
         // total sample range
 
         int _rangePointer;
-        float _rangePointerF;
+        int64_t _rangePhase; // fixed point range pointer for custom playback rates (see Resampler)
 
         // looping / custom repeat range
 
@@ -125,13 +144,62 @@ class SampleEvent : public BaseAudioEvent
         int _bufferRangeLength;
         bool _useBufferRange;
         float _playbackRate;
-        float _readPointerF;
+        int64_t _readPhase; // fixed point read pointer for custom playback rates (see Resampler)
+        int _resamplingQuality;
 
         unsigned int _sampleRate;
+        float _sampleRateRatio; // the playback rate adjustment for the sample rate of the sample (relative to the engine)
         int _lastPlaybackPosition;
 
+        // compact sample (when set, the AudioBuffer is null)
+
+        CompactBuffer* _compactBuffer;
+
+        // SampleManager buffer this event holds a reference to (prevents its eviction while in use)
+
+        const void* _retainedBuffer;
+
+        // while the engine is rendering, the sample is prepared by the control thread and swapped in by the render
+        // thread (see applyUpdate()). The replaced sample is released once the render thread has applied the swap
+
+        struct PendingSample {
+            AudioBuffer* buffer;
+            CompactBuffer* compactBuffer;
+            int sampleLength;
+            unsigned int sampleRate;
+        };
+
+        struct RetiredSample {
+            AudioBuffer* buffer;        // cloned buffer owned by this event (or nullptr)
+            const void* retainedBuffer; // SampleManager buffer to release (or nullptr)
+            uint64_t command;           // the amount of posted commands upon posting the swap
+        };
+
+        PendingSample _pendingSample;
+        std::vector<RetiredSample> _retiredSamples;
+
         void init( BaseInstrument* aInstrument );
+        void initSample( int sampleLength, unsigned int sampleRate );
+        void swapSample( AudioBuffer* buffer, CompactBuffer* compactBuffer, const void* retainedBuffer,
+                         int sampleLength, unsigned int sampleRate );
+        void releaseRetiredSamples( bool all ); // releases the replaced samples (when all is false, only those swapped out by the render thread)
+        int getSourceLength();
         void cacheFades();
+
+#ifndef SWIG
+        // mixing is shared between sample storage types through the source accessors
+        // (see sampleevent.cpp), compact samples read consecutive samples via mixCompactBuffer()
+
+        template <typename Source>
+        void mixSource( Source& source, AudioBuffer* outputBuffer, int bufferPos, int minBufferPosition, int maxBufferPosition,
+                        bool loopStarted, int loopOffset, bool useChannelRange );
+
+        template <typename Source>
+        bool getSourceForRange( Source& source, AudioBuffer* buffer, int readPos );
+
+        void mixCompactBuffer( AudioBuffer* outputBuffer, int bufferPos, int minBufferPosition, int maxBufferPosition,
+                               bool loopStarted, int loopOffset, bool useChannelRange );
+#endif
 };
 } // E.O namespace MWEngine
 
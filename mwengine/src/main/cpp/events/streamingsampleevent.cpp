@@ -0,0 +1,323 @@
+/**
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2026 Igor Zinken - https://www.igorski.nl
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#include "streamingsampleevent.h"
+#include <global.h>
+#include <messaging/commandqueue.h>
+#include <algorithm>
+
+namespace MWEngine {
+
+/* constructor / destructor */
+
+StreamingSampleEvent::StreamingSampleEvent()
+{
+    init( nullptr );
+}
+
+StreamingSampleEvent::StreamingSampleEvent( BaseInstrument* aInstrument )
+{
+    init( aInstrument );
+}
+
+StreamingSampleEvent::~StreamingSampleEvent()
+{
+    // ensure the event is no longer rendered before closing the stream
+
+    removeFromInstrument();
+    CommandQueue::synchronize();
+
+    delete _stream;
+}
+
+/* public methods */
+
+bool StreamingSampleEvent::setFile( std::string inputFile )
+{
+    SampleStream* stream = SampleStream::open( inputFile );
+
+    if ( stream == nullptr )
+        return false;
+
+    // keep the event out of the render cycle while swapping the stream (note this stops live playback)
+
+    bool wasAdded = isAddedToSequencer();
+
+    if ( _instrument != nullptr ) {
+        _instrument->removeEvent( this, false );
+        _instrument->removeEvent( this, true );
+    }
+    resetPlayState();
+    CommandQueue::synchronize();
+
+    delete _stream;
+    _stream = stream;
+
+    _loopStartOffset = 0;
+    _loopEndOffset   = _stream->getLength() - 1;
+    updateLoop();
+
+    setEventLength( _stream->getLength() );
+    setEventEnd( _eventStart + ( _eventLength - 1 ));
+
+    if ( wasAdded ) _instrument->addEvent( this, false );
+
+    return true;
+}
+
+int StreamingSampleEvent::getSampleLength()
+{
+    return ( _stream != nullptr ) ? _stream->getLength() : 0;
+}
+
+unsigned int StreamingSampleEvent::getSampleRate()
+{
+    return ( _stream != nullptr ) ? _stream->getSampleRate() : ( unsigned int ) AudioEngineProps::SAMPLE_RATE;
+}
+
+void StreamingSampleEvent::play()
+{
+    _lastPlaybackPosition = 0;
+
+    if ( _stream != nullptr )
+        _stream->setPlaybackOffset( 0 );
+
+    BaseAudioEvent::play();
+}
+
+int StreamingSampleEvent::getBufferRangeStart()
+{
+    return ( _stream != nullptr ) ? _stream->getRangeStart() : 0;
+}
+
+void StreamingSampleEvent::setBufferRangeStart( int value )
+{
+    if ( _stream == nullptr )
+        return;
+
+    _stream->setRange( value, std::max( value, _stream->getRangeEnd() ));
+
+    if ( !_loopeable )
+        setEventLength( getBufferRangeLength() );
+}
+
+int StreamingSampleEvent::getBufferRangeEnd()
+{
+    return ( _stream != nullptr ) ? _stream->getRangeEnd() : 0;
+}
+
+void StreamingSampleEvent::setBufferRangeEnd( int value )
+{
+    if ( _stream == nullptr )
+        return;
+
+    _stream->setRange( std::min( value, _stream->getRangeStart() ), value );
+
+    if ( !_loopeable )
+        setEventLength( getBufferRangeLength() );
+}
+
+int StreamingSampleEvent::getBufferRangeLength()
+{
+    return ( _stream != nullptr ) ? ( _stream->getRangeEnd() - _stream->getRangeStart() ) + 1 : 0;
+}
+
+bool StreamingSampleEvent::isLoopeable()
+{
+    return _loopeable;
+}
+
+void StreamingSampleEvent::setLoopeable( bool value )
+{
+    _loopeable = value;
+    updateLoop();
+
+    // non-loopeable events play the buffer range once
+
+    if ( !_loopeable && _stream != nullptr )
+        setEventLength( getBufferRangeLength() );
+}
+
+int StreamingSampleEvent::getLoopStartOffset()
+{
+    return _loopStartOffset;
+}
+
+void StreamingSampleEvent::setLoopStartOffset( int value )
+{
+    _loopStartOffset = std::max( 0, std::min( value, getSampleLength() - 1 ));
+    updateLoop();
+}
+
+int StreamingSampleEvent::getLoopEndOffset()
+{
+    return _loopEndOffset;
+}
+
+void StreamingSampleEvent::setLoopEndOffset( int value )
+{
+    _loopEndOffset = std::max( 0, std::min( value, getSampleLength() - 1 ));
+    updateLoop();
+}
+
+int StreamingSampleEvent::getUnderruns()
+{
+    return ( _stream != nullptr ) ? _stream->getUnderruns() : 0;
+}
+
+int StreamingSampleEvent::getUnderrunFrames()
+{
+    return ( _stream != nullptr ) ? _stream->getUnderrunFrames() : 0;
+}
+
+void StreamingSampleEvent::resetUnderruns()
+{
+    if ( _stream != nullptr )
+        _stream->resetUnderruns();
+}
+
+int StreamingSampleEvent::getPlaybackPosition()
+{
+    return _lastPlaybackPosition;
+}
+
+void StreamingSampleEvent::mixBuffer( AudioBuffer* outputBuffer, int bufferPosition,
+                                      int minBufferPosition, int maxBufferPosition,
+                                      bool loopStarted, int loopOffset, bool useChannelRange )
+{
+    if ( !hasBuffer() )
+        return;
+
+    int bufferSize     = outputBuffer->bufferSize;
+    int eventLength    = ( _eventEnd - _eventStart ) + 1;
+    int missingFrames  = 0;
+    int playbackOffset = -1;
+
+    for ( int i = 0; i < bufferSize; )
+    {
+        int bufferPointer = getBufferPointer( i, bufferPosition, minBufferPosition, maxBufferPosition, loopStarted, loopOffset, useChannelRange );
+
+        if ( bufferPointer < _eventStart || bufferPointer > _eventEnd ) {
+            ++i;
+            continue;
+        }
+
+        // the frames are mixed in runs for as long as the sequencer position advances contiguously
+        // (e.g. until the sequencer loops or the end of the event has been reached)
+
+        int run = 1;
+        while ( i + run < bufferSize && bufferPointer + run <= _eventEnd &&
+                getBufferPointer( i + run, bufferPosition, minBufferPosition, maxBufferPosition, loopStarted, loopOffset, useChannelRange ) == bufferPointer + run )
+            ++run;
+
+        // the playback offset is derived from the sequencer position (rather than an
+        // internal read pointer) so changes in sequencer position are followed instantly
+
+        missingFrames += _stream->mixFrames( outputBuffer, i, bufferPointer - _eventStart, run, _volume );
+
+        playbackOffset = bufferPointer - _eventStart + run - 1;
+        i += run;
+    }
+
+    if ( missingFrames > 0 )
+        _stream->registerUnderrun( missingFrames );
+
+    // communicate where playback continues, once the event has played in its entirety
+    // its start is prefetched (for when the sequencer loops back to the start of the event)
+
+    if ( playbackOffset >= 0 )
+        _stream->setPlaybackOffset(( playbackOffset + 1 ) < eventLength ? playbackOffset + 1 : 0 );
+}
+
+/**
+ * Invoked by the Sequencer in case this event isn't sequenced
+ * but triggered manually via a "noteOn" / "noteOff" operation for instant "live" playback
+ */
+void StreamingSampleEvent::mixBuffer( AudioBuffer* outputBuffer )
+{
+    if ( !hasBuffer() )
+        return;
+
+    int amountOfFrames = outputBuffer->bufferSize;
+    bool ended         = false;
+
+    // loopeable events play indefinitely (until stopped), one-shot events stop at the end of their range
+
+    if ( !_loopeable ) {
+        int remainingFrames = std::max( 0, getBufferRangeLength() - _lastPlaybackPosition );
+
+        if ( remainingFrames < amountOfFrames ) {
+            amountOfFrames = remainingFrames;
+            ended          = true;
+        }
+    }
+    int missingFrames = _stream->mixFrames( outputBuffer, 0, _lastPlaybackPosition, amountOfFrames, _volume );
+    _lastPlaybackPosition += amountOfFrames;
+
+    if ( ended )
+        stop();
+
+    if ( missingFrames > 0 )
+        _stream->registerUnderrun( missingFrames );
+
+    _stream->setPlaybackOffset( _lastPlaybackPosition );
+}
+
+bool StreamingSampleEvent::hasBuffer()
+{
+    return _stream != nullptr;
+}
+
+/* protected methods */
+
+void StreamingSampleEvent::init( BaseInstrument* aInstrument )
+{
+    BaseAudioEvent::init();
+
+    _stream               = nullptr;
+    _lastPlaybackPosition = 0;
+    _loopeable            = false;
+    _loopStartOffset      = 0;
+    _loopEndOffset        = 0;
+
+    _instrument           = aInstrument;
+}
+
+void StreamingSampleEvent::updateLoop()
+{
+    if ( _stream != nullptr )
+        _stream->setLoop( _loopeable, _loopStartOffset, _loopEndOffset );
+}
+
+int StreamingSampleEvent::getBufferPointer( int index, int bufferPosition, int minBufferPosition, int maxBufferPosition,
+                                            bool loopStarted, int loopOffset, bool useChannelRange )
+{
+    int bufferPointer = ( loopStarted && index >= loopOffset ) ? minBufferPosition + ( index - loopOffset ) : index + bufferPosition;
+
+    // over the max position ? read from the start (channel has its own range)
+    if ( bufferPointer > maxBufferPosition && useChannelRange )
+        bufferPointer -= maxBufferPosition;
+
+    return bufferPointer;
+}
+
+} // E.O namespace MWEngine
@@ -0,0 +1,121 @@
+/**
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2026 Igor Zinken - https://www.igorski.nl
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#ifndef __MWENGINE__STREAMINGSAMPLEEVENT_H_INCLUDED__
+#define __MWENGINE__STREAMINGSAMPLEEVENT_H_INCLUDED__
+
+#include "baseaudioevent.h"
+#include <instruments/baseinstrument.h>
+#include <utilities/samplestream.h>
+#include <string>
+
+namespace MWEngine {
+
+/**
+ * A StreamingSampleEvent plays back a WAV file directly from storage, making it suitable for
+ * long samples (e.g. backing tracks and stems) that would otherwise occupy large amounts of memory
+ * when read into an AudioBuffer (see SampleEvent). Only a small portion of the file is held in memory
+ * at a time (see SampleStream), which is read ahead of the sequencer position by a separate thread.
+ *
+ * The render thread never accesses the file system. When the sequencer position is moved to a part
+ * of the file that has not been read yet (e.g. when seeking using SequencerController::setBufferPosition()),
+ * the event remains silent until the data has been read, see getUnderruns().
+ *
+ * Note the file is played back at its own sample rate (no sample rate conversion nor custom playback rate
+ * is applied) and all offsets (buffer range, loop offsets) are expressed in sample frames of the file.
+ */
+class StreamingSampleEvent : public BaseAudioEvent
+{
+    public:
+        StreamingSampleEvent();
+        StreamingSampleEvent( BaseInstrument* aInstrument );
+        virtual ~StreamingSampleEvent();
+
+        // opens the WAV file at given path for playback, returns false when the file
+        // doesn't exist / is not a valid WAV file. The event length equals the sample length
+
+        bool setFile( std::string inputFile );
+
+        int getSampleLength();       // the length of the file in sample frames
+        unsigned int getSampleRate();
+
+        void play();
+
+        // play back a specific range of the file instead of the full sample
+
+        int getBufferRangeStart();
+        void setBufferRangeStart( int value );
+        int getBufferRangeEnd();
+        void setBufferRangeEnd( int value );
+        int getBufferRangeLength();
+
+        // repeats the region between the loop start and end offsets for the total
+        // event duration (once the event length exceeds the buffer range length)
+
+        bool isLoopeable();
+        void setLoopeable( bool value );
+        int getLoopStartOffset();
+        void setLoopStartOffset( int value );
+        int getLoopEndOffset();
+        void setLoopEndOffset( int value );
+
+        // the amount of render cycles in which this event could not read the data
+        // from storage in time, and the total amount of sample frames this concerns
+
+        int getUnderruns();
+        int getUnderrunFrames();
+        void resetUnderruns();
+
+        int getPlaybackPosition();
+
+#ifndef SWIG
+        // internal to the engine
+        void mixBuffer( AudioBuffer* outputBuffer, int bufferPos, int minBufferPosition, int maxBufferPosition,
+                        bool loopStarted, int loopOffset, bool useChannelRange );
+
+        void mixBuffer( AudioBuffer* outputBuffer );
+
+        bool hasBuffer();
+#endif
+
+    protected:
+
+        SampleStream* _stream;
+        int _lastPlaybackPosition;
+
+        void init( BaseInstrument* aInstrument );
+        void updateLoop();
+
+        // translates given index of the output buffer into a position of the sequencer
+
+        int getBufferPointer( int index, int bufferPosition, int minBufferPosition, int maxBufferPosition,
+                              bool loopStarted, int loopOffset, bool useChannelRange );
+
+    private:
+
+        int _loopStartOffset;
+        int _loopEndOffset;
+        bool _loopeable;
+};
+} // E.O namespace MWEngine
+
+#endif
@@ -24,7 +24,6 @@
 #include "../audioengine.h"
 #include "../sequencer.h"
 #include "../global.h"
-#include <utilities/bufferpool.h>
 #include <utilities/bufferutility.h>
 #include <cmath>
 
@@ -59,7 +58,7 @@ SynthEvent::SynthEvent( float aFrequency, SynthInstrument* aInstrument )
 
 SynthEvent::~SynthEvent()
 {
-    BufferPool::destroyRingBuffersForEvent( this ); // see synthesizer.h
+    // ring buffers are released by BaseSynthEvent
 }
 
 } // E.O namespace MWEngine
@@ -27,9 +27,325 @@
 #include <utilities/bufferpool.h>
 #include <utilities/bufferutility.h>
 #include <utilities/utils.h>
+#include <algorithm>
 
 namespace MWEngine {
 
+namespace {
+
+// the amount of samples an oscillator kernel renders in a single pass
+
+const int KERNEL_BLOCK_SIZE = 128;
+
+// the render state of an oscillator, cached by Synthesizer::render() for the duration of a render cycle
+
+struct OscillatorState
+{
+    SAMPLE_TYPE phase;
+    SAMPLE_TYPE phaseIncr;
+    SAMPLE_TYPE frequency;
+
+    // sine specific
+    bool fade;      // whether to fade in/out at the start/end of the event
+    bool attenuate; // whether to reduce the output level (for multi timbral use)
+    int writeIndex;
+    int maxSampleIndex;
+    int fadeInDuration;
+    int fadeOutDuration;
+
+    // PWM specific
+    SAMPLE_TYPE twoPiOverSR;
+    float pwr, pwAmp, pwmValue;
+
+    // WaveTable specific
+    WaveTable* waveTable;
+    SAMPLE_TYPE* tableBuffer;
+    SAMPLE_TYPE accumulator;
+    SAMPLE_TYPE tableDivider;
+    int sampleRate;
+
+    // Karplus-Strong specific
+    RingBuffer* ringBuffer;
+};
+
+/**
+ * oscillator kernels render a block of given amount of samples into output (mono)
+ * each waveform has its own specialization, meaning the waveform is resolved once per block
+ * rather than once per sample. offset describes the position of the block within the render cycle
+ */
+template <int waveform>
+struct Oscillator
+{
+    static void render( OscillatorState& state, SAMPLE_TYPE* output, int offset, int amount );
+};
+
+// parabolic approximation of a sine wave, the basis for several waveforms
+
+inline SAMPLE_TYPE parabola( SAMPLE_TYPE phase )
+{
+    SAMPLE_TYPE tmp;
+
+    if ( phase < .5 )
+    {
+        tmp = ( phase * 4.0 - 1.0 );
+        return ( 1.0 - tmp * tmp );
+    }
+    tmp = ( phase * 4.0 - 3.0 );
+    return ( tmp * tmp - 1.0 );
+}
+
+// phase update operation (not used by TABLE, PWM and KARPLUS_STRONG)
+
+inline SAMPLE_TYPE advancePhase( SAMPLE_TYPE phase, SAMPLE_TYPE phaseIncr )
+{
+    phase += phaseIncr;
+
+    // keep phase within range
+    if ( phase > 1.0 )
+        phase -= 1.0;
+
+    return phase;
+}
+
+template <>
+void Oscillator<WaveForms::SINE>::render( OscillatorState& state, SAMPLE_TYPE* output, int offset, int amount )
+{
+    SAMPLE_TYPE phase = state.phase;
+
+    for ( int i = 0; i < amount; ++i )
+    {
+        SAMPLE_TYPE amp = parabola( phase );
+
+        // sines need some extra love :
+        // for one: a fade-in and fade-out at the start to prevent POP!ping...
+
+        if ( state.fade )
+        {
+            int curWritePos = state.writeIndex + offset + i;
+
+            if ( curWritePos < state.fadeInDuration )
+                amp *= ( SAMPLE_TYPE ) curWritePos / ( SAMPLE_TYPE ) state.fadeInDuration;
+
+            else if ( curWritePos >= ( state.maxSampleIndex - state.fadeOutDuration ))
+                amp *= ( SAMPLE_TYPE ) ( state.maxSampleIndex - ( curWritePos )) / ( SAMPLE_TYPE ) state.fadeOutDuration;
+        }
+
+        if ( state.attenuate )
+            amp *= .7;  // we're anticipating multi timbral use, bring down the level a tad.
+
+        output[ i ] = amp;
+        phase       = advancePhase( phase, state.phaseIncr );
+    }
+    state.phase = phase;
+}
+
+template <>
+void Oscillator<WaveForms::SAWTOOTH>::render( OscillatorState& state, SAMPLE_TYPE* output, int, int amount )
+{
+    SAMPLE_TYPE phase = state.phase;
+
+    for ( int i = 0; i < amount; ++i )
+    {
+        output[ i ] = ( phase < 0 ) ? phase - ( int )( phase - 1 ) : phase - ( int )( phase );
+        phase       = advancePhase( phase, state.phaseIncr );
+    }
+    state.phase = phase;
+}
+
+template <>
+void Oscillator<WaveForms::SQUARE>::render( OscillatorState& state, SAMPLE_TYPE* output, int, int amount )
+{
+    SAMPLE_TYPE phase = state.phase;
+    SAMPLE_TYPE tmp, amp;
+
+    for ( int i = 0; i < amount; ++i )
+    {
+        if ( phase < .5 )
+        {
+            tmp = TWO_PI * ( phase * 4.0 - 1.0 );
+            amp = ( 1.0 - tmp * tmp );
+        }
+        else {
+            tmp = TWO_PI * ( phase * 4.0 - 3.0 );
+            amp = ( tmp * tmp - 1.0 );
+        }
+        amp *= .01; // these get loud !
+
+        output[ i ] = amp;
+        phase       = advancePhase( phase, state.phaseIncr );
+    }
+    state.phase = phase;
+}
+
+template <>
+void Oscillator<WaveForms::TRIANGLE>::render( OscillatorState& state, SAMPLE_TYPE* output, int, int amount )
+{
+    SAMPLE_TYPE phase = state.phase;
+
+    for ( int i = 0; i < amount; ++i )
+    {
+        SAMPLE_TYPE amp = parabola( phase );
+
+        // the actual triangulation function
+        output[ i ] = amp < 0 ? -amp : amp;
+        phase       = advancePhase( phase, state.phaseIncr );
+    }
+    state.phase = phase;
+}
+
+template <>
+void Oscillator<WaveForms::PWM>::render( OscillatorState& state, SAMPLE_TYPE* output, int offset, int amount )
+{
+    SAMPLE_TYPE phase     = state.phase;
+    SAMPLE_TYPE phaseIncr = state.twoPiOverSR * state.frequency;
+    float pwmValue        = state.pwmValue;
+    SAMPLE_TYPE amp, dpw, pmv;
+
+    for ( int i = 0; i < amount; ++i )
+    {
+        pmv = ( offset + i ) + ( ++pwmValue ); // i + event position
+
+        dpw = sin( pmv / 0x4800 ) * state.pwr; // LFO -> PW
+        amp = phase < PI - dpw ? state.pwAmp : -state.pwAmp;
+
+        // PWM has its own phase update operation
+        phase = phase + phaseIncr;
+        phase = phase > TWO_PI ? phase - TWO_PI : phase;
+
+        // we multiply the amplitude as PWM results in a "quieter" wave
+        output[ i ] = amp * 4;
+    }
+    state.phase    = phase;
+    state.pwmValue = pwmValue;
+}
+
+template <>
+void Oscillator<WaveForms::NOISE>::render( OscillatorState& state, SAMPLE_TYPE* output, int, int amount )
+{
+    SAMPLE_TYPE phase = state.phase;
+
+    for ( int i = 0; i < amount; ++i )
+    {
+        // calculate pitch, then add some randomization to the signal for the actual noise
+        SAMPLE_TYPE amp = parabola( phase );
+        amp *= randomFloat();
+
+        output[ i ] = amp;
+        phase       = advancePhase( phase, state.phaseIncr );
+    }
+    state.phase = phase;
+}
+
+template <>
+void Oscillator<WaveForms::KARPLUS_STRONG>::render( OscillatorState& state, SAMPLE_TYPE* output, int, int amount )
+{
+    RingBuffer* ringBuffer = state.ringBuffer;
+
+    // no ring buffer could be acquired for the event (see BufferPool)
+
+    if ( ringBuffer == nullptr ) {
+        std::fill( output, output + amount, SILENCE );
+        return;
+    }
+
+    for ( int i = 0; i < amount; ++i )
+    {
+        // Karplus-Strong algorithm for plucked string-sound (0.990f being energy decay factor)
+        ringBuffer->enqueue(( 0.990f * (( ringBuffer->dequeue() + ringBuffer->peek() ) / 2 ) ));
+        output[ i ] = ringBuffer->peek();
+    }
+}
+
+template <>
+void Oscillator<WaveForms::TABLE>::render( OscillatorState& state, SAMPLE_TYPE* output, int, int amount )
+{
+    SAMPLE_TYPE accumulator = state.accumulator;
+    WaveTable* waveTable    = state.waveTable;
+
+    if ( waveTable->hasMipmaps() )
+    {
+        // band-limited playback: read from the mipmap matching the frequency using linear interpolation
+
+        SAMPLE_TYPE* mipmap = waveTable->getMipmapForIncrement( state.frequency / ( SAMPLE_TYPE ) state.sampleRate );
+        int mipmapLength    = waveTable->getMipmapLength();
+        int mipmapMask      = mipmapLength - 1;
+
+        // the accumulator is scaled to the mipmap length for the duration of the block
+
+        SAMPLE_TYPE scale     = ( SAMPLE_TYPE ) mipmapLength / ( SAMPLE_TYPE ) state.sampleRate;
+        SAMPLE_TYPE position  = accumulator * scale;
+        SAMPLE_TYPE increment = state.frequency * scale;
+
+        for ( int i = 0; i < amount; ++i )
+        {
+            int readOffset       = ( int ) position;
+            SAMPLE_TYPE fraction = position - readOffset;
+            SAMPLE_TYPE sample   = mipmap[ readOffset & mipmapMask ];
+
+            output[ i ] = sample + ( mipmap[ ( readOffset + 1 ) & mipmapMask ] - sample ) * fraction;
+
+            position += increment;
+
+            if ( position >= mipmapLength )
+                position -= mipmapLength;
+        }
+        state.accumulator = position / scale;
+        return;
+    }
+
+    // tables without mipmaps are read without interpolation
+
+    int tableReadOffset;
+
+    for ( int i = 0; i < amount; ++i )
+    {
+        tableReadOffset = ( accumulator == 0 ) ? 0 : ( int ) ( accumulator / state.tableDivider );
+        accumulator    += state.frequency;
+
+        if ( accumulator > state.sampleRate )
+            accumulator -= state.sampleRate;
+
+        output[ i ] = state.tableBuffer[ tableReadOffset ];
+    }
+    state.accumulator = accumulator;
+}
+
+void renderOscillator( int waveform, OscillatorState& state, SAMPLE_TYPE* output, int offset, int amount )
+{
+    switch ( waveform )
+    {
+        case WaveForms::SINE:
+            Oscillator<WaveForms::SINE>::render( state, output, offset, amount );
+            break;
+        case WaveForms::TRIANGLE:
+            Oscillator<WaveForms::TRIANGLE>::render( state, output, offset, amount );
+            break;
+        case WaveForms::SAWTOOTH:
+            Oscillator<WaveForms::SAWTOOTH>::render( state, output, offset, amount );
+            break;
+        case WaveForms::SQUARE:
+            Oscillator<WaveForms::SQUARE>::render( state, output, offset, amount );
+            break;
+        case WaveForms::NOISE:
+            Oscillator<WaveForms::NOISE>::render( state, output, offset, amount );
+            break;
+        case WaveForms::PWM:
+            Oscillator<WaveForms::PWM>::render( state, output, offset, amount );
+            break;
+        case WaveForms::KARPLUS_STRONG:
+            Oscillator<WaveForms::KARPLUS_STRONG>::render( state, output, offset, amount );
+            break;
+        case WaveForms::TABLE:
+            Oscillator<WaveForms::TABLE>::render( state, output, offset, amount );
+            break;
+        default:
+            std::fill( output, output + amount, 0.0 );
+            break;
+    }
+}
+
+}
+
 /* constructors / destructor */
 
 Synthesizer::Synthesizer( SynthInstrument* aInstrument, int aOscillatorNum )
@@ -70,9 +386,6 @@ void Synthesizer::render( AudioBuffer* aOutputBuffer, BaseSynthEvent* aEvent )
     int type                       = oscProps->getWaveform();
     int SAMPLE_RATE                = AudioEngineProps::SAMPLE_RATE;
 
-    SAMPLE_TYPE amp = 0.0;
-    SAMPLE_TYPE tmp, dpw, pmv;
-
     bool doAddOSCs = !hasParent && _instrument->getOscillatorAmount() > 1;
 
     // attenuate oscillators
@@ -109,191 +422,87 @@ void Synthesizer::render( AudioBuffer* aOutputBuffer, BaseSynthEvent* aEvent )
         aEvent->setFrequency( frequency, false );
     }
 
+    // oscillator state for this render cycle (see kernels above)
+
+    OscillatorState state = {};
+
+    state.phase           = phase;
+    state.frequency       = frequency;
+    state.fade            = isSequenced && !hasParent; // unless this isn't the main oscillator
+    state.attenuate       = !isSequenced;
+    state.writeIndex      = bufferWriteIndex;
+    state.maxSampleIndex  = maxSampleIndex;
+    state.fadeInDuration  = _fadeInDuration;
+    state.fadeOutDuration = _fadeOutDuration;
+    state.twoPiOverSR     = TWO_PI_OVER_SR;
+    state.pwr             = _pwr;
+    state.pwAmp           = _pwAmp;
+    state.pwmValue        = _pwmValue;
+    state.sampleRate      = SAMPLE_RATE;
+
     // Karplus-Strong specific
 
-    RingBuffer* ringBuffer = ( type == WaveForms::KARPLUS_STRONG ) ? getRingBuffer( aEvent, frequency ) : nullptr;
+    state.ringBuffer = ( type == WaveForms::KARPLUS_STRONG ) ? getRingBuffer( aEvent, frequency, _oscillatorNum ) : nullptr;
 
     // WaveTable specific
 
     WaveTable* waveTable = nullptr;
-    int tableReadOffset;
-    SAMPLE_TYPE waveTableAccumulator;
-    SAMPLE_TYPE* tableBuffer;
-    SAMPLE_TYPE tableDivider;
 
     if ( type == WaveForms::TABLE ) {
-        waveTable            = oscProps->waveTable;
-        tableBuffer          = waveTable->getBuffer();
-        waveTableAccumulator = waveTable->getAccumulator();
-        tableDivider         = ( SAMPLE_TYPE ) SAMPLE_RATE / ( SAMPLE_TYPE ) waveTable->tableLength;
+        waveTable          = oscProps->waveTable;
+        state.waveTable    = waveTable;
+        state.tableBuffer  = waveTable->getBuffer();
+        state.accumulator  = waveTable->getAccumulator();
+        state.tableDivider = ( SAMPLE_TYPE ) SAMPLE_RATE / ( SAMPLE_TYPE ) waveTable->tableLength;
     }
 
-    for ( int i = renderStartOffset; i < renderEndOffset; ++i )
-    {
-        switch ( type )
-        {
-            case WaveForms::TABLE:
-
-                // ---- Wave table based
-
-                tableReadOffset       = ( waveTableAccumulator == 0 ) ? 0 : ( int ) ( waveTableAccumulator / tableDivider );
-                waveTableAccumulator += frequency;
-
-                if ( waveTableAccumulator > SAMPLE_RATE )
-                    waveTableAccumulator -= SAMPLE_RATE;
-
-                amp = tableBuffer[ tableReadOffset ];
-
-                break;
-
-            case WaveForms::SINE:
-
-                // ---- Sine wave
-
-                if ( phase < .5 )
-                {
-                    tmp = ( phase * 4.0 - 1.0 );
-                    amp = ( 1.0 - tmp * tmp );
-                }
-                else {
-                    tmp = ( phase * 4.0 - 3.0 );
-                    amp = ( tmp * tmp - 1.0 );
-                }
-
-                // sines need some extra love :
-                // for one: a fade-in and fade-out at the start to prevent POP!ping...
-
-                if ( isSequenced && !hasParent ) // unless this isn't the main oscillator
-                {
-                    int curWritePos = bufferWriteIndex + i;
-
-                    if ( curWritePos < _fadeInDuration )
-                        amp *= ( SAMPLE_TYPE ) curWritePos / ( SAMPLE_TYPE ) _fadeInDuration;
+    // the oscillator is rendered in mono blocks, which are subsequently mixed into the output channels
+    // arpeggiator steps (which change the frequency) mark the boundaries between blocks
 
-                    else if ( curWritePos >= ( maxSampleIndex - _fadeOutDuration ))
-                        amp *= ( SAMPLE_TYPE ) ( maxSampleIndex - ( curWritePos  )) / ( SAMPLE_TYPE ) _fadeOutDuration;
-                }
+    SAMPLE_TYPE block[ KERNEL_BLOCK_SIZE ];
+    int channelAmount = aOutputBuffer->amountOfChannels;
 
-                if ( !isSequenced )
-                    amp *= .7;  // we're anticipating multi timbral use, bring down the level a tad.
-
-                break;
-
-            case WaveForms::SAWTOOTH:
-
-                // ---- Sawtooth
-                amp = ( phase < 0 ) ? phase - ( int )( phase - 1 ) : phase - ( int )( phase );
-
-                break;
-
-            case WaveForms::SQUARE:
-
-                // ---- Square wave
-                if ( phase < .5 )
-                {
-                    tmp = TWO_PI * ( phase * 4.0 - 1.0 );
-                    amp = ( 1.0 - tmp * tmp );
-                }
-                else {
-                    tmp = TWO_PI * ( phase * 4.0 - 3.0 );
-                    amp = ( tmp * tmp - 1.0 );
-                }
-                amp *= .01; // these get loud !
-                break;
-
-            case WaveForms::TRIANGLE:
-
-                // ---- triangle
-                if ( phase < .5 )
-                {
-                    tmp = ( phase * 4.0 - 1.0 );
-                    amp = ( 1.0 - tmp * tmp );
-                }
-                else {
-                    tmp = ( phase * 4.0 - 3.0 );
-                    amp = ( tmp * tmp - 1.0 );
-                }
-                // the actual triangulation function
-                amp = amp < 0 ? -amp : amp;
-
-                break;
-
-            case WaveForms::PWM:
-
-                // --- pulse width modulation
-                pmv = i + ( ++_pwmValue ); // i + event position
-
-                dpw = sin( pmv / 0x4800 ) * _pwr; // LFO -> PW
-                amp = phase < PI - dpw ? _pwAmp : -_pwAmp;
-
-                // PWM has its own phase update operation
-                phase = phase + ( TWO_PI_OVER_SR * frequency );
-                phase = phase > TWO_PI ? phase - TWO_PI : phase;
-
-                // we multiply the amplitude as PWM results in a "quieter" wave
-                amp *= 4;
-
-                break;
-
-            case WaveForms::NOISE:
-
-                // --- noise
-                if ( phase < .5 )
-                {
-                    tmp = ( phase * 4.0 - 1.0 );
-                    amp = ( 1.0 - tmp * tmp );
-                }
-                else {
-                    tmp = ( phase * 4.0 - 3.0 );
-                    amp = ( tmp * tmp - 1.0 );
-                }
-                // above we calculated pitch, now we add some
-                // randomization to the signal for the actual noise
-                amp *= randomFloat();
-                break;
-
-            case WaveForms::KARPLUS_STRONG:
-
-                // --- Karplus-Strong algorithm for plucked string-sound (0.990f being energy decay factor)
-                ringBuffer->enqueue(( 0.990f * (( ringBuffer->dequeue() + ringBuffer->peek() ) / 2 ) ));
-                amp = ringBuffer->peek();
+    for ( int i = renderStartOffset; i < renderEndOffset; )
+    {
+        int amount = std::min( KERNEL_BLOCK_SIZE, renderEndOffset - i );
 
-                break;
-        }
+        if ( doArpeggiator )
+            amount = std::min( amount, arpeggiator->getSamplesUntilStep() );
 
-        // --- phase update operations
-        if ( type != WaveForms::TABLE && type != WaveForms::PWM && type != WaveForms::KARPLUS_STRONG )
-        {
-            phase += aEvent->cachedProps.phaseIncr;
+        state.phaseIncr = aEvent->cachedProps.phaseIncr;
 
-            // keep phase within range
-            if ( phase > 1.0 )
-                phase -= 1.0;
-        }
+        renderOscillator( type, state, block, i, amount );
 
         // update modules
         if ( doArpeggiator )
         {
             // step the arpeggiator to the next position
-            if ( arpeggiator->peek() )
+            if ( arpeggiator->peek( amount ))
             {
                 frequency = arpeggiator->getPitchForStep( arpeggiator->getStep(), baseFrequency );
                 aEvent->setFrequency( frequency, false );
                 initializeEventProperties( aEvent, true ); // force update of ring buffers where applicable
-                if ( type == WaveForms::KARPLUS_STRONG ) ringBuffer = getRingBuffer( aEvent, frequency );
+                if ( type == WaveForms::KARPLUS_STRONG ) state.ringBuffer = getRingBuffer( aEvent, frequency, _oscillatorNum );
             }
         }
 
         // events frequency updated from outside (e.g. user shifted event note ?)
         // update the cached frequency
 
-        frequency = aEvent->getFrequency();
+        state.frequency = aEvent->getFrequency();
 
         // -- write the output into the buffers channels
 
-        for ( int c = 0, ca = aOutputBuffer->amountOfChannels; c < ca; ++c )
-            aOutputBuffer->getBufferForChannel( c )[ i ] += ( amp * volume );
+        for ( int c = 0; c < channelAmount; ++c )
+        {
+            SAMPLE_TYPE* channelBuffer = aOutputBuffer->getBufferForChannel( c ) + i;
+
+            for ( int j = 0; j < amount; ++j )
+                channelBuffer[ j ] += ( block[ j ] * volume );
+        }
+        i += amount;
     }
+    _pwmValue = state.pwmValue;
 
     // additional oscillators ? render their contents into the output buffer
 
@@ -326,10 +535,10 @@ void Synthesizer::render( AudioBuffer* aOutputBuffer, BaseSynthEvent* aEvent )
 
     // commit the updated event properties
 
-    aEvent->setPhaseForOscillator( _oscillatorNum, phase );
+    aEvent->setPhaseForOscillator( _oscillatorNum, state.phase );
 
     if ( waveTable != nullptr )
-        waveTable->setAccumulator( waveTableAccumulator );
+        waveTable->setAccumulator( state.accumulator );
 }
 
 void Synthesizer::updateProperties()
@@ -359,7 +568,7 @@ void Synthesizer::initializeEventProperties( BaseSynthEvent* aEvent, bool initia
         if ( _instrument->getOscillatorProperties( i )->getWaveform() == WaveForms::KARPLUS_STRONG )
         {
             SAMPLE_TYPE frequency  = tuneOscillator( i, aEvent->getFrequency() );
-            RingBuffer* ringBuffer = getRingBuffer( aEvent, frequency );
+            RingBuffer* ringBuffer = getRingBuffer( aEvent, frequency, i );
             initKarplusStrong( ringBuffer );
         }
     }
@@ -370,33 +579,14 @@ ResizableAudioBuffer* Synthesizer::getTempBuffer()
     return _tempBuffer;
 }
 
-/* protected methods */
-
-/**
- * creates a new/updates an existing additional oscillator
- *
- * @param aOscillatorNum index for the additional oscillator
- * @param aInstrument the synth instrument whose properties are used for synthesis
- */
-void Synthesizer::createOscillator( int aOscillatorNum )
+int Synthesizer::getFadeInDuration()
 {
-    if ( _instrument->getOscillatorAmount() > 1 &&
-         _oscillators.size() < ( _instrument->getOscillatorAmount() - 1 ))
-    {
-        _oscillators.push_back( new Synthesizer( _instrument, aOscillatorNum ));
-    }
+    return _fadeInDuration;
 }
 
-void Synthesizer::destroyOscillator( int aOscillatorNum )
+int Synthesizer::getFadeOutDuration()
 {
-    if ( _oscillators.size() < aOscillatorNum )
-        return;
-
-    Synthesizer* osc = _oscillators.at( aOscillatorNum );
-    _oscillators.erase( _oscillators.begin() + aOscillatorNum );
-
-    if ( osc != nullptr )
-        delete osc;
+    return _fadeOutDuration;
 }
 
 float Synthesizer::tuneOscillator( int aOscillatorNum, float aFrequency )
@@ -426,13 +616,59 @@ float Synthesizer::tuneOscillator( int aOscillatorNum, float aFrequency )
     return lfo2freq;
 }
 
-RingBuffer* Synthesizer::getRingBuffer( BaseSynthEvent* aEvent, float aFrequency )
+/* protected methods */
+
+/**
+ * creates a new/updates an existing additional oscillator
+ *
+ * @param aOscillatorNum index for the additional oscillator
+ * @param aInstrument the synth instrument whose properties are used for synthesis
+ */
+void Synthesizer::createOscillator( int aOscillatorNum )
 {
-    return BufferPool::getRingBufferForEvent( aEvent, aFrequency );
+    if ( _instrument->getOscillatorAmount() > 1 &&
+         _oscillators.size() < ( _instrument->getOscillatorAmount() - 1 ))
+    {
+        _oscillators.push_back( new Synthesizer( _instrument, aOscillatorNum ));
+    }
+}
+
+void Synthesizer::destroyOscillator( int aOscillatorNum )
+{
+    if ( _oscillators.size() < aOscillatorNum )
+        return;
+
+    Synthesizer* osc = _oscillators.at( aOscillatorNum );
+    _oscillators.erase( _oscillators.begin() + aOscillatorNum );
+
+    if ( osc != nullptr )
+        delete osc;
+}
+
+RingBuffer* Synthesizer::getRingBuffer( BaseSynthEvent* aEvent, float aFrequency, int aOscillatorNum )
+{
+    // live events use the preallocated ring buffers of their voice
+
+    SynthVoice* voice = _instrument->getVoicePool()->getVoice( aEvent );
+
+    if ( voice != nullptr && aOscillatorNum < voice->ringBuffers.size() )
+    {
+        RingBuffer* ringBuffer = voice->ringBuffers.at( aOscillatorNum );
+        int ringBufferLength   = ( int ) (( SAMPLE_TYPE ) AudioEngineProps::SAMPLE_RATE / aFrequency );
+
+        if ( ringBuffer->getBufferLength() != ringBufferLength ) {
+            ringBuffer->setBufferLength( ringBufferLength );
+        }
+        return ringBuffer;
+    }
+    return BufferPool::getRingBufferForEvent( aEvent, aOscillatorNum, aFrequency );
 }
 
 void Synthesizer::initKarplusStrong( RingBuffer* ringBuffer )
 {
+    if ( ringBuffer == nullptr )
+        return;
+
     ringBuffer->flush();
 
     // fill the ring buffer with noise (the initial "pluck" of the string)
@@ -55,6 +55,15 @@ class Synthesizer
         void initializeEventProperties( BaseSynthEvent* aEvent, bool initializeBuffers );
         ResizableAudioBuffer* getTempBuffer();
 
+        // the frequency an oscillator renders a note of given frequency at (applies oscillator detune/shifting)
+
+        float tuneOscillator( int aOscillatorNum, float aFrequency );
+
+        // the durations (in samples) of the fades applied by sine oscillators at the start and end of sequenced events
+
+        int getFadeInDuration();
+        int getFadeOutDuration();
+
     protected:
 
         int _oscillatorNum;
@@ -69,7 +78,9 @@ class Synthesizer
         float _pwr, _pwAmp, _pwmValue;      // PWM-specific
 
         // Karplus-Strong specific
-        RingBuffer* getRingBuffer( BaseSynthEvent* aEvent, float aFrequency );
+        // live events render using the ring buffers of their voice (see VoicePool), otherwise these are retrieved from the BufferPool
+        // (can return nullptr when the BufferPool is exhausted)
+        RingBuffer* getRingBuffer( BaseSynthEvent* aEvent, float aFrequency, int aOscillatorNum );
         void initKarplusStrong( RingBuffer* ringBuffer ); // fill a ring buffer with noise (initial "pluck" of a string sound)
 
         // E.O. SYNTHESIS VARIABLES -----------
@@ -80,7 +91,6 @@ class Synthesizer
         bool hasParent;
         void createOscillator ( int aOscillatorNum );
         void destroyOscillator( int aOscillatorNum );
-        float tuneOscillator  ( int aOscillatorNum, float aFrequency );
 };
 } // E.O namespace MWEngine
 
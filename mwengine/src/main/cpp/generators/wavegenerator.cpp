@@ -27,8 +27,102 @@
 #include <definitions/waveforms.h>
 #include <math.h>
 #include <cmath>
+#include <complex>
+#include <cstdint>
+#include <vector>
 
 namespace MWEngine {
+
+namespace {
+
+typedef std::complex<double> complex;
+
+// in-place iterative radix-2 FFT, size of data must be a power of two
+// the inverse transform is not normalized
+
+void fft( std::vector<complex>& data, bool inverse )
+{
+    int size = data.size();
+
+    // bit reversal permutation
+
+    for ( int i = 1, j = 0; i < size; ++i )
+    {
+        int bit = size >> 1;
+
+        for ( ; j & bit; bit >>= 1 )
+            j ^= bit;
+
+        j ^= bit;
+
+        if ( i < j )
+            std::swap( data[ i ], data[ j ]);
+    }
+
+    for ( int length = 2; length <= size; length <<= 1 )
+    {
+        double angle = ( inverse ? 2.0 : -2.0 ) * PI / length;
+        complex twiddle( cos( angle ), sin( angle ));
+
+        for ( int i = 0; i < size; i += length )
+        {
+            complex w( 1.0 );
+
+            for ( int j = 0, half = length / 2; j < half; ++j )
+            {
+                complex even = data[ i + j ];
+                complex odd  = data[ i + j + half ] * w;
+
+                data[ i + j ]        = even + odd;
+                data[ i + j + half ] = even - odd;
+
+                w *= twiddle;
+            }
+        }
+    }
+}
+
+// the spectrum of a table of arbitrary size (Bluestein's algorithm), expressing the transform as a
+// convolution that is computed using power of two sized FFTs of the zero-padded table (O(N log N))
+
+void bluestein( std::vector<complex>& data )
+{
+    int size = data.size();
+
+    int paddedSize = 1;
+    while ( paddedSize < size * 2 - 1 )
+        paddedSize <<= 1;
+
+    // the chirp e^(i * PI * n^2 / size), n^2 is wrapped by 2 * size to retain precision for large n
+
+    std::vector<complex> chirp( size );
+    for ( int n = 0; n < size; ++n )
+        chirp[ n ] = std::polar( 1.0, PI * ( double )(( int64_t ) n * n % ( 2 * size )) / size );
+
+    std::vector<complex> a( paddedSize, complex( 0.0 ));
+    std::vector<complex> b( paddedSize, complex( 0.0 ));
+
+    for ( int n = 0; n < size; ++n )
+        a[ n ] = data[ n ] * std::conj( chirp[ n ]);
+
+    b[ 0 ] = chirp[ 0 ];
+    for ( int n = 1; n < size; ++n )
+        b[ n ] = b[ paddedSize - n ] = chirp[ n ];
+
+    fft( a, false );
+    fft( b, false );
+
+    for ( int i = 0; i < paddedSize; ++i )
+        a[ i ] *= b[ i ];
+
+    fft( a, true );
+
+    for ( int k = 0; k < size; ++k )
+        data[ k ] = std::conj( chirp[ k ]) * a[ k ] / ( double ) paddedSize;
+}
+
+}
+
 namespace WaveGenerator
 {
     void generate( WaveTable* waveTable, int waveformType )
@@ -105,6 +199,71 @@ namespace WaveGenerator
             }
         }
     }
+
+    void generateMipmaps( WaveTable* waveTable )
+    {
+        SAMPLE_TYPE* buffer = waveTable->getBuffer();
+        int tableLength     = waveTable->tableLength;
+        int maxHarmonics    = tableLength / 2;
+
+        if ( maxHarmonics < 1 || tableLength > MAX_MIPMAP_TABLE_LENGTH || !waveTable->hasContent() ) {
+            waveTable->clearMipmaps();
+            return;
+        }
+
+        // the amount of mipmaps required to halve the harmonics down to the fundamental
+
+        int mipmapAmount = 1;
+        while (( maxHarmonics >> mipmapAmount ) > 0 )
+            ++mipmapAmount;
+
+        int mipmapLength = 1;
+        while ( mipmapLength < tableLength * MIPMAP_OVERSAMPLING )
+            mipmapLength <<= 1;
+
+        // calculate the spectrum of the table (Bluestein's algorithm for tables that aren't power of two sized)
+
+        std::vector<complex> spectrum( tableLength );
+
+        for ( int i = 0; i < tableLength; ++i )
+            spectrum[ i ] = complex( buffer[ i ], 0.0 );
+
+        if (( tableLength & ( tableLength - 1 )) == 0 )
+            fft( spectrum, false );
+        else
+            bluestein( spectrum );
+
+        // in an even sized table, the harmonic at the Nyquist frequency is not mirrored in the spectrum
+
+        if ( tableLength % 2 == 0 )
+            spectrum[ maxHarmonics ] *= 0.5;
+
+        // synthesize each mipmap from the harmonics that fit its level (the remainder of the spectrum is zeroed)
+
+        SAMPLE_TYPE* mipmaps = new SAMPLE_TYPE[ mipmapAmount * mipmapLength ];
+        std::vector<complex> bins( mipmapLength );
+
+        for ( int level = 0; level < mipmapAmount; ++level )
+        {
+            int harmonics = maxHarmonics >> level;
+
+            std::fill( bins.begin(), bins.end(), complex( 0.0 ));
+            bins[ 0 ] = spectrum[ 0 ];
+
+            for ( int k = 1; k <= harmonics; ++k )
+            {
+                bins[ k ]                = spectrum[ k ];
+                bins[ mipmapLength - k ] = std::conj( spectrum[ k ]);
+            }
+            fft( bins, true );
+
+            SAMPLE_TYPE* mipmap = mipmaps + level * mipmapLength;
+
+            for ( int i = 0; i < mipmapLength; ++i )
+                mipmap[ i ] = ( SAMPLE_TYPE ) ( bins[ i ].real() / tableLength );
+        }
+        waveTable->setMipmaps( mipmaps, mipmapAmount, mipmapLength, maxHarmonics );
+    }
 }
 
 } // E.O namespace MWEngine
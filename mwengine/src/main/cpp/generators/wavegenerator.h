@@ -38,6 +38,19 @@ namespace WaveGenerator
     // (also see TablePool for maintaining the cache)
 
     extern void generate( WaveTable* waveTable, int waveformType );
+
+    // generate the band-limited mipmaps for given WaveTables contents (see WaveTable::getMipmapForIncrement())
+    // each mipmap holds half the harmonics of the previous one (i.e. one mipmap per octave)
+    // and is oversampled by MIPMAP_OVERSAMPLING so it can be read with linear interpolation
+    // NOTE : like generate() this should be done upon application start (see TablePool::setTable())
+
+    // tables exceeding MAX_MIPMAP_TABLE_LENGTH (e.g. tables created from a WAV file, see WaveReader::fileToTable())
+    // are read without mipmaps, as each mipmap occupies MIPMAP_OVERSAMPLING times the length of the table
+
+    const int MIPMAP_OVERSAMPLING     = 4;
+    const int MAX_MIPMAP_TABLE_LENGTH = 4096;
+
+    extern void generateMipmaps( WaveTable* waveTable );
 }
 } // E.O namespace MWEngine
 
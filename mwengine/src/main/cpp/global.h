@@ -23,6 +23,7 @@
 #ifndef __MWENGINE__GLOBAL_H_INCLUDED__
 #define __MWENGINE__GLOBAL_H_INCLUDED__
 
+#include <atomic>
 #include <cmath>
 #include <limits.h>
 #include <stdint.h>
@@ -31,9 +32,12 @@
 namespace MWEngine {
 
 // PRECISION defines the floating-point precision used to synthesize the audio samples
-// valid options are 1 (32-bit float) and 2 (64-bit double)
+// valid options are 1 (32-bit float) and 2 (64-bit double). Can be overridden by the build
+// (e.g. -DPRECISION=1), the host build produces an engine for both precisions (see CMakeLists.txt)
 
+#ifndef PRECISION
 #define PRECISION 2
+#endif
 
 // if you wish to record audio from the Android device input, uncomment the RECORD_DEVICE_INPUT definition
 // (note this requires both android.permission.RECORD_AUDIO and android.permission.MODIFY_AUDIO_SETTINGS)
@@ -51,7 +55,14 @@ namespace MWEngine {
 #define LOGTAG "MWENGINE" // the logtag used when logging messages to logcat
 
 // if you wish to use the engine without JNI support (e.g. using solely C++/NDK), comment the USE_JNI definition
+// (note JNI is never available when building for the host, e.g. the native benchmark target)
+#ifdef __ANDROID__
 #define USE_JNI
+#endif
+
+// uncomment to profile the duration of each stage of the render cycle (see RenderProfiler)
+// this adds timing overhead to the render cycle and should not be used in production builds
+//#define PROFILE_RENDER
 
 // Performance improvement suggested at Google I/O 17.
 // Prevent CPU frequency scaling by adding a stabilizing load in the callback routine. This load
@@ -23,6 +23,7 @@
 #include "baseinstrument.h"
 #include <audioengine.h>
 #include <sequencer.h>
+#include <messaging/commandqueue.h>
 #include <utilities/eventutility.h>
 #include <algorithm>
 
@@ -38,6 +39,7 @@ BaseInstrument::BaseInstrument()
 BaseInstrument::~BaseInstrument()
 {
     dispose();
+    CommandQueue::synchronize();
 
     delete audioChannel;
     delete _audioEvents;
@@ -53,8 +55,22 @@ BaseInstrument::~BaseInstrument()
 void BaseInstrument::dispose()
 {
     unregisterFromSequencer();
+
+    // ensure the render thread no longer addresses this instrument (nor mutates its event lists)
+
+    CommandQueue::synchronize();
+
+    // detach the events that still reference this instrument, as they
+    // can outlive it (and would otherwise address it upon their disposal)
+
+    for ( auto events : { *_audioEvents, *_liveAudioEvents }) {
+        for ( auto audioEvent : events ) {
+            audioEvent->setInstrument( nullptr );
+        }
+    }
     clearEvents();
     clearMeasureCache();
+    _measureCacheInvalid.store( false );
 }
 
 bool BaseInstrument::hasEvents()
@@ -74,6 +90,9 @@ std::vector<BaseAudioEvent*>* BaseInstrument::getEvents()
 
 std::vector<BaseAudioEvent*>* BaseInstrument::getEventsForMeasure( int measureNum )
 {
+    if ( _measureCacheInvalid.exchange( false )) {
+        rebuildMeasureCache();
+    }
     return _audioEventsPerMeasure.size() <= measureNum ? nullptr : _audioEventsPerMeasure.at( measureNum );
 }
 
@@ -82,6 +101,11 @@ std::vector<BaseAudioEvent*>* BaseInstrument::getLiveEvents()
     return _liveAudioEvents;
 }
 
+EventIndex* BaseInstrument::getEventIndex()
+{
+    return &_eventIndex;
+}
+
 void BaseInstrument::updateEvents( float tempoRatio )
 {
     // when updating to reflect changes in the instruments properties
@@ -111,28 +135,20 @@ void BaseInstrument::updateEvents( float tempoRatio )
     }
 
     _freezeEvents = false;
-    clearMeasureCache();
+    _measureCacheInvalid.store( true );
+
+    // repositioning retains the order of the events, as such the index is updated in a single pass
 
-    for ( i = 0; i < total; ++i ) {
-        addEventToMeasureCache( _audioEvents->at( i ));
-    };
+    _eventIndex.refresh();
 }
 
 void BaseInstrument::clearEvents()
 {
-    if ( _audioEvents != nullptr )
-    {
-        while ( !_audioEvents->empty() ) {
-            removeEvent( _audioEvents->at( 0 ), false );
-        }
-    }
-
-    if ( _liveAudioEvents != nullptr )
-    {
-        while ( !_liveAudioEvents->empty() ) {
-            removeEvent( _liveAudioEvents->at( 0 ), true );
-        }
+    if ( CommandQueue::isDeferred() ) {
+        CommandQueue::post({ .type = CommandQueue::CLEAR_EVENTS, .instrument = this });
+        return;
     }
+    applyClearEvents();
 }
 
 void BaseInstrument::addEvent( BaseAudioEvent* audioEvent, bool isLiveEvent )
@@ -141,23 +157,86 @@ void BaseInstrument::addEvent( BaseAudioEvent* audioEvent, bool isLiveEvent )
         return;
     }
 
-    if ( isLiveEvent ) {
-        _liveAudioEvents->push_back( audioEvent );
-    } else {
-        _audioEvents->push_back( audioEvent );
-        addEventToMeasureCache( audioEvent );
+    int amount = ( isLiveEvent ? _liveEventAmount : _eventAmount ).fetch_add( 1 ) + 1;
+
+    if ( !CommandQueue::isDeferred() ) {
+        applyAddEvent( audioEvent, isLiveEvent );
+        return;
     }
+
+    // the render thread can't grow the lists, exchange them for larger ones prior to posting the addition
+
+    if ( amount > ( isLiveEvent ? _liveEventCapacity : _eventCapacity ).load() ) {
+        reserveEvents( isLiveEvent );
+    }
+
+    if ( !isLiveEvent ) {
+        audioEvent->setAddedToSequencer( true );
+    }
+    CommandQueue::post({ .type = CommandQueue::ADD_EVENT, .instrument = this, .audioEvent = audioEvent, .isLiveEvent = isLiveEvent });
 }
 
 bool BaseInstrument::removeEvent( BaseAudioEvent* audioEvent, bool isLiveEvent )
 {
-    if ( _freezeEvents ) {
+    if ( _freezeEvents || audioEvent == nullptr ) {
         return false;
     }
 
+    if ( !CommandQueue::isDeferred() ) {
+        return applyRemoveEvent( audioEvent, isLiveEvent );
+    }
+
+    if ( !isLiveEvent ) {
+        audioEvent->setAddedToSequencer( false );
+    }
+    CommandQueue::post({ .type = CommandQueue::REMOVE_EVENT, .instrument = this, .audioEvent = audioEvent, .isLiveEvent = isLiveEvent });
+    return true;
+}
+
+bool BaseInstrument::applyAddEvent( BaseAudioEvent* audioEvent, bool isLiveEvent )
+{
+    std::vector<BaseAudioEvent*>* events = isLiveEvent ? _liveAudioEvents : _audioEvents;
+
+    if ( !hasCapacity( events ))
+    {
+        ( isLiveEvent ? _liveEventAmount : _eventAmount ).fetch_sub( 1 );
+
+        if ( !isLiveEvent ) {
+            audioEvent->setAddedToSequencer( false );
+        }
+        return false;
+    }
+    events->push_back( audioEvent );
+
+    if ( !isLiveEvent ) {
+        _eventIndex.add( audioEvent );
+        _measureCacheInvalid.store( true );
+        audioEvent->setAddedToSequencer( true );
+    }
+
+    // the list grew while the engine isn't rendering, reserve the same room for the collected events
+
+    std::atomic<int>& capacity = isLiveEvent ? _liveEventCapacity : _eventCapacity;
+
+    if ( events->capacity() > ( size_t ) capacity.load() )
+    {
+        capacity.store(( int ) events->capacity() );
+
+        if ( isLiveEvent ) {
+            audioChannel->liveEvents.reserve( events->capacity() );
+        } else {
+            audioChannel->audioEvents.reserve( events->capacity() );
+            _eventIndex.reserve( events->capacity() );
+        }
+    }
+    return true;
+}
+
+bool BaseInstrument::applyRemoveEvent( BaseAudioEvent* audioEvent, bool isLiveEvent )
+{
     bool removed = false;
 
-    if ( audioEvent == nullptr || _liveAudioEvents == nullptr || _audioEvents == nullptr ) {
+    if ( _liveAudioEvents == nullptr || _audioEvents == nullptr ) {
         return removed;
     }
 
@@ -165,6 +244,7 @@ bool BaseInstrument::removeEvent( BaseAudioEvent* audioEvent, bool isLiveEvent )
     {
         removed = EventUtility::removeEventFromVector( _liveAudioEvents, audioEvent );
         if ( removed ) {
+            _liveEventAmount.fetch_sub( 1 );
             audioEvent->resetPlayState();
         }
     }
@@ -172,15 +252,81 @@ bool BaseInstrument::removeEvent( BaseAudioEvent* audioEvent, bool isLiveEvent )
     {
         removed = EventUtility::removeEventFromVector( _audioEvents, audioEvent );
         if ( removed ) {
-            removeEventFromMeasureCache( audioEvent );
+            _eventAmount.fetch_sub( 1 );
+            _eventIndex.remove( audioEvent );
+            _measureCacheInvalid.store( true );
+            audioEvent->setAddedToSequencer( false );
         }
     }
     return removed;
 }
 
+void BaseInstrument::applyClearEvents()
+{
+    if ( _audioEvents != nullptr )
+    {
+        while ( !_audioEvents->empty() ) {
+            applyRemoveEvent( _audioEvents->at( 0 ), false );
+        }
+    }
+
+    if ( _liveAudioEvents != nullptr )
+    {
+        while ( !_liveAudioEvents->empty() ) {
+            applyRemoveEvent( _liveAudioEvents->at( 0 ), true );
+        }
+    }
+}
+
+void BaseInstrument::applyReserveEvents()
+{
+    EventStorage* storage = _pendingStorage;
+
+    if ( storage == nullptr ) {
+        return;
+    }
+    _pendingStorage = nullptr;
+
+    // move the events into the prepared storage (which has reserved room for these, e.g. this doesn't allocate)
+    // after which the storage holds the previous lists, to be disposed by the control thread
+
+    std::vector<BaseAudioEvent*>*& events       = storage->isLiveEvent ? _liveAudioEvents : _audioEvents;
+    std::vector<BaseAudioEvent*>& channelEvents = storage->isLiveEvent ? audioChannel->liveEvents : audioChannel->audioEvents;
+
+    storage->events->assign( events->begin(), events->end() );
+    std::swap( events, storage->events );
+
+    storage->channelEvents.assign( channelEvents.begin(), channelEvents.end() );
+    channelEvents.swap( storage->channelEvents );
+
+    if ( !storage->isLiveEvent )
+    {
+        for ( auto audioEvent : *_audioEvents ) {
+            storage->eventIndex.add( audioEvent );
+        }
+        _eventIndex.swap( storage->eventIndex );
+    }
+}
+
+void BaseInstrument::applyUpdate()
+{
+    // override in derived class
+}
+
+void BaseInstrument::beginEventMix( AudioBuffer* )
+{
+    // override in derived class
+}
+
+void BaseInstrument::endEventMix()
+{
+    // override in derived class
+}
+
 void BaseInstrument::registerInSequencer()
 {
-    index = Sequencer::registerInstrument( this );
+    // index is assigned by the Sequencer once the registration is applied
+    Sequencer::registerInstrument( this );
 }
 
 void BaseInstrument::unregisterFromSequencer()
@@ -200,36 +346,106 @@ void BaseInstrument::construct()
     _audioEvents     = new std::vector<BaseAudioEvent*>();
     _liveAudioEvents = new std::vector<BaseAudioEvent*>();
 
+    // reserve room so events posted by the control thread can be added by the render thread without allocation
+
+    _audioEvents->reserve( EVENT_CAPACITY );
+    _liveAudioEvents->reserve( EVENT_CAPACITY );
+    _eventIndex.reserve( EVENT_CAPACITY );
+
+    _measureCacheInvalid.store( false );
+
+    _eventAmount.store( 0 );
+    _liveEventAmount.store( 0 );
+    _eventCapacity.store( EVENT_CAPACITY );
+    _liveEventCapacity.store( EVENT_CAPACITY );
+
     // register instrument inside the sequencer
 
     registerInSequencer();
 }
 
-void BaseInstrument::addEventToMeasureCache( BaseAudioEvent* audioEvent )
+void BaseInstrument::postUpdate()
 {
-    unsigned long startMeasureForEvent = EventUtility::getStartMeasureForEvent( audioEvent );
-    unsigned long endMeasureForEvent   = EventUtility::getEndMeasureForEvent( audioEvent );
+    if ( !CommandQueue::isDeferred() ) {
+        applyUpdate();
+        return;
+    }
+    CommandQueue::post({ .type = CommandQueue::UPDATE_INSTRUMENT, .instrument = this });
+    CommandQueue::synchronize();
+}
 
-    for ( unsigned long i = startMeasureForEvent; i <= endMeasureForEvent; ++i ) {
-        while ( _audioEventsPerMeasure.size() <= i ) {
-            _audioEventsPerMeasure.push_back( new std::vector<BaseAudioEvent*>() );
-        }
-        _audioEventsPerMeasure.at( i )->push_back( audioEvent );
+void BaseInstrument::reserveEvents( bool isLiveEvent )
+{
+    // serializes the control threads, this is never acquired by the render thread
+
+    std::lock_guard<std::mutex> guard( _reserveMutex );
+
+    std::atomic<int>& capacity = isLiveEvent ? _liveEventCapacity : _eventCapacity;
+    int amount = ( isLiveEvent ? _liveEventAmount : _eventAmount ).load();
+
+    if ( amount <= capacity.load() ) {
+        return; // reserved by another control thread in the meantime
+    }
+
+    int reservedCapacity = capacity.load();
+    while ( reservedCapacity < amount ) {
+        reservedCapacity *= 2;
+    }
+
+    auto storage = new EventStorage();
+
+    storage->isLiveEvent = isLiveEvent;
+    storage->events      = new std::vector<BaseAudioEvent*>();
+
+    storage->events->reserve( reservedCapacity );
+    storage->channelEvents.reserve( reservedCapacity );
+
+    if ( !isLiveEvent ) {
+        storage->eventIndex.reserve( reservedCapacity );
+    }
+
+    _pendingStorage = storage;
+
+    CommandQueue::post({ .type = CommandQueue::RESERVE_EVENTS, .instrument = this });
+    CommandQueue::synchronize();
+
+    capacity.store( reservedCapacity );
+
+    delete storage->events;
+    delete storage;
+}
+
+bool BaseInstrument::hasCapacity( std::vector<BaseAudioEvent*>* events )
+{
+    // the lists can only grow when the engine isn't rendering
+
+    return events->size() < events->capacity() || !AudioEngineProps::isRendering.load();
+}
+
+void BaseInstrument::rebuildMeasureCache()
+{
+    // apply the pending additions and removals first
+
+    CommandQueue::synchronize();
+
+    for ( auto eventVector : _audioEventsPerMeasure ) {
+        eventVector->clear();
+    }
+    for ( auto audioEvent : *_audioEvents ) {
+        addEventToMeasureCache( audioEvent );
     }
 }
 
-void BaseInstrument::removeEventFromMeasureCache( BaseAudioEvent* audioEvent )
+void BaseInstrument::addEventToMeasureCache( BaseAudioEvent* audioEvent )
 {
-    unsigned long startMeasureForEvent     = EventUtility::getStartMeasureForEvent( audioEvent );
-    unsigned long endMeasureForEvent       = EventUtility::getEndMeasureForEvent( audioEvent );
-    unsigned long audioEventPerMeasureSize = _audioEventsPerMeasure.size();
+    int startMeasure = ( int ) EventUtility::getStartMeasureForEvent( audioEvent );
+    int endMeasure   = ( int ) EventUtility::getEndMeasureForEvent( audioEvent );
 
-    for ( size_t i = startMeasureForEvent; i <= endMeasureForEvent; ++i ) {
-        if ( i >= audioEventPerMeasureSize ) {
-            return;
+    for ( int i = startMeasure; i <= endMeasure; ++i ) {
+        while ( _audioEventsPerMeasure.size() <= i ) {
+            _audioEventsPerMeasure.push_back( new std::vector<BaseAudioEvent*>() );
         }
-        auto eventVector = _audioEventsPerMeasure.at( i );
-        EventUtility::removeEventFromVector( eventVector, audioEvent );
+        _audioEventsPerMeasure.at( i )->push_back( audioEvent );
     }
 }
 
@@ -25,6 +25,9 @@
 
 #include "../audiochannel.h"
 #include <events/baseaudioevent.h>
+#include <utilities/eventindex.h>
+#include <atomic>
+#include <mutex>
 
 namespace MWEngine {
 class BaseInstrument
@@ -43,16 +46,39 @@ class BaseInstrument
         virtual std::vector<BaseAudioEvent*>* getEventsForMeasure( int measureNum );
         virtual std::vector<BaseAudioEvent*>* getLiveEvents();
 
+        // indexes the sequenced events by their playback range (used by the Sequencer to collect the events to render)
+        EventIndex* getEventIndex();
+
         virtual void clearEvents();
 
         // internal to the engine
-        // addition and removal of events is performed when the Sequencer is collecting audible
-        // content for the engine to render. By managing this through the Sequencer we omit the
-        // need for thread locks or mutexes when changing event lists during rendering
+        // while the engine is rendering, addition and removal of events requested by a control thread
+        // is posted into the CommandQueue and applied by the render thread at the start of its next
+        // render cycle. This omits the need for thread locks or mutexes when changing event lists
+        // during rendering. Note removeEvent() returns true when the removal has been posted
 
 #ifndef SWIG
         void addEvent( BaseAudioEvent* audioEvent, bool isLiveEvent );
         bool removeEvent( BaseAudioEvent* audioEvent, bool isLiveEvent );
+
+        // applied by the CommandQueue. While the engine is rendering, the event lists can't grow (as this would
+        // allocate on the render thread). An addition requested by a control thread that exceeds the capacity of
+        // the lists is preceded by the exchange of larger lists (see reserveEvents()), as such only additions
+        // made by the render thread itself can be rejected
+
+        virtual bool applyAddEvent   ( BaseAudioEvent* audioEvent, bool isLiveEvent );
+        virtual bool applyRemoveEvent( BaseAudioEvent* audioEvent, bool isLiveEvent );
+        void applyClearEvents();
+        void applyReserveEvents();
+
+        // applies the state changes of the instrument that were prepared by a control thread (see postUpdate())
+        virtual void applyUpdate();
+
+        // invoked by the engine before and after mixing the instruments events into the output buffer of its
+        // AudioChannel, allows instruments to render their events in batches (see SynthInstrument)
+
+        virtual void beginEventMix( AudioBuffer* outputBuffer );
+        virtual void endEventMix();
 #endif
 
         void registerInSequencer();
@@ -61,20 +87,60 @@ class BaseInstrument
         AudioChannel *audioChannel;
         int index;  // index in the Sequencers instrument Vector
 
+        // the amount of events the event lists have reserved room for upon construction (doubled when exceeded)
+
+        static const int EVENT_CAPACITY = 256;
+
     protected:
         virtual void construct();
 
         std::vector<BaseAudioEvent*>* _audioEvents;
         std::vector<BaseAudioEvent*>* _liveAudioEvents;
 
-        // a vector that indexes all sequenced events by measure for easy lookup by the sequencer
+        // a vector that indexes all sequenced events by measure for easy lookup. This is only queried by
+        // control threads and thus (re)built by getEventsForMeasure() when the sequenced events have changed
         std::vector<std::vector<BaseAudioEvent*>*> _audioEventsPerMeasure;
+        std::atomic<bool> _measureCacheInvalid;
+
+        EventIndex _eventIndex;
 
         bool _freezeEvents = false;
 
+        // the amount of events added to (or pending addition to) the event lists, and the amount of events the
+        // lists have reserved room for
+
+        std::atomic<int> _eventAmount;
+        std::atomic<int> _liveEventAmount;
+        std::atomic<int> _eventCapacity;
+        std::atomic<int> _liveEventCapacity;
+
+        // storage of a larger capacity, prepared by a control thread for the render thread to move the events into
+
+        struct EventStorage {
+            bool isLiveEvent;
+            std::vector<BaseAudioEvent*>* events;
+            std::vector<BaseAudioEvent*> channelEvents;
+            EventIndex eventIndex;
+        };
+        EventStorage* _pendingStorage = nullptr;
+        std::mutex _reserveMutex;
+
+        // grows the event list for given event type to fit the requested amount of events, when the engine is
+        // rendering this blocks until the render thread has moved the events into the larger list
+
+        void reserveEvents( bool isLiveEvent );
+
+        // applies a state change that must not occur while the render thread addresses the instrument (e.g. swapping
+        // preallocated resources), when the engine is rendering this blocks until the render thread has applied the update
+
+        void postUpdate();
+
+        // whether an event can be added to given list (e.g. without allocating while rendering)
+        bool hasCapacity( std::vector<BaseAudioEvent*>* events );
+
         void clearMeasureCache();
+        void rebuildMeasureCache();
         void addEventToMeasureCache( BaseAudioEvent* audioEvent );
-        void removeEventFromMeasureCache( BaseAudioEvent* audioEvent );
 };
 } // E.O namespace MWEngine
 
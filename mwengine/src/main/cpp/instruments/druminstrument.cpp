@@ -39,7 +39,7 @@ DrumInstrument::DrumInstrument()
 
 DrumInstrument::~DrumInstrument()
 {
-    clearEvents();
+    dispose();
 
     delete rOsc;
     delete drumPatterns;
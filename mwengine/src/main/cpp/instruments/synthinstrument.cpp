@@ -26,6 +26,7 @@
 #include <definitions/waveforms.h>
 #include <events/basesynthevent.h>
 #include <utilities/utils.h>
+#include <algorithm>
 #include <cstddef>
 #include <audioengine.h>
 
@@ -41,6 +42,10 @@ SynthInstrument::SynthInstrument()
 
 SynthInstrument::~SynthInstrument()
 {
+    dispose(); // while the ADSR is available (determines the event ranges)
+
+    delete _voicePool;
+    delete _voiceRenderer;
     delete adsr;
     delete rOsc;
     delete arpeggiator;
@@ -58,12 +63,17 @@ int SynthInstrument::getOscillatorAmount()
 
 void SynthInstrument::setOscillatorAmount( int aAmount )
 {
-    oscAmount = aAmount;
+    oscAmount = std::min( aAmount, MAX_OSCILLATOR_AMOUNT );
 
     if ( oscillators.size() < oscAmount )
         reserveOscillators( oscAmount );
 
     synthesizer->updateProperties();
+
+    // ensure the voices hold the render state for each oscillator
+
+    if ( _voicePool->getOscillatorAmount() < oscAmount )
+        createVoicePool( _voicePool->getMaxPolyphony(), oscAmount );
 }
 
 void SynthInstrument::reserveOscillators( int aAmount )
@@ -86,6 +96,100 @@ OscillatorProperties* SynthInstrument::getOscillatorProperties( int aOscillatorN
     return oscillators.at( aOscillatorNum );
 }
 
+int SynthInstrument::getMaxPolyphony()
+{
+    return _voicePool->getMaxPolyphony();
+}
+
+void SynthInstrument::setMaxPolyphony( int maxPolyphony )
+{
+    if ( maxPolyphony != _voicePool->getMaxPolyphony() ) {
+        createVoicePool( maxPolyphony, _voicePool->getOscillatorAmount() );
+    }
+}
+
+VoiceStealing::policies SynthInstrument::getVoiceStealingPolicy()
+{
+    return _voicePool->getStealingPolicy();
+}
+
+void SynthInstrument::setVoiceStealingPolicy( VoiceStealing::policies policy )
+{
+    _voicePool->setStealingPolicy( policy );
+}
+
+bool SynthInstrument::getBatchedRendering()
+{
+    return _voiceRenderer->isEnabled();
+}
+
+void SynthInstrument::setBatchedRendering( bool value )
+{
+    _voiceRenderer->setEnabled( value );
+}
+
+VoicePool* SynthInstrument::getVoicePool()
+{
+    return _voicePool;
+}
+
+VoiceRenderer* SynthInstrument::getVoiceRenderer()
+{
+    return _voiceRenderer;
+}
+
+bool SynthInstrument::applyAddEvent( BaseAudioEvent* audioEvent, bool isLiveEvent )
+{
+    bool added = BaseInstrument::applyAddEvent( audioEvent, isLiveEvent );
+
+    if ( added && isLiveEvent ) {
+        auto synthEvent = static_cast<BaseSynthEvent*>( audioEvent ); // NOLINT
+
+        _voicePool->acquire( synthEvent );
+        synthesizer->initializeEventProperties( synthEvent, true ); // prepares the ring buffers of the voice
+    }
+    return added;
+}
+
+bool SynthInstrument::applyRemoveEvent( BaseAudioEvent* audioEvent, bool isLiveEvent )
+{
+    bool removed = BaseInstrument::applyRemoveEvent( audioEvent, isLiveEvent );
+
+    if ( isLiveEvent ) {
+        _voicePool->release( audioEvent );
+    }
+    return removed;
+}
+
+void SynthInstrument::applyUpdate()
+{
+    if ( _pendingVoicePool == nullptr ) {
+        return;
+    }
+
+    // move the playing live events onto the voices of the new pool
+
+    _voicePool->transferTo( _pendingVoicePool );
+
+    _retiredVoicePool = _voicePool;
+    _voicePool        = _pendingVoicePool;
+    _pendingVoicePool = nullptr;
+
+    for ( auto audioEvent : *_liveAudioEvents ) {
+        synthesizer->initializeEventProperties( static_cast<BaseSynthEvent*>( audioEvent ), true ); // NOLINT
+    }
+}
+
+void SynthInstrument::beginEventMix( AudioBuffer* outputBuffer )
+{
+    _voiceRenderer->begin( outputBuffer );
+}
+
+void SynthInstrument::endEventMix()
+{
+    _voiceRenderer->flush();
+}
+
 /* protected methods */
 
 void SynthInstrument::init()
@@ -104,6 +208,13 @@ void SynthInstrument::init()
     keyboardOctave  = 4;
     keyboardVolume  = 0.5;
 
+    // voices for the live events
+
+    _voicePool        = new VoicePool( this, DEFAULT_POLYPHONY, 1 );
+    _pendingVoicePool = nullptr;
+    _retiredVoicePool = nullptr;
+    _voiceRenderer    = new VoiceRenderer( this );
+
     // modules
 
     rOsc              = new RouteableOscillator();
@@ -117,4 +228,19 @@ void SynthInstrument::init()
     setOscillatorAmount( 1 );
 }
 
+/**
+ * the voices are preallocated by the calling (control) thread, replacing the
+ * existing pool once the render thread no longer addresses it (see applyUpdate())
+ */
+void SynthInstrument::createVoicePool( int maxPolyphony, int oscillatorAmount )
+{
+    _pendingVoicePool = new VoicePool( this, maxPolyphony, oscillatorAmount );
+    _pendingVoicePool->setStealingPolicy( _voicePool->getStealingPolicy() );
+
+    postUpdate();
+
+    delete _retiredVoicePool;
+    _retiredVoicePool = nullptr;
+}
+
 } // E.O namespace MWEngine
@@ -25,7 +25,10 @@
 
 #include "baseinstrument.h"
 #include "../audiochannel.h"
+#include <definitions/voicestealing.h>
 #include <instruments/oscillatorproperties.h>
+#include <instruments/voicepool.h>
+#include <instruments/voicerenderer.h>
 #include <events/baseaudioevent.h>
 #include <generators/synthesizer.h>
 #include <modules/adsr.h>
@@ -60,12 +63,49 @@ class SynthInstrument : public BaseInstrument
         RouteableOscillator *rOsc;
         ADSR* adsr;
 
+        // polyphony of the live events (events exceeding the maximum polyphony steal the voice
+        // of a playing event, as determined by the voice stealing policy, see VoicePool)
+
+        static constexpr int DEFAULT_POLYPHONY = 16;
+
+        int getMaxPolyphony();
+        void setMaxPolyphony( int maxPolyphony );
+        VoiceStealing::policies getVoiceStealingPolicy();
+        void setVoiceStealingPolicy( VoiceStealing::policies policy );
+
+        // whether the events are rendered in batches (multiple voices at a time, see VoiceRenderer)
+        // rather than individually. Enabled by default, applies to phase based waveforms only
+
+        bool getBatchedRendering();
+        void setBatchedRendering( bool value );
+
+#ifndef SWIG
+        // internal to the engine
+
+        VoicePool* getVoicePool();
+        VoiceRenderer* getVoiceRenderer();
+
+        bool applyAddEvent   ( BaseAudioEvent* audioEvent, bool isLiveEvent );
+        bool applyRemoveEvent( BaseAudioEvent* audioEvent, bool isLiveEvent );
+        void applyUpdate();
+
+        void beginEventMix( AudioBuffer* outputBuffer );
+        void endEventMix();
+#endif
+
     protected:
 
         int oscAmount;      // amount of oscillators, minimum == 1
         std::vector<OscillatorProperties*> oscillators;
 
+        VoicePool* _voicePool;
+        VoicePool* _pendingVoicePool; // replaces _voicePool upon applyUpdate()
+        VoicePool* _retiredVoicePool; // the replaced pool, disposed by the thread that created its replacement
+
+        VoiceRenderer* _voiceRenderer;
+
         void init();
+        void createVoicePool( int maxPolyphony, int oscillatorAmount );
 };
 } // E.O namespace MWEngine
 
@@ -0,0 +1,311 @@
+/**
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2026 Igor Zinken - https://www.igorski.nl
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#include "voicepool.h"
+#include "synthinstrument.h"
+#include "../global.h"
+#include <utilities/bufferutility.h>
+#include <algorithm>
+
+namespace MWEngine {
+
+/* constructor / destructor */
+
+VoicePool::VoicePool( SynthInstrument* instrument, int maxPolyphony, int oscillatorAmount )
+{
+    _instrument       = instrument;
+    _maxPolyphony     = std::max( 1, maxPolyphony );
+    _oscillatorAmount = oscillatorAmount;
+    _fadeDuration     = std::max( 1, BufferUtility::millisecondsToBuffer( FADE_DURATION, AudioEngineProps::SAMPLE_RATE ));
+    _acquisitions     = 0;
+    _stealingPolicy   = VoiceStealing::OLDEST;
+
+    int ringBufferCapacity = AudioEngineProps::SAMPLE_RATE / MIN_FREQUENCY;
+
+    for ( int i = 0, total = _maxPolyphony + FADE_VOICES; i < total; ++i )
+    {
+        auto voice = new SynthVoice();
+
+        voice->event         = nullptr;
+        voice->order         = 0;
+        voice->fadeRemaining = 0;
+
+        for ( int o = 0; o < _oscillatorAmount; ++o ) {
+            voice->ringBuffers.push_back( new RingBuffer( ringBufferCapacity ));
+        }
+        _voices.push_back( voice );
+    }
+}
+
+VoicePool::~VoicePool()
+{
+    for ( auto voice : _voices )
+    {
+        for ( auto ringBuffer : voice->ringBuffers ) {
+            delete ringBuffer;
+        }
+        delete voice;
+    }
+    _voices.clear();
+}
+
+/* public methods */
+
+int VoicePool::getMaxPolyphony()
+{
+    return _maxPolyphony;
+}
+
+int VoicePool::getOscillatorAmount()
+{
+    return _oscillatorAmount;
+}
+
+VoiceStealing::policies VoicePool::getStealingPolicy()
+{
+    return _stealingPolicy;
+}
+
+void VoicePool::setStealingPolicy( VoiceStealing::policies policy )
+{
+    _stealingPolicy = policy;
+}
+
+SynthVoice* VoicePool::acquire( BaseSynthEvent* event )
+{
+    SynthVoice* voice = getVoice( event );
+
+    // event is retriggered while it is still playing, continue using its voice
+
+    if ( voice != nullptr )
+    {
+        voice->order         = ++_acquisitions;
+        voice->fadeRemaining = 0;
+
+        return voice;
+    }
+
+    // maximum polyphony reached ? fade out a playing voice
+
+    if ( getActiveVoiceAmount() >= _maxPolyphony ) {
+        getVoiceToSteal()->fadeRemaining = _fadeDuration;
+    }
+
+    voice = getFreeVoice();
+
+    // all voices reserved for fading are in use, cut off the voice that is closest to completing its
+    // fade (note the voice is cleared prior to removing its event so the removal leaves it untouched)
+
+    if ( voice == nullptr )
+    {
+        voice = getVoiceToCutOff();
+
+        BaseSynthEvent* cutOffEvent = voice->event;
+        voice->event = nullptr;
+
+        _instrument->applyRemoveEvent( cutOffEvent, true );
+    }
+
+    voice->event         = event;
+    voice->order         = ++_acquisitions;
+    voice->fadeRemaining = 0;
+
+    return voice;
+}
+
+void VoicePool::release( BaseAudioEvent* event )
+{
+    for ( auto voice : _voices )
+    {
+        if ( voice->event == event ) {
+            voice->event         = nullptr;
+            voice->fadeRemaining = 0;
+            return;
+        }
+    }
+}
+
+SynthVoice* VoicePool::getVoice( BaseAudioEvent* event )
+{
+    for ( auto voice : _voices ) {
+        if ( voice->event == event ) {
+            return voice;
+        }
+    }
+    return nullptr;
+}
+
+int VoicePool::getActiveVoiceAmount()
+{
+    int amount = 0;
+
+    for ( auto voice : _voices ) {
+        if ( voice->event != nullptr && voice->fadeRemaining == 0 ) {
+            ++amount;
+        }
+    }
+    return amount;
+}
+
+bool VoicePool::applyFade( SynthVoice* voice, AudioBuffer* buffer )
+{
+    if ( voice->fadeRemaining <= 0 ) {
+        return false;
+    }
+
+    int bufferSize = buffer->bufferSize;
+    int fadeLength = std::min( voice->fadeRemaining, bufferSize );
+
+    for ( int c = 0, ca = buffer->amountOfChannels; c < ca; ++c )
+    {
+        SAMPLE_TYPE* channelBuffer = buffer->getBufferForChannel( c );
+
+        for ( int i = 0; i < fadeLength; ++i ) {
+            channelBuffer[ i ] *= ( SAMPLE_TYPE ) ( voice->fadeRemaining - i ) / ( SAMPLE_TYPE ) _fadeDuration;
+        }
+
+        for ( int i = fadeLength; i < bufferSize; ++i ) {
+            channelBuffer[ i ] = 0.0;
+        }
+    }
+    voice->fadeRemaining -= fadeLength;
+
+    // note we keep the voice in the fading state (as a non-zero value) until its event is removed
+
+    if ( voice->fadeRemaining <= 0 ) {
+        voice->fadeRemaining = 1;
+        return true;
+    }
+    return false;
+}
+
+void VoicePool::transferTo( VoicePool* pool )
+{
+    while ( true )
+    {
+        SynthVoice* oldest = nullptr;
+
+        for ( auto voice : _voices ) {
+            if ( voice->event != nullptr && ( oldest == nullptr || voice->order < oldest->order )) {
+                oldest = voice;
+            }
+        }
+
+        if ( oldest == nullptr ) {
+            break;
+        }
+
+        BaseSynthEvent* event = oldest->event;
+        int fadeRemaining     = oldest->fadeRemaining;
+
+        oldest->event         = nullptr;
+        oldest->fadeRemaining = 0;
+
+        SynthVoice* voice = pool->acquire( event );
+
+        if ( fadeRemaining > 0 ) {
+            voice->fadeRemaining = fadeRemaining;
+        }
+    }
+}
+
+/* private methods */
+
+SynthVoice* VoicePool::getFreeVoice()
+{
+    for ( auto voice : _voices ) {
+        if ( voice->event == nullptr ) {
+            return voice;
+        }
+    }
+    return nullptr;
+}
+
+SynthVoice* VoicePool::getVoiceToSteal()
+{
+    SynthVoice* candidate = nullptr;
+    bool candidateReleased = false;
+    SAMPLE_TYPE candidateLevel = 0.0;
+
+    for ( auto voice : _voices )
+    {
+        // only playing voices can be stolen (omitting voices that are already fading out)
+
+        if ( voice->event == nullptr || voice->fadeRemaining > 0 ) {
+            continue;
+        }
+
+        bool isOlder = candidate == nullptr || voice->order < candidate->order;
+
+        switch ( _stealingPolicy )
+        {
+            default:
+            case VoiceStealing::OLDEST:
+                if ( isOlder ) {
+                    candidate = voice;
+                }
+                break;
+
+            case VoiceStealing::QUIETEST:
+            {
+                SAMPLE_TYPE level = getVoiceLevel( voice );
+
+                if ( candidate == nullptr || level < candidateLevel || ( level == candidateLevel && isOlder )) {
+                    candidate      = voice;
+                    candidateLevel = level;
+                }
+                break;
+            }
+
+            case VoiceStealing::RELEASED_FIRST:
+            {
+                bool released = voice->event->released;
+
+                if ( candidate == nullptr || ( released && !candidateReleased ) || ( released == candidateReleased && isOlder )) {
+                    candidate         = voice;
+                    candidateReleased = released;
+                }
+                break;
+            }
+        }
+    }
+    return candidate;
+}
+
+SynthVoice* VoicePool::getVoiceToCutOff()
+{
+    SynthVoice* candidate = nullptr;
+
+    for ( auto voice : _voices ) {
+        if ( voice->fadeRemaining > 0 && ( candidate == nullptr || voice->fadeRemaining < candidate->fadeRemaining )) {
+            candidate = voice;
+        }
+    }
+    return candidate;
+}
+
+SAMPLE_TYPE VoicePool::getVoiceLevel( SynthVoice* voice )
+{
+    return voice->event->cachedProps.envelope * ( SAMPLE_TYPE ) voice->event->getVolume();
+}
+
+} // E.O namespace MWEngine
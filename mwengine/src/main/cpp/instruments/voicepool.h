@@ -0,0 +1,112 @@
+/**
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2026 Igor Zinken - https://www.igorski.nl
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#ifndef __MWENGINE__VOICEPOOL_H_INCLUDED__
+#define __MWENGINE__VOICEPOOL_H_INCLUDED__
+
+#include "../audiobuffer.h"
+#include "../ringbuffer.h"
+#include <definitions/voicestealing.h>
+#include <events/basesynthevent.h>
+#include <vector>
+
+namespace MWEngine {
+
+class SynthInstrument; // forward declaration, see <instruments/synthinstrument.h>
+
+/**
+ * a SynthVoice holds the render state of a live BaseSynthEvent
+ * that would otherwise be allocated during playback
+ */
+struct SynthVoice {
+    BaseSynthEvent* event;                // the event rendering through this voice (nullptr when the voice is free)
+    unsigned int order;                   // the order in which the voice was acquired (lower values are older)
+    int fadeRemaining;                    // the amount of samples remaining in the fade out of a stolen voice (0 when not stolen)
+    std::vector<RingBuffer*> ringBuffers; // Karplus-Strong ring buffer for each oscillator
+};
+
+/**
+ * VoicePool manages the voices for the live events of a SynthInstrument. All voices are
+ * allocated upon construction, acquiring and releasing voices does not allocate memory.
+ *
+ * When acquiring a voice would exceed the maximum polyphony, a playing voice is stolen (as
+ * determined by the stealing policy) and faded out before its event is removed. The pool
+ * reserves FADE_VOICES additional voices for this purpose. Should these be exhausted as well,
+ * the stolen voice closest to completing its fade is cut off immediately.
+ *
+ * The pool is mutated by the thread applying the event mutations of the instrument (see CommandQueue)
+ */
+class VoicePool
+{
+    public:
+        VoicePool( SynthInstrument* instrument, int maxPolyphony, int oscillatorAmount );
+        ~VoicePool();
+
+        static constexpr int FADE_VOICES   = 4;   // amount of voices reserved for fading out stolen voices
+        static constexpr int FADE_DURATION = 5;   // duration (in milliseconds) of the fade out of a stolen voice
+        static constexpr int MIN_FREQUENCY = 20;  // lowest frequency (in Hz) the ring buffers can hold a full cycle of
+
+        int getMaxPolyphony();
+        int getOscillatorAmount();
+
+        VoiceStealing::policies getStealingPolicy();
+        void setStealingPolicy( VoiceStealing::policies policy );
+
+        // acquires a voice for given event, stealing a voice when the maximum polyphony is exceeded
+        SynthVoice* acquire( BaseSynthEvent* event );
+
+        // frees the voice of given event (note the event is not dereferenced, it can be in destruction)
+        void release( BaseAudioEvent* event );
+
+        // the voice given event renders through (nullptr when the event has no voice)
+        SynthVoice* getVoice( BaseAudioEvent* event );
+
+        // the amount of playing voices (omitting voices that are fading out after having been stolen)
+        int getActiveVoiceAmount();
+
+        /**
+         * applies the fade out of a stolen voice onto given buffer, silencing the
+         * buffer beyond the end of the fade. Returns true when the fade has completed
+         */
+        bool applyFade( SynthVoice* voice, AudioBuffer* buffer );
+
+        // acquires voices in given pool for all events playing in this pool (oldest first), after which this pool is empty
+        void transferTo( VoicePool* pool );
+
+    private:
+        SynthInstrument* _instrument;
+        std::vector<SynthVoice*> _voices;
+
+        int _maxPolyphony;
+        int _oscillatorAmount;
+        int _fadeDuration;
+        unsigned int _acquisitions;
+        VoiceStealing::policies _stealingPolicy;
+
+        SynthVoice* getFreeVoice();
+        SynthVoice* getVoiceToSteal();
+        SynthVoice* getVoiceToCutOff();
+        SAMPLE_TYPE getVoiceLevel( SynthVoice* voice );
+};
+} // E.O namespace MWEngine
+
+#endif
@@ -0,0 +1,568 @@
+/**
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2026 Igor Zinken - https://www.igorski.nl
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#include "voicerenderer.h"
+#include <definitions/waveforms.h>
+#include <instruments/synthinstrument.h>
+#include <algorithm>
+
+#if defined(__SSE2__)
+#include <immintrin.h>
+#elif defined(__ARM_NEON)
+#include <arm_neon.h>
+#endif
+
+namespace MWEngine {
+
+namespace {
+
+// the amount of samples rendered for a group of voices in a single pass
+
+const int BLOCK_SIZE = 64;
+
+// a group of voices is rendered using a Lanes vector (holding a value for each voice), which is
+// composed of the native SIMD vectors of the architecture (or a scalar fallback)
+
+#if defined(__SSE2__) && PRECISION == 2
+
+    typedef __m128d Vector;
+    const int VECTOR_SIZE = 2;
+
+    inline Vector vset  ( SAMPLE_TYPE value )        { return _mm_set1_pd( value ); }
+    inline Vector vload ( const SAMPLE_TYPE* values ) { return _mm_loadu_pd( values ); }
+    inline void   vstore( SAMPLE_TYPE* output, Vector v ) { _mm_storeu_pd( output, v ); }
+    inline Vector vadd  ( Vector a, Vector b ) { return _mm_add_pd( a, b ); }
+    inline Vector vsub  ( Vector a, Vector b ) { return _mm_sub_pd( a, b ); }
+    inline Vector vmul  ( Vector a, Vector b ) { return _mm_mul_pd( a, b ); }
+    inline Vector vmax  ( Vector a, Vector b ) { return _mm_max_pd( a, b ); }
+
+    // a < b ? x : y
+    inline Vector vselectLess( Vector a, Vector b, Vector x, Vector y )
+    {
+        Vector mask = _mm_cmplt_pd( a, b );
+        return _mm_or_pd( _mm_and_pd( mask, x ), _mm_andnot_pd( mask, y ));
+    }
+
+#elif defined(__SSE2__)
+
+    typedef __m128 Vector;
+    const int VECTOR_SIZE = 4;
+
+    inline Vector vset  ( SAMPLE_TYPE value )        { return _mm_set1_ps( value ); }
+    inline Vector vload ( const SAMPLE_TYPE* values ) { return _mm_loadu_ps( values ); }
+    inline void   vstore( SAMPLE_TYPE* output, Vector v ) { _mm_storeu_ps( output, v ); }
+    inline Vector vadd  ( Vector a, Vector b ) { return _mm_add_ps( a, b ); }
+    inline Vector vsub  ( Vector a, Vector b ) { return _mm_sub_ps( a, b ); }
+    inline Vector vmul  ( Vector a, Vector b ) { return _mm_mul_ps( a, b ); }
+    inline Vector vmax  ( Vector a, Vector b ) { return _mm_max_ps( a, b ); }
+
+    inline Vector vselectLess( Vector a, Vector b, Vector x, Vector y )
+    {
+        Vector mask = _mm_cmplt_ps( a, b );
+        return _mm_or_ps( _mm_and_ps( mask, x ), _mm_andnot_ps( mask, y ));
+    }
+
+#elif defined(__ARM_NEON) && PRECISION == 1
+
+    typedef float32x4_t Vector;
+    const int VECTOR_SIZE = 4;
+
+    inline Vector vset  ( SAMPLE_TYPE value )        { return vdupq_n_f32( value ); }
+    inline Vector vload ( const SAMPLE_TYPE* values ) { return vld1q_f32( values ); }
+    inline void   vstore( SAMPLE_TYPE* output, Vector v ) { vst1q_f32( output, v ); }
+    inline Vector vadd  ( Vector a, Vector b ) { return vaddq_f32( a, b ); }
+    inline Vector vsub  ( Vector a, Vector b ) { return vsubq_f32( a, b ); }
+    inline Vector vmul  ( Vector a, Vector b ) { return vmulq_f32( a, b ); }
+    inline Vector vmax  ( Vector a, Vector b ) { return vmaxq_f32( a, b ); }
+
+    inline Vector vselectLess( Vector a, Vector b, Vector x, Vector y )
+    {
+        return vbslq_f32( vcltq_f32( a, b ), x, y );
+    }
+
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+
+    typedef float64x2_t Vector;
+    const int VECTOR_SIZE = 2;
+
+    inline Vector vset  ( SAMPLE_TYPE value )        { return vdupq_n_f64( value ); }
+    inline Vector vload ( const SAMPLE_TYPE* values ) { return vld1q_f64( values ); }
+    inline void   vstore( SAMPLE_TYPE* output, Vector v ) { vst1q_f64( output, v ); }
+    inline Vector vadd  ( Vector a, Vector b ) { return vaddq_f64( a, b ); }
+    inline Vector vsub  ( Vector a, Vector b ) { return vsubq_f64( a, b ); }
+    inline Vector vmul  ( Vector a, Vector b ) { return vmulq_f64( a, b ); }
+    inline Vector vmax  ( Vector a, Vector b ) { return vmaxq_f64( a, b ); }
+
+    inline Vector vselectLess( Vector a, Vector b, Vector x, Vector y )
+    {
+        return vbslq_f64( vcltq_f64( a, b ), x, y );
+    }
+
+#else
+
+    typedef SAMPLE_TYPE Vector;
+    const int VECTOR_SIZE = 1;
+
+    inline Vector vset  ( SAMPLE_TYPE value )        { return value; }
+    inline Vector vload ( const SAMPLE_TYPE* values ) { return *values; }
+    inline void   vstore( SAMPLE_TYPE* output, Vector v ) { *output = v; }
+    inline Vector vadd  ( Vector a, Vector b ) { return a + b; }
+    inline Vector vsub  ( Vector a, Vector b ) { return a - b; }
+    inline Vector vmul  ( Vector a, Vector b ) { return a * b; }
+    inline Vector vmax  ( Vector a, Vector b ) { return std::max( a, b ); }
+
+    inline Vector vselectLess( Vector a, Vector b, Vector x, Vector y )
+    {
+        return a < b ? x : y;
+    }
+
+#endif
+
+const int VECTORS = VoiceRenderer::LANES / VECTOR_SIZE;
+
+struct Lanes
+{
+    Vector vectors[ VECTORS ];
+};
+
+inline Lanes set( SAMPLE_TYPE value )
+{
+    Lanes out;
+    for ( int i = 0; i < VECTORS; ++i )
+        out.vectors[ i ] = vset( value );
+    return out;
+}
+
+inline Lanes load( const SAMPLE_TYPE* values )
+{
+    Lanes out;
+    for ( int i = 0; i < VECTORS; ++i )
+        out.vectors[ i ] = vload( values + i * VECTOR_SIZE );
+    return out;
+}
+
+inline void store( SAMPLE_TYPE* output, const Lanes& lanes )
+{
+    for ( int i = 0; i < VECTORS; ++i )
+        vstore( output + i * VECTOR_SIZE, lanes.vectors[ i ]);
+}
+
+inline Lanes add( const Lanes& a, const Lanes& b )
+{
+    Lanes out;
+    for ( int i = 0; i < VECTORS; ++i )
+        out.vectors[ i ] = vadd( a.vectors[ i ], b.vectors[ i ]);
+    return out;
+}
+
+inline Lanes sub( const Lanes& a, const Lanes& b )
+{
+    Lanes out;
+    for ( int i = 0; i < VECTORS; ++i )
+        out.vectors[ i ] = vsub( a.vectors[ i ], b.vectors[ i ]);
+    return out;
+}
+
+inline Lanes mul( const Lanes& a, const Lanes& b )
+{
+    Lanes out;
+    for ( int i = 0; i < VECTORS; ++i )
+        out.vectors[ i ] = vmul( a.vectors[ i ], b.vectors[ i ]);
+    return out;
+}
+
+inline Lanes max( const Lanes& a, const Lanes& b )
+{
+    Lanes out;
+    for ( int i = 0; i < VECTORS; ++i )
+        out.vectors[ i ] = vmax( a.vectors[ i ], b.vectors[ i ]);
+    return out;
+}
+
+// per lane: a < b ? x : y
+
+inline Lanes selectLess( const Lanes& a, const Lanes& b, const Lanes& x, const Lanes& y )
+{
+    Lanes out;
+    for ( int i = 0; i < VECTORS; ++i )
+        out.vectors[ i ] = vselectLess( a.vectors[ i ], b.vectors[ i ], x.vectors[ i ], y.vectors[ i ]);
+    return out;
+}
+
+inline SAMPLE_TYPE sum( const Lanes& lanes )
+{
+    SAMPLE_TYPE values[ VoiceRenderer::LANES ];
+    store( values, lanes );
+
+    SAMPLE_TYPE out = 0.0;
+    for ( int i = 0; i < VoiceRenderer::LANES; ++i )
+        out += values[ i ];
+
+    return out;
+}
+
+/* oscillators, these equal the phase based waveforms of the Synthesizer (see Synthesizer::render()) */
+
+template <int waveform>
+inline Lanes oscillate( const Lanes& phase );
+
+// parabolic approximation of a sine wave
+
+template <>
+inline Lanes oscillate<WaveForms::SINE>( const Lanes& phase )
+{
+    const Lanes half = set( .5 ), one = set( 1.0 );
+
+    Lanes tmp = sub( mul( phase, set( 4.0 )), selectLess( phase, half, one, set( 3.0 )));
+    Lanes sq  = mul( tmp, tmp );
+
+    return selectLess( phase, half, sub( one, sq ), sub( sq, one ));
+}
+
+template <>
+inline Lanes oscillate<WaveForms::TRIANGLE>( const Lanes& phase )
+{
+    Lanes amp = oscillate<WaveForms::SINE>( phase );
+    return max( amp, sub( set( 0.0 ), amp ));
+}
+
+// note the phase of the voices remains within the 0 - 1 range
+
+template <>
+inline Lanes oscillate<WaveForms::SAWTOOTH>( const Lanes& phase )
+{
+    const Lanes one = set( 1.0 );
+    return selectLess( phase, one, phase, sub( phase, one ));
+}
+
+template <>
+inline Lanes oscillate<WaveForms::SQUARE>( const Lanes& phase )
+{
+    const Lanes half = set( .5 ), one = set( 1.0 );
+
+    Lanes tmp = mul( set( TWO_PI ), sub( mul( phase, set( 4.0 )), selectLess( phase, half, one, set( 3.0 ))));
+    Lanes sq  = mul( tmp, tmp );
+
+    return mul( selectLess( phase, half, sub( one, sq ), sub( sq, one )), set( .01 ));
+}
+
+// renders given amount of samples for an oscillator of each voice, summing the gained output into output
+
+template <int waveform>
+void renderOscillator( Lanes& phase, const Lanes& increment, const Lanes& gain, Lanes* output, int amount )
+{
+    const Lanes one = set( 1.0 );
+
+    for ( int i = 0; i < amount; ++i )
+    {
+        output[ i ] = add( output[ i ], mul( oscillate<waveform>( phase ), gain ));
+
+        // keep phase within range
+        phase = add( phase, increment );
+        phase = selectLess( one, phase, sub( phase, one ), phase );
+    }
+}
+
+void renderOscillator( int waveform, Lanes& phase, const Lanes& increment, const Lanes& gain, Lanes* output, int amount )
+{
+    switch ( waveform )
+    {
+        case WaveForms::SINE:
+            renderOscillator<WaveForms::SINE>( phase, increment, gain, output, amount );
+            break;
+        case WaveForms::TRIANGLE:
+            renderOscillator<WaveForms::TRIANGLE>( phase, increment, gain, output, amount );
+            break;
+        case WaveForms::SAWTOOTH:
+            renderOscillator<WaveForms::SAWTOOTH>( phase, increment, gain, output, amount );
+            break;
+        case WaveForms::SQUARE:
+            renderOscillator<WaveForms::SQUARE>( phase, increment, gain, output, amount );
+            break;
+    }
+}
+
+inline bool isBatchable( int waveform )
+{
+    return waveform == WaveForms::SINE     || waveform == WaveForms::TRIANGLE ||
+           waveform == WaveForms::SAWTOOTH || waveform == WaveForms::SQUARE;
+}
+
+}
+
+/* constructor / destructor */
+
+VoiceRenderer::VoiceRenderer( SynthInstrument* instrument )
+{
+    _instrument   = instrument;
+    _outputBuffer = nullptr;
+    _enabled      = true;
+    _voiceAmount  = 0;
+    _mixBuffer    = new ResizableAudioBuffer( 1, AudioEngineProps::BUFFER_SIZE );
+}
+
+VoiceRenderer::~VoiceRenderer()
+{
+    delete _mixBuffer;
+}
+
+/* public methods */
+
+bool VoiceRenderer::isEnabled()
+{
+    return _enabled;
+}
+
+void VoiceRenderer::setEnabled( bool value )
+{
+    _enabled = value;
+}
+
+void VoiceRenderer::begin( AudioBuffer* outputBuffer )
+{
+    _outputBuffer = nullptr;
+    _voiceAmount  = 0;
+
+    // the arpeggiator changes the frequency of the voices during rendering, while
+    // the remaining waveforms hold state outside of the phase (see Synthesizer::render())
+
+    if ( !_enabled || _instrument->arpeggiatorActive )
+        return;
+
+    for ( int i = 0, l = _instrument->getOscillatorAmount(); i < l; ++i )
+    {
+        _waveforms[ i ] = _instrument->getOscillatorProperties( i )->getWaveform();
+
+        if ( !isBatchable( _waveforms[ i ]))
+            return;
+    }
+
+    _mixBuffer->resize( outputBuffer->bufferSize );
+    _mixBuffer->silenceBuffers();
+
+    _outputBuffer = outputBuffer;
+}
+
+bool VoiceRenderer::enqueue( BaseSynthEvent* event, AudioBuffer* outputBuffer )
+{
+    if ( _outputBuffer == nullptr || outputBuffer != _outputBuffer )
+        return false;
+
+    int bufferSize     = outputBuffer->bufferSize;
+    int maxSampleIndex = event->getEventLength() - 1;
+    int writeIndex     = event->lastWriteIndex;
+
+    // events shorter than the buffer render partially
+
+    if ( maxSampleIndex < bufferSize )
+        return false;
+
+    // sequenced sine waves fade in and out at the start and end of the event
+
+    if ( event->isSequenced && _waveforms[ 0 ] == WaveForms::SINE )
+    {
+        Synthesizer* synthesizer = _instrument->synthesizer;
+
+        if ( writeIndex < synthesizer->getFadeInDuration() ||
+             writeIndex + bufferSize > maxSampleIndex - synthesizer->getFadeOutDuration())
+            return false;
+    }
+
+    // batch full ? render the pending voices to make room
+
+    if ( _voiceAmount == MAX_VOICES ) {
+        render();
+        _voiceAmount = 0;
+    }
+
+    int voice = _voiceAmount++;
+    _events[ voice ] = event;
+
+    // cache the oscillator properties for this voice, additional oscillators
+    // are tuned relative to the events base frequency (see Synthesizer::render())
+
+    int oscillatorAmount = _instrument->getOscillatorAmount();
+    SAMPLE_TYPE volume   = event->getVolumeLogarithmic() / ( SAMPLE_TYPE ) oscillatorAmount;
+    float baseFrequency  = event->getBaseFrequency();
+
+    for ( int o = 0; o < oscillatorAmount; ++o )
+    {
+        if ( o == 0 )
+            _phaseIncrements[ o ][ voice ] = event->cachedProps.phaseIncr;
+        else
+            _phaseIncrements[ o ][ voice ] = _instrument->synthesizer->tuneOscillator( o, baseFrequency ) / ( SAMPLE_TYPE ) AudioEngineProps::SAMPLE_RATE;
+
+        // sines of live events are attenuated for multi timbral use
+        _gains[ o ][ voice ] = ( _waveforms[ o ] == WaveForms::SINE && !event->isSequenced ) ? volume * .7 : volume;
+    }
+
+    // describe the ADSR envelope of this cycle, this also updates the envelope state of the event
+
+    _envelopeSegments[ voice ] = _instrument->adsr->getSegments( event, writeIndex, bufferSize, _envelopes[ voice ]);
+
+    // update the event properties for the next render cycle
+
+    event->cachedProps.arpeggioPosition = _instrument->arpeggiator->getBufferPosition();
+    event->cachedProps.arpeggioStep     = _instrument->arpeggiator->getStep();
+    event->lastWriteIndex               = writeIndex + bufferSize;
+
+    return true;
+}
+
+void VoiceRenderer::flush()
+{
+    if ( _outputBuffer == nullptr )
+        return;
+
+    if ( _voiceAmount > 0 )
+    {
+        render();
+
+        // write the mixed voices into the output channels (matching the channels the Synthesizer writes)
+
+        SAMPLE_TYPE* mixBuffer = _mixBuffer->getBufferForChannel( 0 );
+        int channelAmount      = std::min( _outputBuffer->amountOfChannels, _instrument->synthesizer->getTempBuffer()->amountOfChannels );
+
+        for ( int c = 0; c < channelAmount; ++c )
+        {
+            SAMPLE_TYPE* channelBuffer = _outputBuffer->getBufferForChannel( c );
+
+            for ( int i = 0, l = _outputBuffer->bufferSize; i < l; ++i )
+                channelBuffer[ i ] += mixBuffer[ i ];
+        }
+    }
+    _outputBuffer = nullptr;
+    _voiceAmount  = 0;
+}
+
+/* protected methods */
+
+void VoiceRenderer::render()
+{
+    int bufferSize         = _outputBuffer->bufferSize;
+    int oscillatorAmount   = _instrument->getOscillatorAmount();
+    SAMPLE_TYPE* mixBuffer = _mixBuffer->getBufferForChannel( 0 );
+
+    Lanes block[ BLOCK_SIZE ];
+    Lanes phases[ MAX_OSCILLATOR_AMOUNT ], increments[ MAX_OSCILLATOR_AMOUNT ], gains[ MAX_OSCILLATOR_AMOUNT ];
+    SAMPLE_TYPE values[ LANES ];
+
+    // the envelope state of each lane, the amplitude equals max( base + slope * offset, floor ) (see ADSR::Segment)
+
+    Lanes envelopeBase, envelopeSlope, envelopeFloor, envelopeOffset;
+    SAMPLE_TYPE bases[ LANES ], slopes[ LANES ], floors[ LANES ], offsets[ LANES ];
+    int segments[ LANES ], segmentEnds[ LANES ];
+
+    const Lanes one = set( 1.0 );
+
+    for ( int voice = 0; voice < _voiceAmount; voice += LANES )
+    {
+        int lanes = std::min( static_cast<int>( LANES ), _voiceAmount - voice );
+
+        // pack the voice state into lanes (unused lanes are silent)
+
+        for ( int o = 0; o < oscillatorAmount; ++o )
+        {
+            for ( int l = 0; l < LANES; ++l )
+                values[ l ] = l < lanes ? _events[ voice + l ]->getPhaseForOscillator( o ) : 0.0;
+            phases[ o ] = load( values );
+
+            for ( int l = 0; l < LANES; ++l )
+                values[ l ] = l < lanes ? _phaseIncrements[ o ][ voice + l ] : 0.0;
+            increments[ o ] = load( values );
+
+            for ( int l = 0; l < LANES; ++l )
+                values[ l ] = l < lanes ? _gains[ o ][ voice + l ] : 0.0;
+            gains[ o ] = load( values );
+        }
+
+        for ( int l = 0; l < LANES; ++l ) {
+            segments[ l ]    = -1;
+            segmentEnds[ l ] = l < lanes ? 0 : bufferSize;
+            bases[ l ] = slopes[ l ] = floors[ l ] = offsets[ l ] = 0.0;
+        }
+        envelopeBase = envelopeSlope = envelopeFloor = envelopeOffset = set( 0.0 );
+        int nextSegment = 0; // the first index at which the envelope of a lane advances to its next segment
+
+        for ( int offset = 0; offset < bufferSize; offset += BLOCK_SIZE )
+        {
+            int amount = std::min( BLOCK_SIZE, bufferSize - offset );
+
+            for ( int i = 0; i < amount; ++i )
+                block[ i ] = set( 0.0 );
+
+            for ( int o = 0; o < oscillatorAmount; ++o )
+                renderOscillator( _waveforms[ o ], phases[ o ], increments[ o ], gains[ o ], block, amount );
+
+            // apply the envelopes and sum the voices
+
+            for ( int i = 0; i < amount; ++i )
+            {
+                int index = offset + i;
+
+                if ( index == nextSegment )
+                {
+                    // unpack the envelope state and advance the lanes whose segment ends here
+
+                    store( offsets, envelopeOffset );
+                    nextSegment = bufferSize;
+
+                    for ( int l = 0; l < LANES; ++l )
+                    {
+                        if ( segmentEnds[ l ] == index )
+                        {
+                            int s = ++segments[ l ];
+                            const ADSR::Segment& segment = _envelopes[ voice + l ][ s ];
+
+                            bases[ l ]       = segment.base;
+                            slopes[ l ]      = segment.slope;
+                            floors[ l ]      = segment.floor;
+                            offsets[ l ]     = ( SAMPLE_TYPE ) segment.offset;
+                            segmentEnds[ l ] = ( s + 1 < _envelopeSegments[ voice + l ]) ? _envelopes[ voice + l ][ s + 1 ].start : bufferSize;
+                        }
+                        nextSegment = std::min( nextSegment, segmentEnds[ l ]);
+                    }
+                    envelopeBase   = load( bases );
+                    envelopeSlope  = load( slopes );
+                    envelopeFloor  = load( floors );
+                    envelopeOffset = load( offsets );
+                }
+                Lanes envelope = max( add( envelopeBase, mul( envelopeSlope, envelopeOffset )), envelopeFloor );
+                envelopeOffset = add( envelopeOffset, one );
+
+                mixBuffer[ index ] += sum( mul( block[ i ], envelope ));
+            }
+        }
+
+        // commit the updated phases
+
+        for ( int o = 0; o < oscillatorAmount; ++o )
+        {
+            store( values, phases[ o ]);
+
+            for ( int l = 0; l < lanes; ++l )
+                _events[ voice + l ]->setPhaseForOscillator( o, values[ l ]);
+        }
+    }
+}
+
+} // E.O namespace MWEngine
@@ -0,0 +1,97 @@
+/**
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2026 Igor Zinken - https://www.igorski.nl
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#ifndef __MWENGINE__VOICERENDERER_H_INCLUDED__
+#define __MWENGINE__VOICERENDERER_H_INCLUDED__
+
+#include "../global.h"
+#include <audiobuffer.h>
+#include <resizable_audiobuffer.h>
+#include <events/basesynthevent.h>
+#include <modules/adsr.h>
+
+namespace MWEngine {
+class SynthInstrument; // forward declaration, see <instruments/synthinstrument.h>
+
+/**
+ * VoiceRenderer renders the events of a SynthInstrument in batches: rather than each
+ * event rendering into a temporary buffer that is subsequently enveloped and merged into
+ * the output (see BaseSynthEvent::mixBuffer()), the oscillator state, envelope and volume
+ * of the voices are packed into structure of arrays, from which four voices are rendered
+ * at a time (one voice per SIMD vector lane) and summed into the output buffer in one go.
+ * The ADSR envelope of each voice is described as linear segments (see ADSR::getSegments()),
+ * which are evaluated in the vector lanes alongside the oscillators.
+ *
+ * Batching applies to the phase based waveforms (SINE, TRIANGLE, SAWTOOTH and SQUARE)
+ * when the arpeggiator is inactive. Events that cannot be batched in a render cycle (e.g. a
+ * sequenced sine fading in, an event starting within the cycle or a live event fading out)
+ * are rendered by the Synthesizer instead, the output of both is equal (within floating point
+ * rounding) allowing events to switch between both in consecutive render cycles.
+ */
+class VoiceRenderer
+{
+    public:
+        VoiceRenderer( SynthInstrument* instrument );
+        ~VoiceRenderer();
+
+        // the amount of voices rendered at a time and the maximum amount of voices held in a batch
+        // (batches holding more voices are rendered in multiple passes)
+
+        static const int LANES      = 4;
+        static const int MAX_VOICES = LANES * 4;
+
+        bool isEnabled();
+        void setEnabled( bool value );
+
+#ifndef SWIG
+        // internal to the engine
+        // begin() starts a batch for given output buffer (see SynthInstrument::beginEventMix()), when
+        // enqueue() returns true given event has been added to the batch, which is rendered into
+        // the output buffer upon flush(). When false, the event should render itself
+
+        void begin( AudioBuffer* outputBuffer );
+        bool enqueue( BaseSynthEvent* event, AudioBuffer* outputBuffer );
+        void flush();
+#endif
+
+    protected:
+        SynthInstrument* _instrument;
+        AudioBuffer* _outputBuffer; // output buffer of the current batch (nullptr when not batching)
+        bool _enabled;
+        int _waveforms[ MAX_OSCILLATOR_AMOUNT ]; // waveform of each oscillator for the current batch
+
+        // per voice state (structure of arrays)
+
+        int _voiceAmount;
+        BaseSynthEvent* _events[ MAX_VOICES ];
+        SAMPLE_TYPE _phaseIncrements[ MAX_OSCILLATOR_AMOUNT ][ MAX_VOICES ];
+        SAMPLE_TYPE _gains[ MAX_OSCILLATOR_AMOUNT ][ MAX_VOICES ];
+        ADSR::Segment _envelopes[ MAX_VOICES ][ ADSR::MAX_SEGMENTS ]; // the ADSR envelope of each voice for the current render cycle
+        int _envelopeSegments[ MAX_VOICES ];
+
+        ResizableAudioBuffer* _mixBuffer; // voices are mixed in mono (as the Synthesizer renders all channels equally)
+
+        void render();
+};
+} // E.O namespace MWEngine
+
+#endif
@@ -91,6 +91,12 @@ JavaVM* getVM()
     return _vm;
 }
 
+void detachCurrentThread()
+{
+    if ( _vm != nullptr )
+        _vm->DetachCurrentThread();
+}
+
 /**
  * retrieve a Java method ID from the registered Java interface class
  * note: all these methods are expected to be static Java methods
@@ -68,6 +68,7 @@ namespace JavaBridge
     jclass getJavaInterface();                      // the Java class acting as the JNI message mediator
     JNIEnv* getEnvironment();                       // get a pointer to the Java environment (for C to Java communication)
     JavaVM* getVM();                                // the Java VM
+    void detachCurrentThread();                     // detach a native thread that communicated with Java prior to its exit
     jmethodID getJavaMethod( javaAPI aAPImethod );  // retrieve the identifier of a Java method
 
     /* convenience methods to convert Java data types to C types */
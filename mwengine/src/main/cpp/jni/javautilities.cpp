@@ -37,17 +37,9 @@ namespace MWEngine {
 
 bool JavaUtilities::createSampleFromFile( jstring aKey, jstring aWAVFilePath )
 {
-    std::string thePath = JavaBridge::getString( aWAVFilePath );
-    waveFile WAV = WaveReader::fileToBuffer( thePath );
-
-    // error during loading of WAV file ?
+    // file backed samples can be evicted by the SampleManager when exceeding its memory budget
 
-    if ( WAV.buffer == nullptr )
-        return false;
-
-    SampleManager::setSample( JavaBridge::getString( aKey ), WAV.buffer, WAV.sampleRate );
-
-    return true;
+    return SampleManager::loadSample( JavaBridge::getString( aKey ), JavaBridge::getString( aWAVFilePath ));
 }
 
 bool JavaUtilities::createSampleFromAsset( jstring aKey, jobject assetManager, jstring cacheDir, jstring assetName )
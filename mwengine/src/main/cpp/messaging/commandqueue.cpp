@@ -0,0 +1,245 @@
+/**
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2026 Igor Zinken - https://www.igorski.nl
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#include "commandqueue.h"
+#include <global.h>
+#include <processingchain.h>
+#include <sequencer.h>
+#include <instruments/baseinstrument.h>
+#include <events/baseaudioevent.h>
+#include <utilities/debug.h>
+#include <utilities/perfutility.h>
+#include <utilities/spscqueue.h>
+#include <atomic>
+#include <thread>
+
+namespace MWEngine {
+namespace CommandQueue
+{
+    // the amount of commands that can be pending at once (e.g. a full sequence being
+    // replaced by the control thread in between two render cycles)
+
+    const size_t QUEUE_CAPACITY = 4096;
+
+    // the duration after which a control thread waiting for the render thread to apply commands
+    // reports a stalled render thread. The control thread keeps waiting as it can't safely mutate
+    // the lists the render thread is iterating (only once the engine stops rendering does it apply them)
+
+    const int64_t STALL_WARNING_TIME = 2 * NANOS_PER_SECOND;
+
+    SPSCQueue<Command> _queue( QUEUE_CAPACITY );
+
+    std::atomic<std::thread::id> _renderThread;
+    std::atomic<uint64_t> _posted  { 0 };
+    std::atomic<uint64_t> _applied { 0 };
+
+    /* internal methods */
+
+    void apply( const Command& command )
+    {
+        switch ( command.type )
+        {
+            case ADD_EVENT:
+                command.instrument->applyAddEvent( command.audioEvent, command.isLiveEvent );
+                break;
+
+            case REMOVE_EVENT:
+                command.instrument->applyRemoveEvent( command.audioEvent, command.isLiveEvent );
+                break;
+
+            case CLEAR_EVENTS:
+                command.instrument->applyClearEvents();
+                break;
+
+            case REGISTER_INSTRUMENT:
+                Sequencer::applyRegisterInstrument( command.instrument );
+                break;
+
+            case UNREGISTER_INSTRUMENT:
+                Sequencer::applyUnregisterInstrument( command.instrument );
+                break;
+
+            case ADD_PROCESSOR:
+                command.chain->applyAddProcessor( command.processor );
+                break;
+
+            case REMOVE_PROCESSOR:
+                command.chain->applyRemoveProcessor( command.processor );
+                break;
+
+            case CLEAR_PROCESSORS:
+                command.chain->applyReset();
+                break;
+
+            case UPDATE_INSTRUMENT:
+                command.instrument->applyUpdate();
+                break;
+
+            case RESERVE_EVENTS:
+                command.instrument->applyReserveEvents();
+                break;
+
+            case UPDATE_EVENT:
+                command.audioEvent->applyUpdate();
+                break;
+        }
+    }
+
+    // the queue is consumed by the render thread, but when the engine isn't rendering the control
+    // thread applies pending commands itself. This flag ensures only a single thread consumes at a time
+
+    std::atomic_flag _consuming = ATOMIC_FLAG_INIT;
+
+    void applyPending()
+    {
+        Command command;
+        while ( _queue.dequeue( command )) {
+            apply( command );
+            _applied.fetch_add( 1, std::memory_order_release );
+        }
+    }
+
+    void applyPendingAndWait()
+    {
+        while ( _consuming.test_and_set( std::memory_order_acquire )) {
+            std::this_thread::yield();
+        }
+        applyPending();
+        _consuming.clear( std::memory_order_release );
+    }
+
+    // waits until given condition is met (returns true) or the engine has stopped rendering (returns false)
+
+    template <typename Condition>
+    bool waitForRenderThread( Condition condition )
+    {
+        int64_t deadline = PerfUtility::now() + STALL_WARNING_TIME;
+        bool warned      = false;
+
+        while ( !condition() )
+        {
+            if ( !isDeferred() ) {
+                return false;
+            }
+            if ( !warned && PerfUtility::now() > deadline ) {
+                Debug::log( "CommandQueue::render thread did not apply pending commands in time, still waiting" );
+                warned = true;
+            }
+            std::this_thread::sleep_for( std::chrono::microseconds( 250 ));
+        }
+        return true;
+    }
+
+    /* public methods */
+
+    bool isDeferred()
+    {
+        return AudioEngineProps::isRendering.load() && !isRenderThread();
+    }
+
+    bool isRenderThread()
+    {
+        return _renderThread.load( std::memory_order_relaxed ) == std::this_thread::get_id();
+    }
+
+    // the queue has a single producer, though commands can be posted from multiple control
+    // threads (e.g. the UI thread and the garbage collector finalizing objects). This flag
+    // serializes the producers, it is never acquired by the render thread
+
+    std::atomic_flag _producing = ATOMIC_FLAG_INIT;
+
+    void post( const Command& command )
+    {
+        while ( _producing.test_and_set( std::memory_order_acquire )) {
+            std::this_thread::yield();
+        }
+
+        bool enqueued = _queue.enqueue( command ) ||
+                        waitForRenderThread([ &command ]() { return _queue.enqueue( command ); });
+
+        if ( enqueued ) {
+            _posted.fetch_add( 1, std::memory_order_relaxed );
+        }
+        _producing.clear( std::memory_order_release );
+
+        if ( enqueued ) {
+            return;
+        }
+
+        // queue remained full until the engine stopped rendering, apply all pending commands directly
+
+        while ( _consuming.test_and_set( std::memory_order_acquire )) {
+            std::this_thread::yield();
+        }
+        applyPending();
+        apply( command );
+        _consuming.clear( std::memory_order_release );
+    }
+
+    void flush()
+    {
+        // only the thread driven by the audio driver is registered (see OfflineRenderer, which
+        // renders on the calling thread while the engine isn't rendering)
+
+        if ( AudioEngineProps::isRendering.load() ) {
+            _renderThread.store( std::this_thread::get_id(), std::memory_order_relaxed );
+        }
+
+        // the render thread never waits, should the control thread be applying
+        // the commands (when the engine is starting) these are applied next cycle
+
+        if ( _consuming.test_and_set( std::memory_order_acquire )) {
+            return;
+        }
+        applyPending();
+        _consuming.clear( std::memory_order_release );
+    }
+
+    void synchronize()
+    {
+        if ( isDeferred() )
+        {
+            uint64_t posted = _posted.load( std::memory_order_relaxed );
+
+            if ( waitForRenderThread([ posted ]() { return _applied.load( std::memory_order_acquire ) >= posted; })) {
+                return;
+            }
+        }
+        // engine is not rendering (or has stopped while waiting), apply the remaining commands directly
+
+        if ( !AudioEngineProps::isRendering.load() ) {
+            _renderThread.store( std::thread::id(), std::memory_order_relaxed );
+        }
+        applyPendingAndWait();
+    }
+
+    uint64_t getPostedCommands()
+    {
+        return _posted.load();
+    }
+
+    uint64_t getAppliedCommands()
+    {
+        return _applied.load();
+    }
+}
+} // E.O namespace MWEngine
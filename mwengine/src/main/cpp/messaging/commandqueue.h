@@ -0,0 +1,114 @@
+/**
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2026 Igor Zinken - https://www.igorski.nl
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#ifndef __MWENGINE__COMMANDQUEUE_H_INCLUDED__
+#define __MWENGINE__COMMANDQUEUE_H_INCLUDED__
+
+#include <cstdint>
+
+/**
+ * CommandQueue transfers mutations of the engine state (e.g. adding/removing events, instruments
+ * and processors) from a control thread (e.g. the UI/Java thread) to the render thread. Rather than
+ * mutating the lists the render thread iterates while it is rendering, the control thread posts a
+ * command into a bounded wait-free queue, which the render thread applies at the start of its next
+ * render cycle (see AudioEngine::render()).
+ *
+ * When the engine isn't rendering (or when invoked from the render thread itself) mutations are
+ * applied immediately, e.g. the mutating methods don't need to know which thread they are invoked from.
+ *
+ * Commands carry their payload by value, applying them does not allocate any memory.
+ */
+namespace MWEngine {
+
+class BaseAudioEvent;
+class BaseInstrument;
+class BaseProcessor;
+class ProcessingChain;
+
+namespace CommandQueue
+{
+    enum Types {
+        ADD_EVENT,            // add event to instrument (sequenced or live)
+        REMOVE_EVENT,         // remove event from instrument (sequenced or live)
+        CLEAR_EVENTS,         // remove all events from instrument
+        REGISTER_INSTRUMENT,  // add instrument to the Sequencer
+        UNREGISTER_INSTRUMENT,// remove instrument from the Sequencer
+        ADD_PROCESSOR,        // add processor to ProcessingChain
+        REMOVE_PROCESSOR,     // remove processor from ProcessingChain
+        CLEAR_PROCESSORS,     // remove all processors from ProcessingChain
+        UPDATE_INSTRUMENT,    // apply a prepared state change of an instrument (see BaseInstrument::postUpdate())
+        RESERVE_EVENTS,       // move the events of an instrument into prepared lists of a larger capacity
+        UPDATE_EVENT          // apply a prepared state change of an event (e.g. swapping the sample of a SampleEvent)
+    };
+
+    // construct using designated initializers, e.g. { .type = CLEAR_EVENTS, .instrument = instrument }
+
+    struct Command {
+        Types type;
+        BaseInstrument*  instrument  = nullptr;
+        BaseAudioEvent*  audioEvent  = nullptr;
+        ProcessingChain* chain       = nullptr;
+        BaseProcessor*   processor   = nullptr;
+        bool             isLiveEvent = false;
+    };
+
+    /**
+     * Whether mutations requested by the calling thread must be posted into the queue (e.g.
+     * the engine is rendering and the calling thread is not the render thread)
+     */
+    extern bool isDeferred();
+
+    /**
+     * Whether the calling thread is the render thread (e.g. the thread that last invoked flush())
+     */
+    extern bool isRenderThread();
+
+    /**
+     * Posts given command for the render thread to apply. When the queue is full, the
+     * calling (control) thread waits until the render thread has made room (or until the
+     * engine stops rendering, after which the command is applied directly).
+     */
+    extern void post( const Command& command );
+
+    /**
+     * Applies all pending commands. Invoked by the render thread at the start of each render
+     * cycle (marking the calling thread as the render thread while the engine is rendering, an
+     * offline render on the calling thread is thus not registered). Never blocks.
+     */
+    extern void flush();
+
+    /**
+     * Blocks the calling (control) thread until all commands it has posted have been applied.
+     * Invoked prior to destroying objects that pending commands (or the render thread) might
+     * still reference. When the engine isn't rendering, the pending commands are applied by the
+     * calling thread (e.g. by AudioEngine::stop() once the render thread has halted). While the
+     * engine is rendering, commands are never applied by the calling thread (not even when the
+     * render thread stalls), to batch removals: post all of them first and synchronize once.
+     */
+    extern void synchronize();
+
+    extern uint64_t getPostedCommands();
+    extern uint64_t getAppliedCommands();
+}
+} // E.O namespace MWEngine
+
+#endif
@@ -22,7 +22,22 @@
  */
 #include "notifier.h"
 #include "global.h"
+#include <audioengine.h>
+#include <definitions/notifications.h>
+#include <messaging/commandqueue.h>
+#include <utilities/spscqueue.h>
 #include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <climits>
+#include <mutex>
+#include <thread>
+
+#if defined(__linux__)
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
 
 #ifdef USE_JNI
 
@@ -33,106 +48,481 @@
 namespace MWEngine {
 namespace Notifier
 {
-    std::map<int, std::vector<Observer*> > _observerMap;
+    typedef std::map<int, std::vector<Observer*> > ObserverMap;
 
-    void registerObserver( int aNotificationType, Observer* aObserver )
-    {
-        // first check if given type was already registered
-        std::map<int, std::vector<Observer*> >::iterator it = _observerMap.find( aNotificationType );
-        bool typeRegistered = ( it != _observerMap.end());
+    ObserverMap _observerMap;
 
-        if ( !typeRegistered )
-            _observerMap.insert( std::pair<int, std::vector<Observer*> >( aNotificationType,
-                                                                          std::vector<Observer*>() ));
+    // the observers are registered by control threads while the dispatcher thread (and threads broadcasting
+    // directly) iterate them. The registrations are mutated under lock after which a copy is published for
+    // dispatching, which is freed once no thread dispatches. Dispatching threads thus never acquire the lock
 
-        it = _observerMap.find( aNotificationType );
-        it->second.push_back( aObserver );
-    }
+    std::mutex _observerMutex;
+    std::atomic<ObserverMap*> _observers { nullptr };
+    std::vector<ObserverMap*> _retiredObservers;
+    std::atomic<int> _dispatchingThreads { 0 };
+    thread_local int _dispatchDepth = 0;
 
-    void unregisterObserver( int aNotificationType, Observer* aObserver )
-    {
-        std::map<int, std::vector<Observer*> >::iterator it = _observerMap.find( aNotificationType );
+    struct Notification {
+        int type;
+        int value;
+        bool hasValue;
+        int64_t frame;
+    };
 
-        if ( it != _observerMap.end() )
-        {
-            std::vector<Observer*> observers = it->second;
+    // the amount of notifications the render thread (and each render worker) can enqueue before the dispatcher drains them
 
-            if ( std::find( observers.begin(), observers.end(), aObserver ) != observers.end())
-                observers.erase( std::find( observers.begin(), observers.end(), aObserver ));
+    const size_t QUEUE_CAPACITY        = 1024;
+    const size_t WORKER_QUEUE_CAPACITY = 256;
+    const int MAX_RENDER_WORKERS       = 16;
 
-            if ( _observerMap.size() == 0 )
-                _observerMap.erase( _observerMap.find( aNotificationType ));
-        }
-    }
+    SPSCQueue<Notification> _queue( QUEUE_CAPACITY );
+    std::vector<Notification> _pending; // the notifications drained in a single dispatch (only used by the dispatcher)
 
-    void broadcast( int aNotificationType )
+    // the queues of the render workers, allocated upon registration and reused once a worker unregisters
+
+    struct WorkerQueue {
+        std::atomic<SPSCQueue<Notification>*> queue { nullptr };
+        std::atomic<bool> registered { false };
+    };
+    WorkerQueue _workerQueues[ MAX_RENDER_WORKERS ];
+    thread_local SPSCQueue<Notification>* _workerQueue = nullptr;
+    thread_local int _workerIndex = -1;
+
+    // the most recent position update of the render thread, written by the render thread only. The sequence
+    // is odd while the slot is being written, the dispatcher retries reading the slot when the sequence changed
+
+    std::atomic<uint32_t> _positionSequence { 0 };
+    std::atomic<int>      _positionValue    { 0 };
+    std::atomic<bool>     _positionHasValue { false };
+    std::atomic<int64_t>  _positionFrame    { 0 };
+    std::atomic<bool>     _positionPending  { false };
+
+    std::thread* _dispatcher = nullptr;
+    std::atomic<bool> _dispatching { false };
+    std::atomic<uint64_t> _coalesced { 0 };
+    std::atomic<uint64_t> _dropped   { 0 };
+
+    // incremented for each broadcast handed to the dispatcher, the dispatcher awaits its change (futex word)
+
+    std::atomic<uint32_t> _signal { 0 };
+    std::atomic<int> _parkedDispatchers { 0 };
+
+    thread_local int64_t _notificationFrame = 0;
+
+    /* internal methods */
+
+    void dispatch( const Notification& notification )
     {
+        _notificationFrame = notification.frame;
+
 #ifdef USE_JNI
 
         // broadcast over JNI to Java
 
-        jmethodID native_method_id = JavaBridge::getJavaMethod( JavaAPIs::HANDLE_NOTIFICATION );
+        jmethodID native_method_id = JavaBridge::getJavaMethod(
+            notification.hasValue ? JavaAPIs::HANDLE_NOTIFICATION_DATA : JavaAPIs::HANDLE_NOTIFICATION
+        );
 
         if ( native_method_id != nullptr )
         {
             JNIEnv* env = JavaBridge::getEnvironment();
 
             if ( env != nullptr ) {
-                env->CallStaticVoidMethod( JavaBridge::getJavaInterface(), native_method_id, aNotificationType );
+                if ( notification.hasValue ) {
+                    env->CallStaticVoidMethod( JavaBridge::getJavaInterface(), native_method_id,
+                                               notification.type, notification.value );
+                } else {
+                    env->CallStaticVoidMethod( JavaBridge::getJavaInterface(), native_method_id, notification.type );
+                }
             }
         }
 #else
         // strictly native layer code
 
-        std::map<int, std::vector<Observer*> >::iterator it = _observerMap.find( aNotificationType );
+        _dispatchingThreads.fetch_add( 1 );
+        ++_dispatchDepth;
 
-        if ( it != _observerMap.end() )
+        ObserverMap* observerMap = _observers.load();
+
+        if ( observerMap != nullptr )
         {
-            std::vector<Observer*> observers = it->second;
+            ObserverMap::iterator it = observerMap->find( notification.type );
 
-            if ( observers.size() > 0 )
+            if ( it != observerMap->end() )
             {
-                for ( int i = 0, l = observers.size(); i < l; ++i )
-                    observers.at( i )->handleNotification( aNotificationType );
+                for ( auto observer : it->second ) {
+                    if ( notification.hasValue ) {
+                        observer->handleNotification( notification.type, notification.value );
+                    } else {
+                        observer->handleNotification( notification.type );
+                    }
+                }
             }
         }
+        --_dispatchDepth;
+        _dispatchingThreads.fetch_sub( 1 );
 #endif
     }
 
-    void broadcast( int aNotificationType, int aNotificationValue )
+    void wakeDispatcher()
     {
-#ifdef USE_JNI
+        _signal.fetch_add( 1 );
 
-        // broadcast over JNI to Java
+        if ( _parkedDispatchers.load() > 0 ) {
+#if defined(__linux__)
+            syscall( SYS_futex, reinterpret_cast<uint32_t*>( &_signal ), FUTEX_WAKE_PRIVATE, INT_MAX, nullptr, nullptr, 0 );
+#endif
+        }
+    }
 
-        jmethodID native_method_id = JavaBridge::getJavaMethod( JavaAPIs::HANDLE_NOTIFICATION_DATA );
+    void awaitSignal( uint32_t signal )
+    {
+        // note the parked count is incremented prior to checking the signal (while wakeDispatcher() increments
+        // the signal prior to checking the parked count), as such either the dispatcher observes the change or is woken
 
-        if ( native_method_id != nullptr )
+        while ( _signal.load() == signal )
         {
-            JNIEnv* env = JavaBridge::getEnvironment();
+            _parkedDispatchers.fetch_add( 1 );
 
-            if ( env != nullptr ) {
-                env->CallStaticVoidMethod( JavaBridge::getJavaInterface(), native_method_id,
-                                           aNotificationType, aNotificationValue );
+            if ( _signal.load() == signal ) {
+#if defined(__linux__)
+                syscall( SYS_futex, reinterpret_cast<uint32_t*>( &_signal ), FUTEX_WAIT_PRIVATE, signal, nullptr, nullptr, 0 );
+#else
+                std::this_thread::sleep_for( std::chrono::microseconds( 1000 ));
+#endif
             }
+            _parkedDispatchers.fetch_sub( 1 );
         }
-#else
-        // strictly native layer code
+    }
+
+    void storePosition( const Notification& notification )
+    {
+        uint32_t sequence = _positionSequence.load( std::memory_order_relaxed );
+
+        _positionSequence.store( sequence + 1, std::memory_order_relaxed );
+        std::atomic_thread_fence( std::memory_order_release );
+
+        _positionValue.store( notification.value, std::memory_order_relaxed );
+        _positionHasValue.store( notification.hasValue, std::memory_order_relaxed );
+        _positionFrame.store( notification.frame, std::memory_order_relaxed );
+
+        _positionSequence.store( sequence + 2, std::memory_order_release );
+
+        // a position update the dispatcher didn't get to is replaced by this one
+
+        if ( _positionPending.exchange( true, std::memory_order_acq_rel )) {
+            _coalesced.fetch_add( 1, std::memory_order_relaxed );
+        }
+    }
 
-        std::map<int, std::vector<Observer*> >::iterator it = _observerMap.find( aNotificationType );
+    bool takePosition( Notification& notification )
+    {
+        if ( !_positionPending.exchange( false, std::memory_order_acq_rel )) {
+            return false;
+        }
+        uint32_t sequence;
+
+        do {
+            sequence = _positionSequence.load( std::memory_order_acquire );
+
+            notification.value    = _positionValue.load( std::memory_order_relaxed );
+            notification.hasValue = _positionHasValue.load( std::memory_order_relaxed );
+            notification.frame    = _positionFrame.load( std::memory_order_relaxed );
+
+            std::atomic_thread_fence( std::memory_order_acquire );
+        }
+        while (( sequence & 1 ) != 0 || sequence != _positionSequence.load( std::memory_order_relaxed ));
 
-        if ( it != _observerMap.end() )
+        notification.type = Notifications::SEQUENCER_POSITION_UPDATED;
+
+        return true;
+    }
+
+    void post( const Notification& notification )
+    {
+        // broadcasts from the render thread (and render workers) are handed to the dispatcher thread, these threads
+        // merely enqueue the notification (should the queue be full, it is dropped) and wake the dispatcher
+
+        if ( _dispatching.load( std::memory_order_acquire ) && AudioEngineProps::isRendering.load() )
         {
-            std::vector<Observer*> observers = it->second;
+            if ( CommandQueue::isRenderThread() )
+            {
+                if ( notification.type == Notifications::SEQUENCER_POSITION_UPDATED ) {
+                    storePosition( notification );
+                } else if ( !_queue.enqueue( notification )) {
+                    _dropped.fetch_add( 1, std::memory_order_relaxed );
+                }
+                wakeDispatcher();
+                return;
+            }
 
-            if ( observers.size() > 0 )
+            if ( _workerQueue != nullptr )
             {
-                for ( int i = 0, l = observers.size(); i < l; ++i )
-                    observers.at( i )->handleNotification( aNotificationType, aNotificationValue );
+                if ( !_workerQueue->enqueue( notification )) {
+                    _dropped.fetch_add( 1, std::memory_order_relaxed );
+                }
+                wakeDispatcher();
+                return;
             }
         }
+        dispatch( notification );
+    }
+
+    void runDispatcher()
+    {
+        // a broadcast made while dispatching changes the signal, as such the dispatcher doesn't park
+
+        uint32_t signal = _signal.load();
+
+        while ( _dispatching.load( std::memory_order_acquire ))
+        {
+            dispatchPending();
+            awaitSignal( signal );
+            signal = _signal.load();
+        }
+
+#ifdef USE_JNI
+        // the dispatcher thread was attached to the Java VM when broadcasting over JNI
+        JavaBridge::detachCurrentThread();
 #endif
     }
+
+    // publishes a copy of the registrations (invoked under lock after mutating these)
+
+    void publishObservers()
+    {
+        _retiredObservers.push_back( _observers.exchange( new ObserverMap( _observerMap )));
+
+        // threads that start dispatching from now on use the published copy, as such the
+        // previous copies can be freed when no thread is dispatching
+
+        if ( _dispatchingThreads.load() == 0 )
+        {
+            for ( auto observerMap : _retiredObservers ) {
+                delete observerMap;
+            }
+            _retiredObservers.clear();
+        }
+    }
+
+    // awaits the threads dispatching using the previous registrations (invoked without holding the lock, as
+    // an Observer can register itself while being dispatched to). A thread unregistering from within a dispatch
+    // (e.g. an Observer unregistering itself) can't await itself
+
+    void awaitDispatch()
+    {
+        if ( _dispatchDepth > 0 ) {
+            return;
+        }
+        while ( _dispatchingThreads.load() > 0 ) {
+            std::this_thread::yield();
+        }
+    }
+
+    /* public methods */
+
+    void registerObserver( int aNotificationType, Observer* aObserver )
+    {
+        std::lock_guard<std::mutex> guard( _observerMutex );
+
+        _observerMap[ aNotificationType ].push_back( aObserver );
+
+        publishObservers();
+    }
+
+    void unregisterObserver( int aNotificationType, Observer* aObserver )
+    {
+        {
+            std::lock_guard<std::mutex> guard( _observerMutex );
+
+            ObserverMap::iterator it = _observerMap.find( aNotificationType );
+
+            if ( it == _observerMap.end() ) {
+                return;
+            }
+            std::vector<Observer*>& observers = it->second;
+            auto observer = std::find( observers.begin(), observers.end(), aObserver );
+
+            if ( observer == observers.end() ) {
+                return;
+            }
+            observers.erase( observer );
+
+            if ( observers.empty() ) {
+                _observerMap.erase( it );
+            }
+            publishObservers();
+        }
+
+        // once unregistered, the Observer is no longer invoked (e.g. it can safely be deleted)
+
+        awaitDispatch();
+    }
+
+    void broadcast( int aNotificationType )
+    {
+        post({ aNotificationType, 0, false, AudioEngine::bufferFrame });
+    }
+
+    void broadcast( int aNotificationType, int aNotificationValue )
+    {
+        post({ aNotificationType, aNotificationValue, true, AudioEngine::bufferFrame });
+    }
+
+    void broadcastAtFrame( int64_t aFrame, int aNotificationType )
+    {
+        post({ aNotificationType, 0, false, aFrame });
+    }
+
+    void broadcastAtFrame( int64_t aFrame, int aNotificationType, int aNotificationValue )
+    {
+        post({ aNotificationType, aNotificationValue, true, aFrame });
+    }
+
+    int64_t getNotificationFrame()
+    {
+        return _notificationFrame;
+    }
+
+    void startDispatcher()
+    {
+        if ( _dispatcher != nullptr ) {
+            return;
+        }
+        _pending.reserve( QUEUE_CAPACITY + WORKER_QUEUE_CAPACITY * MAX_RENDER_WORKERS );
+        _dispatching.store( true, std::memory_order_release );
+        _dispatcher = new std::thread( runDispatcher );
+    }
+
+    void stopDispatcher()
+    {
+        if ( _dispatcher == nullptr ) {
+            return;
+        }
+        _dispatching.store( false, std::memory_order_release );
+        wakeDispatcher();
+
+        // when stopped by an observer (e.g. from the dispatcher thread itself), the dispatcher
+        // finishes its current dispatch and exits, the remaining notifications are dispatched upon restart
+
+        bool isDispatcherThread = _dispatcher->get_id() == std::this_thread::get_id();
+
+        if ( isDispatcherThread ) {
+            _dispatcher->detach();
+        } else {
+            _dispatcher->join();
+        }
+        delete _dispatcher;
+        _dispatcher = nullptr;
+
+        if ( isDispatcherThread ) {
+            return;
+        }
+
+        // dispatch the notifications the dispatcher thread didn't get to
+
+        dispatchPending();
+    }
+
+    void dispatchPending()
+    {
+        _pending.clear();
+
+        // the position update is taken before draining the queues, as such all notifications
+        // broadcast by the render thread prior to the position update are dispatched alongside it
+
+        Notification position;
+        bool hasPosition = takePosition( position );
+
+        Notification notification;
+        while ( _pending.size() < _pending.capacity() && _queue.dequeue( notification )) {
+            _pending.push_back( notification );
+        }
+
+        bool drainedWorkers = false;
+
+        for ( auto& workerQueue : _workerQueues )
+        {
+            SPSCQueue<Notification>* queue = workerQueue.queue.load( std::memory_order_acquire );
+
+            if ( queue == nullptr ) {
+                continue;
+            }
+            while ( _pending.size() < _pending.capacity() && queue->dequeue( notification )) {
+                _pending.push_back( notification );
+                drainedWorkers = true;
+            }
+        }
+
+        // the notifications of the render workers are interleaved with those of the render thread
+
+        if ( drainedWorkers ) {
+            std::stable_sort( _pending.begin(), _pending.end(), []( const Notification& a, const Notification& b ) {
+                return a.frame < b.frame;
+            });
+        }
+
+        for ( size_t i = 0; i < _pending.size(); ++i )
+        {
+            if ( hasPosition && _pending[ i ].frame > position.frame ) {
+                dispatch( position );
+                hasPosition = false;
+            }
+            dispatch( _pending[ i ] );
+        }
+
+        if ( hasPosition ) {
+            dispatch( position );
+        }
+    }
+
+    void registerRenderWorker()
+    {
+        if ( _workerQueue != nullptr ) {
+            return;
+        }
+
+        for ( int i = 0; i < MAX_RENDER_WORKERS; ++i )
+        {
+            bool registered = false;
+
+            if ( !_workerQueues[ i ].registered.compare_exchange_strong( registered, true, std::memory_order_acq_rel )) {
+                continue;
+            }
+            SPSCQueue<Notification>* queue = _workerQueues[ i ].queue.load( std::memory_order_acquire );
+
+            if ( queue == nullptr ) {
+                queue = new SPSCQueue<Notification>( WORKER_QUEUE_CAPACITY );
+                _workerQueues[ i ].queue.store( queue, std::memory_order_release );
+            }
+            _workerQueue = queue;
+            _workerIndex = i;
+            return;
+        }
+        // all queues are in use, the broadcasts of this thread are dispatched immediately
+    }
+
+    void unregisterRenderWorker()
+    {
+        if ( _workerQueue == nullptr ) {
+            return;
+        }
+        // the queue is kept for reuse, its pending notifications are still dispatched
+
+        _workerQueues[ _workerIndex ].registered.store( false, std::memory_order_release );
+        _workerQueue = nullptr;
+        _workerIndex = -1;
+    }
+
+    uint64_t getCoalescedNotifications()
+    {
+        return _coalesced.load();
+    }
+
+    uint64_t getDroppedNotifications()
+    {
+        return _dropped.load();
+    }
 }
 
 } // E.O namespace MWEngine
@@ -24,9 +24,26 @@
 #define __MWENGINE__NOTIFIER_H_INCLUDED__
 
 #include "observer.h"
+#include <cstdint>
 #include <map>
 #include <vector>
 
+/**
+ * Notifier broadcasts the engine's notifications (see notifications.h) to the registered
+ * Observers (or over JNI to Java when USE_JNI is defined).
+ *
+ * Broadcasts made by the render thread (and the render workers, see registerRenderWorker()) are not
+ * dispatched on these threads (as the observers can block them for an undetermined amount of time)
+ * but are enqueued into preallocated lock-free queues, which are drained by a dedicated dispatcher
+ * thread that is woken up by the broadcast. SEQUENCER_POSITION_UPDATED notifications of the render
+ * thread are not enqueued but held in a single slot, when the dispatcher lags behind, pending position
+ * updates are thus coalesced into the most recent one while the queue remains available to all other
+ * notifications. Broadcasts from any other thread are dispatched immediately.
+ *
+ * Observers can be (un)registered from any thread while notifications are dispatched. Dispatching
+ * uses a copy of the registrations made when the dispatch started, once unregisterObserver() returns
+ * the Observer is no longer invoked (unless unregistered from within its own dispatch).
+ */
 namespace MWEngine {
 namespace Notifier
 {
@@ -36,6 +53,37 @@ namespace Notifier
     extern void unregisterObserver( int aNotificationType, Observer* aObserver );
     extern void broadcast         ( int aNotificationType );
     extern void broadcast         ( int aNotificationType, int aNotificationValue );
+
+    /**
+     * Broadcasts a notification that belongs to given sample frame (counted since the engine
+     * started rendering, see AudioEngine::bufferFrame). The frame of broadcasts made without
+     * providing one is the start of the current render cycle.
+     */
+    extern void broadcastAtFrame( int64_t aFrame, int aNotificationType );
+    extern void broadcastAtFrame( int64_t aFrame, int aNotificationType, int aNotificationValue );
+
+    /**
+     * The sample frame the notification currently being dispatched belongs to,
+     * can be queried by an Observer from within its handleNotification()-method
+     */
+    extern int64_t getNotificationFrame();
+
+#ifndef SWIG
+    // internal to the engine
+
+    extern void startDispatcher();  // invoked before the engine starts rendering
+    extern void stopDispatcher();   // invoked after the engine stopped rendering, dispatches all pending notifications
+    extern void dispatchPending();  // dispatches all notifications enqueued by the render thread
+
+    // invoked by threads rendering alongside the render thread (e.g. the WorkerPool threads) when
+    // they start / before they exit, so their broadcasts are handed to the dispatcher thread as well
+
+    extern void registerRenderWorker();
+    extern void unregisterRenderWorker();
+
+    extern uint64_t getCoalescedNotifications();
+    extern uint64_t getDroppedNotifications(); // notifications that couldn't be enqueued as the queue was full
+#endif
 }
 } // E.O namespace MWEngine
 
@@ -117,16 +117,49 @@ void ADSR::cloneEnvelopes( ADSR* source )
 }
 
 void ADSR::apply( AudioBuffer* inputBuffer, BaseSynthEvent* synthEvent, int writeOffset )
+{
+    int bufferSize = inputBuffer->bufferSize;
+
+    Segment segments[ MAX_SEGMENTS ];
+    int segmentAmount = getSegments( synthEvent, writeOffset, bufferSize, segments );
+
+    // each channel is enveloped from the same starting amplitude
+
+    for ( int cn = 0, ca = inputBuffer->amountOfChannels; cn < ca; ++cn )
+    {
+        SAMPLE_TYPE* targetBuffer = inputBuffer->getBufferForChannel( cn );
+
+        for ( int s = 0; s < segmentAmount; ++s )
+        {
+            const Segment& segment = segments[ s ];
+            int segmentEnd = ( s + 1 < segmentAmount ) ? segments[ s + 1 ].start : bufferSize;
+
+            // segment at full amplitude (e.g. no envelope applies)
+            if ( segment.slope == 0.0 && segment.base == MAX_VOLUME )
+                continue;
+
+            for ( int i = segment.start, offset = segment.offset; i < segmentEnd; ++i, ++offset )
+                targetBuffer[ i ] *= getAmplitude( segment, offset );
+        }
+    }
+}
+
+int ADSR::getSegments( BaseSynthEvent* synthEvent, int writeOffset, int bufferSize, Segment* segments )
 {
     SAMPLE_TYPE lastEnvelope = synthEvent->cachedProps.envelope;
     int eventDuration        = synthEvent->getEventLength();
 
+    // the floor of the segments that cannot drop below silence
+    const SAMPLE_TYPE NO_FLOOR = -MAX_VOLUME;
+
     // the events lifetime is actually extended by the release phase of this ADSR envelope
     int eventDurationWithRelease = eventDuration + _releaseDuration;
 
     // nothing to do
-    if ( writeOffset > eventDurationWithRelease && lastEnvelope == 1.0 )
-        return;
+    if ( writeOffset > eventDurationWithRelease && lastEnvelope == 1.0 ) {
+        segments[ 0 ] = { 0, 0, lastEnvelope, 0.0, NO_FLOOR };
+        return 1;
+    }
 
     // cache envelopes for given event duration
     if ( eventDuration != _bufferLength ) {
@@ -134,10 +167,9 @@ void ADSR::apply( AudioBuffer* inputBuffer, BaseSynthEvent* synthEvent, int writ
         invalidateEnvelopes();
     }
 
-    int bufferSize     = inputBuffer->bufferSize;
     int writeEndOffset = writeOffset + bufferSize; // for the current cycle
     float sustainLevel = _sustainLevel;
-    
+
     bool applyAttack  = _attackDuration  > 0 && writeOffset < _decayStart;
     bool applyDecay   = _decayDuration   > 0 && writeEndOffset >= _decayStart   && writeOffset < _sustainStart;
     bool applySustain = _sustainDuration > 0 && writeEndOffset >= _sustainStart && writeOffset < _releaseStart;
@@ -164,45 +196,55 @@ void ADSR::apply( AudioBuffer* inputBuffer, BaseSynthEvent* synthEvent, int writ
          !applyDecay   &&
          !applyRelease )
     {
-        if ( lastEnvelope < 1.0 )
-            inputBuffer->adjustBufferVolumes( lastEnvelope );
-
-        return;
+        segments[ 0 ] = { 0, 0, lastEnvelope, 0.0, NO_FLOOR };
+        return 1;
     }
 
-    int readOffset;
-    for ( int cn = 0, ca = inputBuffer->amountOfChannels; cn < ca; ++cn )
+    // the offsets at which the applicable envelope stage can change
+
+    const int boundaries[] = { _attackDuration, _decayStart, _sustainStart, _sustainStart + 1, _releaseStart, _releaseStart + 1 };
+
+    int segmentAmount = 0;
+    int readOffset    = writeOffset;
+    int endOffset     = writeOffset + bufferSize;
+
+    while ( readOffset < endOffset )
     {
-        SAMPLE_TYPE* targetBuffer = inputBuffer->getBufferForChannel( cn );
-        readOffset = writeOffset;
+        int segmentEnd = endOffset;
 
-        for ( int i = 0; i < bufferSize; ++i, ++readOffset )
-        {
-            // attack envelope
-            if ( applyAttack && readOffset < _attackDuration )
-                lastEnvelope = ( SAMPLE_TYPE ) readOffset * _attackIncrement;
+        for ( int boundary : boundaries ) {
+            if ( boundary > readOffset && boundary < segmentEnd )
+                segmentEnd = boundary;
+        }
 
-            // decay envelope
-            else if ( applyDecay && readOffset >= _decayStart && readOffset <= _sustainStart )
-                lastEnvelope = 1.0 - ( SAMPLE_TYPE ) ( readOffset - _decayStart ) * _decayDecrement;
+        Segment& segment = segments[ segmentAmount++ ];
+        int start        = readOffset - writeOffset;
 
-            // sustain envelope (keeps at last envelope value which is the last decay phase value)
+        // attack envelope
+        if ( applyAttack && readOffset < _attackDuration )
+            segment = { start, readOffset, 0.0, _attackIncrement, NO_FLOOR };
 
-            else if ( applySustain && readOffset >= _sustainStart && readOffset <= _releaseStart )
-                lastEnvelope = _sustainLevel;
+        // decay envelope
+        else if ( applyDecay && readOffset >= _decayStart && readOffset <= _sustainStart )
+            segment = { start, readOffset - _decayStart, 1.0, -_decayDecrement, NO_FLOOR };
 
-            // release envelope
+        // sustain envelope (keeps at last envelope value which is the last decay phase value)
 
-            else if ( applyRelease && readOffset >= _releaseStart )
-                lastEnvelope = std::max(
-                    sustainLevel - ( SAMPLE_TYPE ) ( readOffset - _releaseStart ) * _releaseDecrement,
-                    SILENCE
-                );
+        else if ( applySustain && readOffset >= _sustainStart && readOffset <= _releaseStart )
+            segment = { start, 0, _sustainLevel, 0.0, NO_FLOOR };
 
-            // apply the calculated amplitude envelope onto the sample
+        // release envelope
 
-            targetBuffer[ i ] *= lastEnvelope;
-        }
+        else if ( applyRelease && readOffset >= _releaseStart )
+            segment = { start, readOffset - _releaseStart, sustainLevel, -_releaseDecrement, SILENCE };
+
+        // no stage applies, keep at the last envelope value
+
+        else
+            segment = { start, 0, lastEnvelope, 0.0, NO_FLOOR };
+
+        lastEnvelope = getAmplitude( segment, segment.offset + ( segmentEnd - readOffset ) - 1 );
+        readOffset   = segmentEnd;
     }
 
     // store the current envelope into the events cached properties
@@ -214,6 +256,7 @@ void ADSR::apply( AudioBuffer* inputBuffer, BaseSynthEvent* synthEvent, int writ
     if ( synthEvent->released ) {
         synthEvent->cachedProps.envelopeOffset = readOffset;
     }
+    return segmentAmount;
 }
 
 void ADSR::setDurations( int attackDuration, int decayDuration, int releaseDuration, int bufferLength )
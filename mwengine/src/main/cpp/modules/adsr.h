@@ -26,6 +26,7 @@
 #include "audiobuffer.h"
 #include "global.h"
 #include <events/basesynthevent.h>
+#include <algorithm>
 
 /**
  * ADSR (Attack, Decay, Sustain and Release) provides amplitude
@@ -78,6 +79,33 @@ class ADSR
          */
         void apply( AudioBuffer* inputBuffer, BaseSynthEvent* synthEvent, int writeOffset );
 
+#ifndef SWIG
+        // the envelope is linear within each stage, as such the envelope of a range can be described as a
+        // series of segments. The amplitude of a segment equals max( base + slope * offset, floor ) where
+        // the offset increments with each sample (starting at the offset of the segment)
+
+        struct Segment {
+            int start;         // the index within the range where the segment starts
+            int offset;
+            SAMPLE_TYPE base;
+            SAMPLE_TYPE slope;
+            SAMPLE_TYPE floor;
+        };
+
+        static const int MAX_SEGMENTS = 8;
+
+        // describes the envelope apply() renders for given range (where the range is bufferSize in length)
+        // as segments, returning the amount of segments. This updates the envelope state of the event
+        // (as apply() does), allowing the envelope to be rendered elsewhere (e.g. see VoiceRenderer)
+
+        int getSegments( BaseSynthEvent* synthEvent, int writeOffset, int bufferSize, Segment* segments );
+
+        static inline SAMPLE_TYPE getAmplitude( const Segment& segment, int offset )
+        {
+            return std::max( segment.base + segment.slope * ( SAMPLE_TYPE ) offset, segment.floor );
+        }
+#endif
+
         // set envelope durations (in buffer samples) directly
         // this is more useful for unit testing rather than direct use
         void setDurations( int attackDuration, int decayDuration, int releaseDuration, int bufferLength );
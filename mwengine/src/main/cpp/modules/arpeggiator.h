@@ -72,6 +72,24 @@ class Arpeggiator
             return stepped;
         }
 
+        // the amount of peek() invocations until the arpeggiator moves to the next step
+        // (allows block based rendering to render up until the next step in one go)
+
+        inline int getSamplesUntilStep()
+        {
+            int samples = _stepSize - _bufferPosition;
+            return samples > 1 ? samples : 1;
+        }
+
+        // increments the buffer position by given amount (which should not exceed getSamplesUntilStep())
+        // will return a boolean indicating whether the arpeggiator has moved to the next step
+
+        inline bool peek( int amount )
+        {
+            _bufferPosition += amount - 1;
+            return peek();
+        }
+
         inline float getPitchForStep( int step, float basePitch )
         {
             float pitch = basePitch;
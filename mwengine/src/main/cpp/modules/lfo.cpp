@@ -122,6 +122,7 @@ void LFO::generate()
     }
     else {
         _table->cloneTable( table );
+        _table->clearMipmaps(); // LFO reads the table directly at sub audio rates (see LFO::peek())
     }
 
     // ensure tables are unipolar for easy lookup
@@ -20,6 +20,7 @@ using namespace MWEngine;
 #include "definitions/notifications.h"
 #include "definitions/pitch.h"
 #include "definitions/waveforms.h"
+#include "definitions/voicestealing.h"
 #include "audiochannel.h"
 #include "channelgroup.h"
 #include "processingchain.h"
@@ -55,6 +56,11 @@ using namespace MWEngine;
 #include "modules/lfo.h"
 #include "modules/routeableoscillator.h"
 #include "utilities/audiorenderer.h"
+#include "utilities/rendersink.h"
+#include "utilities/stemcapture.h"
+#include "utilities/offlinerenderer.h"
+#include "utilities/compactbuffer.h"
+#include "utilities/resampler.h"
 #include "utilities/samplemanager.h"
 #include "utilities/sampleutility.h"
 #include "instruments/baseinstrument.h"
@@ -63,6 +69,7 @@ using namespace MWEngine;
 #include "instruments/synthinstrument.h"
 #include "instruments/oscillatorproperties.h"
 #include "events/sampleevent.h"
+#include "events/streamingsampleevent.h"
 #include "events/drumevent.h"
 #include "events/basecacheableaudioevent.h"
 #include "events/basesynthevent.h"
@@ -100,6 +107,7 @@ typedef double SAMPLE_TYPE;
 %include "definitions/notifications.h"
 %include "definitions/pitch.h"
 %include "definitions/waveforms.h"
+%include "definitions/voicestealing.h"
 %include "audiochannel.h"
 %include "channelgroup.h"
 %include "modules/adsr.h"
@@ -136,6 +144,11 @@ typedef double SAMPLE_TYPE;
 %include "utilities/sampleutility.h"
 %include "drumpattern.h"
 %include "utilities/audiorenderer.h"
+%include "utilities/rendersink.h"
+%include "utilities/stemcapture.h"
+%include "utilities/offlinerenderer.h"
+%include "utilities/compactbuffer.h"
+%include "utilities/resampler.h"
 %include "utilities/samplemanager.h"
 %include "instruments/baseinstrument.h"
 %include "instruments/druminstrument.h"
@@ -146,6 +159,7 @@ typedef double SAMPLE_TYPE;
 %include "events/basecacheableaudioevent.h"
 %include "events/basesynthevent.h"
 %include "events/sampleevent.h"
+%include "events/streamingsampleevent.h"
 %include "events/drumevent.h"
 %include "events/synthevent.h"
 %include "audioengine.h"
@@ -22,6 +22,9 @@
  */
 #include "processingchain.h"
 #include "global.h"
+#include <messaging/commandqueue.h>
+#include <utilities/renderprofiler.h>
+#include <algorithm>
 
 namespace MWEngine {
 
@@ -29,24 +32,52 @@ namespace MWEngine {
 
 ProcessingChain::ProcessingChain()
 {
-
+    _activeProcessors.reserve( PROCESSOR_CAPACITY );
 }
 
 ProcessingChain::~ProcessingChain()
 {
-    while ( _activeProcessors.size() > 0 ) {
-        auto processor = _activeProcessors.at( 0 );
+    // apply pending mutations before the processors are detached from this chain
+
+    CommandQueue::synchronize();
+
+    for ( auto processor : _activeProcessors ) {
         if ( processor != nullptr ) {
-            removeProcessor( processor );
-        } else {
-            _activeProcessors.erase( _activeProcessors.begin() );
+            processor->setChain( nullptr );
         }
     }
+    _activeProcessors.clear();
 }
 
 /* public methods */
 
 void ProcessingChain::addProcessor( BaseProcessor* processor )
+{
+    PROFILE_REGISTER_PROCESSOR( processor );
+
+    // the processors chain reference is only maintained by the control thread
+
+    processor->setChain( this );
+
+    if ( CommandQueue::isDeferred() ) {
+        CommandQueue::post({ .type = CommandQueue::ADD_PROCESSOR, .chain = this, .processor = processor });
+        return;
+    }
+    applyAddProcessor( processor );
+}
+
+bool ProcessingChain::removeProcessor( BaseProcessor* processor )
+{
+    processor->setChain( nullptr );
+
+    if ( CommandQueue::isDeferred() ) {
+        CommandQueue::post({ .type = CommandQueue::REMOVE_PROCESSOR, .chain = this, .processor = processor });
+        return true;
+    }
+    return applyRemoveProcessor( processor );
+}
+
+void ProcessingChain::applyAddProcessor( BaseProcessor* processor )
 {
     auto it = std::find( _activeProcessors.begin(), _activeProcessors.end(), processor );
     bool hasProcessor = it != _activeProcessors.end();
@@ -55,14 +86,12 @@ void ProcessingChain::addProcessor( BaseProcessor* processor )
         return;
     }
     _activeProcessors.push_back( processor );
-    processor->setChain( this );
 }
 
-bool ProcessingChain::removeProcessor( BaseProcessor* processor )
+bool ProcessingChain::applyRemoveProcessor( BaseProcessor* processor )
 {
     auto it = std::find( _activeProcessors.begin(), _activeProcessors.end(), processor );
     if ( it != _activeProcessors.end() ) {
-        processor->setChain( nullptr );
         _activeProcessors.erase( it );
 
         return true;
@@ -78,7 +107,7 @@ BaseProcessor* ProcessingChain::getProcessorAt( int index )
     return _activeProcessors.at( index );
 }
 
-std::vector<BaseProcessor*> ProcessingChain::getActiveProcessors()
+const std::vector<BaseProcessor*>& ProcessingChain::getActiveProcessors()
 {
     return _activeProcessors;
 }
@@ -94,6 +123,25 @@ int ProcessingChain::amountOfProcessors()
 }
 
 void ProcessingChain::reset()
+{
+    // detach the processors from this chain so destroying them afterwards doesn't
+    // post (and await) their individual removal. Pending mutations are applied first
+    // so the list is stable while reading it
+
+    CommandQueue::synchronize();
+
+    for ( auto processor : _activeProcessors ) {
+        processor->setChain( nullptr );
+    }
+
+    if ( CommandQueue::isDeferred() ) {
+        CommandQueue::post({ .type = CommandQueue::CLEAR_PROCESSORS, .chain = this });
+        return;
+    }
+    applyReset();
+}
+
+void ProcessingChain::applyReset()
 {
     _activeProcessors.clear();
 }
@@ -35,17 +35,33 @@ class ProcessingChain
         ProcessingChain();
         ~ProcessingChain();
 
+        // while the engine is rendering, mutations of the chain are
+        // deferred onto the render thread (see CommandQueue)
+
         void addProcessor   ( BaseProcessor* processor );
         bool removeProcessor( BaseProcessor* processor );
 
         BaseProcessor* getProcessorAt( int index );
-        std::vector<BaseProcessor*> getActiveProcessors();
+        // note the returned vector is owned by the chain (iterating it doesn't copy nor allocate)
+        const std::vector<BaseProcessor*>& getActiveProcessors();
 
         bool hasProcessors();
         int amountOfProcessors();
 
         void reset();
 
+#ifndef SWIG
+        // internal to the engine, mutates the chain directly
+
+        void applyAddProcessor   ( BaseProcessor* processor );
+        bool applyRemoveProcessor( BaseProcessor* processor );
+        void applyReset();
+
+        // the amount of processors a chain can hold before its list is reallocated
+
+        static const int PROCESSOR_CAPACITY = 16;
+#endif
+
 private:
 
         /* cached chains */
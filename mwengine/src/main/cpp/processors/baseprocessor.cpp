@@ -22,6 +22,8 @@
  */
 #include "baseprocessor.h"
 #include "../processingchain.h"
+#include <messaging/commandqueue.h>
+#include <utilities/renderprofiler.h>
 
 namespace MWEngine {
 
@@ -36,6 +38,13 @@ BaseProcessor::~BaseProcessor()
 {
     if ( chain != nullptr )
         chain->removeProcessor( this );
+
+    // the removal is deferred while the engine is rendering, await its application
+    // (returns immediately when nothing is pending, e.g. once ProcessingChain::reset() was applied)
+
+    CommandQueue::synchronize();
+
+    PROFILE_UNREGISTER_PROCESSOR( this );
 }
 
 /* public methods */
@@ -23,6 +23,7 @@
  */
 #include "formantfilter.h"
 #include "../utilities/utils.h"
+#include <cfloat>
 #include <cmath>
 
 namespace MWEngine {
@@ -22,6 +22,7 @@
  */
 #include "ringbuffer.h"
 #include <utilities/bufferutility.h>
+#include <algorithm>
 
 namespace MWEngine {
 
@@ -30,6 +31,7 @@ namespace MWEngine {
 RingBuffer::RingBuffer( int capacity )
 {
     _bufferLength = capacity;
+    _capacity     = capacity;
     _buffer       = BufferUtility::generateSilentBuffer( _bufferLength );
     _first        = 0;
     _last         = 0;
@@ -48,6 +50,18 @@ int RingBuffer::getBufferLength()
     return _bufferLength;
 }
 
+int RingBuffer::getCapacity()
+{
+    return _capacity;
+}
+
+void RingBuffer::setBufferLength( int length )
+{
+    flush(); // silences the full length of the current contents
+
+    _bufferLength = std::max( 1, std::min( length, _capacity ));
+}
+
 int RingBuffer::getSize()
 {
     return _last - _first;
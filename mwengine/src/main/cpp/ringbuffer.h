@@ -33,6 +33,11 @@ class RingBuffer
         RingBuffer( int capacity );
         ~RingBuffer();
         int getBufferLength();
+        int getCapacity();
+
+        // updates the length of the buffer (up to its capacity, e.g. without allocating) and flushes its contents
+        void setBufferLength( int length );
+
         int getSize();
         bool isEmpty();
         bool isFull();
@@ -74,6 +79,7 @@ class RingBuffer
     protected:
         SAMPLE_TYPE* _buffer;
         int _bufferLength;
+        int _capacity;
         int _first;
         int _last;
 };
@@ -22,7 +22,9 @@
  */
 #include "sequencer.h"
 #include "audioengine.h"
+#include <messaging/commandqueue.h>
 #include <utilities/utils.h>
+#include <climits>
 #include <vector>
 #include <utilities/eventutility.h>
 
@@ -34,10 +36,31 @@ bool Sequencer::playing           = false;
 BulkCacher* Sequencer::bulkCacher = new BulkCacher( true );
 std::vector<BaseInstrument*> Sequencer::instruments;
 std::vector<BaseAudioEvent*> Sequencer::removes;
+size_t Sequencer::audibleChannels = 0;
 
 /* public methods */
 
 int Sequencer::registerInstrument( BaseInstrument* instrument )
+{
+    // while the engine is rendering, the instruments list is only mutated by the render thread
+
+    if ( CommandQueue::isDeferred() ) {
+        CommandQueue::post({ .type = CommandQueue::REGISTER_INSTRUMENT, .instrument = instrument });
+        return -1;
+    }
+    return applyRegisterInstrument( instrument );
+}
+
+bool Sequencer::unregisterInstrument( BaseInstrument* instrument )
+{
+    if ( CommandQueue::isDeferred() ) {
+        CommandQueue::post({ .type = CommandQueue::UNREGISTER_INSTRUMENT, .instrument = instrument });
+        return true;
+    }
+    return applyUnregisterInstrument( instrument );
+}
+
+int Sequencer::applyRegisterInstrument( BaseInstrument* instrument )
 {
     int index       = -1;
     bool wasPresent = false; // prevent double addition
@@ -51,11 +74,12 @@ int Sequencer::registerInstrument( BaseInstrument* instrument )
     if ( !wasPresent ) {
         instruments.push_back( instrument );
         index = ( int ) instruments.size() - 1;
+        instrument->index = index;
     }
     return index; // the index this instrument is registered at
 }
 
-bool Sequencer::unregisterInstrument( BaseInstrument* instrument )
+bool Sequencer::applyUnregisterInstrument( BaseInstrument* instrument )
 {
     for ( int i = 0; i < instruments.size(); i++ )
     {
@@ -79,6 +103,7 @@ bool Sequencer::getAudioEvents( std::vector<AudioChannel*>* channels, int buffer
     if ( flushChannels ) {
         // clears the audio events gathered in a previous iteration
         channels->clear();
+        audibleChannels = 0;
     }
 
     // note we update the channels mix properties here as they might change during playback
@@ -88,35 +113,67 @@ bool Sequencer::getAudioEvents( std::vector<AudioChannel*>* channels, int buffer
         BaseInstrument* instrument      = instruments[ i ];
         AudioChannel* instrumentChannel = instrument->audioChannel;
 
-        // clear previous channel contents when requested
+        instrumentChannel->instrument = instrument;
+
+        // muted instruments are omitted from rendering altogether
+
+        if ( instrumentChannel->muted ) {
+            continue;
+        }
+
         if ( flushChannels ) {
-            instrumentChannel->reset();
+            ++audibleChannels;
         }
 
-        if ( !instrumentChannel->muted )
-        {
-            if ( playing )
-            {
-                int firstMeasure = ( int ) floor(( float ) bufferPosition / ( float ) AudioEngine::samples_per_bar );
-                int lastMeasure  = ( int ) floor(( float ) bufferEnd / ( float ) AudioEngine::samples_per_bar );
+        // the sequenced events are retained in between render cycles (see collectSequencedEvents())
+        // while the live events are collected anew each cycle (O(amount of live events))
 
-                // note we deduplicate eligible events if flushChannels is false
+        if ( playing && instrument->hasEvents() ) {
+            // note we deduplicate eligible events if flushChannels is false (e.g. when collecting
+            // the events at the loop start, an event could also overlap the range prior to looping)
 
-                collectSequencedEvents( instrument, bufferPosition, bufferEnd, firstMeasure, !flushChannels );
+            collectSequencedEvents( instrument, bufferPosition, bufferEnd, !flushChannels );
+        }
+        else if ( flushChannels && !instrumentChannel->audioEvents.empty() ) {
+            instrumentChannel->audioEvents.clear();
+            instrumentChannel->schedule.valid = false;
+        }
+
+        if ( flushChannels && instrumentChannel->hasLiveEvents ) {
+            instrumentChannel->liveEvents.clear();
+            instrumentChannel->hasLiveEvents = false;
+        }
 
-                // when the current range spans 2 measures, collect for the second measure as well
-                // here we always deduplicate as events can overlap from first to last measure
+        if ( addLiveInstruments && instrument->hasLiveEvents() )
+            collectLiveEvents( instrument );
 
-                if ( lastMeasure != firstMeasure ) {
-                    collectSequencedEvents( instrument, bufferPosition, bufferEnd, lastMeasure, true );
+        // instruments without events in the current range (nor live events) are omitted from rendering as
+        // well, unless their processing chain is active (as processors can output a tail, e.g. a delay)
+
+        bool idle = instrumentChannel->audioEvents.empty() && !instrumentChannel->hasLiveEvents &&
+                    instrumentChannel->processingChain->getActiveProcessors().empty();
+
+        if ( idle ) {
+            // the output of a channel that is no longer rendered is silenced once, as
+            // its output buffer is still read when mixing the channel groups
+
+            if ( flushChannels && instrumentChannel->isGathered ) {
+                instrumentChannel->isGathered = false;
+
+                if ( instrumentChannel->getOutputBuffer() != nullptr ) {
+                    instrumentChannel->getOutputBuffer()->silenceBuffers();
                 }
             }
+            continue;
+        }
 
-            if ( addLiveInstruments && instrument->hasLiveEvents() )
-                collectLiveEvents( instrument );
+        // when collecting without flushing (e.g. at the loop start), the channel might have been gathered already
 
-            channels->push_back( instrumentChannel );
+        if ( !flushChannels && instrumentChannel->isGathered ) {
+            continue;
         }
+        instrumentChannel->isGathered = true;
+        channels->push_back( instrumentChannel );
     }
     return loopStarted;
 }
@@ -128,7 +185,7 @@ void Sequencer::clearEvents()
     }
 }
 
-void Sequencer::collectSequencedEvents( BaseInstrument* instrument, int bufferPosition, int bufferEnd, int measure, bool checkForDuplicates )
+void Sequencer::collectSequencedEvents( BaseInstrument* instrument, int bufferPosition, int bufferEnd, bool checkForDuplicates )
 {
     if ( !instrument->hasEvents() ) {
         return;
@@ -136,12 +193,6 @@ void Sequencer::collectSequencedEvents( BaseInstrument* instrument, int bufferPo
 
     AudioChannel* channel = instrument->audioChannel;
 
-    auto audioEvents = instrument->getEventsForMeasure( measure );
-
-    if ( audioEvents == nullptr ) {
-        return;
-    }
-
     // channel has an internal loop (e.g. drum machine) ? recalculate requested
     // buffer position by subtracting all measures above the first
 
@@ -156,31 +207,66 @@ void Sequencer::collectSequencedEvents( BaseInstrument* instrument, int bufferPo
         }
     }
 
-    for ( auto const audioEvent : *audioEvents )
+    EventIndex* eventIndex                = instrument->getEventIndex();
+    AudioChannel::EventSchedule& schedule = channel->schedule;
+
+    // when the requested range directly follows the previously collected range and no event starts or
+    // ends in between (nor were events added or removed), the previously collected events remain valid
+
+    if ( !checkForDuplicates && schedule.valid &&
+         schedule.revision == eventIndex->getRevision() &&
+         bufferPosition    == schedule.rangeEnd + 1 &&
+         bufferEnd         <  schedule.nextEventStart &&
+         bufferPosition    <= schedule.firstEventEnd )
     {
-        if ( audioEvent->isEnabled() )
-        {
-            int eventStart = audioEvent->getEventStart();
-            int eventEnd   = audioEvent->getEventEnd();
+        bool eventsChanged = false;
 
-            if (( eventStart >= bufferPosition && eventStart <= bufferEnd ) ||
-                ( eventStart <  bufferPosition && eventEnd >= bufferPosition ))
-            {
-                if ( !audioEvent->isEnqueuedForRemoval()) {
-                    if ( checkForDuplicates && EventUtility::vectorContainsEvent( channel->audioEvents, audioEvent )) {
-                        continue;
-                    }
-                    channel->addEvent( audioEvent );
-                }
-                else {
-                    // NOTE: no need to check for duplicates here as previous removes
-                    // will already have been removed from the event vector
-                    removes.push_back( audioEvent );
-                }
+        for ( auto const audioEvent : channel->audioEvents ) {
+            if ( !audioEvent->isEnabled() || audioEvent->isEnqueuedForRemoval() ) {
+                eventsChanged = true;
+                break;
             }
         }
+
+        if ( !eventsChanged ) {
+            schedule.rangeEnd = bufferEnd;
+            return;
+        }
+    }
+
+    // collect the events overlapping the requested range
+
+    if ( !checkForDuplicates ) {
+        channel->audioEvents.clear();
     }
 
+    // the collected events can only be retained when they represent the full set of overlapping
+    // events for a single range (e.g. not when collecting at the loop start or when disabled events
+    // were omitted, as these could be enabled in the meantime)
+
+    bool canRetain    = !checkForDuplicates;
+    int firstEventEnd = INT_MAX;
+
+    eventIndex->query( bufferPosition, bufferEnd, [ channel, checkForDuplicates, &canRetain, &firstEventEnd ]( BaseAudioEvent* audioEvent )
+    {
+        if ( !audioEvent->isEnabled() ) {
+            canRetain = false;
+            return;
+        }
+        if ( !audioEvent->isEnqueuedForRemoval()) {
+            if ( checkForDuplicates && EventUtility::vectorContainsEvent( channel->audioEvents, audioEvent )) {
+                return;
+            }
+            channel->addEvent( audioEvent );
+            firstEventEnd = std::min( firstEventEnd, audioEvent->getEventEnd() );
+        }
+        else {
+            // NOTE: no need to check for duplicates here as previous removes
+            // will already have been removed from the event vector
+            removes.push_back( audioEvent );
+        }
+    });
+
     // removal queue filled ? process it so we can safely
     // remove "deleted" AudioEvents without errors occurring
     if ( !removes.empty() )
@@ -190,6 +276,14 @@ void Sequencer::collectSequencedEvents( BaseInstrument* instrument, int bufferPo
         }
         removes.clear();
     }
+
+    // store the schedule for the collected events (note the revision is read after processing the removals)
+
+    schedule.valid          = canRetain;
+    schedule.rangeEnd       = bufferEnd;
+    schedule.nextEventStart = eventIndex->getNextEventStart( bufferEnd );
+    schedule.firstEventEnd  = firstEventEnd;
+    schedule.revision       = eventIndex->getRevision();
 }
 
 void Sequencer::collectLiveEvents( BaseInstrument* instrument )
@@ -47,10 +47,28 @@ class Sequencer
         static std::vector<BaseAudioEvent*> removes;
         static BulkCacher* bulkCacher;
 
+        // the amount of unmuted instrument channels at the last collection (see getAudioEvents()). The channel
+        // volumes are divided by this amount to provide headroom, regardless of which channels have events
+
+        static size_t audibleChannels;
+
+        /**
+         * (un)registers given instrument for rendering. When the engine is rendering, the
+         * mutation is deferred onto the render thread (see CommandQueue) in which case
+         * registerInstrument() returns -1 and the instruments index is assigned once applied
+         */
         static int registerInstrument   ( BaseInstrument* instrument );
         static bool unregisterInstrument( BaseInstrument* instrument );
 
-        // collect all audio events which should be rendered at the given buffer range
+#ifndef SWIG
+        // internal to the engine, mutates the instruments list directly
+
+        static int applyRegisterInstrument   ( BaseInstrument* instrument );
+        static bool applyUnregisterInstrument( BaseInstrument* instrument );
+#endif
+
+        // collect all audio events which should be rendered at the given buffer range, only
+        // the channels of unmuted instruments with events (or live events) are gathered
 
         static bool getAudioEvents( std::vector<AudioChannel*>* channels, int bufferPosition,
                                     int bufferSize, bool addLiveInstruments, bool flushChannels );
@@ -65,12 +83,11 @@ class Sequencer
          * @param instrument         {BaseInstrument*} instrument to gather events from
          * @param bufferPosition     {int} the current buffers start pointer
          * @param bufferEnd          {int} the current buffers end pointer
-         * @param measure            {int} the current measure to look up events for
          * @param checkForDuplicates {bool} whether to check whether eligible events are already
-         *                           added to the given instruments channel (as this method can be
-         *                           invoked recursively when the current buffer range overlaps 2 measures
+         *                           added to the given instruments channel (as this method is
+         *                           invoked twice when the current buffer range exceeds the loop end)
          */
-        static void collectSequencedEvents( BaseInstrument* aInstrument, int bufferPosition, int bufferEnd, int measure, bool checkForDuplicates );
+        static void collectSequencedEvents( BaseInstrument* aInstrument, int bufferPosition, int bufferEnd, bool checkForDuplicates );
         static void collectLiveEvents     ( BaseInstrument* aInstrument );
 
 
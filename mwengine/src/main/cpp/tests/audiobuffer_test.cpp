@@ -282,3 +282,24 @@ TEST( AudioBuffer, Clone )
     delete audioBuffer;
     delete clone;
 }
+
+TEST( AudioBuffer, WrapExistingMemory )
+{
+    SAMPLE_TYPE left[ 4 ]  = { 0.1, 0.2, 0.3, 0.4 };
+    SAMPLE_TYPE right[ 4 ] = { -0.1, -0.2, -0.3, -0.4 };
+    SAMPLE_TYPE* channels[ 2 ] = { left, right };
+
+    AudioBuffer* audioBuffer = new AudioBuffer( 2, 4, channels );
+
+    EXPECT_EQ( left,  audioBuffer->getBufferForChannel( 0 )) << "expected no copy to have been made";
+    EXPECT_EQ( right, audioBuffer->getBufferForChannel( 1 )) << "expected no copy to have been made";
+
+    audioBuffer->adjustBufferVolumes( 2.0 );
+
+    EXPECT_FLOAT_EQ( 0.8, left[ 3 ] );
+    EXPECT_FLOAT_EQ( -0.8, right[ 3 ] );
+
+    // deleting the AudioBuffer must not release the wrapped memory (which is stack allocated here)
+
+    delete audioBuffer;
+}
@@ -142,6 +142,7 @@ TEST( AudioChannel, OutputBuffer )
     // update output buffer (is invoked by AudioEngine during application lifetime)
 
     audioChannel->createOutputBuffer();
+    outputBuffer = audioChannel->getOutputBuffer();
 
     // ensure created buffer matches new engine properties
 
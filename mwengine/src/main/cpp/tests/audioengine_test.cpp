@@ -7,6 +7,12 @@
 #include <drivers/mock_io.h>
 #include <events/baseaudioevent.h>
 #include <instruments/baseinstrument.h>
+#include <instruments/synthinstrument.h>
+#include <events/synthevent.h>
+#include <processors/delay.h>
+#include <processors/filter.h>
+#include <messaging/notifier.h>
+#include <definitions/notifications.h>
 
 TEST( AudioEngine, Start )
 {
@@ -317,6 +323,247 @@ TEST( AudioEngine, OutputAtLoopStart )
     delete instrument2;
 }
 
+// renders a scene of several channels (sampled and synthesized, with processors and a
+// channel group) through the mocked driver and returns the recorded output
+
+std::vector<float> renderParallelTestScene( int renderWorkers )
+{
+    MockData::test_program          = 4; // help mocked IO identify which test is running
+    MockData::render_iterations     = 0;
+    MockData::max_render_iterations = 16;
+    MockData::recorded_output.clear();
+
+    SequencerController* controller = new SequencerController();
+    controller->prepare( 120, 4, 4 );
+
+    // stereo output with 44.1 kHz sample rate and buffer size of 512 samples
+    AudioEngine::setup( 512, 44100, 2, 0 );
+    AudioEngine::setRenderWorkers( renderWorkers );
+
+    controller->setTempoNow( 120.0f, 4, 4 );
+    controller->rewind();
+
+    AudioEngine::min_buffer_position = 0;
+    AudioEngine::max_buffer_position = AudioEngine::samples_per_bar - 1;
+
+    std::vector<BaseInstrument*> instruments;
+    std::vector<BaseAudioEvent*> events;
+    std::vector<AudioBuffer*> buffers;
+
+    for ( int i = 0; i < 4; ++i )
+    {
+        BaseInstrument* instrument = new BaseInstrument();
+        BaseAudioEvent* audioEvent = enqueuedAudioEvent( instrument, 4096, 0, 16, i );
+        AudioBuffer* buffer        = new AudioBuffer( 1 + ( i % 2 ), audioEvent->getEventLength() );
+
+        for ( int c = 0; c < buffer->amountOfChannels; ++c ) {
+            SAMPLE_TYPE* channelBuffer = buffer->getBufferForChannel( c );
+            for ( int j = 0; j < buffer->bufferSize; ++j ) {
+                channelBuffer[ j ] = ( SAMPLE_TYPE ) sin(( j + c ) * ( i + 1 ) * 0.01 ) * 0.5;
+            }
+        }
+        audioEvent->setBuffer( buffer, false );
+
+        instruments.push_back( instrument );
+        events.push_back( audioEvent );
+        buffers.push_back( buffer );
+    }
+
+    SynthInstrument* synth = new SynthInstrument();
+    SynthEvent* synthEvent = new SynthEvent( 220.F, 2, 2.F, synth );
+    synthEvent->addToSequencer();
+
+    Filter* filter = new Filter( 2000.F, 0.7F, 40.F, 20000.F, 2 );
+    Delay* delay   = new Delay( 10, 50, .5F, .5F, 2 );
+    instruments.at( 0 )->audioChannel->processingChain->addProcessor( filter );
+    instruments.at( 1 )->audioChannel->processingChain->addProcessor( delay );
+
+    ChannelGroup* group = new ChannelGroup( .75F );
+    group->addAudioChannel( instruments.at( 2 )->audioChannel );
+    group->addAudioChannel( synth->audioChannel );
+    AudioEngine::addChannelGroup( group );
+
+    // start the engine (halts when the mocked driver has recorded the requested iterations)
+
+    AudioEngine::bufferPosition = 0;
+    AudioEngine::volume         = 1;
+    controller->setPlaying( true );
+    AudioEngine::start( Drivers::types::MOCKED );
+
+    std::vector<float> output = MockData::recorded_output;
+
+    // clean up
+
+    controller->setPlaying( false );
+    AudioEngine::removeChannelGroup( group );
+    AudioEngine::setRenderWorkers( 0 );
+    MockData::render_iterations = 0;
+    MockData::recorded_output.clear();
+
+    delete group;
+    delete synthEvent;
+    delete synth;
+
+    for ( size_t i = 0; i < instruments.size(); ++i ) {
+        delete events.at( i );
+        delete buffers.at( i );
+        delete instruments.at( i );
+    }
+    delete filter;
+    delete delay;
+    delete controller;
+
+    return output;
+}
+
+TEST( AudioEngine, ParallelChannelRendering )
+{
+    std::vector<float> serialOutput   = renderParallelTestScene( 0 );
+    std::vector<float> parallelOutput = renderParallelTestScene( 3 );
+
+    ASSERT_EQ( 16 * 512 * 2, serialOutput.size() )
+        << "expected all render iterations to have been recorded";
+
+    ASSERT_EQ( serialOutput.size(), parallelOutput.size() )
+        << "expected parallel render to have recorded the same amount of samples as the serial render";
+
+    bool hasSignal = false;
+
+    for ( size_t i = 0; i < serialOutput.size(); ++i )
+    {
+        if ( serialOutput[ i ] != 0.f )
+            hasSignal = true;
+
+        ASSERT_EQ( serialOutput[ i ], parallelOutput[ i ] )
+            << "expected parallel rendered output to be identical to the serial output at sample " << i;
+    }
+    ASSERT_TRUE( hasSignal ) << "expected the rendered scene to be audible";
+}
+
+// records the sequencer notifications (and the sample frame they belong to)
+
+class SequencerNotificationRecorder final : public Observer
+{
+    public:
+        std::vector<int64_t> notifications;
+
+        void handleNotification( int aNotificationType ) {
+            record( aNotificationType, -1 );
+        }
+
+        void handleNotification( int aNotificationType, int aValue ) {
+            record( aNotificationType, aValue );
+        }
+
+        void record( int aNotificationType, int aValue ) {
+            notifications.push_back( aNotificationType );
+            notifications.push_back( aValue );
+            notifications.push_back( Notifier::getNotificationFrame() );
+        }
+};
+
+TEST( AudioEngine, SequencerNotifications )
+{
+    MockData::test_program          = 4; // help mocked IO identify which test is running
+    MockData::render_iterations     = 0;
+    MockData::max_render_iterations = 48;
+    MockData::recorded_output.clear();
+
+    SequencerController* controller = new SequencerController();
+    controller->prepare( 120, 4, 4 );
+
+    // mono output with 44.1 kHz sample rate and a buffer size that isn't a divisor of the step size
+    int bufferSize = 301;
+    AudioEngine::setup( bufferSize, 44100, 1, 0 );
+
+    controller->setTempoNow( 120.0f, 4, 4 );
+    controller->rewind();
+
+    // loop range spanning several steps (not aligned to the step size) with a marker within the range
+
+    int startPosition = 777;
+    AudioEngine::min_buffer_position    = AudioEngine::samples_per_step;
+    AudioEngine::max_buffer_position    = AudioEngine::samples_per_step * 3 + 1234;
+    AudioEngine::marked_buffer_position = AudioEngine::samples_per_step * 2 + 66;
+
+    SequencerNotificationRecorder* recorder = new SequencerNotificationRecorder();
+    Notifier::registerObserver( Notifications::SEQUENCER_POSITION_UPDATED, recorder );
+    Notifier::registerObserver( Notifications::MARKER_POSITION_REACHED,    recorder );
+
+    uint64_t coalesced = Notifier::getCoalescedNotifications();
+
+    AudioEngine::bufferPosition = startPosition;
+    controller->setPlaying( true );
+    AudioEngine::start( Drivers::types::MOCKED );
+
+    // calculate the expected notifications (and their sample frame) by evaluating each sample
+
+    std::vector<int64_t> expected;
+    int bufferPosition = startPosition;
+
+    for ( int iteration = 0; iteration < MockData::max_render_iterations; ++iteration )
+    {
+        for ( int i = 0; i < bufferSize; ++i )
+        {
+            int64_t frame = ( int64_t ) iteration * bufferSize + i;
+
+            if ( bufferPosition % AudioEngine::samples_per_step == 0 ) {
+                expected.insert( expected.end(), { Notifications::SEQUENCER_POSITION_UPDATED, i, frame });
+            }
+            if ( bufferPosition == AudioEngine::marked_buffer_position ) {
+                expected.insert( expected.end(), { Notifications::MARKER_POSITION_REACHED, -1, frame });
+            }
+            if ( ++bufferPosition > AudioEngine::max_buffer_position ) {
+                bufferPosition = AudioEngine::min_buffer_position;
+            }
+        }
+    }
+
+    EXPECT_EQ( bufferPosition, AudioEngine::bufferPosition )
+        << "expected the sequencer position to have advanced by the rendered amount of samples";
+
+    // notifications are dispatched outside of the render thread, where position updates that were
+    // pending simultaneously are coalesced. As such the recorded notifications must equal the
+    // expected notifications, save for the position updates that were superseded by a later one
+
+    uint64_t expectedCoalesced = Notifier::getCoalescedNotifications() - coalesced;
+
+    ASSERT_EQ( expected.size(), recorder->notifications.size() + expectedCoalesced * 3 )
+        << "expected the same amount of notifications as a per-sample evaluation (minus the coalesced position updates)";
+
+    size_t recorded = 0;
+
+    for ( size_t i = 0; i < expected.size(); i += 3 )
+    {
+        bool isDispatched = recorded < recorder->notifications.size() &&
+                            std::equal( expected.begin() + i, expected.begin() + i + 3, recorder->notifications.begin() + recorded );
+
+        if ( isDispatched ) {
+            recorded += 3;
+            continue;
+        }
+        ASSERT_EQ( Notifications::SEQUENCER_POSITION_UPDATED, expected[ i ] )
+            << "expected notification " << ( i / 3 ) << " to have been dispatched, only position updates can be coalesced";
+
+        ASSERT_TRUE( i + 3 < expected.size() )
+            << "expected the final position update to have been dispatched";
+    }
+    EXPECT_EQ( recorder->notifications.size(), recorded )
+        << "expected all notifications to have been dispatched in order of occurrence";
+
+    // clean up
+
+    controller->setPlaying( false );
+    Notifier::unregisterObserver( Notifications::SEQUENCER_POSITION_UPDATED, recorder );
+    Notifier::unregisterObserver( Notifications::MARKER_POSITION_REACHED,    recorder );
+    AudioEngine::marked_buffer_position = -1;
+    MockData::render_iterations = 0;
+    MockData::recorded_output.clear();
+
+    delete recorder;
+    delete controller;
+}
+
 TEST( AudioEngine, AddRemoveChannelGroups )
 {
     ChannelGroup* channelGroup = new ChannelGroup();
@@ -0,0 +1,331 @@
+/**
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2026 Igor Zinken - https://www.igorski.nl
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#include <audioengine.h>
+#include <audiobuffer.h>
+#include <sequencer.h>
+#include <sequencercontroller.h>
+#include <definitions/drivers.h>
+#include <definitions/waveforms.h>
+#include <drivers/mock_io.h>
+#include <events/sampleevent.h>
+#include <events/synthevent.h>
+#include <instruments/sampledinstrument.h>
+#include <instruments/synthinstrument.h>
+#include <processors/compressor.h>
+#include <processors/delay.h>
+#include <processors/filter.h>
+#include <processors/limiter.h>
+#include <processors/reverbsm.h>
+#include <utilities/compactbuffer.h>
+#include <utilities/perfutility.h>
+#include <utilities/resampler.h>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+using namespace MWEngine;
+
+/**
+ * Renders scripted scenarios through the engine using the mocked driver
+ * (i.e. as fast as possible) and reports the average render time per sample
+ * and the real-time factor (the amount of rendered audio relative to the
+ * time it took to render it) for a range of buffer sizes.
+ *
+ * The benchmark is built for both the 64-bit double and 32-bit float engine
+ * (mwengine_benchmark and mwengine_f32_benchmark respectively).
+ *
+ * The sample events can play their sample from compact storage (see CompactBuffer) using
+ * --storage pcm16|half|float, allowing comparison with sample playback at the engine precision.
+ * Using --resampling linear|hermite|sinc the sample events are pitched (played at custom
+ * playback rates) and resampled using given interpolation quality (see Resampler).
+ *
+ * The "voices" scenario sounds all synth events of a single synthesizer simultaneously (e.g. a
+ * 64 voice pad), using --unbatched the voices are rendered individually rather than in batches
+ * (see VoiceRenderer), allowing comparison.
+ *
+ * usage: mwengine_benchmark [--seconds <audio duration per measurement>] [--workers <render workers>]
+ *                           [--storage <sample storage type>] [--resampling <quality>] [--unbatched] [--quick]
+ */
+
+const unsigned int SAMPLE_RATE     = 44100;
+const unsigned int OUTPUT_CHANNELS = 2;
+const int AMOUNT_OF_MEASURES       = 4;
+const int STEPS_PER_BAR            = 16;
+
+struct Scenario {
+    const char* name;
+    int instruments;  // half of these are sampled instruments, the other half synthesizers
+    int sampleEvents; // distributed across the sampled instruments
+    int synthEvents;  // distributed across the synth instruments
+    bool sustained;   // whether all synth events sound for the full duration of the sequence
+};
+
+struct Session {
+    SequencerController* controller;
+    std::vector<BaseInstrument*> instruments;
+    std::vector<BaseAudioEvent*> events;
+    std::vector<BaseProcessor*> processors;
+    AudioBuffer* sample;
+    CompactBuffer* compactSample;
+};
+
+Session* createSession( const Scenario& scenario, int storageType, int resamplingQuality, bool batched )
+{
+    Session* session = new Session();
+
+    AudioEngine::setup( 512, SAMPLE_RATE, OUTPUT_CHANNELS, 0 );
+
+    session->controller = new SequencerController( AMOUNT_OF_MEASURES, STEPS_PER_BAR );
+    session->controller->prepare( 120.F, 4, 4 );
+    session->controller->setTempoNow( 120.F, 4, 4 );
+    session->controller->rewind();
+
+    // a quarter second sample with a decaying harmonic tone
+
+    int sampleLength = SAMPLE_RATE / 4;
+    session->sample  = new AudioBuffer( OUTPUT_CHANNELS, sampleLength );
+
+    for ( int c = 0; c < OUTPUT_CHANNELS; ++c ) {
+        SAMPLE_TYPE* buffer = session->sample->getBufferForChannel( c );
+        for ( int i = 0; i < sampleLength; ++i ) {
+            SAMPLE_TYPE envelope = 1.0 - ( SAMPLE_TYPE ) i / sampleLength;
+            buffer[ i ] = envelope * ( sin( i * 0.05 ) + 0.5 * sin( i * 0.1 + c )) * 0.5;
+        }
+    }
+    session->compactSample = ( storageType >= 0 ) ? new CompactBuffer( session->sample, storageType ) : nullptr;
+
+    int sampledInstruments = std::max( 1, scenario.instruments / 2 );
+    int synthInstruments   = std::max( 1, scenario.instruments - sampledInstruments );
+    int totalSteps         = AMOUNT_OF_MEASURES * STEPS_PER_BAR;
+
+    // sampled instruments (e.g. drums) process their output through a filter and compressor
+
+    std::vector<SampledInstrument*> samplers;
+    for ( int i = 0; i < sampledInstruments; ++i ) {
+        SampledInstrument* instrument = new SampledInstrument();
+
+        Filter* filter         = new Filter( 2000.F + i * 500.F, 0.5F, 40.F, 20000.F, OUTPUT_CHANNELS );
+        Compressor* compressor = new Compressor();
+
+        instrument->audioChannel->processingChain->addProcessor( filter );
+        instrument->audioChannel->processingChain->addProcessor( compressor );
+
+        session->processors.push_back( filter );
+        session->processors.push_back( compressor );
+        session->instruments.push_back( instrument );
+        samplers.push_back( instrument );
+    }
+
+    for ( int i = 0; i < scenario.sampleEvents; ++i ) {
+        SampleEvent* event = new SampleEvent( samplers.at( i % sampledInstruments ));
+        if ( session->compactSample != nullptr )
+            event->setCompactSample( session->compactSample, SAMPLE_RATE );
+        else
+            event->setSample( session->sample );
+        if ( resamplingQuality >= 0 ) {
+            const float playbackRates[ 4 ] = { 0.75F, 0.9F, 1.2F, 1.5F };
+            event->setPlaybackRate( playbackRates[ i % 4 ] );
+            event->setResamplingQuality( resamplingQuality );
+        }
+        event->positionEvent( 0, STEPS_PER_BAR, ( i * 3 ) % totalSteps );
+        event->addToSequencer();
+
+        session->events.push_back( event );
+    }
+
+    // synth instruments (e.g. pads and leads) process their output through a filter, delay and reverb
+
+    std::vector<SynthInstrument*> synths;
+    for ( int i = 0; i < synthInstruments; ++i ) {
+        SynthInstrument* instrument = new SynthInstrument();
+
+        instrument->setBatchedRendering( batched );
+        instrument->setOscillatorAmount( 2 );
+        instrument->getOscillatorProperties( 0 )->setWaveform( WaveForms::SAWTOOTH );
+        instrument->getOscillatorProperties( 1 )->setWaveform( WaveForms::SQUARE );
+
+        Filter* filter   = new Filter( 1500.F + i * 250.F, 0.7F, 40.F, 20000.F, OUTPUT_CHANNELS );
+        Delay* delay     = new Delay( 250, 500, 0.35F, 0.5F, OUTPUT_CHANNELS );
+        ReverbSM* reverb = new ReverbSM();
+
+        instrument->audioChannel->processingChain->addProcessor( filter );
+        instrument->audioChannel->processingChain->addProcessor( delay );
+        instrument->audioChannel->processingChain->addProcessor( reverb );
+
+        session->processors.push_back( filter );
+        session->processors.push_back( delay );
+        session->processors.push_back( reverb );
+        session->instruments.push_back( instrument );
+        synths.push_back( instrument );
+    }
+
+    for ( int i = 0; i < scenario.synthEvents; ++i ) {
+        float frequency = 110.F * ( 1 + ( i % 12 ) / 4.F );
+        SynthEvent* event = scenario.sustained ?
+            new SynthEvent( frequency, 0, ( float ) totalSteps, synths.at( i % synthInstruments )) :
+            new SynthEvent( frequency, ( i * 5 ) % totalSteps, 1.F + ( i % 4 ), synths.at( i % synthInstruments ));
+
+        session->events.push_back( event );
+    }
+
+    // master bus
+
+    Limiter* limiter = new Limiter( 10.F, 500.F, 0.6F, true );
+    AudioEngine::masterBus->addProcessor( limiter );
+    session->processors.push_back( limiter );
+
+    return session;
+}
+
+void destroySession( Session* session )
+{
+    AudioEngine::masterBus->reset();
+
+    for ( auto event : session->events ) {
+        delete event;
+    }
+    for ( auto instrument : session->instruments ) {
+        delete instrument;
+    }
+    for ( auto processor : session->processors ) {
+        delete processor;
+    }
+    delete session->sample;
+    delete session->compactSample;
+    delete session->controller;
+    delete session;
+}
+
+/**
+ * Renders given duration of audio at given buffer size, returns the elapsed time in nanoseconds
+ */
+int64_t render( int bufferSize, float seconds )
+{
+    int iterations = std::max( 1, ( int )(( seconds * SAMPLE_RATE ) / bufferSize ));
+
+    AudioEngine::setup( bufferSize, SAMPLE_RATE, OUTPUT_CHANNELS, 0 );
+    AudioEngine::bufferPosition = 0;
+
+    MockData::test_program          = 5; // benchmark program of the mocked driver
+    MockData::render_iterations     = 0;
+    MockData::max_render_iterations = iterations;
+
+    Sequencer::playing = true;
+
+    // note the mocked driver renders synchronously and returns once all iterations have rendered
+
+    int64_t start = PerfUtility::now();
+    AudioEngine::start( Drivers::types::MOCKED );
+    int64_t end = PerfUtility::now();
+
+    Sequencer::playing = false;
+
+    return end - start;
+}
+
+int main( int argc, char* argv[] )
+{
+    float seconds = 10.F;
+    int workers   = 0;
+    bool quick    = false;
+    int storage   = -1;
+    int quality   = -1;
+    bool batched  = true;
+
+    for ( int i = 1; i < argc; ++i ) {
+        if ( strcmp( argv[ i ], "--seconds" ) == 0 && i + 1 < argc ) {
+            seconds = ( float ) atof( argv[ ++i ] );
+        } else if ( strcmp( argv[ i ], "--workers" ) == 0 && i + 1 < argc ) {
+            workers = atoi( argv[ ++i ] );
+        } else if ( strcmp( argv[ i ], "--storage" ) == 0 && i + 1 < argc ) {
+            ++i;
+            if ( strcmp( argv[ i ], "pcm16" ) == 0 )      storage = CompactBuffer::PCM16;
+            else if ( strcmp( argv[ i ], "half" ) == 0 )  storage = CompactBuffer::HALF_FLOAT;
+            else if ( strcmp( argv[ i ], "float" ) == 0 ) storage = CompactBuffer::SINGLE_FLOAT;
+        } else if ( strcmp( argv[ i ], "--resampling" ) == 0 && i + 1 < argc ) {
+            ++i;
+            if ( strcmp( argv[ i ], "linear" ) == 0 )       quality = Resampler::LINEAR;
+            else if ( strcmp( argv[ i ], "hermite" ) == 0 ) quality = Resampler::HERMITE;
+            else if ( strcmp( argv[ i ], "sinc" ) == 0 )    quality = Resampler::SINC;
+        } else if ( strcmp( argv[ i ], "--unbatched" ) == 0 ) {
+            batched = false;
+        } else if ( strcmp( argv[ i ], "--quick" ) == 0 ) {
+            quick = true;
+        } else {
+            fprintf( stderr, "usage: %s [--seconds <audio duration per measurement>] [--workers <render workers>] [--storage pcm16|half|float] [--resampling linear|hermite|sinc] [--unbatched] [--quick]\n", argv[ 0 ]);
+            return 1;
+        }
+    }
+
+    std::vector<Scenario> scenarios = {
+        { "small",  4,  16,  16,  false },
+        { "medium", 8,  64,  64,  false },
+        { "large",  16, 256, 128, false },
+        { "voices", 2,  0,   64,  true }
+    };
+    std::vector<int> bufferSizes = { 64, 128, 256, 512, 1024 };
+
+    // a quick run (e.g. as a smoke test) only verifies whether all scenarios render
+
+    if ( quick ) {
+        seconds     = 0.1F;
+        bufferSizes = { 256 };
+    }
+    AudioEngine::setRenderWorkers( workers );
+
+    // the engine is built for both sample precisions (see PRECISION in global.h), allowing comparison
+
+    size_t sampleSize = ( storage < 0 ) ? sizeof( SAMPLE_TYPE ) : ( storage == CompactBuffer::SINGLE_FLOAT ) ? sizeof( float ) : sizeof( int16_t );
+
+    printf( "engine precision: %d-bit %s (%.1f KB per second of %d channel sample memory)\n",
+            ( int ) sizeof( SAMPLE_TYPE ) * 8, PRECISION == 1 ? "float" : "double",
+            ( sampleSize * SAMPLE_RATE * OUTPUT_CHANNELS ) / 1024.0, OUTPUT_CHANNELS );
+
+    printf( "%-8s %-12s %-8s %12s %12s\n", "scenario", "instr/events", "buffer", "ns/sample", "RT factor" );
+
+    for ( auto const& scenario : scenarios )
+    {
+        Session* session = createSession( scenario, storage, quality, batched );
+
+        char description[ 32 ];
+        snprintf( description, sizeof( description ), "%d/%d+%d", scenario.instruments, scenario.sampleEvents, scenario.synthEvents );
+
+        for ( int bufferSize : bufferSizes )
+        {
+            render( bufferSize, std::min( seconds, 1.F )); // warm up (caches, lazily allocated buffers)
+
+            int64_t elapsed = render( bufferSize, seconds );
+            int64_t samples = ( int64_t ) MockData::render_iterations * bufferSize;
+
+            double nsPerSample = ( double ) elapsed / samples;
+            double rtFactor    = (( double ) samples / SAMPLE_RATE ) / (( double ) elapsed / NANOS_PER_SECOND );
+
+            printf( "%-8s %-12s %-8d %12.2f %11.1fx\n", scenario.name, description, bufferSize, nsPerSample, rtFactor );
+        }
+        destroySession( session );
+    }
+    AudioEngine::setRenderWorkers( 0 );
+
+    return 0;
+}
@@ -0,0 +1,173 @@
+/**
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2026 Igor Zinken - https://www.igorski.nl
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#include <audiobuffer.h>
+#include <global.h>
+#include <utilities/perfutility.h>
+#include <utilities/wavereader.h>
+#include <utilities/wavewriter.h>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+using namespace MWEngine;
+
+/**
+ * Measures the time it takes to read a 16-bit stereo WAV file into an AudioBuffer using the
+ * WaveReader and compares it to the previous implementation (which read and converted the
+ * file sample by sample), verifying both produce the same output.
+ *
+ * usage: mwengine_wavereader_benchmark [--seconds <duration of the WAV file>] [--iterations <amount>] [--quick]
+ */
+
+const int SAMPLE_RATE = 44100;
+const int CHANNELS    = 2;
+
+/**
+ * the previous WaveReader implementation (for 16-bit PCM), reads each sample individually from the
+ * file, assumes the data chunk follows the format chunk
+ */
+AudioBuffer* legacyFileToBuffer( const char* inputFile )
+{
+    FILE* fp = fopen( inputFile, "rb" );
+
+    if ( !fp ) {
+        return nullptr;
+    }
+    char id[ 4 ];
+    UINT32 size;
+
+    fseek( fp, 12, SEEK_SET );
+
+    while ( fread( id, 1, 4, fp ) == 4 && fread( &size, 4, 1, fp ) == 1 ) {
+        if ( memcmp( id, "data", 4 ) == 0 ) {
+            break;
+        }
+        fseek( fp, size, SEEK_CUR );
+    }
+    int bufferSize = size / ( 2 * CHANNELS );
+    AudioBuffer* buffer = new AudioBuffer( CHANNELS, bufferSize );
+
+    short input;
+    for ( int i = 0; i < bufferSize; ++i ) {
+        for ( int c = 0; c < CHANNELS; ++c ) {
+            fread( &input, 2, 1, fp );
+            buffer->getBufferForChannel( c )[ i ] = (( SAMPLE_TYPE ) input ) / ( SAMPLE_TYPE ) 32767;
+        }
+    }
+    fclose( fp );
+
+    return buffer;
+}
+
+AudioBuffer* readerFileToBuffer( const char* inputFile )
+{
+    return WaveReader::fileToBuffer( inputFile ).buffer;
+}
+
+// reads the file given amount of times, returns the average read time in milliseconds
+
+double measure( AudioBuffer* ( *read )( const char* ), const char* file, int iterations, AudioBuffer** output )
+{
+    int64_t total = 0;
+
+    for ( int i = 0; i < iterations; ++i ) {
+        int64_t start = PerfUtility::now();
+        AudioBuffer* buffer = read( file );
+        total += PerfUtility::now() - start;
+
+        if ( i == iterations - 1 ) {
+            *output = buffer;
+        } else {
+            delete buffer;
+        }
+    }
+    return ( double ) total / iterations / NANOS_PER_MILLISECOND;
+}
+
+int main( int argc, char* argv[] )
+{
+    float seconds  = 30.f;
+    int iterations = 10;
+
+    for ( int i = 1; i < argc; ++i ) {
+        if ( strcmp( argv[ i ], "--seconds" ) == 0 && i + 1 < argc ) {
+            seconds = ( float ) atof( argv[ ++i ]);
+        } else if ( strcmp( argv[ i ], "--iterations" ) == 0 && i + 1 < argc ) {
+            iterations = atoi( argv[ ++i ]);
+        } else if ( strcmp( argv[ i ], "--quick" ) == 0 ) {
+            seconds    = 1.f;
+            iterations = 1;
+        }
+    }
+    iterations = iterations < 1 ? 1 : iterations;
+
+    // create the WAV file to read
+
+    const char* file   = "wavereader_benchmark.wav";
+    int amountOfFrames = ( int ) ( seconds * SAMPLE_RATE );
+    AudioBuffer* source = new AudioBuffer( CHANNELS, amountOfFrames );
+
+    for ( int i = 0; i < amountOfFrames; ++i ) {
+        source->getBufferForChannel( 0 )[ i ] = ( SAMPLE_TYPE ) sin( i * 0.01 ) * 0.9;
+        source->getBufferForChannel( 1 )[ i ] = ( SAMPLE_TYPE ) cos( i * 0.013 ) * 0.7;
+    }
+    WaveWriter::bufferToWAV( file, source, SAMPLE_RATE );
+    delete source;
+
+    AudioBuffer* legacyOutput = nullptr;
+    AudioBuffer* readerOutput = nullptr;
+
+    double legacyTime = measure( legacyFileToBuffer, file, iterations, &legacyOutput );
+    double readerTime = measure( readerFileToBuffer, file, iterations, &readerOutput );
+
+    remove( file );
+
+    // verify both readers produce the same output
+
+    bool isEqual = legacyOutput != nullptr && readerOutput != nullptr &&
+                   legacyOutput->bufferSize == readerOutput->bufferSize;
+
+    for ( int c = 0; isEqual && c < CHANNELS; ++c ) {
+        for ( int i = 0; i < amountOfFrames; ++i ) {
+            if ( fabs( legacyOutput->getBufferForChannel( c )[ i ] - readerOutput->getBufferForChannel( c )[ i ] ) > 1e-6 ) {
+                isEqual = false;
+                break;
+            }
+        }
+    }
+    delete legacyOutput;
+    delete readerOutput;
+
+    printf( "MWEngine WAV reader benchmark (%s precision, 16-bit stereo, %.1f seconds of audio, %d iterations)\n",
+            PRECISION == 2 ? "double" : "float", seconds, iterations );
+    printf( "%-12s %12s %12s\n", "reader", "ms per file", "speedup" );
+    printf( "%-12s %12.3f %12s\n", "legacy", legacyTime, "1.00x" );
+    printf( "%-12s %12.3f %11.2fx\n", "WaveReader", readerTime, legacyTime / readerTime );
+
+    if ( !isEqual ) {
+        printf( "ERROR: output of WaveReader does not match the legacy implementation\n" );
+        return 1;
+    }
+    return 0;
+}
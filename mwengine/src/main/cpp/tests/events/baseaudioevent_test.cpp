@@ -566,9 +566,8 @@ TEST( BaseAudioEvent, MixBuffer )
         ASSERT_FALSE( bufferHasContent( targetBuffer ))
             << "expected output buffer to contain no content after mixing for an out-of-range buffer position";
     }
-    delete audioEvent;
+    delete audioEvent; // note: also deletes the destroyable buffer
     delete targetBuffer;
-    delete buffer;
 }
 
 TEST( BaseAudioEvent, Instrument )
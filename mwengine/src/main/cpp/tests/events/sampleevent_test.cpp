@@ -358,6 +358,26 @@ TEST( SampleEvent, PlaybackRateLimit )
     delete sampleEvent;
 }
 
+TEST( SampleEvent, ResamplingQuality )
+{
+    SampleEvent* sampleEvent = new SampleEvent();
+
+    EXPECT_EQ( Resampler::LINEAR, sampleEvent->getResamplingQuality() )
+        << "expected linear interpolation by default";
+
+    sampleEvent->setResamplingQuality( Resampler::SINC );
+    EXPECT_EQ( Resampler::SINC, sampleEvent->getResamplingQuality() );
+
+    sampleEvent->setResamplingQuality( 100 );
+    EXPECT_EQ( Resampler::SINC, sampleEvent->getResamplingQuality() )
+        << "expected quality to be clamped to the available qualities";
+
+    sampleEvent->setResamplingQuality( -1 );
+    EXPECT_EQ( Resampler::LINEAR, sampleEvent->getResamplingQuality() );
+
+    delete sampleEvent;
+}
+
 TEST( SampleEvent, PlaybackRate )
 {
     SampleEvent* sampleEvent = new SampleEvent();
@@ -891,6 +911,125 @@ TEST( SampleEvent, MixBufferCustomPlaybackRateHalfSpeed )
     delete targetBuffer;
 }
 
+TEST( SampleEvent, MixBufferCustomPlaybackRateLargeOffset )
+{
+    // at sequencer positions beyond the range where single precision floating point
+    // numbers can represent fractional positions, read positions should not drift
+
+    SampleEvent* sampleEvent = new SampleEvent();
+
+    int sourceSize            = 64;
+    AudioBuffer* sourceBuffer = new AudioBuffer( 1, sourceSize );
+    SAMPLE_TYPE* rawBuffer    = sourceBuffer->getBufferForChannel( 0 );
+
+    for ( int i = 0; i < sourceSize; ++i )
+        rawBuffer[ i ] = ( SAMPLE_TYPE ) i / sourceSize;
+
+    int eventStart = 20000000;
+
+    sampleEvent->setSample( sourceBuffer );
+    sampleEvent->setPlaybackRate( 0.5f );
+    sampleEvent->setEventStart( eventStart );
+
+    AudioBuffer* targetBuffer = new AudioBuffer( 1, 32 );
+    sampleEvent->mixBuffer( targetBuffer, eventStart + 15, 0, eventStart + 1000, false, 0, false );
+
+    SAMPLE_TYPE* mixedBuffer = targetBuffer->getBufferForChannel( 0 );
+
+    for ( int i = 0; i < targetBuffer->bufferSize; ++i ) {
+        SAMPLE_TYPE expected = (( SAMPLE_TYPE ) ( 15 + i ) * 0.5 ) / sourceSize;
+        EXPECT_NEAR( expected, mixedBuffer[ i ], 1e-6 )
+            << "expected interpolated ramp at mixed offset " << i;
+    }
+
+    delete sampleEvent;
+    delete sourceBuffer;
+    delete targetBuffer;
+}
+
+TEST( SampleEvent, MixBufferLoopeableCustomPlaybackRateLargeOffset )
+{
+    SampleEvent* sampleEvent = new SampleEvent();
+
+    int sourceSize            = 16;
+    AudioBuffer* sourceBuffer = new AudioBuffer( 1, sourceSize );
+    SAMPLE_TYPE* rawBuffer    = sourceBuffer->getBufferForChannel( 0 );
+
+    for ( int i = 0; i < sourceSize; ++i )
+        rawBuffer[ i ] = ( SAMPLE_TYPE ) i / sourceSize;
+
+    sampleEvent->setSample( sourceBuffer );
+    sampleEvent->setLoopeable( true, 0 );
+    sampleEvent->setEventLength( 40000000 );
+    sampleEvent->setPlaybackRate( 0.5f );
+
+    int bufferPosition = 30000001;
+    int maxReadPos     = sampleEvent->getLoopEndOffset();
+
+    AudioBuffer* targetBuffer = new AudioBuffer( 1, 64 );
+    sampleEvent->mixBuffer( targetBuffer, bufferPosition, 0, sampleEvent->getEventEnd(), false, 0, false );
+
+    SAMPLE_TYPE* mixedBuffer = targetBuffer->getBufferForChannel( 0 );
+
+    for ( int i = 0; i < targetBuffer->bufferSize; ++i ) {
+
+        // read position relative to the start of the event, wrapped at the loop end
+
+        double readPos = ( double ) ( bufferPosition + i ) * 0.5;
+        if ( readPos > maxReadPos )
+            readPos = fmod( readPos, ( double ) maxReadPos );
+
+        int t = ( int ) readPos;
+        SAMPLE_TYPE expected = ( t < maxReadPos ) ? rawBuffer[ t ] + ( rawBuffer[ t + 1 ] - rawBuffer[ t ] ) * ( readPos - t ) : 0.0;
+
+        EXPECT_NEAR( expected, mixedBuffer[ i ], 1e-6 )
+            << "expected looped ramp at mixed offset " << i;
+    }
+
+    delete sampleEvent;
+    delete sourceBuffer;
+    delete targetBuffer;
+}
+
+TEST( SampleEvent, MixBufferCustomPlaybackRateResamplingQualities )
+{
+    int qualities[ 3 ] = { Resampler::LINEAR, Resampler::HERMITE, Resampler::SINC };
+
+    for ( int q = 0; q < 3; ++q )
+    {
+        SampleEvent* sampleEvent = new SampleEvent();
+
+        int sourceSize            = 64;
+        AudioBuffer* sourceBuffer = new AudioBuffer( 2, sourceSize );
+
+        // constant signal (interpolation should not alter its level)
+
+        for ( int c = 0; c < 2; ++c ) {
+            for ( int i = 0; i < sourceSize; ++i )
+                sourceBuffer->getBufferForChannel( c )[ i ] = ( SAMPLE_TYPE ) ( c == 0 ? .5 : -.25 );
+        }
+
+        sampleEvent->setSample( sourceBuffer );
+        sampleEvent->setPlaybackRate( 0.75f );
+        sampleEvent->setResamplingQuality( qualities[ q ] );
+
+        AudioBuffer* targetBuffer = new AudioBuffer( 2, 64 );
+        sampleEvent->mixBuffer( targetBuffer, 0, 0, sampleEvent->getEventEnd(), false, 0, false );
+
+        for ( int c = 0; c < 2; ++c ) {
+            SAMPLE_TYPE* mixedBuffer = targetBuffer->getBufferForChannel( c );
+            for ( int i = 0; i < targetBuffer->bufferSize; ++i ) {
+                EXPECT_NEAR( c == 0 ? .5 : -.25, mixedBuffer[ i ], 1e-5 )
+                    << "for quality " << qualities[ q ] << " at channel " << c << " and offset " << i;
+            }
+        }
+
+        delete sampleEvent;
+        delete sourceBuffer;
+        delete targetBuffer;
+    }
+}
+
 TEST( SampleEvent, MixBufferLoopeableEvent )
 {
     SampleEvent* sampleEvent = new SampleEvent();
@@ -1517,3 +1656,139 @@ TEST( SampleEvent, MixBufferCustomLoopStartAndEndOffsetWithCrossfade )
     delete sourceBuffer;
     delete sampleEvent;
 }
+
+// mixes the output of an event playing a sample from an AudioBuffer and an event playing the same
+// sample from a CompactBuffer over several consecutive buffers, returns the largest difference
+
+SAMPLE_TYPE compareCompactSampleOutput( int storageType, bool loopeable, float playbackRate, bool useRange, bool livePlayback )
+{
+    int sampleLength = 53;
+    AudioBuffer* source = new AudioBuffer( 2, sampleLength );
+
+    // values that are exactly representable at half precision
+
+    for ( int c = 0; c < 2; ++c ) {
+        for ( int i = 0; i < sampleLength; ++i ) {
+            source->getBufferForChannel( c )[ i ] = ( SAMPLE_TYPE ) ((( i * 5 + c * 11 ) % 33 ) - 16 ) / 16.0;
+        }
+    }
+    CompactBuffer* compact = new CompactBuffer( source, storageType );
+
+    SampleEvent* events[ 2 ] = { new SampleEvent(), new SampleEvent() };
+    AudioBuffer* outputs[ 2 ];
+
+    events[ 0 ]->setSample( source );
+    events[ 1 ]->setCompactSample( compact, AudioEngineProps::SAMPLE_RATE );
+
+    for ( int e = 0; e < 2; ++e )
+    {
+        SampleEvent* event = events[ e ];
+
+        event->setEventStart( 7 );
+        event->setVolume( 0.8f );
+        event->setPlaybackRate( playbackRate );
+
+        if ( loopeable ) {
+            event->setLoopeable( true, 0 );
+            event->setEventLength( sampleLength * 3 );
+            event->setLoopStartOffset( 10 );
+        }
+        if ( useRange ) {
+            event->setBufferRangeStart( 5 );
+            event->setBufferRangeEnd( 40 );
+        }
+        if ( livePlayback )
+            event->play();
+
+        outputs[ e ] = new AudioBuffer( 2, 16 );
+    }
+
+    SAMPLE_TYPE maxDifference = 0.0;
+    int maxBufferPosition     = 150;
+
+    for ( int bufferPosition = 0; bufferPosition < maxBufferPosition; bufferPosition += 16 )
+    {
+        for ( int e = 0; e < 2; ++e )
+        {
+            outputs[ e ]->silenceBuffers();
+
+            if ( livePlayback ) {
+                events[ e ]->mixBuffer( outputs[ e ] );
+            }
+            else {
+                // the last buffer crosses the end of the sequencer loop
+                bool loopStarted = bufferPosition + 16 > maxBufferPosition;
+                events[ e ]->mixBuffer( outputs[ e ], bufferPosition, 0, maxBufferPosition, loopStarted,
+                                        maxBufferPosition - bufferPosition, false );
+            }
+        }
+
+        for ( int c = 0; c < 2; ++c ) {
+            for ( int i = 0; i < 16; ++i ) {
+                maxDifference = std::max( maxDifference, ( SAMPLE_TYPE ) std::abs(
+                    outputs[ 0 ]->getBufferForChannel( c )[ i ] - outputs[ 1 ]->getBufferForChannel( c )[ i ]
+                ));
+            }
+        }
+    }
+
+    for ( int e = 0; e < 2; ++e ) {
+        delete events[ e ];
+        delete outputs[ e ];
+    }
+    delete compact;
+    delete source;
+
+    return maxDifference;
+}
+
+TEST( SampleEvent, SetCompactSample )
+{
+    AudioBuffer* source    = fillAudioBuffer( new AudioBuffer( 2, 24 ));
+    CompactBuffer* compact = new CompactBuffer( source, CompactBuffer::PCM16 );
+
+    SampleEvent* sampleEvent = new SampleEvent();
+
+    ASSERT_FALSE( sampleEvent->setCompactSample( nullptr, AudioEngineProps::SAMPLE_RATE ));
+    ASSERT_FALSE( sampleEvent->hasBuffer() );
+
+    ASSERT_TRUE( sampleEvent->setCompactSample( compact, AudioEngineProps::SAMPLE_RATE ));
+    ASSERT_TRUE( sampleEvent->hasBuffer() );
+
+    EXPECT_EQ( compact, sampleEvent->getCompactBuffer() );
+    EXPECT_EQ( nullptr, sampleEvent->getBuffer() );
+    EXPECT_EQ( 24, sampleEvent->getEventLength() );
+    EXPECT_EQ( 23, sampleEvent->getBufferRangeEnd() );
+    EXPECT_EQ( 23, sampleEvent->getLoopEndOffset() );
+
+    // setting an AudioBuffer replaces the compact sample
+
+    sampleEvent->setSample( source );
+
+    EXPECT_EQ( nullptr, sampleEvent->getCompactBuffer() );
+    EXPECT_EQ( source, sampleEvent->getBuffer() );
+
+    delete sampleEvent;
+    delete compact;
+    delete source;
+}
+
+TEST( SampleEvent, MixBufferCompactSample )
+{
+    // floating point storage of the test values is lossless (and thus should equal the output of
+    // the AudioBuffer), 16-bit integer storage is within half a quantization step (scaled by the volume)
+
+    int types[ 3 ] = { CompactBuffer::PCM16, CompactBuffer::HALF_FLOAT, CompactBuffer::SINGLE_FLOAT };
+    SAMPLE_TYPE tolerance[ 3 ] = { 0.5 / 32767.0, 0.0, 0.0 };
+
+    for ( int t = 0; t < 3; ++t )
+    {
+        EXPECT_LE( compareCompactSampleOutput( types[ t ], false, 1.f,  false, false ), tolerance[ t ] ) << "sequenced";
+        EXPECT_LE( compareCompactSampleOutput( types[ t ], false, 1.f,  false, true ),  tolerance[ t ] ) << "live";
+        EXPECT_LE( compareCompactSampleOutput( types[ t ], true,  1.f,  false, false ), tolerance[ t ] ) << "loopeable";
+        EXPECT_LE( compareCompactSampleOutput( types[ t ], false, 1.5f, false, false ), tolerance[ t ] ) << "custom playback rate";
+        EXPECT_LE( compareCompactSampleOutput( types[ t ], true,  0.7f, false, true ),  tolerance[ t ] ) << "loopeable at custom playback rate";
+        EXPECT_LE( compareCompactSampleOutput( types[ t ], false, 1.f,  true,  false ), tolerance[ t ] ) << "buffer range";
+        EXPECT_LE( compareCompactSampleOutput( types[ t ], true,  1.3f, true,  false ), tolerance[ t ] ) << "buffer range at custom playback rate";
+    }
+}
@@ -0,0 +1,262 @@
+#include "../../events/streamingsampleevent.h"
+#include "../../instruments/sampledinstrument.h"
+#include "../../utilities/wavereader.h"
+#include "../../utilities/wavewriter.h"
+#include <chrono>
+#include <cstdio>
+#include <thread>
+
+// writes a WAV file of given length for streaming, returns its contents as read by the WaveReader
+
+AudioBuffer* createStreamTestFile( std::string file, int amountOfFrames, int amountOfChannels )
+{
+    AudioBuffer* source = new AudioBuffer( amountOfChannels, amountOfFrames );
+
+    for ( int c = 0; c < amountOfChannels; ++c ) {
+        for ( int i = 0; i < amountOfFrames; ++i ) {
+            source->getBufferForChannel( c )[ i ] = ( SAMPLE_TYPE ) ((( i * ( c + 1 )) % 1000 ) / 1000.0 - 0.5 );
+        }
+    }
+    WaveWriter::bufferToWAV( file, source, AudioEngineProps::SAMPLE_RATE );
+    delete source;
+
+    return WaveReader::fileToBuffer( file ).buffer;
+}
+
+// allow the prefetch thread to read the blocks following the current playback offset
+
+void awaitPrefetch()
+{
+    std::this_thread::sleep_for( std::chrono::milliseconds( 100 ));
+}
+
+TEST( StreamingSampleEvent, SetFile )
+{
+    SampledInstrument* instrument = new SampledInstrument();
+    StreamingSampleEvent* event   = new StreamingSampleEvent( instrument );
+
+    ASSERT_FALSE( event->hasBuffer() ) << "expected no buffer prior to setting a file";
+    ASSERT_FALSE( event->setFile( "streamingsampleevent_test_nonexistent.wav" ))
+        << "expected non-existing file to not have been opened";
+
+    std::string file = "streamingsampleevent_test.wav";
+    AudioBuffer* contents = createStreamTestFile( file, 20000, 2 );
+
+    ASSERT_TRUE( event->setFile( file )) << "expected file to have been opened";
+    ASSERT_TRUE( event->hasBuffer() );
+
+    EXPECT_EQ( 20000, event->getSampleLength() );
+    EXPECT_EQ( 20000, event->getEventLength() );
+    EXPECT_EQ( AudioEngineProps::SAMPLE_RATE, event->getSampleRate() );
+    EXPECT_EQ( 0,     event->getBufferRangeStart() );
+    EXPECT_EQ( 19999, event->getBufferRangeEnd() );
+
+    // setting a buffer range updates the event length
+
+    event->setBufferRangeStart( 1000 );
+    event->setBufferRangeEnd( 4999 );
+
+    EXPECT_EQ( 4000, event->getBufferRangeLength() );
+    EXPECT_EQ( 4000, event->getEventLength() );
+
+    delete event;
+    delete instrument;
+    delete contents;
+
+    remove( file.c_str() );
+}
+
+TEST( StreamingSampleEvent, MixBuffer )
+{
+    SampledInstrument* instrument = new SampledInstrument();
+    StreamingSampleEvent* event   = new StreamingSampleEvent( instrument );
+
+    // file exceeds the preloaded head, requiring blocks to be read by the prefetch thread
+
+    std::string file   = "streamingsampleevent_test_mix.wav";
+    int amountOfFrames = 60000;
+    int eventStart     = 1000;
+    AudioBuffer* contents = createStreamTestFile( file, amountOfFrames, 2 );
+
+    event->setFile( file );
+    event->setEventStart( eventStart );
+
+    SAMPLE_TYPE volume  = event->getVolumeLogarithmic();
+    int bufferSize      = 512;
+    AudioBuffer* output = new AudioBuffer( 2, bufferSize );
+
+    for ( int position = 0; position < eventStart + amountOfFrames + bufferSize; position += bufferSize )
+    {
+        output->silenceBuffers();
+        event->mixBuffer( output, position, 0, 100000, false, 0, false );
+
+        if ( position == 0 ) {
+            awaitPrefetch();
+        }
+
+        for ( int c = 0; c < 2; ++c ) {
+            for ( int i = 0; i < bufferSize; ++i ) {
+                int frame = position + i - eventStart;
+                SAMPLE_TYPE expected = ( frame >= 0 && frame < amountOfFrames ) ? contents->getBufferForChannel( c )[ frame ] * volume : 0.0;
+                ASSERT_FLOAT_EQ( expected, output->getBufferForChannel( c )[ i ] )
+                    << "expected sample at position " << ( position + i ) << " for channel " << c;
+            }
+        }
+    }
+    EXPECT_EQ( 0, event->getUnderruns() ) << "expected no underruns during sequential playback";
+
+    delete output;
+    delete event;
+    delete instrument;
+    delete contents;
+
+    remove( file.c_str() );
+}
+
+TEST( StreamingSampleEvent, MixBufferLoop )
+{
+    SampledInstrument* instrument = new SampledInstrument();
+    StreamingSampleEvent* event   = new StreamingSampleEvent( instrument );
+
+    std::string file = "streamingsampleevent_test_loop.wav";
+    AudioBuffer* contents = createStreamTestFile( file, 40000, 1 );
+
+    // play a range of the file, repeating a region of the range
+
+    int rangeStart  = 1000;
+    int loopStart   = 20000;
+    int loopEnd     = 29999;
+    int eventLength = 60000;
+
+    event->setFile( file );
+    event->setBufferRangeStart( rangeStart );
+    event->setBufferRangeEnd( 30000 );
+    event->setLoopeable( true );
+    event->setLoopStartOffset( loopStart );
+    event->setLoopEndOffset( loopEnd );
+    event->setEventLength( eventLength );
+
+    SAMPLE_TYPE volume  = event->getVolumeLogarithmic();
+    int bufferSize      = 256;
+    AudioBuffer* output = new AudioBuffer( 2, bufferSize );
+
+    for ( int position = 0; position < eventLength; position += bufferSize )
+    {
+        output->silenceBuffers();
+        event->mixBuffer( output, position, 0, 100000, false, 0, false );
+
+        if ( position == 0 ) {
+            awaitPrefetch();
+        }
+
+        for ( int i = 0; i < bufferSize && position + i < eventLength; ++i ) {
+            int offset = position + i;
+            int frame  = rangeStart + offset;
+
+            if ( frame > loopEnd ) {
+                frame = loopStart + ( frame - loopEnd - 1 ) % ( loopEnd - loopStart + 1 );
+            }
+            SAMPLE_TYPE expected = contents->getBufferForChannel( 0 )[ frame ] * volume;
+
+            // mono source is mixed into both output channels
+            ASSERT_FLOAT_EQ( expected, output->getBufferForChannel( 0 )[ i ] ) << "expected sample at offset " << offset;
+            ASSERT_FLOAT_EQ( expected, output->getBufferForChannel( 1 )[ i ] ) << "expected sample at offset " << offset;
+        }
+    }
+    EXPECT_EQ( 0, event->getUnderruns() ) << "expected no underruns during looped playback";
+
+    delete output;
+    delete event;
+    delete instrument;
+    delete contents;
+
+    remove( file.c_str() );
+}
+
+TEST( StreamingSampleEvent, Seek )
+{
+    SampledInstrument* instrument = new SampledInstrument();
+    StreamingSampleEvent* event   = new StreamingSampleEvent( instrument );
+
+    std::string file = "streamingsampleevent_test_seek.wav";
+    AudioBuffer* contents = createStreamTestFile( file, 300000, 1 );
+
+    event->setFile( file );
+
+    SAMPLE_TYPE volume  = event->getVolumeLogarithmic();
+    int bufferSize      = 512;
+    int position        = 250000; // far beyond the head and read ahead blocks
+    AudioBuffer* output = new AudioBuffer( 1, bufferSize );
+
+    // moving the sequencer to a position that hasn't been read leads to an underrun (and silence)
+
+    event->mixBuffer( output, position, 0, 400000, false, 0, false );
+
+    EXPECT_EQ( 1, event->getUnderruns() ) << "expected an underrun as the data has not been read";
+    EXPECT_EQ( bufferSize, event->getUnderrunFrames() ) << "expected all frames to have been missing";
+    EXPECT_FALSE( bufferHasContent( output )) << "expected silence for the missing frames";
+
+    // once the prefetch thread has read the data at the new position, playback continues
+
+    awaitPrefetch();
+
+    event->resetUnderruns();
+    output->silenceBuffers();
+    event->mixBuffer( output, position + bufferSize, 0, 400000, false, 0, false );
+
+    EXPECT_EQ( 0, event->getUnderruns() ) << "expected no underruns once the data was read";
+
+    for ( int i = 0; i < bufferSize; ++i ) {
+        ASSERT_FLOAT_EQ( contents->getBufferForChannel( 0 )[ position + bufferSize + i ] * volume, output->getBufferForChannel( 0 )[ i ] );
+    }
+
+    // moving back to the start of the event is covered by the preloaded head
+
+    output->silenceBuffers();
+    event->mixBuffer( output, 0, 0, 400000, false, 0, false );
+
+    EXPECT_EQ( 0, event->getUnderruns() ) << "expected no underruns when playing from the event start";
+    EXPECT_FLOAT_EQ( contents->getBufferForChannel( 0 )[ 100 ] * volume, output->getBufferForChannel( 0 )[ 100 ] );
+
+    delete output;
+    delete event;
+    delete instrument;
+    delete contents;
+
+    remove( file.c_str() );
+}
+
+TEST( StreamingSampleEvent, LivePlayback )
+{
+    SampledInstrument* instrument = new SampledInstrument();
+    StreamingSampleEvent* event   = new StreamingSampleEvent( instrument );
+
+    std::string file = "streamingsampleevent_test_live.wav";
+    AudioBuffer* contents = createStreamTestFile( file, 1000, 1 );
+
+    event->setFile( file );
+    event->play();
+
+    SAMPLE_TYPE volume  = event->getVolumeLogarithmic();
+    AudioBuffer* output = new AudioBuffer( 1, 768 );
+
+    event->mixBuffer( output );
+    EXPECT_EQ( 768, event->getPlaybackPosition() );
+    EXPECT_FLOAT_EQ( contents->getBufferForChannel( 0 )[ 500 ] * volume, output->getBufferForChannel( 0 )[ 500 ] );
+
+    // mixing beyond the sample end stops the one-shot event
+
+    output->silenceBuffers();
+    event->mixBuffer( output );
+
+    EXPECT_EQ( 1000, event->getPlaybackPosition() ) << "expected playback to have stopped at the sample end";
+    EXPECT_FLOAT_EQ( contents->getBufferForChannel( 0 )[ 999 ] * volume, output->getBufferForChannel( 0 )[ 231 ] );
+    EXPECT_FLOAT_EQ( 0.0, output->getBufferForChannel( 0 )[ 232 ] );
+
+    delete output;
+    delete event;
+    delete instrument;
+    delete contents;
+
+    remove( file.c_str() );
+}
@@ -0,0 +1,72 @@
+#include <generators/synthesizer.h>
+#include <instruments/synthinstrument.h>
+#include <definitions/waveforms.h>
+
+TEST( Synthesizer, RenderInSegments )
+{
+    int waveforms[] = { WaveForms::SINE, WaveForms::TRIANGLE, WaveForms::SAWTOOTH, WaveForms::SQUARE };
+    int bufferSize  = 300;
+    int segments[]  = { 7, 64, 229 }; // render sizes that don't align with the arpeggiator steps
+
+    for ( int waveform : waveforms )
+    {
+        SynthInstrument* instrument = new SynthInstrument();
+        instrument->getOscillatorProperties( 0 )->setWaveform( waveform );
+
+        instrument->arpeggiatorActive = true;
+        instrument->arpeggiator->setStepSize( 37 );
+        instrument->arpeggiator->setAmountOfSteps( 4 );
+
+        for ( int step = 0; step < 4; ++step )
+            instrument->arpeggiator->setShiftForStep( step, step * 3 );
+
+        BaseSynthEvent* event          = new BaseSynthEvent( 440.f, 0, 1.f, instrument );
+        BaseSynthEvent* segmentedEvent = new BaseSynthEvent( 440.f, 0, 1.f, instrument );
+
+        event->setEventLength( bufferSize * 2 );
+        segmentedEvent->setEventLength( bufferSize * 2 );
+
+        // render the event in a single pass
+
+        AudioBuffer* buffer = new AudioBuffer( 2, bufferSize );
+        instrument->synthesizer->render( buffer, event );
+
+        // render the other event in segments (state should carry over between render cycles)
+
+        AudioBuffer* segmentedBuffer = new AudioBuffer( 2, bufferSize );
+        int offset = 0;
+
+        for ( int segment : segments )
+        {
+            AudioBuffer* segmentBuffer = new AudioBuffer( 2, segment );
+            instrument->synthesizer->render( segmentBuffer, segmentedEvent );
+            segmentedBuffer->mergeBuffers( segmentBuffer, 0, offset, MAX_VOLUME );
+            offset += segment;
+            delete segmentBuffer;
+        }
+
+        EXPECT_EQ( event->cachedProps.arpeggioStep, ( bufferSize / 37 ) % 4 )
+            << "expected arpeggiator to have moved to the step matching the rendered duration";
+
+        EXPECT_EQ( event->cachedProps.arpeggioStep, segmentedEvent->cachedProps.arpeggioStep );
+        EXPECT_EQ( event->cachedProps.arpeggioPosition, segmentedEvent->cachedProps.arpeggioPosition );
+
+        for ( int c = 0; c < buffer->amountOfChannels; ++c )
+        {
+            SAMPLE_TYPE* channel          = buffer->getBufferForChannel( c );
+            SAMPLE_TYPE* segmentedChannel = segmentedBuffer->getBufferForChannel( c );
+
+            for ( int i = 0; i < bufferSize; ++i )
+            {
+                ASSERT_EQ( channel[ i ], segmentedChannel[ i ] )
+                    << "expected segmented render to equal single pass render for waveform " << waveform << " at index " << i;
+            }
+        }
+
+        delete buffer;
+        delete segmentedBuffer;
+        delete event;
+        delete segmentedEvent;
+        delete instrument;
+    }
+}
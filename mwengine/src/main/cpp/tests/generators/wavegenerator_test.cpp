@@ -0,0 +1,119 @@
+#include <generators/wavegenerator.h>
+
+// the magnitude of given harmonic within a single wave cycle
+SAMPLE_TYPE getHarmonicMagnitude( SAMPLE_TYPE* buffer, int length, int harmonic )
+{
+    double real = 0.0, imaginary = 0.0;
+
+    for ( int i = 0; i < length; ++i ) {
+        real      += buffer[ i ] * cos( 2.0 * PI * harmonic * i / length );
+        imaginary -= buffer[ i ] * sin( 2.0 * PI * harmonic * i / length );
+    }
+    return ( SAMPLE_TYPE ) ( 2.0 * sqrt( real * real + imaginary * imaginary ) / length );
+}
+
+TEST( WaveGenerator, GenerateMipmaps )
+{
+    int tableLength  = 128;
+    WaveTable* table = new WaveTable( tableLength, 440.f );
+
+    // naive (non band-limited) sawtooth
+
+    for ( int i = 0; i < tableLength; ++i )
+        table->getBuffer()[ i ] = ( SAMPLE_TYPE ) i / ( tableLength / 2 ) - 1.0;
+
+    WaveGenerator::generateMipmaps( table );
+
+    ASSERT_TRUE( table->hasMipmaps() );
+
+    EXPECT_EQ( 64, table->getMaxHarmonics() );
+    EXPECT_EQ( 7, table->getMipmapAmount() )
+        << "expected a mipmap for 64, 32, 16, 8, 4, 2 and 1 harmonic(s)";
+    EXPECT_EQ( tableLength * WaveGenerator::MIPMAP_OVERSAMPLING, table->getMipmapLength() );
+
+    int mipmapLength = table->getMipmapLength();
+
+    // the first mipmap holds all harmonics and should thus equal the table at its sample positions
+
+    SAMPLE_TYPE* mipmap = table->getMipmapForIncrement( 0.0 );
+
+    for ( int i = 0; i < tableLength; ++i ) {
+        EXPECT_NEAR( table->getBuffer()[ i ], mipmap[ i * WaveGenerator::MIPMAP_OVERSAMPLING ], 1e-4 )
+            << "expected first mipmap to equal the table contents at index " << i;
+    }
+
+    // each mipmap should retain the harmonics of its octave and remove the harmonics above
+
+    for ( int level = 0; level < table->getMipmapAmount(); ++level )
+    {
+        mipmap        = table->getMipmapForIncrement( 0.5 / ( 64 >> level ));
+        int harmonics = 64 >> level;
+
+        EXPECT_NEAR( getHarmonicMagnitude( table->getBuffer(), tableLength, 1 ),
+                     getHarmonicMagnitude( mipmap, mipmapLength, 1 ), 1e-4 )
+            << "expected fundamental to be retained in mipmap " << level;
+
+        EXPECT_NEAR( getHarmonicMagnitude( table->getBuffer(), tableLength, harmonics / 2 + 1 ),
+                     getHarmonicMagnitude( mipmap, mipmapLength, harmonics / 2 + 1 ), 1e-4 )
+            << "expected harmonic " << ( harmonics / 2 + 1 ) << " to be retained in mipmap " << level;
+
+        EXPECT_NEAR( 0.0, getHarmonicMagnitude( mipmap, mipmapLength, harmonics + 1 ), 1e-4 )
+            << "expected harmonic " << ( harmonics + 1 ) << " to be removed from mipmap " << level;
+    }
+    delete table;
+}
+
+TEST( WaveGenerator, GenerateMipmapsNonPowerOfTwo )
+{
+    int tableLength  = 100;
+    WaveTable* table = new WaveTable( tableLength, 440.f );
+
+    for ( int i = 0; i < tableLength; ++i )
+        table->getBuffer()[ i ] = sin( 2.0 * PI * i / tableLength ) + 0.5 * sin( 2.0 * PI * 20 * i / tableLength );
+
+    WaveGenerator::generateMipmaps( table );
+
+    ASSERT_TRUE( table->hasMipmaps() );
+
+    EXPECT_EQ( 50, table->getMaxHarmonics() );
+    EXPECT_EQ( 6, table->getMipmapAmount() );
+    EXPECT_EQ( 512, table->getMipmapLength() ) << "expected mipmap length to be a power of two";
+
+    SAMPLE_TYPE* first = table->getMipmapForIncrement( 0.0 );
+    SAMPLE_TYPE* last  = table->getMipmapForIncrement( 0.5 );
+
+    EXPECT_NEAR( 1.0, getHarmonicMagnitude( first, 512, 1 ), 1e-4 );
+    EXPECT_NEAR( 0.5, getHarmonicMagnitude( first, 512, 20 ), 1e-4 );
+
+    EXPECT_NEAR( 1.0, getHarmonicMagnitude( last, 512, 1 ), 1e-4 );
+    EXPECT_NEAR( 0.0, getHarmonicMagnitude( last, 512, 20 ), 1e-4 )
+        << "expected the last mipmap to solely hold the fundamental";
+
+    delete table;
+}
+
+TEST( WaveGenerator, GenerateMipmapsForEmptyTable )
+{
+    WaveTable* table = new WaveTable( 128, 440.f );
+
+    WaveGenerator::generateMipmaps( table );
+
+    ASSERT_FALSE( table->hasMipmaps() ) << "expected no mipmaps to be generated for a table without content";
+
+    delete table;
+}
+
+TEST( WaveGenerator, GenerateMipmapsForLongTable )
+{
+    int tableLength  = WaveGenerator::MAX_MIPMAP_TABLE_LENGTH + 1;
+    WaveTable* table = new WaveTable( tableLength, 440.f );
+
+    for ( int i = 0; i < tableLength; ++i )
+        table->getBuffer()[ i ] = sin( 2.0 * PI * i / tableLength );
+
+    WaveGenerator::generateMipmaps( table );
+
+    ASSERT_FALSE( table->hasMipmaps() ) << "expected no mipmaps to be generated for a table exceeding the maximum length";
+
+    delete table;
+}
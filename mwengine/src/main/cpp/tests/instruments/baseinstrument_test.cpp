@@ -3,6 +3,9 @@
 #include "../../utilities/eventutility.h"
 #include "../../sequencer.h"
 #include "../../audioengine.h"
+#include "../../messaging/commandqueue.h"
+#include <atomic>
+#include <thread>
 
 TEST( BaseInstrument, Constructor )
 {
@@ -354,4 +357,54 @@ TEST( BaseInstrument, MeasureCache )
     delete audioEvent2;
     delete audioEvent3;
     delete instrument;
-}
\ No newline at end of file
+}
+TEST( BaseInstrument, GrowsEventCapacityWhileRendering )
+{
+    BaseInstrument* instrument = new BaseInstrument();
+    std::vector<BaseAudioEvent*> events;
+
+    int capacity = BaseInstrument::EVENT_CAPACITY;
+
+    for ( int i = 0; i <= capacity; ++i ) {
+        events.push_back( new BaseAudioEvent( instrument ));
+    }
+
+    std::atomic<bool> running( true );
+
+    AudioEngineProps::isRendering.store( true );
+
+    std::thread renderThread([ &running ]() {
+        while ( running.load() ) {
+            CommandQueue::flush();
+            std::this_thread::sleep_for( std::chrono::microseconds( 100 ));
+        }
+    });
+
+    // add one event more than the lists have reserved room for
+
+    for ( auto audioEvent : events ) {
+        audioEvent->addToSequencer();
+    }
+    CommandQueue::synchronize();
+
+    BaseAudioEvent* exceedingEvent = events.at( capacity );
+
+    EXPECT_TRUE( EventUtility::vectorContainsEvent( instrument->getEvents(), exceedingEvent ))
+        << "expected the event exceeding the capacity to have been added";
+
+    EXPECT_EQ( capacity + 1, instrument->getEvents()->size() );
+    EXPECT_EQ( capacity + 1, instrument->getEventIndex()->size() );
+    EXPECT_LE( capacity * 2, instrument->getEvents()->capacity() )
+        << "expected the event list to have been exchanged for one of a larger capacity";
+
+    running.store( false );
+    renderThread.join();
+
+    AudioEngineProps::isRendering.store( false );
+    CommandQueue::synchronize();
+
+    for ( auto audioEvent : events ) {
+        delete audioEvent;
+    }
+    delete instrument;
+}
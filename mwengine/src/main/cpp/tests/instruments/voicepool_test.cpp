@@ -0,0 +1,278 @@
+#include "../../instruments/synthinstrument.h"
+#include "../../instruments/voicepool.h"
+#include "../../events/basesynthevent.h"
+
+TEST( VoicePool, Construction )
+{
+    SynthInstrument* instrument = new SynthInstrument();
+    VoicePool* pool = new VoicePool( instrument, 4, 2 );
+
+    EXPECT_EQ( 4, pool->getMaxPolyphony() )
+        << "expected the maximum polyphony to equal the value given in the constructor";
+
+    EXPECT_EQ( 2, pool->getOscillatorAmount() )
+        << "expected the oscillator amount to equal the value given in the constructor";
+
+    EXPECT_EQ( 0, pool->getActiveVoiceAmount() )
+        << "expected no voices to be active upon construction";
+
+    EXPECT_EQ( VoiceStealing::OLDEST, pool->getStealingPolicy() )
+        << "expected the oldest voice to be stolen by default";
+
+    delete pool;
+    delete instrument;
+}
+
+TEST( VoicePool, AcquireAndRelease )
+{
+    SynthInstrument* instrument = new SynthInstrument();
+    VoicePool* pool = instrument->getVoicePool();
+
+    BaseSynthEvent* event = new BaseSynthEvent( 440.F, instrument );
+
+    ASSERT_TRUE( pool->getVoice( event ) == nullptr )
+        << "expected the event not to have a voice prior to playback";
+
+    event->play();
+
+    SynthVoice* voice = pool->getVoice( event );
+
+    ASSERT_FALSE( voice == nullptr )
+        << "expected the event to have acquired a voice upon playback";
+
+    EXPECT_EQ( 1, pool->getActiveVoiceAmount() )
+        << "expected a single voice to be active";
+
+    EXPECT_EQ( 1, voice->ringBuffers.size() )
+        << "expected the voice to hold a ring buffer for each oscillator of the instrument";
+
+    // removal of the event frees its voice
+
+    instrument->removeEvent( event, true );
+
+    ASSERT_TRUE( pool->getVoice( event ) == nullptr )
+        << "expected the voice to have been released after removal of the event";
+
+    EXPECT_EQ( 0, pool->getActiveVoiceAmount() )
+        << "expected no voices to be active after removal of the event";
+
+    delete event;
+    delete instrument;
+}
+
+TEST( VoicePool, StealOldestVoice )
+{
+    SynthInstrument* instrument = new SynthInstrument();
+    instrument->setMaxPolyphony( 2 );
+
+    VoicePool* pool = instrument->getVoicePool();
+
+    BaseSynthEvent* event1 = new BaseSynthEvent( 440.F, instrument );
+    BaseSynthEvent* event2 = new BaseSynthEvent( 440.F, instrument );
+    BaseSynthEvent* event3 = new BaseSynthEvent( 440.F, instrument );
+
+    event1->play();
+    event2->play();
+    event3->play();
+
+    EXPECT_EQ( 2, pool->getActiveVoiceAmount() )
+        << "expected the amount of active voices not to exceed the maximum polyphony";
+
+    EXPECT_GT( pool->getVoice( event1 )->fadeRemaining, 0 )
+        << "expected the voice of the oldest event to be fading out after having been stolen";
+
+    EXPECT_EQ( 0, pool->getVoice( event2 )->fadeRemaining )
+        << "expected the voice of the second event to remain playing";
+
+    EXPECT_EQ( 0, pool->getVoice( event3 )->fadeRemaining )
+        << "expected the voice of the newest event to be playing";
+
+    delete event1;
+    delete event2;
+    delete event3;
+    delete instrument;
+}
+
+TEST( VoicePool, StealQuietestVoice )
+{
+    SynthInstrument* instrument = new SynthInstrument();
+    instrument->setMaxPolyphony( 2 );
+    instrument->setVoiceStealingPolicy( VoiceStealing::QUIETEST );
+
+    VoicePool* pool = instrument->getVoicePool();
+
+    BaseSynthEvent* event1 = new BaseSynthEvent( 440.F, instrument );
+    BaseSynthEvent* event2 = new BaseSynthEvent( 440.F, instrument );
+    BaseSynthEvent* event3 = new BaseSynthEvent( 440.F, instrument );
+
+    event1->setVolume( 1.F );
+    event2->setVolume( .1F );
+
+    event1->play();
+    event2->play();
+
+    event1->cachedProps.envelope = 1.0;
+    event2->cachedProps.envelope = 1.0;
+
+    event3->play();
+
+    EXPECT_EQ( 0, pool->getVoice( event1 )->fadeRemaining )
+        << "expected the voice of the loudest event to remain playing";
+
+    EXPECT_GT( pool->getVoice( event2 )->fadeRemaining, 0 )
+        << "expected the voice of the quietest event to be fading out after having been stolen";
+
+    delete event1;
+    delete event2;
+    delete event3;
+    delete instrument;
+}
+
+TEST( VoicePool, StealReleasedVoiceFirst )
+{
+    SynthInstrument* instrument = new SynthInstrument();
+    instrument->setMaxPolyphony( 2 );
+    instrument->setVoiceStealingPolicy( VoiceStealing::RELEASED_FIRST );
+
+    VoicePool* pool = instrument->getVoicePool();
+
+    BaseSynthEvent* event1 = new BaseSynthEvent( 440.F, instrument );
+    BaseSynthEvent* event2 = new BaseSynthEvent( 440.F, instrument );
+    BaseSynthEvent* event3 = new BaseSynthEvent( 440.F, instrument );
+
+    event1->play();
+    event2->play();
+    event2->stop(); // enters the release phase
+
+    event3->play();
+
+    EXPECT_EQ( 0, pool->getVoice( event1 )->fadeRemaining )
+        << "expected the voice of the held (though older) event to remain playing";
+
+    EXPECT_GT( pool->getVoice( event2 )->fadeRemaining, 0 )
+        << "expected the voice of the released event to be fading out after having been stolen";
+
+    delete event1;
+    delete event2;
+    delete event3;
+    delete instrument;
+}
+
+TEST( VoicePool, CutOffVoiceWhenFadeVoicesAreExhausted )
+{
+    SynthInstrument* instrument = new SynthInstrument();
+    instrument->setMaxPolyphony( 1 );
+
+    VoicePool* pool = instrument->getVoicePool();
+    std::vector<BaseSynthEvent*> events;
+
+    // each played event steals the voice of its predecessor, exceeding the voices reserved for fading
+
+    int amountOfEvents = 2 + VoicePool::FADE_VOICES;
+
+    for ( int i = 0; i < amountOfEvents; ++i ) {
+        BaseSynthEvent* event = new BaseSynthEvent( 440.F, instrument );
+        event->play();
+        events.push_back( event );
+    }
+
+    ASSERT_TRUE( pool->getVoice( events.at( 0 )) == nullptr )
+        << "expected the voice of the first event to have been cut off";
+
+    EXPECT_EQ( amountOfEvents - 1, instrument->getLiveEvents()->size() )
+        << "expected the event that was cut off to have been removed from the instrument";
+
+    EXPECT_EQ( 1, pool->getActiveVoiceAmount() )
+        << "expected a single voice to be active";
+
+    for ( auto event : events ) {
+        delete event;
+    }
+    delete instrument;
+}
+
+TEST( VoicePool, ApplyFade )
+{
+    SynthInstrument* instrument = new SynthInstrument();
+    instrument->setMaxPolyphony( 1 );
+
+    VoicePool* pool = instrument->getVoicePool();
+
+    BaseSynthEvent* event1 = new BaseSynthEvent( 440.F, instrument );
+    BaseSynthEvent* event2 = new BaseSynthEvent( 440.F, instrument );
+
+    event1->play();
+    event2->play();
+
+    SynthVoice* voice = pool->getVoice( event1 );
+    int fadeDuration  = voice->fadeRemaining;
+    int bufferSize    = fadeDuration + 16;
+
+    AudioBuffer* buffer = new AudioBuffer( 1, bufferSize );
+    SAMPLE_TYPE* channelBuffer = buffer->getBufferForChannel( 0 );
+
+    for ( int i = 0; i < bufferSize; ++i ) {
+        channelBuffer[ i ] = 1.0;
+    }
+
+    ASSERT_TRUE( pool->applyFade( voice, buffer ))
+        << "expected the fade to have completed within a buffer exceeding the fade duration";
+
+    EXPECT_EQ( 1.0, channelBuffer[ 0 ] )
+        << "expected the fade to start at full volume";
+
+    EXPECT_LT( channelBuffer[ fadeDuration - 1 ], channelBuffer[ 0 ] )
+        << "expected the fade to decrease the volume over time";
+
+    for ( int i = fadeDuration; i < bufferSize; ++i ) {
+        EXPECT_EQ( 0.0, channelBuffer[ i ] )
+            << "expected the buffer to be silent beyond the fade";
+    }
+
+    delete buffer;
+    delete event1;
+    delete event2;
+    delete instrument;
+}
+
+TEST( VoicePool, UpdatePolyphony )
+{
+    SynthInstrument* instrument = new SynthInstrument();
+
+    EXPECT_EQ( SynthInstrument::DEFAULT_POLYPHONY, instrument->getMaxPolyphony() )
+        << "expected the default polyphony upon construction";
+
+    BaseSynthEvent* event1 = new BaseSynthEvent( 440.F, instrument );
+    BaseSynthEvent* event2 = new BaseSynthEvent( 440.F, instrument );
+
+    event1->play();
+    event2->play();
+
+    instrument->setVoiceStealingPolicy( VoiceStealing::QUIETEST );
+    instrument->setMaxPolyphony( 1 );
+
+    VoicePool* pool = instrument->getVoicePool();
+
+    EXPECT_EQ( 1, pool->getMaxPolyphony() )
+        << "expected the maximum polyphony to have updated";
+
+    EXPECT_EQ( VoiceStealing::QUIETEST, pool->getStealingPolicy() )
+        << "expected the stealing policy to have been retained";
+
+    ASSERT_FALSE( pool->getVoice( event1 ) == nullptr || pool->getVoice( event2 ) == nullptr )
+        << "expected the playing events to have been moved onto the voices of the updated pool";
+
+    EXPECT_EQ( 1, pool->getActiveVoiceAmount() )
+        << "expected the amount of active voices not to exceed the updated polyphony";
+
+    // increasing the oscillator amount provides the voices with additional ring buffers
+
+    instrument->setOscillatorAmount( 3 );
+
+    EXPECT_EQ( 3, instrument->getVoicePool()->getVoice( event2 )->ringBuffers.size() )
+        << "expected the voice to hold a ring buffer for each oscillator of the instrument";
+
+    delete event1;
+    delete event2;
+    delete instrument;
+}
@@ -0,0 +1,242 @@
+#include "../../instruments/synthinstrument.h"
+#include "../../instruments/voicerenderer.h"
+#include "../../events/basesynthevent.h"
+#include <definitions/waveforms.h>
+
+// creates an instrument with two (detuned) oscillators of given waveform
+
+SynthInstrument* createVoiceRendererInstrument( int waveform, bool batched )
+{
+    SynthInstrument* instrument = new SynthInstrument();
+
+    instrument->setBatchedRendering( batched );
+    instrument->setOscillatorAmount( 2 );
+    instrument->getOscillatorProperties( 0 )->setWaveform( waveform );
+    instrument->getOscillatorProperties( 1 )->setWaveform( waveform );
+    instrument->getOscillatorProperties( 1 )->detune      = 7;
+    instrument->getOscillatorProperties( 1 )->octaveShift = 1;
+
+    return instrument;
+}
+
+void expectEqualBuffers( AudioBuffer* expected, AudioBuffer* actual, int waveform, int cycle )
+{
+    for ( int c = 0; c < expected->amountOfChannels; ++c )
+    {
+        SAMPLE_TYPE* expectedChannel = expected->getBufferForChannel( c );
+        SAMPLE_TYPE* actualChannel   = actual->getBufferForChannel( c );
+
+        for ( int i = 0; i < expected->bufferSize; ++i )
+        {
+            ASSERT_NEAR( expectedChannel[ i ], actualChannel[ i ], 1.0E-4 )
+                << "expected batched render to equal individual render for waveform " << waveform
+                << " in cycle " << cycle << " at index " << i << " of channel " << c;
+        }
+    }
+}
+
+TEST( VoiceRenderer, BatchedRendering )
+{
+    SynthInstrument* instrument = new SynthInstrument();
+
+    EXPECT_TRUE( instrument->getBatchedRendering() )
+        << "expected batched rendering to be enabled by default";
+
+    instrument->setBatchedRendering( false );
+
+    EXPECT_FALSE( instrument->getBatchedRendering() )
+        << "expected batched rendering to have been disabled";
+
+    EXPECT_FALSE( instrument->getVoiceRenderer()->isEnabled() );
+
+    delete instrument;
+}
+
+TEST( VoiceRenderer, RenderSequencedEvents )
+{
+    int waveforms[]   = { WaveForms::SINE, WaveForms::TRIANGLE, WaveForms::SAWTOOTH, WaveForms::SQUARE };
+    int bufferSize    = 256;
+    int cycles        = 12;
+    int eventAmount   = 6; // exceeds the amount of lanes
+    int eventLength   = bufferSize * 8;
+    int maxBufferPos  = bufferSize * cycles;
+
+    for ( int waveform : waveforms )
+    {
+        SynthInstrument* instruments[ 2 ] = {
+            createVoiceRendererInstrument( waveform, false ),
+            createVoiceRendererInstrument( waveform, true )
+        };
+        BaseSynthEvent* events[ 2 ][ 6 ];
+
+        for ( int n = 0; n < 2; ++n )
+        {
+            for ( int e = 0; e < eventAmount; ++e )
+            {
+                // events start and end at different offsets (not all aligned to the buffer)
+
+                events[ n ][ e ] = new BaseSynthEvent( 220.f + e * 110.f, 0, 1.f, instruments[ n ]);
+                events[ n ][ e ]->setEventStart( e * 100 );
+                events[ n ][ e ]->setEventLength( eventLength + e * 50 );
+            }
+        }
+
+        AudioBuffer* buffers[ 2 ] = { new AudioBuffer( 2, bufferSize ), new AudioBuffer( 2, bufferSize ) };
+
+        for ( int cycle = 0, bufferPos = 0; cycle < cycles; ++cycle, bufferPos += bufferSize )
+        {
+            for ( int n = 0; n < 2; ++n )
+            {
+                buffers[ n ]->silenceBuffers();
+                instruments[ n ]->beginEventMix( buffers[ n ]);
+
+                for ( int e = 0; e < eventAmount; ++e )
+                    events[ n ][ e ]->mixBuffer( buffers[ n ], bufferPos, 0, maxBufferPos, false, 0, false );
+
+                instruments[ n ]->endEventMix();
+            }
+            expectEqualBuffers( buffers[ 0 ], buffers[ 1 ], waveform, cycle );
+
+            for ( int e = 0; e < eventAmount; ++e )
+            {
+                EXPECT_EQ( events[ 0 ][ e ]->lastWriteIndex, events[ 1 ][ e ]->lastWriteIndex )
+                    << "expected the write index of the batched event to have advanced equally";
+            }
+        }
+
+        for ( int n = 0; n < 2; ++n )
+        {
+            for ( int e = 0; e < eventAmount; ++e )
+                delete events[ n ][ e ];
+
+            delete buffers[ n ];
+            delete instruments[ n ];
+        }
+    }
+}
+
+TEST( VoiceRenderer, RenderEnvelopedEvents )
+{
+    int bufferSize   = 128;
+    int cycles       = 24;
+    int eventAmount  = 6;
+    int eventLength  = bufferSize * 12;
+    int maxBufferPos = bufferSize * cycles;
+
+    SynthInstrument* instruments[ 2 ] = {
+        createVoiceRendererInstrument( WaveForms::SAWTOOTH, false ),
+        createVoiceRendererInstrument( WaveForms::SAWTOOTH, true )
+    };
+    BaseSynthEvent* events[ 2 ][ 6 ];
+
+    for ( int n = 0; n < 2; ++n )
+    {
+        // the envelope stages change within the render cycles
+
+        instruments[ n ]->adsr->setAttackTime( .005f );
+        instruments[ n ]->adsr->setDecayTime( .01f );
+        instruments[ n ]->adsr->setSustainLevel( .5f );
+        instruments[ n ]->adsr->setReleaseTime( .01f );
+
+        for ( int e = 0; e < eventAmount; ++e )
+        {
+            events[ n ][ e ] = new BaseSynthEvent( 220.f + e * 110.f, 0, 1.f, instruments[ n ]);
+            events[ n ][ e ]->setEventStart( e * 30 );
+            events[ n ][ e ]->setEventLength( eventLength + e * 70 );
+        }
+    }
+
+    AudioBuffer* buffers[ 2 ] = { new AudioBuffer( 2, bufferSize ), new AudioBuffer( 2, bufferSize ) };
+
+    for ( int cycle = 0, bufferPos = 0; cycle < cycles; ++cycle, bufferPos += bufferSize )
+    {
+        for ( int n = 0; n < 2; ++n )
+        {
+            buffers[ n ]->silenceBuffers();
+            instruments[ n ]->beginEventMix( buffers[ n ]);
+
+            for ( int e = 0; e < eventAmount; ++e )
+                events[ n ][ e ]->mixBuffer( buffers[ n ], bufferPos, 0, maxBufferPos, false, 0, false );
+
+            instruments[ n ]->endEventMix();
+        }
+        expectEqualBuffers( buffers[ 0 ], buffers[ 1 ], WaveForms::SAWTOOTH, cycle );
+
+        for ( int e = 0; e < eventAmount; ++e )
+        {
+            EXPECT_FLOAT_EQ( events[ 0 ][ e ]->cachedProps.envelope, events[ 1 ][ e ]->cachedProps.envelope )
+                << "expected the envelope of the batched event to have advanced equally";
+        }
+    }
+
+    for ( int n = 0; n < 2; ++n )
+    {
+        for ( int e = 0; e < eventAmount; ++e )
+            delete events[ n ][ e ];
+
+        delete buffers[ n ];
+        delete instruments[ n ];
+    }
+}
+
+TEST( VoiceRenderer, RenderLiveEvents )
+{
+    int waveforms[] = { WaveForms::SINE, WaveForms::SAWTOOTH };
+    int bufferSize  = 128;
+    int cycles      = 24;
+    int eventAmount = 5;
+
+    for ( int waveform : waveforms )
+    {
+        SynthInstrument* instruments[ 2 ] = {
+            createVoiceRendererInstrument( waveform, false ),
+            createVoiceRendererInstrument( waveform, true )
+        };
+        BaseSynthEvent* events[ 2 ][ 5 ];
+
+        for ( int n = 0; n < 2; ++n )
+        {
+            for ( int e = 0; e < eventAmount; ++e ) {
+                events[ n ][ e ] = new BaseSynthEvent( 220.f + e * 55.f, instruments[ n ]);
+                events[ n ][ e ]->play();
+            }
+        }
+
+        AudioBuffer* buffers[ 2 ] = { new AudioBuffer( 2, bufferSize ), new AudioBuffer( 2, bufferSize ) };
+
+        for ( int cycle = 0; cycle < cycles; ++cycle )
+        {
+            // release the first event halfway (will fade out once its minimum length has been rendered)
+
+            if ( cycle == cycles / 2 ) {
+                events[ 0 ][ 0 ]->stop();
+                events[ 1 ][ 0 ]->stop();
+            }
+
+            for ( int n = 0; n < 2; ++n )
+            {
+                buffers[ n ]->silenceBuffers();
+                instruments[ n ]->beginEventMix( buffers[ n ]);
+
+                for ( int e = 0; e < eventAmount; ++e )
+                {
+                    if ( events[ n ][ e ]->isEnqueuedForRemoval() )
+                        continue;
+
+                    events[ n ][ e ]->mixBuffer( buffers[ n ]);
+                }
+                instruments[ n ]->endEventMix();
+            }
+            expectEqualBuffers( buffers[ 0 ], buffers[ 1 ], waveform, cycle );
+        }
+
+        for ( int n = 0; n < 2; ++n )
+        {
+            for ( int e = 0; e < eventAmount; ++e )
+                delete events[ n ][ e ];
+
+            delete buffers[ n ];
+            delete instruments[ n ];
+        }
+    }
+}
@@ -41,15 +41,22 @@ using namespace MWEngine;
 #include "ringbuffer_test.cpp"
 #include "sequencer_test.cpp"
 #include "sequencercontroller_test.cpp"
+#include "workerpool_test.cpp"
 #include "wavetable_test.cpp"
 #include "events/baseaudioevent_test.cpp"
 #include "events/basesynthevent_test.cpp"
 //#include "events/drumevent_test.cpp"
 #include "events/sampleevent_test.cpp"
+#include "events/streamingsampleevent_test.cpp"
 #include "generators/envelopegenerator_test.cpp"
+#include "generators/synthesizer_test.cpp"
+#include "generators/wavegenerator_test.cpp"
 #include "instruments/baseinstrument_test.cpp"
 #include "instruments/synthinstrument_test.cpp"
+#include "instruments/voicepool_test.cpp"
+#include "instruments/voicerenderer_test.cpp"
 #include "modules/adsr_test.cpp"
+#include "modules/arpeggiator_test.cpp"
 #include "modules/lfo_test.cpp"
 #include "processors/baseprocessor_test.cpp"
 #include "processors/bitcrusher_test.cpp"
@@ -73,10 +80,25 @@ using namespace MWEngine;
 #include "processors/reverbsm_test.cpp"
 #include "processors/tremolo_test.cpp"
 #include "processors/waveshaper_test.cpp"
+#include "messaging/commandqueue_test.cpp"
+#include "messaging/notifier_test.cpp"
+#include "utilities/bufferpool_test.cpp"
+#include "utilities/bufferutility_test.cpp"
+#include "utilities/compactbuffer_test.cpp"
+#include "utilities/diskwriter_test.cpp"
+#include "utilities/eventindex_test.cpp"
 #include "utilities/eventutility_test.cpp"
+#include "utilities/offlinerenderer_test.cpp"
+#include "utilities/renderprofiler_test.cpp"
+#include "utilities/resampler_test.cpp"
+#include "utilities/rtsafetychecker_test.cpp"
 #include "utilities/tablepool_test.cpp"
+#include "utilities/samplebank_test.cpp"
 #include "utilities/samplemanager_test.cpp"
+#include "utilities/samplestream_test.cpp"
+#include "utilities/spscqueue_test.cpp"
 #include "utilities/sampleutility_test.cpp"
+#include "utilities/wavereader_test.cpp"
 #include "utilities/waveutil_test.cpp"
 #include "utilities/volumeutil_test.cpp"
 #include "deprecation_test.cpp"
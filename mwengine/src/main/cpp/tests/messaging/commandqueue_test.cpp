@@ -0,0 +1,246 @@
+#include "../../messaging/commandqueue.h"
+#include "../../instruments/baseinstrument.h"
+#include "../../processors/baseprocessor.h"
+#include "../../processingchain.h"
+#include "../../utilities/eventutility.h"
+#include <atomic>
+#include <thread>
+
+// applies the pending commands from a thread other than the calling one (mimicking a single render cycle)
+
+void flushFromRenderThread()
+{
+    std::thread renderThread([]() { CommandQueue::flush(); });
+    renderThread.join();
+}
+
+TEST( CommandQueue, AppliesImmediatelyWhenNotRendering )
+{
+    ASSERT_FALSE( CommandQueue::isDeferred() )
+        << "expected mutations not to be deferred when the engine isn't rendering";
+
+    BaseInstrument* instrument = new BaseInstrument();
+    BaseAudioEvent* audioEvent = new BaseAudioEvent( instrument );
+
+    uint64_t posted = CommandQueue::getPostedCommands();
+
+    audioEvent->addToSequencer();
+
+    ASSERT_TRUE( EventUtility::vectorContainsEvent( instrument->getEvents(), audioEvent ))
+        << "expected event to have been added immediately";
+
+    EXPECT_EQ( posted, CommandQueue::getPostedCommands() )
+        << "expected no commands to have been posted";
+
+    delete audioEvent;
+    delete instrument;
+}
+
+TEST( CommandQueue, DefersMutationsWhileRendering )
+{
+    BaseInstrument* instrument = new BaseInstrument();
+    BaseAudioEvent* audioEvent = new BaseAudioEvent( instrument );
+    ProcessingChain* chain     = instrument->audioChannel->processingChain;
+    BaseProcessor* processor   = new BaseProcessor();
+
+    AudioEngineProps::isRendering.store( true );
+
+    ASSERT_TRUE( CommandQueue::isDeferred() )
+        << "expected mutations to be deferred when the engine is rendering";
+
+    // 1. addition
+
+    audioEvent->addToSequencer();
+    chain->addProcessor( processor );
+
+    ASSERT_FALSE( EventUtility::vectorContainsEvent( instrument->getEvents(), audioEvent ))
+        << "expected event not to be added before the render thread applied the command";
+
+    ASSERT_FALSE( chain->hasProcessors() )
+        << "expected processor not to be added before the render thread applied the command";
+
+    flushFromRenderThread();
+
+    ASSERT_TRUE( EventUtility::vectorContainsEvent( instrument->getEvents(), audioEvent ))
+        << "expected event to be added after the render thread applied the command";
+
+    ASSERT_TRUE( chain->getProcessorAt( 0 ) == processor )
+        << "expected processor to be added after the render thread applied the command";
+
+    // 2. removal
+
+    audioEvent->removeFromSequencer();
+    chain->removeProcessor( processor );
+
+    ASSERT_TRUE( EventUtility::vectorContainsEvent( instrument->getEvents(), audioEvent ))
+        << "expected event not to be removed before the render thread applied the command";
+
+    flushFromRenderThread();
+
+    ASSERT_FALSE( EventUtility::vectorContainsEvent( instrument->getEvents(), audioEvent ))
+        << "expected event to be removed after the render thread applied the command";
+
+    ASSERT_FALSE( chain->hasProcessors() )
+        << "expected processor to be removed after the render thread applied the command";
+
+    EXPECT_EQ( CommandQueue::getPostedCommands(), CommandQueue::getAppliedCommands() )
+        << "expected all posted commands to have been applied";
+
+    AudioEngineProps::isRendering.store( false );
+    CommandQueue::synchronize();
+
+    delete processor;
+    delete audioEvent;
+    delete instrument;
+}
+
+TEST( CommandQueue, SynchronizeAwaitsRenderThread )
+{
+    std::atomic<bool> running( true );
+
+    AudioEngineProps::isRendering.store( true );
+
+    std::thread renderThread([ &running ]() {
+        while ( running.load() ) {
+            CommandQueue::flush();
+            std::this_thread::sleep_for( std::chrono::microseconds( 100 ));
+        }
+    });
+
+    // instrument registration is applied by the render thread
+
+    BaseInstrument* instrument = new BaseInstrument();
+    CommandQueue::synchronize();
+
+    ASSERT_TRUE( std::find( Sequencer::instruments.begin(), Sequencer::instruments.end(), instrument ) != Sequencer::instruments.end() )
+        << "expected instrument to be registered after synchronizing with the render thread";
+
+    for ( int i = 0; i < 64; ++i ) {
+        BaseAudioEvent* audioEvent = new BaseAudioEvent( instrument );
+        audioEvent->addToSequencer();
+    }
+    CommandQueue::synchronize();
+
+    EXPECT_EQ( 64, instrument->getEvents()->size() )
+        << "expected all events to be added after synchronizing with the render thread";
+
+    // destroying the events and the instrument waits for the render thread to release them
+
+    while ( !instrument->getEvents()->empty() ) {
+        delete instrument->getEvents()->at( 0 );
+    }
+    delete instrument;
+
+    ASSERT_TRUE( std::find( Sequencer::instruments.begin(), Sequencer::instruments.end(), instrument ) == Sequencer::instruments.end() )
+        << "expected instrument to be unregistered upon destruction";
+
+    running.store( false );
+    renderThread.join();
+
+    AudioEngineProps::isRendering.store( false );
+    CommandQueue::synchronize();
+}
+
+TEST( CommandQueue, NeverAppliesOnControlThreadWhileRendering )
+{
+    BaseInstrument* instrument = new BaseInstrument();
+    BaseAudioEvent* audioEvent = new BaseAudioEvent( instrument );
+
+    AudioEngineProps::isRendering.store( true );
+
+    audioEvent->addToSequencer();
+
+    // control thread awaits the render thread, which stalls for longer than the warning time
+
+    std::atomic<bool> synchronized( false );
+
+    std::thread controlThread([ &synchronized ]() {
+        CommandQueue::synchronize();
+        synchronized.store( true );
+    });
+
+    std::this_thread::sleep_for( std::chrono::milliseconds( 2500 ));
+
+    ASSERT_FALSE( synchronized.load() )
+        << "expected control thread to keep waiting for the stalled render thread";
+
+    ASSERT_FALSE( EventUtility::vectorContainsEvent( instrument->getEvents(), audioEvent ))
+        << "expected the control thread not to have applied the command while the engine is rendering";
+
+    flushFromRenderThread();
+    controlThread.join();
+
+    ASSERT_TRUE( EventUtility::vectorContainsEvent( instrument->getEvents(), audioEvent ))
+        << "expected the render thread to have applied the command";
+
+    AudioEngineProps::isRendering.store( false );
+    CommandQueue::synchronize();
+
+    delete audioEvent;
+    delete instrument;
+}
+
+TEST( CommandQueue, DestroysDetachedObjectsWithoutPosting )
+{
+    std::atomic<bool> running( true );
+
+    AudioEngineProps::isRendering.store( true );
+
+    std::thread renderThread([ &running ]() {
+        while ( running.load() ) {
+            CommandQueue::flush();
+            std::this_thread::sleep_for( std::chrono::microseconds( 100 ));
+        }
+    });
+
+    BaseInstrument* instrument = new BaseInstrument();
+    ProcessingChain* chain     = instrument->audioChannel->processingChain;
+
+    std::vector<BaseAudioEvent*> events;
+    std::vector<BaseProcessor*> processors;
+
+    for ( int i = 0; i < 16; ++i ) {
+        BaseAudioEvent* audioEvent = new BaseAudioEvent( instrument );
+        audioEvent->addToSequencer();
+        events.push_back( audioEvent );
+
+        BaseProcessor* processor = new BaseProcessor();
+        chain->addProcessor( processor );
+        processors.push_back( processor );
+    }
+    CommandQueue::synchronize();
+
+    ASSERT_EQ( 16, instrument->getEvents()->size() );
+    ASSERT_EQ( 16, chain->amountOfProcessors() );
+
+    // detach all objects at once and await their removal a single time
+
+    for ( auto audioEvent : events ) {
+        audioEvent->setInstrument( nullptr );
+    }
+    chain->reset();
+    CommandQueue::synchronize();
+
+    EXPECT_TRUE( instrument->getEvents()->empty() );
+    EXPECT_FALSE( chain->hasProcessors() );
+
+    uint64_t posted = CommandQueue::getPostedCommands();
+
+    for ( auto audioEvent : events ) {
+        delete audioEvent;
+    }
+    for ( auto processor : processors ) {
+        delete processor;
+    }
+
+    EXPECT_EQ( posted, CommandQueue::getPostedCommands() )
+        << "expected no removals to have been posted for the detached objects";
+
+    delete instrument;
+
+    running.store( false );
+    renderThread.join();
+
+    AudioEngineProps::isRendering.store( false );
+    CommandQueue::synchronize();
+}
@@ -0,0 +1,245 @@
+#include "../../messaging/notifier.h"
+#include "../../messaging/commandqueue.h"
+#include "../../definitions/notifications.h"
+#include <atomic>
+#include <thread>
+
+// records the notifications (and the thread and sample frame they were dispatched with)
+
+class NotificationRecorder final : public Observer
+{
+    public:
+        std::vector<int> types;
+        std::vector<int> values;
+        std::vector<int64_t> frames;
+        std::vector<std::thread::id> threads;
+
+        void handleNotification( int aNotificationType ) {
+            handleNotification( aNotificationType, -1 );
+        }
+
+        void handleNotification( int aNotificationType, int aValue ) {
+            types.push_back( aNotificationType );
+            values.push_back( aValue );
+            frames.push_back( Notifier::getNotificationFrame() );
+            threads.push_back( std::this_thread::get_id() );
+        }
+};
+
+TEST( Notifier, BroadcastsImmediatelyWhenNotRendering )
+{
+    NotificationRecorder* recorder = new NotificationRecorder();
+    Notifier::registerObserver( Notifications::SEQUENCER_POSITION_UPDATED, recorder );
+
+    Notifier::broadcastAtFrame( 1234, Notifications::SEQUENCER_POSITION_UPDATED, 5 );
+
+    ASSERT_EQ( 1, recorder->types.size() )
+        << "expected notification to have been dispatched immediately";
+
+    EXPECT_EQ( 5, recorder->values[ 0 ] ) << "expected notification value to have been dispatched";
+    EXPECT_EQ( 1234, recorder->frames[ 0 ] ) << "expected notification frame to have been dispatched";
+    EXPECT_EQ( std::this_thread::get_id(), recorder->threads[ 0 ] )
+        << "expected notification to have been dispatched on the broadcasting thread";
+
+    Notifier::unregisterObserver( Notifications::SEQUENCER_POSITION_UPDATED, recorder );
+    delete recorder;
+}
+
+TEST( Notifier, DefersBroadcastsFromRenderThread )
+{
+    NotificationRecorder* recorder = new NotificationRecorder();
+    Notifier::registerObserver( Notifications::SEQUENCER_POSITION_UPDATED, recorder );
+    Notifier::registerObserver( Notifications::MARKER_POSITION_REACHED,    recorder );
+
+    uint64_t coalesced = Notifier::getCoalescedNotifications();
+    int amount = 500;
+
+    Notifier::startDispatcher();
+    AudioEngineProps::isRendering.store( true );
+
+    std::thread::id renderThreadId;
+
+    std::thread renderThread([ &renderThreadId, amount ]() {
+        renderThreadId = std::this_thread::get_id();
+        CommandQueue::flush(); // marks this thread as the render thread
+
+        for ( int i = 0; i < amount; ++i ) {
+            Notifier::broadcastAtFrame( i * 100, Notifications::SEQUENCER_POSITION_UPDATED, i );
+
+            if ( i == amount / 2 ) {
+                Notifier::broadcastAtFrame( i * 100 + 50, Notifications::MARKER_POSITION_REACHED );
+            }
+        }
+    });
+    renderThread.join();
+
+    AudioEngineProps::isRendering.store( false );
+    Notifier::stopDispatcher();
+    CommandQueue::synchronize();
+
+    uint64_t totalCoalesced = Notifier::getCoalescedNotifications() - coalesced;
+
+    EXPECT_EQ( amount + 1, recorder->types.size() + totalCoalesced )
+        << "expected all notifications to have been dispatched or coalesced";
+
+    EXPECT_EQ( 0, Notifier::getDroppedNotifications() )
+        << "expected no notifications to have been dropped";
+
+    int markers = 0, lastValue = -1;
+    int64_t lastFrame = -1;
+
+    for ( size_t i = 0; i < recorder->types.size(); ++i )
+    {
+        EXPECT_NE( renderThreadId, recorder->threads[ i ] )
+            << "expected notification not to be dispatched on the render thread";
+
+        EXPECT_GT( recorder->frames[ i ], lastFrame )
+            << "expected notifications to be dispatched in order of occurrence";
+
+        lastFrame = recorder->frames[ i ];
+
+        if ( recorder->types[ i ] == Notifications::MARKER_POSITION_REACHED ) {
+            ++markers;
+            EXPECT_EQ(( amount / 2 ) * 100 + 50, recorder->frames[ i ] ) << "expected marker frame to have been dispatched";
+            continue;
+        }
+        EXPECT_EQ( recorder->values[ i ] * 100, recorder->frames[ i ] )
+            << "expected the frame to match the position update it was broadcast with";
+
+        lastValue = recorder->values[ i ];
+    }
+
+    EXPECT_EQ( 1, markers ) << "expected the marker notification not to be coalesced";
+    EXPECT_EQ( amount - 1, lastValue ) << "expected the most recent position update to have been dispatched";
+
+    Notifier::unregisterObserver( Notifications::SEQUENCER_POSITION_UPDATED, recorder );
+    Notifier::unregisterObserver( Notifications::MARKER_POSITION_REACHED,    recorder );
+    delete recorder;
+}
+
+TEST( Notifier, PositionUpdatesDoNotOccupyTheQueue )
+{
+    NotificationRecorder* recorder = new NotificationRecorder();
+    Notifier::registerObserver( Notifications::SEQUENCER_POSITION_UPDATED, recorder );
+    Notifier::registerObserver( Notifications::BOUNCE_COMPLETE,            recorder );
+
+    uint64_t dropped = Notifier::getDroppedNotifications();
+
+    Notifier::startDispatcher();
+    AudioEngineProps::isRendering.store( true );
+
+    // broadcast a multitude of the queue capacity of position updates, followed by a discrete notification
+
+    int amount = 10000;
+
+    std::thread renderThread([ amount ]() {
+        CommandQueue::flush(); // marks this thread as the render thread
+
+        for ( int i = 0; i < amount; ++i ) {
+            Notifier::broadcastAtFrame( i, Notifications::SEQUENCER_POSITION_UPDATED, i );
+        }
+        Notifier::broadcastAtFrame( amount, Notifications::BOUNCE_COMPLETE );
+    });
+    renderThread.join();
+
+    AudioEngineProps::isRendering.store( false );
+    Notifier::stopDispatcher();
+    CommandQueue::synchronize();
+
+    EXPECT_EQ( dropped, Notifier::getDroppedNotifications() ) << "expected no notifications to have been dropped";
+
+    ASSERT_FALSE( recorder->types.empty() );
+    EXPECT_EQ( Notifications::BOUNCE_COMPLETE, recorder->types.back() )
+        << "expected the discrete notification to have been dispatched last";
+
+    EXPECT_EQ( amount - 1, recorder->values[ recorder->values.size() - 2 ] )
+        << "expected the most recent position update to have been dispatched prior to the discrete notification";
+
+    Notifier::unregisterObserver( Notifications::SEQUENCER_POSITION_UPDATED, recorder );
+    Notifier::unregisterObserver( Notifications::BOUNCE_COMPLETE,            recorder );
+    delete recorder;
+}
+
+TEST( Notifier, DefersBroadcastsFromRenderWorkers )
+{
+    NotificationRecorder* recorder = new NotificationRecorder();
+    Notifier::registerObserver( Notifications::MARKER_POSITION_REACHED, recorder );
+
+    Notifier::startDispatcher();
+    AudioEngineProps::isRendering.store( true );
+
+    std::thread::id workerThreadId;
+
+    std::thread workerThread([ &workerThreadId ]() {
+        workerThreadId = std::this_thread::get_id();
+        Notifier::registerRenderWorker();
+
+        Notifier::broadcastAtFrame( 100, Notifications::MARKER_POSITION_REACHED );
+        Notifier::broadcastAtFrame( 200, Notifications::MARKER_POSITION_REACHED );
+
+        Notifier::unregisterRenderWorker();
+    });
+    workerThread.join();
+
+    AudioEngineProps::isRendering.store( false );
+    Notifier::stopDispatcher();
+
+    ASSERT_EQ( 2, recorder->types.size() ) << "expected all notifications to have been dispatched";
+
+    for ( size_t i = 0; i < recorder->types.size(); ++i ) {
+        EXPECT_NE( workerThreadId, recorder->threads[ i ] )
+            << "expected notification not to be dispatched on the render worker thread";
+    }
+    EXPECT_EQ( 100, recorder->frames[ 0 ] );
+    EXPECT_EQ( 200, recorder->frames[ 1 ] );
+
+    Notifier::unregisterObserver( Notifications::MARKER_POSITION_REACHED, recorder );
+    delete recorder;
+}
+
+TEST( Notifier, RegistersObserversWhileDispatching )
+{
+    NotificationRecorder* recorder = new NotificationRecorder();
+    Notifier::registerObserver( Notifications::MARKER_POSITION_REACHED, recorder );
+
+    Notifier::startDispatcher();
+    AudioEngineProps::isRendering.store( true );
+
+    std::atomic<bool> running( true );
+
+    std::thread renderThread([ &running ]() {
+        CommandQueue::flush(); // marks this thread as the render thread
+
+        for ( int i = 0; running.load(); ++i ) {
+            Notifier::broadcastAtFrame( i, Notifications::MARKER_POSITION_REACHED );
+            std::this_thread::sleep_for( std::chrono::microseconds( 10 ));
+        }
+    });
+
+    // (un)register observers while the dispatcher is dispatching, once
+    // unregistered the observers are no longer invoked and can be deleted
+
+    for ( int i = 0; i < 100; ++i )
+    {
+        NotificationRecorder* observer = new NotificationRecorder();
+
+        Notifier::registerObserver( Notifications::MARKER_POSITION_REACHED, observer );
+        std::this_thread::sleep_for( std::chrono::microseconds( 50 ));
+        Notifier::unregisterObserver( Notifications::MARKER_POSITION_REACHED, observer );
+
+        delete observer;
+    }
+    running.store( false );
+    renderThread.join();
+
+    AudioEngineProps::isRendering.store( false );
+    Notifier::stopDispatcher();
+
+    EXPECT_FALSE( recorder->types.empty() ) << "expected the remaining observer to have been dispatched to";
+
+    Notifier::unregisterObserver( Notifications::MARKER_POSITION_REACHED, recorder );
+    delete recorder;
+
+    EXPECT_TRUE( Notifier::_observerMap.find( Notifications::MARKER_POSITION_REACHED ) == Notifier::_observerMap.end() )
+        << "expected the notification type to have been removed once it has no observers left";
+}
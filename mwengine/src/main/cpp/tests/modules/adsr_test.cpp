@@ -272,6 +272,54 @@ TEST( ADSR, ApplyOnLiveEvent ) {
     delete instrument;
 }
 
+TEST( ADSR, ApplyOnMultipleChannels )
+{
+    float HALF_PHASE = 0.5f;
+
+    int bufferLength = 8;
+    SynthInstrument* instrument = new SynthInstrument();
+    BaseSynthEvent* synthEvent  = new BaseSynthEvent( 440.0f, instrument );
+    synthEvent->setEventLength( bufferLength );
+
+    ADSR* adsr = new ADSR();
+    adsr->setSustainLevel( HALF_PHASE );
+    adsr->setDurations( 2, 2, 8, 8 );
+
+    // release the event two samples before the release phase starts, the first samples
+    // of the buffer hold the last envelope value while the remainder is being released
+
+    synthEvent->play();
+    synthEvent->stop();
+
+    synthEvent->cachedProps.envelope       = HALF_PHASE;
+    synthEvent->cachedProps.releaseLevel   = HALF_PHASE;
+    synthEvent->cachedProps.envelopeOffset = adsr->getReleaseStartOffset() - 2;
+
+    AudioBuffer* inputBuffer = new AudioBuffer( 2, 4 );
+
+    for ( int c = 0; c < inputBuffer->amountOfChannels; ++c ) {
+        for ( int i = 0; i < inputBuffer->bufferSize; ++i )
+            inputBuffer->getBufferForChannel( c )[ i ] = 1.0;
+    }
+    adsr->apply( inputBuffer, synthEvent, 0 );
+
+    SAMPLE_TYPE* left  = inputBuffer->getBufferForChannel( 0 );
+    SAMPLE_TYPE* right = inputBuffer->getBufferForChannel( 1 );
+
+    EXPECT_FLOAT_EQ( HALF_PHASE, left[ 0 ] ) << "expected the last envelope to have been held";
+    EXPECT_FLOAT_EQ( 0.4375, left[ 3 ] )     << "expected the envelope to have been released";
+
+    for ( int i = 0; i < inputBuffer->bufferSize; ++i ) {
+        EXPECT_FLOAT_EQ( left[ i ], right[ i ] )
+            << "expected all channels to have been enveloped from the same starting amplitude at index " << i;
+    }
+
+    delete adsr;
+    delete inputBuffer;
+    delete synthEvent;
+    delete instrument;
+}
+
 TEST( ADSR, LastEnvelope )
 {
     float HALF_PHASE    = 0.5f;
@@ -0,0 +1,42 @@
+#include <modules/arpeggiator.h>
+
+TEST( Arpeggiator, PeekAmount )
+{
+    Arpeggiator* arpeggiator = new Arpeggiator();
+    Arpeggiator* reference   = new Arpeggiator();
+
+    int stepSize = randomInt( 2, 64 );
+
+    arpeggiator->setStepSize( stepSize );
+    arpeggiator->setAmountOfSteps( 4 );
+    arpeggiator->cloneProperties( reference ); // applies the properties onto the reference
+
+    EXPECT_EQ( stepSize, arpeggiator->getSamplesUntilStep() )
+        << "expected the full step size to remain before the first step";
+
+    for ( int i = 0; i < 10; ++i )
+    {
+        int amount = arpeggiator->getSamplesUntilStep();
+
+        // advancing by the remaining amount should equal as many individual peeks
+
+        bool stepped = false;
+        for ( int j = 0; j < amount; ++j )
+            stepped = reference->peek();
+
+        EXPECT_TRUE( stepped );
+        EXPECT_TRUE( arpeggiator->peek( amount ));
+
+        EXPECT_EQ( reference->getStep(), arpeggiator->getStep() );
+        EXPECT_EQ( reference->getBufferPosition(), arpeggiator->getBufferPosition() );
+    }
+
+    // advancing by less than the remaining amount should not step
+
+    EXPECT_FALSE( arpeggiator->peek( stepSize - 1 ));
+    EXPECT_EQ( 1, arpeggiator->getSamplesUntilStep() );
+    EXPECT_TRUE( arpeggiator->peek( 1 ));
+
+    delete arpeggiator;
+    delete reference;
+}
@@ -127,3 +127,42 @@ TEST( RingBuffer, Flush )
     }
     delete buffer;
 }
+
+TEST( RingBuffer, SetBufferLength )
+{
+    int capacity = randomInt( 4, 256 );
+    RingBuffer* buffer = new RingBuffer( capacity );
+
+    for ( int i = 0; i < capacity; ++i ) {
+        buffer->enqueue( randomSample( -1.0, 1.0 ));
+    }
+
+    int length = capacity / 2;
+    buffer->setBufferLength( length );
+
+    EXPECT_EQ( length, buffer->getBufferLength() )
+        << "expected ring buffer length to have updated";
+
+    EXPECT_EQ( capacity, buffer->getCapacity() )
+        << "expected ring buffer capacity to remain unchanged";
+
+    // ensure the buffer wraps at its new length and its contents were flushed
+
+    for ( int i = 0; i < length; ++i ) {
+        buffer->enqueue(( SAMPLE_TYPE ) i );
+    }
+
+    for ( int i = 0; i < length; ++i ) {
+        EXPECT_EQ(( SAMPLE_TYPE ) i, buffer->dequeue() )
+            << "expected ring buffer to wrap at its updated length";
+    }
+
+    // ensure the length cannot exceed the capacity
+
+    buffer->setBufferLength( capacity * 2 );
+
+    EXPECT_EQ( capacity, buffer->getBufferLength() )
+        << "expected ring buffer length not to exceed its capacity";
+
+    delete buffer;
+}
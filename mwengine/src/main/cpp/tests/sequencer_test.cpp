@@ -4,6 +4,7 @@
 #include "../instruments/baseinstrument.h"
 #include "../events/basecacheableaudioevent.h"
 #include "../events/synthevent.h"
+#include "../processors/baseprocessor.h"
 
 TEST( Sequencer, InstrumentRegistration )
 {
@@ -71,22 +72,22 @@ TEST( Sequencer, GetAudioEvents )
     EXPECT_EQ( 3, channels->size() )
         << "expected to receive all AudioChannels";
 
-    EXPECT_EQ( 1, channels->at( 0 )->audioEvents.size() )
+    EXPECT_EQ( 1, instrument1->audioChannel->audioEvents.size() )
         << "expected AudioChannel 1 to contain 1 audio event";
 
-    EXPECT_EQ( 1, channels->at( 1 )->audioEvents.size() )
+    EXPECT_EQ( 1, instrument2->audioChannel->audioEvents.size() )
         << "expected AudioChannel 2 to contain 1 audio event";
 
-    EXPECT_EQ( 1, channels->at( 2 )->audioEvents.size() )
+    EXPECT_EQ( 1, instrument3->audioChannel->audioEvents.size() )
         << "expected AudioChannel 3 to contain 1 audio event";
 
-    ASSERT_TRUE( channels->at( 0 )->audioEvents.at( 0 ) == audioEvent1 )
+    ASSERT_TRUE( instrument1->audioChannel->audioEvents.at( 0 ) == audioEvent1 )
         << "expected to have collected event for AudioChannel 1";
 
-    ASSERT_TRUE( channels->at( 1 )->audioEvents.at( 0 ) == audioEvent2 )
+    ASSERT_TRUE( instrument2->audioChannel->audioEvents.at( 0 ) == audioEvent2 )
         << "expected to have collected event for AudioChannel 2";
 
-    ASSERT_TRUE( channels->at( 2 )->audioEvents.at( 0 ) == audioEvent3 )
+    ASSERT_TRUE( instrument3->audioChannel->audioEvents.at( 0 ) == audioEvent3 )
         << "expected to have collected event for AudioChannel 3";
 
     // test 2 : expect 2 events (1st event sampleEnd is within current range,
@@ -96,22 +97,22 @@ TEST( Sequencer, GetAudioEvents )
     startOffset = bufferSize;
     Sequencer::getAudioEvents( channels, startOffset, bufferSize, true, true );
 
-    EXPECT_EQ( 3, channels->size() )
-        << "expected to receive all AudioChannels";
+    EXPECT_EQ( 2, channels->size() )
+        << "expected to receive only the AudioChannels with events (AudioChannel 3 is omitted)";
 
-    EXPECT_EQ( 1, channels->at( 0 )->audioEvents.size() )
+    EXPECT_EQ( 1, instrument1->audioChannel->audioEvents.size() )
         << "expected AudioChannel 1 to contain 1 audio event";
 
-    EXPECT_EQ( 1, channels->at( 1 )->audioEvents.size() )
+    EXPECT_EQ( 1, instrument2->audioChannel->audioEvents.size() )
         << "expected AudioChannel 2 to contain 1 audio event";
 
-    EXPECT_EQ( 0, channels->at( 2 )->audioEvents.size() )
+    EXPECT_EQ( 0, instrument3->audioChannel->audioEvents.size() )
         << "expected AudioChannel 3 to contain no events";
 
-    ASSERT_TRUE( channels->at( 0 )->audioEvents.at( 0 ) == audioEvent1 )
+    ASSERT_TRUE( instrument1->audioChannel->audioEvents.at( 0 ) == audioEvent1 )
         << "expected to have collected event for AudioChannel 1";
 
-    ASSERT_TRUE( channels->at( 1 )->audioEvents.at( 0 ) == audioEvent2 )
+    ASSERT_TRUE( instrument2->audioChannel->audioEvents.at( 0 ) == audioEvent2 )
         << "expected to have collected event for AudioChannel 2";
 
     // test 3 : expect 1 event (1st event sampleEnd is outside of current range,
@@ -120,19 +121,19 @@ TEST( Sequencer, GetAudioEvents )
     startOffset = bufferSize * 2;
     Sequencer::getAudioEvents( channels, startOffset, bufferSize, true, true );
 
-    EXPECT_EQ( 3, channels->size() )
-        << "expected to receive all AudioChannels";
+    EXPECT_EQ( 1, channels->size() )
+        << "expected to receive only the AudioChannel with events (AudioChannels 1 and 3 are omitted)";
 
-    EXPECT_EQ( 0, channels->at( 0 )->audioEvents.size() )
+    EXPECT_EQ( 0, instrument1->audioChannel->audioEvents.size() )
         << "expected to have received 0 events for AudioChannel 1";
 
-    EXPECT_EQ( 1, channels->at( 1 )->audioEvents.size() )
+    EXPECT_EQ( 1, instrument2->audioChannel->audioEvents.size() )
         << "expected to have received 1 events for AudioChannel 2";
 
-    EXPECT_EQ( 0, channels->at( 2 )->audioEvents.size() )
+    EXPECT_EQ( 0, instrument3->audioChannel->audioEvents.size() )
         << "expected to have received no events for AudioChannel 3";
 
-    ASSERT_TRUE( channels->at( 1 )->audioEvents.at( 0 ) == audioEvent2 )
+    ASSERT_TRUE( instrument2->audioChannel->audioEvents.at( 0 ) == audioEvent2 )
         << "expected to have collected event for AudioChannel 2";
 
     // test 4 : expect no event (1st event sampleEnd is outside of current range,
@@ -141,16 +142,16 @@ TEST( Sequencer, GetAudioEvents )
     startOffset = bufferSize * 3;
     Sequencer::getAudioEvents( channels, startOffset, bufferSize, true, true );
 
-    EXPECT_EQ( 3, channels->size() )
-        << "expected to receive all AudioChannels";
+    EXPECT_EQ( 0, channels->size() )
+        << "expected to receive no AudioChannels (none have events)";
 
-    EXPECT_EQ( 0, channels->at( 0 )->audioEvents.size() )
+    EXPECT_EQ( 0, instrument1->audioChannel->audioEvents.size() )
         << "expected to have no collected events for AudioChannel 1";
 
-    EXPECT_EQ( 0, channels->at( 1 )->audioEvents.size() )
+    EXPECT_EQ( 0, instrument2->audioChannel->audioEvents.size() )
         << "expected to have no collected events for AudioChannel 2";
 
-    EXPECT_EQ( 0, channels->at( 2 )->audioEvents.size() )
+    EXPECT_EQ( 0, instrument3->audioChannel->audioEvents.size() )
         << "expected to have no collected events for AudioChannel 3";
 
     // free allocated memory
@@ -192,7 +193,7 @@ TEST( Sequencer, GetAudioEventsAtBoundaries )
     int startOffset = audioEvent->getEventEnd();
     Sequencer::getAudioEvents( channels, startOffset, bufferSize, true, true );
 
-    EXPECT_EQ( 1, channels->at( 0 )->audioEvents.size() )
+    EXPECT_EQ( 1, instrument->audioChannel->audioEvents.size() )
         << "expected to have collected 1 audio event";
 
     // test 2 : ensure no events are collected when the requested range starts beyond the sample end offset
@@ -201,7 +202,7 @@ TEST( Sequencer, GetAudioEventsAtBoundaries )
     startOffset = audioEvent->getEventEnd() + 1;
     Sequencer::getAudioEvents( channels, startOffset, bufferSize, true, true );
 
-    EXPECT_EQ( 0, channels->at( 0 )->audioEvents.size() )
+    EXPECT_EQ( 0, instrument->audioChannel->audioEvents.size() )
         << "expected to have collected no events";
 
     // test 3 : ensure no events are collected when the requested range end is 1 sample before the sample start offset
@@ -210,7 +211,7 @@ TEST( Sequencer, GetAudioEventsAtBoundaries )
     startOffset = 0;
     Sequencer::getAudioEvents( channels, startOffset, bufferSize, true, true );
 
-    EXPECT_EQ( 0, channels->at( 0 )->audioEvents.size() )
+    EXPECT_EQ( 0, instrument->audioChannel->audioEvents.size() )
         << "expected to have collected no events";
 
     // test 4 : collect audio event when the requested range end is 1 sample before the sample end offset
@@ -219,7 +220,7 @@ TEST( Sequencer, GetAudioEventsAtBoundaries )
     startOffset = 1;
     Sequencer::getAudioEvents( channels, startOffset, bufferSize, true, true );
 
-    EXPECT_EQ( 1, channels->at( 0 )->audioEvents.size() )
+    EXPECT_EQ( 1, instrument->audioChannel->audioEvents.size() )
         << "expected to have collected 1 audio event";
 
     // free allocated memory
@@ -268,16 +269,19 @@ TEST( Sequencer, GetLiveEvents )
 
     Sequencer::getAudioEvents( channels, 0, bufferSize, true, true );
 
-    EXPECT_EQ( 0, channels->at( 0 )->audioEvents.size() )
+    EXPECT_EQ( 1, channels->size() )
+        << "expected to receive only the AudioChannel with live events";
+
+    EXPECT_EQ( 0, instrument1->audioChannel->audioEvents.size() )
         << "expected to have collected no sequenced Events for AudioChannel 1 (Sequencer wasn't playing)";
 
-    EXPECT_EQ( 0, channels->at( 0 )->liveEvents.size() )
+    EXPECT_EQ( 0, instrument1->audioChannel->liveEvents.size() )
         << "expected to have collected no live Events for AudioChannel 1 (none were existent for its instrument)";
 
-    EXPECT_EQ( 0, channels->at( 1 )->audioEvents.size() )
+    EXPECT_EQ( 0, instrument2->audioChannel->audioEvents.size() )
         << "expected to have collected no sequenced Events for AudioChannel 2 (none were existent for its instrument)";
 
-    EXPECT_EQ( 1, channels->at( 1 )->liveEvents.size() )
+    EXPECT_EQ( 1, instrument2->audioChannel->liveEvents.size() )
         << "expected to have collected 1 live Event for AudioChannel 2";
 
     // test 2 : collect live and sequenced events (Sequencer is now running)
@@ -285,32 +289,32 @@ TEST( Sequencer, GetLiveEvents )
     Sequencer::playing = true;
     Sequencer::getAudioEvents( channels, 0, bufferSize, true, true );
 
-    EXPECT_EQ( 1, channels->at( 0 )->audioEvents.size() )
+    EXPECT_EQ( 1, instrument1->audioChannel->audioEvents.size() )
         << "expected to have collected 1 sequenced Events for AudioChannel 1";
 
-    EXPECT_EQ( 0, channels->at( 0 )->liveEvents.size() )
+    EXPECT_EQ( 0, instrument1->audioChannel->liveEvents.size() )
         << "expected to have collected no live Events for AudioChannel 1 (none were existent for its instrument)";
 
-    EXPECT_EQ( 0, channels->at( 1 )->audioEvents.size() )
+    EXPECT_EQ( 0, instrument2->audioChannel->audioEvents.size() )
         << "expected to have collected no sequenced Events for AudioChannel 2 (none were existent for its instrument)";
 
-    EXPECT_EQ( 1, channels->at( 1 )->liveEvents.size() )
+    EXPECT_EQ( 1, instrument2->audioChannel->liveEvents.size() )
         << "expected to have collected 1 live Event for AudioChannel 2";
 
     // test 3 : collect only sequenced events (Sequencer is now running but no live events are requested)
 
     Sequencer::getAudioEvents( channels, 0, bufferSize, false, true );
 
-    EXPECT_EQ( 1, channels->at( 0 )->audioEvents.size() )
+    EXPECT_EQ( 1, instrument1->audioChannel->audioEvents.size() )
         << "expected to have collected 1 sequenced Events for AudioChannel 1";
 
-    EXPECT_EQ( 0, channels->at( 0 )->liveEvents.size() )
+    EXPECT_EQ( 0, instrument1->audioChannel->liveEvents.size() )
         << "expected to have collected no live Events for AudioChannel 1 (none were existent for its instrument and none were requested)";
 
-    EXPECT_EQ( 0, channels->at( 1 )->audioEvents.size() )
+    EXPECT_EQ( 0, instrument2->audioChannel->audioEvents.size() )
         << "expected to have collected no sequenced Events for AudioChannel 2 (nore were existent for its instrument)";
 
-    EXPECT_EQ( 0, channels->at( 1 )->audioEvents.size() )
+    EXPECT_EQ( 0, instrument2->audioChannel->audioEvents.size() )
         << "expected to have collected no live events for AudioChannel 2 (wasn't requested)";
 
     // free allocated memory
@@ -347,53 +351,53 @@ TEST( Sequencer, GetEventsFlushChannel )
     Sequencer::playing = true;
     Sequencer::getAudioEvents( channels, audioEvent2->getEventStart(), bufferSize, true, true );
 
-    EXPECT_EQ( 1, channels->at( 0 )->audioEvents.size() )
+    EXPECT_EQ( 1, instrument->audioChannel->audioEvents.size() )
         << "expected to have collected 1 event for AudioChannel 1";
 
-    ASSERT_TRUE( channels->at( 0 )->audioEvents.at( 0 ) == audioEvent2 )
+    ASSERT_TRUE( instrument->audioChannel->audioEvents.at( 0 ) == audioEvent2 )
         << "expected to have retrieved the second AudioEvent";
 
     Sequencer::getAudioEvents( channels, 0, bufferSize, true, true );
 
-    EXPECT_EQ( 1, channels->at( 0 )->audioEvents.size() )
+    EXPECT_EQ( 1, instrument->audioChannel->audioEvents.size() )
         << "expected to have collected 1 event for AudioChannel 1";
 
-    ASSERT_TRUE( channels->at( 0 )->audioEvents.at( 0 ) == audioEvent1 )
+    ASSERT_TRUE( instrument->audioChannel->audioEvents.at( 0 ) == audioEvent1 )
         << "expected to have retrieved the first AudioEvent";
 
     // test 2 : retrieve events without flushing of channel contents
     // first ensure channels have been flushed of previous test contents
-    channels->at( 0 )->reset();
+    instrument->audioChannel->reset();
 
     Sequencer::getAudioEvents( channels, audioEvent2->getEventStart(), bufferSize, true, false );
 
-    EXPECT_EQ( 1, channels->at( 0 )->audioEvents.size() )
+    EXPECT_EQ( 1, instrument->audioChannel->audioEvents.size() )
         << "expected to have collected 1 event for AudioChannel 1";
 
-    ASSERT_TRUE( channels->at( 0 )->audioEvents.at( 0 ) == audioEvent2 )
+    ASSERT_TRUE( instrument->audioChannel->audioEvents.at( 0 ) == audioEvent2 )
         << "expected to have retrieved the second AudioEvent";
 
     Sequencer::getAudioEvents( channels, 0, bufferSize, true, false );
 
-    EXPECT_EQ( 2, channels->at( 0 )->audioEvents.size() )
+    EXPECT_EQ( 2, instrument->audioChannel->audioEvents.size() )
         << "expected to have collected 2 events for AudioChannel 1 (flushing was disabled)";
 
-    ASSERT_TRUE( channels->at( 0 )->audioEvents.at( 0 ) == audioEvent2 )
+    ASSERT_TRUE( instrument->audioChannel->audioEvents.at( 0 ) == audioEvent2 )
         << "expected to have retrieved the second AudioEvent";
 
-    ASSERT_TRUE( channels->at( 0 )->audioEvents.at( 1 ) == audioEvent1 )
+    ASSERT_TRUE( instrument->audioChannel->audioEvents.at( 1 ) == audioEvent1 )
         << "expected to have retrieved the first AudioEvent by merging new request into non flushed channel";
 
     // verify audioEvent1 will not be re-added to a non flushed channel
     Sequencer::getAudioEvents( channels, 0, bufferSize, true, false );
 
-    EXPECT_EQ( 2, channels->at( 0 )->audioEvents.size() )
+    EXPECT_EQ( 2, instrument->audioChannel->audioEvents.size() )
         << "expected to have collected 2 events for AudioChannel 1 (while flushing was disabled, the Sequencer deduplicates)";
 
-    ASSERT_TRUE( channels->at( 0 )->audioEvents.at( 0 ) == audioEvent2 )
+    ASSERT_TRUE( instrument->audioChannel->audioEvents.at( 0 ) == audioEvent2 )
         << "expected to have retrieved the second AudioEvent in previous request";
 
-    ASSERT_TRUE( channels->at( 0 )->audioEvents.at( 1 ) == audioEvent1 )
+    ASSERT_TRUE( instrument->audioChannel->audioEvents.at( 1 ) == audioEvent1 )
         << "expected to have retrieved the first AudioEvent in previous request";
 
     // free allocated memory
@@ -430,10 +434,10 @@ TEST( Sequencer, RemoveRemovalEnqueuedSequencedEvents )
 
     Sequencer::getAudioEvents( channels, 0, bufferSize, true, true );
 
-    EXPECT_EQ( 1, channels->at( 0 )->audioEvents.size() )
+    EXPECT_EQ( 1, instrument1->audioChannel->audioEvents.size() )
         << "expected to have collected 1 event for AudioChannel 1";
 
-    EXPECT_EQ( 1, channels->at( 1 )->audioEvents.size() )
+    EXPECT_EQ( 1, instrument2->audioChannel->audioEvents.size() )
         << "expected to have collected 1 event for AudioChannel 2";
 
     // test 2 : enqueue event 2 for removal
@@ -445,10 +449,10 @@ TEST( Sequencer, RemoveRemovalEnqueuedSequencedEvents )
 
     Sequencer::getAudioEvents( channels, 0, bufferSize, true, true );
 
-    EXPECT_EQ( 1, channels->at( 0 )->audioEvents.size() )
+    EXPECT_EQ( 1, instrument1->audioChannel->audioEvents.size() )
         << "expected to have collected 1 event for AudioChannel 1";
 
-    EXPECT_EQ( 0, channels->at( 1 )->audioEvents.size() )
+    EXPECT_EQ( 0, instrument2->audioChannel->audioEvents.size() )
         << "expected to have collected no events for AudioChannel 2";
 
     ASSERT_FALSE( instrument2->hasEvents() )
@@ -463,10 +467,10 @@ TEST( Sequencer, RemoveRemovalEnqueuedSequencedEvents )
 
     Sequencer::getAudioEvents( channels, 0, bufferSize, true, true );
 
-    EXPECT_EQ( 0, channels->at( 0 )->audioEvents.size() )
+    EXPECT_EQ( 0, instrument1->audioChannel->audioEvents.size() )
         << "expected to have collected no events for AudioChannel 1";
 
-    EXPECT_EQ( 0, channels->at( 1 )->audioEvents.size() )
+    EXPECT_EQ( 0, instrument2->audioChannel->audioEvents.size() )
         << "expected to have collected no events for AudioChannel 2";
 
     ASSERT_FALSE( instrument1->hasEvents() )
@@ -511,10 +515,10 @@ TEST( Sequencer, RemoveRemovalEnqueuedLiveEvents )
 
     Sequencer::getAudioEvents( channels, 0, bufferSize, true, true );
 
-    EXPECT_EQ( 1, channels->at( 0 )->liveEvents.size() )
+    EXPECT_EQ( 1, instrument1->audioChannel->liveEvents.size() )
         << "expected to have collected 1 live event for AudioChannel 1";
 
-    EXPECT_EQ( 1, channels->at( 1 )->liveEvents.size() )
+    EXPECT_EQ( 1, instrument2->audioChannel->liveEvents.size() )
         << "expected to have collected 1 live event for AudioChannel 2";
 
     // test 2 : enqueue event 2 for removal
@@ -526,10 +530,10 @@ TEST( Sequencer, RemoveRemovalEnqueuedLiveEvents )
 
     Sequencer::getAudioEvents( channels, 0, bufferSize, true, true );
 
-    EXPECT_EQ( 1, channels->at( 0 )->liveEvents.size() )
+    EXPECT_EQ( 1, instrument1->audioChannel->liveEvents.size() )
         << "expected to have collected 1 live event for AudioChannel 1";
 
-    EXPECT_EQ( 0, channels->at( 1 )->liveEvents.size() )
+    EXPECT_EQ( 0, instrument2->audioChannel->liveEvents.size() )
         << "expected to have collected no live events for AudioChannel 2";
 
     ASSERT_FALSE( instrument2->hasLiveEvents() )
@@ -544,10 +548,10 @@ TEST( Sequencer, RemoveRemovalEnqueuedLiveEvents )
 
     Sequencer::getAudioEvents( channels, 0, bufferSize, true, true );
 
-    EXPECT_EQ( 0, channels->at( 0 )->liveEvents.size() )
+    EXPECT_EQ( 0, instrument1->audioChannel->liveEvents.size() )
         << "expected to have collected no live events for AudioChannel 1";
 
-    EXPECT_EQ( 0, channels->at( 1 )->liveEvents.size() )
+    EXPECT_EQ( 0, instrument2->audioChannel->liveEvents.size() )
         << "expected to have collected no live events for AudioChannel 2";
 
     ASSERT_FALSE( instrument1->hasLiveEvents() )
@@ -592,10 +596,10 @@ TEST( Sequencer, RemoveDeletableLiveEvents )
 
     Sequencer::getAudioEvents( channels, 0, bufferSize, true, true );
 
-    EXPECT_EQ( 1, channels->at( 0 )->liveEvents.size() )
+    EXPECT_EQ( 1, instrument1->audioChannel->liveEvents.size() )
         << "expected to have collected 1 live event for AudioChannel 1";
 
-    EXPECT_EQ( 1, channels->at( 1 )->liveEvents.size() )
+    EXPECT_EQ( 1, instrument2->audioChannel->liveEvents.size() )
         << "expected to have collected 1 live event for AudioChannel 2";
 
     // test 2 : enqueue event 2 for removal
@@ -607,10 +611,10 @@ TEST( Sequencer, RemoveDeletableLiveEvents )
 
     Sequencer::getAudioEvents( channels, 0, bufferSize, true, true );
 
-    EXPECT_EQ( 1, channels->at( 0 )->liveEvents.size() )
+    EXPECT_EQ( 1, instrument1->audioChannel->liveEvents.size() )
         << "expected to have collected 1 live event for AudioChannel 1";
 
-    EXPECT_EQ( 0, channels->at( 1 )->liveEvents.size() )
+    EXPECT_EQ( 0, instrument2->audioChannel->liveEvents.size() )
         << "expected to have collected no live events for AudioChannel 2";
 
     ASSERT_FALSE( instrument2->hasLiveEvents() )
@@ -625,10 +629,10 @@ TEST( Sequencer, RemoveDeletableLiveEvents )
 
     Sequencer::getAudioEvents( channels, 0, bufferSize, true, true );
 
-    EXPECT_EQ( 0, channels->at( 0 )->liveEvents.size() )
+    EXPECT_EQ( 0, instrument1->audioChannel->liveEvents.size() )
         << "expected to have collected no live events for AudioChannel 1";
 
-    EXPECT_EQ( 0, channels->at( 1 )->liveEvents.size() )
+    EXPECT_EQ( 0, instrument2->audioChannel->liveEvents.size() )
         << "expected to have collected no live events for AudioChannel 2";
 
     ASSERT_FALSE( instrument1->hasLiveEvents() )
@@ -754,6 +758,68 @@ TEST( Sequencer, IgnoreEventsForMutedChannels )
     Sequencer::playing = false;
 }
 
+TEST( Sequencer, OmitIdleChannels )
+{
+    // setup sequencer
+    Sequencer::playing = true;
+
+    std::vector<AudioChannel*>* channels = new std::vector<AudioChannel*>();
+    BaseInstrument* instrument1 = new BaseInstrument();
+    BaseInstrument* instrument2 = new BaseInstrument();
+    BaseInstrument* instrument3 = new BaseInstrument();
+
+    AudioEngine::samples_per_bar     = 88200;
+    AudioEngine::min_buffer_position = 0;
+    AudioEngine::max_buffer_position = AudioEngine::samples_per_bar - 1;
+    int bufferSize                   = AudioEngine::samples_per_bar / 8;
+
+    // audioEvent1 start: 0 end: 11024, audioEvent2 start: 77175 end: 88199
+    // instrument3 has no events but an active processing chain
+
+    BaseAudioEvent* audioEvent1 = enqueuedAudioEvent( instrument1, bufferSize, 0, 16, 0 );
+    BaseAudioEvent* audioEvent2 = enqueuedAudioEvent( instrument2, bufferSize, 0, 16, 14 );
+    BaseProcessor* processor    = new BaseProcessor();
+
+    instrument3->audioChannel->processingChain->addProcessor( processor );
+
+    Sequencer::getAudioEvents( channels, 0, bufferSize, true, true );
+
+    EXPECT_EQ( 2, channels->size() )
+        << "expected the channel without events nor processors to have been omitted";
+
+    EXPECT_TRUE( channels->at( 0 ) == instrument1->audioChannel && channels->at( 1 ) == instrument3->audioChannel )
+        << "expected the channel with events and the channel with an active processing chain to have been gathered";
+
+    EXPECT_EQ( 3, Sequencer::audibleChannels )
+        << "expected all unmuted channels to be taken into account for the mixing headroom";
+
+    // collect the events at the loop end and those at the loop start
+
+    int bufferPosition = AudioEngine::max_buffer_position - 99;
+
+    Sequencer::getAudioEvents( channels, bufferPosition, bufferSize, true, true );
+    Sequencer::getAudioEvents( channels, AudioEngine::min_buffer_position, bufferSize - 100, false, false );
+
+    EXPECT_EQ( 3, channels->size() )
+        << "expected each channel to have been gathered once when collecting at the loop start";
+
+    EXPECT_TRUE( channels->at( 0 ) == instrument2->audioChannel && channels->at( 2 ) == instrument1->audioChannel )
+        << "expected the channel with events at the loop start to have been gathered after the loop end";
+
+    // free allocated memory
+
+    delete channels;
+    delete processor;
+    delete audioEvent1;
+    delete audioEvent2;
+    delete instrument1;
+    delete instrument2;
+    delete instrument3;
+
+    // reset Sequencer
+    Sequencer::playing = false;
+}
+
 TEST( Sequencer, EventClearing )
 {
     BaseInstrument* instrument1 = new BaseInstrument();
@@ -796,3 +862,88 @@ TEST( Sequencer, EventClearing )
     delete instrument1;
     delete instrument2;
 }
+
+TEST( Sequencer, RetainEventsAcrossContiguousBuffers )
+{
+    std::vector<AudioChannel*>* channels = new std::vector<AudioChannel*>();
+    BaseInstrument* instrument = new BaseInstrument();
+    AudioChannel* channel      = instrument->audioChannel;
+
+    Sequencer::playing = true;
+    int bufferSize     = 64;
+
+    // event 1 spans many buffers, event 2 starts at the fourth buffer
+
+    BaseAudioEvent* audioEvent1 = new BaseAudioEvent( instrument );
+    audioEvent1->setEventStart( 0 );
+    audioEvent1->setEventLength( bufferSize * 10 );
+    audioEvent1->addToSequencer();
+
+    BaseAudioEvent* audioEvent2 = new BaseAudioEvent( instrument );
+    audioEvent2->setEventStart( bufferSize * 3 );
+    audioEvent2->setEventLength( bufferSize );
+    audioEvent2->addToSequencer();
+
+    // test 1 : the long event is collected and retained while no event starts or ends
+
+    Sequencer::getAudioEvents( channels, 0, bufferSize, false, true );
+
+    ASSERT_EQ( 1, channel->audioEvents.size() ) << "expected the first event to be collected";
+    EXPECT_TRUE( channel->schedule.valid ) << "expected the collected events to be retainable";
+    EXPECT_EQ( bufferSize * 3, channel->schedule.nextEventStart ) << "expected the start of the next event to be scheduled";
+
+    Sequencer::getAudioEvents( channels, bufferSize, bufferSize, false, true );
+
+    ASSERT_EQ( 1, channel->audioEvents.size() ) << "expected the first event to be retained";
+    EXPECT_EQ( bufferSize * 2 - 1, channel->schedule.rangeEnd ) << "expected the schedule to have advanced";
+
+    // test 2 : adding an event within the range invalidates the retained events
+
+    BaseAudioEvent* audioEvent3 = new BaseAudioEvent( instrument );
+    audioEvent3->setEventStart( bufferSize * 2 + 1 );
+    audioEvent3->setEventLength( bufferSize );
+    audioEvent3->addToSequencer();
+
+    Sequencer::getAudioEvents( channels, bufferSize * 2, bufferSize, false, true );
+
+    EXPECT_EQ( 2, channel->audioEvents.size() ) << "expected the added event to be collected";
+
+    // test 3 : an event starting within the range is collected
+
+    Sequencer::getAudioEvents( channels, bufferSize * 3, bufferSize, false, true );
+
+    EXPECT_EQ( 3, channel->audioEvents.size() ) << "expected the scheduled event to be collected";
+
+    // test 4 : disabling a retained event removes it from the collected events
+
+    audioEvent1->setEnabled( false );
+    Sequencer::getAudioEvents( channels, bufferSize * 4, bufferSize, false, true );
+
+    EXPECT_EQ( 0, channel->audioEvents.size() ) << "expected the disabled event to be omitted";
+    EXPECT_FALSE( channel->schedule.valid ) << "expected omitted disabled events to prevent retaining the collected events";
+
+    // test 5 : a non-contiguous range (e.g. seeking) requeries the events
+
+    Sequencer::getAudioEvents( channels, bufferSize * 3, bufferSize, false, true );
+
+    EXPECT_EQ( 2, channel->audioEvents.size() ) << "expected the events overlapping the sought range to be collected";
+
+    Sequencer::getAudioEvents( channels, bufferSize * 20, bufferSize, false, true );
+
+    EXPECT_EQ( 0, channel->audioEvents.size() ) << "expected no events beyond the last event";
+
+    // test 6 : stopping the sequencer flushes the collected events
+
+    Sequencer::getAudioEvents( channels, 0, bufferSize, false, true );
+    Sequencer::playing = false;
+    Sequencer::getAudioEvents( channels, bufferSize, bufferSize, false, true );
+
+    EXPECT_EQ( 0, channel->audioEvents.size() ) << "expected no events to be collected when the sequencer is stopped";
+    EXPECT_FALSE( channel->schedule.valid ) << "expected the schedule to be invalidated when the sequencer is stopped";
+
+    delete channels;
+    delete audioEvent1;
+    delete audioEvent2;
+    delete audioEvent3;
+    delete instrument;
+}
@@ -0,0 +1,58 @@
+#include "../../utilities/bufferpool.h"
+#include "../../instruments/synthinstrument.h"
+#include "../../events/basesynthevent.h"
+#include <definitions/waveforms.h>
+
+TEST( BufferPool, ReserveAndAcquireRingBuffers )
+{
+    BufferPool::reserveRingBuffers( 2 );
+
+    int available = BufferPool::getAvailableRingBuffers();
+    ASSERT_GE( available, 2 ) << "expected the requested amount of ring buffers to have been reserved";
+
+    RingBuffer* ringBuffer1 = BufferPool::acquireRingBuffer();
+    RingBuffer* ringBuffer2 = BufferPool::acquireRingBuffer();
+
+    ASSERT_FALSE( ringBuffer1 == nullptr );
+    ASSERT_FALSE( ringBuffer2 == nullptr );
+    ASSERT_FALSE( ringBuffer1 == ringBuffer2 ) << "expected a ring buffer to be acquired only once";
+
+    EXPECT_EQ( available - 2, BufferPool::getAvailableRingBuffers() );
+    EXPECT_EQ( AudioEngineProps::SAMPLE_RATE / BufferPool::RING_BUFFER_MIN_FREQUENCY, ringBuffer1->getCapacity() );
+
+    BufferPool::releaseRingBuffer( ringBuffer1 );
+    BufferPool::releaseRingBuffer( ringBuffer2 );
+
+    EXPECT_EQ( available, BufferPool::getAvailableRingBuffers() ) << "expected the ring buffers to have been returned to the pool";
+}
+
+TEST( BufferPool, RingBuffersForSequencedEvents )
+{
+    SynthInstrument* instrument = new SynthInstrument();
+    instrument->getOscillatorProperties( 0 )->setWaveform( WaveForms::KARPLUS_STRONG );
+
+    BufferPool::reserveRingBuffers( 1 );
+    int available = BufferPool::getAvailableRingBuffers();
+
+    // the ring buffer is assigned on the control thread when the event is added to the sequencer
+
+    BaseSynthEvent* event  = new BaseSynthEvent( 440.f, 0, 1.f, instrument );
+    RingBuffer* ringBuffer = event->ringBuffers[ 0 ].load();
+
+    ASSERT_FALSE( ringBuffer == nullptr ) << "expected a ring buffer to have been assigned to the Karplus-Strong oscillator";
+    EXPECT_EQ( available - 1, BufferPool::getAvailableRingBuffers() );
+
+    // retrieving the ring buffer (as done when rendering) does not acquire another
+
+    EXPECT_EQ( ringBuffer, BufferPool::getRingBufferForEvent( event, 0, 440.f ));
+    EXPECT_EQ(( int )( AudioEngineProps::SAMPLE_RATE / 440.f ), ringBuffer->getBufferLength() );
+    EXPECT_EQ( available - 1, BufferPool::getAvailableRingBuffers() );
+
+    // the ring buffer is returned to the pool upon destruction of the event
+
+    delete event;
+
+    EXPECT_EQ( available, BufferPool::getAvailableRingBuffers() );
+
+    delete instrument;
+}
@@ -0,0 +1,46 @@
+#include "../../utilities/bufferutility.h"
+#include "../../utilities/utils.h"
+
+TEST( BufferUtility, WriteBufferInterleaved )
+{
+    // test mono, stereo and multichannel configurations at buffer sizes that
+    // aren't multiples of the vector width (to validate the remainder is written)
+
+    for ( int amountOfChannels = 1; amountOfChannels <= 3; ++amountOfChannels )
+    {
+        int bufferSize      = randomInt( 17, 67 );
+        float gain          = randomFloat( 0.5f, 1.5f );
+        AudioBuffer* buffer = new AudioBuffer( amountOfChannels, bufferSize );
+
+        // fill with content that exceeds the output range (when using double precision, the
+        // values are not representable as float, validating the order of conversion and gain)
+
+        for ( int c = 0; c < amountOfChannels; ++c ) {
+            SAMPLE_TYPE* channelBuffer = buffer->getBufferForChannel( c );
+            for ( int i = 0; i < bufferSize; ++i ) {
+                channelBuffer[ i ] = ( SAMPLE_TYPE ) randomFloat( -2.f, 2.f ) + ( SAMPLE_TYPE ) 1e-9 * ( i + 1 ) / 3;
+            }
+        }
+
+        int outputSize = bufferSize * amountOfChannels;
+        float* output  = new float[ outputSize + 1 ];
+        output[ outputSize ] = 12345.f; // guard value beyond the writable range
+
+        BufferUtility::writeBufferInterleaved( buffer, output, bufferSize, amountOfChannels, gain );
+
+        for ( int i = 0; i < bufferSize; ++i ) {
+            for ( int c = 0; c < amountOfChannels; ++c ) {
+                float expected = ( float ) capSampleSafe(( float ) buffer->getBufferForChannel( c )[ i ] * gain );
+
+                ASSERT_EQ( expected, output[ i * amountOfChannels + c ])
+                    << "expected interleaved sample " << i << " for channel " << c << " of " << amountOfChannels
+                    << " channel(s) to equal the gain applied, capped source sample";
+            }
+        }
+        EXPECT_EQ( 12345.f, output[ outputSize ])
+            << "expected no samples to be written beyond the output range";
+
+        delete[] output;
+        delete buffer;
+    }
+}
@@ -0,0 +1,152 @@
+#include "../../utilities/compactbuffer.h"
+#include <cmath>
+#include <limits>
+
+// creates a buffer holding values that are exactly representable at half precision
+
+AudioBuffer* createCompactTestBuffer( int amountOfChannels, int bufferSize )
+{
+    AudioBuffer* buffer = new AudioBuffer( amountOfChannels, bufferSize );
+
+    for ( int c = 0; c < amountOfChannels; ++c ) {
+        for ( int i = 0; i < bufferSize; ++i ) {
+            buffer->getBufferForChannel( c )[ i ] = ( SAMPLE_TYPE ) ((( i * 7 + c * 3 ) % 33 ) - 16 ) / 16.0;
+        }
+    }
+    return buffer;
+}
+
+TEST( CompactBuffer, Construction )
+{
+    AudioBuffer* source = createCompactTestBuffer( 2, 100 );
+
+    CompactBuffer* pcm    = new CompactBuffer( source, CompactBuffer::PCM16 );
+    CompactBuffer* half   = new CompactBuffer( source, CompactBuffer::HALF_FLOAT );
+    CompactBuffer* single = new CompactBuffer( source, CompactBuffer::SINGLE_FLOAT );
+
+    EXPECT_EQ( 2,   pcm->amountOfChannels );
+    EXPECT_EQ( 100, pcm->bufferSize );
+    EXPECT_EQ( CompactBuffer::PCM16,        pcm->getStorageType() );
+    EXPECT_EQ( CompactBuffer::HALF_FLOAT,   half->getStorageType() );
+    EXPECT_EQ( CompactBuffer::SINGLE_FLOAT, single->getStorageType() );
+
+    // each channel is padded to an aligned size
+
+    EXPECT_EQ( 2 * 256, pcm->getMemoryUsage() );
+    EXPECT_EQ( 2 * 256, half->getMemoryUsage() );
+    EXPECT_EQ( 2 * 448, single->getMemoryUsage() );
+
+    delete pcm;
+    delete half;
+    delete single;
+    delete source;
+}
+
+TEST( CompactBuffer, DecodeStorageTypes )
+{
+    AudioBuffer* source = createCompactTestBuffer( 2, 67 ); // uneven size to cover the non-vectorized remainder
+
+    // floating point storage of half precision values is lossless, 16-bit integers are
+    // scaled to the peak (1.0) of the source and are within half a quantization step
+
+    int types[ 3 ] = { CompactBuffer::PCM16, CompactBuffer::HALF_FLOAT, CompactBuffer::SINGLE_FLOAT };
+    SAMPLE_TYPE tolerance[ 3 ] = { 0.5 / 32767.0, 0.0, 0.0 };
+
+    for ( int t = 0; t < 3; ++t )
+    {
+        CompactBuffer* compact = new CompactBuffer( source, types[ t ] );
+        AudioBuffer* decoded   = compact->toAudioBuffer();
+
+        ASSERT_EQ( source->amountOfChannels, decoded->amountOfChannels );
+        ASSERT_EQ( source->bufferSize, decoded->bufferSize );
+
+        for ( int c = 0; c < source->amountOfChannels; ++c ) {
+            for ( int i = 0; i < source->bufferSize; ++i ) {
+                SAMPLE_TYPE expected = source->getBufferForChannel( c )[ i ];
+                EXPECT_NEAR( expected, decoded->getBufferForChannel( c )[ i ], tolerance[ t ] )
+                    << "expected decoded sample to match source for storage type " << types[ t ] << " at " << i;
+
+                EXPECT_EQ( decoded->getBufferForChannel( c )[ i ], compact->getSample( c, i ))
+                    << "expected vectorized and per sample decoding to be equal";
+            }
+        }
+        delete decoded;
+        delete compact;
+    }
+    delete source;
+}
+
+TEST( CompactBuffer, PCM16ScalesToPeak )
+{
+    AudioBuffer* source = new AudioBuffer( 1, 8 );
+
+    for ( int i = 0; i < 8; ++i ) {
+        source->getBufferForChannel( 0 )[ i ] = ( SAMPLE_TYPE ) ( i - 4 ) * 0.0001;
+    }
+    CompactBuffer* compact = new CompactBuffer( source, CompactBuffer::PCM16 );
+
+    // a quiet sample retains its resolution
+
+    for ( int i = 0; i < 8; ++i ) {
+        EXPECT_NEAR( source->getBufferForChannel( 0 )[ i ], compact->getSample( 0, i ), 0.0004 / 32767.0 );
+    }
+    delete compact;
+    delete source;
+}
+
+TEST( CompactBuffer, Mix )
+{
+    AudioBuffer* source = createCompactTestBuffer( 1, 37 );
+    CompactBuffer* compact = new CompactBuffer( source, CompactBuffer::HALF_FLOAT );
+
+    SAMPLE_TYPE target[ 30 ];
+    SAMPLE_TYPE volume = 0.5;
+
+    for ( int i = 0; i < 30; ++i ) {
+        target[ i ] = 0.25;
+    }
+
+    // mix from an offset into an offset of the target
+
+    compact->mix( 0, 5, target + 3, 25, volume );
+
+    for ( int i = 0; i < 30; ++i )
+    {
+        SAMPLE_TYPE expected = 0.25;
+
+        if ( i >= 3 && i < 28 )
+            expected += source->getBufferForChannel( 0 )[ i + 2 ] * volume;
+
+        EXPECT_EQ( expected, target[ i ] ) << "expected mixed sample at " << i;
+    }
+    delete compact;
+    delete source;
+}
+
+TEST( CompactBuffer, HalfPrecisionConversion )
+{
+    // exactly representable values
+
+    float values[ 8 ] = { 0.f, -0.f, 1.f, -1.f, 0.5f, 65504.f, 6.103515625e-05f /* smallest normal */, 5.960464477539063e-08f /* smallest subnormal */ };
+
+    for ( int i = 0; i < 8; ++i ) {
+        EXPECT_EQ( values[ i ], CompactBuffer::halfToFloat( CompactBuffer::floatToHalf( values[ i ] )));
+    }
+
+    EXPECT_EQ( 0x3c00, CompactBuffer::floatToHalf( 1.f ));
+    EXPECT_EQ( 0xbc00, CompactBuffer::floatToHalf( -1.f ));
+    EXPECT_EQ( 0x0001, CompactBuffer::floatToHalf( 5.960464477539063e-08f ));
+
+    // rounding to nearest (even)
+
+    EXPECT_EQ( 0x3c00, CompactBuffer::floatToHalf( 1.f + 1.f / 2048.f ));       // halfway, rounds down to even
+    EXPECT_EQ( 0x3c02, CompactBuffer::floatToHalf( 1.f + 3.f / 2048.f ));       // halfway, rounds up to even
+    EXPECT_EQ( 0x3c01, CompactBuffer::floatToHalf( 1.f + 1.f / 2048.f + 1e-6f ));
+
+    // out of range values
+
+    EXPECT_EQ( 0x7c00, CompactBuffer::floatToHalf( 100000.f ));
+    EXPECT_EQ( 0xfc00, CompactBuffer::floatToHalf( -std::numeric_limits<float>::infinity() ));
+    EXPECT_TRUE( std::isinf( CompactBuffer::halfToFloat( 0x7c00 )));
+    EXPECT_TRUE( std::isnan( CompactBuffer::halfToFloat( CompactBuffer::floatToHalf( std::numeric_limits<float>::quiet_NaN() ))));
+}
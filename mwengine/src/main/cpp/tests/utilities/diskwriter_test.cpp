@@ -0,0 +1,225 @@
+#include "../../utilities/diskwriter.h"
+#include "../../utilities/wavereader.h"
+#include "../../audioengine.h"
+#include <atomic>
+#include <cstdio>
+#include <thread>
+
+TEST( DiskWriter, FinishWithoutPrepare )
+{
+    ASSERT_FALSE( DiskWriter::finish() )
+        << "expected finish to fail when no recording was prepared";
+}
+
+TEST( DiskWriter, AppendInterleavedBuffer )
+{
+    AudioEngine::setup( 64, 44100, 2, 0 );
+
+    std::string outputFile = "diskwriter_test_interleaved.wav";
+    int amountOfFrames     = 64;
+    int iterations         = 50;
+
+    // the buffer can hold the full recording (see BufferWhileBouncing for a smaller buffer)
+
+    DiskWriter::prepare( outputFile, amountOfFrames * iterations, 2 );
+
+    float* buffer = new float[ amountOfFrames * 2 ];
+
+    for ( int i = 0; i < iterations; ++i ) {
+        for ( int j = 0; j < amountOfFrames; ++j ) {
+            buffer[ j * 2 ]     = ( float ) (( i + j ) % 10 ) / 20.f;
+            buffer[ j * 2 + 1 ] = -( float ) (( i + j ) % 10 ) / 20.f;
+        }
+        DiskWriter::appendBuffer( buffer, amountOfFrames, 2 );
+    }
+    delete[] buffer;
+
+    ASSERT_TRUE( DiskWriter::finish() ) << "expected recording to have been written";
+    ASSERT_EQ( 0, DiskWriter::getDroppedFrames() ) << "expected no frames to have been dropped";
+
+    AudioBuffer* recording = WaveReader::fileToBuffer( outputFile ).buffer;
+
+    ASSERT_FALSE( recording == nullptr ) << "expected a valid WAV file to have been written";
+    ASSERT_EQ( 2, recording->amountOfChannels ) << "expected recorded channel amount";
+    ASSERT_EQ( amountOfFrames * iterations, recording->bufferSize ) << "expected all appended frames to have been written";
+
+    for ( int i = 0; i < iterations; ++i ) {
+        for ( int j = 0; j < amountOfFrames; ++j ) {
+            SAMPLE_TYPE expected = ( SAMPLE_TYPE ) (( i + j ) % 10 ) / 20.0;
+            int index = i * amountOfFrames + j;
+
+            EXPECT_NEAR( +expected, recording->getBufferForChannel( 0 )[ index ], 0.0001 ) << "expected left sample at " << index;
+            EXPECT_NEAR( -expected, recording->getBufferForChannel( 1 )[ index ], 0.0001 ) << "expected right sample at " << index;
+        }
+    }
+    delete recording;
+    std::remove( outputFile.c_str() );
+}
+
+TEST( DiskWriter, AppendAudioBuffer )
+{
+    AudioEngine::setup( 32, 44100, 2, 0 );
+
+    std::string outputFile = "diskwriter_test_buffer.wav";
+    AudioBuffer* buffer    = new AudioBuffer( 1, 32 );
+
+    for ( int i = 0; i < 32; ++i ) {
+        buffer->getBufferForChannel( 0 )[ i ] = ( SAMPLE_TYPE ) i / 64.0;
+    }
+
+    DiskWriter::prepare( outputFile, 128, 2 );
+    DiskWriter::appendBuffer( buffer );
+    DiskWriter::appendBuffer( buffer );
+
+    ASSERT_TRUE( DiskWriter::finish() ) << "expected recording to have been written";
+
+    AudioBuffer* recording = WaveReader::fileToBuffer( outputFile ).buffer;
+
+    ASSERT_FALSE( recording == nullptr ) << "expected a valid WAV file to have been written";
+    ASSERT_EQ( 64, recording->bufferSize ) << "expected all appended frames to have been written";
+
+    for ( int i = 0; i < 64; ++i ) {
+        SAMPLE_TYPE expected = buffer->getBufferForChannel( 0 )[ i % 32 ];
+
+        EXPECT_NEAR( expected, recording->getBufferForChannel( 0 )[ i ], 0.0001 ) << "expected mono source in left channel at " << i;
+        EXPECT_NEAR( expected, recording->getBufferForChannel( 1 )[ i ], 0.0001 ) << "expected mono source in right channel at " << i;
+    }
+    delete buffer;
+    delete recording;
+    std::remove( outputFile.c_str() );
+}
+
+TEST( DiskWriter, FullDuplexLatencyCorrection )
+{
+    AudioEngine::setup( 16, 44100, 1, 0 );
+
+    AudioEngine::recordingState.correctLatency = true;
+    AudioEngine::recordingState.latency        = 5;
+
+    std::string outputFile = "diskwriter_test_duplex.wav";
+    int amountOfFrames     = 16;
+    int iterations         = 4;
+    int totalFrames        = amountOfFrames * iterations;
+
+    DiskWriter::prepare( outputFile, 64, 1 );
+
+    float* output      = new float[ amountOfFrames ];
+    AudioBuffer* input = new AudioBuffer( 1, amountOfFrames );
+
+    // the output and input both describe a ramp (the input ramp being negative)
+
+    for ( int i = 0; i < iterations; ++i ) {
+        for ( int j = 0; j < amountOfFrames; ++j ) {
+            int frame = i * amountOfFrames + j;
+            output[ j ] = ( float ) frame / 256.f;
+            input->getBufferForChannel( 0 )[ j ] = -( SAMPLE_TYPE ) frame / 512.0;
+        }
+        DiskWriter::appendDuplexBuffers( output, input, amountOfFrames, 1 );
+    }
+    delete[] output;
+    delete input;
+
+    ASSERT_TRUE( DiskWriter::finish() ) << "expected recording to have been written";
+
+    AudioEngine::recordingState.correctLatency = false;
+    AudioEngine::recordingState.latency        = 0;
+
+    AudioBuffer* recording = WaveReader::fileToBuffer( outputFile ).buffer;
+
+    ASSERT_FALSE( recording == nullptr ) << "expected a valid WAV file to have been written";
+    ASSERT_EQ( totalFrames, recording->bufferSize ) << "expected the mix to be as long as the recorded output";
+
+    for ( int i = 0; i < totalFrames; ++i ) {
+        // each output frame is mixed with the input recorded the latency amount of frames later
+        // (the last frames have no corresponding input)
+
+        SAMPLE_TYPE expected = ( SAMPLE_TYPE ) i / 256.0;
+        if ( i + 5 < totalFrames ) {
+            expected -= ( SAMPLE_TYPE ) ( i + 5 ) / 512.0;
+        }
+        EXPECT_NEAR( expected, recording->getBufferForChannel( 0 )[ i ], 0.0001 ) << "expected latency corrected mix at " << i;
+    }
+    delete recording;
+    std::remove( outputFile.c_str() );
+}
+
+TEST( DiskWriter, BufferWhileBouncing )
+{
+    AudioEngine::setup( 64, 44100, 1, 0 );
+
+    // when bouncing, the render thread awaits the writer thread when the buffer is full
+    // (rather than dropping frames), as such the recording can exceed the buffer size
+
+    AudioEngine::recordingState.bouncing = true;
+
+    std::string outputFile = "diskwriter_test_bounce.wav";
+    int amountOfFrames     = 64;
+    int iterations         = 200;
+
+    DiskWriter::prepare( outputFile, amountOfFrames, 1 );
+
+    float* buffer = new float[ amountOfFrames ];
+
+    for ( int i = 0; i < iterations; ++i ) {
+        for ( int j = 0; j < amountOfFrames; ++j ) {
+            buffer[ j ] = ( float ) ( i % 10 ) / 20.f;
+        }
+        DiskWriter::appendBuffer( buffer, amountOfFrames, 1 );
+    }
+    delete[] buffer;
+
+    ASSERT_TRUE( DiskWriter::finish() ) << "expected recording to have been written";
+
+    AudioEngine::recordingState.bouncing = false;
+
+    EXPECT_EQ( 0, DiskWriter::getDroppedFrames() ) << "expected no frames to have been dropped";
+
+    AudioBuffer* recording = WaveReader::fileToBuffer( outputFile ).buffer;
+
+    ASSERT_FALSE( recording == nullptr ) << "expected a valid WAV file to have been written";
+    ASSERT_EQ( amountOfFrames * iterations, recording->bufferSize ) << "expected all appended frames to have been written";
+
+    for ( int i = 0; i < iterations; ++i ) {
+        EXPECT_NEAR(( SAMPLE_TYPE ) ( i % 10 ) / 20.0, recording->getBufferForChannel( 0 )[ i * amountOfFrames ], 0.0001 )
+            << "expected frames to have been written in order for iteration " << i;
+    }
+    delete recording;
+    std::remove( outputFile.c_str() );
+}
+
+TEST( DiskWriter, PrepareWhileAppending )
+{
+    AudioEngine::setup( 64, 44100, 2, 0 );
+
+    std::string outputFile = "diskwriter_test_prepare.wav";
+    int amountOfFrames     = 64;
+
+    DiskWriter::prepare( outputFile, amountOfFrames * 4, 2 );
+
+    // the render thread keeps appending while the control thread prepares a new (differently sized) recording
+
+    std::atomic<bool> rendering( true );
+
+    std::thread renderThread([ &rendering, amountOfFrames ]() {
+        float* buffer = new float[ amountOfFrames * 2 ]();
+        AudioBuffer* audioBuffer = new AudioBuffer( 2, amountOfFrames );
+
+        while ( rendering.load() ) {
+            DiskWriter::appendBuffer( buffer, amountOfFrames, 2 );
+            DiskWriter::appendBuffer( audioBuffer );
+        }
+        delete audioBuffer;
+        delete[] buffer;
+    });
+
+    for ( int i = 0; i < 20; ++i ) {
+        DiskWriter::prepare( outputFile, amountOfFrames * ( 1 + i % 4 ), 1 + i % 2 );
+    }
+    ASSERT_TRUE( DiskWriter::finish() ) << "expected recording to have been written";
+    ASSERT_FALSE( DiskWriter::finish() ) << "expected recording to have been finished only once";
+
+    rendering.store( false );
+    renderThread.join();
+
+    std::remove( outputFile.c_str() );
+}
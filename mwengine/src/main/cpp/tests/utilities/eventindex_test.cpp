@@ -0,0 +1,163 @@
+#include "../../utilities/eventindex.h"
+
+// collects the events the index reports for given range
+
+std::vector<BaseAudioEvent*> queryEventIndex( EventIndex* index, int rangeStart, int rangeEnd )
+{
+    std::vector<BaseAudioEvent*> result;
+    index->query( rangeStart, rangeEnd, [ &result ]( BaseAudioEvent* audioEvent ) {
+        result.push_back( audioEvent );
+    });
+    return result;
+}
+
+TEST( EventIndex, Query )
+{
+    EventIndex* index = new EventIndex();
+    std::vector<BaseAudioEvent*> events;
+
+    ASSERT_TRUE( queryEventIndex( index, 0, 1000 ).empty() )
+        << "expected no events to be reported for an empty index";
+
+    for ( int i = 0; i < 200; ++i )
+    {
+        BaseAudioEvent* audioEvent = new BaseAudioEvent();
+        audioEvent->setEventStart( randomInt( 0, 10000 ));
+        audioEvent->setEventLength( randomInt( 1, i % 10 == 0 ? 5000 : 200 ));
+
+        events.push_back( audioEvent );
+        index->add( audioEvent );
+    }
+
+    EXPECT_EQ( 200, index->size() ) << "expected all events to have been indexed";
+
+    // remove a portion of the events
+
+    for ( int i = 0; i < 50; ++i ) {
+        ASSERT_TRUE( index->remove( events.back() )) << "expected event to have been removed";
+        delete events.back();
+        events.pop_back();
+    }
+    ASSERT_FALSE( index->remove( nullptr )) << "expected removal of a non-indexed event to fail";
+
+    // compare the overlapping events against a linear scan
+
+    for ( int i = 0; i < 100; ++i )
+    {
+        int rangeStart = randomInt( 0, 11000 );
+        int rangeEnd   = rangeStart + randomInt( 0, 512 );
+
+        std::vector<BaseAudioEvent*> result = queryEventIndex( index, rangeStart, rangeEnd );
+        size_t expected = 0;
+
+        for ( auto audioEvent : events )
+        {
+            if ( audioEvent->getEventStart() > rangeEnd || audioEvent->getEventEnd() < rangeStart ) {
+                continue;
+            }
+            ++expected;
+
+            EXPECT_EQ( 1, std::count( result.begin(), result.end(), audioEvent ))
+                << "expected overlapping event to be reported exactly once";
+        }
+        EXPECT_EQ( expected, result.size() ) << "expected only overlapping events to be reported";
+
+        for ( size_t j = 1; j < result.size(); ++j ) {
+            EXPECT_LE( result[ j - 1 ]->getEventStart(), result[ j ]->getEventStart() )
+                << "expected events to be reported in order of their start offset";
+        }
+    }
+
+    index->clear();
+
+    EXPECT_EQ( 0, index->size() ) << "expected index to be empty after clearing";
+    ASSERT_TRUE( queryEventIndex( index, 0, 11000 ).empty() ) << "expected no events to be reported after clearing";
+
+    for ( auto audioEvent : events ) {
+        delete audioEvent;
+    }
+    delete index;
+}
+
+TEST( EventIndex, RefreshAfterRepositioning )
+{
+    EventIndex* index = new EventIndex();
+    std::vector<BaseAudioEvent*> events;
+
+    index->reserve( 64 );
+
+    for ( int i = 0; i < 64; ++i )
+    {
+        BaseAudioEvent* audioEvent = new BaseAudioEvent();
+        audioEvent->setEventStart( randomInt( 0, 10000 ));
+        audioEvent->setEventLength( randomInt( 1, 500 ));
+
+        events.push_back( audioEvent );
+        index->add( audioEvent );
+    }
+
+    // repositioning the events to a tempo change retains their order
+
+    for ( auto audioEvent : events ) {
+        audioEvent->repositionToTempoChange( 0.5f );
+    }
+    unsigned int revision = index->getRevision();
+    index->refresh();
+
+    EXPECT_NE( revision, index->getRevision() ) << "expected the revision to have been incremented";
+    EXPECT_EQ( 64, index->size() );
+
+    int firstStart = INT_MAX;
+
+    for ( auto audioEvent : events ) {
+        firstStart = std::min( firstStart, audioEvent->getEventStart() );
+
+        std::vector<BaseAudioEvent*> result = queryEventIndex( index, audioEvent->getEventStart(), audioEvent->getEventStart() );
+
+        EXPECT_EQ( 1, std::count( result.begin(), result.end(), audioEvent ))
+            << "expected event to be reported at its repositioned range";
+    }
+    EXPECT_EQ( firstStart, index->getNextEventStart( -1 ));
+
+    // removal after a refresh should still find each event
+
+    for ( auto audioEvent : events ) {
+        ASSERT_TRUE( index->remove( audioEvent ));
+        delete audioEvent;
+    }
+    EXPECT_EQ( 0, index->size() );
+    EXPECT_TRUE( queryEventIndex( index, 0, 20000 ).empty() );
+
+    delete index;
+}
+
+TEST( EventIndex, InstrumentIndexesSequencedEvents )
+{
+    BaseInstrument* instrument = new BaseInstrument();
+    BaseAudioEvent* audioEvent = new BaseAudioEvent( instrument );
+
+    audioEvent->setEventStart( 100 );
+    audioEvent->setEventLength( 50 );
+    audioEvent->addToSequencer();
+
+    EXPECT_EQ( 1, queryEventIndex( instrument->getEventIndex(), 0, 100 ).size() )
+        << "expected the sequenced event to have been indexed";
+
+    // repositioning the event should update the index
+
+    audioEvent->setEventStart( 500 );
+
+    EXPECT_EQ( 0, queryEventIndex( instrument->getEventIndex(), 0, 100 ).size() )
+        << "expected the event not to be reported at its previous range";
+
+    EXPECT_EQ( 1, queryEventIndex( instrument->getEventIndex(), 540, 600 ).size() )
+        << "expected the event to be reported at its updated range";
+
+    audioEvent->removeFromSequencer();
+
+    EXPECT_EQ( 0, instrument->getEventIndex()->size() )
+        << "expected the event to have been removed from the index";
+
+    delete audioEvent;
+    delete instrument;
+}
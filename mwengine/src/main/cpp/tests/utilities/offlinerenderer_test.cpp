@@ -0,0 +1,328 @@
+#include "../../utilities/offlinerenderer.h"
+#include "../../utilities/rendersink.h"
+#include "../../audioengine.h"
+#include "../../sequencer.h"
+#include "../../sequencercontroller.h"
+#include "../../events/baseaudioevent.h"
+#include "../../instruments/baseinstrument.h"
+#include "../../channelgroup.h"
+#include "../../messaging/commandqueue.h"
+#include <cstdio>
+
+// creates a mono event with a ramping buffer (within the safe output range) of given length at given offset
+
+BaseAudioEvent* createOfflineTestEvent( BaseInstrument* instrument, int eventStart, int eventLength )
+{
+    BaseAudioEvent* event = new BaseAudioEvent( instrument );
+    AudioBuffer* buffer   = new AudioBuffer( 1, eventLength );
+
+    for ( int i = 0; i < eventLength; ++i ) {
+        buffer->getBufferForChannel( 0 )[ i ] = ( SAMPLE_TYPE ) ( i + 1 ) / ( SAMPLE_TYPE ) ( eventLength * 2 );
+    }
+    event->setBuffer( buffer, true );
+    event->setEventStart( eventStart );
+    event->setEventLength( eventLength );
+    event->addToSequencer();
+
+    return event;
+}
+
+TEST( OfflineRenderer, BlockSize )
+{
+    AudioEngine::setup( 64, 44100, 1, 0 );
+
+    OfflineRenderer* renderer = new OfflineRenderer( 0, 1000, 16 );
+    EXPECT_EQ( 16, renderer->getBlockSize() ) << "expected given block size to have been applied";
+    delete renderer;
+
+    renderer = new OfflineRenderer( 0, 1000, 128 );
+    EXPECT_EQ( 64, renderer->getBlockSize() ) << "expected block size to be capped to the engine buffer size";
+    delete renderer;
+
+    renderer = new OfflineRenderer( 0, 1000, 0 );
+    EXPECT_EQ( 1, renderer->getBlockSize() ) << "expected block size to be at least a single sample";
+    delete renderer;
+}
+
+TEST( OfflineRenderer, RenderIntoMemory )
+{
+    SequencerController* controller = new SequencerController();
+    controller->prepare( 120, 4, 4 );
+
+    AudioEngine::setup( 16, 44100, 1, 0 );
+    AudioEngine::volume = 1;
+
+    BaseInstrument* instrument = new BaseInstrument();
+    BaseAudioEvent* event      = createOfflineTestEvent( instrument, 10, 40 );
+
+    MemoryRenderSink* sink    = new MemoryRenderSink();
+    OfflineRenderer* renderer = new OfflineRenderer( 0, 63, 16 );
+
+    ASSERT_TRUE( renderer->render( sink )) << "expected render to have succeeded";
+
+    EXPECT_FALSE( CommandQueue::isRenderThread() )
+        << "expected the calling thread not to have been registered as the render thread";
+
+    EXPECT_EQ( 64, renderer->getRenderedFrames() ) << "expected the full range to have been rendered";
+    EXPECT_EQ( 64, sink->getBuffer()->bufferSize ) << "expected the sink to contain the full range";
+    EXPECT_EQ( 1,  sink->getBuffer()->amountOfChannels ) << "expected the sink to match the output channel amount";
+
+    SAMPLE_TYPE* eventBuffer  = event->getBuffer()->getBufferForChannel( 0 );
+    SAMPLE_TYPE* outputBuffer = sink->getBuffer()->getBufferForChannel( 0 );
+
+    for ( int i = 0; i < 64; ++i ) {
+        SAMPLE_TYPE expected = ( i >= 10 && i < 50 ) ? eventBuffer[ i - 10 ] : 0.0;
+        EXPECT_FLOAT_EQ( expected, outputBuffer[ i ] ) << "expected rendered sample at index " << i << " to match the event";
+    }
+
+    delete renderer;
+    delete sink;
+    delete event;
+    delete instrument;
+    delete controller;
+}
+
+TEST( OfflineRenderer, Deterministic )
+{
+    SequencerController* controller = new SequencerController();
+    controller->prepare( 120, 4, 4 );
+
+    AudioEngine::setup( 64, 44100, 2, 0 );
+    AudioEngine::volume = 1;
+
+    BaseInstrument* instrument = new BaseInstrument();
+    BaseAudioEvent* event1     = createOfflineTestEvent( instrument, 5,   100 );
+    BaseAudioEvent* event2     = createOfflineTestEvent( instrument, 150, 250 );
+
+    // render using different block sizes, the output should be identical
+
+    MemoryRenderSink* sink1 = new MemoryRenderSink();
+    MemoryRenderSink* sink2 = new MemoryRenderSink();
+
+    OfflineRenderer* renderer1 = new OfflineRenderer( 0, 511, 64 );
+    OfflineRenderer* renderer2 = new OfflineRenderer( 0, 511, 7 );
+
+    ASSERT_TRUE( renderer1->render( sink1 ));
+    ASSERT_TRUE( renderer2->render( sink2 ));
+
+    bool hasSignal = false;
+
+    for ( int c = 0; c < 2; ++c ) {
+        SAMPLE_TYPE* buffer1 = sink1->getBuffer()->getBufferForChannel( c );
+        SAMPLE_TYPE* buffer2 = sink2->getBuffer()->getBufferForChannel( c );
+
+        for ( int i = 0; i < 512; ++i ) {
+            if ( buffer1[ i ] != 0.0 )
+                hasSignal = true;
+
+            ASSERT_EQ( buffer1[ i ], buffer2[ i ] ) << "expected identical output for channel " << c << " at sample " << i;
+        }
+    }
+    ASSERT_TRUE( hasSignal ) << "expected the rendered range to be audible";
+
+    delete renderer1;
+    delete renderer2;
+    delete sink1;
+    delete sink2;
+    delete event1;
+    delete event2;
+    delete instrument;
+    delete controller;
+}
+
+TEST( OfflineRenderer, RestoreSequencerState )
+{
+    SequencerController* controller = new SequencerController();
+    controller->prepare( 120, 4, 4 );
+
+    AudioEngine::setup( 32, 44100, 1, 0 );
+
+    AudioEngine::min_buffer_position = 100;
+    AudioEngine::max_buffer_position = 20000;
+    AudioEngine::bufferPosition      = 1234;
+    Sequencer::playing               = false;
+
+    MemoryRenderSink* sink    = new MemoryRenderSink();
+    OfflineRenderer* renderer = new OfflineRenderer( 500, 999, 32 );
+
+    ASSERT_TRUE( renderer->render( sink ));
+
+    EXPECT_EQ( 100,   AudioEngine::min_buffer_position ) << "expected loop start to have been restored";
+    EXPECT_EQ( 20000, AudioEngine::max_buffer_position ) << "expected loop end to have been restored";
+    EXPECT_EQ( 1234,  AudioEngine::bufferPosition )      << "expected playback position to have been restored";
+    EXPECT_FALSE( Sequencer::playing )                   << "expected playback state to have been restored";
+
+    delete renderer;
+    delete sink;
+    delete controller;
+}
+
+TEST( OfflineRenderer, RefuseWhileRendering )
+{
+    AudioEngine::setup( 32, 44100, 1, 0 );
+
+    MemoryRenderSink* sink    = new MemoryRenderSink();
+    OfflineRenderer* renderer = new OfflineRenderer( 0, 511, 32 );
+
+    AudioEngineProps::isRendering.store( true );
+
+    EXPECT_FALSE( renderer->render( sink )) << "expected render to be refused while the engine is running";
+    EXPECT_EQ( nullptr, sink->getBuffer() ) << "expected sink not to have been opened";
+
+    AudioEngineProps::isRendering.store( false );
+
+    EXPECT_FALSE( renderer->render( nullptr )) << "expected render to fail without a sink";
+
+    OfflineRenderer* invalidRenderer = new OfflineRenderer( 100, 50, 32 );
+    EXPECT_FALSE( invalidRenderer->render( sink )) << "expected render to fail for an invalid range";
+
+    delete invalidRenderer;
+    delete renderer;
+    delete sink;
+}
+
+TEST( OfflineRenderer, CallbackSink )
+{
+    SequencerController* controller = new SequencerController();
+    controller->prepare( 120, 4, 4 );
+
+    AudioEngine::setup( 32, 44100, 2, 0 );
+
+    std::vector<int> blocks;
+    int channelAmount = 0;
+
+    CallbackRenderSink* sink = new CallbackRenderSink([ &blocks, &channelAmount ]( const float*, int amountOfFrames, int amountOfChannels ) {
+        blocks.push_back( amountOfFrames );
+        channelAmount = amountOfChannels;
+        return true;
+    });
+    OfflineRenderer* renderer = new OfflineRenderer( 0, 99, 32 );
+
+    ASSERT_TRUE( renderer->render( sink ));
+
+    ASSERT_EQ( 4, blocks.size() ) << "expected the range to have been written in blocks";
+    EXPECT_EQ( 32, blocks[ 0 ] );
+    EXPECT_EQ( 32, blocks[ 1 ] );
+    EXPECT_EQ( 32, blocks[ 2 ] );
+    EXPECT_EQ( 4,  blocks[ 3 ] ) << "expected the last block to contain the remainder of the range";
+    EXPECT_EQ( 2,  channelAmount ) << "expected the output channel amount to have been provided";
+
+    delete renderer;
+    delete sink;
+    delete controller;
+}
+
+TEST( OfflineRenderer, WaveFileSink )
+{
+    SequencerController* controller = new SequencerController();
+    controller->prepare( 120, 4, 4 );
+
+    AudioEngine::setup( 64, 44100, 2, 0 );
+
+    BaseInstrument* instrument = new BaseInstrument();
+    BaseAudioEvent* event      = createOfflineTestEvent( instrument, 0, 200 );
+
+    std::string outputFile    = "offlinerenderer_test.wav";
+    WaveFileRenderSink* sink  = new WaveFileRenderSink( outputFile );
+    OfflineRenderer* renderer = new OfflineRenderer( 0, 999, 64 );
+
+    ASSERT_TRUE( renderer->render( sink )) << "expected render to have succeeded";
+
+    std::ifstream file( outputFile, std::ios::binary | std::ios::ate );
+
+    ASSERT_TRUE( file.good() ) << "expected WAV file to have been written";
+    EXPECT_EQ( 44 + 1000 * 2 * sizeof( INT16 ), ( size_t ) file.tellg() )
+        << "expected WAV file to contain the header and the full range as 16-bit stereo PCM";
+
+    file.close();
+    std::remove( outputFile.c_str() );
+
+    delete renderer;
+    delete sink;
+    delete event;
+    delete instrument;
+    delete controller;
+}
+
+TEST( OfflineRenderer, Stems )
+{
+    SequencerController* controller = new SequencerController();
+    controller->prepare( 120, 4, 4 );
+
+    AudioEngine::setup( 64, 44100, 1, 0 );
+    AudioEngine::volume = 1;
+
+    BaseInstrument* instrument1 = new BaseInstrument();
+    BaseInstrument* instrument2 = new BaseInstrument();
+    BaseInstrument* instrument3 = new BaseInstrument();
+    BaseAudioEvent* event1      = createOfflineTestEvent( instrument1, 0,  200 );
+    BaseAudioEvent* event2      = createOfflineTestEvent( instrument2, 50, 300 );
+    BaseAudioEvent* event3      = createOfflineTestEvent( instrument3, 20, 100 );
+
+    // instrument3 is routed through a group
+
+    ChannelGroup* group = new ChannelGroup();
+    group->addAudioChannel( instrument3->audioChannel );
+    AudioEngine::addChannelGroup( group );
+
+    MemoryRenderSink* masterSink = new MemoryRenderSink();
+    MemoryRenderSink* stemSink1  = new MemoryRenderSink();
+    MemoryRenderSink* stemSink2  = new MemoryRenderSink();
+    MemoryRenderSink* groupSink  = new MemoryRenderSink();
+
+    OfflineRenderer* renderer = new OfflineRenderer( 0, 511, 64 );
+
+    renderer->addStem( instrument1->audioChannel, stemSink1 );
+    renderer->addStem( instrument2->audioChannel, stemSink2 );
+    renderer->addStem( group, groupSink );
+
+    ASSERT_TRUE( renderer->render( masterSink )) << "expected render to have succeeded";
+
+    ASSERT_EQ( 512, stemSink1->getBuffer()->bufferSize ) << "expected stem to contain the full range";
+    ASSERT_EQ( 512, stemSink2->getBuffer()->bufferSize ) << "expected stem to contain the full range";
+    ASSERT_EQ( 512, groupSink->getBuffer()->bufferSize ) << "expected group stem to contain the full range";
+
+    SAMPLE_TYPE* master = masterSink->getBuffer()->getBufferForChannel( 0 );
+    SAMPLE_TYPE* stem1  = stemSink1->getBuffer()->getBufferForChannel( 0 );
+    SAMPLE_TYPE* stem2  = stemSink2->getBuffer()->getBufferForChannel( 0 );
+    SAMPLE_TYPE* stem3  = groupSink->getBuffer()->getBufferForChannel( 0 );
+
+    for ( int i = 0; i < 512; ++i ) {
+        EXPECT_EQ( i < 200, stem1[ i ] != 0.0 ) << "expected first stem to only contain the first event at sample " << i;
+        EXPECT_EQ( i >= 50 && i < 350, stem2[ i ] != 0.0 ) << "expected second stem to only contain the second event at sample " << i;
+        EXPECT_EQ( i >= 20 && i < 120, stem3[ i ] != 0.0 ) << "expected group stem to only contain the third event at sample " << i;
+
+        EXPECT_NEAR( master[ i ], stem1[ i ] + stem2[ i ] + stem3[ i ], 0.0001 )
+            << "expected stems to sum to the master mix at sample " << i;
+    }
+
+    // render the stems without a master mix, muted channels should result in silent stems
+
+    instrument2->audioChannel->muted = true;
+
+    MemoryRenderSink* mutedSink = new MemoryRenderSink();
+    OfflineRenderer* stemRenderer = new OfflineRenderer( 0, 511, 64 );
+    stemRenderer->addStem( instrument2->audioChannel, mutedSink );
+
+    ASSERT_TRUE( stemRenderer->render( nullptr )) << "expected stems to render without a master sink";
+    EXPECT_TRUE( mutedSink->getBuffer()->isSilent() ) << "expected the stem of a muted channel to be silent";
+    EXPECT_EQ( nullptr, AudioEngine::stemCapture ) << "expected the stem capture to be unset after rendering";
+
+    AudioEngine::removeChannelGroup( group );
+
+    delete stemRenderer;
+    delete renderer;
+    delete mutedSink;
+    delete masterSink;
+    delete stemSink1;
+    delete stemSink2;
+    delete groupSink;
+    delete group;
+    delete event1;
+    delete event2;
+    delete event3;
+    delete instrument1;
+    delete instrument2;
+    delete instrument3;
+    delete controller;
+}
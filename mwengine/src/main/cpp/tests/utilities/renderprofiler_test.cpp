@@ -0,0 +1,119 @@
+#include "../../utilities/renderprofiler.h"
+
+// the profiler only exists when PROFILE_RENDER is defined (see global.h)
+
+#ifdef PROFILE_RENDER
+
+#include <processors/gain.h>
+
+TEST( RenderProfiler, Percentiles )
+{
+    RenderProfiler::reset();
+
+    // record 100 measurements of 1 to 100 microseconds
+
+    for ( int i = 1; i <= 100; ++i ) {
+        RenderProfiler::record( RenderProfiler::SEQUENCER, i * 1000 );
+    }
+
+    std::vector<RenderProfiler::Result> results = RenderProfiler::getResults();
+
+    ASSERT_EQ( 1, results.size() ) << "expected a single result";
+
+    RenderProfiler::Result result = results.at( 0 );
+
+    EXPECT_EQ( RenderProfiler::SEQUENCER, result.stage );
+    EXPECT_EQ( -1, result.channelId ) << "expected no channel to be associated with the stage";
+    EXPECT_EQ( 100, result.count ) << "expected all measurements to have been recorded";
+    EXPECT_EQ( 100000, result.max ) << "expected the maximum to be exact";
+
+    // histogram buckets are accurate to 12.5 %
+
+    EXPECT_NEAR( 50000, result.p50, 50000 * .125 ) << "expected median to be within the bucket accuracy";
+    EXPECT_NEAR( 99000, result.p99, 99000 * .125 ) << "expected 99th percentile to be within the bucket accuracy";
+
+    RenderProfiler::reset();
+
+    ASSERT_EQ( 0, RenderProfiler::getResults().size() ) << "expected results to have been cleared after reset";
+}
+
+TEST( RenderProfiler, ProcessorsAndDSPLoad )
+{
+    RenderProfiler::reset();
+
+    AudioEngineProps::SAMPLE_RATE = 44100;
+
+    Gain* gain1 = new Gain();
+    Gain* gain2 = new Gain();
+
+    RenderProfiler::registerProcessor( gain1 );
+    RenderProfiler::registerProcessor( gain2 );
+
+    // 441 samples at 44.1 kHz equals 10 ms of audio, spend 2.5 ms in each processor
+
+    for ( int i = 0; i < 4; ++i ) {
+        RenderProfiler::record( RenderProfiler::PROCESSOR, 2500000, 1, gain1 );
+        RenderProfiler::record( RenderProfiler::PROCESSOR, 2500000, 2, gain2 );
+        RenderProfiler::recordCycle( 5000000, 441 );
+    }
+
+    std::vector<RenderProfiler::Result> results = RenderProfiler::getResults();
+
+    ASSERT_EQ( 3, results.size() ) << "expected the render cycle and two processors to have been profiled";
+
+    // results are sorted by stage, then channel
+
+    EXPECT_EQ( RenderProfiler::RENDER_CYCLE, results.at( 0 ).stage );
+    EXPECT_NEAR( 50.0, results.at( 0 ).dspLoad, 0.01 ) << "expected render cycle to occupy half of the available time";
+
+    for ( int i = 1; i < 3; ++i ) {
+        EXPECT_EQ( RenderProfiler::PROCESSOR, results.at( i ).stage );
+        EXPECT_EQ( i, results.at( i ).channelId ) << "expected processor to be associated with its channel";
+        EXPECT_EQ( 0, results.at( i ).name.compare( gain1->getType() )) << "expected processor to be identified by its type";
+        EXPECT_EQ( 4, results.at( i ).count );
+        EXPECT_NEAR( 25.0, results.at( i ).dspLoad, 0.01 ) << "expected processor to occupy a quarter of the available time";
+    }
+
+    RenderProfiler::reset();
+
+    delete gain1;
+    delete gain2;
+}
+
+TEST( RenderProfiler, ReleasesProcessorNames )
+{
+    RenderProfiler::reset();
+
+    AudioEngineProps::SAMPLE_RATE = 44100;
+
+    // register and unregister more processors than there are entries for processor names
+    // (processors remain allocated so each registration concerns a unique processor)
+
+    std::vector<Gain*> processors;
+
+    for ( int i = 0; i < 512; ++i ) {
+        Gain* processor = new Gain();
+        processors.push_back( processor );
+
+        RenderProfiler::registerProcessor( processor );
+        RenderProfiler::unregisterProcessor( processor );
+    }
+
+    Gain* gain = new Gain();
+    RenderProfiler::registerProcessor( gain );
+    RenderProfiler::record( RenderProfiler::PROCESSOR, 1000, 1, gain );
+
+    std::vector<RenderProfiler::Result> results = RenderProfiler::getResults();
+
+    ASSERT_EQ( 1, results.size() );
+    EXPECT_EQ( 0, results.at( 0 ).name.compare( gain->getType() )) << "expected the name entries of unregistered processors to have been reused";
+
+    RenderProfiler::reset();
+
+    delete gain;
+    for ( auto processor : processors ) {
+        delete processor;
+    }
+}
+
+#endif
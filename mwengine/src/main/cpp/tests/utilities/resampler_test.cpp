@@ -0,0 +1,229 @@
+#include "../../utilities/resampler.h"
+#include <cmath>
+
+// measures the largest deviation of a sine wave (of given period in samples) read
+// at fractional positions by given interpolation quality from the actual sine
+
+SAMPLE_TYPE getResamplerSineError( int quality, double period )
+{
+    const int size = 256;
+    SAMPLE_TYPE source[ size ];
+
+    for ( int i = 0; i < size; ++i )
+        source[ i ] = ( SAMPLE_TYPE ) sin( TWO_PI * i / period );
+
+    const int amount = 128;
+    int64_t phases[ amount ];
+    SAMPLE_TYPE gains[ amount ];
+    SAMPLE_TYPE target[ amount ];
+
+    // read from the center of the buffer (the sinc taps do not reach beyond its edges)
+
+    int64_t increment = Resampler::toPhase( 0.37 );
+
+    for ( int i = 0; i < amount; ++i ) {
+        phases[ i ] = Resampler::fromIndex( 64 ) + i * increment;
+        gains [ i ] = 1.0;
+        target[ i ] = 0.0;
+    }
+    Resampler::mix( source, phases, gains, target, amount, size - 1, quality );
+
+    SAMPLE_TYPE maxError = 0.0;
+
+    for ( int i = 0; i < amount; ++i ) {
+        double position = 64.0 + ( double ) ( i * increment ) / 4294967296.0;
+        maxError = std::max( maxError, ( SAMPLE_TYPE ) std::abs( target[ i ] - sin( TWO_PI * position / period )));
+    }
+    return maxError;
+}
+
+TEST( Resampler, Phases )
+{
+    int64_t phase = Resampler::toPhase( 2.75 );
+
+    EXPECT_EQ( INT64_C( 11 ) << 30, phase );
+    EXPECT_EQ( 2, Resampler::getIndex( phase ));
+    EXPECT_EQ( 3, Resampler::roundIndex( phase ));
+    EXPECT_EQ(( SAMPLE_TYPE ) .75, Resampler::getFraction( phase ));
+
+    EXPECT_EQ( Resampler::toPhase( 7.0 ), Resampler::fromIndex( 7 ));
+    EXPECT_EQ(( SAMPLE_TYPE ) 0, Resampler::getFraction( Resampler::fromIndex( 7 )));
+}
+
+TEST( Resampler, PhaseAccumulation )
+{
+    // incrementing a phase by the playback rate should not drift, even at offsets where
+    // single precision floating point numbers can no longer represent fractional positions
+
+    int64_t increment = Resampler::toPhase( 0.75 );
+    int64_t phase     = 0;
+
+    for ( int i = 0; i < 40000000; ++i )
+        phase += increment;
+
+    EXPECT_EQ( 30000000, Resampler::getIndex( phase ));
+    EXPECT_EQ(( SAMPLE_TYPE ) 0, Resampler::getFraction( phase ));
+}
+
+TEST( Resampler, SincTable )
+{
+    const float* table = Resampler::getSincTable();
+
+    // each phase should have unity gain
+
+    for ( int p = 0; p <= Resampler::SINC_PHASES; ++p ) {
+        float sum = 0.f;
+        for ( int k = 0; k < Resampler::SINC_TAPS; ++k )
+            sum += table[ p * Resampler::SINC_TAPS + k ];
+
+        EXPECT_NEAR( 1.f, sum, 1e-5f ) << "expected unity gain for phase " << p;
+    }
+
+    // at a fractional position of 0 the filter is centered on the sample at the read index,
+    // at a fractional position of .5 the filter is symmetrical
+
+    int center = Resampler::SINC_TAPS / 2 - 1;
+
+    for ( int k = 0; k < Resampler::SINC_TAPS; ++k ) {
+        EXPECT_GE( table[ center ], table[ k ] );
+    }
+
+    const float* halfway = table + ( Resampler::SINC_PHASES / 2 ) * Resampler::SINC_TAPS;
+
+    for ( int k = 0; k < Resampler::SINC_TAPS / 2; ++k ) {
+        EXPECT_NEAR( halfway[ k ], halfway[ Resampler::SINC_TAPS - 1 - k ], 1e-6f );
+    }
+}
+
+TEST( Resampler, MixLinear )
+{
+    SAMPLE_TYPE source[ 4 ] = { 0.0, 1.0, -1.0, 0.5 };
+
+    int64_t phases[ 4 ]     = { Resampler::toPhase( 0.5 ), Resampler::toPhase( 1.25 ), Resampler::toPhase( 2.0 ), Resampler::toPhase( 3.5 ) };
+    SAMPLE_TYPE gains[ 4 ]  = { 1.0, 1.0, 0.5, 1.0 };
+    SAMPLE_TYPE target[ 4 ] = { 0.0, 0.0, 0.0, 1.0 };
+
+    Resampler::mix( source, phases, gains, target, 4, 3, Resampler::LINEAR );
+
+    EXPECT_EQ(( SAMPLE_TYPE ) 0.5, target[ 0 ]);
+    EXPECT_EQ(( SAMPLE_TYPE ) 0.5, target[ 1 ]);
+    EXPECT_EQ(( SAMPLE_TYPE ) -0.5, target[ 2 ]) << "expected gain to be applied";
+    EXPECT_EQ(( SAMPLE_TYPE ) 1.5, target[ 3 ]) << "expected reads beyond the last index to be clamped and the sample to be mixed";
+}
+
+TEST( Resampler, MixConstantSignal )
+{
+    // all qualities should pass DC unaltered (also at the edges of the source) and leave zero gain samples silent
+
+    SAMPLE_TYPE source[ 32 ];
+    for ( int i = 0; i < 32; ++i )
+        source[ i ] = ( SAMPLE_TYPE ) .5;
+
+    int qualities[ 3 ] = { Resampler::LINEAR, Resampler::HERMITE, Resampler::SINC };
+
+    for ( int q = 0; q < 3; ++q )
+    {
+        int64_t phases[ 64 ];
+        SAMPLE_TYPE gains[ 64 ];
+        SAMPLE_TYPE target[ 64 ];
+
+        for ( int i = 0; i < 64; ++i ) {
+            phases[ i ] = i * Resampler::toPhase( 0.49 );
+            gains [ i ] = ( i % 8 == 0 ) ? 0.0 : 1.0;
+            target[ i ] = 0.0;
+        }
+        Resampler::mix( source, phases, gains, target, 64, 31, qualities[ q ] );
+
+        for ( int i = 0; i < 64; ++i ) {
+            EXPECT_NEAR(( i % 8 == 0 ) ? 0.0 : 0.5, target[ i ], 1e-5 ) << "for quality " << q << " at index " << i;
+        }
+    }
+}
+
+TEST( Resampler, InterpolationQuality )
+{
+    // at low frequencies all qualities should approximate the signal, where higher quality
+    // interpolation should be more accurate
+
+    EXPECT_LT( getResamplerSineError( Resampler::LINEAR,  32.0 ), 5e-3 );
+    EXPECT_LT( getResamplerSineError( Resampler::HERMITE, 32.0 ), getResamplerSineError( Resampler::LINEAR, 32.0 ));
+    EXPECT_LT( getResamplerSineError( Resampler::SINC,    32.0 ), 1e-3 );
+
+    // at higher frequencies the polynomial interpolators should deviate considerably, where the
+    // sinc filter remains accurate up to its cutoff frequency
+
+    SAMPLE_TYPE linearError  = getResamplerSineError( Resampler::LINEAR,  5.0 );
+    SAMPLE_TYPE hermiteError = getResamplerSineError( Resampler::HERMITE, 5.0 );
+    SAMPLE_TYPE sincError    = getResamplerSineError( Resampler::SINC,    5.0 );
+
+    EXPECT_LT( hermiteError, linearError );
+    EXPECT_LT( sincError,    hermiteError );
+    EXPECT_LT( sincError,    1e-2 );
+}
+
+TEST( Resampler, Resample )
+{
+    // a 1 kHz sine at 44.1 kHz converted to 48 kHz should remain a 1 kHz sine
+
+    AudioBuffer* source = new AudioBuffer( 2, 4410 );
+
+    for ( int c = 0; c < 2; ++c ) {
+        for ( int i = 0; i < source->bufferSize; ++i )
+            source->getBufferForChannel( c )[ i ] = ( SAMPLE_TYPE ) ( 0.5 * sin( TWO_PI * 1000.0 * i / 44100.0 + c ));
+    }
+    AudioBuffer* output = Resampler::resample( source, 44100, 48000 );
+
+    ASSERT_EQ( 2, output->amountOfChannels );
+    ASSERT_EQ( 4800, output->bufferSize ) << "expected duration to be retained";
+
+    // the edges of the output are affected by the silence surrounding the source
+
+    SAMPLE_TYPE maxError = 0.0;
+
+    for ( int c = 0; c < 2; ++c ) {
+        for ( int i = 100; i < output->bufferSize - 100; ++i ) {
+            SAMPLE_TYPE expected = ( SAMPLE_TYPE ) ( 0.5 * sin( TWO_PI * 1000.0 * i / 48000.0 + c ));
+            maxError = std::max( maxError, ( SAMPLE_TYPE ) std::abs( expected - output->getBufferForChannel( c )[ i ] ));
+        }
+    }
+    EXPECT_LT( maxError, 1e-4 );
+
+    delete output;
+
+    // equal sample rates should return an equal buffer
+
+    output = Resampler::resample( source, 44100, 44100 );
+
+    ASSERT_FALSE( output == source );
+    ASSERT_EQ( source->bufferSize, output->bufferSize );
+
+    for ( int i = 0; i < source->bufferSize; ++i )
+        EXPECT_EQ( source->getBufferForChannel( 1 )[ i ], output->getBufferForChannel( 1 )[ i ] );
+
+    delete output;
+    delete source;
+}
+
+TEST( Resampler, ResampleBandLimitsDownsampling )
+{
+    // a 30 kHz sine at 96 kHz cannot be represented at 48 kHz and should be filtered out (rather than alias)
+
+    AudioBuffer* source = new AudioBuffer( 1, 9600 );
+
+    for ( int i = 0; i < source->bufferSize; ++i )
+        source->getBufferForChannel( 0 )[ i ] = ( SAMPLE_TYPE ) sin( TWO_PI * 30000.0 * i / 96000.0 );
+
+    AudioBuffer* output = Resampler::resample( source, 96000, 48000 );
+
+    ASSERT_EQ( 4800, output->bufferSize );
+
+    SAMPLE_TYPE peak = 0.0;
+
+    for ( int i = 100; i < output->bufferSize - 100; ++i )
+        peak = std::max( peak, ( SAMPLE_TYPE ) std::abs( output->getBufferForChannel( 0 )[ i ] ));
+
+    EXPECT_LT( peak, 1e-3 );
+
+    delete output;
+    delete source;
+}
@@ -0,0 +1,148 @@
+#include "../../utilities/rtsafetychecker.h"
+
+// the checker only exists when CHECK_RT_SAFETY is defined (see CMakeLists.txt)
+
+#ifdef CHECK_RT_SAFETY
+
+#include <mutex>
+#include <definitions/waveforms.h>
+
+TEST( RTSafetyChecker, DetectsViolationsInRenderScope )
+{
+    RTSafetyChecker::reset();
+
+    int* value = new int( 1 );
+    delete value;
+
+    EXPECT_EQ( 0, RTSafetyChecker::getViolations() )
+        << "expected no violations to be reported outside of a render scope";
+
+    {
+        RTSafetyChecker::RenderScope scope;
+
+        EXPECT_TRUE( RTSafetyChecker::isChecking() )
+            << "expected checker to be active within a render scope";
+
+        value = new int( 2 );
+
+        std::mutex mutex;
+        mutex.lock();
+        mutex.unlock();
+    }
+    delete value;
+
+    EXPECT_FALSE( RTSafetyChecker::isChecking() )
+        << "expected checker to be inactive after leaving the render scope";
+
+    EXPECT_EQ( 2, RTSafetyChecker::getViolations() )
+        << "expected both the allocation and the lock to have been reported";
+
+    RTSafetyChecker::reset();
+}
+
+TEST( RTSafetyChecker, SuspendScope )
+{
+    RTSafetyChecker::reset();
+
+    {
+        RTSafetyChecker::RenderScope scope;
+        {
+            RTSafetyChecker::SuspendScope suspend;
+
+            EXPECT_FALSE( RTSafetyChecker::isChecking() )
+                << "expected checker to be inactive within a suspended scope";
+
+            int* value = new int( 1 );
+            delete value;
+        }
+        EXPECT_TRUE( RTSafetyChecker::isChecking() )
+            << "expected checker to be active again after leaving the suspended scope";
+    }
+
+    EXPECT_EQ( 0, RTSafetyChecker::getViolations() )
+        << "expected no violations to be reported for a suspended scope";
+}
+
+// renders a scene with sequenced and live Karplus-Strong synthesis and sample playback
+// while the mocked driver alternates the tempo (see MockData test program 6)
+
+void renderTempoChangeTestScene( int renderWorkers )
+{
+    MockData::test_program          = 6;
+    MockData::render_iterations     = 0;
+    MockData::max_render_iterations = 24;
+
+    SequencerController* controller = new SequencerController();
+    controller->prepare( 120, 4, 4 );
+
+    AudioEngine::setup( 512, 44100, 2, 0 );
+    AudioEngine::setRenderWorkers( renderWorkers );
+
+    controller->setTempoNow( 120.0f, 4, 4 );
+    controller->rewind();
+
+    AudioEngine::min_buffer_position = 0;
+    AudioEngine::max_buffer_position = AudioEngine::samples_per_bar * 2 - 1;
+
+    BaseInstrument* instrument = new BaseInstrument();
+    BaseAudioEvent* audioEvent = enqueuedAudioEvent( instrument, 8192, 1, 16, 4 );
+    AudioBuffer* buffer        = randomAudioBuffer();
+    audioEvent->setBuffer( buffer, false );
+
+    SynthInstrument* synth = new SynthInstrument();
+    synth->getOscillatorProperties( 0 )->setWaveform( WaveForms::KARPLUS_STRONG );
+
+    std::vector<SynthEvent*> synthEvents;
+
+    for ( int i = 0; i < 8; ++i ) {
+        SynthEvent* synthEvent = new SynthEvent( 110.F * ( 1 + i % 3 ), i * 4, 2.F, synth );
+        synthEvent->addToSequencer();
+        synthEvents.push_back( synthEvent );
+    }
+    SynthEvent* liveEvent = new SynthEvent( 330.F, synth );
+    liveEvent->play();
+
+    AudioEngine::bufferPosition = 0;
+    AudioEngine::volume         = 1;
+    controller->setPlaying( true );
+    AudioEngine::start( Drivers::types::MOCKED );
+
+    EXPECT_EQ( 90.f, AudioEngine::tempo ) << "expected the tempo changes to have been applied during rendering";
+    EXPECT_FALSE( synthEvents.at( 0 )->ringBuffers[ 0 ].load() == nullptr ) << "expected a pooled ring buffer to have been used";
+
+    // clean up
+
+    controller->setPlaying( false );
+    AudioEngine::setRenderWorkers( 0 );
+    MockData::render_iterations = 0;
+
+    delete liveEvent;
+    for ( auto synthEvent : synthEvents ) {
+        delete synthEvent;
+    }
+    delete synth;
+    delete audioEvent;
+    delete buffer;
+    delete instrument;
+    delete controller;
+}
+
+TEST( RTSafetyChecker, RenderCycleIsRealTimeSafe )
+{
+    RTSafetyChecker::reset();
+
+    // serial render as well as the render using worker threads
+
+    renderParallelTestScene( 0 );
+    renderParallelTestScene( 2 );
+
+    // tempo changes as well as Karplus-Strong synthesis (using pooled ring buffers)
+
+    renderTempoChangeTestScene( 0 );
+    renderTempoChangeTestScene( 2 );
+
+    EXPECT_EQ( 0, RTSafetyChecker::getViolations() )
+        << "expected the render cycle not to allocate memory nor acquire locks";
+}
+
+#endif
@@ -0,0 +1,122 @@
+#include "../../utilities/samplebank.h"
+#include <cstdio>
+#include <unistd.h>
+
+TEST( SampleBank, WriteAndOpen )
+{
+    std::string file = "samplebank_test.mwsb";
+
+    AudioBuffer* buffer1 = new AudioBuffer( 2, 100 );
+    AudioBuffer* buffer2 = new AudioBuffer( 1, 37 );  // length not aligned to the data alignment
+
+    fillAudioBuffer( buffer1 );
+    fillAudioBuffer( buffer2 );
+
+    std::vector<bankSample> samples = {
+        { "kick", buffer1, 44100 },
+        { "snare drum", buffer2, 22050 }
+    };
+    ASSERT_TRUE( SampleBank::write( file, samples )) << "expected bank to have been written";
+
+    SampleBank* bank = SampleBank::open( file );
+
+    ASSERT_FALSE( bank == nullptr ) << "expected bank to have been opened";
+    ASSERT_EQ( 2, bank->getAmountOfSamples() );
+
+    for ( int i = 0; i < 2; ++i ) {
+        EXPECT_EQ( samples[ i ].identifier, bank->getIdentifier( i ));
+        EXPECT_EQ( samples[ i ].sampleRate, bank->getSampleRate( i ));
+
+        AudioBuffer* source = samples[ i ].buffer;
+        AudioBuffer* buffer = bank->createBuffer( i );
+
+        ASSERT_EQ( source->amountOfChannels, buffer->amountOfChannels );
+        ASSERT_EQ( source->bufferSize, buffer->bufferSize );
+
+        for ( int c = 0; c < source->amountOfChannels; ++c ) {
+            SAMPLE_TYPE* channel = buffer->getBufferForChannel( c );
+
+            EXPECT_EQ( 0, ( uintptr_t ) channel % 64 ) << "expected channel data to be aligned";
+
+            for ( int j = 0; j < source->bufferSize; ++j ) {
+                EXPECT_EQ( source->getBufferForChannel( c )[ j ], channel[ j ] );
+            }
+        }
+        delete buffer;
+    }
+
+    // buffers reference the mapped memory rather than holding a copy
+
+    AudioBuffer* view1 = bank->createBuffer( 0 );
+    AudioBuffer* view2 = bank->createBuffer( 0 );
+
+    EXPECT_EQ( view1->getBufferForChannel( 1 ), view2->getBufferForChannel( 1 ));
+
+    // out of range indices
+
+    EXPECT_TRUE( bank->createBuffer( 2 ) == nullptr );
+    EXPECT_EQ( "", bank->getIdentifier( -1 ));
+
+    delete view1;
+    delete view2;
+    delete bank;
+    delete buffer1;
+    delete buffer2;
+
+    remove( file.c_str() );
+}
+
+TEST( SampleBank, WritingIntoBufferDoesNotAlterFile )
+{
+    std::string file = "samplebank_test_private.mwsb";
+
+    AudioBuffer* source = new AudioBuffer( 1, 16 );
+    fillAudioBuffer( source );
+
+    ASSERT_TRUE( SampleBank::write( file, {{ "foo", source, 44100 }} ));
+
+    SampleBank* bank = SampleBank::open( file );
+    AudioBuffer* buffer = bank->createBuffer( 0 );
+    buffer->silenceBuffers();
+    delete buffer;
+    delete bank;
+
+    bank   = SampleBank::open( file );
+    buffer = bank->createBuffer( 0 );
+
+    for ( int i = 0; i < source->bufferSize; ++i ) {
+        EXPECT_EQ( source->getBufferForChannel( 0 )[ i ], buffer->getBufferForChannel( 0 )[ i ] )
+            << "expected contents of the file to not have been altered";
+    }
+    delete buffer;
+    delete bank;
+    delete source;
+
+    remove( file.c_str() );
+}
+
+TEST( SampleBank, OpenInvalidFile )
+{
+    ASSERT_TRUE( SampleBank::open( "samplebank_test_nonexistent.mwsb" ) == nullptr )
+        << "expected no bank for a non-existing file";
+
+    std::string file = "samplebank_test_invalid.mwsb";
+
+    FILE* fp = fopen( file.c_str(), "wb" );
+    fputs( "this is not a sample bank", fp );
+    fclose( fp );
+
+    ASSERT_TRUE( SampleBank::open( file ) == nullptr ) << "expected no bank for an invalid file";
+
+    // a truncated bank (e.g. interrupted write) should be rejected
+
+    AudioBuffer* source = new AudioBuffer( 2, 1000 );
+    ASSERT_TRUE( SampleBank::write( file, {{ "foo", source, 44100 }} ));
+    delete source;
+
+    truncate( file.c_str(), 1000 );
+
+    ASSERT_TRUE( SampleBank::open( file ) == nullptr ) << "expected no bank for a truncated file";
+
+    remove( file.c_str() );
+}
@@ -1,5 +1,12 @@
 #include "../../utilities/samplemanager.h"
 #include "../../audiobuffer.h"
+#include "../../events/sampleevent.h"
+#include "../../utilities/wavewriter.h"
+#include "../../instruments/baseinstrument.h"
+#include "../../messaging/commandqueue.h"
+#include "../../utilities/eventutility.h"
+#include <atomic>
+#include <thread>
 
 TEST( SampleManager, EmptyByDefault )
 {
@@ -128,3 +135,458 @@ TEST( SampleManager, Flush )
 
     // buffers deleted by SampleManager.flushSamples()
 }
+
+TEST( SampleManager, WriteAndLoadBank )
+{
+    std::string file = "samplemanager_test.mwsb";
+
+    AudioBuffer* buffer1 = new AudioBuffer( 2, 10 );
+    AudioBuffer* buffer2 = new AudioBuffer( 1, 20 );
+
+    fillAudioBuffer( buffer1 );
+    fillAudioBuffer( buffer2 );
+
+    SampleManager::setSample( "foo", buffer1, AudioEngineProps::SAMPLE_RATE );
+    SampleManager::setSample( "bar", buffer2, AudioEngineProps::SAMPLE_RATE / 2 );
+
+    ASSERT_TRUE( SampleManager::writeBank( file )) << "expected bank to have been written";
+
+    // keep a copy of the contents for comparison
+
+    AudioBuffer* expected = buffer1->clone();
+
+    SampleManager::flushSamples();
+
+    ASSERT_FALSE( SampleManager::loadBank( "samplemanager_test_nonexistent.mwsb" ))
+        << "expected non-existing bank to not have been loaded";
+
+    ASSERT_TRUE( SampleManager::loadBank( file )) << "expected bank to have been loaded";
+
+    ASSERT_TRUE( SampleManager::hasSample( "foo" ));
+    ASSERT_TRUE( SampleManager::hasSample( "bar" ));
+
+    EXPECT_EQ( 10, SampleManager::getSampleLength( "foo" ));
+    EXPECT_EQ( 20, SampleManager::getSampleLength( "bar" ));
+    EXPECT_EQ( AudioEngineProps::SAMPLE_RATE / 2, SampleManager::getSampleRateForSample( "bar" ));
+
+    AudioBuffer* sample = SampleManager::getSample( "foo" );
+
+    for ( int c = 0; c < 2; ++c ) {
+        for ( int i = 0; i < 10; ++i ) {
+            EXPECT_EQ( expected->getBufferForChannel( c )[ i ], sample->getBufferForChannel( c )[ i ] );
+        }
+    }
+    delete expected;
+
+    // removing a bank sample only deletes its AudioBuffer, the bank remains mapped until flushed
+
+    SampleManager::removeSample( "bar", true );
+    ASSERT_TRUE( SampleManager::hasSample( "foo" ));
+
+    SampleManager::flushSamples();
+
+    ASSERT_FALSE( SampleManager::hasSample( "foo" ));
+
+    remove( file.c_str() );
+}
+
+TEST( SampleManager, ReferenceCounting )
+{
+    AudioBuffer* buffer = new AudioBuffer( 1, 10 );
+    SampleManager::setSample( "foo", buffer, AudioEngineProps::SAMPLE_RATE );
+
+    EXPECT_EQ( 0, SampleManager::getReferenceCount( "foo" ));
+
+    SampleEvent* event1 = new SampleEvent();
+    SampleEvent* event2 = new SampleEvent();
+
+    event1->setSample( SampleManager::getSample( "foo" ));
+    event2->setSample( SampleManager::getSample( "foo" ));
+
+    EXPECT_EQ( 2, SampleManager::getReferenceCount( "foo" ))
+        << "expected both events to reference the sample";
+
+    // setting the same sample again should not add a reference
+
+    event1->setSample( SampleManager::getSample( "foo" ));
+    EXPECT_EQ( 2, SampleManager::getReferenceCount( "foo" ));
+
+    delete event1;
+
+    EXPECT_EQ( 1, SampleManager::getReferenceCount( "foo" ))
+        << "expected deleted event to have released its reference";
+
+    // removing a referenced sample defers the deletion of its buffer until its last reference is released
+
+    SampleManager::removeSample( "foo", true );
+
+    ASSERT_FALSE( SampleManager::hasSample( "foo" ));
+    EXPECT_EQ( buffer->bufferSize * sizeof( SAMPLE_TYPE ), SampleManager::getMemoryUsage() )
+        << "expected released buffer to remain allocated while referenced";
+
+    EXPECT_EQ( buffer, event2->getBuffer() );
+
+    delete event2; // deletes buffer
+
+    EXPECT_EQ( 0, SampleManager::getMemoryUsage() );
+}
+
+TEST( SampleManager, ReferenceReleasedAfterSwapWhileRendering )
+{
+    AudioBuffer* buffer1 = new AudioBuffer( 1, 10 );
+    AudioBuffer* buffer2 = new AudioBuffer( 1, 20 );
+    SampleManager::setSample( "foo", buffer1, AudioEngineProps::SAMPLE_RATE );
+    SampleManager::setSample( "bar", buffer2, AudioEngineProps::SAMPLE_RATE );
+
+    BaseInstrument* instrument = new BaseInstrument();
+    SampleEvent* event         = new SampleEvent( instrument );
+
+    event->setSample( SampleManager::getSample( "foo" ));
+    event->addToSequencer();
+
+    AudioEngineProps::isRendering.store( true );
+
+    // swapping the sample while rendering doesn't await the render thread
+
+    event->setSample( SampleManager::getSample( "bar" ));
+
+    EXPECT_EQ( buffer1, event->getBuffer() ) << "expected the sample not to be swapped before the render thread applied the swap";
+    EXPECT_EQ( 1, SampleManager::getReferenceCount( "foo" ))
+        << "expected the previous sample to remain referenced until the render thread has applied the swap";
+    EXPECT_EQ( 1, SampleManager::getReferenceCount( "bar" ));
+
+    std::thread renderThread([]() { CommandQueue::flush(); });
+    renderThread.join();
+
+    EXPECT_EQ( buffer2, event->getBuffer() ) << "expected the render thread to have swapped the sample";
+    EXPECT_EQ( 20, event->getEventLength() );
+    EXPECT_TRUE( EventUtility::vectorContainsEvent( instrument->getEvents(), event ))
+        << "expected the event to have remained in the sequencer";
+
+    // the previous sample is released upon the next swap (or the deletion of the event) once the swap has been applied
+
+    event->setSample( SampleManager::getSample( "bar" ));
+
+    EXPECT_EQ( 0, SampleManager::getReferenceCount( "foo" ))
+        << "expected the reference to have been released after the swap was applied";
+
+    // deleting the event awaits the removal by the render thread
+
+    std::atomic<bool> running( true );
+    std::thread renderLoop([ &running ]() {
+        while ( running.load() ) {
+            CommandQueue::flush();
+            std::this_thread::sleep_for( std::chrono::microseconds( 100 ));
+        }
+    });
+
+    delete event;
+
+    EXPECT_EQ( 0, SampleManager::getReferenceCount( "bar" ))
+        << "expected the references to have been released after the removal was applied";
+
+    EXPECT_TRUE( instrument->getEvents()->empty() );
+
+    running.store( false );
+    renderLoop.join();
+
+    AudioEngineProps::isRendering.store( false );
+    CommandQueue::synchronize();
+
+    delete instrument;
+    SampleManager::removeSample( "foo", true );
+    SampleManager::removeSample( "bar", true );
+}
+
+TEST( SampleManager, MemoryUsage )
+{
+    SampleManager::setSample( "foo", new AudioBuffer( 2, 10 ), AudioEngineProps::SAMPLE_RATE );
+    SampleManager::setSample( "bar", new AudioBuffer( 1, 20 ), AudioEngineProps::SAMPLE_RATE );
+
+    EXPECT_EQ( 20 * sizeof( SAMPLE_TYPE ), SampleManager::getMemoryUsage( "foo" ));
+    EXPECT_EQ( 20 * sizeof( SAMPLE_TYPE ), SampleManager::getMemoryUsage( "bar" ));
+    EXPECT_EQ( 0, SampleManager::getMemoryUsage( "baz" ));
+    EXPECT_EQ( 40 * sizeof( SAMPLE_TYPE ), SampleManager::getMemoryUsage() );
+
+    SampleManager::flushSamples();
+
+    EXPECT_EQ( 0, SampleManager::getMemoryUsage() );
+}
+
+TEST( SampleManager, MemoryBudgetEvictsLeastRecentlyUsed )
+{
+    std::string files[ 3 ] = { "samplemanager_test_1.wav", "samplemanager_test_2.wav", "samplemanager_test_3.wav" };
+    std::string ids[ 3 ]   = { "foo", "bar", "baz" };
+
+    // deterministic sample values a quarter step above the 16-bit values they are written as, so
+    // the WAV round trip deviates by a fixed amount (well within a single quantization step)
+
+    AudioBuffer* source = new AudioBuffer( 1, 100 );
+    SAMPLE_TYPE* sourceBuffer = source->getBufferForChannel( 0 );
+
+    for ( int i = 0; i < 100; ++i ) {
+        int value = i * 640 - 32000;
+        sourceBuffer[ i ] = ( value + ( value < 0 ? -.25 : .25 )) / 32767.0;
+    }
+
+    for ( int i = 0; i < 3; ++i ) {
+        WaveWriter::bufferToWAV( files[ i ], source, AudioEngineProps::SAMPLE_RATE );
+        ASSERT_TRUE( SampleManager::loadSample( ids[ i ], files[ i ] ));
+    }
+    ASSERT_FALSE( SampleManager::loadSample( "qux", "samplemanager_test_nonexistent.wav" ))
+        << "expected non-existing file to not have been loaded";
+
+    size_t sampleSize = 100 * sizeof( SAMPLE_TYPE );
+    EXPECT_EQ( sampleSize * 3, SampleManager::getMemoryUsage() );
+
+    // reference "foo" and use "bar" so "baz" becomes the least recently used sample
+
+    SampleEvent* event = new SampleEvent();
+    event->setSample( SampleManager::getSample( "foo" ));
+    SampleManager::getSample( "bar" );
+
+    SampleManager::setMemoryBudget( sampleSize * 2 );
+
+    EXPECT_EQ( sampleSize * 2, SampleManager::getMemoryBudget() );
+    EXPECT_EQ( sampleSize * 2, SampleManager::getMemoryUsage() );
+
+    ASSERT_TRUE( SampleManager::isSampleLoaded( "foo" )) << "expected referenced sample to not have been evicted";
+    ASSERT_TRUE( SampleManager::isSampleLoaded( "bar" )) << "expected recently used sample to not have been evicted";
+    ASSERT_FALSE( SampleManager::isSampleLoaded( "baz" )) << "expected least recently used sample to have been evicted";
+    ASSERT_TRUE( SampleManager::hasSample( "baz" ))       << "expected evicted sample to remain registered";
+    EXPECT_EQ( 100, SampleManager::getSampleLength( "baz" ));
+
+    // requesting the evicted sample reloads it, evicting the least recently used unreferenced sample
+
+    AudioBuffer* reloaded = SampleManager::getSample( "baz" );
+
+    ASSERT_FALSE( reloaded == nullptr ) << "expected evicted sample to have been reloaded";
+    ASSERT_TRUE( SampleManager::isSampleLoaded( "baz" ));
+    ASSERT_TRUE( SampleManager::isSampleLoaded( "foo" ));
+    ASSERT_FALSE( SampleManager::isSampleLoaded( "bar" ));
+    EXPECT_EQ( sampleSize * 2, SampleManager::getMemoryUsage() );
+
+    for ( int i = 0; i < 100; ++i ) {
+        EXPECT_NEAR( source->getBufferForChannel( 0 )[ i ], reloaded->getBufferForChannel( 0 )[ i ], 1.0 / 32767 );
+    }
+
+    // released samples become eligible for eviction
+
+    delete event;
+    SampleManager::getSample( "bar" );
+
+    ASSERT_FALSE( SampleManager::isSampleLoaded( "foo" ));
+    EXPECT_EQ( sampleSize * 2, SampleManager::getMemoryUsage() );
+
+    SampleManager::setMemoryBudget( 0 );
+    SampleManager::flushSamples();
+
+    delete source;
+
+    for ( int i = 0; i < 3; ++i ) {
+        remove( files[ i ].c_str() );
+    }
+}
+
+TEST( SampleManager, CompactSample )
+{
+    AudioBuffer* buffer = fillAudioBuffer( new AudioBuffer( 2, 100 ));
+    AudioBuffer* expected = buffer->clone();
+
+    SampleManager::setSample( "foo", buffer, AudioEngineProps::SAMPLE_RATE );
+
+    ASSERT_FALSE( SampleManager::compactSample( "bar", CompactBuffer::PCM16 ))
+        << "expected non-registered sample not to be compacted";
+
+    EXPECT_EQ( nullptr, SampleManager::getCompactSample( "foo" ))
+        << "expected no CompactBuffer for a non-compacted sample";
+
+    // an event referencing the AudioBuffer keeps it after compacting
+
+    SampleEvent* event = new SampleEvent();
+    event->setSample( SampleManager::getSample( "foo" ));
+
+    ASSERT_TRUE( SampleManager::compactSample( "foo", CompactBuffer::PCM16 ));
+    ASSERT_TRUE( SampleManager::compactSample( "foo", CompactBuffer::PCM16 )) << "expected repeated compacting to succeed";
+    ASSERT_FALSE( SampleManager::compactSample( "foo", CompactBuffer::SINGLE_FLOAT ))
+        << "expected compacted sample not to be converted to another storage type";
+
+    CompactBuffer* compact = SampleManager::getCompactSample( "foo" );
+
+    ASSERT_FALSE( compact == nullptr );
+    EXPECT_EQ( nullptr, SampleManager::getSample( "foo" )) << "expected no AudioBuffer for a compacted sample";
+    EXPECT_EQ( 100, SampleManager::getSampleLength( "foo" ));
+    EXPECT_EQ( compact->getMemoryUsage(), SampleManager::getMemoryUsage( "foo" ));
+    EXPECT_EQ( compact->getMemoryUsage() + 200 * sizeof( SAMPLE_TYPE ), SampleManager::getMemoryUsage() )
+        << "expected the referenced AudioBuffer to remain allocated";
+
+    event->setCompactSample( compact, AudioEngineProps::SAMPLE_RATE );
+
+    EXPECT_EQ( compact->getMemoryUsage(), SampleManager::getMemoryUsage() )
+        << "expected the AudioBuffer to have been released";
+    EXPECT_EQ( 1, SampleManager::getReferenceCount( "foo" ));
+
+    for ( int c = 0; c < 2; ++c ) {
+        for ( int i = 0; i < 100; ++i ) {
+            EXPECT_NEAR( expected->getBufferForChannel( c )[ i ], compact->getSample( c, i ), 1.0 / 32767 );
+        }
+    }
+
+    // compacted samples are decoded when writing a bank
+
+    std::string file = "samplemanager_compact_test.mwsb";
+    ASSERT_TRUE( SampleManager::writeBank( file ));
+
+    delete event;
+    SampleManager::flushSamples();
+
+    ASSERT_TRUE( SampleManager::loadBank( file ));
+    AudioBuffer* loaded = SampleManager::getSample( "foo" );
+
+    ASSERT_FALSE( loaded == nullptr );
+    for ( int c = 0; c < 2; ++c ) {
+        for ( int i = 0; i < 100; ++i ) {
+            EXPECT_NEAR( expected->getBufferForChannel( c )[ i ], loaded->getBufferForChannel( c )[ i ], 1.0 / 32767 );
+        }
+    }
+
+    SampleManager::flushSamples();
+    remove( file.c_str() );
+
+    delete expected;
+}
+
+TEST( SampleManager, CompactSampleEviction )
+{
+    std::string file = "samplemanager_compact_test.wav";
+    AudioBuffer* source = fillAudioBuffer( new AudioBuffer( 1, 100 ));
+    WaveWriter::bufferToWAV( file, source, AudioEngineProps::SAMPLE_RATE );
+
+    ASSERT_TRUE( SampleManager::loadSample( "foo", file ));
+    ASSERT_TRUE( SampleManager::compactSample( "foo", CompactBuffer::HALF_FLOAT ));
+
+    size_t compactSize = SampleManager::getMemoryUsage( "foo" );
+    EXPECT_LT( compactSize, 100 * sizeof( SAMPLE_TYPE ));
+
+    // evicted compact samples are compacted again when reloaded
+
+    SampleManager::setMemoryBudget( 1 );
+    ASSERT_FALSE( SampleManager::isSampleLoaded( "foo" ));
+
+    SampleManager::setMemoryBudget( 0 );
+
+    CompactBuffer* compact = SampleManager::getCompactSample( "foo" );
+
+    ASSERT_FALSE( compact == nullptr );
+    EXPECT_EQ( CompactBuffer::HALF_FLOAT, compact->getStorageType() );
+    EXPECT_EQ( compactSize, SampleManager::getMemoryUsage() );
+
+    SampleManager::flushSamples();
+    remove( file.c_str() );
+
+    delete source;
+}
+
+TEST( SampleManager, ConvertSampleRate )
+{
+    int sourceRate = AudioEngineProps::SAMPLE_RATE / 2;
+
+    AudioBuffer* buffer = fillAudioBuffer( new AudioBuffer( 2, 100 ));
+
+    // samples are not converted unless requested, or when their sample rate equals the engine's
+
+    SampleManager::setSample( "foo", buffer, sourceRate );
+    SampleManager::setSample( "bar", new AudioBuffer( 1, 10 ), AudioEngineProps::SAMPLE_RATE, true );
+
+    EXPECT_FALSE( SampleManager::isConvertingSampleRate( "foo" ));
+    EXPECT_FALSE( SampleManager::isConvertingSampleRate( "bar" ));
+
+    SampleManager::removeSample( "foo", false );
+    SampleManager::flushSamples();
+
+    // samples converted in the background are available at their original sample rate until converted
+
+    SampleManager::setSample( "foo", buffer, sourceRate, true );
+
+    // (the conversions are applied when invoking the SampleManager, reference the source directly as the conversion
+    // may already have completed, once applied, getSample() would return the converted sample)
+
+    SampleEvent* event = new SampleEvent();
+    event->setSample( buffer, sourceRate );
+
+    SampleManager::awaitSampleRateConversions();
+
+    EXPECT_FALSE( SampleManager::isConvertingSampleRate( "foo" ));
+    EXPECT_EQ( AudioEngineProps::SAMPLE_RATE, SampleManager::getSampleRateForSample( "foo" ));
+    EXPECT_EQ( 200, SampleManager::getSampleLength( "foo" ));
+
+    AudioBuffer* converted = SampleManager::getSample( "foo" );
+
+    ASSERT_FALSE( converted == nullptr );
+    ASSERT_FALSE( converted == buffer );
+    EXPECT_EQ( 2, converted->amountOfChannels );
+    EXPECT_EQ( 200, converted->bufferSize );
+    EXPECT_EQ( 0, SampleManager::getReferenceCount( "foo" ));
+
+    // the event referencing the source keeps it until it releases it
+
+    EXPECT_EQ( buffer, event->getBuffer() );
+    EXPECT_EQ(( 200 + 100 ) * 2 * sizeof( SAMPLE_TYPE ), SampleManager::getMemoryUsage() );
+
+    event->setSample( converted );
+
+    EXPECT_EQ( 1.f, event->getPlaybackRate() ) << "expected converted sample to play at the engine's sample rate";
+    EXPECT_EQ( 200 * 2 * sizeof( SAMPLE_TYPE ), SampleManager::getMemoryUsage() );
+
+    delete event;
+
+    // removing a sample while it is being converted discards the conversion
+
+    SampleManager::setSample( "bar", fillAudioBuffer( new AudioBuffer( 1, 1000 )), sourceRate, true );
+    SampleManager::removeSample( "bar", true );
+    SampleManager::awaitSampleRateConversions();
+
+    EXPECT_FALSE( SampleManager::hasSample( "bar" ));
+    EXPECT_EQ( 200 * 2 * sizeof( SAMPLE_TYPE ), SampleManager::getMemoryUsage() );
+
+    SampleManager::flushSamples();
+}
+
+TEST( SampleManager, ConvertSampleRateReloadsEvictedSample )
+{
+    std::string file = "samplemanager_test_convert.wav";
+    int sourceRate   = AudioEngineProps::SAMPLE_RATE / 2;
+
+    AudioBuffer* source = fillAudioBuffer( new AudioBuffer( 1, 100 ));
+    WaveWriter::bufferToWAV( file, source, sourceRate );
+
+    ASSERT_TRUE( SampleManager::loadSample( "foo", file, true ));
+    SampleManager::awaitSampleRateConversions();
+
+    AudioBuffer* converted = SampleManager::getSample( "foo" )->clone();
+
+    EXPECT_EQ( AudioEngineProps::SAMPLE_RATE, SampleManager::getSampleRateForSample( "foo" ));
+    EXPECT_EQ( 200, converted->bufferSize );
+
+    // evicted samples are converted again when reloaded
+
+    SampleManager::setMemoryBudget( 1 );
+    ASSERT_FALSE( SampleManager::isSampleLoaded( "foo" ));
+    SampleManager::setMemoryBudget( 0 );
+
+    AudioBuffer* reloaded = SampleManager::getSample( "foo" );
+
+    ASSERT_FALSE( reloaded == nullptr );
+    ASSERT_EQ( converted->bufferSize, reloaded->bufferSize );
+    EXPECT_EQ( AudioEngineProps::SAMPLE_RATE, SampleManager::getSampleRateForSample( "foo" ));
+
+    for ( int i = 0; i < converted->bufferSize; ++i ) {
+        EXPECT_EQ( converted->getBufferForChannel( 0 )[ i ], reloaded->getBufferForChannel( 0 )[ i ] );
+    }
+
+    SampleManager::flushSamples();
+
+    delete converted;
+    delete source;
+    remove( file.c_str() );
+}
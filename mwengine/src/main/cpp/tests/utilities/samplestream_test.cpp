@@ -0,0 +1,122 @@
+#include "../../utilities/samplestream.h"
+#include <cstdio>
+
+TEST( SampleStream, Open )
+{
+    ASSERT_TRUE( SampleStream::open( "samplestream_test_nonexistent.wav" ) == nullptr )
+        << "expected no stream for a non-existing file";
+
+    std::string file = "samplestream_test.wav";
+    AudioBuffer* contents = createStreamTestFile( file, 50000, 2 );
+
+    SampleStream* stream = SampleStream::open( file );
+
+    ASSERT_FALSE( stream == nullptr ) << "expected stream to have been opened";
+    EXPECT_EQ( 50000, stream->getLength() );
+    EXPECT_EQ( 2, stream->getAmountOfChannels() );
+    EXPECT_EQ( AudioEngineProps::SAMPLE_RATE, stream->getSampleRate() );
+
+    // the head is available immediately
+
+    AudioBuffer* buffer = new AudioBuffer( 2, 1 );
+
+    EXPECT_EQ( 0, stream->mixFrames( buffer, 0, 100, 1, 1.f )) << "expected head to have been read synchronously";
+    EXPECT_FLOAT_EQ( contents->getBufferForChannel( 1 )[ 100 ], buffer->getBufferForChannel( 1 )[ 0 ] );
+
+    // changing the range start reads the head of the range synchronously
+
+    stream->setRange( 40000, 49999 );
+    buffer->silenceBuffers();
+
+    EXPECT_EQ( 0, stream->mixFrames( buffer, 0, 5000, 1, 1.f )) << "expected head of the range to have been read synchronously";
+    EXPECT_FLOAT_EQ( contents->getBufferForChannel( 0 )[ 45000 ], buffer->getBufferForChannel( 0 )[ 0 ] );
+
+    delete buffer;
+    delete stream;
+    delete contents;
+
+    remove( file.c_str() );
+}
+
+TEST( SampleStream, GetSourceFrame )
+{
+    std::string file = "samplestream_test_frames.wav";
+    AudioBuffer* contents = createStreamTestFile( file, 1000, 1 );
+
+    SampleStream* stream = SampleStream::open( file );
+
+    EXPECT_EQ( 0,   stream->getSourceFrame( 0 ));
+    EXPECT_EQ( 999, stream->getSourceFrame( 999 ));
+    EXPECT_EQ( -1,  stream->getSourceFrame( 1000 )) << "expected no frame beyond the range";
+    EXPECT_EQ( -1,  stream->getSourceFrame( -1 ));
+
+    stream->setRange( 100, 599 );
+
+    EXPECT_EQ( 100, stream->getSourceFrame( 0 ));
+    EXPECT_EQ( 599, stream->getSourceFrame( 499 ));
+    EXPECT_EQ( -1,  stream->getSourceFrame( 500 ));
+
+    // loop the region between 400 and 499 (range end is not reached)
+
+    stream->setLoop( true, 400, 499 );
+
+    EXPECT_EQ( 499, stream->getSourceFrame( 399 ));
+    EXPECT_EQ( 400, stream->getSourceFrame( 400 ));
+    EXPECT_EQ( 499, stream->getSourceFrame( 499 ));
+    EXPECT_EQ( 400, stream->getSourceFrame( 500 ));
+    EXPECT_EQ( 450, stream->getSourceFrame( 10050 ));
+
+    // loop offsets are kept within the range
+
+    stream->setLoop( true, 0, 999 );
+
+    EXPECT_EQ( 599, stream->getSourceFrame( 499 ));
+    EXPECT_EQ( 100, stream->getSourceFrame( 500 ));
+
+    delete stream;
+    delete contents;
+
+    remove( file.c_str() );
+}
+
+TEST( SampleStream, MixFrames )
+{
+    std::string file = "samplestream_test_mix.wav";
+    AudioBuffer* contents = createStreamTestFile( file, 1000, 1 );
+
+    SampleStream* stream = SampleStream::open( file );
+    stream->setLoop( true, 400, 499 );
+
+    // mix a range spanning the loop end (which wraps back to the loop start) at half volume
+
+    int amountOfFrames  = 300;
+    int playbackOffset  = 350;
+    AudioBuffer* buffer  = new AudioBuffer( 2, amountOfFrames + 10 );
+
+    EXPECT_EQ( 0, stream->mixFrames( buffer, 10, playbackOffset, amountOfFrames, .5f ));
+
+    for ( int i = 0; i < buffer->bufferSize; ++i )
+    {
+        for ( int c = 0; c < buffer->amountOfChannels; ++c )
+        {
+            SAMPLE_TYPE expected = i < 10 ? 0.0 : contents->getBufferForChannel( 0 )[ stream->getSourceFrame( playbackOffset + i - 10 ) ] * .5f;
+            EXPECT_FLOAT_EQ( expected, buffer->getBufferForChannel( c )[ i ] )
+                << "expected mono source to have been mixed into channel " << c << " at index " << i;
+        }
+    }
+
+    // frames beyond a non-looping range are not mixed (nor reported as missing)
+
+    stream->setLoop( false, 400, 499 );
+    buffer->silenceBuffers();
+
+    EXPECT_EQ( 0, stream->mixFrames( buffer, 0, 990, amountOfFrames, 1.f ));
+    EXPECT_FLOAT_EQ( contents->getBufferForChannel( 0 )[ 999 ], buffer->getBufferForChannel( 0 )[ 9 ] );
+    EXPECT_FLOAT_EQ( 0.0, buffer->getBufferForChannel( 0 )[ 10 ] );
+
+    delete buffer;
+    delete stream;
+    delete contents;
+
+    remove( file.c_str() );
+}
@@ -0,0 +1,132 @@
+#include "../../utilities/spscqueue.h"
+#include <thread>
+
+TEST( SPSCQueue, Constructor )
+{
+    SPSCQueue<int> queue( 100 );
+
+    EXPECT_EQ( 128, queue.getCapacity() )
+        << "expected capacity to be rounded up to the next power of two";
+
+    EXPECT_EQ( 0, queue.getSize() )
+        << "expected queue to be empty upon construction";
+
+    ASSERT_TRUE( queue.isEmpty() )
+        << "expected queue to be empty upon construction";
+
+    ASSERT_TRUE( queue.peek() == nullptr )
+        << "expected no item to be available upon construction";
+}
+
+TEST( SPSCQueue, EnqueueDequeue )
+{
+    SPSCQueue<int> queue( 8 );
+    int value;
+
+    for ( int i = 0; i < 8; ++i ) {
+        ASSERT_TRUE( queue.enqueue( i ))
+            << "expected item " << i << " to be enqueued";
+    }
+
+    ASSERT_FALSE( queue.enqueue( 8 ))
+        << "expected enqueue to fail when the queue is full";
+
+    EXPECT_EQ( 8, queue.getSize() )
+        << "expected queue size to equal its capacity";
+
+    EXPECT_EQ( 0, *queue.peek() )
+        << "expected peek to return the first enqueued item";
+
+    for ( int i = 0; i < 8; ++i ) {
+        ASSERT_TRUE( queue.dequeue( value ))
+            << "expected item " << i << " to be dequeued";
+
+        EXPECT_EQ( i, value )
+            << "expected items to be dequeued in order of insertion";
+    }
+
+    ASSERT_FALSE( queue.dequeue( value ))
+        << "expected dequeue to fail when the queue is empty";
+
+    // wrapping around the end of the storage
+
+    for ( int i = 0; i < 5; ++i ) {
+        queue.enqueue( i );
+    }
+    for ( int i = 0; i < 5; ++i ) {
+        queue.dequeue( value );
+        EXPECT_EQ( i, value ) << "expected items to be dequeued in order after wrapping";
+    }
+    ASSERT_TRUE( queue.isEmpty() );
+}
+
+TEST( SPSCQueue, EnqueueDequeueBlocks )
+{
+    SPSCQueue<float> queue( 8 );
+
+    float input[]  = { 0.f, 1.f, 2.f, 3.f, 4.f, 5.f };
+    float output[ 8 ];
+
+    ASSERT_TRUE( queue.enqueue( input, 6 ))
+        << "expected block to be enqueued";
+
+    ASSERT_FALSE( queue.enqueue( input, 3 ))
+        << "expected enqueue to fail when the queue cannot hold the full block";
+
+    EXPECT_EQ( 6, queue.getSize() )
+        << "expected a failed enqueue not to have enqueued any items";
+
+    EXPECT_EQ( 4, queue.dequeue( output, 4 ))
+        << "expected the requested amount of items to be dequeued";
+
+    // wrapping around the end of the storage
+
+    ASSERT_TRUE( queue.enqueue( input, 6 ))
+        << "expected block to be enqueued after dequeueing";
+
+    EXPECT_EQ( 8, queue.dequeue( output, 8 ))
+        << "expected all remaining items to be dequeued";
+
+    float expected[] = { 4.f, 5.f, 0.f, 1.f, 2.f, 3.f, 4.f, 5.f };
+
+    for ( int i = 0; i < 8; ++i ) {
+        EXPECT_EQ( expected[ i ], output[ i ] ) << "expected items to be dequeued in order at index " << i;
+    }
+    EXPECT_EQ( 0, queue.dequeue( output, 8 ))
+        << "expected no items to be dequeued when the queue is empty";
+}
+
+TEST( SPSCQueue, ConcurrentOrdering )
+{
+    SPSCQueue<int> queue( 64 );
+
+    const int amount = 100000;
+
+    std::thread producer([ &queue ]() {
+        for ( int i = 0; i < amount; ++i ) {
+            while ( !queue.enqueue( i )) {
+                std::this_thread::yield();
+            }
+        }
+    });
+
+    int expected = 0, value;
+    bool ordered = true;
+
+    while ( expected < amount )
+    {
+        if ( !queue.dequeue( value )) {
+            std::this_thread::yield();
+            continue;
+        }
+        ordered = ordered && ( value == expected );
+        ++expected;
+    }
+    producer.join();
+
+    ASSERT_TRUE( ordered )
+        << "expected all items to be consumed in the order they were produced";
+
+    ASSERT_TRUE( queue.isEmpty() )
+        << "expected queue to be empty after consuming all items";
+}
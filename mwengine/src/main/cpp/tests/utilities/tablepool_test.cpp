@@ -45,3 +45,21 @@ TEST( TablePool, RemoveTable )
 
     delete table;
 }
+
+TEST( TablePool, SetTableGeneratesMipmaps )
+{
+    WaveTable* table      = new WaveTable( 128, 440.f );
+    WaveTable* emptyTable = new WaveTable( 128, 440.f );
+
+    for ( int i = 0; i < table->tableLength; ++i )
+        table->getBuffer()[ i ] = randomSample( -1.0, 1.0 );
+
+    TablePool::setTable( table, "foo" );
+    TablePool::setTable( emptyTable, "bar" );
+
+    ASSERT_TRUE( table->hasMipmaps() ) << "expected mipmaps to have been generated for the pooled table";
+    ASSERT_FALSE( emptyTable->hasMipmaps() ) << "expected no mipmaps to have been generated for an empty table";
+
+    TablePool::removeTable( "foo", true );
+    TablePool::removeTable( "bar", true );
+}
@@ -0,0 +1,360 @@
+#include "../../utilities/wavereader.h"
+#include "../../utilities/wavewriter.h"
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+
+// assembles a WAV file in memory using given format and (interleaved) sample data, when
+// extensible is true the WAVE_FORMAT_EXTENSIBLE header is used, when withMetadata is true
+// additional (odd sized) chunks are placed before the format and data chunks
+
+std::vector<char> createWAVData( int audioFormat, int channels, int sampleRate, int bitsPerSample,
+                                 const std::vector<char>& samples, bool extensible = false, bool withMetadata = false )
+{
+    std::vector<char> out;
+
+    auto write = [ &out ]( uint32_t value, int size ) {
+        for ( int i = 0; i < size; ++i ) {
+            out.push_back(( char ) (( value >> ( i * 8 )) & 0xFF ));
+        }
+    };
+    auto writeTag = [ &out ]( const char* tag ) {
+        out.insert( out.end(), tag, tag + 4 );
+    };
+
+    writeTag( "RIFF" );
+    write( 0, 4 ); // updated below
+    writeTag( "WAVE" );
+
+    if ( withMetadata ) {
+        writeTag( "LIST" );
+        write( 5, 4 );
+        out.insert( out.end(), { 'I', 'N', 'F', 'O', 'x' });
+        out.push_back( 0 ); // pad byte
+    }
+
+    int blockAlign = channels * ( bitsPerSample / 8 );
+
+    writeTag( "fmt " );
+    write( extensible ? 40 : 16, 4 );
+    write( extensible ? 0xFFFE : audioFormat, 2 );
+    write( channels, 2 );
+    write( sampleRate, 4 );
+    write( sampleRate * blockAlign, 4 );
+    write( blockAlign, 2 );
+    write( bitsPerSample, 2 );
+
+    if ( extensible ) {
+        write( 22, 2 );             // extension size
+        write( bitsPerSample, 2 );  // valid bits per sample
+        write( 0, 4 );              // channel mask
+        write( audioFormat, 2 );    // sub format GUID (first two bytes)
+        for ( int i = 0; i < 14; ++i ) {
+            out.push_back( 0 );
+        }
+    }
+
+    if ( withMetadata ) {
+        writeTag( "fact" );
+        write( 4, 4 );
+        write( ( uint32_t ) ( samples.size() / blockAlign ), 4 );
+    }
+
+    writeTag( "data" );
+    write(( uint32_t ) samples.size(), 4 );
+    out.insert( out.end(), samples.begin(), samples.end() );
+
+    uint32_t riffSize = ( uint32_t ) out.size() - 8;
+    memcpy( out.data() + 4, &riffSize, 4 );
+
+    return out;
+}
+
+template <typename T>
+std::vector<char> toBytes( const std::vector<T>& samples )
+{
+    std::vector<char> out( samples.size() * sizeof( T ));
+    memcpy( out.data(), samples.data(), out.size() );
+    return out;
+}
+
+void writeFile( const std::string& file, const std::vector<char>& data )
+{
+    FILE* fp = fopen( file.c_str(), "wb" );
+    fwrite( data.data(), 1, data.size(), fp );
+    fclose( fp );
+}
+
+TEST( WaveReader, FileToBufferInvalidFile )
+{
+    waveFile WAV = WaveReader::fileToBuffer( "wavereader_test_nonexistent.wav" );
+    ASSERT_TRUE( WAV.buffer == nullptr ) << "expected no buffer for a non-existing file";
+
+    std::string file = "wavereader_test_invalid.wav";
+    writeFile( file, { 'n', 'o', 't', ' ', 'a', ' ', 'w', 'a', 'v', 'e' });
+
+    WAV = WaveReader::fileToBuffer( file );
+    ASSERT_TRUE( WAV.buffer == nullptr ) << "expected no buffer for an invalid file";
+
+    remove( file.c_str() );
+}
+
+TEST( WaveReader, FileToBuffer16bit )
+{
+    std::string file = "wavereader_test_16bit.wav";
+
+    // stereo content that is long enough to be processed by the vectorized conversion (and a remainder)
+
+    int amountOfFrames = 4099;
+    std::vector<int16_t> samples( amountOfFrames * 2 );
+    for ( int i = 0; i < amountOfFrames; ++i ) {
+        samples[ i * 2 ]     = ( int16_t ) (( i % 200 ) * 100 - 10000 );
+        samples[ i * 2 + 1 ] = ( int16_t ) -( i % 327 ) * 100;
+    }
+    writeFile( file, createWAVData( 1, 2, 48000, 16, toBytes( samples )));
+
+    waveFile WAV = WaveReader::fileToBuffer( file );
+
+    ASSERT_FALSE( WAV.buffer == nullptr ) << "expected buffer to have been read";
+    EXPECT_EQ( 48000, WAV.sampleRate );
+    EXPECT_EQ( 2, WAV.buffer->amountOfChannels );
+    EXPECT_EQ( amountOfFrames, WAV.buffer->bufferSize );
+
+    for ( int i = 0; i < amountOfFrames; ++i ) {
+        EXPECT_NEAR( samples[ i * 2 ] / 32767.0,     WAV.buffer->getBufferForChannel( 0 )[ i ], 0.00001 );
+        EXPECT_NEAR( samples[ i * 2 + 1 ] / 32767.0, WAV.buffer->getBufferForChannel( 1 )[ i ], 0.00001 );
+    }
+    delete WAV.buffer;
+    remove( file.c_str() );
+}
+
+TEST( WaveReader, FileToBuffer8bit )
+{
+    std::string file = "wavereader_test_8bit.wav";
+    writeFile( file, createWAVData( 1, 1, 22050, 8, { ( char ) 0, ( char ) 64, ( char ) 128, ( char ) 192 }));
+
+    waveFile WAV = WaveReader::fileToBuffer( file );
+
+    ASSERT_FALSE( WAV.buffer == nullptr ) << "expected buffer to have been read";
+    ASSERT_EQ( 4, WAV.buffer->bufferSize );
+
+    // 8-bit WAV data is unsigned, 128 representing silence
+
+    SAMPLE_TYPE* buffer = WAV.buffer->getBufferForChannel( 0 );
+    EXPECT_FLOAT_EQ( -1.0,  buffer[ 0 ] );
+    EXPECT_FLOAT_EQ( -0.5,  buffer[ 1 ] );
+    EXPECT_FLOAT_EQ( 0.0,   buffer[ 2 ] );
+    EXPECT_FLOAT_EQ( 0.5,   buffer[ 3 ] );
+
+    delete WAV.buffer;
+    remove( file.c_str() );
+}
+
+TEST( WaveReader, FileToBuffer24bit )
+{
+    std::string file = "wavereader_test_24bit.wav";
+
+    std::vector<int32_t> values = { 0, 8388607, -8388607, 4194304, -4194304, -1 };
+    std::vector<char> samples;
+    for ( int32_t value : values ) {
+        samples.push_back(( char ) ( value & 0xFF ));
+        samples.push_back(( char ) (( value >> 8 ) & 0xFF ));
+        samples.push_back(( char ) (( value >> 16 ) & 0xFF ));
+    }
+    writeFile( file, createWAVData( 1, 1, 44100, 24, samples ));
+
+    waveFile WAV = WaveReader::fileToBuffer( file );
+
+    ASSERT_FALSE( WAV.buffer == nullptr ) << "expected buffer to have been read";
+    ASSERT_EQ( values.size(), WAV.buffer->bufferSize );
+
+    for ( size_t i = 0; i < values.size(); ++i ) {
+        EXPECT_NEAR( values[ i ] / 8388607.0, WAV.buffer->getBufferForChannel( 0 )[ i ], 0.000001 )
+            << "expected sample " << i << " to have been sign extended and scaled";
+    }
+    delete WAV.buffer;
+    remove( file.c_str() );
+}
+
+TEST( WaveReader, FileToBuffer32bit )
+{
+    std::string file = "wavereader_test_32bit.wav";
+
+    std::vector<int32_t> samples = { 0, 2147483647, -2147483647, 1073741824, -1073741824, 536870912, 0, 1 };
+    writeFile( file, createWAVData( 1, 1, 44100, 32, toBytes( samples )));
+
+    waveFile WAV = WaveReader::fileToBuffer( file );
+
+    ASSERT_FALSE( WAV.buffer == nullptr ) << "expected buffer to have been read";
+    ASSERT_EQ( samples.size(), WAV.buffer->bufferSize );
+
+    for ( size_t i = 0; i < samples.size(); ++i ) {
+        EXPECT_NEAR( samples[ i ] / 2147483647.0, WAV.buffer->getBufferForChannel( 0 )[ i ], 0.000001 );
+#if PRECISION == 2
+        // double precision engines retain the full precision of the 32-bit samples
+        EXPECT_DOUBLE_EQ( samples[ i ] * ( 1.0 / 2147483647.0 ), WAV.buffer->getBufferForChannel( 0 )[ i ] );
+#endif
+    }
+    delete WAV.buffer;
+    remove( file.c_str() );
+}
+
+TEST( WaveReader, FileToBufferFloat )
+{
+    std::string file = "wavereader_test_float.wav";
+
+    std::vector<float> samples = { 0.f, 1.f, -1.f, .5f, -.5f, .25f, -.25f, .125f, -.125f, .75f, .1f };
+    writeFile( file, createWAVData( 3, 1, 96000, 32, toBytes( samples )));
+
+    waveFile WAV = WaveReader::fileToBuffer( file );
+
+    ASSERT_FALSE( WAV.buffer == nullptr ) << "expected buffer to have been read";
+    EXPECT_EQ( 96000, WAV.sampleRate );
+    ASSERT_EQ( samples.size(), WAV.buffer->bufferSize );
+
+    for ( size_t i = 0; i < samples.size(); ++i ) {
+        EXPECT_FLOAT_EQ( samples[ i ], WAV.buffer->getBufferForChannel( 0 )[ i ] );
+    }
+    delete WAV.buffer;
+
+    // 64-bit float
+
+    std::vector<double> doubleSamples = { 0.0, 1.0, -1.0, 0.5, -0.25 };
+    writeFile( file, createWAVData( 3, 1, 44100, 64, toBytes( doubleSamples )));
+
+    WAV = WaveReader::fileToBuffer( file );
+
+    ASSERT_FALSE( WAV.buffer == nullptr ) << "expected buffer to have been read";
+    ASSERT_EQ( doubleSamples.size(), WAV.buffer->bufferSize );
+
+    for ( size_t i = 0; i < doubleSamples.size(); ++i ) {
+        EXPECT_FLOAT_EQ( doubleSamples[ i ], WAV.buffer->getBufferForChannel( 0 )[ i ] );
+    }
+    delete WAV.buffer;
+    remove( file.c_str() );
+}
+
+TEST( WaveReader, FileToBufferExtensibleWithMetadata )
+{
+    std::string file = "wavereader_test_extensible.wav";
+
+    // multi channel content (deinterleaved at the channel stride)
+
+    std::vector<float> samples;
+    for ( int i = 0; i < 10; ++i ) {
+        samples.push_back(( float ) i / 10.f );
+        samples.push_back(( float ) -i / 10.f );
+        samples.push_back(( float ) i / 20.f );
+    }
+    writeFile( file, createWAVData( 3, 3, 44100, 32, toBytes( samples ), true, true ));
+
+    waveFile WAV = WaveReader::fileToBuffer( file );
+
+    ASSERT_FALSE( WAV.buffer == nullptr ) << "expected buffer to have been read";
+    ASSERT_EQ( 3, WAV.buffer->amountOfChannels );
+    ASSERT_EQ( 10, WAV.buffer->bufferSize );
+
+    for ( int i = 0; i < 10; ++i ) {
+        EXPECT_FLOAT_EQ( samples[ i * 3 ],     WAV.buffer->getBufferForChannel( 0 )[ i ] );
+        EXPECT_FLOAT_EQ( samples[ i * 3 + 1 ], WAV.buffer->getBufferForChannel( 1 )[ i ] );
+        EXPECT_FLOAT_EQ( samples[ i * 3 + 2 ], WAV.buffer->getBufferForChannel( 2 )[ i ] );
+    }
+    delete WAV.buffer;
+    remove( file.c_str() );
+}
+
+TEST( WaveReader, FileToBufferUnsupportedFormat )
+{
+    std::string file = "wavereader_test_unsupported.wav";
+
+    // 12-bit PCM
+
+    writeFile( file, createWAVData( 1, 1, 44100, 12, { 0, 0, 0, 0 }));
+    ASSERT_TRUE( WaveReader::fileToBuffer( file ).buffer == nullptr ) << "expected unsupported bit depth to be rejected";
+
+    // A-law
+
+    writeFile( file, createWAVData( 6, 1, 44100, 8, { 0, 0, 0, 0 }));
+    ASSERT_TRUE( WaveReader::fileToBuffer( file ).buffer == nullptr ) << "expected unsupported format to be rejected";
+
+    remove( file.c_str() );
+}
+
+TEST( WaveReader, FileToFormat )
+{
+    std::string file = "wavereader_test_format.wav";
+
+    std::vector<int16_t> samples( 100, 0 );
+    writeFile( file, createWAVData( 1, 2, 32000, 16, toBytes( samples ), false, true ));
+
+    waveFormat format;
+    ASSERT_TRUE( WaveReader::fileToFormat( file, format ));
+
+    EXPECT_EQ( 1,     format.audioFormat );
+    EXPECT_EQ( 2,     format.amountOfChannels );
+    EXPECT_EQ( 32000, format.sampleRate );
+    EXPECT_EQ( 16,    format.bitsPerSample );
+    EXPECT_EQ( 200,   format.dataSize );
+
+    // data offset is located after the RIFF header, the LIST, fmt and fact chunks and the data chunk header
+
+    EXPECT_EQ( 12 + 14 + 24 + 12 + 8, format.dataOffset );
+
+    remove( file.c_str() );
+}
+
+TEST( WaveReader, ByteArrayToBuffer )
+{
+    std::vector<int16_t> samples = { 0, 16384, -16384, 32767, -32767 };
+
+    waveFile WAV = WaveReader::byteArrayToBuffer( createWAVData( 1, 1, 44100, 16, toBytes( samples )));
+
+    ASSERT_FALSE( WAV.buffer == nullptr ) << "expected buffer to have been read";
+    ASSERT_EQ( samples.size(), WAV.buffer->bufferSize );
+
+    for ( size_t i = 0; i < samples.size(); ++i ) {
+        EXPECT_NEAR( samples[ i ] / 32767.0, WAV.buffer->getBufferForChannel( 0 )[ i ], 0.00001 );
+    }
+    delete WAV.buffer;
+
+    // truncated data chunk (e.g. interrupted download) is read up until the available data
+
+    std::vector<char> data = createWAVData( 1, 1, 44100, 16, toBytes( samples ));
+    data.resize( data.size() - 4 );
+
+    WAV = WaveReader::byteArrayToBuffer( data );
+
+    ASSERT_FALSE( WAV.buffer == nullptr ) << "expected buffer to have been read";
+    EXPECT_EQ( samples.size() - 2, WAV.buffer->bufferSize );
+
+    delete WAV.buffer;
+}
+
+TEST( WaveReader, WriteAndReadBuffer )
+{
+    std::string file = "wavereader_test_roundtrip.wav";
+
+    AudioBuffer* buffer = new AudioBuffer( 2, 1000 );
+    for ( int i = 0; i < 1000; ++i ) {
+        buffer->getBufferForChannel( 0 )[ i ] = ( SAMPLE_TYPE ) sin( i * 0.05 ) * 0.8;
+        buffer->getBufferForChannel( 1 )[ i ] = ( SAMPLE_TYPE ) cos( i * 0.03 ) * 0.5;
+    }
+    WaveWriter::bufferToWAV( file, buffer, 44100 );
+
+    waveFile WAV = WaveReader::fileToBuffer( file );
+
+    ASSERT_FALSE( WAV.buffer == nullptr ) << "expected written file to have been read";
+    ASSERT_EQ( 2, WAV.buffer->amountOfChannels );
+    ASSERT_EQ( 1000, WAV.buffer->bufferSize );
+
+    // written as 16-bit PCM, allow for the quantization error
+
+    for ( int c = 0; c < 2; ++c ) {
+        for ( int i = 0; i < 1000; ++i ) {
+            EXPECT_NEAR( buffer->getBufferForChannel( c )[ i ], WAV.buffer->getBufferForChannel( c )[ i ], 0.0001 );
+        }
+    }
+    delete buffer;
+    delete WAV.buffer;
+    remove( file.c_str() );
+}
@@ -183,3 +183,61 @@ TEST( WaveTable, Clone )
     delete table;
     delete clone;
 }
+
+TEST( WaveTable, Mipmaps )
+{
+    WaveTable* table = new WaveTable( 16, 440.f );
+
+    ASSERT_FALSE( table->hasMipmaps() )
+        << "expected WaveTable to have no mipmaps upon construction";
+
+    // 8 harmonics require mipmaps holding 8, 4, 2 and 1 harmonic(s)
+
+    int amount = 4, length = 64;
+    SAMPLE_TYPE* mipmaps = new SAMPLE_TYPE[ amount * length ];
+
+    for ( int i = 0; i < amount * length; ++i )
+        mipmaps[ i ] = randomSample( -1.0, 1.0 );
+
+    table->setMipmaps( mipmaps, amount, length, 8 );
+
+    ASSERT_TRUE( table->hasMipmaps() );
+    EXPECT_EQ( amount, table->getMipmapAmount() );
+    EXPECT_EQ( length, table->getMipmapLength() );
+    EXPECT_EQ( 8, table->getMaxHarmonics() );
+
+    // mipmap selection (harmonics times increment should remain below the Nyquist frequency)
+
+    EXPECT_EQ( mipmaps, table->getMipmapForIncrement( 0.01 ));
+    EXPECT_EQ( mipmaps, table->getMipmapForIncrement( 0.0625 ));
+    EXPECT_EQ( mipmaps + length, table->getMipmapForIncrement( 0.1 ));
+    EXPECT_EQ( mipmaps + length * 2, table->getMipmapForIncrement( 0.2 ));
+    EXPECT_EQ( mipmaps + length * 3, table->getMipmapForIncrement( 0.4 ));
+    EXPECT_EQ( mipmaps + length * 3, table->getMipmapForIncrement( 0.8 ))
+        << "expected the last mipmap to be used for frequencies above the Nyquist frequency";
+
+    // clones should hold a copy of the mipmaps
+
+    WaveTable* clone = table->clone();
+
+    ASSERT_TRUE( clone->hasMipmaps() );
+    EXPECT_EQ( amount, clone->getMipmapAmount() );
+    EXPECT_EQ( length, clone->getMipmapLength() );
+
+    SAMPLE_TYPE* clonedMipmaps = clone->getMipmapForIncrement( 0.0 );
+
+    ASSERT_FALSE( clonedMipmaps == mipmaps );
+
+    for ( int i = 0; i < amount * length; ++i )
+        EXPECT_EQ( mipmaps[ i ], clonedMipmaps[ i ] );
+
+    // setting a new buffer invalidates the mipmaps
+
+    table->setBuffer( new SAMPLE_TYPE[ table->tableLength ]);
+
+    ASSERT_FALSE( table->hasMipmaps() )
+        << "expected mipmaps to have been cleared after setting a new buffer";
+
+    delete table;
+    delete clone;
+}
@@ -0,0 +1,40 @@
+#include "../workerpool.h"
+#include <chrono>
+#include <thread>
+
+namespace {
+    void countIndex( size_t index, void* data )
+    {
+        static_cast<std::atomic<int>*>( data )[ index ].fetch_add( 1 );
+    }
+}
+
+TEST( WorkerPool, RunProcessesEachIndexOnce )
+{
+    WorkerPool* pool = new WorkerPool( 3, std::vector<int>());
+
+    EXPECT_EQ( 3, pool->getAmountOfWorkers() );
+
+    const size_t amount = 37;
+    std::atomic<int> counts[ amount ];
+
+    for ( int run = 0; run < 50; ++run )
+    {
+        for ( size_t i = 0; i < amount; ++i ) {
+            counts[ i ].store( 0 );
+        }
+
+        // allow the workers to park in between some of the runs
+
+        if ( run % 10 == 0 ) {
+            std::this_thread::sleep_for( std::chrono::milliseconds( 5 ));
+        }
+
+        pool->run( countIndex, counts, amount );
+
+        for ( size_t i = 0; i < amount; ++i ) {
+            ASSERT_EQ( 1, counts[ i ].load() ) << "expected index " << i << " to have been processed once in run " << run;
+        }
+    }
+    delete pool;
+}
@@ -38,7 +38,7 @@ bool AudioRenderer::renderEvent( const std::string& outputFilename, BaseAudioEve
     // and adding the tail the processors can optionally add to the signal
 
     if ( chain != nullptr ) {
-        auto processors = chain->getActiveProcessors();
+        auto& processors = chain->getActiveProcessors();
         for ( auto const &processor : processors ) {
             bufferSize += processor->addedDurationInSamples();
         }
@@ -53,7 +53,7 @@ bool AudioRenderer::renderEvent( const std::string& outputFilename, BaseAudioEve
     // 3. apply the processing chain
 
     if ( chain != nullptr ) {
-        auto processors = chain->getActiveProcessors();
+        auto& processors = chain->getActiveProcessors();
         bool isMono = outputBuffer->amountOfChannels == 1;
         for ( auto &processor : processors ) {
             processor->process( outputBuffer, isMono );
@@ -22,15 +22,24 @@
  */
 #include "bufferpool.h"
 #include <utilities/bufferutility.h>
+#include <mutex>
 
 namespace MWEngine {
 namespace BufferPool
 {
+    std::atomic<RingBuffer*>             _ringBuffers[ MAX_RING_BUFFERS ];
+    std::atomic<int>                     _availableRingBuffers { 0 };
+    std::atomic<int>                     _totalRingBuffers { 0 };
     std::map<unsigned int, SAMPLE_TYPE*> _silentBufferMap;
-    ringMap                              _eventBufferMap;
+
+    // serializes the control threads mutating the pool and the silent buffer map (never acquired by the render thread)
+
+    std::mutex _controlMutex;
 
     SAMPLE_TYPE* getSilentBuffer( int aBufferSize )
     {
+        std::lock_guard<std::mutex> guard( _controlMutex );
+
         // retrieve buffer from map if existed
 
         std::map<unsigned int, SAMPLE_TYPE*>::iterator it = _silentBufferMap.find( aBufferSize );
@@ -47,71 +56,121 @@ namespace BufferPool
         }
     }
 
-    RingBuffer* getRingBufferForEvent( BaseSynthEvent* aEvent, float aFrequency )
+    void reserveRingBuffers( int amount )
     {
-        // retrieve eventMap from map if existed
+        std::lock_guard<std::mutex> guard( _controlMutex );
 
-        std::map<unsigned int, innerRingMap>::iterator it = _eventBufferMap.find( aEvent->instanceId );
-        innerRingMap eventMap;
+        int capacity = AudioEngineProps::SAMPLE_RATE / RING_BUFFER_MIN_FREQUENCY;
 
-        if ( it != _eventBufferMap.end())
+        while ( _availableRingBuffers.load() < amount && _totalRingBuffers.load() < MAX_RING_BUFFERS )
         {
-            eventMap = it->second;
+            _totalRingBuffers.fetch_add( 1 );
+            releaseRingBuffer( new RingBuffer( capacity ));
         }
-        else
+    }
+
+    RingBuffer* acquireRingBuffer()
+    {
+        if ( _availableRingBuffers.load( std::memory_order_acquire ) <= 0 ) {
+            return nullptr;
+        }
+
+        // each slot is emptied through an atomic exchange, a ring buffer can thus only be acquired once
+
+        for ( int i = 0; i < MAX_RING_BUFFERS; ++i )
         {
-            innerRingMap inner = innerRingMap();
-            /*if (*/ _eventBufferMap.insert( std::make_pair( aEvent->instanceId, inner ));//.second )
-            //{
-                it = _eventBufferMap.find( aEvent->instanceId );
-                eventMap = it->second;
-            //}
+            if ( _ringBuffers[ i ].load( std::memory_order_relaxed ) == nullptr ) {
+                continue;
+            }
+            RingBuffer* ringBuffer = _ringBuffers[ i ].exchange( nullptr, std::memory_order_acq_rel );
+
+            if ( ringBuffer != nullptr ) {
+                _availableRingBuffers.fetch_sub( 1, std::memory_order_release );
+                return ringBuffer;
+            }
         }
+        return nullptr;
+    }
 
-        // use integer value of frequency for map lookup (should be fine for
-        // everything but the most microtonal requests !! )
+    void releaseRingBuffer( RingBuffer* ringBuffer )
+    {
+        // the pool holds a slot for every ring buffer it has allocated
 
-        unsigned int frequency = ( unsigned int ) aFrequency;
+        for ( int i = 0; i < MAX_RING_BUFFERS; ++i )
+        {
+            RingBuffer* expected = nullptr;
+
+            if ( _ringBuffers[ i ].compare_exchange_strong( expected, ringBuffer, std::memory_order_acq_rel )) {
+                _availableRingBuffers.fetch_add( 1, std::memory_order_release );
+                return;
+            }
+        }
+    }
 
-        // retrieve ringBuffer from eventMap if existed
+    RingBuffer* assignRingBuffer( BaseSynthEvent* aEvent, int aOscillatorNum )
+    {
+        RingBuffer* ringBuffer = aEvent->ringBuffers[ aOscillatorNum ].load();
 
-        std::map<unsigned int, RingBuffer*>::iterator mapIt = eventMap.find( frequency );
+        if ( ringBuffer != nullptr ) {
+            return ringBuffer;
+        }
 
-        if ( mapIt != eventMap.end() )
-            return mapIt->second;
+        ringBuffer = acquireRingBuffer();
 
-        // new ringBuffer, create on the fly
+        if ( ringBuffer == nullptr ) {
+            return nullptr;
+        }
 
-        int ringBufferSize     = ( int ) (( SAMPLE_TYPE ) AudioEngineProps::SAMPLE_RATE / aFrequency );
-        RingBuffer* ringBuffer = new RingBuffer( ringBufferSize );
+        // both the control and render thread can assign, should the other thread have assigned a
+        // ring buffer in the meantime, return the acquired one to the pool
 
-        _eventBufferMap[ aEvent->instanceId ][ frequency ] = ringBuffer;
+        RingBuffer* expected = nullptr;
 
+        if ( !aEvent->ringBuffers[ aOscillatorNum ].compare_exchange_strong( expected, ringBuffer )) {
+            releaseRingBuffer( ringBuffer );
+            return expected;
+        }
         return ringBuffer;
     }
 
-    bool destroyRingBuffersForEvent( BaseSynthEvent* aEvent )
+    RingBuffer* getRingBufferForEvent( BaseSynthEvent* aEvent, int aOscillatorNum, float aFrequency )
     {
-        std::map<unsigned int, innerRingMap>::iterator it = _eventBufferMap.find( aEvent->instanceId );
+        // the ring buffer is missing when the oscillator has become a Karplus-Strong
+        // oscillator after the event was added to the sequencer
 
-        if ( it != _eventBufferMap.end())
-        {
-            std::map<unsigned int, RingBuffer*> eventMap = it->second;
+        RingBuffer* ringBuffer = assignRingBuffer( aEvent, aOscillatorNum );
 
-            // destroy ring buffers
+        if ( ringBuffer == nullptr ) {
+            return nullptr;
+        }
 
-            for ( innerRingMap::iterator in_it = eventMap.begin(); in_it != eventMap.end(); )
-            {
-                RingBuffer* ringBuffer = in_it->second;
+        int ringBufferLength = ( int ) (( SAMPLE_TYPE ) AudioEngineProps::SAMPLE_RATE / aFrequency );
 
-                delete ringBuffer;
+        if ( ringBuffer->getBufferLength() != ringBufferLength ) {
+            ringBuffer->setBufferLength( ringBufferLength );
+        }
+        return ringBuffer;
+    }
 
-                eventMap.erase( in_it++ );
+    bool destroyRingBuffersForEvent( BaseSynthEvent* aEvent )
+    {
+        bool released = false;
+
+        for ( int i = 0; i < MAX_OSCILLATOR_AMOUNT; ++i )
+        {
+            RingBuffer* ringBuffer = aEvent->ringBuffers[ i ].exchange( nullptr );
+
+            if ( ringBuffer != nullptr ) {
+                releaseRingBuffer( ringBuffer );
+                released = true;
             }
-            _eventBufferMap.erase( it );    // erase contents for events instanceId
-            return true;
         }
-        return false;
+        return released;
+    }
+
+    int getAvailableRingBuffers()
+    {
+        return _availableRingBuffers.load();
     }
 }
 
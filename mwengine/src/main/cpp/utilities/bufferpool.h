@@ -25,6 +25,7 @@
 
 #include "../ringbuffer.h"
 #include <events/basesynthevent.h>
+#include <atomic>
 #include <map>
 
 namespace MWEngine {
@@ -33,25 +34,54 @@ namespace BufferPool
     // lazily instantiates / retrieves existing buffers of SAMPLE_TYPE
     // at the given buffer size, allows for memcpy of contents instead
     // using loops te re-initialize existing buffers to 0.0 values
+    // (allocates, not to be invoked from the render thread)
 
     extern SAMPLE_TYPE* getSilentBuffer( int aBufferSize );
 
-    // lazily instantiates / retrieves existing RingBuffer for given aEvent
-    // as pitch modulators (see arpeggiator) might shift the frequency of the
-    // given event, second argument aFrequency ensures multiple buffers for a single event
+    // the Karplus-Strong ring buffers of sequenced events are taken from a pool of preallocated
+    // ring buffers (live events use the ring buffers of their voice, see VoicePool). The pool holds
+    // up to MAX_RING_BUFFERS buffers, each able to hold a full cycle of RING_BUFFER_MIN_FREQUENCY
 
-    extern RingBuffer* getRingBufferForEvent( BaseSynthEvent* aEvent, float aFrequency );
+    const int MAX_RING_BUFFERS          = 512;
+    const int RING_BUFFER_MIN_FREQUENCY = 20;
 
-    // destroys all ring buffers associated with given aEvent
+    // preallocates ring buffers until the pool holds at least given amount of available
+    // buffers (or has reached its maximum size). Invoked by the control thread
+
+    extern void reserveRingBuffers( int amount );
+
+    // takes an available ring buffer from the pool, returns nullptr when the pool is exhausted
+    // lock-free and non-allocating (can be invoked by concurrently rendering AudioChannels)
+
+    extern RingBuffer* acquireRingBuffer();
+
+    // returns given ring buffer to the pool
+
+    extern void releaseRingBuffer( RingBuffer* ringBuffer );
+
+    // assigns an available ring buffer to given oscillator of given aEvent (unless it already holds one)
+    // returns the assigned ring buffer, or nullptr when the pool is exhausted
+
+    extern RingBuffer* assignRingBuffer( BaseSynthEvent* aEvent, int aOscillatorNum );
+
+    // retrieves the ring buffer for given oscillator of given aEvent, tuned to given aFrequency
+    // when the event holds no ring buffer for the oscillator, one is acquired from the pool. Invoked
+    // by the render thread, returns nullptr when the pool is exhausted
+
+    extern RingBuffer* getRingBufferForEvent( BaseSynthEvent* aEvent, int aOscillatorNum, float aFrequency );
+
+    // returns all ring buffers held by given aEvent to the pool
 
     extern bool destroyRingBuffersForEvent( BaseSynthEvent* aEvent );
 
-    // internal maps
+    extern int getAvailableRingBuffers();
+
+    // internal storage
 
-    typedef std::map<unsigned int, RingBuffer*>  innerRingMap;
-    typedef std::map<unsigned int, innerRingMap> ringMap;
+    extern std::atomic<RingBuffer*> _ringBuffers[ MAX_RING_BUFFERS ]; // available ring buffers (nullptr for empty slots)
+    extern std::atomic<int> _availableRingBuffers;
+    extern std::atomic<int> _totalRingBuffers;
 
-    extern ringMap                              _eventBufferMap;
     extern std::map<unsigned int, SAMPLE_TYPE*> _silentBufferMap;
 }
 } // E.O namespace MWEngine
@@ -27,8 +27,130 @@
 #include <iostream>
 #include "utils.h"
 
+#if defined(__SSE2__)
+#include <immintrin.h>
+#elif defined(__ARM_NEON)
+#include <arm_neon.h>
+#endif
+
 namespace MWEngine {
 
+/* output kernels */
+
+namespace {
+
+    // applies gain onto given sample and caps it to the safe output range (branchless variant of capSampleSafe()). Note
+    // the sample is converted to float prior to applying the gain (equal to the order of operations of the original output stage)
+
+    inline float toSafeOutput( SAMPLE_TYPE sample, float gain )
+    {
+        return std::min( MAX_OUTPUT, std::max( -MAX_OUTPUT, ( float ) sample * gain ));
+    }
+
+// the vectorized kernels process four frames at a time. Note that doubles are converted to
+// float prior to applying the gain (which equals the result of the scalar variant)
+
+#if defined(__SSE2__)
+
+    #define MWENGINE_OUTPUT_SIMD
+
+    typedef __m128 Frames4;
+
+    inline Frames4 toSafeOutput4( const SAMPLE_TYPE* samples, float gain )
+    {
+#if PRECISION == 2
+#ifdef __AVX__
+        // AVX converts all four doubles at once, the gain and cap are applied in float lanes (as in the scalar variant)
+        __m128 v = _mm256_cvtpd_ps( _mm256_loadu_pd( samples ));
+#else
+        __m128 v = _mm_movelh_ps( _mm_cvtpd_ps( _mm_loadu_pd( samples )), _mm_cvtpd_ps( _mm_loadu_pd( samples + 2 )));
+#endif
+#else
+        __m128 v = _mm_loadu_ps( samples );
+#endif
+        v = _mm_mul_ps( v, _mm_set1_ps( gain ));
+        return _mm_min_ps( _mm_max_ps( v, _mm_set1_ps( -MAX_OUTPUT )), _mm_set1_ps( MAX_OUTPUT ));
+    }
+
+    inline void store4( float* output, Frames4 frames )
+    {
+        _mm_storeu_ps( output, frames );
+    }
+
+    inline void storeInterleaved4( float* output, Frames4 left, Frames4 right )
+    {
+        _mm_storeu_ps( output,     _mm_unpacklo_ps( left, right ));
+        _mm_storeu_ps( output + 4, _mm_unpackhi_ps( left, right ));
+    }
+
+#elif defined(__ARM_NEON) && ( PRECISION == 1 || defined(__aarch64__))
+
+    #define MWENGINE_OUTPUT_SIMD
+
+    typedef float32x4_t Frames4;
+
+    inline Frames4 toSafeOutput4( const SAMPLE_TYPE* samples, float gain )
+    {
+#if PRECISION == 2
+        // double precision vectors are only available on AArch64
+        float32x4_t v = vcombine_f32( vcvt_f32_f64( vld1q_f64( samples )), vcvt_f32_f64( vld1q_f64( samples + 2 )));
+#else
+        float32x4_t v = vld1q_f32( samples );
+#endif
+        v = vmulq_n_f32( v, gain );
+        return vminq_f32( vmaxq_f32( v, vdupq_n_f32( -MAX_OUTPUT )), vdupq_n_f32( MAX_OUTPUT ));
+    }
+
+    inline void store4( float* output, Frames4 frames )
+    {
+        vst1q_f32( output, frames );
+    }
+
+    inline void storeInterleaved4( float* output, Frames4 left, Frames4 right )
+    {
+        float32x4x2_t frames = {{ left, right }};
+        vst2q_f32( output, frames );
+    }
+
+#endif
+
+    void writeMono( const SAMPLE_TYPE* input, float* output, int amountOfSamples, float gain )
+    {
+        int i = 0;
+#ifdef MWENGINE_OUTPUT_SIMD
+        for ( ; i + 4 <= amountOfSamples; i += 4 ) {
+            store4( output + i, toSafeOutput4( input + i, gain ));
+        }
+#endif
+        for ( ; i < amountOfSamples; ++i ) {
+            output[ i ] = toSafeOutput( input[ i ], gain );
+        }
+    }
+
+    void writeStereo( const SAMPLE_TYPE* left, const SAMPLE_TYPE* right, float* output, int amountOfSamples, float gain )
+    {
+        int i = 0;
+#ifdef MWENGINE_OUTPUT_SIMD
+        for ( ; i + 4 <= amountOfSamples; i += 4 ) {
+            storeInterleaved4( output + i * 2, toSafeOutput4( left + i, gain ), toSafeOutput4( right + i, gain ));
+        }
+#endif
+        for ( ; i < amountOfSamples; ++i ) {
+            output[ i * 2 ]     = toSafeOutput( left[ i ],  gain );
+            output[ i * 2 + 1 ] = toSafeOutput( right[ i ], gain );
+        }
+    }
+
+    // for other channel configurations each channel is written at the output channel stride
+
+    void writeStrided( const SAMPLE_TYPE* input, float* output, int amountOfSamples, int stride, float gain )
+    {
+        for ( int i = 0; i < amountOfSamples; ++i, output += stride ) {
+            *output = toSafeOutput( input[ i ], gain );
+        }
+    }
+}
+
 /* public methods */
 
 int BufferUtility::bufferToMilliseconds( int bufferSize, int sampleRate )
@@ -156,5 +278,25 @@ void BufferUtility::mixBufferInterleaved( AudioBuffer* sourceBuffer, float* buff
     }
 }
 
+void BufferUtility::writeBufferInterleaved( AudioBuffer* sourceBuffer, float* outputBuffer, int amountOfSamples, int outputChannels, float gain )
+{
+    switch ( outputChannels )
+    {
+        case 1:
+            writeMono( sourceBuffer->getBufferForChannel( 0 ), outputBuffer, amountOfSamples, gain );
+            break;
+
+        case 2:
+            writeStereo( sourceBuffer->getBufferForChannel( 0 ), sourceBuffer->getBufferForChannel( 1 ),
+                         outputBuffer, amountOfSamples, gain );
+            break;
+
+        default:
+            for ( int c = 0; c < outputChannels; ++c ) {
+                writeStrided( sourceBuffer->getBufferForChannel( c ), outputBuffer + c, amountOfSamples, outputChannels, gain );
+            }
+            break;
+    }
+}
 
 } // E.O namespace MWEngine
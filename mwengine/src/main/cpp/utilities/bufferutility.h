@@ -131,6 +131,14 @@ class BufferUtility
          * representing interleaved sample format
          */
         static void mixBufferInterleaved( AudioBuffer* sourceBuffer, float* bufferToMixInto, int amountOfSamples, int outputChannels );
+
+        /**
+         * Writes the contents of given sourceBuffer into a one dimensional float array representing
+         * interleaved sample format (overwriting its contents). The samples are converted to float, after
+         * which given gain is applied and the samples are capped to the safe output range (see capSampleSafe())
+         * without branching. Uses SSE or NEON instructions when available. Used by the output stage of the render cycle.
+         */
+        static void writeBufferInterleaved( AudioBuffer* sourceBuffer, float* outputBuffer, int amountOfSamples, int outputChannels, float gain );
 };
 } // E.O namespace MWEngine
 
@@ -0,0 +1,344 @@
+/**
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2026 Igor Zinken - https://www.igorski.nl
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#include "compactbuffer.h"
+#include <algorithm>
+#include <cmath>
+
+#if defined(__SSE2__)
+#include <immintrin.h>
+#elif defined(__ARM_NEON)
+#include <arm_neon.h>
+#endif
+
+namespace MWEngine {
+
+/* internal methods */
+
+namespace {
+
+// the vectorized kernels widen four stored samples at a time to single precision (which is
+// lossless for all storage types), to then be scaled and written at the sample type of the engine
+
+#if defined(__SSE2__)
+
+    #define MWENGINE_COMPACT_SIMD
+
+    typedef __m128 Samples4;
+
+    inline Samples4 load4( const int16_t* data )
+    {
+        // sign extend the 16-bit integers to 32-bit by shifting them into the upper half
+        __m128i v = _mm_loadl_epi64(( const __m128i* ) data );
+        return _mm_cvtepi32_ps( _mm_srai_epi32( _mm_unpacklo_epi16( v, v ), 16 ));
+    }
+
+    inline Samples4 load4( const uint16_t* data )
+    {
+        __m128i v = _mm_loadl_epi64(( const __m128i* ) data );
+#ifdef __F16C__
+        return _mm_cvtph_ps( v );
+#else
+        // vectorized variant of CompactBuffer::halfToFloat()
+        v = _mm_unpacklo_epi16( v, _mm_setzero_si128() );
+
+        __m128i expMantissa = _mm_and_si128( v, _mm_set1_epi32( 0x7fff ));
+        __m128i sign        = _mm_slli_epi32( _mm_xor_si128( v, expMantissa ), 16 );
+        __m128  scaled      = _mm_mul_ps( _mm_castsi128_ps( _mm_slli_epi32( expMantissa, 13 )),
+                                          _mm_castsi128_ps( _mm_set1_epi32( 0x77800000 ))); // 2^112
+        __m128i infNaN      = _mm_cmpeq_epi32( _mm_and_si128( expMantissa, _mm_set1_epi32( 0x7c00 )), _mm_set1_epi32( 0x7c00 ));
+
+        return _mm_castsi128_ps( _mm_or_si128(
+            _mm_or_si128( _mm_castps_si128( scaled ), _mm_and_si128( infNaN, _mm_set1_epi32( 0x7f800000 ))), sign
+        ));
+#endif
+    }
+
+    inline Samples4 load4( const float* data )
+    {
+        return _mm_loadu_ps( data );
+    }
+
+    inline void store4( SAMPLE_TYPE* target, Samples4 samples, SAMPLE_TYPE scale )
+    {
+#if PRECISION == 2
+        const __m128d s = _mm_set1_pd( scale );
+        _mm_storeu_pd( target,     _mm_mul_pd( _mm_cvtps_pd( samples ), s ));
+        _mm_storeu_pd( target + 2, _mm_mul_pd( _mm_cvtps_pd( _mm_movehl_ps( samples, samples )), s ));
+#else
+        _mm_storeu_ps( target, _mm_mul_ps( samples, _mm_set1_ps( scale )));
+#endif
+    }
+
+    inline void mix4( SAMPLE_TYPE* target, Samples4 samples, SAMPLE_TYPE scale, SAMPLE_TYPE volume )
+    {
+#if PRECISION == 2
+        const __m128d s = _mm_set1_pd( scale );
+        const __m128d v = _mm_set1_pd( volume );
+        __m128d lo = _mm_mul_pd( _mm_mul_pd( _mm_cvtps_pd( samples ), s ), v );
+        __m128d hi = _mm_mul_pd( _mm_mul_pd( _mm_cvtps_pd( _mm_movehl_ps( samples, samples )), s ), v );
+        _mm_storeu_pd( target,     _mm_add_pd( _mm_loadu_pd( target ),     lo ));
+        _mm_storeu_pd( target + 2, _mm_add_pd( _mm_loadu_pd( target + 2 ), hi ));
+#else
+        __m128 v = _mm_mul_ps( _mm_mul_ps( samples, _mm_set1_ps( scale )), _mm_set1_ps( volume ));
+        _mm_storeu_ps( target, _mm_add_ps( _mm_loadu_ps( target ), v ));
+#endif
+    }
+
+#elif defined(__ARM_NEON) && ( PRECISION == 1 || defined(__aarch64__))
+
+    #define MWENGINE_COMPACT_SIMD
+
+    typedef float32x4_t Samples4;
+
+    inline Samples4 load4( const int16_t* data )
+    {
+        return vcvtq_f32_s32( vmovl_s16( vld1_s16( data )));
+    }
+
+    inline Samples4 load4( const uint16_t* data )
+    {
+#if defined(__aarch64__)
+        return vcvt_f32_f16( vreinterpret_f16_u16( vld1_u16( data )));
+#else
+        float samples[ 4 ];
+        for ( int i = 0; i < 4; ++i ) {
+            samples[ i ] = CompactBuffer::halfToFloat( data[ i ] );
+        }
+        return vld1q_f32( samples );
+#endif
+    }
+
+    inline Samples4 load4( const float* data )
+    {
+        return vld1q_f32( data );
+    }
+
+    inline void store4( SAMPLE_TYPE* target, Samples4 samples, SAMPLE_TYPE scale )
+    {
+#if PRECISION == 2
+        // double precision vectors are only available on AArch64
+        vst1q_f64( target,     vmulq_n_f64( vcvt_f64_f32( vget_low_f32( samples )), scale ));
+        vst1q_f64( target + 2, vmulq_n_f64( vcvt_high_f64_f32( samples ), scale ));
+#else
+        vst1q_f32( target, vmulq_n_f32( samples, scale ));
+#endif
+    }
+
+    inline void mix4( SAMPLE_TYPE* target, Samples4 samples, SAMPLE_TYPE scale, SAMPLE_TYPE volume )
+    {
+#if PRECISION == 2
+        float64x2_t lo = vmulq_n_f64( vmulq_n_f64( vcvt_f64_f32( vget_low_f32( samples )), scale ), volume );
+        float64x2_t hi = vmulq_n_f64( vmulq_n_f64( vcvt_high_f64_f32( samples ), scale ), volume );
+        vst1q_f64( target,     vaddq_f64( vld1q_f64( target ),     lo ));
+        vst1q_f64( target + 2, vaddq_f64( vld1q_f64( target + 2 ), hi ));
+#else
+        vst1q_f32( target, vaddq_f32( vld1q_f32( target ), vmulq_n_f32( vmulq_n_f32( samples, scale ), volume )));
+#endif
+    }
+
+#endif
+
+    template <typename T>
+    void decodeChannel( const T* data, CompactBuffer::Channel<T> channel, SAMPLE_TYPE* target, int amountOfSamples, SAMPLE_TYPE scale )
+    {
+        int i = 0;
+#ifdef MWENGINE_COMPACT_SIMD
+        for ( ; i + 4 <= amountOfSamples; i += 4 ) {
+            store4( target + i, load4( data + i ), scale );
+        }
+#endif
+        for ( ; i < amountOfSamples; ++i ) {
+            target[ i ] = channel[ i ];
+        }
+    }
+
+    template <typename T>
+    void mixChannel( const T* data, CompactBuffer::Channel<T> channel, SAMPLE_TYPE* target, int amountOfSamples,
+                     SAMPLE_TYPE scale, SAMPLE_TYPE volume )
+    {
+        int i = 0;
+#ifdef MWENGINE_COMPACT_SIMD
+        for ( ; i + 4 <= amountOfSamples; i += 4 ) {
+            mix4( target + i, load4( data + i ), scale, volume );
+        }
+#endif
+        for ( ; i < amountOfSamples; ++i ) {
+            target[ i ] += ( channel[ i ] * volume );
+        }
+    }
+}
+
+/* constructor / destructor */
+
+CompactBuffer::CompactBuffer( AudioBuffer* sourceBuffer, int storageType )
+{
+    amountOfChannels = sourceBuffer->amountOfChannels;
+    bufferSize       = sourceBuffer->bufferSize;
+    _storageType     = storageType;
+    _scale           = 1.0;
+    _sampleSize      = ( storageType == SINGLE_FLOAT ) ? sizeof( float ) : sizeof( int16_t );
+    _channelSize     = (( bufferSize * _sampleSize + DATA_ALIGNMENT - 1 ) / DATA_ALIGNMENT ) * DATA_ALIGNMENT;
+    _data            = new char[ std::max(( size_t ) 1, amountOfChannels * _channelSize ) ];
+
+    // 16-bit integers are scaled to the peak of the source
+
+    if ( _storageType == PCM16 )
+    {
+        SAMPLE_TYPE peak = 0.0;
+
+        for ( int c = 0; c < amountOfChannels; ++c ) {
+            SAMPLE_TYPE* channelBuffer = sourceBuffer->getBufferForChannel( c );
+            for ( int i = 0; i < bufferSize; ++i ) {
+                peak = std::max( peak, ( SAMPLE_TYPE ) std::abs( channelBuffer[ i ] ));
+            }
+        }
+        _scale = (( peak > 0.0 ) ? peak : 1.0 ) / 32767.0;
+    }
+
+    for ( int c = 0; c < amountOfChannels; ++c )
+    {
+        SAMPLE_TYPE* channelBuffer = sourceBuffer->getBufferForChannel( c );
+        char* channelData = _data + c * _channelSize;
+
+        for ( int i = 0; i < bufferSize; ++i )
+        {
+            switch ( _storageType )
+            {
+                case PCM16:
+                    (( int16_t* ) channelData )[ i ] = ( int16_t ) std::max( -32767L, std::min( 32767L, lrint( channelBuffer[ i ] / _scale )));
+                    break;
+                case HALF_FLOAT:
+                    (( uint16_t* ) channelData )[ i ] = floatToHalf(( float ) channelBuffer[ i ] );
+                    break;
+                default:
+                    (( float* ) channelData )[ i ] = ( float ) channelBuffer[ i ];
+                    break;
+            }
+        }
+    }
+}
+
+CompactBuffer::~CompactBuffer()
+{
+    delete[] _data;
+}
+
+/* public methods */
+
+int CompactBuffer::getStorageType()
+{
+    return _storageType;
+}
+
+size_t CompactBuffer::getMemoryUsage()
+{
+    return amountOfChannels * _channelSize;
+}
+
+SAMPLE_TYPE CompactBuffer::getSample( int channel, int index )
+{
+    switch ( _storageType )
+    {
+        case PCM16:
+            return getChannel<int16_t>( channel )[ index ];
+        case HALF_FLOAT:
+            return getChannel<uint16_t>( channel )[ index ];
+        default:
+            return getChannel<float>( channel )[ index ];
+    }
+}
+
+AudioBuffer* CompactBuffer::toAudioBuffer()
+{
+    AudioBuffer* output = new AudioBuffer( amountOfChannels, bufferSize );
+
+    for ( int c = 0; c < amountOfChannels; ++c ) {
+        decode( c, 0, output->getBufferForChannel( c ), bufferSize );
+    }
+    return output;
+}
+
+void CompactBuffer::decode( int channel, int readOffset, SAMPLE_TYPE* target, int amountOfSamples )
+{
+    const char* data = _data + channel * _channelSize + readOffset * _sampleSize;
+
+    switch ( _storageType )
+    {
+        case PCM16:
+            decodeChannel(( const int16_t* ) data, Channel<int16_t>(( const int16_t* ) data, _scale ), target, amountOfSamples, _scale );
+            break;
+        case HALF_FLOAT:
+            decodeChannel(( const uint16_t* ) data, Channel<uint16_t>(( const uint16_t* ) data, _scale ), target, amountOfSamples, _scale );
+            break;
+        default:
+            decodeChannel(( const float* ) data, Channel<float>(( const float* ) data, _scale ), target, amountOfSamples, _scale );
+            break;
+    }
+}
+
+void CompactBuffer::mix( int channel, int readOffset, SAMPLE_TYPE* target, int amountOfSamples, SAMPLE_TYPE volume )
+{
+    const char* data = _data + channel * _channelSize + readOffset * _sampleSize;
+
+    switch ( _storageType )
+    {
+        case PCM16:
+            mixChannel(( const int16_t* ) data, Channel<int16_t>(( const int16_t* ) data, _scale ), target, amountOfSamples, _scale, volume );
+            break;
+        case HALF_FLOAT:
+            mixChannel(( const uint16_t* ) data, Channel<uint16_t>(( const uint16_t* ) data, _scale ), target, amountOfSamples, _scale, volume );
+            break;
+        default:
+            mixChannel(( const float* ) data, Channel<float>(( const float* ) data, _scale ), target, amountOfSamples, _scale, volume );
+            break;
+    }
+}
+
+uint16_t CompactBuffer::floatToHalf( float value )
+{
+    uint32_t bits;
+    memcpy( &bits, &value, sizeof( float ));
+
+    uint16_t sign = ( uint16_t ) (( bits >> 16 ) & 0x8000 );
+    bits &= 0x7fffffff;
+
+    // values exceeding the half precision range become infinity (NaN remains NaN)
+
+    if ( bits >= 0x47800000 )
+        return sign | ( bits > 0x7f800000 ? 0x7e00 : 0x7c00 );
+
+    // values below the smallest normal half precision value are stored as subnormals (in steps of 2^-24)
+
+    if ( bits < 0x38800000 ) {
+        memcpy( &value, &bits, sizeof( float ));
+        return sign | ( uint16_t ) lrintf( value * 16777216.f );
+    }
+
+    // rebias the exponent and round the mantissa to nearest even
+
+    bits += (( uint32_t ) ( 15 - 127 ) << 23 ) + 0xfff + (( bits >> 13 ) & 1 );
+
+    return sign | ( uint16_t ) ( bits >> 13 );
+}
+
+} // E.O namespace MWEngine
@@ -0,0 +1,160 @@
+/**
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2026 Igor Zinken - https://www.igorski.nl
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#ifndef __MWENGINE__COMPACTBUFFER_H_INCLUDED__
+#define __MWENGINE__COMPACTBUFFER_H_INCLUDED__
+
+#include "../audiobuffer.h"
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+namespace MWEngine {
+
+/**
+ * A CompactBuffer holds sample data in a storage type that is smaller than the
+ * sample type of the engine (see PRECISION in global.h), reducing the memory
+ * occupied by (and the memory bandwidth required to play back) samples 2 - 4 times.
+ *
+ * The samples are decoded to SAMPLE_TYPE while being read, see SampleEvent::setCompactSample()
+ * and SampleManager::compactSample(). PCM16 storage scales the samples by the peak of the source
+ * (so quiet samples retain their resolution), HALF_FLOAT and SINGLE_FLOAT store the samples as-is.
+ */
+class CompactBuffer
+{
+    public:
+
+        // storage types
+
+        enum types {
+            PCM16,
+            HALF_FLOAT,
+            SINGLE_FLOAT
+        };
+
+        // encodes the contents of given AudioBuffer (which remains owned by the caller)
+
+        CompactBuffer( AudioBuffer* sourceBuffer, int storageType );
+        ~CompactBuffer();
+
+        int amountOfChannels;
+        int bufferSize;
+
+        int getStorageType();
+        size_t getMemoryUsage(); // in bytes
+
+        // decodes the sample at given index of given channel
+
+        SAMPLE_TYPE getSample( int channel, int index );
+
+        // creates an AudioBuffer holding the decoded contents of this buffer
+
+        AudioBuffer* toAudioBuffer();
+
+#ifndef SWIG
+        // internal to the engine, decode (or mix, multiplied by given volume) given amount of samples
+        // starting at given read offset of given channel into given buffer
+
+        void decode( int channel, int readOffset, SAMPLE_TYPE* target, int amountOfSamples );
+        void mix( int channel, int readOffset, SAMPLE_TYPE* target, int amountOfSamples, SAMPLE_TYPE volume );
+
+        // accessors for per-sample reads within (interpolating) inner loops, to be
+        // used when the storage type is known, e.g. : getChannel<int16_t>( 0 )[ index ]
+
+        template <typename T>
+        class Channel
+        {
+            public:
+                Channel( const T* data, SAMPLE_TYPE scale ) : _data( data ), _scale( scale ) {}
+                inline SAMPLE_TYPE operator[]( int index ) const;
+            private:
+                const T* _data;
+                SAMPLE_TYPE _scale;
+        };
+
+        template <typename T>
+        Channel<T> getChannel( int channel )
+        {
+            return Channel<T>(( const T* ) ( _data + channel * _channelSize ), _scale );
+        }
+
+        // IEEE 754 half precision conversion (HALF_FLOAT storage is held as uint16_t)
+
+        static inline float halfToFloat( uint16_t value )
+        {
+            // shift exponent and mantissa into place and rebias the exponent by multiplying with 2^112,
+            // this also normalizes subnormal values. Infinity and NaN retain their maximum exponent
+
+            uint32_t bits = ( uint32_t ) ( value & 0x7fff ) << 13;
+            float    out;
+            memcpy( &out, &bits, sizeof( float ));
+            out *= 5.192296858534828e+33f;
+            memcpy( &bits, &out, sizeof( float ));
+
+            if (( value & 0x7c00 ) == 0x7c00 )
+                bits |= 0x7f800000;
+
+            bits |= ( uint32_t ) ( value & 0x8000 ) << 16;
+            memcpy( &out, &bits, sizeof( float ));
+
+            return out;
+        }
+
+        static uint16_t floatToHalf( float value );
+#endif
+
+    private:
+
+        static const size_t DATA_ALIGNMENT = 64;
+
+        int _storageType;
+        SAMPLE_TYPE _scale;  // multiplier for PCM16 storage
+        size_t _sampleSize;  // in bytes
+        size_t _channelSize; // in bytes, the data of each channel starts at an aligned offset
+        char* _data;
+};
+
+#ifndef SWIG
+
+template <>
+inline SAMPLE_TYPE CompactBuffer::Channel<int16_t>::operator[]( int index ) const
+{
+    return ( SAMPLE_TYPE ) _data[ index ] * _scale;
+}
+
+template <>
+inline SAMPLE_TYPE CompactBuffer::Channel<uint16_t>::operator[]( int index ) const
+{
+    return ( SAMPLE_TYPE ) CompactBuffer::halfToFloat( _data[ index ] );
+}
+
+template <>
+inline SAMPLE_TYPE CompactBuffer::Channel<float>::operator[]( int index ) const
+{
+    return ( SAMPLE_TYPE ) _data[ index ];
+}
+
+#endif
+
+} // E.O namespace MWEngine
+
+#endif
@@ -27,7 +27,10 @@
 namespace MWEngine {
 
 #ifdef DEBUG
+#ifdef __ANDROID__
 #include <android/log.h>
+#endif
+#include <stdarg.h>
 #include <stdio.h>
 #endif
 
@@ -52,7 +55,14 @@ namespace Debug
          */
         va_list args;
         va_start( args, aMessage );
+#ifdef __ANDROID__
         __android_log_vprint( ANDROID_LOG_VERBOSE, LOGTAG, aMessage, args );
+#else
+        // host builds (e.g. the native benchmark target) log to stderr
+        fprintf( stderr, "%s: ", LOGTAG );
+        vfprintf( stderr, aMessage, args );
+        fputc( '\n', stderr );
+#endif
         va_end( args );
 #endif
     }
@@ -23,385 +23,369 @@
 #include "diskwriter.h"
 #include "audioengine.h"
 #include "wavewriter.h"
-#include "wavereader.h"
-#include "utils.h"
-#include "bufferutility.h"
 #include "debug.h"
-#include <cstdio>
-#include <definitions/notifications.h>
-#include <messaging/notifier.h>
-#include <utilities/stringutility.h>
-#include <resizable_audiobuffer.h>
+#include "utils.h"
+#include <algorithm>
 
 namespace MWEngine {
 
-std::string DiskWriter::outputFile;
-std::string DiskWriter::tempDirectory;
-std::vector<DiskWriter::writtenFile> DiskWriter::outputFiles;
-std::vector<ResizableBufferGroup*> DiskWriter::cachedBuffers{ nullptr, nullptr };
-
-int DiskWriter::currentBufferIndex = 0;
-int DiskWriter::recordingChunkSize = 0;
-int DiskWriter::outputWriterIndex  = 0;
-int DiskWriter::savedSnippets      = 0;
-
-int DiskWriter::recordingChannelAmount = AudioEngineProps::OUTPUT_CHANNELS;
-bool DiskWriter::prepared = false;
-
-/* public methods */
-
-void DiskWriter::prepare( std::string outputFilename, int chunkSize, int amountOfChannels )
-{
-    outputFile = outputFilename;
-
-    std::string path   = std::string( outputFilename );
-    std::size_t dirPos = path.find_last_of( "/" );
-    tempDirectory      = path.substr( 0, dirPos ) + "/";
+const std::chrono::microseconds DiskWriter::WRITE_INTERVAL( 2000 );
 
-    // when full duplex recording is active, half the chunkSize to keep memory usage (more or less) equal
-    int channelChunkSize = isFullDuplex() ? ceil( chunkSize / 2 ) : chunkSize;
+std::string   DiskWriter::outputFile;
+std::ofstream DiskWriter::outputStream;
+std::thread*  DiskWriter::writerThread = nullptr;
+DiskWriter::Recording* DiskWriter::recording = nullptr;
 
-    recordingChunkSize     = channelChunkSize;
-    recordingChannelAmount = amountOfChannels;
-    savedSnippets          = 0;
-    outputWriterIndex      = 0;
+std::atomic<DiskWriter::Recording*> DiskWriter::activeRecording { nullptr };
+std::atomic<int>  DiskWriter::appending     { 0 };
+std::atomic<bool> DiskWriter::writing       { false };
+std::atomic<int>  DiskWriter::droppedFrames { 0 };
 
-    outputFiles.clear();
-    prepareSnippet();
+int    DiskWriter::latency     = 0;
+size_t DiskWriter::writtenSize = 0;
 
-    prepared = true;
-}
-
-bool DiskWriter::updateSnippetProgress( bool force, bool broadcast )
-{
-    if ( !force && !isSnippetBufferFull()) {
-        return false;
-    }
-
-    // when bouncing, this is done synchronously (as engine is not writing output to hardware), otherwise
-    // broadcast that a snippet has recorded in full and can be written onto storage
-
-    if ( AudioEngine::recordingState.bouncing ) {
-        writeBufferToFile( currentBufferIndex, false );
-    } else if ( broadcast ) {
-        Notifier::broadcast( Notifications::RECORDED_SNIPPET_READY, currentBufferIndex );
-    }
-    prepareSnippet();
+std::vector<float> DiskWriter::readBuffer;
+std::vector<float> DiskWriter::mixBuffer;
+std::vector<INT16> DiskWriter::pcmBuffer;
+std::vector<float> DiskWriter::delayBuffer;
+size_t DiskWriter::processedFrames = 0;
 
-   return true;
-}
+/* public methods */
 
-bool DiskWriter::finish()
+void DiskWriter::prepare( std::string outputFilename, int bufferSize, int amountOfChannels )
 {
-    if ( !prepared ) {
-        return false;
-    }
-
-    int bufferIndex = currentBufferIndex;
-    updateSnippetProgress( true, false );    // finish current snippet
-    writeBufferToFile( bufferIndex, false ); // render current snippet to temp file
-
-    // flush all temporary buffers now recording has finished
-    // and all snippets have been written onto disk
-
-    for ( int i = 0; i < 2; ++i ) {
-        flushOutput( i );
-    }
-
-    if ( outputFiles.empty() ) {
-        return false;
-    }
+    // halt the writer of a previous recording that hasn't finished (the render thread
+    // might still be appending into it, as such it is only freed once it no longer does)
 
-    // calculate total data size of concatenated wave files
+    activeRecording.store( nullptr );
+    awaitAppending();
+    stopWriter();
 
-    size_t totalBufferSize = 0;
-
-    for ( const auto & file : outputFiles ) {
-        totalBufferSize += file.size;
+    if ( outputStream.is_open() ) {
+        outputStream.close();
     }
+    delete recording;
 
-    // create a stream for writing the output file to
-
-    std::ofstream waveStream = WaveWriter::createWAVStream(
-        outputFile.c_str(), totalBufferSize,
-        AudioEngineProps::SAMPLE_RATE, recordingChannelAmount
-    );
+    int frameSize = isFullDuplex() ? amountOfChannels * 2 : amountOfChannels;
 
-    // concatenate the wave files into a single output file
+    outputFile      = outputFilename;
+    latency         = isFullDuplex() ? std::max( 0, AudioEngine::recordingState.latency ) : 0;
+    writtenSize     = 0;
+    processedFrames = 0;
+    droppedFrames.store( 0 );
 
-    while ( ! outputFiles.empty() )
-    {
-        auto file = outputFiles.at( 0 );
+    // allocate all buffers upfront (appending is done by the render thread)
+    // note the queue can always hold at least two render cycles worth of samples
 
-        // read WAV data from file
+    int queuedFrames = std::max( bufferSize, ( int ) AudioEngineProps::BUFFER_SIZE * 2 );
 
-        AudioBuffer* tempBuffer = nullptr;
+    recording = new Recording( amountOfChannels, frameSize, ( size_t ) queuedFrames, AudioEngineProps::BUFFER_SIZE );
 
-        if ( isFullDuplex() )
-        {
-            auto serializedBuffer = WaveReader::fileToBuffer( file.path ).buffer;
+    readBuffer.resize( WRITE_BLOCK_SIZE * frameSize );
+    mixBuffer.resize( WRITE_BLOCK_SIZE * amountOfChannels );
+    pcmBuffer.resize( WRITE_BLOCK_SIZE * amountOfChannels );
+    delayBuffer.assign(( size_t ) latency * amountOfChannels, 0.f );
 
-            if ( serializedBuffer != nullptr ) {
+    // the size of the recording is unknown at this point, it is written into the header upon finish()
 
-                // always calculate length from buffer (instead of taking recordingChunkSize)
-                // as the buffer might not have recorded for a full recordingChunkSize in length!
-                int serializedChunkSize = ceil( serializedBuffer->bufferSize / 2 );
-                int nextSerializedChunkSize = 0;
+    outputStream = WaveWriter::createWAVStream( outputFile.c_str(), 0, AudioEngineProps::SAMPLE_RATE, amountOfChannels );
 
-                tempBuffer = new AudioBuffer( serializedBuffer->amountOfChannels, serializedChunkSize );
+    writing.store( true, std::memory_order_release );
+    writerThread = new std::thread( runWriter );
 
-                // to correct the recorded input channel with the output channel we subtract the specified
-                // latency in samples, this means we also need to read a little from the next available buffer
+    // hand the fully prepared recording over to the render thread
 
-                AudioBuffer* nextSerializedBuffer = nullptr;
-                if ( outputFiles.size() > 1 ) {
-                    nextSerializedBuffer = WaveReader::fileToBuffer( outputFiles.at( 1 ).path ).buffer;
-                    nextSerializedChunkSize = nextSerializedBuffer != nullptr ? ceil( nextSerializedBuffer->bufferSize / 2 ) : 0;
-                }
-                int nextInputReadOffset = serializedChunkSize - AudioEngine::recordingState.latency;
-
-                for ( int c = 0, cl = serializedBuffer->amountOfChannels; c < cl; ++c ) {
-                    auto outputBuffer = tempBuffer->getBufferForChannel( c );
-                    auto sampleBuffer = serializedBuffer->getBufferForChannel( c );
-                    auto nextSampleBuffer = nextSerializedChunkSize != 0 ? nextSerializedBuffer->getBufferForChannel( c ) : nullptr;
-
-                    int inputOffset; // offset at which we can get the appropriate input sample, corrected for the latency
-
-                    for ( int i = 0; i < serializedChunkSize; ++i ) {
-                        SAMPLE_TYPE outputSample = sampleBuffer[ i ];
-                        SAMPLE_TYPE inputSample  = SILENCE;
-
-                        // note inputOffset starts at recordingChunkSize (== half the size of each file) as
-                        // the input samples were serialized after the output samples
-
-                        if ( nextInputReadOffset < 0 ) {
-                            // this shouldn't occur
-                        } else if ( i < nextInputReadOffset ) {
-                            inputOffset = serializedChunkSize + ( i + AudioEngine::recordingState.latency );
-                            inputSample = sampleBuffer[ inputOffset ];
-                        } else if ( nextSampleBuffer != nullptr ) {
-                            // read the amount of samples of the latency from the next buffer, when existing
-                            inputOffset = nextSerializedChunkSize + ( i - nextInputReadOffset );
-                            inputSample = nextSampleBuffer[ inputOffset ];
-                        }
-
-                        // mix in the offset corrected input sample with the output sample
-
-                        outputBuffer[ i ] = capSampleSafe( outputSample + inputSample );
-                    }
-                }
-                delete serializedBuffer;
-                delete nextSerializedBuffer;
-            }
-        } else {
-            tempBuffer = WaveReader::fileToBuffer( file.path ).buffer;
-        }
+    activeRecording.store( recording );
+}
 
-        // delete the source WAV file so we immediately free storage space for
-        // writing the buffer contents into the single file output stream,
-        // note we assume that no errors have occurred with file writing
-        // as the original recording is now gone!! then again, if it has errors
-        // then the original recording isn't worth keeping anyways... :/
+bool DiskWriter::finish()
+{
+    // claim the active recording (finish() can be invoked from both the render and a control thread)
 
-        remove( file.path.c_str() );
+    if ( activeRecording.exchange( nullptr ) == nullptr ) {
+        return false;
+    }
+    awaitAppending();
 
-        if ( tempBuffer != nullptr ) {
+    // the writer thread writes all remaining queued samples before halting
 
-            // convert data to a temporary PCM buffer
-            // TODO: can we just extract the existing PCM data without this
-            // back-and-forth conversion?
-            INT16* outputBuffer = WaveWriter::bufferToPCM( tempBuffer );
+    stopWriter();
 
-            delete tempBuffer; // free memory allocated to read WAV file
-            tempBuffer = nullptr;
+    if ( latency > 0 ) {
+        writeDelayedFrames();
+    }
 
-            // write PCM buffer into the output stream
+    // update the header with the final size of the recording
 
-            WaveWriter::appendBufferToStream( waveStream, outputBuffer, file.size );
+    WaveWriter::updateWAVStreamSize( outputStream, writtenSize );
 
-            delete[] outputBuffer; // free memory allocated to the temporary PCM buffer
-        }
+    bool success = outputStream.good();
+    outputStream.close();
 
-        // remove from vector, iterate onto next
+    delete recording;
+    recording = nullptr;
 
-        outputFiles.erase( outputFiles.begin() );
+    if ( droppedFrames.load() > 0 ) {
+        Debug::log( "DiskWriter::dropped %d frames as storage could not keep up with the recording", droppedFrames.load() );
     }
-    waveStream.close();
-
-    prepared = false;
-
-    return true;
+    return success;
 }
 
 void DiskWriter::appendBuffer( AudioBuffer* aBuffer )
 {
-    if ( !prepared ) {
+    Recording* target = acquireRecording();
+
+    if ( target == nullptr ) {
         return;
     }
     int bufferSize    = aBuffer->bufferSize;
     int channelAmount = aBuffer->amountOfChannels;
+    int frameSize     = target->frameSize;
+    int maxFrames     = ( int ) target->appendBufferData.size() / frameSize;
+
+    // interleave the buffer contents (mono buffers are written to all recorded channels)
+
+    for ( int offset = 0; offset < bufferSize; offset += maxFrames )
+    {
+        int amountOfFrames = std::min( maxFrames, bufferSize - offset );
 
-    auto cachedBuffer = getCachedOutputBuffer( currentBufferIndex )->getBufferAtIndex( 0 );
+        for ( int c = 0; c < target->channelAmount; ++c )
+        {
+            SAMPLE_TYPE* channelBuffer = aBuffer->getBufferForChannel( std::min( c, channelAmount - 1 ));
 
-    if ( cachedBuffer == nullptr ) {
-        cachedBuffer = generateOutputBuffer( currentBufferIndex, channelAmount )->getBufferAtIndex( 0 );
+            for ( int i = 0, w = c; i < amountOfFrames; ++i, w += frameSize ) {
+                target->appendBufferData[ w ] = ( float ) channelBuffer[ offset + i ];
+            }
+        }
+        enqueue( target, target->appendBufferData.data(), amountOfFrames );
     }
-    cachedBuffer->mergeBuffers( aBuffer, 0, outputWriterIndex, MAX_VOLUME );
-    outputWriterIndex += bufferSize;
+    releaseRecording();
 }
 
 void DiskWriter::appendBuffer( const float* outputBuffer, int bufferSize, int amountOfChannels )
 {
-    if ( !prepared ) {
+    Recording* target = acquireRecording();
+
+    if ( target == nullptr ) {
         return;
     }
-    auto cachedBuffer = getCachedOutputBuffer( currentBufferIndex )->getBufferAtIndex( 0 );
+    int frameSize = target->frameSize;
 
-    if ( cachedBuffer == nullptr ) {
-        cachedBuffer = generateOutputBuffer( currentBufferIndex, amountOfChannels )->getBufferAtIndex( 0 );
-    }
-    int i, c, ci;
+    // the engine output is already interleaved, as such it can be queued as is
 
-    // write samples into cache buffers
+    if ( amountOfChannels == frameSize ) {
+        enqueue( target, outputBuffer, bufferSize );
+        releaseRecording();
+        return;
+    }
+    int maxFrames = ( int ) target->appendBufferData.size() / frameSize;
 
-    for ( i = 0, c = 0; i < bufferSize; ++i, ++outputWriterIndex, c += amountOfChannels )
+    for ( int offset = 0; offset < bufferSize; offset += maxFrames )
     {
-        if ( outputWriterIndex == recordingChunkSize ) {
-            updateSnippetProgress( true, true );
-            cachedBuffer = getCachedOutputBuffer( currentBufferIndex )->getBufferAtIndex( 0 );
-        }
-        for ( ci = 0; ci < amountOfChannels; ++ci ) {
-            cachedBuffer->getBufferForChannel( ci )[ outputWriterIndex ] = outputBuffer[ c + ci ];
+        int amountOfFrames = std::min( maxFrames, bufferSize - offset );
+
+        for ( int i = 0, r = offset * amountOfChannels, w = 0; i < amountOfFrames; ++i, r += amountOfChannels, w += frameSize ) {
+            for ( int c = 0; c < target->channelAmount; ++c ) {
+                target->appendBufferData[ w + c ] = outputBuffer[ r + std::min( c, amountOfChannels - 1 )];
+            }
         }
+        enqueue( target, target->appendBufferData.data(), amountOfFrames );
     }
+    releaseRecording();
 }
 
-void DiskWriter::appendDuplexBuffers( const float* outputBuffer, AudioBuffer* inputBuffer, int outputBufferSize, int amountOfChannels, int latencyInSamples )
+void DiskWriter::appendDuplexBuffers( const float* outputBuffer, AudioBuffer* inputBuffer, int outputBufferSize, int amountOfChannels )
 {
-    if ( !prepared ) {
-        return;
-    }
     if ( outputBufferSize != inputBuffer->bufferSize ) {
         Debug::log( "cannot appendDuplexBuffers when input- and outputBuffer are of unequal size!" );
         return;
     }
+    Recording* target = acquireRecording();
 
-    auto cachedOutputBuffer = getCachedOutputBuffer( currentBufferIndex )->getBufferAtIndex( 0 );
-    if ( cachedOutputBuffer == nullptr ) {
-        cachedOutputBuffer = generateOutputBuffer( currentBufferIndex, amountOfChannels )->getBufferAtIndex( 0 );
+    if ( target == nullptr ) {
+        return;
     }
-    auto cachedInputBuffer = getCachedOutputBuffer( currentBufferIndex )->getBufferAtIndex( 1 );
+    int frameSize     = target->frameSize;
+    int channelAmount = target->channelAmount;
+    int maxFrames     = ( int ) target->appendBufferData.size() / frameSize;
 
-    int i, c, ci;
+    // each queued frame contains the output samples, followed by the input samples
 
-    // write samples into cache buffers
-
-    for ( i = 0, c = 0; i < outputBufferSize; ++i, ++outputWriterIndex, c += amountOfChannels )
+    for ( int offset = 0; offset < outputBufferSize; offset += maxFrames )
     {
-        if ( outputWriterIndex == recordingChunkSize ) {
-            updateSnippetProgress( true, true );
-            cachedOutputBuffer = getCachedOutputBuffer( currentBufferIndex )->getBufferAtIndex( 0 );
-            cachedInputBuffer  = getCachedOutputBuffer( currentBufferIndex )->getBufferAtIndex( 1 );
-        }
-        for ( ci = 0; ci < amountOfChannels; ++ci ) {
-            cachedOutputBuffer->getBufferForChannel( ci )[ outputWriterIndex ] = outputBuffer[ c + ci ];
-            cachedInputBuffer->getBufferForChannel( ci )[ outputWriterIndex ] = inputBuffer->getBufferForChannel( ci )[ i ];
+        int amountOfFrames = std::min( maxFrames, outputBufferSize - offset );
+
+        for ( int i = 0, r = offset * amountOfChannels, w = 0; i < amountOfFrames; ++i, r += amountOfChannels, w += frameSize ) {
+            for ( int c = 0; c < channelAmount; ++c ) {
+                target->appendBufferData[ w + c ] = outputBuffer[ r + c ];
+                target->appendBufferData[ w + channelAmount + c ] = ( float ) inputBuffer->getBufferForChannel( c )[ offset + i ];
+            }
         }
+        enqueue( target, target->appendBufferData.data(), amountOfFrames );
     }
+    releaseRecording();
 }
 
-void DiskWriter::writeBufferToFile( int bufferIndex, bool broadcastUpdate )
+int DiskWriter::getDroppedFrames()
 {
-    if ( !prepared ) {
-        return;
-    }
-    auto cachedBuffer = getCachedOutputBuffer( bufferIndex );
+    return droppedFrames.load();
+}
 
-    if ( cachedBuffer == nullptr ) {
-        return;
-    }
-    int sampleRate = ( int ) AudioEngineProps::SAMPLE_RATE;
-
-    // create output file name
-    std::string snippetFileName = std::string(
-        tempDirectory
-    ).append( "rec_snippet_" + TO_STRING( savedSnippets ) + ".WAV" );
-
-    size_t writtenWAVsize;
-    int groupSize = cachedBuffer->getGroupSize();
-
-    if ( groupSize == 1 ) {
-        writtenWAVsize = WaveWriter::bufferToWAV( snippetFileName, cachedBuffer->getBufferAtIndex( 0 ), sampleRate );
-        flushOutput( bufferIndex ); // free allocated buffer memory
-    } else {
-        auto buffer = cachedBuffer->getContentSerialized();
-        flushOutput( bufferIndex ); // free allocated buffer memory
-        // we're cheating here, the written size will eventually be the size of a single mixed buffer
-        writtenWAVsize = ceil( WaveWriter::bufferToWAV( snippetFileName, buffer, sampleRate ) / groupSize );
-        delete buffer; // free allocated serialized buffer
-    }
+/* private methods */
+
+// the render thread announces it is appending before reading the active recording, while the
+// control thread retires the active recording before awaiting the announcements. As both use
+// sequentially consistent operations, a retired recording is never appended into once awaited
 
-    // store output file in vector
-    writtenFile file;
-    file.path = snippetFileName;
-    file.size = writtenWAVsize;
-    outputFiles.push_back( file );
+DiskWriter::Recording* DiskWriter::acquireRecording()
+{
+    appending.fetch_add( 1 );
+    Recording* active = activeRecording.load();
 
-    // broadcast update
-    if ( broadcastUpdate ) {
-        Notifier::broadcast( Notifications::RECORDED_SNIPPET_SAVED, savedSnippets );
+    if ( active == nullptr ) {
+        appending.fetch_sub( 1 );
     }
-    ++savedSnippets;
+    return active;
 }
 
-/* private methods */
+void DiskWriter::releaseRecording()
+{
+    appending.fetch_sub( 1 );
+}
+
+void DiskWriter::awaitAppending()
+{
+    while ( appending.load() > 0 ) {
+        std::this_thread::yield();
+    }
+}
 
-void DiskWriter::prepareSnippet()
+bool DiskWriter::enqueue( Recording* target, const float* samples, int amountOfFrames )
 {
-    // resize the currently active buffer to reflect its total written size
-    auto currentBuffer = getCachedOutputBuffer( currentBufferIndex );
-    if ( currentBuffer != nullptr ) {
-        currentBuffer->resize( outputWriterIndex );
+    size_t amountOfSamples = ( size_t ) amountOfFrames * target->frameSize;
+
+    while ( !target->queue.enqueue( samples, amountOfSamples ))
+    {
+        // when bouncing, the render thread isn't bound to real time and can await the writer thread
+        // otherwise we drop the frames (rather than blocking the render thread)
+
+        if ( !AudioEngine::recordingState.bouncing ) {
+            droppedFrames.fetch_add( amountOfFrames );
+            return false;
+        }
+        std::this_thread::yield();
     }
+    return true;
+}
 
-    // swap the currently active buffer index
-    currentBufferIndex = ( currentBufferIndex == 0 ) ? 1 : 0;
+void DiskWriter::runWriter()
+{
+    while ( writing.load( std::memory_order_acquire ))
+    {
+        if ( writeQueuedSamples() == 0 ) {
+            std::this_thread::sleep_for( WRITE_INTERVAL );
+        }
+    }
+    // write the samples queued since the last iteration
 
-    // generate output buffer for the next snippets index
-    generateOutputBuffer( currentBufferIndex, recordingChannelAmount );
+    writeQueuedSamples();
 }
 
-ResizableBufferGroup* DiskWriter::getCachedOutputBuffer( int bufferIndex )
+void DiskWriter::stopWriter()
 {
-    return cachedBuffers.at(( unsigned long ) bufferIndex );
+    if ( writerThread == nullptr ) {
+        return;
+    }
+    writing.store( false, std::memory_order_release );
+    writerThread->join();
+
+    delete writerThread;
+    writerThread = nullptr;
 }
 
-ResizableBufferGroup* DiskWriter::generateOutputBuffer( int bufferIndex, int amountOfChannels )
+size_t DiskWriter::writeQueuedSamples()
 {
-    flushOutput( bufferIndex ); // free previous contents when existing
+    size_t writtenFrames = 0;
+    size_t amountOfSamples;
 
-    if (( bufferIndex + 1 ) > cachedBuffers.size()) {
-        cachedBuffers.resize(( unsigned long ) ( bufferIndex ) + 1 );
-    }
-    int bufferAmount = isFullDuplex() ? 2 : 1;
-    auto *out = new ResizableBufferGroup( bufferAmount, amountOfChannels, recordingChunkSize );
+    // note the render thread only queues whole frames
+
+    int frameSize     = recording->frameSize;
+    int channelAmount = recording->channelAmount;
+
+    while (( amountOfSamples = recording->queue.dequeue( readBuffer.data(), readBuffer.size() )) > 0 )
+    {
+        size_t amountOfFrames = amountOfSamples / frameSize;
+
+        if ( frameSize == channelAmount ) {
+            writeSamples( readBuffer.data(), amountOfSamples );
+            writtenFrames += amountOfFrames;
+            continue;
+        }
+
+        // full duplex : mix the input with the output recorded the latency amount of frames before
+        // (as the input arrives later than the output it corresponds with)
+
+        size_t mixedSamples = 0;
+
+        for ( size_t i = 0, r = 0; i < amountOfFrames; ++i, r += frameSize, ++processedFrames )
+        {
+            const float* outputFrame = &readBuffer[ r ];
+            const float* inputFrame  = &readBuffer[ r + channelAmount ];
 
-    cachedBuffers.at(( unsigned long ) bufferIndex ) = out;
-    outputWriterIndex = 0;
+            if ( latency == 0 ) {
+                for ( int c = 0; c < channelAmount; ++c ) {
+                    mixBuffer[ mixedSamples++ ] = ( float ) capSampleSafe( outputFrame[ c ] + inputFrame[ c ] );
+                }
+                continue;
+            }
+            size_t slot = ( processedFrames % latency ) * channelAmount;
 
-    return out;
+            for ( int c = 0; c < channelAmount; ++c )
+            {
+                if ( processedFrames >= ( size_t ) latency ) {
+                    mixBuffer[ mixedSamples++ ] = ( float ) capSampleSafe( delayBuffer[ slot + c ] + inputFrame[ c ] );
+                }
+                delayBuffer[ slot + c ] = outputFrame[ c ];
+            }
+        }
+        writeSamples( mixBuffer.data(), mixedSamples );
+        writtenFrames += amountOfFrames;
+    }
+    return writtenFrames;
 }
 
-bool DiskWriter::isSnippetBufferFull()
+void DiskWriter::writeSamples( const float* samples, size_t amountOfSamples )
 {
-    return outputWriterIndex >= recordingChunkSize;
+    if ( amountOfSamples == 0 ) {
+        return;
+    }
+    WaveWriter::floatToPCM( samples, pcmBuffer.data(), amountOfSamples );
+    WaveWriter::appendBufferToStream( outputStream, pcmBuffer.data(), amountOfSamples * sizeof( INT16 ));
+
+    writtenSize += amountOfSamples * sizeof( INT16 );
 }
 
-void DiskWriter::flushOutput( int bufferIndex )
+void DiskWriter::writeDelayedFrames()
 {
-    auto *cachedBuffer = getCachedOutputBuffer( bufferIndex );
-    delete cachedBuffer;
-    cachedBuffers.at(( unsigned long ) bufferIndex ) = nullptr;
+    size_t amountOfFrames = std::min( processedFrames, ( size_t ) latency );
+    size_t firstFrame     = processedFrames >= ( size_t ) latency ? processedFrames % latency : 0;
+    size_t mixedSamples   = 0;
+    int channelAmount     = recording->channelAmount;
+
+    for ( size_t i = 0; i < amountOfFrames; ++i )
+    {
+        size_t slot = (( firstFrame + i ) % latency ) * channelAmount;
+
+        for ( int c = 0; c < channelAmount; ++c ) {
+            mixBuffer[ mixedSamples++ ] = ( float ) capSampleSafe( delayBuffer[ slot + c ] );
+        }
+        if ( mixedSamples == mixBuffer.size() ) {
+            writeSamples( mixBuffer.data(), mixedSamples );
+            mixedSamples = 0;
+        }
+    }
+    writeSamples( mixBuffer.data(), mixedSamples );
 }
 
 } // E.O namespace MWEngine
@@ -23,132 +23,144 @@
 #ifndef __MWENGINE__DISKWRITER_H_INCLUDED__
 #define __MWENGINE__DISKWRITER_H_INCLUDED__
 
+#include <atomic>
+#include <chrono>
+#include <fstream>
 #include <string>
+#include <thread>
 #include <vector>
-#include <resizable_buffergroup.h>
 #include <audioengine.h>
+#include <utilities/spscqueue.h>
 
 /**
- * DiskWriter is a utility that records audio for a given buffer length
- * (for instance to record a whole measure of live generated music) and
- * appends the AudioBuffer rendered by the engines until the buffer is full,
- * after which the contents can be written onto disk in PCM .WAV format
+ * DiskWriter is a utility that records the audio rendered by the engine
+ * into a PCM .WAV file.
  *
- * To overcome excessive memory consumption / CPU resources recordings are
- * written in snippets (with a length defined by chunkSize in the prepare()-method).
- * When a full snippet has been recorded, a
+ * The render thread appends its buffers into a lock-free queue, which is drained
+ * by a writer thread that converts the samples and appends them to the output file
+ * while the recording progresses. As such the render thread never writes to storage and
+ * completing a recording merely requires updating the size of the written WAV file.
+ *
+ * For full duplex recordings, the device input is mixed into the output by the
+ * writer thread, corrected for the roundtrip latency.
  */
 namespace MWEngine {
 class DiskWriter
 {
     public:
-        static int currentBufferIndex; // index of the cachedBuffer the output is currently being written to
-
         /**
-         * Prepare for a new recording. The recording can consist
-         * of multiple iterations, each of given chunkSize in buffer size.
-         * When completed (through finish()) the rendered file will be written to the path
-         * described by outputFilename.
-         */
-        static void prepare( std::string outputFilename, int chunkSize, int amountOfChannels );
-    
-        /**
-         * Verifies whether the current snippet is "complete" (e.g. its buffer is full)
-         * If so, this will broadcast RECORDED_SNIPPET_READY message so the current recording can
-         * be written to temporary storage.
-         *
-         * This saving should happen in a separate thread to prevent buffer under runs from occurring
-         * while the engine continues to render audio while recording large fragments. Saving should
-         * however complete before the next snippet has filled its complete buffer to prevent data loss!
-         *
-         * Additionally, this will prepare the next snippet and reset the write indices.
-         *
-         * @param {bool} force whether to force finish writing to the current snippet and swap the
-         *               active snippet buffers (otherwise swap only occurs when current snippet buffer is full)
-         * @param {bool} broadcast whether to broadcast RECORDED_SNIPPET_READY message (can be false
-         *               when halting all recording and executing synchronous writing during completion)
+         * Prepare for a new recording, written into the file at given outputFilename.
+         * bufferSize describes the amount of sample frames that can be buffered in memory
+         * before the writer thread must have written them onto storage (should storage
+         * stall for longer than this duration, the frames that don't fit are dropped).
          */
-        static bool updateSnippetProgress( bool force, bool broadcast );
-    
+        static void prepare( std::string outputFilename, int bufferSize, int amountOfChannels );
+
         /**
-         * Completes a recording. This will close the current snippet, write it to disk
-         * (synchronously) and subsequently combine all written files into a single WAV file
-         * (path defined by outputFile).
+         * Completes a recording. This waits for the writer thread to have written all
+         * buffered samples and finalizes the output file. Returns false when no recording
+         * was prepared or when the output file could not be written.
          *
-         * For best performance while keeping the engine rendering audio, execute
-         * this in a separate thread.
+         * When invoked from outside the render thread, the engine keeps rendering audio
+         * while the recording completes.
          */
         static bool finish();
 
         /**
-         * appends an AudioBuffer into the current snippets output buffer
+         * appends an AudioBuffer into the recording
          */
         static void appendBuffer( AudioBuffer* aBuffer );
 
         /**
-         * append the actual output buffer from the engine
-         * into the current snippets output buffer
+         * append the actual (interleaved) output buffer from the engine into the recording
          */
         static void appendBuffer( const float* outputBuffer, int bufferSize, int amountOfChannels );
 
         /**
          * same as appendBuffer() except that the contents of given inputBuffer are also mixed
-         * into the current snippets output buffer to allow simultaneous bi-directional recording.
-         * upon completion of recording, we will also be correcting for the given latencyInSamples
-         * to address a timing mismatch when mixing device input and output streams)
+         * into the recording to allow simultaneous bi-directional recording. When writing,
+         * the input is corrected for the roundtrip latency (to address a timing mismatch when
+         * mixing device input and output streams), e.g. AudioEngine::recordingState.latency
+         * at the moment the recording was prepared.
          */
-        static void appendDuplexBuffers( const float* outputBuffer, AudioBuffer* inputBuffer, int outputBufferSize, int amountOfChannels, int latencyInSamples );
+        static void appendDuplexBuffers( const float* outputBuffer, AudioBuffer* inputBuffer, int outputBufferSize, int amountOfChannels );
 
         /**
-         * write the contents of the snippet buffer into an output file, this will only write content
-         * up until the point the buffer was written to in order to cut silence in case the buffer
-         * wasn't filled in its entirety
+         * the amount of sample frames within the current recording that could not be
+         * buffered as the writer thread didn't keep up with the render thread
          */
-        static void writeBufferToFile( int bufferIndex, bool broadcastUpdate );
+        static int getDroppedFrames();
 
     private:
 
-        typedef struct
-        {
-            std::string path; // path to written WAV file
-            size_t size;      // total size of the WAV file's sample buffer
-    
-        } writtenFile;
-        
-        static std::string               outputFile;         // the file name to write the output to when finished
-        static std::string               tempDirectory;      // output directory to write temporary files to
-        static std::vector<writtenFile>  outputFiles;
-        static std::vector<ResizableBufferGroup*> cachedBuffers;
-
-        static int recordingChunkSize;
-        static int outputWriterIndex;
-        static int savedSnippets; // amount of snippets within the current recording that have been saved
-        static int recordingChannelAmount;
-        static bool prepared;
+        // the interval at which the writer thread writes the buffered samples onto storage
+        // and the maximum amount of frames written in a single write operation
 
-        /**
-         * Prepares the next snippet to continue recording audio into.
-         * We allow two snippets to exist at a time.
-         */
-        static void prepareSnippet();
+        static const std::chrono::microseconds WRITE_INTERVAL;
+        static const int WRITE_BLOCK_SIZE = 4096;
+
+        // the state of a single recording. Once published to the render thread it is never mutated,
+        // preparing a new recording retires the current one and frees it once no longer appended to
+
+        struct Recording {
+            Recording( int amountOfChannels, int samplesPerFrame, size_t queuedFrames, int appendedFrames ) :
+                queue( queuedFrames * samplesPerFrame ),
+                appendBufferData(( size_t ) appendedFrames * samplesPerFrame ),
+                channelAmount( amountOfChannels ),
+                frameSize( samplesPerFrame ) {}
+
+            SPSCQueue<float> queue;                // interleaved samples appended by the render thread
+            std::vector<float> appendBufferData;   // used to interleave the appended buffers prior to queueing
+            const int channelAmount;
+            const int frameSize;                   // amount of queued samples per frame (doubled for full duplex recordings as input follows output)
+        };
+
+        static std::string   outputFile;    // the file name to write the output to
+        static std::ofstream outputStream;
+        static std::thread*  writerThread;
+        static Recording*    recording;     // the recording owned by the control and writer thread
+
+        static std::atomic<Recording*> activeRecording; // the recording the render thread appends into
+        static std::atomic<int>        appending;       // whether the render thread is appending into the active recording
+        static std::atomic<bool>       writing;
+        static std::atomic<int>        droppedFrames;
+
+        static int latency;        // full duplex roundtrip latency in samples
+        static size_t writtenSize; // size (in bytes) of the WAV data written so far
+
+        // writer thread buffers
+
+        static std::vector<float> readBuffer;  // samples drained from the queue
+        static std::vector<float> mixBuffer;   // the latency corrected full duplex mix
+        static std::vector<INT16> pcmBuffer;   // the PCM conversion of the written samples
+        static std::vector<float> delayBuffer; // output frames awaiting the latency corrected input
+        static size_t processedFrames;         // the amount of full duplex frames processed
+
+        static Recording* acquireRecording(); // invoked by the render thread prior to appending (returns nullptr when not recording)
+        static void releaseRecording();
+        static void awaitAppending();        // invoked by the control thread after retiring the active recording
 
-        static ResizableBufferGroup* getCachedOutputBuffer( int bufferIndex );
+        static bool enqueue( Recording* target, const float* samples, int amountOfFrames );
+        static void runWriter();
+        static void stopWriter();
 
         /**
-         * allocates a new buffer (at given index) for writing output into
+         * writes all samples that are currently queued into the output file, returns
+         * the amount of frames that have been written
          */
-        static ResizableBufferGroup* generateOutputBuffer( int bufferIndex, int amountOfChannels );
+        static size_t writeQueuedSamples();
+        static void writeSamples( const float* samples, size_t amountOfSamples );
 
         /**
-         * checks whether the current write buffer is full
+         * writes the remaining output frames of a full duplex recording (these have
+         * no input to mix as it would have been recorded after recording stopped)
          */
-        static bool isSnippetBufferFull();
-        static void flushOutput( int bufferIndex );
+        static void writeDelayedFrames();
 
         /**
          * when the correctLatency flag is set, we know we are dealing with a full duplex recording
-         * as such, we write into separate engine output and device input buffers (so we can correct
-         * for the roundtrip latency on finish())
+         * as such, the engine output and device input are appended separately (so the writer
+         * thread can correct for the roundtrip latency)
          */
         static bool isFullDuplex() {
             return AudioEngine::recordingState.correctLatency;
@@ -0,0 +1,411 @@
+/**
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2026 Igor Zinken - https://www.igorski.nl
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#include "eventindex.h"
+#include <algorithm>
+#include <climits>
+#include <cstdint>
+
+namespace MWEngine {
+
+/* constructor */
+
+EventIndex::EventIndex()
+{
+    _root       = NONE;
+    _pooledNode = NONE;
+    _size       = 0;
+    _capacity   = 0;
+    _order      = 0;
+    _seed       = 2463534242;
+    _revision   = 0;
+}
+
+/* public methods */
+
+void EventIndex::reserve( size_t capacity )
+{
+    if ( capacity <= _capacity ) {
+        return;
+    }
+    _capacity = capacity;
+
+    _nodes.reserve( capacity );
+    _sorted.reserve( capacity );
+    _stack.reserve( capacity );
+
+    // keep the table at most half full (keeps the probe sequences short)
+
+    size_t amountOfSlots = 16;
+    while ( amountOfSlots < capacity * 2 ) {
+        amountOfSlots <<= 1;
+    }
+    if ( amountOfSlots > _slots.size() ) {
+        rehash( amountOfSlots );
+    }
+}
+
+void EventIndex::add( BaseAudioEvent* audioEvent )
+{
+    if ( _size >= _capacity ) {
+        reserve( std::max(( size_t ) 16, _capacity * 2 ));
+    }
+    int node = allocateNode();
+
+    // xorshift, the priorities only need to be random enough to keep the tree balanced
+
+    _seed ^= _seed << 13;
+    _seed ^= _seed >> 17;
+    _seed ^= _seed << 5;
+
+    Node& entry      = _nodes[ node ];
+    entry.start      = audioEvent->getEventStart();
+    entry.end        = audioEvent->getEventEnd();
+    entry.maxEnd     = entry.end;
+    entry.order      = _order++; // inserted after all events sharing the same start offset
+    entry.priority   = _seed;
+    entry.left       = NONE;
+    entry.right      = NONE;
+    entry.audioEvent = audioEvent;
+
+    insertSlot( audioEvent, node );
+
+    int left, right;
+    split( _root, node, left, right );
+    _root = merge( merge( left, node ), right );
+
+    ++_size;
+    ++_revision;
+}
+
+bool EventIndex::remove( BaseAudioEvent* audioEvent )
+{
+    // the events range might have changed since its addition, as such we look up its node by reference
+
+    size_t slot = findSlot( audioEvent );
+
+    if ( slot == SIZE_MAX ) {
+        return false;
+    }
+    int node = _slots[ slot ].node;
+    eraseSlot( slot );
+
+    _root = erase( _root, node );
+
+    _nodes[ node ].audioEvent = nullptr;
+    _nodes[ node ].left       = _pooledNode;
+    _pooledNode = node;
+
+    --_size;
+    ++_revision;
+
+    return true;
+}
+
+void EventIndex::clear()
+{
+    _nodes.clear();
+    std::fill( _slots.begin(), _slots.end(), Slot { nullptr, NONE });
+
+    _root       = NONE;
+    _pooledNode = NONE;
+    _size       = 0;
+    _order      = 0;
+    ++_revision;
+}
+
+void EventIndex::refresh()
+{
+    // collect the nodes in order
+
+    _sorted.clear();
+    _stack.clear();
+
+    int node = _root;
+
+    while ( node != NONE || !_stack.empty() )
+    {
+        while ( node != NONE ) {
+            _stack.push_back( node );
+            node = _nodes[ node ].left;
+        }
+        node = _stack.back();
+        _stack.pop_back();
+
+        _sorted.push_back( node );
+        node = _nodes[ node ].right;
+    }
+
+    for ( int sorted : _sorted ) {
+        _nodes[ sorted ].start = _nodes[ sorted ].audioEvent->getEventStart();
+        _nodes[ sorted ].end   = _nodes[ sorted ].audioEvent->getEventEnd();
+    }
+
+    // should individual events have moved out of order, restore it (linear for ordered lists)
+
+    for ( size_t i = 1; i < _sorted.size(); ++i )
+    {
+        int sorted = _sorted[ i ];
+        size_t j   = i;
+
+        for ( ; j > 0 && _nodes[ _sorted[ j - 1 ]].start > _nodes[ sorted ].start; --j ) {
+            _sorted[ j ] = _sorted[ j - 1 ];
+        }
+        _sorted[ j ] = sorted;
+    }
+
+    // rebuild the tree from the ordered nodes (retaining their priorities)
+
+    _stack.clear();
+
+    for ( size_t i = 0; i < _sorted.size(); ++i )
+    {
+        int sorted  = _sorted[ i ];
+        Node& entry = _nodes[ sorted ];
+        int last    = NONE;
+
+        entry.order = ( unsigned int ) i;
+        entry.right = NONE;
+
+        while ( !_stack.empty() && _nodes[ _stack.back() ].priority < entry.priority ) {
+            last = _stack.back();
+            _stack.pop_back();
+        }
+        entry.left = last;
+
+        if ( !_stack.empty() ) {
+            _nodes[ _stack.back() ].right = sorted;
+        }
+        _stack.push_back( sorted );
+    }
+    _root  = _stack.empty() ? NONE : _stack.front();
+    _order = ( unsigned int ) _sorted.size();
+
+    pullAll( _root );
+    ++_revision;
+}
+
+void EventIndex::swap( EventIndex& other )
+{
+    unsigned int revision = std::max( _revision, other._revision ) + 1;
+
+    std::swap( *this, other );
+
+    _revision       = revision;
+    other._revision = revision;
+}
+
+size_t EventIndex::size()
+{
+    return _size;
+}
+
+unsigned int EventIndex::getRevision()
+{
+    return _revision;
+}
+
+int EventIndex::getNextEventStart( int position )
+{
+    int nextStart = INT_MAX;
+    int node      = _root;
+
+    while ( node != NONE )
+    {
+        if ( _nodes[ node ].start > position ) {
+            nextStart = _nodes[ node ].start;
+            node      = _nodes[ node ].left;
+        } else {
+            node = _nodes[ node ].right;
+        }
+    }
+    return nextStart;
+}
+
+/* private methods */
+
+int EventIndex::allocateNode()
+{
+    if ( _pooledNode == NONE ) {
+        _nodes.push_back( Node());
+        return ( int ) _nodes.size() - 1;
+    }
+    int node    = _pooledNode;
+    _pooledNode = _nodes[ node ].left;
+
+    return node;
+}
+
+bool EventIndex::precedes( int node, int other )
+{
+    const Node& a = _nodes[ node ];
+    const Node& b = _nodes[ other ];
+
+    return a.start < b.start || ( a.start == b.start && a.order < b.order );
+}
+
+void EventIndex::pull( int node )
+{
+    Node& entry  = _nodes[ node ];
+    entry.maxEnd = entry.end;
+
+    if ( entry.left != NONE ) {
+        entry.maxEnd = std::max( entry.maxEnd, _nodes[ entry.left ].maxEnd );
+    }
+    if ( entry.right != NONE ) {
+        entry.maxEnd = std::max( entry.maxEnd, _nodes[ entry.right ].maxEnd );
+    }
+}
+
+void EventIndex::pullAll( int node )
+{
+    if ( node == NONE ) {
+        return;
+    }
+    pullAll( _nodes[ node ].left );
+    pullAll( _nodes[ node ].right );
+    pull( node );
+}
+
+// splits the subtree of given node into the nodes preceding given key node and the remaining nodes
+
+void EventIndex::split( int node, int key, int& left, int& right )
+{
+    if ( node == NONE ) {
+        left = right = NONE;
+        return;
+    }
+    if ( precedes( node, key )) {
+        split( _nodes[ node ].right, key, _nodes[ node ].right, right );
+        left = node;
+    } else {
+        split( _nodes[ node ].left, key, left, _nodes[ node ].left );
+        right = node;
+    }
+    pull( node );
+}
+
+// merges two subtrees where all nodes of the left subtree precede those of the right subtree
+
+int EventIndex::merge( int left, int right )
+{
+    if ( left == NONE ) {
+        return right;
+    }
+    if ( right == NONE ) {
+        return left;
+    }
+    if ( _nodes[ left ].priority > _nodes[ right ].priority ) {
+        int merged = merge( _nodes[ left ].right, right );
+        _nodes[ left ].right = merged;
+        pull( left );
+        return left;
+    }
+    int merged = merge( left, _nodes[ right ].left );
+    _nodes[ right ].left = merged;
+    pull( right );
+    return right;
+}
+
+int EventIndex::erase( int node, int target )
+{
+    if ( node == NONE ) {
+        return NONE;
+    }
+    if ( node == target ) {
+        return merge( _nodes[ node ].left, _nodes[ node ].right );
+    }
+    if ( precedes( target, node )) {
+        int left = erase( _nodes[ node ].left, target );
+        _nodes[ node ].left = left;
+    } else {
+        int right = erase( _nodes[ node ].right, target );
+        _nodes[ node ].right = right;
+    }
+    pull( node );
+    return node;
+}
+
+size_t EventIndex::hash( BaseAudioEvent* audioEvent )
+{
+    uint64_t value = reinterpret_cast<uintptr_t>( audioEvent ) >> 4;
+    return ( size_t )(( value * 0x9E3779B97F4A7C15ULL ) >> 32 ) & ( _slots.size() - 1 );
+}
+
+size_t EventIndex::findSlot( BaseAudioEvent* audioEvent )
+{
+    if ( audioEvent == nullptr || _slots.empty() ) {
+        return SIZE_MAX;
+    }
+    size_t mask = _slots.size() - 1;
+
+    for ( size_t slot = hash( audioEvent ); _slots[ slot ].audioEvent != nullptr; slot = ( slot + 1 ) & mask ) {
+        if ( _slots[ slot ].audioEvent == audioEvent ) {
+            return slot;
+        }
+    }
+    return SIZE_MAX;
+}
+
+void EventIndex::insertSlot( BaseAudioEvent* audioEvent, int node )
+{
+    size_t mask = _slots.size() - 1;
+    size_t slot = hash( audioEvent );
+
+    while ( _slots[ slot ].audioEvent != nullptr ) {
+        slot = ( slot + 1 ) & mask;
+    }
+    _slots[ slot ] = { audioEvent, node };
+}
+
+void EventIndex::eraseSlot( size_t slot )
+{
+    // shift the subsequent entries of the probe sequence back into the emptied slot
+
+    size_t mask = _slots.size() - 1;
+    size_t next = ( slot + 1 ) & mask;
+
+    for ( ; _slots[ next ].audioEvent != nullptr; next = ( next + 1 ) & mask )
+    {
+        size_t home = hash( _slots[ next ].audioEvent );
+
+        if ((( next - home ) & mask ) >= (( next - slot ) & mask )) {
+            _slots[ slot ] = _slots[ next ];
+            slot = next;
+        }
+    }
+    _slots[ slot ] = { nullptr, NONE };
+}
+
+void EventIndex::rehash( size_t amountOfSlots )
+{
+    std::vector<Slot> slots( amountOfSlots, Slot { nullptr, NONE });
+    _slots.swap( slots );
+
+    for ( auto& slot : slots ) {
+        if ( slot.audioEvent != nullptr ) {
+            insertSlot( slot.audioEvent, slot.node );
+        }
+    }
+}
+
+} // E.O namespace MWEngine
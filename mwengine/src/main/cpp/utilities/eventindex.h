@@ -0,0 +1,158 @@
+/**
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2026 Igor Zinken - https://www.igorski.nl
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#ifndef __MWENGINE__EVENTINDEX_H_INCLUDED__
+#define __MWENGINE__EVENTINDEX_H_INCLUDED__
+
+#include <events/baseaudioevent.h>
+#include <vector>
+
+namespace MWEngine {
+
+/**
+ * EventIndex indexes the sequenced events of an instrument by their playback range, answering
+ * which events overlap a given range in O(log n + k) (where k is the amount of overlapping events).
+ *
+ * The events are kept in a treap (a binary search tree ordered by event start offset, balanced by
+ * random node priorities) in which each node is augmented with the highest event end within its
+ * subtree. Subtrees whose highest end precedes the requested range are skipped in full. Adding and
+ * removing events is O(log n) and only updates the augmentation of the nodes along the affected path.
+ * The nodes are pooled and the events are mapped onto their node by an open addressing table, as
+ * such mutations don't allocate unless the reserved capacity is exceeded.
+ *
+ * The index reports each event only once, in order of its start offset.
+ */
+class EventIndex
+{
+    public:
+        EventIndex();
+
+        // reserve room for given amount of events (mutations won't allocate until it is exceeded)
+        void reserve( size_t capacity );
+
+        // add/remove given event, the range is that of the event at the moment of addition
+        void add( BaseAudioEvent* audioEvent );
+        bool remove( BaseAudioEvent* audioEvent );
+        void clear();
+
+        // re-reads the range of all indexed events in linear time and without allocating, for
+        // mutations that (mostly) retain the order of the events (e.g. repositioning to a tempo change)
+        void refresh();
+
+        size_t size();
+
+        // exchanges the contents of this index with given index (without allocating), e.g. to
+        // replace this index with one of a larger capacity. The revisions of both are incremented
+        void swap( EventIndex& other );
+
+        // the revision is incremented on each mutation (e.g. to determine whether previously queried results are still valid)
+        unsigned int getRevision();
+
+        // the start offset of the first event that starts after given position (INT_MAX when there is none)
+        int getNextEventStart( int position );
+
+        /**
+         * Invokes given callback (accepting a BaseAudioEvent*) for all
+         * events overlapping the range of rangeStart - rangeEnd (inclusive)
+         */
+        template <typename Callback>
+        void query( int rangeStart, int rangeEnd, Callback callback )
+        {
+            query( _root, rangeStart, rangeEnd, callback );
+        }
+
+    private:
+
+        static const int NONE = -1;
+
+        struct Node {
+            int start;
+            int end;
+            int maxEnd;             // the highest end within the subtree this node is the root of
+            unsigned int order;     // orders the nodes sharing the same start offset by their addition
+            unsigned int priority;
+            int left;
+            int right;              // when pooled, left references the next pooled node
+            BaseAudioEvent* audioEvent;
+        };
+
+        struct Slot {
+            BaseAudioEvent* audioEvent;
+            int node;
+        };
+
+        std::vector<Node> _nodes;
+        std::vector<Slot> _slots;  // maps the indexed events onto their node
+        std::vector<int>  _sorted; // scratch lists used by refresh()
+        std::vector<int>  _stack;
+
+        int _root;
+        int _pooledNode;
+        size_t _size;
+        size_t _capacity;
+        unsigned int _order;
+        unsigned int _seed;
+        unsigned int _revision;
+
+        int allocateNode();
+        bool precedes( int node, int other );
+        void pull( int node );
+        void pullAll( int node );
+        void split( int node, int key, int& left, int& right );
+        int merge( int left, int right );
+        int erase( int node, int target );
+
+        size_t hash( BaseAudioEvent* audioEvent );
+        size_t findSlot( BaseAudioEvent* audioEvent );
+        void insertSlot( BaseAudioEvent* audioEvent, int node );
+        void eraseSlot( size_t slot );
+        void rehash( size_t amountOfSlots );
+
+        template <typename Callback>
+        void query( int node, int rangeStart, int rangeEnd, Callback& callback )
+        {
+            if ( node == NONE ) {
+                return;
+            }
+            Node& entry = _nodes[ node ];
+
+            // none of the events in this subtree end within the range
+
+            if ( entry.maxEnd < rangeStart ) {
+                return;
+            }
+            query( entry.left, rangeStart, rangeEnd, callback );
+
+            // this and all subsequent events start after the range
+
+            if ( entry.start > rangeEnd ) {
+                return;
+            }
+            if ( entry.end >= rangeStart ) {
+                callback( entry.audioEvent );
+            }
+            query( entry.right, rangeStart, rangeEnd, callback );
+        }
+};
+} // E.O namespace MWEngine
+
+#endif
@@ -25,6 +25,7 @@
 
 #include <audioengine.h>
 #include <events/baseaudioevent.h>
+#include <algorithm>
 #include <vector>
 
 namespace MWEngine {
@@ -0,0 +1,149 @@
+/**
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2026 Igor Zinken - https://www.igorski.nl
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#include "offlinerenderer.h"
+#include "../audioengine.h"
+#include "../sequencer.h"
+#include <algorithm>
+
+namespace MWEngine {
+
+OfflineRenderer::OfflineRenderer( int rangeStart, int rangeEnd, int blockSize )
+{
+    _rangeStart     = rangeStart;
+    _rangeEnd       = rangeEnd;
+    _blockSize      = std::max( 1, std::min( blockSize, ( int ) AudioEngineProps::BUFFER_SIZE ));
+    _renderedFrames = 0;
+    _stemCapture    = new StemCapture();
+}
+
+OfflineRenderer::~OfflineRenderer()
+{
+    delete _stemCapture;
+}
+
+void OfflineRenderer::addStem( AudioChannel* channel, RenderSink* sink )
+{
+    _stemCapture->addChannel( channel, sink );
+}
+
+void OfflineRenderer::addStem( ChannelGroup* group, RenderSink* sink )
+{
+    _stemCapture->addGroup( group, sink );
+}
+
+bool OfflineRenderer::render( RenderSink* sink )
+{
+    _renderedFrames = 0;
+
+    // offline rendering shares the engine's render buffers and cannot run alongside the driver
+
+    bool hasStems = _stemCapture->getStemAmount() > 0;
+
+    if ( AudioEngineProps::isRendering.load() || ( sink == nullptr && !hasStems ) || _rangeStart < 0 || _rangeEnd < _rangeStart ) {
+        return false;
+    }
+
+    int totalFrames    = ( _rangeEnd - _rangeStart ) + 1;
+    int outputChannels = AudioEngineProps::OUTPUT_CHANNELS;
+
+    if ( sink != nullptr && !sink->open( totalFrames, outputChannels, AudioEngineProps::SAMPLE_RATE )) {
+        return false;
+    }
+
+    bool success = true;
+
+    if ( hasStems ) {
+        success = _stemCapture->open( totalFrames, outputChannels, AudioEngineProps::SAMPLE_RATE );
+        AudioEngine::stemCapture = _stemCapture;
+    }
+
+    // store the current sequencer state so it can be restored after rendering
+
+    int  minBufferPosition = AudioEngine::min_buffer_position;
+    int  maxBufferPosition = AudioEngine::max_buffer_position;
+    int  bufferPosition    = AudioEngine::bufferPosition;
+    int  stepPosition      = AudioEngine::stepPosition;
+    bool playing           = Sequencer::playing;
+
+    AudioEngine::allocateRenderBuffers();
+
+    AudioEngine::min_buffer_position = _rangeStart;
+    AudioEngine::max_buffer_position = _rangeEnd;
+    AudioEngine::bufferPosition      = _rangeStart;
+    Sequencer::playing               = true;
+
+    while ( success && _renderedFrames < totalFrames )
+    {
+        int amountOfSamples = std::min( _blockSize, totalFrames - _renderedFrames );
+        float* output       = AudioEngine::renderOutput( amountOfSamples, false );
+
+        if ( sink != nullptr && !sink->write( output, amountOfSamples )) {
+            success = false;
+        }
+
+        if ( hasStems && !_stemCapture->write( amountOfSamples )) {
+            success = false;
+        }
+        _renderedFrames += amountOfSamples;
+    }
+
+    AudioEngine::releaseRenderBuffers();
+    AudioEngine::stemCapture = nullptr;
+
+    AudioEngine::min_buffer_position = minBufferPosition;
+    AudioEngine::max_buffer_position = maxBufferPosition;
+    AudioEngine::bufferPosition      = bufferPosition;
+    AudioEngine::stepPosition        = stepPosition;
+    Sequencer::playing               = playing;
+
+    if ( hasStems && !_stemCapture->close()) {
+        success = false;
+    }
+
+    if ( sink != nullptr && !sink->close()) {
+        success = false;
+    }
+    return success;
+}
+
+int OfflineRenderer::getRangeStart()
+{
+    return _rangeStart;
+}
+
+int OfflineRenderer::getRangeEnd()
+{
+    return _rangeEnd;
+}
+
+int OfflineRenderer::getBlockSize()
+{
+    return _blockSize;
+}
+
+int OfflineRenderer::getRenderedFrames()
+{
+    return _renderedFrames;
+}
+
+} // E.O namespace MWEngine
@@ -0,0 +1,87 @@
+/**
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2026 Igor Zinken - https://www.igorski.nl
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#ifndef __MWENGINE__OFFLINERENDERER_H_INCLUDED__
+#define __MWENGINE__OFFLINERENDERER_H_INCLUDED__
+
+#include "rendersink.h"
+#include "stemcapture.h"
+
+/**
+ * OfflineRenderer renders a range of the sequencer into a RenderSink on the calling
+ * thread, without requiring the audio driver (or its render thread) to be running.
+ * Rendering happens as fast as the device allows and does not depend on the block size. Note
+ * that the state of the processors and events (e.g. the tail of a delay) is not reset in between
+ * renders, as such rendering the same range twice only yields identical output for stateless chains.
+ *
+ * The engine must have been setup (see AudioEngine::setup()) but must not be running
+ * while rendering offline. The sequencer position and loop range are restored once
+ * rendering completes. As the size of the range is fixed, queued tempo changes are not
+ * applied during an offline render (but once the engine starts).
+ */
+namespace MWEngine {
+class OfflineRenderer
+{
+    public:
+
+        /**
+         * rangeStart {int} the buffer position (in samples) rendering starts at
+         * rangeEnd {int} the buffer position (in samples) rendering ends at (inclusive)
+         * blockSize {int} the amount of samples rendered (and written into the sink) per
+         *           iteration, is capped to the engine's buffer size
+         */
+        OfflineRenderer( int rangeStart, int rangeEnd, int blockSize );
+        ~OfflineRenderer();
+
+        /**
+         * Registers a stem to be written into given sink during render(). A stem contains
+         * the signal of given AudioChannel / ChannelGroup after applying its ProcessingChain
+         * and volume, prior to the master bus. All stems are rendered within the same pass
+         * as the master mix.
+         */
+        void addStem( AudioChannel* channel, RenderSink* sink );
+        void addStem( ChannelGroup* group, RenderSink* sink );
+
+        /**
+         * Renders the range into given sink (the master mix, can be null when only rendering
+         * stems). Returns false when the engine is currently rendering, when the range is
+         * invalid or when a sink failed to receive the output
+         */
+        bool render( RenderSink* sink );
+
+        int getRangeStart();
+        int getRangeEnd();
+        int getBlockSize();
+
+        // the amount of sample frames written into the sink during the last render
+        int getRenderedFrames();
+
+    protected:
+        int _rangeStart;
+        int _rangeEnd;
+        int _blockSize;
+        int _renderedFrames;
+        StemCapture* _stemCapture;
+};
+} // E.O namespace MWEngine
+
+#endif
@@ -23,7 +23,11 @@
 #ifndef __MWENGINE__PERF_UTILITY_H_INCLUDED__
 #define __MWENGINE__PERF_UTILITY_H_INCLUDED__
 
+#include <cerrno>
 #include <ctime>
+#include <sched.h>
+#include <unistd.h>
+#include <vector>
 #include <utilities/debug.h>
 #ifdef MOCK_ENGINE
 #include <drivers/adapter.h>
@@ -77,6 +81,23 @@ namespace PerfUtility
         }
     }
 
+    /**
+     * Binds the calling thread to a single CPU core (e.g. for worker threads
+     * that should not migrate between cores during rendering)
+     */
+    inline bool pinThreadToCore( int cpuId )
+    {
+        cpu_set_t cpu_set;
+        CPU_ZERO( &cpu_set );
+        CPU_SET( cpuId, &cpu_set );
+
+        if ( sched_setaffinity( gettid(), sizeof( cpu_set_t ), &cpu_set ) != 0 ) {
+            Debug::log( "PerfUtility::Could not bind thread %d to CPU ID %d", gettid(), cpuId );
+            return false;
+        }
+        return true;
+    }
+
 #ifdef PREVENT_CPU_FREQUENCY_SCALING
 
     #define OPERATIONS_PER_STEP 20000
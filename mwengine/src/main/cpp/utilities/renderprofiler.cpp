@@ -0,0 +1,376 @@
+/**
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2026 Igor Zinken - https://www.igorski.nl
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#include "renderprofiler.h"
+
+#ifdef PROFILE_RENDER
+
+#include <processors/baseprocessor.h>
+#include <utilities/debug.h>
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+
+namespace MWEngine {
+namespace RenderProfiler
+{
+    // histogram resolution, values below 2 ^ SUB_BUCKET_BITS are stored in individual buckets
+    // (which are thus exact), beyond that each power of two is divided into 2 ^ SUB_BUCKET_BITS buckets
+
+    const int SUB_BUCKET_BITS = 3;
+    const int SUB_BUCKETS     = 1 << SUB_BUCKET_BITS;
+    const int BUCKETS         = SUB_BUCKETS * 40; // up to 2 ^ 42 ns (over an hour)
+    const int MAX_SLOTS       = 128;              // maximum amount of profiled stage / channel / processor combinations
+    const int NAME_LENGTH     = 32;
+
+    enum SlotStates {
+        SLOT_EMPTY,
+        SLOT_CLAIMING,
+        SLOT_READY,
+        SLOT_RELEASED // entry of an unregistered processor, lookups continue probing past it
+    };
+
+    struct Slot {
+        std::atomic<int> state;
+        Stages stage;
+        int channelId;
+        BaseProcessor* processor;
+        char name[ NAME_LENGTH ];
+
+        std::atomic<uint64_t> sum;
+        std::atomic<int64_t>  max;
+        std::atomic<uint32_t> buckets[ BUCKETS ];
+    };
+
+    struct ProcessorName {
+        std::atomic<int> state;
+        BaseProcessor* processor;
+        char name[ NAME_LENGTH ];
+    };
+
+    Slot _slots[ MAX_SLOTS ];
+    ProcessorName _processorNames[ MAX_SLOTS ];
+    std::atomic<uint64_t> _renderedTime( 0 );  // duration (in nanoseconds) of all rendered audio
+    std::atomic<uint64_t> _droppedRecords( 0 ); // records that could not be stored as all slots were occupied
+
+    const char* STAGE_NAMES[] = {
+        "RENDER_CYCLE", "SEQUENCER", "CHANNEL_EVENTS", "PROCESSOR", "GROUPS", "MASTER_BUS", "OUTPUT"
+    };
+
+    /* internal methods */
+
+    inline int getBucket( int64_t value )
+    {
+        if ( value < SUB_BUCKETS ) {
+            return value < 0 ? 0 : ( int ) value;
+        }
+        int msb    = 63 - __builtin_clzll(( uint64_t ) value );
+        int shift  = msb - SUB_BUCKET_BITS;
+        int bucket = ( shift + 1 ) * SUB_BUCKETS + (( int )( value >> shift ) & ( SUB_BUCKETS - 1 ));
+
+        return std::min( bucket, BUCKETS - 1 );
+    }
+
+    inline int64_t getBucketValue( int bucket )
+    {
+        if ( bucket < SUB_BUCKETS ) {
+            return bucket;
+        }
+        int shift = ( bucket / SUB_BUCKETS ) - 1;
+        int sub   = bucket % SUB_BUCKETS;
+
+        // return the center of the buckets range
+
+        int64_t lower = ( int64_t )( SUB_BUCKETS + sub ) << shift;
+        return lower + (( int64_t ) 1 << shift ) / 2;
+    }
+
+    inline size_t getSlotIndex( Stages stage, int channelId, BaseProcessor* processor )
+    {
+        uint64_t hash = ( uint64_t ) reinterpret_cast<uintptr_t>( processor );
+        hash ^= (( uint64_t )( uint32_t ) channelId << 8 ) ^ ( uint64_t ) stage;
+        hash *= 0x9E3779B97F4A7C15ULL;
+
+        return ( size_t )( hash >> 32 ) % MAX_SLOTS;
+    }
+
+    const char* getProcessorName( BaseProcessor* processor )
+    {
+        size_t index = getSlotIndex( PROCESSOR, 0, processor );
+
+        for ( int i = 0; i < MAX_SLOTS; ++i, index = ( index + 1 ) % MAX_SLOTS )
+        {
+            ProcessorName& entry = _processorNames[ index ];
+            int state = entry.state.load( std::memory_order_acquire );
+
+            if ( state == SLOT_EMPTY ) {
+                break;
+            }
+            if ( state == SLOT_READY && entry.processor == processor ) {
+                return entry.name;
+            }
+        }
+        return STAGE_NAMES[ PROCESSOR ];
+    }
+
+    Slot* getSlot( Stages stage, int channelId, BaseProcessor* processor )
+    {
+        size_t index = getSlotIndex( stage, channelId, processor );
+
+        for ( int i = 0; i < MAX_SLOTS; ++i, index = ( index + 1 ) % MAX_SLOTS )
+        {
+            Slot& slot = _slots[ index ];
+            int state  = slot.state.load( std::memory_order_acquire );
+
+            if ( state == SLOT_EMPTY )
+            {
+                if ( slot.state.compare_exchange_strong( state, SLOT_CLAIMING, std::memory_order_acq_rel )) {
+                    slot.stage     = stage;
+                    slot.channelId = channelId;
+                    slot.processor = processor;
+
+                    const char* name = processor != nullptr ? getProcessorName( processor ) : STAGE_NAMES[ stage ];
+                    strncpy( slot.name, name, NAME_LENGTH - 1 );
+                    slot.name[ NAME_LENGTH - 1 ] = '\0';
+
+                    slot.state.store( SLOT_READY, std::memory_order_release );
+                    return &slot;
+                }
+            }
+
+            // another thread is registering this slot (brief), wait for it to complete
+
+            while ( state == SLOT_CLAIMING ) {
+                state = slot.state.load( std::memory_order_acquire );
+            }
+
+            if ( slot.stage == stage && slot.channelId == channelId && slot.processor == processor ) {
+                return &slot;
+            }
+        }
+        return nullptr;
+    }
+
+    /* public methods */
+
+    void record( Stages stage, int64_t duration, int channelId, BaseProcessor* processor )
+    {
+        Slot* slot = getSlot( stage, channelId, processor );
+
+        if ( slot == nullptr ) {
+            _droppedRecords.fetch_add( 1, std::memory_order_relaxed );
+            return;
+        }
+        slot->buckets[ getBucket( duration ) ].fetch_add( 1, std::memory_order_relaxed );
+        slot->sum.fetch_add(( uint64_t ) std::max(( int64_t ) 0, duration ), std::memory_order_relaxed );
+
+        int64_t max = slot->max.load( std::memory_order_relaxed );
+        while ( duration > max && !slot->max.compare_exchange_weak( max, duration, std::memory_order_relaxed )) {
+            // max updated by the compare exchange, retry
+        }
+    }
+
+    void registerProcessor( BaseProcessor* processor )
+    {
+        std::string name = processor->getType();
+
+        // retry when another thread claimed the entry in the meantime
+
+        while ( true )
+        {
+            ProcessorName* available = nullptr;
+            int availableState       = SLOT_EMPTY;
+            size_t index             = getSlotIndex( PROCESSOR, 0, processor );
+
+            for ( int i = 0; i < MAX_SLOTS; ++i, index = ( index + 1 ) % MAX_SLOTS )
+            {
+                ProcessorName& entry = _processorNames[ index ];
+                int state = entry.state.load( std::memory_order_acquire );
+
+                if ( state == SLOT_READY && entry.processor == processor )
+                {
+                    // processor is already registered
+
+                    if ( name.compare( entry.name ) == 0 ) {
+                        return;
+                    }
+                    // rename the entry for this processor (its address has been reused)
+
+                    available      = &entry;
+                    availableState = state;
+                    break;
+                }
+
+                // the first released entry is reused, though only once it is known that
+                // the processor isn't registered further along the probe sequence
+
+                if ( state == SLOT_EMPTY || ( state == SLOT_RELEASED && available == nullptr )) {
+                    if ( available == nullptr ) {
+                        available      = &entry;
+                        availableState = state;
+                    }
+                    if ( state == SLOT_EMPTY ) {
+                        break;
+                    }
+                }
+            }
+
+            if ( available == nullptr ) {
+                return; // all entries are occupied
+            }
+
+            if ( available->state.compare_exchange_strong( availableState, SLOT_CLAIMING, std::memory_order_acq_rel ))
+            {
+                available->processor = processor;
+                strncpy( available->name, name.c_str(), NAME_LENGTH - 1 );
+                available->name[ NAME_LENGTH - 1 ] = '\0';
+
+                available->state.store( SLOT_READY, std::memory_order_release );
+                return;
+            }
+        }
+    }
+
+    void unregisterProcessor( BaseProcessor* processor )
+    {
+        size_t index = getSlotIndex( PROCESSOR, 0, processor );
+
+        for ( int i = 0; i < MAX_SLOTS; ++i, index = ( index + 1 ) % MAX_SLOTS )
+        {
+            ProcessorName& entry = _processorNames[ index ];
+            int state = entry.state.load( std::memory_order_acquire );
+
+            if ( state == SLOT_EMPTY ) {
+                return;
+            }
+            if ( state == SLOT_READY && entry.processor == processor ) {
+                entry.state.compare_exchange_strong( state, SLOT_RELEASED, std::memory_order_acq_rel );
+                return;
+            }
+        }
+    }
+
+    void recordCycle( int64_t duration, int amountOfSamples )
+    {
+        _renderedTime.fetch_add(( uint64_t ) amountOfSamples * NANOS_PER_SECOND / AudioEngineProps::SAMPLE_RATE, std::memory_order_relaxed );
+        record( RENDER_CYCLE, duration );
+    }
+
+    std::vector<Result> getResults()
+    {
+        std::vector<Result> results;
+        double renderedTime = ( double ) _renderedTime.load( std::memory_order_relaxed );
+
+        for ( int i = 0; i < MAX_SLOTS; ++i )
+        {
+            Slot& slot = _slots[ i ];
+
+            if ( slot.state.load( std::memory_order_acquire ) != SLOT_READY ) {
+                continue;
+            }
+
+            Result result;
+            result.name      = std::string( slot.name );
+            result.stage     = slot.stage;
+            result.channelId = slot.channelId;
+            result.count     = 0;
+            result.max       = slot.max.load( std::memory_order_relaxed );
+            result.dspLoad   = renderedTime > 0 ? ( double ) slot.sum.load( std::memory_order_relaxed ) / renderedTime * 100.0 : 0.0;
+
+            // take a snapshot of the buckets (these can be updated while we're reading)
+
+            uint32_t buckets[ BUCKETS ];
+            for ( int j = 0; j < BUCKETS; ++j ) {
+                buckets[ j ]  = slot.buckets[ j ].load( std::memory_order_relaxed );
+                result.count += buckets[ j ];
+            }
+
+            uint64_t p50threshold = ( result.count + 1 ) / 2;
+            uint64_t p99threshold = ( result.count * 99 + 99 ) / 100;
+            uint64_t accumulated  = 0;
+
+            result.p50 = result.p99 = 0;
+
+            for ( int j = 0; j < BUCKETS; ++j )
+            {
+                if ( buckets[ j ] == 0 ) {
+                    continue;
+                }
+                accumulated += buckets[ j ];
+
+                if ( result.p50 == 0 && accumulated >= p50threshold ) {
+                    result.p50 = std::min( getBucketValue( j ), result.max );
+                }
+                if ( accumulated >= p99threshold ) {
+                    result.p99 = std::min( getBucketValue( j ), result.max );
+                    break;
+                }
+            }
+            results.push_back( result );
+        }
+
+        std::sort( results.begin(), results.end(), []( const Result& a, const Result& b ) {
+            return a.stage == b.stage ? a.channelId < b.channelId : a.stage < b.stage;
+        });
+
+        return results;
+    }
+
+    void logResults()
+    {
+        Debug::log( "RenderProfiler::stage (channel) count, p50 / p99 / max in ns, DSP load %%" );
+
+        for ( auto const& result : getResults() ) {
+            Debug::log( "RenderProfiler::%s (%d) %llu, %lld / %lld / %lld, %.2f %%",
+                        result.name.c_str(), result.channelId, ( unsigned long long ) result.count,
+                        ( long long ) result.p50, ( long long ) result.p99, ( long long ) result.max,
+                        result.dspLoad );
+        }
+
+        uint64_t dropped = _droppedRecords.load( std::memory_order_relaxed );
+        if ( dropped > 0 ) {
+            Debug::log( "RenderProfiler::%llu records dropped (all slots occupied)", ( unsigned long long ) dropped );
+        }
+    }
+
+    void reset()
+    {
+        for ( int i = 0; i < MAX_SLOTS; ++i )
+        {
+            Slot& slot = _slots[ i ];
+
+            slot.sum.store( 0 );
+            slot.max.store( 0 );
+
+            for ( int j = 0; j < BUCKETS; ++j ) {
+                slot.buckets[ j ].store( 0 );
+            }
+            slot.state.store( SLOT_EMPTY );
+            _processorNames[ i ].state.store( SLOT_EMPTY );
+        }
+        _renderedTime.store( 0 );
+        _droppedRecords.store( 0 );
+    }
+}
+} // E.O namespace MWEngine
+
+#endif
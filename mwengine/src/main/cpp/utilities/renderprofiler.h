@@ -0,0 +1,146 @@
+/**
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2026 Igor Zinken - https://www.igorski.nl
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#ifndef __MWENGINE__RENDERPROFILER_H_INCLUDED__
+#define __MWENGINE__RENDERPROFILER_H_INCLUDED__
+
+#include "global.h"
+
+/**
+ * RenderProfiler measures how long each stage of AudioEngine::render() takes
+ * (see PROFILE_RENDER in global.h). When the definition is absent, the PROFILE_*
+ * macros expand to nothing so production builds do not pay for any of this.
+ */
+#ifdef PROFILE_RENDER
+
+#include <utilities/perfutility.h>
+#include <string>
+
+// starts a timer of given name within the current scope
+
+#define PROFILE_START( timer ) int64_t timer = PerfUtility::now()
+
+// records the time elapsed since given timer was started for given stage
+
+#define PROFILE_STOP( timer, stage ) RenderProfiler::record( RenderProfiler::stage, PerfUtility::now() - timer )
+#define PROFILE_STOP_CHANNEL( timer, stage, channel ) RenderProfiler::record( RenderProfiler::stage, PerfUtility::now() - timer, channel->instanceId )
+#define PROFILE_STOP_PROCESSOR( timer, channel, processor ) RenderProfiler::record( RenderProfiler::PROCESSOR, PerfUtility::now() - timer, channel->instanceId, processor )
+
+// records the duration of the complete render cycle for given amount of samples
+
+#define PROFILE_STOP_CYCLE( timer, amountOfSamples ) RenderProfiler::recordCycle( PerfUtility::now() - timer, amountOfSamples )
+
+// (un)registers the name of given processor (invoke from a non-render thread)
+
+#define PROFILE_REGISTER_PROCESSOR( processor ) RenderProfiler::registerProcessor( processor )
+#define PROFILE_UNREGISTER_PROCESSOR( processor ) RenderProfiler::unregisterProcessor( processor )
+
+namespace MWEngine {
+
+class BaseProcessor;
+
+namespace RenderProfiler
+{
+    enum Stages {
+        RENDER_CYCLE,   // the full AudioEngine::render() call
+        SEQUENCER,      // collection of the audio events (Sequencer::getAudioEvents())
+        CHANNEL_EVENTS, // mixing of the events of a single AudioChannel
+        PROCESSOR,      // a single BaseProcessor::process() call within an AudioChannel
+        GROUPS,         // processing of all ChannelGroups
+        MASTER_BUS,     // processing of the master bus
+        OUTPUT          // writing of the interleaved output and sequencer position update
+    };
+
+    /**
+     * Results are collected in histograms with 8 buckets per power of two (in nanoseconds)
+     * meaning percentiles are accurate to within 12.5 % of the measured value
+     * (the maximum value is exact)
+     */
+    struct Result {
+        std::string name;      // stage name, for processors this is the processors getType() value
+        Stages stage;
+        int channelId;         // AudioChannel instanceId, -1 when the stage isn't specific to a channel
+        uint64_t count;        // amount of recorded measurements
+        int64_t p50;           // median duration in nanoseconds
+        int64_t p99;           // 99th percentile duration in nanoseconds
+        int64_t max;           // maximum duration in nanoseconds
+        double dspLoad;        // percentage of the available render time (duration of the rendered audio) spent in this stage
+    };
+
+    /**
+     * Record a measured duration (in nanoseconds) for a stage. This is invoked from the
+     * render thread(s), all storage is preallocated and updated using atomic operations.
+     * When measuring a processor, pass the processor and the instanceId of the channel
+     * it belongs to. The name of the processor is that given in registerProcessor().
+     */
+    extern void record( Stages stage, int64_t duration, int channelId = -1, BaseProcessor* processor = nullptr );
+
+    /**
+     * Stores the name of given processor (see BaseProcessor::getType()) for use in its results.
+     * As this allocates, this is invoked from a non-render thread (e.g. when adding the processor to
+     * a ProcessingChain). Unregistered processors are reported under the PROCESSOR stage name.
+     */
+    extern void registerProcessor( BaseProcessor* processor );
+
+    /**
+     * Releases the name of given processor (e.g. when it is disposed) so its entry can be reused by
+     * other processors. Results that were recorded for the processor retain its name.
+     */
+    extern void unregisterProcessor( BaseProcessor* processor );
+
+    /**
+     * Records the duration of a full render cycle rendering given amount of
+     * samples (used to derive the DSP load percentages)
+     */
+    extern void recordCycle( int64_t duration, int amountOfSamples );
+
+    /**
+     * Retrieve the results collected so far. Should be invoked from a non-render thread.
+     */
+    extern std::vector<Result> getResults();
+
+    /**
+     * Logs the results (see Debug::log())
+     */
+    extern void logResults();
+
+    /**
+     * Clears all collected results (and channel / processor registrations)
+     * Invoke when the engine isn't rendering.
+     */
+    extern void reset();
+}
+} // E.O namespace MWEngine
+
+#else
+
+#define PROFILE_START( timer )
+#define PROFILE_STOP( timer, stage )
+#define PROFILE_STOP_CHANNEL( timer, stage, channel )
+#define PROFILE_STOP_PROCESSOR( timer, channel, processor )
+#define PROFILE_STOP_CYCLE( timer, amountOfSamples )
+#define PROFILE_REGISTER_PROCESSOR( processor )
+#define PROFILE_UNREGISTER_PROCESSOR( processor )
+
+#endif
+
+#endif
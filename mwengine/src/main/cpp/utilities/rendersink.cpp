@@ -0,0 +1,153 @@
+/**
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2026 Igor Zinken - https://www.igorski.nl
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#include "rendersink.h"
+#include "wavewriter.h"
+
+namespace MWEngine {
+
+/* MemoryRenderSink */
+
+MemoryRenderSink::MemoryRenderSink()
+{
+    _buffer     = nullptr;
+    _writeIndex = 0;
+}
+
+MemoryRenderSink::~MemoryRenderSink()
+{
+    delete _buffer;
+}
+
+bool MemoryRenderSink::open( int amountOfFrames, int amountOfChannels, int )
+{
+    delete _buffer;
+
+    _buffer     = new AudioBuffer( amountOfChannels, amountOfFrames );
+    _writeIndex = 0;
+
+    return true;
+}
+
+bool MemoryRenderSink::write( const float* buffer, int amountOfFrames )
+{
+    int amountOfChannels = _buffer->amountOfChannels;
+
+    if ( _writeIndex + amountOfFrames > _buffer->bufferSize ) {
+        return false;
+    }
+
+    for ( int c = 0; c < amountOfChannels; ++c )
+    {
+        SAMPLE_TYPE* channelBuffer = _buffer->getBufferForChannel( c );
+
+        for ( int i = 0, r = c; i < amountOfFrames; ++i, r += amountOfChannels ) {
+            channelBuffer[ _writeIndex + i ] = ( SAMPLE_TYPE ) buffer[ r ];
+        }
+    }
+    _writeIndex += amountOfFrames;
+
+    return true;
+}
+
+bool MemoryRenderSink::close()
+{
+    return _buffer != nullptr && _writeIndex == _buffer->bufferSize;
+}
+
+AudioBuffer* MemoryRenderSink::getBuffer()
+{
+    return _buffer;
+}
+
+/* WaveFileRenderSink */
+
+WaveFileRenderSink::WaveFileRenderSink( std::string outputFile )
+{
+    _outputFile       = outputFile;
+    _amountOfChannels = 0;
+}
+
+WaveFileRenderSink::~WaveFileRenderSink()
+{
+    if ( _stream.is_open() ) {
+        _stream.close();
+    }
+}
+
+bool WaveFileRenderSink::open( int amountOfFrames, int amountOfChannels, int sampleRate )
+{
+    // the total amount of frames is known upfront, as such the header can be written directly
+
+    size_t dataSize   = ( size_t ) amountOfFrames * amountOfChannels * sizeof( INT16 );
+    _stream           = WaveWriter::createWAVStream( _outputFile.c_str(), dataSize, sampleRate, amountOfChannels );
+    _amountOfChannels = amountOfChannels;
+
+    return _stream.good();
+}
+
+bool WaveFileRenderSink::write( const float* buffer, int amountOfFrames )
+{
+    size_t amountOfSamples = ( size_t ) amountOfFrames * _amountOfChannels;
+
+    if ( _pcmBuffer.size() < amountOfSamples ) {
+        _pcmBuffer.resize( amountOfSamples );
+    }
+    WaveWriter::floatToPCM( buffer, _pcmBuffer.data(), amountOfSamples );
+    WaveWriter::appendBufferToStream( _stream, _pcmBuffer.data(), amountOfSamples * sizeof( INT16 ));
+
+    return _stream.good();
+}
+
+bool WaveFileRenderSink::close()
+{
+    bool success = _stream.good();
+    _stream.close();
+
+    return success;
+}
+
+/* CallbackRenderSink */
+
+CallbackRenderSink::CallbackRenderSink( Callback callback )
+{
+    _callback         = callback;
+    _amountOfChannels = 0;
+}
+
+bool CallbackRenderSink::open( int, int amountOfChannels, int )
+{
+    _amountOfChannels = amountOfChannels;
+    return _callback != nullptr;
+}
+
+bool CallbackRenderSink::write( const float* buffer, int amountOfFrames )
+{
+    return _callback( buffer, amountOfFrames, _amountOfChannels );
+}
+
+bool CallbackRenderSink::close()
+{
+    return true;
+}
+
+} // E.O namespace MWEngine
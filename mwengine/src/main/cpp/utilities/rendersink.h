@@ -0,0 +1,118 @@
+/**
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2026 Igor Zinken - https://www.igorski.nl
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#ifndef __MWENGINE__RENDERSINK_H_INCLUDED__
+#define __MWENGINE__RENDERSINK_H_INCLUDED__
+
+#include "../audiobuffer.h"
+#include "../global.h"
+#include <fstream>
+#include <string>
+#include <vector>
+#ifndef SWIG
+#include <functional>
+#endif
+
+/**
+ * A RenderSink receives the output rendered by the OfflineRenderer. The output
+ * is provided in blocks of interleaved samples (as written into the audio driver)
+ */
+namespace MWEngine {
+class RenderSink
+{
+    public:
+        virtual ~RenderSink() {}
+
+        // invoked prior to rendering, returns false when the sink cannot receive given output
+        virtual bool open( int amountOfFrames, int amountOfChannels, int sampleRate ) = 0;
+
+        // receives the next block of rendered output, returns false when the block could not be written
+        virtual bool write( const float* buffer, int amountOfFrames ) = 0;
+
+        // invoked after rendering has completed, returns false when the output could not be finalized
+        virtual bool close() = 0;
+};
+
+/**
+ * Writes the output into an AudioBuffer
+ */
+class MemoryRenderSink : public RenderSink
+{
+    public:
+        MemoryRenderSink();
+        ~MemoryRenderSink();
+
+        bool open( int amountOfFrames, int amountOfChannels, int sampleRate );
+        bool write( const float* buffer, int amountOfFrames );
+        bool close();
+
+        // the rendered output (owned by the sink, valid until the next render into this sink)
+        AudioBuffer* getBuffer();
+
+    protected:
+        AudioBuffer* _buffer;
+        int _writeIndex;
+};
+
+/**
+ * Writes the output into a 16-bit PCM WAV file
+ */
+class WaveFileRenderSink : public RenderSink
+{
+    public:
+        explicit WaveFileRenderSink( std::string outputFile );
+        ~WaveFileRenderSink();
+
+        bool open( int amountOfFrames, int amountOfChannels, int sampleRate );
+        bool write( const float* buffer, int amountOfFrames );
+        bool close();
+
+    protected:
+        std::string _outputFile;
+        std::ofstream _stream;
+        std::vector<INT16> _pcmBuffer;
+        int _amountOfChannels;
+};
+
+#ifndef SWIG
+/**
+ * Provides the output to a callback (e.g. to encode or stream the output)
+ */
+class CallbackRenderSink : public RenderSink
+{
+    public:
+        typedef std::function<bool( const float* buffer, int amountOfFrames, int amountOfChannels )> Callback;
+
+        explicit CallbackRenderSink( Callback callback );
+
+        bool open( int amountOfFrames, int amountOfChannels, int sampleRate );
+        bool write( const float* buffer, int amountOfFrames );
+        bool close();
+
+    protected:
+        Callback _callback;
+        int _amountOfChannels;
+};
+#endif
+} // E.O namespace MWEngine
+
+#endif
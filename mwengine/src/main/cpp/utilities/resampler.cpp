@@ -0,0 +1,191 @@
+/**
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2026 Igor Zinken - https://www.igorski.nl
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#include "resampler.h"
+#include <cmath>
+#include <vector>
+
+namespace MWEngine {
+
+/* internal methods */
+
+namespace {
+
+    // cutoff frequency of the low pass filter (relative to the Nyquist frequency of the source), slightly
+    // below Nyquist to leave room for the transition band, and the shape of the Kaiser window (~ -70 dB stop band)
+
+    const double SINC_CUTOFF      = 0.9;
+    const double SINC_KAISER_BETA = 7.0;
+
+    // zeroth order modified Bessel function of the first kind (for the Kaiser window)
+
+    double besselI0( double x )
+    {
+        double sum  = 1.0;
+        double term = 1.0;
+
+        for ( int k = 1; k < 32; ++k ) {
+            term *= ( x / ( 2.0 * k )) * ( x / ( 2.0 * k ));
+            sum  += term;
+        }
+        return sum;
+    }
+
+    struct SincTable
+    {
+        float coefficients[( Resampler::SINC_PHASES + 1 ) * Resampler::SINC_TAPS ];
+
+        SincTable()
+        {
+            const int    offset     = Resampler::SINC_TAPS / 2 - 1;
+            const double halfLength = Resampler::SINC_TAPS / 2;
+            const double pi         = atan( 1.0 ) * 4.0;
+            const double windowNorm = besselI0( SINC_KAISER_BETA );
+
+            for ( int phase = 0; phase <= Resampler::SINC_PHASES; ++phase )
+            {
+                double frac = ( double ) phase / Resampler::SINC_PHASES;
+                double taps[ Resampler::SINC_TAPS ];
+                double sum  = 0.0;
+
+                for ( int k = 0; k < Resampler::SINC_TAPS; ++k )
+                {
+                    // distance of the tap to the read position
+
+                    double x      = ( k - offset ) - frac;
+                    double w      = x / halfLength;
+                    double sinc   = ( x == 0.0 ) ? 1.0 : sin( pi * SINC_CUTOFF * x ) / ( pi * SINC_CUTOFF * x );
+                    double window = ( fabs( w ) >= 1.0 ) ? 0.0 : besselI0( SINC_KAISER_BETA * sqrt( 1.0 - w * w )) / windowNorm;
+
+                    taps[ k ] = sinc * window;
+                    sum      += taps[ k ];
+                }
+
+                // normalize each phase to unity gain (so DC passes unaltered regardless of read position)
+
+                for ( int k = 0; k < Resampler::SINC_TAPS; ++k )
+                    coefficients[ phase * Resampler::SINC_TAPS + k ] = ( float ) ( taps[ k ] / sum );
+            }
+        }
+    };
+
+    // computed on static initialization, keeping the table out of the render thread
+
+    const SincTable sincTable;
+
+    // the offline conversion filter spans OFFLINE_ZERO_CROSSINGS zero crossings on either side of the read
+    // position, its (symmetrical) kernel is sampled at OFFLINE_RESOLUTION points per zero crossing
+
+    const int    OFFLINE_ZERO_CROSSINGS = 32;
+    const int    OFFLINE_RESOLUTION     = 512;
+    const double OFFLINE_CUTOFF         = 0.95;
+    const double OFFLINE_KAISER_BETA    = 10.0;
+
+    std::vector<double> createOfflineKernel()
+    {
+        const double pi = atan( 1.0 ) * 4.0;
+
+        int size = OFFLINE_ZERO_CROSSINGS * OFFLINE_RESOLUTION + 2; // + 2 for interpolating the last point
+        std::vector<double> kernel( size, 0.0 );
+
+        double windowNorm = besselI0( OFFLINE_KAISER_BETA );
+
+        for ( int i = 0; i <= OFFLINE_ZERO_CROSSINGS * OFFLINE_RESOLUTION; ++i ) {
+            double x = ( double ) i / OFFLINE_RESOLUTION;
+            double w = x / OFFLINE_ZERO_CROSSINGS;
+
+            kernel[ i ] = (( i == 0 ) ? 1.0 : sin( pi * x ) / ( pi * x )) * besselI0( OFFLINE_KAISER_BETA * sqrt( 1.0 - w * w )) / windowNorm;
+        }
+        return kernel;
+    }
+}
+
+/* public methods */
+
+const float* Resampler::getSincTable()
+{
+    return sincTable.coefficients;
+}
+
+AudioBuffer* Resampler::resample( AudioBuffer* buffer, unsigned int sourceSampleRate, unsigned int targetSampleRate )
+{
+    if ( sourceSampleRate == targetSampleRate || sourceSampleRate == 0 || targetSampleRate == 0 )
+        return buffer->clone();
+
+    int outputSize = ( int ) ((( int64_t ) buffer->bufferSize * targetSampleRate + sourceSampleRate / 2 ) / sourceSampleRate );
+    AudioBuffer* output = new AudioBuffer( buffer->amountOfChannels, std::max( 1, outputSize ));
+    output->loopeable   = buffer->loopeable;
+
+    std::vector<double> kernel = createOfflineKernel();
+
+    // when lowering the sample rate, the filter is stretched to cut off at the Nyquist frequency of the target rate
+
+    double cutoff    = OFFLINE_CUTOFF * std::min( 1.0, ( double ) targetSampleRate / sourceSampleRate );
+    double halfWidth = OFFLINE_ZERO_CROSSINGS / cutoff; // in source samples
+    int lastIndex    = buffer->bufferSize - 1;
+
+    std::vector<double> weights;
+
+    for ( int i = 0; i < output->bufferSize; ++i )
+    {
+        // exact read position within the source (expressed as a ratio of both sample rates)
+
+        int64_t position = ( int64_t ) i * sourceSampleRate;
+        int index        = ( int ) ( position / targetSampleRate );
+        double frac      = ( double ) ( position % targetSampleRate ) / targetSampleRate;
+
+        int first = index - ( int ) floor( halfWidth );
+        int last  = index + ( int ) ceil( halfWidth );
+
+        weights.resize( last - first + 1 );
+        double weightSum = 0.0;
+
+        for ( int k = first; k <= last; ++k ) {
+            double kernelPosition = fabs(( k - index ) - frac ) * cutoff * OFFLINE_RESOLUTION;
+            int    kernelIndex    = ( int ) kernelPosition;
+            double weight         = 0.0;
+
+            if ( kernelIndex < OFFLINE_ZERO_CROSSINGS * OFFLINE_RESOLUTION ) {
+                double kernelFrac = kernelPosition - kernelIndex;
+                weight = kernel[ kernelIndex ] + ( kernel[ kernelIndex + 1 ] - kernel[ kernelIndex ] ) * kernelFrac;
+            }
+            weights[ k - first ] = weight;
+            weightSum += weight;
+        }
+
+        // normalize to unity gain, samples outside of the source are silent
+
+        for ( int c = 0; c < buffer->amountOfChannels; ++c )
+        {
+            SAMPLE_TYPE* source = buffer->getBufferForChannel( c );
+            double sum = 0.0;
+
+            for ( int k = std::max( first, 0 ), end = std::min( last, lastIndex ); k <= end; ++k )
+                sum += source[ k ] * weights[ k - first ];
+
+            output->getBufferForChannel( c )[ i ] = ( SAMPLE_TYPE ) ( sum / weightSum );
+        }
+    }
+    return output;
+}
+
+} // E.O namespace MWEngine
@@ -0,0 +1,207 @@
+/**
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2026 Igor Zinken - https://www.igorski.nl
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#ifndef __MWENGINE__RESAMPLER_H_INCLUDED__
+#define __MWENGINE__RESAMPLER_H_INCLUDED__
+
+#include "../global.h"
+#include "../audiobuffer.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+
+namespace MWEngine {
+
+/**
+ * Resampler provides the interpolation kernels used to read sample data at a
+ * playback rate other than 1 (e.g. pitch shifted SampleEvents or samples recorded at a
+ * different sample rate than the engine's).
+ *
+ * Read positions are expressed as 32.32 fixed point phases : the upper 32 bits hold the
+ * index of the sample, the lower 32 bits the fractional position in between that sample
+ * and the next. Unlike floating point read pointers, phases do not lose resolution at large
+ * offsets, nor do they accumulate rounding errors while being incremented by the playback rate.
+ */
+class Resampler
+{
+    public:
+
+        // interpolation qualities, in order of increasing quality (and CPU usage)
+
+        enum qualities {
+            LINEAR,  // 2-point linear interpolation
+            HERMITE, // 4-point, 3rd order Hermite interpolation
+            SINC     // polyphase windowed-sinc interpolation (see SINC_TAPS and SINC_PHASES)
+        };
+
+        static const int FRACTION_BITS = 32;
+
+        // the windowed-sinc filter is precomputed for SINC_PHASES fractional positions (in
+        // between which is interpolated linearly), each phase convolving SINC_TAPS samples
+        // surrounding the read position (SINC_TAPS / 2 - 1 preceding samples and SINC_TAPS / 2 following)
+
+        static const int SINC_TAPS   = 16;
+        static const int SINC_PHASES = 256;
+
+        static inline int64_t toPhase( double position )
+        {
+            return ( int64_t ) llround( position * 4294967296.0 );
+        }
+
+        static inline int64_t fromIndex( int index )
+        {
+            return ( int64_t ) index << FRACTION_BITS;
+        }
+
+        static inline int getIndex( int64_t phase )
+        {
+            return ( int ) ( phase >> FRACTION_BITS );
+        }
+
+        // index of the sample nearest to given phase
+
+        static inline int roundIndex( int64_t phase )
+        {
+            return ( int ) (( phase + ( INT64_C( 1 ) << ( FRACTION_BITS - 1 ))) >> FRACTION_BITS );
+        }
+
+        static inline SAMPLE_TYPE getFraction( int64_t phase )
+        {
+            return ( SAMPLE_TYPE ) ( uint32_t ) phase * ( SAMPLE_TYPE ) 2.3283064365386963e-10; // 1 / 2^32
+        }
+
+        // the filter coefficients, ( SINC_PHASES + 1 ) rows of SINC_TAPS coefficients
+        // (the last row describes a fractional position of 1 for interpolating the last phase)
+
+        static const float* getSincTable();
+
+        // creates a new AudioBuffer holding the contents of given AudioBuffer converted from given source
+        // sample rate to given target sample rate. This is an offline conversion using a long windowed-sinc
+        // filter (band limited to the lower of both Nyquist frequencies) and should not be invoked from
+        // the render thread. Returns a clone of given buffer when the sample rates are equal
+
+        static AudioBuffer* resample( AudioBuffer* buffer, unsigned int sourceSampleRate, unsigned int targetSampleRate );
+
+#ifndef SWIG
+        // internal to the engine, mixes given amount of samples into given target buffer, reading the
+        // samples of given channel (either a SAMPLE_TYPE* or a CompactBuffer::Channel) at given phases,
+        // multiplied by the gain given for each sample (gain of 0 for positions that should not be read).
+        // lastIndex describes the last readable index of the channel, interpolation taps outside
+        // of the channel are clamped to its range
+
+        template <typename Channel>
+        static void mix( const Channel& channel, const int64_t* phases, const SAMPLE_TYPE* gains,
+                         SAMPLE_TYPE* target, int amountOfSamples, int lastIndex, int quality );
+#endif
+};
+
+#ifndef SWIG
+
+template <typename Channel>
+void Resampler::mix( const Channel& channel, const int64_t* phases, const SAMPLE_TYPE* gains,
+                     SAMPLE_TYPE* target, int amountOfSamples, int lastIndex, int quality )
+{
+    // the quality is resolved once per block, leaving branch free inner loops
+
+    switch ( quality )
+    {
+        default:
+        case LINEAR:
+        {
+            for ( int i = 0; i < amountOfSamples; ++i )
+            {
+                int t  = std::min( std::max( getIndex( phases[ i ] ), 0 ), lastIndex );
+                int t2 = std::min( t + 1, lastIndex );
+
+                SAMPLE_TYPE s1 = channel[ t ];
+                SAMPLE_TYPE s2 = channel[ t2 ];
+
+                target[ i ] += ( s1 + ( s2 - s1 ) * getFraction( phases[ i ] )) * gains[ i ];
+            }
+            break;
+        }
+
+        case HERMITE:
+        {
+            for ( int i = 0; i < amountOfSamples; ++i )
+            {
+                int t = std::min( std::max( getIndex( phases[ i ] ), 0 ), lastIndex );
+
+                SAMPLE_TYPE xm1  = channel[ std::max( t - 1, 0 )];
+                SAMPLE_TYPE x0   = channel[ t ];
+                SAMPLE_TYPE x1   = channel[ std::min( t + 1, lastIndex )];
+                SAMPLE_TYPE x2   = channel[ std::min( t + 2, lastIndex )];
+                SAMPLE_TYPE frac = getFraction( phases[ i ] );
+
+                SAMPLE_TYPE c1 = ( SAMPLE_TYPE ) .5 * ( x1 - xm1 );
+                SAMPLE_TYPE c2 = xm1 - ( SAMPLE_TYPE ) 2.5 * x0 + ( SAMPLE_TYPE ) 2. * x1 - ( SAMPLE_TYPE ) .5 * x2;
+                SAMPLE_TYPE c3 = ( SAMPLE_TYPE ) .5 * ( x2 - xm1 ) + ( SAMPLE_TYPE ) 1.5 * ( x0 - x1 );
+
+                target[ i ] += ((( c3 * frac + c2 ) * frac + c1 ) * frac + x0 ) * gains[ i ];
+            }
+            break;
+        }
+
+        case SINC:
+        {
+            const float* table = getSincTable();
+            const int offset   = SINC_TAPS / 2 - 1;
+
+            SAMPLE_TYPE taps[ SINC_TAPS ];
+
+            for ( int i = 0; i < amountOfSamples; ++i )
+            {
+                int t = std::min( std::max( getIndex( phases[ i ] ), 0 ), lastIndex ) - offset;
+
+                // the upper 8 bits of the fraction select one of the SINC_PHASES, the remaining bits interpolate to the next phase
+
+                uint32_t fraction      = ( uint32_t ) phases[ i ];
+                const float* row       = table + ( fraction >> 24 ) * SINC_TAPS;
+                SAMPLE_TYPE  rowFrac   = ( SAMPLE_TYPE ) ( fraction & 0xffffff ) * ( SAMPLE_TYPE ) 5.9604644775390625e-8; // 1 / 2^24
+
+                if ( t >= 0 && t + SINC_TAPS - 1 <= lastIndex ) {
+                    for ( int k = 0; k < SINC_TAPS; ++k )
+                        taps[ k ] = channel[ t + k ];
+                }
+                else {
+                    for ( int k = 0; k < SINC_TAPS; ++k )
+                        taps[ k ] = channel[ std::min( std::max( t + k, 0 ), lastIndex )];
+                }
+
+                SAMPLE_TYPE sum = 0.0;
+
+                for ( int k = 0; k < SINC_TAPS; ++k ) {
+                    SAMPLE_TYPE coefficient = row[ k ] + ( row[ k + SINC_TAPS ] - row[ k ] ) * rowFrac;
+                    sum += taps[ k ] * coefficient;
+                }
+                target[ i ] += sum * gains[ i ];
+            }
+            break;
+        }
+    }
+}
+
+#endif
+
+} // E.O namespace MWEngine
+
+#endif
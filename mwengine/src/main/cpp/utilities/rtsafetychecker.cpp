@@ -0,0 +1,204 @@
+/**
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2026 Igor Zinken - https://www.igorski.nl
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#include "rtsafetychecker.h"
+
+#ifdef CHECK_RT_SAFETY
+
+#include <atomic>
+#include <dlfcn.h>
+#include <execinfo.h>
+#include <new>
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+// the original implementations of the intercepted functions
+
+extern "C" {
+    void* __libc_malloc ( size_t size );
+    void* __libc_calloc ( size_t amount, size_t size );
+    void* __libc_realloc( void* ptr, size_t size );
+}
+
+namespace MWEngine {
+namespace RTSafetyChecker
+{
+    const int MAX_STACK_DEPTH = 32;
+
+    thread_local int _renderDepth  = 0;
+    thread_local int _suspendDepth = 0;
+    thread_local bool _reporting   = false;
+
+    std::atomic<uint64_t> _violations( 0 );
+
+    typedef int ( *MutexLockFunction )( pthread_mutex_t* );
+    std::atomic<MutexLockFunction> _mutexLock( nullptr );
+
+    MutexLockFunction getMutexLock()
+    {
+        MutexLockFunction function = _mutexLock.load( std::memory_order_acquire );
+
+        if ( function == nullptr ) {
+            function = ( MutexLockFunction ) dlsym( RTLD_NEXT, "pthread_mutex_lock" );
+            _mutexLock.store( function, std::memory_order_release );
+        }
+        return function;
+    }
+
+    // resolve the symbols and load the unwinder used by backtrace() upon
+    // startup, so doing so on first violation doesn't allocate in turn
+
+    __attribute__(( constructor )) void initialize()
+    {
+        void* stack[ 1 ];
+        backtrace( stack, 1 );
+        getMutexLock();
+    }
+
+    /* public methods */
+
+    uint64_t getViolations()
+    {
+        return _violations.load();
+    }
+
+    void reset()
+    {
+        _violations.store( 0 );
+    }
+
+    bool isChecking()
+    {
+        return _renderDepth > 0 && _suspendDepth == 0 && !_reporting;
+    }
+
+    /* internal methods */
+
+    void report( const char* functionName )
+    {
+        _reporting = true;
+        _violations.fetch_add( 1 );
+
+        // note we solely write to the file descriptor (unbuffered, doesn't allocate)
+
+        char message[ 128 ];
+        int length = snprintf( message, sizeof( message ), "RTSafetyChecker::%s invoked during render cycle, call stack:\n", functionName );
+        write( STDERR_FILENO, message, length );
+
+        void* stack[ MAX_STACK_DEPTH ];
+        int depth = backtrace( stack, MAX_STACK_DEPTH );
+        backtrace_symbols_fd( stack, depth, STDERR_FILENO );
+
+        _reporting = false;
+    }
+
+    RenderScope::RenderScope()
+    {
+        ++_renderDepth;
+    }
+
+    RenderScope::~RenderScope()
+    {
+        --_renderDepth;
+    }
+
+    SuspendScope::SuspendScope()
+    {
+        ++_suspendDepth;
+    }
+
+    SuspendScope::~SuspendScope()
+    {
+        --_suspendDepth;
+    }
+}
+} // E.O namespace MWEngine
+
+using namespace MWEngine;
+
+/* intercepted functions */
+
+extern "C" void* malloc( size_t size )
+{
+    if ( RTSafetyChecker::isChecking() ) {
+        RTSafetyChecker::report( "malloc" );
+    }
+    return __libc_malloc( size );
+}
+
+extern "C" void* calloc( size_t amount, size_t size )
+{
+    if ( RTSafetyChecker::isChecking() ) {
+        RTSafetyChecker::report( "calloc" );
+    }
+    return __libc_calloc( amount, size );
+}
+
+extern "C" void* realloc( void* ptr, size_t size )
+{
+    if ( RTSafetyChecker::isChecking() ) {
+        RTSafetyChecker::report( "realloc" );
+    }
+    return __libc_realloc( ptr, size );
+}
+
+extern "C" int pthread_mutex_lock( pthread_mutex_t* mutex )
+{
+    if ( RTSafetyChecker::isChecking() ) {
+        RTSafetyChecker::report( "pthread_mutex_lock" );
+    }
+    return RTSafetyChecker::getMutexLock()( mutex );
+}
+
+void* operator new( size_t size )
+{
+    if ( RTSafetyChecker::isChecking() ) {
+        RTSafetyChecker::report( "operator new" );
+    }
+    void* ptr = __libc_malloc( size == 0 ? 1 : size );
+    if ( ptr == nullptr ) {
+        throw std::bad_alloc();
+    }
+    return ptr;
+}
+
+void* operator new[]( size_t size )
+{
+    return operator new( size );
+}
+
+void* operator new( size_t size, const std::nothrow_t& ) noexcept
+{
+    if ( RTSafetyChecker::isChecking() ) {
+        RTSafetyChecker::report( "operator new" );
+    }
+    return __libc_malloc( size == 0 ? 1 : size );
+}
+
+void* operator new[]( size_t size, const std::nothrow_t& tag ) noexcept
+{
+    return operator new( size, tag );
+}
+
+#endif
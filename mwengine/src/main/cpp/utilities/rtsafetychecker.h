@@ -0,0 +1,93 @@
+/**
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2026 Igor Zinken - https://www.igorski.nl
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#ifndef __MWENGINE__RTSAFETYCHECKER_H_INCLUDED__
+#define __MWENGINE__RTSAFETYCHECKER_H_INCLUDED__
+
+/**
+ * RTSafetyChecker verifies the render cycle is real-time safe, e.g. it doesn't allocate
+ * heap memory nor acquire locks (which can block the render thread for an undetermined
+ * amount of time, leading to buffer under runs).
+ *
+ * When CHECK_RT_SAFETY is defined (e.g. for the host build, see CMakeLists.txt)
+ * operator new, malloc, calloc, realloc and pthread_mutex_lock are intercepted. When
+ * invoked from a thread that is within a render scope, the violation is counted and
+ * the call stack of the offending call site is printed to stderr.
+ *
+ * The checker is only available for host builds (relies on glibc symbol interposition),
+ * when the definition is absent the RT_SAFETY_* macros expand to nothing.
+ */
+#ifdef CHECK_RT_SAFETY
+
+#include <stdint.h>
+
+// marks the remainder of the current scope as part of the render cycle
+
+#define RT_SAFETY_SCOPE() RTSafetyChecker::RenderScope __rtSafetyScope
+
+// suspends the checks for the remainder of the current scope (for instance for
+// the audio driver write, which is expected to block until the hardware is ready)
+
+#define RT_SAFETY_SUSPEND() RTSafetyChecker::SuspendScope __rtSafetySuspendScope
+
+namespace MWEngine {
+namespace RTSafetyChecker
+{
+    /**
+     * The amount of violations detected since the last reset()
+     */
+    extern uint64_t getViolations();
+
+    extern void reset();
+
+    /**
+     * Whether the calling thread is currently within a render scope
+     * (where allocations and locks are considered violations)
+     */
+    extern bool isChecking();
+
+    /* scopes */
+
+    class RenderScope
+    {
+        public:
+            RenderScope();
+            ~RenderScope();
+    };
+
+    class SuspendScope
+    {
+        public:
+            SuspendScope();
+            ~SuspendScope();
+    };
+}
+} // E.O namespace MWEngine
+
+#else
+
+#define RT_SAFETY_SCOPE()
+#define RT_SAFETY_SUSPEND()
+
+#endif
+
+#endif
@@ -0,0 +1,222 @@
+/**
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2026 Igor Zinken - https://www.igorski.nl
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#include "samplebank.h"
+#include "debug.h"
+#include <cstring>
+#include <fcntl.h>
+#include <fstream>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace MWEngine {
+
+/* constructor / destructor */
+
+SampleBank::SampleBank( char* data, size_t size )
+{
+    _data    = data;
+    _size    = size;
+    _entries = ( const bankEntry* ) ( data + sizeof( bankHeader ));
+    _amountOfSamples = ( int ) (( const bankHeader* ) data )->amountOfSamples;
+}
+
+SampleBank::~SampleBank()
+{
+    munmap( _data, _size );
+}
+
+/* public methods */
+
+bool SampleBank::write( std::string outputFile, const std::vector<bankSample>& samples )
+{
+    std::ofstream stream( outputFile, std::ios::out | std::ios::binary | std::ios::trunc );
+
+    if ( !stream.is_open()) {
+        Debug::log( "SampleBank::Error could not create file '%s'", outputFile.c_str() );
+        return false;
+    }
+
+    bankHeader header = { { 'M', 'W', 'S', 'B' }, VERSION, sizeof( SAMPLE_TYPE ), ( uint32_t ) samples.size() };
+
+    // calculate the offsets of the identifiers and sample data
+
+    std::vector<bankEntry> entries( samples.size() );
+    size_t offset = sizeof( bankHeader ) + sizeof( bankEntry ) * samples.size();
+
+    for ( size_t i = 0; i < samples.size(); ++i ) {
+        entries[ i ].nameOffset = offset;
+        entries[ i ].nameLength = ( uint32_t ) samples[ i ].identifier.size();
+        offset += samples[ i ].identifier.size();
+    }
+
+    for ( size_t i = 0; i < samples.size(); ++i ) {
+        AudioBuffer* buffer = samples[ i ].buffer;
+        offset = align( offset );
+
+        entries[ i ].dataOffset       = offset;
+        entries[ i ].amountOfChannels = ( uint32_t ) buffer->amountOfChannels;
+        entries[ i ].length           = ( uint32_t ) buffer->bufferSize;
+        entries[ i ].sampleRate       = samples[ i ].sampleRate;
+
+        offset += getChannelSize( entries[ i ].length ) * buffer->amountOfChannels;
+    }
+
+    stream.write(( const char* ) &header, sizeof( bankHeader ));
+    stream.write(( const char* ) entries.data(), sizeof( bankEntry ) * entries.size() );
+
+    for ( auto& sample : samples ) {
+        stream.write( sample.identifier.data(), sample.identifier.size() );
+    }
+
+    // write the planar sample data, padding each channel up to the next aligned offset
+
+    const char padding[ DATA_ALIGNMENT ] = { 0 };
+
+    for ( size_t i = 0; i < samples.size(); ++i ) {
+        size_t position = ( size_t ) stream.tellp();
+        stream.write( padding, entries[ i ].dataOffset - position );
+
+        size_t channelBytes = entries[ i ].length * sizeof( SAMPLE_TYPE );
+
+        for ( uint32_t c = 0; c < entries[ i ].amountOfChannels; ++c ) {
+            stream.write(( const char* ) samples[ i ].buffer->getBufferForChannel( c ), channelBytes );
+            stream.write( padding, getChannelSize( entries[ i ].length ) - channelBytes );
+        }
+    }
+    bool success = stream.good();
+    stream.close();
+
+    if ( !success ) {
+        Debug::log( "SampleBank::Error could not write file '%s'", outputFile.c_str() );
+    }
+    return success;
+}
+
+SampleBank* SampleBank::open( std::string inputFile )
+{
+    int fd = ::open( inputFile.c_str(), O_RDONLY );
+
+    if ( fd < 0 ) {
+        Debug::log( "SampleBank::Error could not open file '%s'", inputFile.c_str() );
+        return nullptr;
+    }
+
+    struct stat fileStats;
+    size_t size = ( fstat( fd, &fileStats ) == 0 ) ? ( size_t ) fileStats.st_size : 0;
+
+    if ( size < sizeof( bankHeader )) {
+        Debug::log( "SampleBank::Error '%s' is not a valid sample bank", inputFile.c_str() );
+        close( fd );
+        return nullptr;
+    }
+
+    // the mapping is private (copy-on-write) so the samples AudioBuffers remain writable without altering the file
+
+    void* mapping = mmap( nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0 );
+    close( fd ); // mapping remains valid after closing the descriptor
+
+    if ( mapping == MAP_FAILED ) {
+        Debug::log( "SampleBank::Error could not map file '%s'", inputFile.c_str() );
+        return nullptr;
+    }
+
+    // validate the header and the index (note this solely touches the pages containing the index)
+
+    char* data = ( char* ) mapping;
+    const bankHeader* header = ( const bankHeader* ) data;
+    bool isValid = memcmp( header->id, "MWSB", 4 ) == 0 && header->version == VERSION;
+
+    if ( isValid && header->sampleSize != sizeof( SAMPLE_TYPE )) {
+        Debug::log( "SampleBank::Error '%s' was written at %d-bit precision", inputFile.c_str(), header->sampleSize * 8 );
+        munmap( mapping, size );
+        return nullptr;
+    }
+
+    isValid = isValid && ( size - sizeof( bankHeader )) / sizeof( bankEntry ) >= header->amountOfSamples;
+
+    const bankEntry* entries = ( const bankEntry* ) ( data + sizeof( bankHeader ));
+
+    for ( uint32_t i = 0; isValid && i < header->amountOfSamples; ++i ) {
+        const bankEntry& entry = entries[ i ];
+        isValid = entry.nameOffset <= size && entry.nameLength <= size - entry.nameOffset &&
+                  entry.dataOffset % DATA_ALIGNMENT == 0 && entry.dataOffset <= size &&
+                  getChannelSize( entry.length ) * entry.amountOfChannels <= size - entry.dataOffset;
+    }
+
+    if ( !isValid ) {
+        Debug::log( "SampleBank::Error '%s' is not a valid sample bank", inputFile.c_str() );
+        munmap( mapping, size );
+        return nullptr;
+    }
+    return new SampleBank( data, size );
+}
+
+int SampleBank::getAmountOfSamples()
+{
+    return _amountOfSamples;
+}
+
+std::string SampleBank::getIdentifier( int index )
+{
+    if ( index < 0 || index >= _amountOfSamples ) {
+        return "";
+    }
+    return std::string( _data + _entries[ index ].nameOffset, _entries[ index ].nameLength );
+}
+
+unsigned int SampleBank::getSampleRate( int index )
+{
+    if ( index < 0 || index >= _amountOfSamples ) {
+        return 0;
+    }
+    return _entries[ index ].sampleRate;
+}
+
+AudioBuffer* SampleBank::createBuffer( int index )
+{
+    if ( index < 0 || index >= _amountOfSamples ) {
+        return nullptr;
+    }
+    const bankEntry& entry = _entries[ index ];
+    std::vector<SAMPLE_TYPE*> channels( entry.amountOfChannels );
+
+    for ( uint32_t c = 0; c < entry.amountOfChannels; ++c ) {
+        channels[ c ] = ( SAMPLE_TYPE* ) ( _data + entry.dataOffset + getChannelSize( entry.length ) * c );
+    }
+    return new AudioBuffer(( int ) entry.amountOfChannels, ( int ) entry.length, channels.data() );
+}
+
+/* private methods */
+
+size_t SampleBank::getChannelSize( uint32_t length )
+{
+    return align( length * sizeof( SAMPLE_TYPE ));
+}
+
+size_t SampleBank::align( size_t offset )
+{
+    return ( offset + DATA_ALIGNMENT - 1 ) & ~( DATA_ALIGNMENT - 1 );
+}
+
+} // E.O namespace MWEngine
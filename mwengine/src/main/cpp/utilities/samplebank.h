@@ -0,0 +1,118 @@
+/**
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2026 Igor Zinken - https://www.igorski.nl
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#ifndef __MWENGINE__SAMPLEBANK_H_INCLUDED__
+#define __MWENGINE__SAMPLEBANK_H_INCLUDED__
+
+#include "../audiobuffer.h"
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace MWEngine {
+
+// describes a sample to be written into a SampleBank
+
+typedef struct
+{
+    std::string identifier;
+    AudioBuffer* buffer;
+    unsigned int sampleRate;
+} bankSample;
+
+/**
+ * A SampleBank is a single file packing multiple samples as planar sample data at the
+ * sample type of the engine (see PRECISION in global.h), preceded by an index of the
+ * samples identifiers, lengths and sample rates.
+ *
+ * As the data requires no parsing nor conversion, the bank is memory mapped when opened
+ * and its samples are provided as AudioBuffers directly referencing the mapped memory.
+ * Opening a bank takes the same time regardless of its size, the operating system
+ * pages the sample data in (and out) on demand.
+ *
+ * The mapping is private: writing into a samples AudioBuffer does not alter the file.
+ * All AudioBuffers created by a SampleBank must be deleted before the bank is deleted.
+ *
+ * See SampleManager::loadBank() and SampleManager::writeBank()
+ */
+class SampleBank
+{
+    public:
+
+        ~SampleBank(); // unmaps the file
+
+        // packs given samples into a bank at given file path, returns false on failure
+
+        static bool write( std::string outputFile, const std::vector<bankSample>& samples );
+
+        // maps the bank at given file path into memory, returns a null pointer when the
+        // file doesn't exist / is not a valid bank / was written at another sample precision
+
+        static SampleBank* open( std::string inputFile );
+
+        int getAmountOfSamples();
+        std::string getIdentifier( int index );
+        unsigned int getSampleRate( int index );
+
+        // creates an AudioBuffer for the sample at given index, referencing the mapped memory (no copy is made)
+
+        AudioBuffer* createBuffer( int index );
+
+        static const int VERSION = 1;
+
+    private:
+
+        SampleBank( char* data, size_t size );
+
+        // layout of the file (little endian), the header is followed by the index entries, the identifiers and
+        // the sample data, where the data of each channel starts at an offset aligned to DATA_ALIGNMENT bytes
+
+        typedef struct {
+            char id[ 4 ];         // "MWSB"
+            uint32_t version;
+            uint32_t sampleSize;  // size of a single sample in bytes (sizeof( SAMPLE_TYPE ) of the engine that wrote the bank)
+            uint32_t amountOfSamples;
+        } bankHeader;
+
+        typedef struct {
+            uint64_t dataOffset;  // offset (in bytes) of the first channel data
+            uint64_t nameOffset;  // offset (in bytes) of the identifier
+            uint32_t nameLength;
+            uint32_t amountOfChannels;
+            uint32_t length;      // in samples (per channel)
+            uint32_t sampleRate;
+        } bankEntry;
+
+        static const size_t DATA_ALIGNMENT = 64;
+
+        static size_t getChannelSize( uint32_t length );
+        static size_t align( size_t offset );
+
+        char*  _data;
+        size_t _size;
+        const bankEntry* _entries;
+        int _amountOfSamples;
+};
+} // E.O namespace MWEngine
+
+#endif
@@ -21,36 +21,406 @@
  * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
  */
 #include "samplemanager.h"
+#include "debug.h"
+#include "resampler.h"
+#include "wavereader.h"
+#include <mutex>
+#include <thread>
 
 namespace MWEngine {
 namespace SampleManagerSamples
 {
     std::map<std::string, cachedSample> _sampleMap;
+    std::vector<SampleBank*> _banks;
+    std::map<const void*, std::string> _bufferMap;
+    std::map<const void*, cachedSample> _releasedBuffers;
+    size_t _memoryBudget = 0;
+    uint64_t _useCounter = 0;
+}
+
+/* internal methods */
+
+namespace {
+
+    // the AudioBuffer or CompactBuffer holding the samples data (null when evicted)
+
+    const void* getSampleData( const cachedSample& sample )
+    {
+        if ( sample.compactBuffer != nullptr )
+            return sample.compactBuffer;
+
+        return sample.sampleBuffer;
+    }
+
+    size_t getSampleMemory( const cachedSample& sample )
+    {
+        if ( sample.compactBuffer != nullptr )
+            return sample.compactBuffer->getMemoryUsage();
+
+        AudioBuffer* buffer = sample.sampleBuffer;
+        return ( buffer != nullptr ) ? ( size_t ) buffer->amountOfChannels * buffer->bufferSize * sizeof( SAMPLE_TYPE ) : 0;
+    }
+
+    // frees the data of given sample, or when it is still referenced, defers its release until it is no longer referenced
+
+    void freeSample( cachedSample& sample )
+    {
+        const void* data = getSampleData( sample );
+
+        if ( data == nullptr )
+            return;
+
+        SampleManagerSamples::_bufferMap.erase( data );
+
+        if ( sample.references > 0 ) {
+            SampleManagerSamples::_releasedBuffers[ data ] = sample;
+        }
+        else {
+            delete sample.sampleBuffer;
+            delete sample.compactBuffer;
+        }
+        sample.sampleBuffer  = nullptr;
+        sample.compactBuffer = nullptr;
+    }
+
+    // reads the file the sample was loaded from, converting its contents to the samples target sample rate (when set)
+
+    AudioBuffer* readSampleFile( const cachedSample& sample )
+    {
+        waveFile WAV = WaveReader::fileToBuffer( sample.source );
+
+        if ( WAV.buffer == nullptr || sample.targetSampleRate == 0 || WAV.sampleRate == sample.targetSampleRate )
+            return WAV.buffer;
+
+        AudioBuffer* buffer = Resampler::resample( WAV.buffer, WAV.sampleRate, sample.targetSampleRate );
+        delete WAV.buffer;
+
+        return buffer;
+    }
+
+    // stores the samples AudioBuffer in the storage type of the sample
+
+    void compactSampleBuffer( cachedSample& sample )
+    {
+        if ( sample.storageType < 0 || sample.sampleBuffer == nullptr )
+            return;
+
+        sample.compactBuffer = new CompactBuffer( sample.sampleBuffer, sample.storageType );
+        delete sample.sampleBuffer;
+        sample.sampleBuffer = nullptr;
+    }
+
+    // evicts the least recently used samples until the memory use is within the budget
+    // (when given, the sample registered under keepIdentifier is not evicted)
+
+    void applyMemoryBudget( const std::string& keepIdentifier )
+    {
+        if ( SampleManagerSamples::_memoryBudget == 0 )
+            return;
+
+        size_t memoryUsage = SampleManager::getMemoryUsage();
+
+        while ( memoryUsage > SampleManagerSamples::_memoryBudget )
+        {
+            cachedSample* leastRecentlyUsed = nullptr;
+
+            for ( auto& it : SampleManagerSamples::_sampleMap )
+            {
+                cachedSample& sample = it.second;
+
+                // only samples that can be read from their file again are eligible for eviction
+
+                if ( getSampleData( sample ) == nullptr || sample.references > 0 || sample.source.empty() || it.first == keepIdentifier )
+                    continue;
+
+                if ( leastRecentlyUsed == nullptr || sample.lastUsed < leastRecentlyUsed->lastUsed )
+                    leastRecentlyUsed = &sample;
+            }
+
+            if ( leastRecentlyUsed == nullptr ) {
+                Debug::log( "SampleManager::Warning memory use of %d bytes exceeds budget, no samples can be evicted", memoryUsage );
+                break;
+            }
+            memoryUsage -= getSampleMemory( *leastRecentlyUsed );
+            freeSample( *leastRecentlyUsed );
+        }
+    }
+
+    // sample rate conversions (see SampleManager::setSample()) are performed by a background thread, the
+    // converted buffers replace the buffers of the samples in applySampleRateConversions(), which is invoked
+    // by the public methods (as the maps of the SampleManager are only accessed outside of the background thread)
+
+    typedef struct
+    {
+        std::string identifier;
+        AudioBuffer* source;           // retained (see SampleManager::retainBuffer()) until the conversion is applied
+        unsigned int sourceSampleRate;
+        unsigned int targetSampleRate;
+        AudioBuffer* result;           // null until converted
+        bool started;
+        bool cancelled;                // whether the sample has been removed while converting
+    } sampleRateConversion;
+
+    std::vector<sampleRateConversion*> _conversions; // pending and completed (not yet applied) conversions
+    std::mutex _conversionMutex;
+    std::thread* _conversionThread = nullptr; // only accessed outside of the conversion thread
+    bool _converting = false; // whether the conversion thread is running (it stops once all conversions are done)
+
+    void handleConversions()
+    {
+        while ( true )
+        {
+            sampleRateConversion* conversion = nullptr;
+            {
+                std::lock_guard<std::mutex> guard( _conversionMutex );
+
+                for ( auto pending : _conversions ) {
+                    if ( !pending->started ) {
+                        conversion = pending;
+                        conversion->started = true;
+                        break;
+                    }
+                }
+
+                if ( conversion == nullptr ) {
+                    _converting = false;
+                    return;
+                }
+            }
+
+            AudioBuffer* result = Resampler::resample( conversion->source, conversion->sourceSampleRate, conversion->targetSampleRate );
+            std::lock_guard<std::mutex> guard( _conversionMutex );
+            conversion->result = result;
+        }
+    }
+
+    void queueSampleRateConversion( const std::string& aIdentifier, AudioBuffer* source, unsigned int sampleRate )
+    {
+        // the source may not be freed nor evicted while converting
+
+        SampleManager::retainBuffer( source );
+
+        sampleRateConversion* conversion = new sampleRateConversion({
+            aIdentifier, source, sampleRate, AudioEngineProps::SAMPLE_RATE, nullptr, false, false
+        });
+
+        std::thread* finishedThread = nullptr;
+        bool startThread = false;
+        {
+            std::lock_guard<std::mutex> guard( _conversionMutex );
+
+            _conversions.push_back( conversion );
+
+            if ( !_converting ) {
+                finishedThread    = _conversionThread;
+                _conversionThread = nullptr;
+                _converting       = startThread = true;
+            }
+        }
+
+        if ( finishedThread != nullptr ) {
+            finishedThread->join();
+            delete finishedThread;
+        }
+
+        if ( startThread )
+            _conversionThread = new std::thread( handleConversions );
+    }
+
+    void cancelSampleRateConversions( const std::string& aIdentifier )
+    {
+        std::lock_guard<std::mutex> guard( _conversionMutex );
+
+        for ( auto conversion : _conversions ) {
+            if ( conversion->identifier == aIdentifier )
+                conversion->cancelled = true;
+        }
+    }
+
+    void applySampleRateConversions()
+    {
+        std::vector<sampleRateConversion*> completed;
+        {
+            std::lock_guard<std::mutex> guard( _conversionMutex );
+
+            if ( _conversions.empty() )
+                return;
+
+            for ( auto it = _conversions.begin(); it != _conversions.end(); ) {
+                if (( *it )->result != nullptr ) {
+                    completed.push_back( *it );
+                    it = _conversions.erase( it );
+                }
+                else {
+                    ++it;
+                }
+            }
+        }
+
+        for ( auto conversion : completed )
+        {
+            auto it = SampleManagerSamples::_sampleMap.find( conversion->identifier );
+            AudioBuffer* result = conversion->result;
+            int resultLength    = result->bufferSize;
+
+            if ( !conversion->cancelled && it != SampleManagerSamples::_sampleMap.end() )
+            {
+                cachedSample& sample = it->second;
+
+                // SampleEvents still referencing the source keep it until they release it, when the
+                // sample has been compacted while converting, the converted buffer is compacted as well
+
+                if ( sample.sampleBuffer == conversion->source ) {
+                    freeSample( sample );
+                    sample.sampleBuffer = result;
+                }
+                else if ( sample.compactBuffer != nullptr && sample.sampleRate == conversion->sourceSampleRate ) {
+                    freeSample( sample );
+                    sample.compactBuffer = new CompactBuffer( result, sample.storageType );
+                    delete result;
+                }
+                else {
+                    delete result;
+                    result = nullptr;
+                }
+
+                if ( result != nullptr ) {
+                    sample.sampleLength = resultLength;
+                    sample.sampleRate   = conversion->targetSampleRate;
+                    sample.references   = 0;
+                    SampleManagerSamples::_bufferMap[ getSampleData( sample ) ] = conversion->identifier;
+                }
+            }
+            else {
+                delete result;
+            }
+            SampleManager::releaseBuffer( conversion->source );
+            delete conversion;
+        }
+        applyMemoryBudget( "" );
+    }
+
+    // retrieves the sample registered under given identifier, evicted samples are read from their file again
+
+    cachedSample* getLoadedSample( const std::string& aIdentifier )
+    {
+        applySampleRateConversions();
+
+        std::map<std::string, cachedSample>::iterator it = SampleManagerSamples::_sampleMap.find( aIdentifier );
+
+        if ( it == SampleManagerSamples::_sampleMap.end() )
+            return nullptr;
+
+        cachedSample& sample = it->second;
+        sample.lastUsed = ++SampleManagerSamples::_useCounter;
+
+        if ( getSampleData( sample ) == nullptr && !sample.source.empty() )
+        {
+            sample.sampleBuffer = readSampleFile( sample );
+
+            if ( sample.sampleBuffer == nullptr ) {
+                Debug::log( "SampleManager::Error could not reload sample '%s' from '%s'", aIdentifier.c_str(), sample.source.c_str() );
+                return nullptr;
+            }
+            compactSampleBuffer( sample );
+
+            SampleManagerSamples::_bufferMap[ getSampleData( sample ) ] = aIdentifier;
+            applyMemoryBudget( aIdentifier );
+        }
+        return &sample;
+    }
 }
 
 /* public methods */
 
 void SampleManager::setSample( std::string aIdentifier, AudioBuffer* aBuffer, unsigned int sampleRate )
 {
-    cachedSample sample = { aBuffer->bufferSize, sampleRate, aBuffer };
+    setSample( aIdentifier, aBuffer, sampleRate, false );
+}
+
+void SampleManager::setSample( std::string aIdentifier, AudioBuffer* aBuffer, unsigned int sampleRate, bool convertSampleRate )
+{
+    unsigned int targetSampleRate = convertSampleRate ? AudioEngineProps::SAMPLE_RATE : 0;
+    cachedSample sample = { aBuffer->bufferSize, sampleRate, aBuffer, nullptr, -1, "", 0, ++SampleManagerSamples::_useCounter, targetSampleRate };
 
     // Assignment using member function insert() and STL pair
-    SampleManagerSamples::_sampleMap.insert( std::pair<std::string, cachedSample>( aIdentifier, sample ));
+    if ( SampleManagerSamples::_sampleMap.insert( std::pair<std::string, cachedSample>( aIdentifier, sample )).second ) {
+        SampleManagerSamples::_bufferMap[ aBuffer ] = aIdentifier;
+
+        if ( convertSampleRate && sampleRate != targetSampleRate )
+            queueSampleRateConversion( aIdentifier, aBuffer, sampleRate );
+
+        applyMemoryBudget( aIdentifier );
+    }
 }
 
-AudioBuffer* SampleManager::getSample( std::string aIdentifier )
+bool SampleManager::loadSample( std::string aIdentifier, std::string aWAVFilePath )
+{
+    return loadSample( aIdentifier, aWAVFilePath, false );
+}
+
+bool SampleManager::loadSample( std::string aIdentifier, std::string aWAVFilePath, bool convertSampleRate )
+{
+    if ( hasSample( aIdentifier ))
+        return false;
+
+    waveFile WAV = WaveReader::fileToBuffer( aWAVFilePath );
+
+    if ( WAV.buffer == nullptr )
+        return false;
+
+    setSample( aIdentifier, WAV.buffer, WAV.sampleRate, convertSampleRate );
+    SampleManagerSamples::_sampleMap.find( aIdentifier )->second.source = aWAVFilePath;
+
+    return true;
+}
+
+bool SampleManager::compactSample( std::string aIdentifier, int storageType )
 {
     if ( !hasSample( aIdentifier ))
-        return nullptr;
+        return false;
 
-    std::map<std::string, cachedSample>::iterator it = SampleManagerSamples::_sampleMap.find( aIdentifier );
+    cachedSample& sample = SampleManagerSamples::_sampleMap.find( aIdentifier )->second;
 
-    // key stored in first, value stored in second
-    return it->second.sampleBuffer;
+    if ( sample.storageType >= 0 )
+        return sample.storageType == storageType;
+
+    // SampleEvents still referencing the AudioBuffer keep it until they release it
+
+    if ( sample.sampleBuffer != nullptr )
+    {
+        AudioBuffer* buffer = sample.sampleBuffer;
+        CompactBuffer* compactBuffer = new CompactBuffer( buffer, storageType );
+
+        freeSample( sample );
+
+        sample.compactBuffer = compactBuffer;
+        SampleManagerSamples::_bufferMap[ compactBuffer ] = aIdentifier;
+    }
+    sample.storageType = storageType;
+    sample.references  = 0;
+
+    return true;
+}
+
+AudioBuffer* SampleManager::getSample( std::string aIdentifier )
+{
+    cachedSample* sample = getLoadedSample( aIdentifier );
+
+    return ( sample != nullptr ) ? sample->sampleBuffer : nullptr;
+}
+
+CompactBuffer* SampleManager::getCompactSample( std::string aIdentifier )
+{
+    cachedSample* sample = getLoadedSample( aIdentifier );
+
+    return ( sample != nullptr ) ? sample->compactBuffer : nullptr;
 }
 
 int SampleManager::getSampleLength( std::string aIdentifier )
 {
+    applySampleRateConversions();
+
     if ( !hasSample( aIdentifier ))
         return 0;
 
@@ -62,6 +432,8 @@ int SampleManager::getSampleLength( std::string aIdentifier )
 
 int SampleManager::getSampleRateForSample( std::string aIdentifier )
 {
+    applySampleRateConversions();
+
     if ( !hasSample( aIdentifier ))
         return AudioEngineProps::SAMPLE_RATE;
 
@@ -83,25 +455,216 @@ void SampleManager::removeSample( std::string aIdentifier, bool free )
     {
         std::map<std::string, cachedSample>::iterator it = SampleManagerSamples::_sampleMap.find( aIdentifier );
 
+        cancelSampleRateConversions( aIdentifier );
+
+        // when the sample is still referenced, its memory is freed once it is no longer referenced
+
         if ( free )
-            delete it->second.sampleBuffer;
+            freeSample( it->second );
+        else
+            SampleManagerSamples::_bufferMap.erase( getSampleData( it->second ));
 
-        SampleManagerSamples::_sampleMap.erase( SampleManagerSamples::_sampleMap.find( aIdentifier ));
+        SampleManagerSamples::_sampleMap.erase( it );
     }
 }
 
 void SampleManager::flushSamples()
 {
-    // invoke destructors on all AudioBuffers
+    // invoke destructors on all AudioBuffers (unless still referenced)
 
     std::map<std::string, cachedSample>::iterator it;
 
     for ( it  = SampleManagerSamples::_sampleMap.begin();
           it != SampleManagerSamples::_sampleMap.end(); ++it )
     {
-        delete it->second.sampleBuffer;
+        cancelSampleRateConversions( it->first );
+        freeSample( it->second );
     }
     SampleManagerSamples::_sampleMap.clear();
+    SampleManagerSamples::_bufferMap.clear();
+
+    // the AudioBuffers of banks reference the mapped memory, unmap once these have been deleted
+
+    while ( !SampleManagerSamples::_banks.empty()) {
+        delete SampleManagerSamples::_banks.back();
+        SampleManagerSamples::_banks.pop_back();
+    }
+}
+
+void SampleManager::setMemoryBudget( size_t bytes )
+{
+    SampleManagerSamples::_memoryBudget = bytes;
+    applyMemoryBudget( "" );
+}
+
+size_t SampleManager::getMemoryBudget()
+{
+    return SampleManagerSamples::_memoryBudget;
+}
+
+size_t SampleManager::getMemoryUsage()
+{
+    size_t memoryUsage = 0;
+
+    for ( auto& it : SampleManagerSamples::_sampleMap ) {
+        memoryUsage += getSampleMemory( it.second );
+    }
+    for ( auto& it : SampleManagerSamples::_releasedBuffers ) {
+        memoryUsage += getSampleMemory( it.second );
+    }
+    return memoryUsage;
+}
+
+size_t SampleManager::getMemoryUsage( std::string aIdentifier )
+{
+    if ( !hasSample( aIdentifier ))
+        return 0;
+
+    return getSampleMemory( SampleManagerSamples::_sampleMap.find( aIdentifier )->second );
+}
+
+bool SampleManager::isSampleLoaded( std::string aIdentifier )
+{
+    return hasSample( aIdentifier ) && getSampleData( SampleManagerSamples::_sampleMap.find( aIdentifier )->second ) != nullptr;
+}
+
+int SampleManager::getReferenceCount( std::string aIdentifier )
+{
+    if ( !hasSample( aIdentifier ))
+        return 0;
+
+    return SampleManagerSamples::_sampleMap.find( aIdentifier )->second.references;
+}
+
+bool SampleManager::isConvertingSampleRate( std::string aIdentifier )
+{
+    applySampleRateConversions();
+
+    std::lock_guard<std::mutex> guard( _conversionMutex );
+
+    for ( auto conversion : _conversions ) {
+        if ( conversion->identifier == aIdentifier && !conversion->cancelled )
+            return true;
+    }
+    return false;
+}
+
+void SampleManager::awaitSampleRateConversions()
+{
+    // the conversion thread stops once all conversions are done
+
+    if ( _conversionThread != nullptr ) {
+        _conversionThread->join();
+        delete _conversionThread;
+        _conversionThread = nullptr;
+    }
+    applySampleRateConversions();
+}
+
+void SampleManager::logMemoryUsage()
+{
+    for ( auto& it : SampleManagerSamples::_sampleMap ) {
+        Debug::log( "SampleManager::sample '%s' uses %d bytes (%d references%s)",
+            it.first.c_str(), getSampleMemory( it.second ), it.second.references,
+            getSampleData( it.second ) == nullptr ? ", evicted" : ""
+        );
+    }
+    Debug::log( "SampleManager::total memory use %d bytes (budget %d bytes)", getMemoryUsage(), SampleManagerSamples::_memoryBudget );
+}
+
+void SampleManager::retainBuffer( const void* aBuffer )
+{
+    auto it = SampleManagerSamples::_bufferMap.find( aBuffer );
+
+    if ( it != SampleManagerSamples::_bufferMap.end() ) {
+        cachedSample& sample = SampleManagerSamples::_sampleMap.find( it->second )->second;
+        ++sample.references;
+        sample.lastUsed = ++SampleManagerSamples::_useCounter;
+        return;
+    }
+
+    auto released = SampleManagerSamples::_releasedBuffers.find( aBuffer );
+
+    if ( released != SampleManagerSamples::_releasedBuffers.end() )
+        ++released->second.references;
+}
+
+void SampleManager::releaseBuffer( const void* aBuffer )
+{
+    auto it = SampleManagerSamples::_bufferMap.find( aBuffer );
+
+    if ( it != SampleManagerSamples::_bufferMap.end() ) {
+        cachedSample& sample = SampleManagerSamples::_sampleMap.find( it->second )->second;
+
+        if ( sample.references > 0 && --sample.references == 0 )
+            applyMemoryBudget( "" );
+
+        return;
+    }
+
+    // removed sample awaiting release
+
+    auto released = SampleManagerSamples::_releasedBuffers.find( aBuffer );
+
+    if ( released != SampleManagerSamples::_releasedBuffers.end() && --released->second.references <= 0 ) {
+        delete released->second.sampleBuffer;
+        delete released->second.compactBuffer;
+        SampleManagerSamples::_releasedBuffers.erase( released );
+    }
+}
+
+bool SampleManager::loadBank( std::string inputFile )
+{
+    SampleBank* bank = SampleBank::open( inputFile );
+
+    if ( bank == nullptr )
+        return false;
+
+    for ( int i = 0; i < bank->getAmountOfSamples(); ++i )
+    {
+        std::string identifier = bank->getIdentifier( i );
+
+        if ( !hasSample( identifier ))
+            setSample( identifier, bank->createBuffer( i ), bank->getSampleRate( i ));
+    }
+    SampleManagerSamples::_banks.push_back( bank );
+
+    return true;
+}
+
+bool SampleManager::writeBank( std::string outputFile )
+{
+    std::vector<bankSample> samples;
+    std::vector<AudioBuffer*> temporaryBuffers;
+
+    std::map<std::string, cachedSample>::iterator it;
+
+    for ( it  = SampleManagerSamples::_sampleMap.begin();
+          it != SampleManagerSamples::_sampleMap.end(); ++it )
+    {
+        AudioBuffer* buffer = it->second.sampleBuffer;
+
+        // compacted samples are temporarily decoded and evicted samples are temporarily
+        // read from their file (without affecting the memory budget)
+
+        if ( it->second.compactBuffer != nullptr ) {
+            buffer = it->second.compactBuffer->toAudioBuffer();
+            temporaryBuffers.push_back( buffer );
+        }
+        else if ( buffer == nullptr && !it->second.source.empty() ) {
+            buffer = readSampleFile( it->second );
+            temporaryBuffers.push_back( buffer );
+        }
+
+        if ( buffer != nullptr )
+            samples.push_back({ it->first, buffer, it->second.sampleRate });
+    }
+    bool success = SampleBank::write( outputFile, samples );
+
+    for ( auto buffer : temporaryBuffers ) {
+        delete buffer;
+    }
+    return success;
 }
 
 } // E.O namespace MWEngine
@@ -24,9 +24,14 @@
 #define __MWENGINE__SAMPLEMANAGER_H_INCLUDED__
 
 #include "audiobuffer.h"
+#include "samplebank.h"
+#include "compactbuffer.h"
+#include <cstddef>
+#include <cstdint>
 #include <string>
 #include <map>
 #include <utility>
+#include <vector>
 
 namespace MWEngine {
 
@@ -34,7 +39,13 @@ typedef struct
 {
    int sampleLength;
    unsigned int sampleRate;
-   AudioBuffer* sampleBuffer;
+   AudioBuffer* sampleBuffer; // null when the sample has been evicted (see setMemoryBudget()) or compacted
+   CompactBuffer* compactBuffer; // null unless the sample has been compacted (see compactSample())
+   int storageType;           // CompactBuffer::types value of a compacted sample, -1 when stored as SAMPLE_TYPE
+   std::string source;        // path of the file the sample was loaded from, empty when registered from memory
+   int references;            // the amount of SampleEvents referencing the sample
+   uint64_t lastUsed;         // when the sample was last retrieved / referenced (used for eviction order)
+   unsigned int targetSampleRate; // sample rate the sample is converted to (see setSample()), 0 to keep its sample rate
 } cachedSample;
 
 /**
@@ -42,6 +53,19 @@ typedef struct
  * used to pool samples (AudioBuffers) that are to be used repeatedly or simultaneously, etc...
  * SampleManager will also manage the memory, when samples can be removed you can do
  * so via SampleManager which will in turn release the memory allocated by the AudioBuffers
+ *
+ * SampleManager keeps track of the amount of SampleEvents referencing each sample. The memory
+ * of a sample that is removed while it is still referenced is released once it is no longer referenced.
+ * When a memory budget is set, samples that were loaded from a file (see loadSample()) and are no longer
+ * referenced are evicted in least recently used order to keep the memory use within the budget. Evicted
+ * samples are read from their file again when they are retrieved using getSample().
+ *
+ * Samples can be kept in a compact storage type (see compactSample() and CompactBuffer) to reduce
+ * their memory use, compacted samples are retrieved using getCompactSample() instead of getSample().
+ *
+ * Samples recorded at a different sample rate than the engine's can be converted to the engine's sample rate
+ * (see setSample() and loadSample()), so SampleEvents can play them without resampling them during playback.
+ * The conversion runs on a background thread, until it completes the sample is retrieved at its original sample rate.
  */
 class SampleManager
 {
@@ -50,10 +74,37 @@ class SampleManager
         // store given AudioBuffer under given identifier name in this SampleManager
         static void setSample( std::string aIdentifier, AudioBuffer* aBuffer, unsigned int sampleRate );
 
+        // store given AudioBuffer and when convertSampleRate is true and given sample rate differs from the
+        // engine's sample rate, convert it to the engine's sample rate on a background thread. Once converted, the
+        // converted AudioBuffer replaces given AudioBuffer (which is deleted once no longer referenced by SampleEvents)
+        static void setSample( std::string aIdentifier, AudioBuffer* aBuffer, unsigned int sampleRate, bool convertSampleRate );
+
+        // read the WAV file at given path and store its contents under given identifier name in
+        // this SampleManager (allowing the sample to be evicted), returns false when the file could not be read
+        static bool loadSample( std::string aIdentifier, std::string aWAVFilePath );
+        static bool loadSample( std::string aIdentifier, std::string aWAVFilePath, bool convertSampleRate );
+
+        // whether the sample registered under given identifier is being converted to the engine's sample rate
+        static bool isConvertingSampleRate( std::string aIdentifier );
+
+        // blocks until all pending sample rate conversions have completed
+        static void awaitSampleRateConversions();
+
         // retrieve AudioBuffer registered under given identifier from this SampleManager
-        // returns 0 if no associated AudioBuffer is found
+        // returns 0 if no associated AudioBuffer is found. If the sample has been evicted, it is
+        // read from its file (note: as this accesses the file system, never invoke this on the render thread)
         static AudioBuffer* getSample( std::string aIdentifier );
 
+        // converts the sample registered under given identifier to given storage type (see CompactBuffer::types)
+        // the samples AudioBuffer is deleted (unless still referenced by SampleEvents, in which case this happens
+        // once they no longer reference it). Returns false if no sample is registered under given identifier
+        // or when the sample has already been compacted to another storage type
+        static bool compactSample( std::string aIdentifier, int storageType );
+
+        // retrieve the CompactBuffer of the compacted sample registered under given identifier, returns 0
+        // if no associated sample is found or when the sample is not compacted (see getSample())
+        static CompactBuffer* getCompactSample( std::string aIdentifier );
+
         // retrieve the length (in samples) of the AudioBuffer registered under given
         // identifier, returns 0 if no associated AudioBuffer is found
         static int getSampleLength( std::string aIdentifier );
@@ -68,11 +119,51 @@ class SampleManager
         // remove the sample from the SampleManager, if free is true, the sample will also be deleted
         static void removeSample( std::string aIdentifier, bool free );
         static void flushSamples();
+
+        // the maximum amount of memory (in bytes) the samples may occupy, 0 for an unlimited budget (default)
+        // note that referenced samples and samples that were not loaded from a file are never evicted
+        static void setMemoryBudget( size_t bytes );
+        static size_t getMemoryBudget();
+
+        // the amount of memory (in bytes) occupied by all samples / the sample registered under given identifier
+        static size_t getMemoryUsage();
+        static size_t getMemoryUsage( std::string aIdentifier );
+
+        // whether the sample registered under given identifier is held in memory (e.g. not evicted)
+        static bool isSampleLoaded( std::string aIdentifier );
+
+        // the amount of SampleEvents referencing the sample registered under given identifier
+        static int getReferenceCount( std::string aIdentifier );
+
+        // logs the memory use of each sample (for debugging purposes)
+        static void logMemoryUsage();
+
+#ifndef SWIG
+        // internal to the engine, invoked by SampleEvents when they start/stop referencing a
+        // buffer, either an AudioBuffer or a CompactBuffer (buffers not registered in the SampleManager are ignored)
+        static void retainBuffer( const void* aBuffer );
+        static void releaseBuffer( const void* aBuffer );
+#endif
+
+        // registers all samples inside the SampleBank at given file path (samples for which an identifier
+        // is already registered are skipped). The samples reference the memory mapped bank (see SampleBank)
+        // which remains mapped until flushSamples() is invoked. Returns false when the bank could not be opened
+
+        static bool loadBank( std::string inputFile );
+
+        // packs all registered samples into a SampleBank at given file path, returns false on failure
+
+        static bool writeBank( std::string outputFile );
 };
 
 namespace SampleManagerSamples
 {
     extern std::map<std::string, cachedSample> _sampleMap;
+    extern std::vector<SampleBank*> _banks;
+    extern std::map<const void*, std::string> _bufferMap;        // identifiers of the registered buffers
+    extern std::map<const void*, cachedSample> _releasedBuffers; // removed samples (and their reference count) awaiting release
+    extern size_t _memoryBudget;
+    extern uint64_t _useCounter;
 }
 
 } // E.O namespace MWEngine
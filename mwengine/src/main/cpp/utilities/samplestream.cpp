@@ -0,0 +1,506 @@
+/**
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2026 Igor Zinken - https://www.igorski.nl
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#include "samplestream.h"
+#include "debug.h"
+#include <algorithm>
+#include <cerrno>
+
+namespace MWEngine {
+
+std::vector<SampleStream*> SampleStream::_streams;
+std::mutex SampleStream::_streamsMutex;
+std::thread* SampleStream::_prefetchThread   = nullptr;
+std::atomic<bool>* SampleStream::_prefetching = nullptr;
+std::atomic<bool> SampleStream::_prefetchRequested( false );
+sem_t SampleStream::_prefetchSignal;
+bool SampleStream::_prefetchSignalCreated = false;
+
+/* constructor / destructor */
+
+SampleStream::SampleStream( FILE* file, waveFormat format )
+{
+    _file   = file;
+    _format = format;
+    _length = ( int ) ( format.dataSize / (( format.bitsPerSample / 8 ) * format.amountOfChannels ));
+
+    _head.buffer = new AudioBuffer( format.amountOfChannels, BLOCK_SIZE * HEAD_BLOCKS );
+    _head.startFrame.store( -1 );
+    _head.amountOfFrames.store( 0 );
+
+    for ( auto& block : _blocks ) {
+        block.buffer = new AudioBuffer( format.amountOfChannels, BLOCK_SIZE );
+        block.startFrame.store( -1 );
+        block.amountOfFrames.store( 0 );
+    }
+    _readBuffer.resize(( size_t ) BLOCK_SIZE * HEAD_BLOCKS * ( format.bitsPerSample / 8 ) * format.amountOfChannels );
+
+    _rangeStart.store( 0 );
+    _rangeEnd.store( _length - 1 );
+    _loopeable.store( false );
+    _loopStart.store( 0 );
+    _loopEnd.store( _length - 1 );
+    _playbackOffset.store( 0 );
+    _requestedBlock.store( -1 );
+    _reading.store( 0 );
+
+    resetUnderruns();
+}
+
+SampleStream::~SampleStream()
+{
+    std::thread* thread = nullptr;
+    std::atomic<bool>* prefetching = nullptr;
+
+    {
+        std::lock_guard<std::mutex> guard( _streamsMutex );
+
+        _streams.erase( std::remove( _streams.begin(), _streams.end(), this ), _streams.end() );
+
+        if ( _streams.empty() && _prefetchThread != nullptr ) {
+            thread          = _prefetchThread;
+            prefetching     = _prefetching;
+            _prefetchThread = nullptr;
+            _prefetching    = nullptr;
+            prefetching->store( false );
+            sem_post( &_prefetchSignal );
+        }
+    }
+
+    // the prefetch thread only claims the file of registered streams (see handlePrefetch()),
+    // once the file is released this stream is no longer in use by the prefetch thread
+
+    _fileMutex.lock();
+    _fileMutex.unlock();
+
+    if ( thread != nullptr ) {
+        thread->join();
+        delete thread;
+        delete prefetching;
+    }
+
+    fclose( _file );
+
+    delete _head.buffer;
+    for ( auto& block : _blocks ) {
+        delete block.buffer;
+    }
+}
+
+/* public methods */
+
+SampleStream* SampleStream::open( std::string inputFile )
+{
+    waveFormat format;
+
+    if ( !WaveReader::fileToFormat( inputFile, format )) {
+        return nullptr;
+    }
+
+    FILE* file = fopen( inputFile.c_str(), "rb" );
+
+    if ( file == nullptr ) {
+        return nullptr;
+    }
+
+    SampleStream* stream = new SampleStream( file, format );
+
+    if ( stream->_length <= 0 ) {
+        Debug::log( "SampleStream::Error could not find sample data in '%s'", inputFile.c_str() );
+        delete stream;
+        return nullptr;
+    }
+
+    // read the head synchronously so playback can start instantly
+
+    stream->readBlock( stream->_head, 0 );
+
+    {
+        std::lock_guard<std::mutex> guard( _streamsMutex );
+
+        _streams.push_back( stream );
+
+        if ( !_prefetchSignalCreated ) {
+            sem_init( &_prefetchSignal, 0, 0 );
+            _prefetchSignalCreated = true;
+        }
+
+        if ( _prefetchThread == nullptr ) {
+            _prefetching    = new std::atomic<bool>( true );
+            _prefetchThread = new std::thread( handlePrefetch, _prefetching );
+        }
+    }
+    // read the blocks following the head
+
+    requestPrefetch();
+
+    return stream;
+}
+
+int SampleStream::getLength()
+{
+    return _length;
+}
+
+int SampleStream::getAmountOfChannels()
+{
+    return _format.amountOfChannels;
+}
+
+unsigned int SampleStream::getSampleRate()
+{
+    return _format.sampleRate;
+}
+
+void SampleStream::setRange( int start, int end )
+{
+    start = std::max( 0, std::min( start, _length - 1 ));
+    end   = std::max( start, std::min( end, _length - 1 ));
+
+    _rangeEnd.store( end );
+
+    if ( start != _rangeStart.load() ) {
+        _rangeStart.store( start );
+
+        // read the head of the new range synchronously (the lock prevents simultaneous file access by the prefetch thread)
+
+        std::lock_guard<std::mutex> guard( _fileMutex );
+        readBlock( _head, start );
+    }
+    requestPrefetch();
+}
+
+int SampleStream::getRangeStart()
+{
+    return _rangeStart.load();
+}
+
+int SampleStream::getRangeEnd()
+{
+    return _rangeEnd.load();
+}
+
+void SampleStream::setLoop( bool loopeable, int loopStart, int loopEnd )
+{
+    _loopStart.store( std::max( 0, std::min( loopStart, _length - 1 )));
+    _loopEnd.store( std::max( 0, std::min( loopEnd, _length - 1 )));
+    _loopeable.store( loopeable );
+
+    requestPrefetch();
+}
+
+bool SampleStream::isLoopeable()
+{
+    return _loopeable.load();
+}
+
+int SampleStream::getLoopStart()
+{
+    return _loopStart.load();
+}
+
+int SampleStream::getLoopEnd()
+{
+    return _loopEnd.load();
+}
+
+int SampleStream::getSourceFrame( int playbackOffset )
+{
+    int rangeStart = _rangeStart.load();
+    int rangeEnd   = _rangeEnd.load();
+
+    if ( playbackOffset < 0 ) {
+        return -1;
+    }
+
+    if ( !_loopeable.load() ) {
+        int frame = rangeStart + playbackOffset;
+        return frame <= rangeEnd ? frame : -1;
+    }
+
+    // the range is played up until the loop end, after which the loop region is repeated
+
+    int loopEnd   = std::max( rangeStart, std::min( _loopEnd.load(), rangeEnd ));
+    int loopStart = std::max( rangeStart, std::min( _loopStart.load(), loopEnd ));
+    int firstPass = loopEnd - rangeStart + 1;
+
+    if ( playbackOffset < firstPass ) {
+        return rangeStart + playbackOffset;
+    }
+    return loopStart + ( playbackOffset - firstPass ) % ( loopEnd - loopStart + 1 );
+}
+
+int SampleStream::mixFrames( AudioBuffer* outputBuffer, int writeIndex, int playbackOffset, int amountOfFrames, float volume )
+{
+    int outputChannels = outputBuffer->amountOfChannels;
+    int missingFrames  = 0;
+
+    // announce the read before resolving the blocks (see readBlock())
+
+    _reading.fetch_add( 1 );
+
+    while ( amountOfFrames > 0 )
+    {
+        int frame = getSourceFrame( playbackOffset );
+
+        if ( frame < 0 ) {
+            break; // beyond the playback range
+        }
+
+        // the source frames are contiguous up until the end of the range (or loop)
+
+        int segmentEnd = getSegmentEnd();
+        int run        = std::max( 1, std::min( amountOfFrames, segmentEnd - frame + 1 ));
+
+        int frameOffset, availableFrames;
+        AudioBuffer* source = getBlock( frame, frameOffset, availableFrames );
+
+        if ( source == nullptr ) {
+            run = std::min( run, BLOCK_SIZE - ( frame % BLOCK_SIZE ));
+            missingFrames += run;
+        }
+        else {
+            run = std::min( run, availableFrames );
+
+            // mono sources are mixed into all output channels
+
+            bool mixMono = source->amountOfChannels < outputChannels;
+
+            for ( int c = 0; c < outputChannels; ++c ) {
+                SAMPLE_TYPE* sourceBuffer = source->getBufferForChannel( mixMono ? 0 : c ) + frameOffset;
+                SAMPLE_TYPE* targetBuffer = outputBuffer->getBufferForChannel( c ) + writeIndex;
+
+                for ( int i = 0; i < run; ++i ) {
+                    targetBuffer[ i ] += sourceBuffer[ i ] * volume;
+                }
+            }
+        }
+        playbackOffset += run;
+        writeIndex     += run;
+        amountOfFrames -= run;
+    }
+    _reading.fetch_sub( 1, std::memory_order_release );
+
+    return missingFrames;
+}
+
+void SampleStream::setPlaybackOffset( int playbackOffset )
+{
+    _playbackOffset.store( playbackOffset, std::memory_order_relaxed );
+
+    // the read ahead drops below its low-water mark once playback has moved on to another block (as
+    // the ring now has a block available for the frames that follow), only then is a prefetch requested
+
+    int frame = getSourceFrame( playbackOffset );
+    int block = frame < 0 ? -1 : frame / BLOCK_SIZE;
+
+    if ( _requestedBlock.exchange( block, std::memory_order_relaxed ) != block ) {
+        requestPrefetch();
+    }
+}
+
+void SampleStream::registerUnderrun( int amountOfFrames )
+{
+    _underruns.fetch_add( 1, std::memory_order_relaxed );
+    _underrunFrames.fetch_add( amountOfFrames, std::memory_order_relaxed );
+
+    requestPrefetch();
+}
+
+int SampleStream::getUnderruns()
+{
+    return _underruns.load();
+}
+
+int SampleStream::getUnderrunFrames()
+{
+    return _underrunFrames.load();
+}
+
+void SampleStream::resetUnderruns()
+{
+    _underruns.store( 0 );
+    _underrunFrames.store( 0 );
+}
+
+/* private methods */
+
+int SampleStream::getSegmentEnd()
+{
+    // the last frame of the contiguous source frames (either the end of the range or the loop end within the range)
+
+    int rangeEnd = _rangeEnd.load();
+    return _loopeable.load() ? std::max( _rangeStart.load(), std::min( _loopEnd.load(), rangeEnd )) : rangeEnd;
+}
+
+AudioBuffer* SampleStream::getBlock( int frame, int& frameOffset, int& availableFrames )
+{
+    // the amount of frames is stored before the start frame is published (see readBlock())
+    // and must as such be read after the start frame
+
+    int headStart  = _head.startFrame.load();
+    int headFrames = _head.amountOfFrames.load( std::memory_order_relaxed );
+
+    if ( headStart >= 0 && frame >= headStart && frame < headStart + headFrames ) {
+        frameOffset     = frame - headStart;
+        availableFrames = headFrames - frameOffset;
+        return _head.buffer;
+    }
+
+    int blockStart     = frame - ( frame % BLOCK_SIZE );
+    streamBlock& block = _blocks[ ( frame / BLOCK_SIZE ) % RING_SIZE ];
+
+    int startFrame  = block.startFrame.load();
+    int blockFrames = block.amountOfFrames.load( std::memory_order_relaxed );
+
+    if ( startFrame == blockStart && frame - blockStart < blockFrames ) {
+        frameOffset     = frame - blockStart;
+        availableFrames = blockFrames - frameOffset;
+        return block.buffer;
+    }
+    return nullptr;
+}
+
+void SampleStream::readBlock( streamBlock& block, int startFrame )
+{
+    // invalidate the block while its contents are being replaced and wait for the reads
+    // that might have resolved the block before it was invalidated (see mixFrames())
+
+    block.startFrame.store( -1 );
+
+    while ( _reading.load( std::memory_order_acquire ) > 0 ) {
+        std::this_thread::yield();
+    }
+
+    int frameSize      = ( _format.bitsPerSample / 8 ) * _format.amountOfChannels;
+    int framesToRead   = std::min( block.buffer->bufferSize, _length - startFrame );
+    int framesRead     = 0;
+
+    if ( fseek( _file, ( long ) ( _format.dataOffset + ( size_t ) startFrame * frameSize ), SEEK_SET ) == 0 ) {
+        framesRead = ( int ) fread( _readBuffer.data(), frameSize, framesToRead, _file );
+    }
+    WaveReader::dataToBuffer( _readBuffer.data(), framesRead, _format, block.buffer, 0 );
+
+    block.amountOfFrames.store( framesRead, std::memory_order_relaxed );
+    block.startFrame.store( startFrame, std::memory_order_release );
+}
+
+void SampleStream::prefetch()
+{
+    int playbackOffset = _playbackOffset.load( std::memory_order_relaxed );
+    int headStart      = _head.startFrame.load();
+    int headEnd        = headStart + _head.amountOfFrames.load();
+    int segmentEnd     = getSegmentEnd();
+
+    bool claimed[ RING_SIZE ] = { false };
+
+    // walk through the frames following the playback offset, reading the blocks that are not
+    // present, until all blocks of the ring are claimed (or the end of the range has been reached)
+
+    for ( int i = 0; i < RING_SIZE * 2; ++i )
+    {
+        int frame = getSourceFrame( playbackOffset );
+
+        if ( frame < 0 ) {
+            break;
+        }
+        int end = std::min( frame - ( frame % BLOCK_SIZE ) + BLOCK_SIZE, segmentEnd + 1 );
+
+        if ( headStart >= 0 && frame >= headStart && frame < headEnd ) {
+            end = std::min( headEnd, segmentEnd + 1 ); // frames are held by the head
+        }
+        else {
+            int blockStart = frame - ( frame % BLOCK_SIZE );
+            int index      = ( frame / BLOCK_SIZE ) % RING_SIZE;
+
+            if ( claimed[ index ] ) {
+                break; // ring is full (or a looped region has been fully read)
+            }
+            claimed[ index ] = true;
+
+            if ( _blocks[ index ].startFrame.load() != blockStart ) {
+                readBlock( _blocks[ index ], blockStart );
+            }
+        }
+        playbackOffset += std::max( 1, end - frame );
+    }
+}
+
+void SampleStream::requestPrefetch()
+{
+    // the prefetch thread handles all streams at once, as such the signal is only posted when no request is pending
+    // (posting a semaphore is safe from the render thread as it neither allocates nor locks)
+
+    if ( !_prefetchRequested.exchange( true )) {
+        sem_post( &_prefetchSignal );
+    }
+}
+
+void SampleStream::handlePrefetch( std::atomic<bool>* prefetching )
+{
+    std::vector<SampleStream*> streams;
+
+    while ( true )
+    {
+        // sleep until a prefetch is requested (or the thread is stopped)
+
+        while ( sem_wait( &_prefetchSignal ) != 0 && errno == EINTR ) {}
+
+        if ( !prefetching->load() ) {
+            break;
+        }
+        _prefetchRequested.store( false );
+
+        {
+            std::lock_guard<std::mutex> guard( _streamsMutex );
+            streams = _streams;
+        }
+
+        // the file is read outside of the streams lock. The file of a stream is claimed while the stream
+        // is known to be registered, so a stream that is being destroyed waits for the read to complete
+
+        for ( auto stream : streams )
+        {
+            std::unique_lock<std::mutex> fileLock( stream->_fileMutex, std::defer_lock );
+            {
+                std::lock_guard<std::mutex> guard( _streamsMutex );
+
+                if ( std::find( _streams.begin(), _streams.end(), stream ) == _streams.end() ) {
+                    continue;
+                }
+
+                // a stream whose file is busy is reading the head of a new range, it requests a prefetch once done
+
+                if ( !fileLock.try_lock() ) {
+                    continue;
+                }
+            }
+            stream->prefetch();
+        }
+    }
+
+    // a stopped thread might have consumed a signal meant for a newly started prefetch thread, pass it on
+
+    sem_post( &_prefetchSignal );
+}
+
+} // E.O namespace MWEngine
@@ -0,0 +1,168 @@
+/**
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2026 Igor Zinken - https://www.igorski.nl
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#ifndef __MWENGINE__SAMPLESTREAM_H_INCLUDED__
+#define __MWENGINE__SAMPLESTREAM_H_INCLUDED__
+
+#include "../audiobuffer.h"
+#include "wavereader.h"
+#include <atomic>
+#include <cstdio>
+#include <mutex>
+#include <semaphore.h>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace MWEngine {
+
+/**
+ * A SampleStream provides the contents of a WAV file without reading the file in its entirety.
+ * Only the head of the playback range (so playback can start instantly) and a ring of blocks
+ * following the current playback offset are held in memory. The blocks are read from storage by
+ * a prefetch thread (shared by all SampleStreams) which looks ahead of the playback offset. The
+ * prefetch thread sleeps until a read is requested (e.g. when playback moves on to the next block).
+ *
+ * The playback offset is relative to the start of the playback range, which can optionally loop a
+ * region of the file (all frame values are expressed in sample frames of the file). mixFrames() is safe
+ * to invoke from the render thread as it never accesses the file system: frames that have not been
+ * read yet are reported as missing (see registerUnderrun()).
+ */
+class SampleStream
+{
+    public:
+
+        // opens given WAV file for streaming, returns a null pointer when the file doesn't
+        // exist / is not a valid WAV file. The head of the file is read synchronously
+
+        static SampleStream* open( std::string inputFile );
+        ~SampleStream();
+
+        int getLength();              // in sample frames
+        int getAmountOfChannels();
+        unsigned int getSampleRate();
+
+        // the range of the file to play (frames are inclusive), when loopeable, the range
+        // from the loop start up until the loop end is repeated once it has been reached
+
+        void setRange( int start, int end );
+        int getRangeStart();
+        int getRangeEnd();
+        void setLoop( bool loopeable, int loopStart, int loopEnd );
+        bool isLoopeable();
+        int getLoopStart();
+        int getLoopEnd();
+
+        // translates given playback offset into a frame of the file, returns -1 when the
+        // offset exceeds the playback range (and the range is not looped)
+
+        int getSourceFrame( int playbackOffset );
+
+#ifndef SWIG
+        // internal to the engine (invoked from the render thread)
+
+        // mixes the frames for given amount of playback offsets (starting at playbackOffset) into the
+        // output buffer (starting at writeIndex) at given volume. The frames are resolved in contiguous
+        // runs per block. Returns the amount of frames that were not available (yet)
+
+        int mixFrames( AudioBuffer* outputBuffer, int writeIndex, int playbackOffset, int amountOfFrames, float volume );
+
+        // sets the offset that playback will continue from, the prefetch thread reads the blocks
+        // following this offset (and is woken once playback has moved on to another block)
+
+        void setPlaybackOffset( int playbackOffset );
+
+        // register an underrun spanning given amount of frames (see getUnderruns())
+
+        void registerUnderrun( int amountOfFrames );
+#endif
+
+        // the amount of render cycles in which frames were requested that had not been
+        // read yet and the total amount of frames that were not available in time
+
+        int getUnderruns();
+        int getUnderrunFrames();
+        void resetUnderruns();
+
+        static const int BLOCK_SIZE  = 8192; // size (in frames) of each block read from storage
+        static const int RING_SIZE   = 8;    // the amount of blocks that can be read ahead of the playback offset
+        static const int HEAD_BLOCKS = 2;    // the amount of blocks preloaded at the start of the playback range
+
+    private:
+
+        SampleStream( FILE* file, waveFormat format );
+
+        // a block of frames read from the file, the start frame is updated
+        // by the prefetch thread once the block has been read completely
+
+        typedef struct {
+            AudioBuffer* buffer;
+            std::atomic<int> startFrame; // first frame of the file held by the buffer, -1 when empty
+            std::atomic<int> amountOfFrames;
+        } streamBlock;
+
+        FILE* _file;
+        waveFormat _format;
+        int _length;
+
+        streamBlock _head;
+        streamBlock _blocks[ RING_SIZE ];
+        std::vector<char> _readBuffer;
+        std::mutex _fileMutex; // guards the file and read buffer
+
+        std::atomic<int> _rangeStart;
+        std::atomic<int> _rangeEnd;
+        std::atomic<bool> _loopeable;
+        std::atomic<int> _loopStart;
+        std::atomic<int> _loopEnd;
+        std::atomic<int> _playbackOffset;
+        std::atomic<int> _requestedBlock; // block of the playback offset for which a prefetch was last requested
+
+        std::atomic<int> _underruns;
+        std::atomic<int> _underrunFrames;
+
+        // the amount of render threads currently reading from the blocks, a block is
+        // only overwritten once it has been invalidated and no reads are in progress
+
+        std::atomic<int> _reading;
+
+        int getSegmentEnd();
+        AudioBuffer* getBlock( int frame, int& frameOffset, int& availableFrames );
+        void readBlock( streamBlock& block, int startFrame );
+        void prefetch();
+
+        /* prefetch thread */
+
+        static std::vector<SampleStream*> _streams;
+        static std::mutex _streamsMutex;
+        static std::thread* _prefetchThread;
+        static std::atomic<bool>* _prefetching;
+        static std::atomic<bool> _prefetchRequested;
+        static sem_t _prefetchSignal;
+        static bool _prefetchSignalCreated;
+
+        static void requestPrefetch();
+        static void handlePrefetch( std::atomic<bool>* prefetching );
+};
+} // E.O namespace MWEngine
+
+#endif
@@ -0,0 +1,168 @@
+/**
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2026 Igor Zinken - https://www.igorski.nl
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#ifndef __MWENGINE__SPSCQUEUE_H_INCLUDED__
+#define __MWENGINE__SPSCQUEUE_H_INCLUDED__
+
+#include <atomic>
+#include <cstddef>
+
+namespace MWEngine {
+
+/**
+ * SPSCQueue is a bounded, wait-free queue for a single producer thread and a single
+ * consumer thread (e.g. a control thread enqueueing items for the render thread). All
+ * storage is allocated on construction, neither enqueue() nor dequeue() allocate or lock.
+ *
+ * The capacity is rounded up to the next power of two.
+ */
+template <typename T>
+class SPSCQueue
+{
+    public:
+        explicit SPSCQueue( size_t capacity )
+        {
+            size_t size = 1;
+            while ( size < capacity ) {
+                size <<= 1;
+            }
+            _mask  = size - 1;
+            _items = new T[ size ];
+        }
+
+        ~SPSCQueue()
+        {
+            delete[] _items;
+        }
+
+        SPSCQueue( const SPSCQueue& ) = delete;
+        SPSCQueue& operator=( const SPSCQueue& ) = delete;
+
+        /**
+         * Invoked by the producer. Returns false when the queue is full
+         */
+        inline bool enqueue( const T& item )
+        {
+            size_t write = _write.load( std::memory_order_relaxed );
+
+            if ( write - _read.load( std::memory_order_acquire ) > _mask ) {
+                return false;
+            }
+            _items[ write & _mask ] = item;
+            _write.store( write + 1, std::memory_order_release );
+
+            return true;
+        }
+
+        /**
+         * Invoked by the consumer. Returns false when the queue is empty
+         */
+        inline bool dequeue( T& item )
+        {
+            size_t read = _read.load( std::memory_order_relaxed );
+
+            if ( read == _write.load( std::memory_order_acquire )) {
+                return false;
+            }
+            item = _items[ read & _mask ];
+            _read.store( read + 1, std::memory_order_release );
+
+            return true;
+        }
+
+        /**
+         * Invoked by the producer. Enqueues given amount of items at once (e.g. a block of samples).
+         * Returns false (enqueueing none of the items) when the queue cannot hold all items
+         */
+        inline bool enqueue( const T* items, size_t amount )
+        {
+            size_t write = _write.load( std::memory_order_relaxed );
+
+            if ( amount > ( _mask + 1 ) - ( write - _read.load( std::memory_order_acquire ))) {
+                return false;
+            }
+            for ( size_t i = 0; i < amount; ++i ) {
+                _items[( write + i ) & _mask ] = items[ i ];
+            }
+            _write.store( write + amount, std::memory_order_release );
+
+            return true;
+        }
+
+        /**
+         * Invoked by the consumer. Dequeues up to given maxAmount of items into given
+         * items, returns the amount of items that have been dequeued
+         */
+        inline size_t dequeue( T* items, size_t maxAmount )
+        {
+            size_t read   = _read.load( std::memory_order_relaxed );
+            size_t amount = _write.load( std::memory_order_acquire ) - read;
+
+            if ( amount > maxAmount ) {
+                amount = maxAmount;
+            }
+            for ( size_t i = 0; i < amount; ++i ) {
+                items[ i ] = _items[( read + i ) & _mask ];
+            }
+            _read.store( read + amount, std::memory_order_release );
+
+            return amount;
+        }
+
+        /**
+         * Provides access to the next item without dequeueing it (consumer only),
+         * returns nullptr when the queue is empty
+         */
+        inline T* peek()
+        {
+            size_t read = _read.load( std::memory_order_relaxed );
+            return ( read == _write.load( std::memory_order_acquire )) ? nullptr : &_items[ read & _mask ];
+        }
+
+        inline bool isEmpty()
+        {
+            return _read.load( std::memory_order_acquire ) == _write.load( std::memory_order_acquire );
+        }
+
+        inline size_t getSize()
+        {
+            return _write.load( std::memory_order_acquire ) - _read.load( std::memory_order_acquire );
+        }
+
+        inline size_t getCapacity()
+        {
+            return _mask + 1;
+        }
+
+    private:
+        T* _items;
+        size_t _mask;
+
+        // the read and write indices are written by different threads, keep them on separate cache lines
+
+        alignas( 64 ) std::atomic<size_t> _write { 0 };
+        alignas( 64 ) std::atomic<size_t> _read  { 0 };
+};
+
+} // E.O namespace MWEngine
+
+#endif
@@ -0,0 +1,141 @@
+/**
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2026 Igor Zinken - https://www.igorski.nl
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#include "stemcapture.h"
+#include "bufferutility.h"
+
+namespace MWEngine {
+
+StemCapture::StemCapture()
+{
+    _outputBuffer   = nullptr;
+    _outputChannels = 0;
+}
+
+StemCapture::~StemCapture()
+{
+    releaseBuffers();
+}
+
+void StemCapture::addChannel( AudioChannel* channel, RenderSink* sink )
+{
+    _stems.push_back({ channel, nullptr, sink, nullptr });
+}
+
+void StemCapture::addGroup( ChannelGroup* group, RenderSink* sink )
+{
+    _stems.push_back({ nullptr, group, sink, nullptr });
+}
+
+size_t StemCapture::getStemAmount()
+{
+    return _stems.size();
+}
+
+bool StemCapture::open( int amountOfFrames, int amountOfChannels, int sampleRate )
+{
+    releaseBuffers();
+
+    _outputChannels = amountOfChannels;
+    _outputBuffer   = new float[ AudioEngineProps::BUFFER_SIZE * amountOfChannels ]();
+
+    bool success = true;
+
+    for ( auto& stem : _stems ) {
+        stem.buffer = new ResizableAudioBuffer( amountOfChannels, AudioEngineProps::BUFFER_SIZE );
+
+        if ( !stem.sink->open( amountOfFrames, amountOfChannels, sampleRate )) {
+            success = false;
+        }
+    }
+    return success;
+}
+
+void StemCapture::prepare( int amountOfSamples )
+{
+    for ( auto& stem : _stems ) {
+        stem.buffer->resize( amountOfSamples );
+        stem.buffer->silenceBuffers();
+    }
+}
+
+void StemCapture::captureChannel( AudioChannel* channel, SAMPLE_TYPE mixVolume )
+{
+    // note a channel can be exported more than once (e.g. into different sinks)
+
+    for ( auto& stem : _stems ) {
+        if ( stem.channel == channel ) {
+            channel->mixBuffer( stem.buffer, mixVolume );
+        }
+    }
+}
+
+void StemCapture::captureGroup( ChannelGroup* group )
+{
+    for ( auto& stem : _stems ) {
+        if ( stem.group == group ) {
+            stem.buffer->mergeBuffers( group->getMixBuffer(), 0, 0, group->getVolumeLogarithmic() );
+        }
+    }
+}
+
+bool StemCapture::write( int amountOfSamples )
+{
+    bool success = true;
+
+    for ( auto& stem : _stems ) {
+        BufferUtility::writeBufferInterleaved( stem.buffer, _outputBuffer, amountOfSamples, _outputChannels, MAX_VOLUME );
+
+        if ( !stem.sink->write( _outputBuffer, amountOfSamples )) {
+            success = false;
+        }
+    }
+    return success;
+}
+
+bool StemCapture::close()
+{
+    bool success = true;
+
+    for ( auto& stem : _stems ) {
+        if ( !stem.sink->close()) {
+            success = false;
+        }
+    }
+    releaseBuffers();
+
+    return success;
+}
+
+/* protected methods */
+
+void StemCapture::releaseBuffers()
+{
+    for ( auto& stem : _stems ) {
+        delete stem.buffer;
+        stem.buffer = nullptr;
+    }
+    delete[] _outputBuffer;
+    _outputBuffer = nullptr;
+}
+
+} // E.O namespace MWEngine
@@ -0,0 +1,80 @@
+/**
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2026 Igor Zinken - https://www.igorski.nl
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#ifndef __MWENGINE__STEMCAPTURE_H_INCLUDED__
+#define __MWENGINE__STEMCAPTURE_H_INCLUDED__
+
+#include "rendersink.h"
+#include "../audiochannel.h"
+#include "../channelgroup.h"
+#include "../resizable_audiobuffer.h"
+#include <vector>
+
+/**
+ * StemCapture records the signal of individual AudioChannels and ChannelGroups during
+ * a render cycle (after their ProcessingChain and volume have been applied, but before
+ * the master bus) so each can be written into its own RenderSink. This allows exporting
+ * multiple stems alongside the master mix in a single render (see OfflineRenderer::addStem()).
+ */
+namespace MWEngine {
+class StemCapture
+{
+    public:
+        StemCapture();
+        ~StemCapture();
+
+        void addChannel( AudioChannel* channel, RenderSink* sink );
+        void addGroup( ChannelGroup* group, RenderSink* sink );
+
+        size_t getStemAmount();
+
+        // opens all sinks and allocates the stem buffers, must be invoked prior to rendering
+        bool open( int amountOfFrames, int amountOfChannels, int sampleRate );
+
+        // invoked by the AudioEngine during the render cycle
+
+        void prepare( int amountOfSamples );
+        void captureChannel( AudioChannel* channel, SAMPLE_TYPE mixVolume );
+        void captureGroup( ChannelGroup* group );
+
+        // writes the captured signal of the last render cycle into the sinks
+        bool write( int amountOfSamples );
+
+        // closes all sinks and releases the stem buffers
+        bool close();
+
+    protected:
+        struct Stem {
+            AudioChannel* channel;
+            ChannelGroup* group;
+            RenderSink* sink;
+            ResizableAudioBuffer* buffer;
+        };
+        std::vector<Stem> _stems;
+        float* _outputBuffer;
+        int _outputChannels;
+
+        void releaseBuffers();
+};
+} // E.O namespace MWEngine
+
+#endif
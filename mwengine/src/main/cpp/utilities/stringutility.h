@@ -23,6 +23,7 @@
 #ifndef __MWENGINE_STRING_UTILITY_H_INCLUDED__
 #define __MWENGINE_STRING_UTILITY_H_INCLUDED__
 
+#include <algorithm>
 #include <locale>
 #include <string>
 
@@ -21,6 +21,7 @@
  * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
  */
 #include "tablepool.h"
+#include <generators/wavegenerator.h>
 
 namespace MWEngine {
 
@@ -47,6 +48,11 @@ bool TablePool::setTable( WaveTable* waveTable, std::string tableId )
 
     std::map<std::string, WaveTable*>::iterator it = _cachedTables.find( tableId );
 
+    // generate the mipmaps used for band-limited playback (omitted for tables exceeding WaveGenerator::MAX_MIPMAP_TABLE_LENGTH)
+
+    if ( !waveTable->hasMipmaps() && waveTable->hasContent() )
+        WaveGenerator::generateMipmaps( waveTable );
+
     // insert the generated table into the pools table map
     _cachedTables.insert( std::pair<std::string, WaveTable*>( tableId, waveTable ));
 
@@ -40,6 +40,8 @@ class TablePool
         // if the table was empty and the waveformType exists inside the WaveGenerator,
         // the tables buffer contents are generated on the fly
         // returns boolean success
+        // the band-limited mipmaps of a table with content are generated here (see WaveGenerator::generateMipmaps()),
+        // tables retrieved by instruments are cloned including their mipmaps
 
         static bool setTable( WaveTable* waveTable, std::string tableId );
 
@@ -23,203 +23,415 @@
 #include "wavereader.h"
 #include "../global.h"
 #include "debug.h"
-#include "utils.h"
-#include <stdio.h>
-#include <stdlib.h>
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
 #include <cstring>
+#include <functional>
 
-namespace MWEngine {
+#if defined(__SSE2__)
+#include <immintrin.h>
+#elif defined(__ARM_NEON)
+#include <arm_neon.h>
+#endif
 
-/**
- * structs used to parse WAV file headers
- * see http://soundfile.sapp.org/doc/WaveFormat/
- */
-struct wav_header
-{
-    char fileType[4];           // "RIFF" = 0x46464952
-    UINT32 fileSize;            // in bytes
-    char format[4];             // "WAVE" = 0x45564157
-    char formatName[4];         // "fmt " = 0x20746D66
-    UINT32 formatLength;
-    INT16 audioFormat;          // 1 == PCM, 3 == IEEE float, 6 = A-law, 7 = µ-law
-    INT16 amountOfChannels;
-    UINT32 sampleRate;
-    UINT32 bytesPerSecond;
-    INT16 blockAlign;
-    INT16 bitsPerSample;
-};
-
-struct wav_header_data_chunk
-{
-    char ID[4];         // "data" = 0x61746164
-    UINT32 size;
-};
+namespace MWEngine {
 
 /* internal methods */
 
-template <typename T>
-inline void convert( T, AudioBuffer* buffer, FILE* fp, int sampleSize, SAMPLE_TYPE maxValue )
-{
-    T input;
-    for ( int i = 0; i < buffer->bufferSize; ++i )
+namespace {
+
+    const int WAVE_FORMAT_PCM        = 1;
+    const int WAVE_FORMAT_IEEE_FLOAT = 3;
+    const int WAVE_FORMAT_EXTENSIBLE = 0xFFFE;
+
+    // the amount of samples converted in a single iteration and the amount
+    // of bytes read from a file in a single iteration
+
+    const int    CONVERSION_BLOCK_SIZE = 2048;
+    const size_t READ_BLOCK_SIZE       = 65536;
+
+    // reads given amount of bytes at given offset of the source into given destination
+
+    typedef std::function<bool( size_t offset, void* destination, size_t size )> ByteReader;
+
+    inline uint32_t readUInt32( const unsigned char* bytes )
+    {
+        // note that RIFF files are little endian
+        return bytes[ 0 ] | ( bytes[ 1 ] << 8 ) | ( bytes[ 2 ] << 16 ) | (( uint32_t ) bytes[ 3 ] << 24 );
+    }
+
+    inline int readUInt16( const unsigned char* bytes )
     {
-        for ( int c = 0; c < buffer->amountOfChannels; ++c ) {
-            fread( &input, ( size_t ) sampleSize, 1, fp );
-            buffer->getBufferForChannel( c )[ i ] = (( SAMPLE_TYPE ) input ) / maxValue;
+        return bytes[ 0 ] | ( bytes[ 1 ] << 8 );
+    }
+
+    /**
+     * parses the RIFF chunks of a WAV file (see http://soundfile.sapp.org/doc/WaveFormat/)
+     * for the format description and the location of the sample data
+     */
+    bool parseFormat( const ByteReader& read, size_t fileSize, waveFormat& format )
+    {
+        unsigned char header[ 12 ];
+
+        if ( !read( 0, header, 12 ) || memcmp( header, "RIFF", 4 ) != 0 || memcmp( header + 8, "WAVE", 4 ) != 0 ) {
+            Debug::log( "WaveReader::Error not a valid WAVE file" );
+            return false;
+        }
+
+        bool hasFormat = false;
+        bool hasData   = false;
+        size_t offset  = 12;
+        unsigned char chunk[ 8 ];
+
+        while ( !( hasFormat && hasData ) && offset + 8 <= fileSize && read( offset, chunk, 8 ))
+        {
+            size_t chunkSize   = readUInt32( chunk + 4 );
+            size_t chunkOffset = offset + 8;
+            bool isData        = memcmp( chunk, "data", 4 ) == 0;
+
+            // when the reported chunk size exceeds the file size, this is a clear indication that we're
+            // dealing with a corrupted file header. Attempt to read the remainder of the file as data
+
+            if ( chunkSize > fileSize - chunkOffset && hasFormat && !isData ) {
+                Debug::log( "WaveReader::Warning chunk parsing failure. Assuming header corruption, attempting to read data as-is" );
+                isData = true;
+            }
+
+            if ( memcmp( chunk, "fmt ", 4 ) == 0 )
+            {
+                unsigned char fmt[ 40 ] = { 0 };
+
+                if ( chunkSize < 16 || !read( chunkOffset, fmt, std::min( chunkSize, sizeof( fmt )))) {
+                    break;
+                }
+                format.audioFormat      = readUInt16( fmt );
+                format.amountOfChannels = readUInt16( fmt + 2 );
+                format.sampleRate       = readUInt32( fmt + 4 );
+                format.bitsPerSample    = readUInt16( fmt + 14 );
+
+                // WAVE_FORMAT_EXTENSIBLE files describe the actual format in the first bytes of the sub format GUID
+
+                if ( format.audioFormat == WAVE_FORMAT_EXTENSIBLE && chunkSize >= 40 ) {
+                    format.audioFormat = readUInt16( fmt + 24 );
+                }
+                hasFormat = true;
+            }
+            else if ( isData )
+            {
+                format.dataOffset = chunkOffset;
+                format.dataSize   = std::min( chunkSize, fileSize - chunkOffset );
+                hasData = true;
+            }
+            // chunks are aligned to an even amount of bytes
+            offset = chunkOffset + chunkSize + ( chunkSize & 1 );
+        }
+
+        if ( !hasFormat || !hasData ) {
+            Debug::log( "WaveReader::Error could not find %s chunk", hasFormat ? "data" : "format" );
+            return false;
+        }
+
+        bool isSupported = format.amountOfChannels > 0 && format.amountOfChannels <= CONVERSION_BLOCK_SIZE && (
+            ( format.audioFormat == WAVE_FORMAT_PCM && (
+                format.bitsPerSample == 8  || format.bitsPerSample == 16 ||
+                format.bitsPerSample == 24 || format.bitsPerSample == 32 )) ||
+            ( format.audioFormat == WAVE_FORMAT_IEEE_FLOAT && (
+                format.bitsPerSample == 32 || format.bitsPerSample == 64 ))
+        );
+
+        if ( !isSupported ) {
+            Debug::log( "WaveReader::Error no support for %d-bit files of format %d", format.bitsPerSample, format.audioFormat );
+            return false;
         }
+
+#ifdef DEBUG
+
+        Debug::log( "File size        : %d", ( int ) fileSize );
+        Debug::log( "Audio format     : %d", format.audioFormat );
+        Debug::log( "Channel amount   : %d", format.amountOfChannels );
+        Debug::log( "Sample rate      : %d", format.sampleRate );
+        Debug::log( "Bits per sample  : %d", format.bitsPerSample );
+
+#endif
+        return true;
     }
-}
 
-/* public methods */
+    inline int getFrameSize( const waveFormat& format )
+    {
+        return ( format.bitsPerSample / 8 ) * format.amountOfChannels;
+    }
 
-waveFile WaveReader::fileToBuffer( std::string inputFile )
-{
-    FILE* fp;
-    waveFile out = { ( unsigned int ) AudioEngineProps::SAMPLE_RATE, nullptr };
+    inline int getAmountOfFrames( const waveFormat& format )
+    {
+        return ( int ) ( format.dataSize / getFrameSize( format ));
+    }
 
-    fp = fopen( inputFile.c_str(), "rb" );
+// the vectorized kernels process four samples at a time. The samples are converted directly into SAMPLE_TYPE
+// (e.g. double precision engines convert the integers into doubles and retain the precision of 24/32-bit data)
 
-    if ( !fp ) {
-        Debug::log( "WaveReader::Error could not open file '%s'", inputFile.c_str() );
-        return out;
+#if defined(__SSE2__)
+
+    #define MWENGINE_PCM_SIMD
+
+    // converts four 32-bit integers into samples and applies given scale
+
+    inline void storeInt32Samples4( __m128i v, SAMPLE_TYPE scale, SAMPLE_TYPE* output )
+    {
+#if PRECISION == 2
+        const __m128d s = _mm_set1_pd( scale );
+        _mm_storeu_pd( output,     _mm_mul_pd( _mm_cvtepi32_pd( v ), s ));
+        _mm_storeu_pd( output + 2, _mm_mul_pd( _mm_cvtepi32_pd( _mm_unpackhi_epi64( v, v )), s ));
+#else
+        _mm_storeu_ps( output, _mm_mul_ps( _mm_cvtepi32_ps( v ), _mm_set1_ps( scale )));
+#endif
     }
 
-    // get the WAV file properties
+    inline void int16ToSamples4( const char* data, SAMPLE_TYPE scale, SAMPLE_TYPE* output )
+    {
+        // sign extend the 16-bit integers to 32-bit by shifting them into the upper half
+        __m128i v = _mm_loadl_epi64(( const __m128i* ) data );
+        storeInt32Samples4( _mm_srai_epi32( _mm_unpacklo_epi16( v, v ), 16 ), scale, output );
+    }
 
-    wav_header header;
-    fread( &header, sizeof( header ), 1, fp );
+    inline void int32ToSamples4( const char* data, SAMPLE_TYPE scale, SAMPLE_TYPE* output )
+    {
+        storeInt32Samples4( _mm_loadu_si128(( const __m128i* ) data ), scale, output );
+    }
 
-    // validate the WAV file header data
+    // splits eight interleaved stereo samples into four left and four right samples
 
-    if ( !strstr( header.fileType,   "RIFF" ) ||
-         !strstr( header.format,     "WAVE" ) ||
-         !strstr( header.formatName, "fmt " )) // yes, the trailing space belongs in there!
+    inline void deinterleave4( const SAMPLE_TYPE* samples, SAMPLE_TYPE* left, SAMPLE_TYPE* right )
     {
-        Debug::log( "WaveReader::Error not a valid WAVE file" );
-        return out;
+#if PRECISION == 2
+        __m128d a = _mm_loadu_pd( samples );
+        __m128d b = _mm_loadu_pd( samples + 2 );
+        __m128d c = _mm_loadu_pd( samples + 4 );
+        __m128d d = _mm_loadu_pd( samples + 6 );
+        _mm_storeu_pd( left,      _mm_unpacklo_pd( a, b ));
+        _mm_storeu_pd( left + 2,  _mm_unpacklo_pd( c, d ));
+        _mm_storeu_pd( right,     _mm_unpackhi_pd( a, b ));
+        _mm_storeu_pd( right + 2, _mm_unpackhi_pd( c, d ));
+#else
+        __m128 a = _mm_loadu_ps( samples );
+        __m128 b = _mm_loadu_ps( samples + 4 );
+        _mm_storeu_ps( left,  _mm_shuffle_ps( a, b, _MM_SHUFFLE( 2, 0, 2, 0 )));
+        _mm_storeu_ps( right, _mm_shuffle_ps( a, b, _MM_SHUFFLE( 3, 1, 3, 1 )));
+#endif
     }
 
-#ifdef DEBUG
+#elif defined(__ARM_NEON) && ( PRECISION == 1 || defined(__aarch64__))
 
-    Debug::log( "WaveReader::About to parse data for WAV file '%s'", inputFile.c_str() );
-    Debug::log( "File size        : %d", header.fileSize );
-    Debug::log( "Audio format     : %d", header.audioFormat );
-    Debug::log( "Channel amount   : %d", header.amountOfChannels );
-    Debug::log( "Sample rate      : %d", header.sampleRate );
-    Debug::log( "Bytes per second : %d", header.bytesPerSecond );
-    Debug::log( "Block align      : %d", header.blockAlign );
-    Debug::log( "Bits per sample  : %d", header.bitsPerSample );
+    #define MWENGINE_PCM_SIMD
 
+    inline void storeInt32Samples4( int32x4_t v, SAMPLE_TYPE scale, SAMPLE_TYPE* output )
+    {
+#if PRECISION == 2
+        // double precision vectors are only available on AArch64
+        vst1q_f64( output,     vmulq_n_f64( vcvtq_f64_s64( vmovl_s32( vget_low_s32( v ))), scale ));
+        vst1q_f64( output + 2, vmulq_n_f64( vcvtq_f64_s64( vmovl_high_s32( v )), scale ));
+#else
+        vst1q_f32( output, vmulq_n_f32( vcvtq_f32_s32( v ), scale ));
 #endif
+    }
 
-    // the data chunk can be offset in case the WAV file contains
-    // meta data, seek for the data definition
+    inline void int16ToSamples4( const char* data, SAMPLE_TYPE scale, SAMPLE_TYPE* output )
+    {
+        storeInt32Samples4( vmovl_s16( vld1_s16(( const int16_t* ) data )), scale, output );
+    }
+
+    inline void int32ToSamples4( const char* data, SAMPLE_TYPE scale, SAMPLE_TYPE* output )
+    {
+        storeInt32Samples4( vld1q_s32(( const int32_t* ) data ), scale, output );
+    }
 
-    wav_header_data_chunk dataChunk;
+    inline void deinterleave4( const SAMPLE_TYPE* samples, SAMPLE_TYPE* left, SAMPLE_TYPE* right )
+    {
+#if PRECISION == 2
+        float64x2x2_t a = vld2q_f64( samples );
+        float64x2x2_t b = vld2q_f64( samples + 4 );
+        vst1q_f64( left,      a.val[ 0 ] );
+        vst1q_f64( left + 2,  b.val[ 0 ] );
+        vst1q_f64( right,     a.val[ 1 ] );
+        vst1q_f64( right + 2, b.val[ 1 ] );
+#else
+        float32x4x2_t frames = vld2q_f32( samples );
+        vst1q_f32( left,  frames.val[ 0 ] );
+        vst1q_f32( right, frames.val[ 1 ] );
+#endif
+    }
+
+#endif
 
-    while ( true )
+    /**
+     * converts given amount of (interleaved) samples in given format to SAMPLE_TYPE
+     */
+    void decodeSamples( const char* data, SAMPLE_TYPE* output, int amountOfSamples, const waveFormat& format )
     {
-        fread( &dataChunk, sizeof( dataChunk ), 1, fp );
+        int i = 0;
 
-        if ( *( unsigned int* ) &dataChunk.ID == 0x61746164 )
-            break;
+        if ( format.audioFormat == WAVE_FORMAT_IEEE_FLOAT ) {
+            if ( format.bitsPerSample == 32 ) {
+                for ( float sample; i < amountOfSamples; ++i ) {
+                    memcpy( &sample, data + i * sizeof( float ), sizeof( float ));
+                    output[ i ] = ( SAMPLE_TYPE ) sample;
+                }
+            } else {
+                for ( double sample; i < amountOfSamples; ++i ) {
+                    memcpy( &sample, data + i * sizeof( double ), sizeof( double ));
+                    output[ i ] = ( SAMPLE_TYPE ) sample;
+                }
+            }
+            return;
+        }
 
-        // skip chunk data bytes
+        switch ( format.bitsPerSample )
+        {
+            // 8-bit (note: 8-bit WAV files are unsigned)
+            case 8:
+                for ( ; i < amountOfSamples; ++i ) {
+                    output[ i ] = ( SAMPLE_TYPE ) (( unsigned char ) data[ i ] - 128 ) / ( SAMPLE_TYPE ) 128;
+                }
+                break;
 
-        if ( dataChunk.size > header.fileSize ) {
+            case 16:
+            {
+                const SAMPLE_TYPE scale = ( SAMPLE_TYPE ) 1 / ( SAMPLE_TYPE ) 32767;
+#ifdef MWENGINE_PCM_SIMD
+                for ( ; i + 4 <= amountOfSamples; i += 4 ) {
+                    int16ToSamples4( data + i * 2, scale, output + i );
+                }
+#endif
+                for ( INT16 sample; i < amountOfSamples; ++i ) {
+                    memcpy( &sample, data + i * 2, 2 );
+                    output[ i ] = ( SAMPLE_TYPE ) sample * scale;
+                }
+                break;
+            }
 
-            // unless this occurs; when the reported data chunk size exceeds the fileSize reported
-            // by the header, this is a clear indication that we're dealing with a corrupted file
-            // header. "Rewind" fread position and attempt to read file by assuming next chunk
-            // is data (in other words: assume no metadata is present in the header)
+            // 24-bit (packed in three bytes as there is no 24-bit data type)
+            case 24:
+            {
+                const SAMPLE_TYPE scale = ( SAMPLE_TYPE ) 1 / ( SAMPLE_TYPE ) 8388607;
+                const unsigned char* bytes = ( const unsigned char* ) data;
 
-            Debug::log( "WaveReader::Warning data chunk parsing failure. Assuming header corruption, attempting to read data as-is" );
+                for ( ; i < amountOfSamples; ++i, bytes += 3 ) {
+                    // shift into the upper bytes of a 32-bit integer to sign extend the value
+                    int32_t sample = ( int32_t )(( uint32_t ) bytes[ 0 ] << 8 | ( uint32_t ) bytes[ 1 ] << 16 | ( uint32_t ) bytes[ 2 ] << 24 ) >> 8;
+                    output[ i ] = ( SAMPLE_TYPE ) sample * scale;
+                }
+                break;
+            }
 
-            fseek( fp, -( sizeof dataChunk ), SEEK_CUR );
+            case 32:
+            {
+                const SAMPLE_TYPE scale = ( SAMPLE_TYPE ) 1 / ( SAMPLE_TYPE ) 2147483647;
+#ifdef MWENGINE_PCM_SIMD
+                for ( ; i + 4 <= amountOfSamples; i += 4 ) {
+                    int32ToSamples4( data + i * 4, scale, output + i );
+                }
+#endif
+                for ( int32_t sample; i < amountOfSamples; ++i ) {
+                    memcpy( &sample, data + i * 4, 4 );
+                    output[ i ] = ( SAMPLE_TYPE ) sample * scale;
+                }
+                break;
+            }
+        }
+    }
 
-            fread( dataChunk.ID,    sizeof( char ), 4, fp );
-            fread( &dataChunk.size, sizeof( unsigned int ), 1, fp );
+    /**
+     * writes given amount of frames of interleaved samples into the channels of given buffer
+     */
+    void deinterleave( const SAMPLE_TYPE* samples, int amountOfFrames, AudioBuffer* buffer, int writeOffset )
+    {
+        int amountOfChannels = buffer->amountOfChannels;
+        int i = 0;
 
-            break;
+        if ( amountOfChannels == 1 ) {
+            memcpy( buffer->getBufferForChannel( 0 ) + writeOffset, samples, amountOfFrames * sizeof( SAMPLE_TYPE ));
+        }
+        else if ( amountOfChannels == 2 ) {
+            SAMPLE_TYPE* left  = buffer->getBufferForChannel( 0 ) + writeOffset;
+            SAMPLE_TYPE* right = buffer->getBufferForChannel( 1 ) + writeOffset;
+#ifdef MWENGINE_PCM_SIMD
+            for ( ; i + 4 <= amountOfFrames; i += 4 ) {
+                deinterleave4( samples + i * 2, left + i, right + i );
+            }
+#endif
+            for ( ; i < amountOfFrames; ++i ) {
+                left[ i ]  = samples[ i * 2 ];
+                right[ i ] = samples[ i * 2 + 1 ];
+            }
         }
         else {
-            fseek( fp, dataChunk.size, SEEK_CUR );
+            // for other channel configurations each channel is read at the channel stride
+            for ( int c = 0; c < amountOfChannels; ++c ) {
+                SAMPLE_TYPE* output = buffer->getBufferForChannel( c ) + writeOffset;
+                for ( i = 0; i < amountOfFrames; ++i ) {
+                    output[ i ] = samples[ i * amountOfChannels + c ];
+                }
+            }
         }
+    }
+}
 
-        if ( feof( fp )) {
-            Debug::log( "WaveReader::Error could not find data chunk" );
-            return out;
-        }
+/* public methods */
+
+waveFile WaveReader::fileToBuffer( std::string inputFile )
+{
+    waveFile out = { ( unsigned int ) AudioEngineProps::SAMPLE_RATE, nullptr };
+    waveFormat format;
+
+    FILE* fp = fopen( inputFile.c_str(), "rb" );
+
+    if ( !fp ) {
+        Debug::log( "WaveReader::Error could not open file '%s'", inputFile.c_str() );
+        return out;
     }
 
-    unsigned int amountOfSamples = dataChunk.size * 8 / header.bitsPerSample;
-    unsigned int bufferSize      = amountOfSamples / header.amountOfChannels;
+    fseek( fp, 0, SEEK_END );
+    size_t fileSize = ( size_t ) ftell( fp );
 
-    if ( amountOfSamples <= 0 ) {
-        Debug::log( "WaveReader::Error could not find sample data" );
+#ifdef DEBUG
+    Debug::log( "WaveReader::About to parse data for WAV file '%s'", inputFile.c_str() );
+#endif
+
+    bool isValid = parseFormat([ fp ]( size_t offset, void* destination, size_t size ) {
+        return fseek( fp, ( long ) offset, SEEK_SET ) == 0 && fread( destination, 1, size, fp ) == size;
+    }, fileSize, format );
+
+    int amountOfFrames = isValid ? getAmountOfFrames( format ) : 0;
+
+    if ( amountOfFrames <= 0 ) {
+        if ( isValid ) {
+            Debug::log( "WaveReader::Error could not find sample data" );
+        }
+        fclose( fp );
         return out;
     }
 
-    int sampleSize = header.bitsPerSample / 8;
-    int i;
-
-    out.sampleRate = ( unsigned int ) header.sampleRate;
-    out.buffer     = new AudioBuffer( header.amountOfChannels, bufferSize );
-
-    // Read samples from WAV file and convert data into MWEngine AudioBuffer
-
-    switch ( header.bitsPerSample ) {
-        // by default we will treat files as 16-bit
-        default:
-            Debug::log( "WaveReader::Warning no support for %s-bit file. Treating as 16-bit", header.bitsPerSample );
-        // 16-bit
-        case 16:
-            convert(
-                ( short ) 0, out.buffer, fp, sampleSize,
-                ( SAMPLE_TYPE ) ( header.audioFormat == 3 ? 1 : 32767 )
-            );
-            break;
-
-        // 24-bit (via char array conversion as there is no 24-bit data type)
-        case 24:
-            unsigned char input[ 3 ];
-            long output;
-            for ( i = 0; i < bufferSize; ++i )
-            {
-                for ( int c = 0; c < header.amountOfChannels; ++c ) {
-                    fread( &input, sizeof( char ), 3, fp );
-                    // note that RIFF files are little endian
-                    if ( input[ 2 ] & 0x80 ) {
-                        // value is negative
-                        output = ( 0xff << 24 ) | ( input[ 2 ] << 16 ) | ( input[ 1 ] << 8 ) | ( input[ 0 ] << 0 );
-                    } else {
-                        output = ( input[ 2 ] << 16 ) | ( input[ 1 ] << 8 ) | (input[ 0 ] << 0 );
-                    }
-                    out.buffer->getBufferForChannel( c )[ i ] = (( SAMPLE_TYPE ) output ) / 8388607.;
-                }
-            }
-            break;
-
-        // 32-bit
-        case 32:
-            convert(
-                ( float ) 0, out.buffer, fp, sampleSize,
-                ( SAMPLE_TYPE ) ( header.audioFormat == 3 ? 1 : 2147483647 )
-            );
-            break;
-
-        // 64-bit
-        case 64:
-            convert(
-                ( double ) 0, out.buffer, fp, sampleSize,
-                ( SAMPLE_TYPE ) ( header.audioFormat == 3 ? 1 : 9223372036854775807 )
-            );
-            break;
-
-        // 8-bit (note: 8-bit WAV files are unsigned)
-        case 8:
-            convert(( unsigned char ) 0, out.buffer, fp, sampleSize, ( SAMPLE_TYPE ) 255 );
-            break;
+    out.sampleRate = format.sampleRate;
+    out.buffer     = new AudioBuffer( format.amountOfChannels, amountOfFrames );
+
+    // read the sample data in blocks (of a whole amount of frames)
+
+    int frameSize      = getFrameSize( format );
+    int framesPerBlock = std::max( 1, ( int ) ( READ_BLOCK_SIZE / frameSize ));
+
+    std::vector<char> block(( size_t ) framesPerBlock * frameSize );
+    fseek( fp, ( long ) format.dataOffset, SEEK_SET );
+
+    for ( int frame = 0; frame < amountOfFrames; frame += framesPerBlock )
+    {
+        int framesToRead = std::min( framesPerBlock, amountOfFrames - frame );
+        int framesRead   = ( int ) fread( block.data(), frameSize, framesToRead, fp );
+
+        dataToBuffer( block.data(), framesRead, format, out.buffer, frame );
+
+        if ( framesRead < framesToRead ) {
+            break; // premature end of file, remainder of buffer remains silent
+        }
     }
 
     // free allocated resources
@@ -254,77 +466,68 @@ WaveTable* WaveReader::fileToTable( std::string inputFile )
 
 waveFile WaveReader::byteArrayToBuffer( const std::vector<char>& byteArray )
 {
-    // TODO: this mostly mirrors the fileToBuffer-method, clean this up!
-
-    AudioBuffer* buffer = nullptr;
-
-    // first we'll check the necessary headers identifying the WAV file
+    waveFile out = { ( unsigned int ) AudioEngineProps::SAMPLE_RATE, nullptr };
+    waveFormat format;
 
-    char id[ 5 ];
-    short* temp_buffer;
-    short amountOfChannels;
-    unsigned long format, sampleRate, dataSize;
-    size_t i, l, w;
+    bool isValid = parseFormat([ &byteArray ]( size_t offset, void* destination, size_t size ) {
+        if ( offset + size > byteArray.size() ) {
+            return false;
+        }
+        memcpy( destination, byteArray.data() + offset, size );
+        return true;
+    }, byteArray.size(), format );
 
-    sliceString( byteArray, id, 0, 4 );
-    id[ 4 ] = '\0';
+    int amountOfFrames = isValid ? getAmountOfFrames( format ) : 0;
 
-    if ( !strcmp( id, "RIFF" ))
-    {
-        sliceString( byteArray, id, 8, 4 );
-        id[ 4 ] = '\0';
+    if ( amountOfFrames <= 0 ) {
+        Debug::log( "WaveReader::Could not parse WAVE file" );
+        return out;
+    }
 
-        if ( !strcmp( id, "WAVE" ))
-        {
-            // read the header data (see http://soundfile.sapp.org/doc/WaveFormat/)
+    out.sampleRate = format.sampleRate;
+    out.buffer     = new AudioBuffer( format.amountOfChannels, amountOfFrames );
 
-            format           = sliceLong( byteArray, 20, true );
-            amountOfChannels = ( short ) sliceLong( byteArray, 22, true );
-            sampleRate       = sliceLong( byteArray, 24, true );
-            dataSize         = sliceLong( byteArray, 40, true );
-            temp_buffer     = ( short* ) malloc( dataSize );
+    dataToBuffer( byteArray.data() + format.dataOffset, amountOfFrames, format, out.buffer, 0 );
 
-            Debug::log("WaveReader::reading %d channels w/ %d samples @ %d Hz", amountOfChannels, dataSize, sampleRate );
+    return out;
+}
 
-            // in Android NDK 26 reading of byte array is horribly broken...
+bool WaveReader::fileToFormat( std::string inputFile, waveFormat& format )
+{
+    FILE* fp = fopen( inputFile.c_str(), "rb" );
 
-            if ( dataSize <= 1 ) {
-                Debug::log( "WaveReader::Could not parse WAVE file" );
-                waveFile out = { ( unsigned int ) sampleRate, buffer };
-                return out;
-            }
+    if ( !fp ) {
+        Debug::log( "WaveReader::Error could not open file '%s'", inputFile.c_str() );
+        return false;
+    }
+    fseek( fp, 0, SEEK_END );
+    size_t fileSize = ( size_t ) ftell( fp );
 
-            // 2 is sizeof short (16-bits, thus 2 bytes)
+    bool isValid = parseFormat([ fp ]( size_t offset, void* destination, size_t size ) {
+        return fseek( fp, ( long ) offset, SEEK_SET ) == 0 && fread( destination, 1, size, fp ) == size;
+    }, fileSize, format );
 
-            for ( i = 44, l = i + dataSize, w = 0; i < l; i += 2, ++w )
-                temp_buffer[ w ] = ( uint8_t ) byteArray[ i ] | (( uint8_t ) byteArray[ i + 1 ] << 8 );
+    fclose( fp );
 
-            unsigned long bufferSize = ( dataSize / sizeof( short )) / amountOfChannels;
+    return isValid;
+}
 
-            buffer = new AudioBuffer( amountOfChannels, ( int ) bufferSize );
+void WaveReader::dataToBuffer( const char* data, int amountOfFrames, const waveFormat& format, AudioBuffer* buffer, int writeOffset )
+{
+    // convert the data in blocks using a fixed size (stack allocated) buffer at the engine's precision
 
-            // convert short values into SAMPLE_TYPE
+    SAMPLE_TYPE samples[ CONVERSION_BLOCK_SIZE ];
 
-            SAMPLE_TYPE MAX_VALUE = ( SAMPLE_TYPE ) 32767; // max size for either side of a signed short
+    int frameSize      = getFrameSize( format );
+    int framesPerBlock = std::max( 1, CONVERSION_BLOCK_SIZE / format.amountOfChannels );
 
-            int cb = 0;
+    for ( int frame = 0; frame < amountOfFrames; frame += framesPerBlock )
+    {
+        int framesToConvert = std::min( framesPerBlock, amountOfFrames - frame );
 
-            for ( i = 0; i < bufferSize; ++i, cb += amountOfChannels )
-            {
-                for ( int c = 0; c < amountOfChannels; ++c )
-                    buffer->getBufferForChannel( c )[ i ] = ( SAMPLE_TYPE )( temp_buffer[ cb + c ]) / MAX_VALUE;
-            }
-            free( temp_buffer );
-        }
-        else
-            Debug::log( "WaveReader::Error not a valid WAVE file" );
+        decodeSamples( data + ( size_t ) frame * frameSize, samples, framesToConvert * format.amountOfChannels, format );
+        deinterleave( samples, framesToConvert, buffer, writeOffset + frame );
     }
-    else
-        Debug::log( "WaveReader::Error not a valid WAVE file (no RIFF header)" );
-
-    waveFile out = { ( unsigned int ) sampleRate, buffer };
-
-    return out;
 }
 
 } // E.O namespace MWEngine
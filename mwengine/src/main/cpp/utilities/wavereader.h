@@ -20,9 +20,13 @@
  * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
  * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
  */
+#ifndef __MWENGINE__WAVEREADER_H_INCLUDED__
+#define __MWENGINE__WAVEREADER_H_INCLUDED__
+
 #include "../audiobuffer.h"
 #include "../wavetable.h"
 #include <string>
+#include <vector>
 
 namespace MWEngine {
 
@@ -32,6 +36,23 @@ typedef struct
    AudioBuffer* buffer; // no auto cleanup, use consideration (f.i. use with SampleManager)
 } waveFile;
 
+// describes the format of the sample data inside a WAV file
+
+typedef struct
+{
+    int audioFormat;         // 1 == PCM, 3 == IEEE float (for WAVE_FORMAT_EXTENSIBLE files, this is the sub format)
+    int amountOfChannels;
+    unsigned int sampleRate;
+    int bitsPerSample;       // 8, 16, 24 or 32-bit PCM or 32 or 64-bit IEEE float
+    size_t dataOffset;       // offset (in bytes) of the sample data inside the file
+    size_t dataSize;         // size (in bytes) of the sample data
+} waveFormat;
+
+/**
+ * WaveReader reads WAV files into AudioBuffers. Supported are 8, 16, 24 and 32-bit PCM and
+ * 32 and 64-bit IEEE float data (including files using the WAVE_FORMAT_EXTENSIBLE header).
+ * The sample data is read in blocks and converted using vectorized kernels (where available).
+ */
 class WaveReader
 {
     public:
@@ -51,5 +72,17 @@ class WaveReader
         static WaveTable* fileToTable( std::string inputFile );
 
         static waveFile byteArrayToBuffer( const std::vector<char>& byteArray );
+
+        // reads the header of the File at the given path into given format, returns false
+        // when the file doesn't exist / is not a valid (or supported) WAV file
+
+        static bool fileToFormat( std::string inputFile, waveFormat& format );
+
+        // converts given amount of frames of (interleaved) sample data in given format
+        // into the channels of given buffer, starting at given writeOffset (in samples)
+
+        static void dataToBuffer( const char* data, int amountOfFrames, const waveFormat& format, AudioBuffer* buffer, int writeOffset );
 };
 } // E.O namespace MWEngine
+
+#endif
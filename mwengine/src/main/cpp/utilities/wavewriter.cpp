@@ -90,4 +90,24 @@ INT16* WaveWriter::bufferToPCM( AudioBuffer* buffer )
     return outputBuffer;
 }
 
+void WaveWriter::floatToPCM( const float* inputBuffer, INT16* outputBuffer, size_t amountOfSamples )
+{
+    float MAX_VALUE = 32767.f;
+
+    for ( size_t i = 0; i < amountOfSamples; ++i )
+    {
+        float sample = inputBuffer[ i ] * MAX_VALUE;
+
+        // sanity check to keep converted samples within range
+
+        if ( sample > +MAX_VALUE )
+            sample = +MAX_VALUE;
+
+        else if ( sample < -MAX_VALUE )
+            sample = -MAX_VALUE;
+
+        outputBuffer[ i ] = ( INT16 ) sample;
+    }
+}
+
 } // E.O namespace MWEngine
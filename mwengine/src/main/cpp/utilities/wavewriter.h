@@ -69,6 +69,22 @@ class WaveWriter
             return stream;
         }
 
+        /**
+         * Updates the size fields in the header of given stream (created by createWAVStream())
+         * to match given size of the written WAV data. This allows writing a WAV file whose
+         * final size wasn't known when creating the stream.
+         */
+        static void updateWAVStreamSize( std::ofstream& stream, size_t totalBufSizeWritten )
+        {
+            std::streampos position = stream.tellp();
+
+            stream.seekp( 4 );
+            t_streamwrite<UINT32>( stream, 36 + totalBufSizeWritten ); // file size
+            stream.seekp( 40 );
+            t_streamwrite<UINT32>( stream, totalBufSizeWritten );      // data size
+            stream.seekp( position );
+        }
+
         /**
          * Appends the contents of given buffer to given stream
          */
@@ -84,6 +100,12 @@ class WaveWriter
          */
         static INT16* bufferToPCM( AudioBuffer* buffer );
 
+        /**
+         * Converts given amount of (interleaved) floating point samples into
+         * PCM compliant samples, written into given (preallocated) outputBuffer
+         */
+        static void floatToPCM( const float* inputBuffer, INT16* outputBuffer, size_t amountOfSamples );
+
     protected:
 
         template <typename T>
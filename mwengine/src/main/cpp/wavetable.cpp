@@ -32,6 +32,8 @@ WaveTable::WaveTable( int aTableLength, float aFrequency )
     tableLength  = aTableLength;
     _accumulator = 0.0;
     _buffer      = BufferUtility::generateSilentBuffer( tableLength );
+    _mipmaps     = nullptr;
+    clearMipmaps();
     setFrequency( aFrequency );
 
     SR_OVER_LENGTH = ( SAMPLE_TYPE ) AudioEngineProps::SAMPLE_RATE / ( SAMPLE_TYPE ) tableLength;
@@ -40,6 +42,7 @@ WaveTable::WaveTable( int aTableLength, float aFrequency )
 WaveTable::~WaveTable()
 {
     delete[] _buffer;
+    delete[] _mipmaps;
 }
 
 /* public methods */
@@ -85,6 +88,49 @@ void WaveTable::setBuffer( SAMPLE_TYPE* aBuffer )
         delete[] _buffer;
 
     _buffer = aBuffer;
+
+    // mipmaps were derived from the previous buffer
+    clearMipmaps();
+}
+
+bool WaveTable::hasMipmaps()
+{
+    return _mipmaps != nullptr;
+}
+
+int WaveTable::getMipmapAmount()
+{
+    return _mipmapAmount;
+}
+
+int WaveTable::getMipmapLength()
+{
+    return _mipmapLength;
+}
+
+int WaveTable::getMaxHarmonics()
+{
+    return _maxHarmonics;
+}
+
+void WaveTable::setMipmaps( SAMPLE_TYPE* mipmaps, int amount, int length, int maxHarmonics )
+{
+    delete[] _mipmaps;
+
+    _mipmaps      = mipmaps;
+    _mipmapAmount = amount;
+    _mipmapLength = length;
+    _maxHarmonics = maxHarmonics;
+}
+
+void WaveTable::clearMipmaps()
+{
+    delete[] _mipmaps;
+
+    _mipmaps      = nullptr;
+    _mipmapAmount = 0;
+    _mipmapLength = 0;
+    _maxHarmonics = 0;
 }
 
 void WaveTable::cloneTable( WaveTable* waveTable )
@@ -97,6 +143,18 @@ void WaveTable::cloneTable( WaveTable* waveTable )
     }
     for ( int i = 0; i < tableLength; ++i )
         _buffer[ i ] = waveTable->_buffer[ i ];
+
+    if ( !waveTable->hasMipmaps() ) {
+        clearMipmaps();
+        return;
+    }
+    int mipmapSize       = waveTable->_mipmapAmount * waveTable->_mipmapLength;
+    SAMPLE_TYPE* mipmaps = new SAMPLE_TYPE[ mipmapSize ];
+
+    for ( int i = 0; i < mipmapSize; ++i )
+        mipmaps[ i ] = waveTable->_mipmaps[ i ];
+
+    setMipmaps( mipmaps, waveTable->_mipmapAmount, waveTable->_mipmapLength, waveTable->_maxHarmonics );
 }
 
 WaveTable* WaveTable::clone()
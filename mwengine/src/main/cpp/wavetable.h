@@ -67,6 +67,33 @@ class WaveTable
             return _buffer[ readOffset ];
         }
 
+        // band-limited mipmaps (one per octave) allow reading the table without aliasing
+        // at higher frequencies. These are generated by WaveGenerator::generateMipmaps(), note
+        // the mipmaps are cleared when a new buffer is set
+
+        bool hasMipmaps();
+        int getMipmapAmount();
+        int getMipmapLength();
+        int getMaxHarmonics();
+        void setMipmaps( SAMPLE_TYPE* mipmaps, int amount, int length, int maxHarmonics );
+        void clearMipmaps();
+
+        /**
+         * retrieve the mipmap holding the most harmonics that remain below the Nyquist
+         * frequency when reading the table at given phase increment (i.e. the fraction
+         * of a wave cycle to advance per sample, equal to frequency / sample rate)
+         * each successive mipmap holds half the harmonics of its predecessor
+         */
+        inline SAMPLE_TYPE* getMipmapForIncrement( SAMPLE_TYPE phaseIncrement )
+        {
+            int level = 0;
+
+            while ( level < _mipmapAmount - 1 && ( _maxHarmonics >> level ) * phaseIncrement > 0.5 )
+                ++level;
+
+            return _mipmaps + level * _mipmapLength;
+        }
+
         void cloneTable( WaveTable* waveTable );
         WaveTable* clone();
 
@@ -75,6 +102,11 @@ class WaveTable
         SAMPLE_TYPE _accumulator;   // is read offset in wave table buffer
         SAMPLE_TYPE SR_OVER_LENGTH;
         float       _frequency;     // frequency (in Hz) of waveform cycle when reading
+
+        SAMPLE_TYPE* _mipmaps;      // all mipmaps in a single buffer (each mipmap is _mipmapLength in size)
+        int _mipmapAmount;
+        int _mipmapLength;          // always a power of two
+        int _maxHarmonics;          // the amount of harmonics in the first mipmap
 };
 } // E.O namespace MWEngine
 
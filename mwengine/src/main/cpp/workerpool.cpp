@@ -0,0 +1,226 @@
+/**
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2026 Igor Zinken - https://www.igorski.nl
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#include "workerpool.h"
+#include <messaging/notifier.h>
+#include <utilities/perfutility.h>
+#include <chrono>
+#include <climits>
+
+#if defined(__linux__)
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace MWEngine {
+
+// the epoch is used as the futex word
+static_assert( sizeof( std::atomic<uint32_t> ) == sizeof( uint32_t ), "atomic epoch cannot be used as a futex" );
+
+/* constructor / destructor */
+
+WorkerPool::WorkerPool( int amountOfWorkers, const std::vector<int>& cpuCores )
+{
+    _amountOfWorkers = amountOfWorkers;
+    _ranges          = new Range[ amountOfWorkers + 1 ];
+
+    _running.store( true );
+    _activeWorkers.store( 0 );
+    _task.store( nullptr );
+    _data.store( nullptr );
+    _epoch.store( 0 );
+    _parkedWorkers.store( 0 );
+
+    for ( int i = 0; i <= amountOfWorkers; ++i ) {
+        _ranges[ i ].next.store( 0 );
+        _ranges[ i ].end = 0;
+    }
+
+    // the calling (render) thread typically occupies the first core, distribute the workers across the remainder
+
+    std::vector<int> cores = cpuCores;
+    if ( cores.empty() ) {
+        for ( int i = 0, l = ( int ) std::thread::hardware_concurrency(); i < l; ++i ) {
+            cores.push_back( i );
+        }
+    }
+
+    for ( int i = 0; i < amountOfWorkers; ++i ) {
+        int cpuId = cores.empty() ? -1 : cores.at(( i + 1 ) % cores.size() );
+        _threads.push_back( new std::thread( &WorkerPool::workerLoop, this, i, cpuId ));
+    }
+}
+
+WorkerPool::~WorkerPool()
+{
+    _running.store( false );
+    _epoch.fetch_add( 1 );
+    wakeWorkers();
+
+    for ( int i = 0; i < _amountOfWorkers; ++i ) {
+        _threads[ i ]->join();
+        delete _threads[ i ];
+    }
+    delete[] _ranges;
+}
+
+/* public methods */
+
+void WorkerPool::run( Task task, void* data, size_t amount )
+{
+    int participants = _amountOfWorkers + 1;
+
+    // divide the indices into contiguous ranges, one for each participant
+
+    size_t rangeSize = amount / participants;
+    size_t remainder = amount % participants;
+    size_t start     = 0;
+
+    for ( int i = 0; i < participants; ++i ) {
+        size_t end = start + rangeSize + (( size_t ) i < remainder ? 1 : 0 );
+        _ranges[ i ].next.store( start, std::memory_order_relaxed );
+        _ranges[ i ].end = end;
+        start = end;
+    }
+
+    _task.store( task, std::memory_order_relaxed );
+    _data.store( data, std::memory_order_relaxed );
+    _activeWorkers.store( _amountOfWorkers, std::memory_order_release );
+
+    // spinning workers pick up the new epoch by themselves, parked workers require a wake up
+
+    _epoch.fetch_add( 1 );
+
+    if ( _parkedWorkers.load() > 0 ) {
+        wakeWorkers();
+    }
+
+    // the calling thread processes the last range
+
+    execute( _amountOfWorkers );
+
+    // all indices have been claimed at this point, wait until the workers have
+    // completed the ones they are still processing (this is typically brief)
+
+    while ( _activeWorkers.load( std::memory_order_acquire ) > 0 ) {
+#ifdef PREVENT_CPU_FREQUENCY_SCALING
+        noop();
+#else
+        std::this_thread::yield();
+#endif
+    }
+}
+
+int WorkerPool::getAmountOfWorkers()
+{
+    return _amountOfWorkers;
+}
+
+/* private methods */
+
+void WorkerPool::workerLoop( int workerIndex, int cpuId )
+{
+    if ( cpuId >= 0 ) {
+        PerfUtility::pinThreadToCore( cpuId );
+    }
+
+    // broadcasts made while executing a task are dispatched outside of the worker (as with the render thread)
+
+    Notifier::registerRenderWorker();
+
+    uint32_t epoch = 0;
+
+    while ( true )
+    {
+        awaitEpoch( epoch );
+        epoch = _epoch.load( std::memory_order_acquire );
+
+        if ( !_running.load() ) {
+            break;
+        }
+        execute( workerIndex );
+        _activeWorkers.fetch_sub( 1, std::memory_order_release );
+    }
+    Notifier::unregisterRenderWorker();
+}
+
+void WorkerPool::awaitEpoch( uint32_t epoch )
+{
+    for ( int i = 0; i < SPIN_ITERATIONS; ++i )
+    {
+        if ( _epoch.load( std::memory_order_acquire ) != epoch ) {
+            return;
+        }
+#ifdef PREVENT_CPU_FREQUENCY_SCALING
+        noop();
+#endif
+    }
+
+    // park the worker. Note the parked count is incremented prior to checking the epoch (while run() increments
+    // the epoch prior to checking the parked count), as such either the worker observes the new epoch or run() wakes it
+
+    while ( _epoch.load() == epoch )
+    {
+        _parkedWorkers.fetch_add( 1 );
+
+        if ( _epoch.load() == epoch ) {
+#if defined(__linux__)
+            // returns immediately when the epoch no longer equals the expected value
+            syscall( SYS_futex, reinterpret_cast<uint32_t*>( &_epoch ), FUTEX_WAIT_PRIVATE, epoch, nullptr, nullptr, 0 );
+#else
+            std::this_thread::sleep_for( std::chrono::microseconds( 100 ));
+#endif
+        }
+        _parkedWorkers.fetch_sub( 1 );
+    }
+}
+
+void WorkerPool::wakeWorkers()
+{
+#if defined(__linux__)
+    syscall( SYS_futex, reinterpret_cast<uint32_t*>( &_epoch ), FUTEX_WAKE_PRIVATE, INT_MAX, nullptr, nullptr, 0 );
+#endif
+}
+
+void WorkerPool::execute( int participantIndex )
+{
+    Task task  = _task.load( std::memory_order_acquire );
+    void* data = _data.load( std::memory_order_acquire );
+
+    int participants = _amountOfWorkers + 1;
+    size_t index;
+
+    // process own range first, then steal from the ranges of the other participants
+    // (claiming an index is an atomic increment, an index can thus never run twice)
+
+    for ( int i = 0; i < participants; ++i )
+    {
+        Range& range = _ranges[( participantIndex + i ) % participants ];
+
+        while (( index = range.next.fetch_add( 1, std::memory_order_acq_rel )) < range.end ) {
+            task( index, data );
+        }
+    }
+}
+
+} // E.O namespace MWEngine
@@ -0,0 +1,94 @@
+/**
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2026 Igor Zinken - https://www.igorski.nl
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#ifndef __MWENGINE__WORKERPOOL_H_INCLUDED__
+#define __MWENGINE__WORKERPOOL_H_INCLUDED__
+
+#include "global.h"
+#include <atomic>
+#include <thread>
+#include <vector>
+
+namespace MWEngine {
+
+/**
+ * WorkerPool maintains a fixed amount of pre-spawned threads (each pinned to
+ * a CPU core) that execute a task for a range of indices in parallel. The calling
+ * thread takes part in the execution of the task and only returns when all
+ * indices have been processed.
+ *
+ * Each participant starts out on its own contiguous subrange of indices and upon
+ * exhausting it, steals the remaining indices from the other participants. As such
+ * a single heavy index (e.g. an AudioChannel with an expensive ProcessingChain)
+ * won't leave the other cores idling.
+ *
+ * Idle workers spin briefly before parking on a futex, run() only wakes the workers through
+ * a system call when any of them has parked. run() neither allocates nor locks, making it
+ * safe to use within the render thread.
+ */
+class WorkerPool
+{
+    public:
+
+        // a task is invoked once for every index, data is the pointer given to run()
+        typedef void ( *Task )( size_t index, void* data );
+
+        WorkerPool( int amountOfWorkers, const std::vector<int>& cpuCores );
+        ~WorkerPool();
+
+        void run( Task task, void* data, size_t amount );
+
+        int getAmountOfWorkers();
+
+    private:
+
+        // the index range owned by a participant, padded to prevent false sharing
+
+        struct alignas( 64 ) Range {
+            std::atomic<size_t> next;
+            size_t end;
+        };
+
+        // the amount of iterations an idle worker spins awaiting the next run() before parking
+
+        static const int SPIN_ITERATIONS = 4096;
+
+        int _amountOfWorkers;
+        std::vector<std::thread*> _threads;
+        Range* _ranges; // one per worker + one for the calling thread (stored last)
+
+        std::atomic<uint32_t> _epoch;        // incremented by each run(), the workers await its change
+        std::atomic<int>      _parkedWorkers; // amount of workers waiting on the futex
+
+        std::atomic<bool> _running;
+        std::atomic<int>  _activeWorkers;
+        std::atomic<Task> _task;
+        std::atomic<void*> _data;
+
+        void workerLoop( int workerIndex, int cpuId );
+        void awaitEpoch( uint32_t epoch );
+        void wakeWorkers();
+        void execute( int participantIndex );
+};
+} // E.O namespace MWEngine
+
+#endif
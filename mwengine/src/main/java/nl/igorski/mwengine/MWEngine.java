@@ -69,9 +69,6 @@ public final class MWEngine
          * SEQUENCER_POSITION_UPDATED fired when Sequencer has advanced a step, payload describes
          *                            the precise buffer offset of the Sequencer when the notification fired
          *                            (as a value in the range of 0 - BUFFER_SIZE)
-         * RECORDED_SNIPPET_READY     fired when a recording snippet of the requested size is ready for
-         *                            writing onto storage, payload describes snippets buffer index (see DiskWriter)
-         * RECORDED_SNIPPET_SAVED     fired when snippet has been saved onto storage, payload describes snippets number
          * BOUNCE_COMPLETE            fired when the offline bouncing of the Sequencer range has completed
          */
         void handleNotification( int aNotificationId, int aNotificationValue );
@@ -365,10 +362,10 @@ public final class MWEngine
     }
 
     /**
-     * Invoke when RECORDED_SNIPPET_READY fires. This will write an in-memory audio recording
-     * snippet onto device storage. Execute as soon as notification as fired for continuous recording,
-     * invoke from a different thread than the audio rendering thread to prevent buffer under runs.
+     * @deprecated recordings are written onto device storage while recording, as such
+     * RECORDED_SNIPPET_READY no longer fires and this method does nothing
      */
+    @Deprecated
     public void saveRecordedSnippet( int snippetBufferIndex ) {
         AudioEngine.saveRecordedSnippet( snippetBufferIndex );
     }
@@ -441,7 +438,7 @@ public final class MWEngine
     /* helper functions */
 
     private int calculateRecordingSnippetBufferSize() {
-        // we divide a recording into 15 second snippets (these are combined when recording finishes)
+        // a recording can buffer up to 15 seconds of audio in memory (should writing onto storage stall)
         final double amountOfMinutes = .25;
 
         // convert milliseconds to sample buffer size